@@ -84,7 +84,7 @@ ATYPE * XFUNC ( UINT4Vector *dimLength )
     XLAL_ERROR_NULL( XLAL_EBADLEN );
 
   /* create array */
-  arr = LALMalloc( sizeof( *arr ) );
+  arr = XLALArenaMalloc( sizeof( *arr ) );
   if ( ! arr )
     XLAL_ERROR_NULL( XLAL_ENOMEM );
 
@@ -92,7 +92,7 @@ ATYPE * XFUNC ( UINT4Vector *dimLength )
   arr->dimLength = XLALCreateUINT4Vector( ndim );
   if ( ! arr->dimLength )
   {
-    LALFree( arr );
+    XLALFree( arr );
     XLAL_ERROR_NULL( XLAL_EFUNC );
   }
 
@@ -101,11 +101,11 @@ ATYPE * XFUNC ( UINT4Vector *dimLength )
       ndim * sizeof( *arr->dimLength->data ) );
 
   /* allocate data storage */
-  arr->data = LALMalloc( size * sizeof( *arr->data ) );
+  arr->data = XLALArenaMalloc( size * sizeof( *arr->data ) );
   if ( ! arr->data )
   {
     XLALDestroyUINT4Vector( arr->dimLength );
-    LALFree( arr );
+    XLALFree( arr );
     XLAL_ERROR_NULL( XLAL_ENOMEM );
   }
 
@@ -21,7 +21,7 @@ STYPE * XFUNC ( UINT4 length, UINT4 veclen )
   if ( ! length || ! veclen )
     XLAL_ERROR_NULL( XLAL_EBADLEN );
 
-  seq = LALMalloc( sizeof( *seq ) );
+  seq = XLALArenaMalloc( sizeof( *seq ) );
   if ( ! seq )
     XLAL_ERROR_NULL( XLAL_ENOMEM );
 
@@ -32,10 +32,10 @@ STYPE * XFUNC ( UINT4 length, UINT4 veclen )
     seq->data = NULL;
   else
   {
-    seq->data = LALMalloc( length * veclen * sizeof( *seq->data ) );
+    seq->data = XLALArenaMalloc( length * veclen * sizeof( *seq->data ) );
     if ( ! seq )
     {
-      LALFree( seq );
+      XLALFree( seq );
       XLAL_ERROR_NULL( XLAL_ENOMEM );
     }
   }
@@ -24,8 +24,8 @@ void XFUNC ( ATYPE *array )
       || ! array->data )
     XLAL_ERROR_VOID( XLAL_EINVAL );
   XLALDestroyUINT4Vector( array->dimLength );
-  LALFree( array->data );
-  LALFree( array );
+  XLALFree( array->data );
+  XLALFree( array );
   return;
 }
 
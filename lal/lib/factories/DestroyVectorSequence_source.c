@@ -23,9 +23,9 @@ void XFUNC ( STYPE *vseq )
   if ( ! vseq->data && ( vseq->length || vseq->vectorLength ) )
     XLAL_ERROR_VOID( XLAL_EINVAL );
   if ( vseq->data )
-    LALFree( vseq->data );
+    XLALFree( vseq->data );
   vseq->data = NULL; /* leave lengths as they are to indicate freed vector */
-  LALFree( vseq );
+  XLALFree( vseq );
   return;
 }
 
@@ -101,7 +101,7 @@ ATYPE * XFUNC ( ATYPE *array, UINT4Vector *dimLength )
       ndim * sizeof( *array->dimLength->data ) );
 
   /* reallocate data storage */
-  array->data = LALRealloc( array->data, size * sizeof( *array->data ) );
+  array->data = XLALRealloc( array->data, size * sizeof( *array->data ) );
   if ( ! array->data )
     XLAL_ERROR_NULL( XLAL_ENOMEM );
 
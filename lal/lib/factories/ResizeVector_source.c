@@ -30,7 +30,7 @@ VTYPE * XFUNC ( VTYPE * vector, UINT4 length )
 #ifdef USE_ALIGNED_MEMORY_ROUTINES
   vector->data = XLALReallocAligned( vector->data, length * sizeof( *vector->data ) );
 #else
-  vector->data = LALRealloc( vector->data, length * sizeof( *vector->data ) );
+  vector->data = XLALRealloc( vector->data, length * sizeof( *vector->data ) );
 #endif
   if ( ! vector->data )
   {
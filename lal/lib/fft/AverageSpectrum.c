@@ -1898,6 +1898,451 @@ int XLALPSDRegressorSetPSD(LALPSDRegressor *r, const REAL8FrequencySeries *psd,
 }
 
 
+/*
+ * Streaming PSD estimation functions.
+ */
+
+
+struct tagLALStreamingPSD {
+  LALStreamingPSDMethod method;
+  unsigned seglen;
+  unsigned stride;
+  unsigned numseg;
+  unsigned nbins;
+  const REAL8Window *window;
+  const REAL8FFTPlan *plan;
+
+  /* time series metadata, fixed by the first chunk of data added */
+  int initialized;
+  REAL8 deltaT;
+  REAL8 f0;
+  LALUnit sampleUnits;
+
+  /* input samples not yet consumed by a segment, and the epoch of the
+   * first of them.  when the stride is longer than a segment, skip counts
+   * input samples that fall between segments and are to be discarded */
+  REAL8 *pending;
+  unsigned n_pending;
+  unsigned pending_size;
+  unsigned skip;
+  LIGOTimeGPS pending_epoch;
+  LIGOTimeGPS next_epoch;
+
+  /* ring buffer of the periodograms of the most recent numseg segments,
+   * and the epochs of those segments */
+  REAL8 *power;
+  LIGOTimeGPS *epochs;
+  unsigned head;
+  unsigned n_segments;
+  unsigned long total_segments;
+
+  /* for each bin, the ring buffer contents in ascending order.  for the
+   * median-mean method the segments are split by the parity of their
+   * position in the stream, and each bin holds two sorted arrays of
+   * length numseg/2 */
+  REAL8 *sorted;
+  unsigned *n_sorted;
+  unsigned sorted_stride;
+
+  /* periodogram of the newest segment */
+  REAL8FrequencySeries *work;
+};
+
+/* insert x into the ascending array a[0..n-1] */
+static void sorted_insert_REAL8(REAL8 *a, unsigned n, REAL8 x)
+{
+  unsigned lo = 0, hi = n;
+  while(lo < hi)
+  {
+    unsigned mid = lo + (hi - lo) / 2;
+    if(a[mid] < x)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  memmove(a + lo + 1, a + lo, (n - lo) * sizeof(*a));
+  a[lo] = x;
+}
+
+/* remove one occurrence of x from the ascending array a[0..n-1] */
+static void sorted_remove_REAL8(REAL8 *a, unsigned n, REAL8 x)
+{
+  unsigned lo = 0, hi = n;
+  while(lo < hi)
+  {
+    unsigned mid = lo + (hi - lo) / 2;
+    if(a[mid] < x)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  /* x was inserted earlier so it must be present, unless it is a NaN */
+  if(lo >= n || !(a[lo] == x))
+    for(lo = 0; lo < n && !(a[lo] == x || (isnan(a[lo]) && isnan(x))); lo++);
+  if(lo < n)
+    memmove(a + lo, a + lo + 1, (n - lo - 1) * sizeof(*a));
+}
+
+/* median of an ascending array, averaging the two middle values if the
+ * length is even */
+static REAL8 sorted_median_REAL8(const REAL8 *a, unsigned n)
+{
+  return n % 2 ? a[n / 2] : 0.5 * (a[n / 2 - 1] + a[n / 2]);
+}
+
+/**
+ * Allocate and initialize a LALStreamingPSD object.
+ *
+ * The LALStreamingPSD object computes the same estimates as
+ * XLALREAL8AverageSpectrumWelch(), XLALREAL8AverageSpectrumMedian() and
+ * XLALREAL8AverageSpectrumMedianMean() over a sliding window of the most
+ * recent numseg segments of a time series that is supplied in arbitrary
+ * contiguous chunks with XLALStreamingPSDAdd().  Only the segments that
+ * are completed by each new chunk are Fourier transformed.  The
+ * periodograms of the segments in the window are kept in a ring buffer,
+ * and for the median methods each frequency bin also keeps its values in
+ * ascending order, so that adding a segment and dropping the oldest costs
+ * a binary search and a memmove per bin rather than a full sort.  A PSD
+ * can be retrieved at any time with XLALStreamingPSDGetPSD().
+ *
+ * seglen is the length of each segment, and stride the number of samples
+ * between the starts of successive segments.  The window, if not NULL,
+ * must have length seglen, and plan must be a forward FFT plan of length
+ * seglen.  Neither is copied:  they must remain valid for the life of the
+ * LALStreamingPSD object.  As for XLALREAL8AverageSpectrumMedianMean(),
+ * the median-mean method requires numseg to be even and stride to be at
+ * least seglen/2.
+ */
+LALStreamingPSD *XLALStreamingPSDNew(unsigned seglen, unsigned stride, unsigned numseg, LALStreamingPSDMethod method, const REAL8Window *window, const REAL8FFTPlan *plan)
+{
+  LALStreamingPSD *new;
+  unsigned nbins = seglen / 2 + 1;
+  unsigned nlists;
+
+  if(!plan)
+    XLAL_ERROR_NULL(XLAL_EFAULT);
+  if(seglen < 1 || stride < 1 || numseg < 1)
+    XLAL_ERROR_NULL(XLAL_EINVAL);
+  if(window && window->data->length != seglen)
+    XLAL_ERROR_NULL(XLAL_EBADLEN);
+  switch(method)
+  {
+  case LAL_STREAMING_PSD_WELCH:
+    nlists = 0;
+    break;
+  case LAL_STREAMING_PSD_MEDIAN:
+    nlists = 1;
+    break;
+  case LAL_STREAMING_PSD_MEDIAN_MEAN:
+    if(numseg % 2 || stride < seglen / 2)
+      XLAL_ERROR_NULL(XLAL_EBADLEN);
+    nlists = 2;
+    break;
+  default:
+    XLAL_ERROR_NULL(XLAL_EINVAL);
+  }
+
+  new = XLALCalloc(1, sizeof(*new));
+  if(!new)
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+  new->method = method;
+  new->seglen = seglen;
+  new->stride = stride;
+  new->numseg = numseg;
+  new->nbins = nbins;
+  new->window = window;
+  new->plan = plan;
+  new->sorted_stride = nlists ? numseg / nlists : 0;
+
+  new->power = XLALMalloc((size_t) numseg * nbins * sizeof(*new->power));
+  new->epochs = XLALMalloc(numseg * sizeof(*new->epochs));
+  new->work = XLALCreateREAL8FrequencySeries("streaming PSD segment", &new->pending_epoch, 0.0, 0.0, &lalDimensionlessUnit, nbins);
+  if(nlists)
+  {
+    new->sorted = XLALMalloc((size_t) nlists * nbins * new->sorted_stride * sizeof(*new->sorted));
+    new->n_sorted = XLALCalloc(nlists, sizeof(*new->n_sorted));
+  }
+  if(!new->power || !new->epochs || !new->work || (nlists && (!new->sorted || !new->n_sorted)))
+  {
+    XLALStreamingPSDFree(new);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+
+  return new;
+}
+
+/**
+ * Reset a LALStreamingPSD object to the newly-allocated state, discarding
+ * all data.  The next chunk of data added may have any epoch and sample
+ * rate.
+ */
+void XLALStreamingPSDReset(LALStreamingPSD *s)
+{
+  s->initialized = 0;
+  s->n_pending = 0;
+  s->skip = 0;
+  s->head = 0;
+  s->n_segments = 0;
+  s->total_segments = 0;
+  if(s->n_sorted)
+    memset(s->n_sorted, 0, (s->method == LAL_STREAMING_PSD_MEDIAN_MEAN ? 2 : 1) * sizeof(*s->n_sorted));
+}
+
+/**
+ * Free all memory associated with a LALStreamingPSD object.  The window
+ * and FFT plan are not freed.
+ */
+void XLALStreamingPSDFree(LALStreamingPSD *s)
+{
+  if(s)
+  {
+    XLALFree(s->pending);
+    XLALFree(s->power);
+    XLALFree(s->epochs);
+    XLALFree(s->sorted);
+    XLALFree(s->n_sorted);
+    XLALDestroyREAL8FrequencySeries(s->work);
+  }
+  XLALFree(s);
+}
+
+/* add the periodogram in s->work to the window, replacing the oldest
+ * segment if the window is full */
+static void streaming_psd_push(LALStreamingPSD *s)
+{
+  const unsigned nbins = s->nbins;
+  const unsigned nlists = s->method == LAL_STREAMING_PSD_MEDIAN_MEAN ? 2 : 1;
+  REAL8 *slot = s->power + (size_t) s->head * nbins;
+  const REAL8 *new_power = s->work->data->data;
+  unsigned k;
+
+  if(s->method != LAL_STREAMING_PSD_WELCH)
+  {
+    /* the segment leaving the window occupied this slot numseg segments
+     * ago, so it has the same parity as the new one */
+    const unsigned list = nlists == 2 ? s->total_segments % 2 : 0;
+    const int full = s->n_segments == s->numseg;
+    unsigned n = s->n_sorted[list];
+    for(k = 0; k < nbins; k++)
+    {
+      REAL8 *a = s->sorted + ((size_t) k * nlists + list) * s->sorted_stride;
+      if(full)
+        sorted_remove_REAL8(a, n, slot[k]);
+      sorted_insert_REAL8(a, full ? n - 1 : n, new_power[k]);
+    }
+    if(!full)
+      s->n_sorted[list]++;
+  }
+
+  memcpy(slot, new_power, nbins * sizeof(*slot));
+  s->epochs[s->head] = s->work->epoch;
+  s->head = (s->head + 1) % s->numseg;
+  if(s->n_segments < s->numseg)
+    s->n_segments++;
+  s->total_segments++;
+}
+
+/**
+ * Add a chunk of time series data to a LALStreamingPSD object.  The chunk
+ * must follow on contiguously from the previous one, with the same sample
+ * rate, heterodyne frequency, and units;  the first chunk added after
+ * creation or XLALStreamingPSDReset() sets these.  The data are copied.
+ * Every segment that is completed by the new data is Fourier transformed
+ * and added to the window.  Returns the number of new segments, or
+ * XLAL_FAILURE on error.
+ */
+int XLALStreamingPSDAdd(LALStreamingPSD *s, const REAL8TimeSeries *tseries)
+{
+  const REAL8 *data;
+  unsigned length;
+  unsigned offset;
+  int nnew = 0;
+
+  if(!s || !tseries || !tseries->data)
+    XLAL_ERROR(XLAL_EFAULT);
+  if(tseries->deltaT <= 0.0)
+    XLAL_ERROR(XLAL_EINVAL);
+
+  if(!s->initialized)
+  {
+    s->deltaT = tseries->deltaT;
+    s->f0 = tseries->f0;
+    s->sampleUnits = tseries->sampleUnits;
+    s->pending_epoch = s->next_epoch = tseries->epoch;
+    s->n_pending = 0;
+    s->skip = 0;
+    s->initialized = 1;
+  }
+  else
+  {
+    if(tseries->deltaT != s->deltaT || tseries->f0 != s->f0 || XLALUnitCompare(&tseries->sampleUnits, &s->sampleUnits))
+    {
+      XLALPrintError("%s(): input parameter mismatch\n", __func__);
+      XLAL_ERROR(XLAL_EDATA);
+    }
+    if(fabs(XLALGPSDiff(&tseries->epoch, &s->next_epoch)) > 0.5 * s->deltaT)
+    {
+      XLALPrintError("%s(): input data are not contiguous with previous data\n", __func__);
+      XLAL_ERROR(XLAL_EDATA);
+    }
+  }
+  XLALGPSAdd(&s->next_epoch, tseries->data->length * s->deltaT);
+
+  /* discard samples that fall between segments */
+  length = tseries->data->length;
+  data = tseries->data->data;
+  if(s->skip)
+  {
+    unsigned n = s->skip < length ? s->skip : length;
+    s->skip -= n;
+    length -= n;
+    data += n;
+  }
+
+  /* append the new data to the pending samples */
+  if(s->n_pending + length > s->pending_size)
+  {
+    unsigned size = s->n_pending + length;
+    REAL8 *pending = XLALRealloc(s->pending, size * sizeof(*pending));
+    if(!pending)
+      XLAL_ERROR(XLAL_ENOMEM);
+    s->pending = pending;
+    s->pending_size = size;
+  }
+  memcpy(s->pending + s->n_pending, data, length * sizeof(*s->pending));
+  s->n_pending += length;
+
+  /* compute the periodogram of each complete segment */
+  for(offset = 0; offset + s->seglen <= s->n_pending; offset += s->stride, nnew++)
+  {
+    REAL8Sequence sequence;
+    REAL8TimeSeries segment;
+
+    sequence.length = s->seglen;
+    sequence.data = s->pending + offset;
+    segment.data = &sequence;
+    segment.epoch = s->pending_epoch;
+    XLALGPSAdd(&segment.epoch, offset * s->deltaT);
+    segment.deltaT = s->deltaT;
+    segment.f0 = s->f0;
+    segment.sampleUnits = s->sampleUnits;
+
+    if(XLALREAL8ModifiedPeriodogram(s->work, &segment, s->window, s->plan) == XLAL_FAILURE)
+      XLAL_ERROR(XLAL_EFUNC);
+    streaming_psd_push(s);
+  }
+
+  /* discard the samples that no future segment will use */
+  XLALGPSAdd(&s->pending_epoch, offset * s->deltaT);
+  if(offset >= s->n_pending)
+  {
+    s->skip += offset - s->n_pending;
+    s->n_pending = 0;
+  }
+  else
+  {
+    memmove(s->pending, s->pending + offset, (s->n_pending - offset) * sizeof(*s->pending));
+    s->n_pending -= offset;
+  }
+
+  return nnew;
+}
+
+/**
+ * Return the number of segments currently contributing to the PSD
+ * estimate of a LALStreamingPSD object.  This counts up from 0 as data is
+ * added, until it reaches numseg.
+ */
+unsigned XLALStreamingPSDGetNSegments(const LALStreamingPSD *s)
+{
+  return s->n_segments;
+}
+
+/**
+ * Retrieve the current PSD estimate of a LALStreamingPSD object.  The
+ * return value is a newly-allocated frequency series object, which the
+ * calling code is responsible for freeing.  Its epoch is that of the
+ * oldest segment in the window.
+ *
+ * Once the window holds numseg segments the result is identical to that of
+ * the corresponding XLALREAL8AverageSpectrumWelch(),
+ * XLALREAL8AverageSpectrumMedian() or XLALREAL8AverageSpectrumMedianMean()
+ * call on the data those segments span.  Before then, the estimate is
+ * formed from the segments available, with the median bias corrected for
+ * the actual number of segments.
+ */
+REAL8FrequencySeries *XLALStreamingPSDGetPSD(const LALStreamingPSD *s)
+{
+  REAL8FrequencySeries *psd;
+  const unsigned oldest = s->n_segments < s->numseg ? 0 : s->head;
+  unsigned k;
+
+  if(!s->n_segments)
+  {
+    XLALPrintError("%s(): no segments have been added\n", __func__);
+    XLAL_ERROR_NULL(XLAL_EDATA);
+  }
+
+  psd = XLALCreateREAL8FrequencySeries("PSD", &s->epochs[oldest], s->work->f0, s->work->deltaF, &s->work->sampleUnits, s->nbins);
+  if(!psd)
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+
+  switch(s->method)
+  {
+  case LAL_STREAMING_PSD_WELCH:
+  {
+    unsigned seg;
+    memset(psd->data->data, 0, s->nbins * sizeof(*psd->data->data));
+    /* sum in time order, as XLALREAL8AverageSpectrumWelch() does */
+    for(seg = 0; seg < s->n_segments; seg++)
+    {
+      const REAL8 *power = s->power + (size_t) ((oldest + seg) % s->numseg) * s->nbins;
+      for(k = 0; k < s->nbins; k++)
+        psd->data->data[k] += power[k];
+    }
+    for(k = 0; k < s->nbins; k++)
+      psd->data->data[k] /= s->n_segments;
+    break;
+  }
+
+  case LAL_STREAMING_PSD_MEDIAN:
+  {
+    const unsigned n = s->n_sorted[0];
+    const REAL8 normfac = 1.0 / XLALMedianBias(n);
+    for(k = 0; k < s->nbins; k++)
+      psd->data->data[k] = normfac * sorted_median_REAL8(s->sorted + (size_t) k * s->sorted_stride, n);
+    break;
+  }
+
+  case LAL_STREAMING_PSD_MEDIAN_MEAN:
+  {
+    /* segments alternate between the two lists starting with the first,
+     * so either both hold the same number or the first holds one more */
+    const unsigned neven = s->n_sorted[0];
+    const unsigned nodd = s->n_sorted[1];
+    const REAL8 evenbias = XLALMedianBias(neven);
+    const REAL8 oddbias = nodd ? XLALMedianBias(nodd) : 1.0;
+    for(k = 0; k < s->nbins; k++)
+    {
+      const REAL8 *even = s->sorted + (size_t) 2 * k * s->sorted_stride;
+      const REAL8 *odd = even + s->sorted_stride;
+      if(neven == nodd)
+        /* same normalization as XLALREAL8AverageSpectrumMedianMean() */
+        psd->data->data[k] = (1.0 / (2.0 * evenbias)) * (sorted_median_REAL8(even, neven) + sorted_median_REAL8(odd, nodd));
+      else if(!nodd)
+        psd->data->data[k] = sorted_median_REAL8(even, neven) / evenbias;
+      else
+        psd->data->data[k] = 0.5 * (sorted_median_REAL8(even, neven) / evenbias + sorted_median_REAL8(odd, nodd) / oddbias);
+    }
+    break;
+  }
+  }
+
+  return psd;
+}
+
+
 /**
  * Compute the two-point spectral correlation function for a whitened
  * frequency series from the window applied to the original time series.
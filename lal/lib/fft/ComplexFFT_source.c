@@ -192,7 +192,9 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
 
     /* perform the fft */
 
+    XLAL_TRACE_START(fft_timer, __func__);
     FFTWX_EXECUTE_DFT(plan->plan, (FFTWX_COMPLEX *)input_data, (FFTWX_COMPLEX *)output_data);
+    XLAL_TRACE_STOP(fft_timer, plan->size * sizeof(COMPLEX_TYPE));
 
     /* cleanup aligned memory space if memory alignment is required;
      * copy data from temporary space to output vector */
@@ -27,6 +27,7 @@
 #include <lal/FFTWMutex.h>
 #include <lal/LALConfig.h> /* Needed to know whether aligning memory */
 #include <lal/LALMalloc.h>
+#include <lal/LALTrace.h>
 #include <lal/RealFFT.h>
 #include <lal/SeqFactories.h>
 #include <lal/XLALError.h>
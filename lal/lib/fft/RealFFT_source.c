@@ -204,7 +204,9 @@ int FORWARD_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * output, const REAL_VECTOR_TYPE *
 
     /* perform the fft */
 
+    XLAL_TRACE_START(fft_timer, __func__);
     FFTWX_EXECUTE_R2R(plan->plan, input_data, tmp);
+    XLAL_TRACE_STOP(fft_timer, plan->size * sizeof(REAL_TYPE));
 
     /* unpack the results into the output vector */
 
@@ -294,7 +296,9 @@ int REVERSE_FFT_FUNCTION(REAL_VECTOR_TYPE * output, const COMPLEX_VECTOR_TYPE *
 
     /* perform the fft */
 
+    XLAL_TRACE_START(fft_timer, __func__);
     FFTWX_EXECUTE_R2R(plan->plan, tmp, output_data);
+    XLAL_TRACE_STOP(fft_timer, plan->size * sizeof(REAL_TYPE));
 
     /* if temporary space for output data was created, copy data into
      * the output vector and free the temporary space */
@@ -359,7 +363,9 @@ int VECTOR_FFT_FUNCTION(REAL_VECTOR_TYPE * _LAL_RESTRICT_ output, const REAL_VEC
 
     /* perform the fft */
 
+    XLAL_TRACE_START(fft_timer, __func__);
     FFTWX_EXECUTE_R2R(plan->plan, input_data, output_data);
+    XLAL_TRACE_STOP(fft_timer, plan->size * sizeof(REAL_TYPE));
 
     /* cleanup aligned memory space if memory alignment is required;
      * copy data from temporary space to output vector */
@@ -421,7 +427,9 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 
     /* perform the fft */
 
+    XLAL_TRACE_START(fft_timer, __func__);
     FFTWX_EXECUTE_R2R(plan->plan, input_data, tmp);
+    XLAL_TRACE_STOP(fft_timer, plan->size * sizeof(REAL_TYPE));
 
     /* compute spectrum from the fft of the data */
 
@@ -186,6 +186,16 @@ tagLALPSDRegressor
 }
 LALPSDRegressor;
 
+/** Averaging methods available to a LALStreamingPSD */
+typedef enum tagLALStreamingPSDMethod {
+  LAL_STREAMING_PSD_WELCH,		/**< mean, as XLALREAL8AverageSpectrumWelch() */
+  LAL_STREAMING_PSD_MEDIAN,		/**< median, as XLALREAL8AverageSpectrumMedian() */
+  LAL_STREAMING_PSD_MEDIAN_MEAN		/**< median-mean, as XLALREAL8AverageSpectrumMedianMean() */
+} LALStreamingPSDMethod;
+
+/** Incremental PSD estimator over a sliding window of segments; see XLALStreamingPSDNew() */
+typedef struct tagLALStreamingPSD LALStreamingPSD;
+
 /*
  *
  * XLAL Functions
@@ -411,6 +421,42 @@ XLALPSDRegressorSetPSD(
 );
 
 
+LALStreamingPSD *
+XLALStreamingPSDNew(
+    unsigned seglen,
+    unsigned stride,
+    unsigned numseg,
+    LALStreamingPSDMethod method,
+    const REAL8Window *window,
+    const REAL8FFTPlan *plan
+);
+
+void
+XLALStreamingPSDFree(
+    LALStreamingPSD *s
+);
+
+void
+XLALStreamingPSDReset(
+    LALStreamingPSD *s
+);
+
+int
+XLALStreamingPSDAdd(
+    LALStreamingPSD *s,
+    const REAL8TimeSeries *tseries
+);
+
+unsigned XLALStreamingPSDGetNSegments(
+    const LALStreamingPSD *s
+);
+
+REAL8FrequencySeries *
+XLALStreamingPSDGetPSD(
+    const LALStreamingPSD *s
+);
+
+
 /** @} */
 
 #if 0
@@ -31,6 +31,7 @@
 /* global variables */
 size_t lalMallocTotal = 0;	/**< current amount of memory allocated by process */
 size_t lalMallocTotalPeak = 0;	/**< peak amount of memory allocated so far */
+size_t lalMallocCount = 0;	/**< number of allocations and reallocations made so far */
 
 /*
  *
@@ -61,6 +62,373 @@ size_t lalMallocTotalPeak = 0;	/**< peak amount of memory allocated so far */
     }                                                                     \
     else (void)(0)
 
+/*
+ *
+ * Memory arenas.
+ *
+ */
+
+/* Note: malloc and free are used for arena blocks and per-thread state,
+ * rather than LALMalloc and LALFree, so that cached blocks are not reported
+ * as memory leaks. */
+
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t) 1 << 20)
+#define ARENA_ALIGNMENT ((size_t) 16)
+#define ARENA_ALIGNMENT_LARGE ((size_t) 64)
+
+/* header stored immediately before each arena allocation */
+typedef struct tagArenaHeader {
+    size_t start;       /* offset in block before this allocation (incl. padding) */
+    size_t size;        /* size of this allocation */
+} ArenaHeader;
+
+/* a contiguous block of memory from which allocations are made */
+typedef struct tagArenaBlock {
+    struct tagArenaBlock *next;
+    size_t capacity;
+    size_t used;
+    char *data;
+} ArenaBlock;
+
+/* an arena pushed by XLALPushMemoryArena(); records where it started */
+typedef struct tagArenaMark {
+    ArenaBlock *block;  /* current block at push time */
+    size_t used;        /* used bytes in current block at push time */
+    size_t blocksize;   /* size of new blocks for this arena */
+} ArenaMark;
+
+/* per-thread arena state */
+typedef struct tagArenaThread {
+    ArenaBlock *blocks;         /* blocks in use, most recent first */
+    ArenaBlock *cache;          /* blocks released by popped arenas, for reuse */
+    size_t depth;               /* number of arenas pushed */
+    size_t maxdepth;            /* allocated length of marks */
+    ArenaMark *marks;
+    LALMemoryArenaStats stats;
+} ArenaThread;
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+/* free per-thread arena state at thread exit */
+static void ArenaDestroyThread(void *ptr)
+{
+    ArenaThread *t = ptr;
+    if (t == NULL)
+        return;
+    for (int k = 0; k < 2; ++k) {
+        ArenaBlock *b = (k == 0) ? t->blocks : t->cache;
+        while (b != NULL) {
+            ArenaBlock *next = b->next;
+            free(b);
+            b = next;
+        }
+    }
+    free(t->marks);
+    free(t);
+}
+
+static pthread_key_t arenaKey;
+static pthread_once_t arenaKeyOnce = PTHREAD_ONCE_INIT;
+static void ArenaCreateKey(void)
+{
+    pthread_key_create(&arenaKey, ArenaDestroyThread);
+}
+#define ARENA_GET_THREAD() (pthread_once(&arenaKeyOnce, ArenaCreateKey), (ArenaThread *) pthread_getspecific(arenaKey))
+#define ARENA_SET_THREAD(t) pthread_setspecific(arenaKey, (t))
+static pthread_mutex_t arenaCountMut = PTHREAD_MUTEX_INITIALIZER;
+#define ARENA_COUNT_ADD(d) (pthread_mutex_lock(&arenaCountMut), arenaCount += (d), pthread_mutex_unlock(&arenaCountMut))
+#else
+/* without pthreads, keep the arena state of each thread (e.g. an OpenMP
+ * thread) in thread-local storage; arenas are unavailable if the compiler
+ * does not support it, since threads would otherwise share one arena */
+#if defined(__GNUC__)
+#define ARENA_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define ARENA_THREAD_LOCAL _Thread_local
+#endif
+#ifdef ARENA_THREAD_LOCAL
+static ARENA_THREAD_LOCAL ArenaThread *arenaThread = NULL;
+#define ARENA_GET_THREAD() (arenaThread)
+#define ARENA_SET_THREAD(t) (arenaThread = (t), 0)
+#else
+#define ARENA_GET_THREAD() ((ArenaThread *) NULL)
+#define ARENA_SET_THREAD(t) (-1)
+#endif
+#if defined(__GNUC__)
+#define ARENA_COUNT_ADD(d) __sync_fetch_and_add(&arenaCount, (d))
+#else
+#define ARENA_COUNT_ADD(d) (arenaCount += (d))
+#endif
+#endif
+
+/* Number of arenas pushed and not yet popped, summed over all threads.  It
+ * is read without locking: a thread always sees its own pushes, so a zero
+ * count means that the calling thread has no arena, and no pointer it may
+ * free can be arena memory.  This keeps the allocation routines free of any
+ * per-thread lookup when arenas are not used. */
+static volatile long arenaCount = 0;
+
+/* per-thread arena state of the calling thread, or NULL if no thread has
+ * pushed an arena */
+#define ARENA_GET_THREAD_IF_ACTIVE() (arenaCount == 0 ? NULL : ARENA_GET_THREAD())
+
+/* return the arena block containing p, or NULL if p is not arena memory */
+static ArenaBlock *ArenaFindBlock(ArenaThread *t, const void *p)
+{
+    if (t == NULL || t->depth == 0)
+        return NULL;
+    for (ArenaBlock *b = t->blocks; b != NULL; b = b->next) {
+        if ((const char *) p >= b->data && (const char *) p < b->data + b->used)
+            return b;
+    }
+    return NULL;
+}
+
+/* allocate n bytes, with the given alignment, from the current arena;
+ * returns NULL if n is zero, like XLALMalloc() may, since a zero-length
+ * allocation at the end of a block could not be told apart from the
+ * unused part of the block */
+static void *ArenaAlloc(ArenaThread *t, size_t n, size_t align)
+{
+    ArenaBlock *b = t->blocks;
+    size_t start = 0, offset = 0;
+    if (n == 0)
+        return NULL;
+    if (b != NULL) {
+        start = b->used;
+        offset = (start + sizeof(ArenaHeader) + align - 1) & ~(align - 1);
+    }
+    if (b == NULL || offset + n > b->capacity) {
+        /* need a new block: reuse a cached block if large enough */
+        const size_t need = n + sizeof(ArenaHeader) + align;
+        ArenaBlock **pb = &t->cache;
+        while (*pb != NULL && (*pb)->capacity < need)
+            pb = &(*pb)->next;
+        if (*pb != NULL) {
+            b = *pb;
+            *pb = b->next;
+        } else {
+            size_t capacity = t->marks[t->depth - 1].blocksize;
+            if (capacity < need)
+                capacity = need;
+            b = malloc(sizeof(*b) + capacity + ARENA_ALIGNMENT_LARGE);
+            if (b == NULL)
+                return NULL;
+            b->capacity = capacity;
+            b->data = (char *) (((size_t) (b + 1) + ARENA_ALIGNMENT_LARGE - 1) & ~(ARENA_ALIGNMENT_LARGE - 1));
+            t->stats.reserved += capacity;
+            if (t->stats.reserved > t->stats.peakReserved)
+                t->stats.peakReserved = t->stats.reserved;
+            ++t->stats.blocks;
+        }
+        b->used = 0;
+        b->next = t->blocks;
+        t->blocks = b;
+        start = 0;
+        offset = (sizeof(ArenaHeader) + align - 1) & ~(align - 1);
+    }
+    ArenaHeader *h = (ArenaHeader *) (b->data + offset) - 1;
+    h->start = start;
+    h->size = n;
+    b->used = offset + n;
+    ++t->stats.allocations;
+    t->stats.bytes += n;
+    return b->data + offset;
+}
+
+/* return true if p, which is in block b, was allocated by the current arena */
+static int ArenaIsCurrent(const ArenaThread *t, const ArenaBlock *b, const void *p)
+{
+    const ArenaMark *m = &t->marks[t->depth - 1];
+    for (const ArenaBlock *c = t->blocks; c != m->block; c = c->next) {
+        if (c == b)
+            return 1;
+    }
+    return b == m->block && (size_t) ((const char *) p - b->data) >= m->used;
+}
+
+/* return true if p, which is in block b, is the most recent allocation of the current arena */
+static int ArenaIsTop(const ArenaThread *t, const ArenaBlock *b, const void *p)
+{
+    const ArenaHeader *h = (const ArenaHeader *) p - 1;
+    return b == t->blocks && (const char *) p + h->size == b->data + b->used && ArenaIsCurrent(t, b, p);
+}
+
+/* free p if it is arena memory; returns nonzero if it was */
+static int ArenaFree(void *p)
+{
+    ArenaThread *t = ARENA_GET_THREAD_IF_ACTIVE();
+    ArenaBlock *b = ArenaFindBlock(t, p);
+    if (b == NULL)
+        return 0;
+    /* memory is reclaimed when the arena is popped, except that the most
+     * recent allocation of the current arena is reclaimed immediately */
+    if (ArenaIsTop(t, b, p))
+        b->used = ((const ArenaHeader *) p - 1)->start;
+    return 1;
+}
+
+/* reallocate p, which is arena memory in block b, to n > 0 bytes; memory
+ * belonging to an outer arena is moved to the heap, since the current arena
+ * may be popped before the outer one */
+static void *ArenaRealloc(ArenaThread *t, ArenaBlock *b, void *p, size_t n, size_t align, const char *file, int line)
+{
+    ArenaHeader *h = (ArenaHeader *) p - 1;
+    void *q;
+    if (ArenaIsTop(t, b, p) && (size_t) ((char *) p - b->data) + n <= b->capacity) {
+        /* grow or shrink in place */
+        if (n > h->size)
+            t->stats.bytes += n - h->size;
+        h->size = n;
+        b->used = (char *) p - b->data + n;
+        return p;
+    }
+    if (ArenaIsCurrent(t, b, p)) {
+        q = ArenaAlloc(t, n, align);
+    } else {
+#if LAL_FFTW3_MEMALIGN_ENABLED
+        q = (align == ARENA_ALIGNMENT_LARGE) ? XLALMallocAlignedLong(n, file, line) : LALMallocLong(n, file, line);
+#else
+        q = LALMallocLong(n, file, line);
+#endif
+    }
+    if (q != NULL)
+        memcpy(q, p, h->size < n ? h->size : n);
+    return q;
+}
+
+/* reallocate p to n bytes, or free it if n is zero, if it is arena memory;
+ * returns nonzero, with the new pointer in *q, if it was */
+static int ArenaReallocIfArena(void *p, size_t n, size_t align, const char *file, int line, void **q)
+{
+    ArenaThread *t = ARENA_GET_THREAD_IF_ACTIVE();
+    ArenaBlock *b = ArenaFindBlock(t, p);
+    if (b == NULL)
+        return 0;
+    if (n == 0) {
+        ArenaFree(p);
+        *q = NULL;
+    } else {
+        *q = ArenaRealloc(t, b, p, n, align, file, line);
+    }
+    return 1;
+}
+
+/**
+ * \brief Push a new memory arena for the calling thread
+ *
+ * While an arena is pushed, the LAL vector, sequence and series factories
+ * (e.g. XLALCreateREAL8Vector(), XLALCreateCOMPLEX16FrequencySeries())
+ * called from the same thread allocate their memory from the arena, by
+ * advancing a pointer through large blocks, instead of calling \c malloc().
+ * Destroying such objects is cheap, and all memory allocated from the arena
+ * is reclaimed at once by XLALPopMemoryArena().  Blocks released by popped
+ * arenas are kept and reused by later arenas on the same thread, which
+ * avoids repeated page faults in hot loops.
+ *
+ * Arenas may be nested.  Objects allocated from an arena must not be used
+ * or destroyed after the arena is popped, nor destroyed by another thread;
+ * results which must outlive the arena should be copied out, or allocated
+ * before the arena is pushed.  Objects allocated outside the arena may be
+ * freely created and destroyed while the arena is pushed.  Memory allocated
+ * from arenas may be resized or freed with LALRealloc() and LALFree() as
+ * well as with XLALRealloc() and XLALFree(), but is not tracked by the LAL
+ * memory debugging routines.  Arenas are not available if LAL is built
+ * without pthreads on a compiler without thread-local storage.
+ *
+ * \c blocksize gives the minimum size in bytes of blocks allocated for the
+ * arena; if zero, a default of 1 MiB is used.
+ */
+int XLALPushMemoryArena(size_t blocksize)
+{
+#if !defined(LAL_PTHREAD_LOCK) && !defined(ARENA_THREAD_LOCAL)
+    XLAL_ERROR(XLAL_EFAILED, "memory arenas require pthreads or thread-local storage");
+#endif
+    ArenaThread *t = ARENA_GET_THREAD();
+    if (t == NULL) {
+        t = calloc(1, sizeof(*t));
+        XLAL_CHECK(t != NULL, XLAL_ENOMEM);
+        if (ARENA_SET_THREAD(t) != 0) {
+            free(t);
+            XLAL_ERROR(XLAL_ESYS, "could not set per-thread memory arena");
+        }
+    }
+    if (t->depth == t->maxdepth) {
+        size_t maxdepth = t->maxdepth > 0 ? 2 * t->maxdepth : 4;
+        ArenaMark *marks = realloc(t->marks, maxdepth * sizeof(*marks));
+        XLAL_CHECK(marks != NULL, XLAL_ENOMEM);
+        t->marks = marks;
+        t->maxdepth = maxdepth;
+    }
+    ArenaMark *m = &t->marks[t->depth++];
+    m->block = t->blocks;
+    m->used = t->blocks ? t->blocks->used : 0;
+    m->blocksize = blocksize > 0 ? blocksize : ARENA_DEFAULT_BLOCK_SIZE;
+    t->stats.depth = t->depth;
+    ARENA_COUNT_ADD(1);
+    return XLAL_SUCCESS;
+}
+
+/**
+ * \brief Pop the most recently pushed memory arena of the calling thread,
+ * reclaiming all memory allocated from it
+ */
+int XLALPopMemoryArena(void)
+{
+    ArenaThread *t = ARENA_GET_THREAD();
+    XLAL_CHECK(t != NULL && t->depth > 0, XLAL_EFAILED, "no memory arena to pop");
+    ArenaMark *m = &t->marks[--t->depth];
+    while (t->blocks != m->block) {
+        ArenaBlock *b = t->blocks;
+        t->blocks = b->next;
+        b->next = t->cache;
+        t->cache = b;
+    }
+    if (t->blocks != NULL)
+        t->blocks->used = m->used;
+    t->stats.depth = t->depth;
+    ARENA_COUNT_ADD(-1);
+    return XLAL_SUCCESS;
+}
+
+/**
+ * \brief Return statistics on the memory arenas of the calling thread
+ */
+int XLALGetMemoryArenaStats(LALMemoryArenaStats *stats)
+{
+    XLAL_CHECK(stats != NULL, XLAL_EFAULT);
+    ArenaThread *t = ARENA_GET_THREAD();
+    if (t == NULL)
+        memset(stats, 0, sizeof(*stats));
+    else
+        *stats = t->stats;
+    return XLAL_SUCCESS;
+}
+
+/**
+ * \brief Allocate \c n bytes from the current memory arena of the calling
+ * thread, or with XLALMalloc() if no arena is pushed
+ */
+void *XLALArenaMallocLong(size_t n, const char *file, int line)
+{
+    ArenaThread *t = ARENA_GET_THREAD_IF_ACTIVE();
+    if (t == NULL || t->depth == 0)
+        return XLALMallocLong(n, file, line);
+    void *p = ArenaAlloc(t, n, ARENA_ALIGNMENT);
+    XLAL_TEST_POINTER_LONG(p, n, file, line);
+    return p;
+}
+
+void *(XLALArenaMalloc)(size_t n)
+{
+    ArenaThread *t = ARENA_GET_THREAD_IF_ACTIVE();
+    if (t == NULL || t->depth == 0)
+        return (XLALMalloc)(n);
+    void *p = ArenaAlloc(t, n, ARENA_ALIGNMENT);
+    XLAL_TEST_POINTER(p, n);
+    return p;
+}
+
 void *(XLALMalloc) (size_t n) {
     void *p;
     p = LALMallocShort(n);
@@ -165,6 +533,10 @@ void *(XLALCallocAligned)(size_t nelem, size_t elsize)
 void *XLALReallocAlignedLong(void *ptr, size_t size, const char *file, int line)
 {
 	void *p;
+	if (ArenaReallocIfArena(ptr, size, ARENA_ALIGNMENT_LARGE, file, line, &p)) {
+		XLAL_TEST_POINTER_LONG(p, size, file, line);
+		return p;
+	}
 	if (ptr == NULL)
 		return XLALMallocAlignedLong(size, file, line);
 	if (size == 0) {
@@ -184,6 +556,10 @@ void *XLALReallocAlignedLong(void *ptr, size_t size, const char *file, int line)
 void *(XLALReallocAligned)(void *ptr, size_t size)
 {
 	void *p;
+	if (ArenaReallocIfArena(ptr, size, ARENA_ALIGNMENT_LARGE, __FILE__, __LINE__, &p)) {
+		XLAL_TEST_POINTER(p, size);
+		return p;
+	}
 	if (ptr == NULL)
 		return XLALMallocAligned(size);
 	if (size == 0) {
@@ -202,9 +578,31 @@ void *(XLALReallocAligned)(void *ptr, size_t size)
 
 void XLALFreeAligned(void *ptr)
 {
+	if (ptr && ArenaFree(ptr))
+		return;
 	free(ptr); /* use ordinary free */
 }
 
+void *XLALArenaMallocAlignedLong(size_t size, const char *file, int line)
+{
+	ArenaThread *t = ARENA_GET_THREAD_IF_ACTIVE();
+	if (t == NULL || t->depth == 0)
+		return XLALMallocAlignedLong(size, file, line);
+	void *p = ArenaAlloc(t, size, ARENA_ALIGNMENT_LARGE);
+	XLAL_TEST_POINTER_LONG(p, size, file, line);
+	return p;
+}
+
+void *(XLALArenaMallocAligned)(size_t size)
+{
+	ArenaThread *t = ARENA_GET_THREAD_IF_ACTIVE();
+	if (t == NULL || t->depth == 0)
+		return (XLALMallocAligned)(size);
+	void *p = ArenaAlloc(t, size, ARENA_ALIGNMENT_LARGE);
+	XLAL_TEST_POINTER(p, size);
+	return p;
+}
+
 #endif /* LAL_FFTW3_MEMALIGN_ENABLED */
 
 /*
@@ -431,6 +829,7 @@ static void *PadAlloc(size_t * p, size_t n, int keep, const char *func)
     pthread_mutex_lock(&mut);
     lalMallocTotal += n;
     lalMallocTotalPeak = (lalMallocTotalPeak > lalMallocTotal) ? lalMallocTotalPeak : lalMallocTotal;
+    ++lalMallocCount;
     pthread_mutex_unlock(&mut);
 
     return (void *) (((char *) p) + prefix);
@@ -671,6 +1070,9 @@ void *LALCallocLong(size_t m, size_t n, const char *file, int line)
 
 void *LALReallocShort(void *p, size_t n)
 {
+    void *q;
+    if (ArenaReallocIfArena(p, n, ARENA_ALIGNMENT, "unknown", -1, &q))
+        return q;
     return (lalDebugLevel & LALMEMDBGBIT) ? LALReallocLong(p, n, "unknown", -1): realloc(p, n);
 }
 
@@ -679,6 +1081,8 @@ void *LALReallocShort(void *p, size_t n)
 void *LALReallocLong(void *q, size_t n, const char *file, const int line)
 {
     void *p;
+    if (ArenaReallocIfArena(q, n, ARENA_ALIGNMENT, file, line, &p))
+        return p;
     if (!(lalDebugLevel & LALMEMDBGBIT)) {
         return realloc(q, n);
     }
@@ -728,6 +1132,8 @@ void LALFree(void *q)
     void *p;
     if (q == NULL)
         return;
+    if (ArenaFree(q))
+        return;
     if (!(lalDebugLevel & LALMEMDBGBIT)) {
         free(q);
         return;
@@ -781,6 +1187,32 @@ void LALCheckMemoryLeaks(void)
 
 #else
 
+/* LALRealloc and LALFree must recognise arena memory even without
+ * debugging, since they may be given buffers allocated by the factories */
+
+void *LALReallocShort(void *p, size_t n)
+{
+    void *q;
+    if (ArenaReallocIfArena(p, n, ARENA_ALIGNMENT, "unknown", -1, &q))
+        return q;
+    return realloc(p, n);
+}
+
+void *LALReallocLong(void *p, size_t n, const char *file, int line)
+{
+    void *q;
+    if (ArenaReallocIfArena(p, n, ARENA_ALIGNMENT, file, line, &q))
+        return q;
+    return realloc(p, n);
+}
+
+void LALFree(void *p)
+{
+    if (p && ArenaFree(p))
+        return;
+    free(p);
+}
+
 void (LALCheckMemoryLeaks)(void) { return; }
 
 #endif /* ! defined NDEBUG */
@@ -32,6 +32,7 @@ extern "C" {
 /** \addtogroup LALMalloc_h */ /** @{ */
 extern size_t lalMallocTotal;
 extern size_t lalMallocTotalPeak;
+extern size_t lalMallocCount;
 void *XLALMalloc(size_t n);
 void *XLALMallocLong(size_t n, const char *file, int line);
 void *XLALCalloc(size_t m, size_t n);
@@ -46,6 +47,26 @@ void XLALFree(void *p);
 #endif /* SWIG */
 /** @} */
 
+/** \addtogroup LALMalloc_h */ /** @{ */
+/** Statistics on the memory arenas of a thread; see XLALPushMemoryArena() */
+typedef struct tagLALMemoryArenaStats {
+    size_t depth;               /**< Number of arenas currently pushed */
+    size_t allocations;         /**< Total number of allocations made from arenas */
+    size_t bytes;               /**< Total number of bytes allocated from arenas */
+    size_t blocks;              /**< Total number of arena blocks allocated with malloc() */
+    size_t reserved;            /**< Number of bytes currently reserved in arena blocks */
+    size_t peakReserved;        /**< Peak number of bytes reserved in arena blocks */
+} LALMemoryArenaStats;
+int XLALPushMemoryArena(size_t blocksize);
+int XLALPopMemoryArena(void);
+int XLALGetMemoryArenaStats(LALMemoryArenaStats *stats);
+#ifndef SWIG    /* exclude from SWIG interface */
+void *XLALArenaMalloc(size_t n);
+void *XLALArenaMallocLong(size_t n, const char *file, int line);
+#define XLALArenaMalloc( n )   XLALArenaMallocLong( n, __FILE__, __LINE__ )
+#endif /* SWIG */
+/** @} */
+
 /** \addtogroup LALMalloc_h */ /** @{ */
 /* presently these are only here if needed */
 #ifdef LAL_FFTW3_MEMALIGN_ENABLED
@@ -59,7 +80,10 @@ void *XLALReallocAlignedLong(void *ptr, size_t size, const char *file, int line)
 void *XLALReallocAligned(void *ptr, size_t size);
 void XLALFreeAligned(void *ptr);
 #ifndef SWIG    /* exclude from SWIG interface */
+void *XLALArenaMallocAligned(size_t size);
+void *XLALArenaMallocAlignedLong(size_t size, const char *file, int line);
 #define LAL_IS_MEMORY_ALIGNED(ptr) (((size_t)(ptr) % LAL_MEM_ALIGNMENT) == 0)
+#define XLALArenaMallocAligned(size) XLALArenaMallocAlignedLong(size, __FILE__, __LINE__)
 #define XLALMallocAligned(size) XLALMallocAlignedLong(size, __FILE__, __LINE__)
 #define XLALCallocAligned(nelem, elsize) XLALCallocAlignedLong(nelem, elsize, __FILE__, __LINE__)
 #define XLALReallocAligned(ptr, size) XLALReallocAlignedLong(ptr, size, __FILE__, __LINE__)
@@ -76,11 +100,12 @@ void XLALFreeAligned(void *ptr);
 #define LALCalloc                          calloc
 #define LALCallocShort                     calloc
 #define LALCallocLong( m, n, file, line )  calloc( m, n )
-#define LALRealloc                         realloc
-#define LALReallocShort                    realloc
-#define LALReallocLong( p, n, file, line ) realloc( p, n )
-#define LALFree                            free
+#define LALRealloc( p, n )                 LALReallocShort( p, n )
 #define LALCheckMemoryLeaks()
+/* LALRealloc and LALFree recognise memory allocated from arenas */
+void *LALReallocShort(void *p, size_t n);
+void *LALReallocLong(void *p, size_t n, const char *file, int line);
+void LALFree(void *p);
 #endif /* SWIG */
 
 #else
@@ -0,0 +1,339 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with with program; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <config.h>
+
+#ifndef HAVE_CLOCK_GETTIME
+#include <sys/time.h>
+#endif
+
+#include <lal/LALTrace.h>
+#include <lal/LALError.h>
+#include <lal/XLALError.h>
+#include <lal/LALString.h>
+
+/* Note: malloc and free are used here rather than LALMalloc and LALFree,
+ * since accumulators may live until exit and must not show up as leaks.
+ * With pthreads, the accumulators of a thread are folded into traceExited
+ * and freed when the thread exits. */
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_once_t traceOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t traceMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t traceKey;
+#define LAL_ONCE(init) pthread_once(&traceOnce, (init))
+#define LOCK() pthread_mutex_lock(&traceMutex)
+#define UNLOCK() pthread_mutex_unlock(&traceMutex)
+#elif defined(__GNUC__)
+/* without pthreads, threads (e.g. OpenMP threads) are serialised with a
+ * spin lock built on the GCC atomic builtins */
+static volatile int traceOnce = 1;
+static volatile int traceSpin = 0;
+#define LOCK() do { while (__sync_lock_test_and_set(&traceSpin, 1)) {} } while (0)
+#define UNLOCK() __sync_lock_release(&traceSpin)
+#define LAL_ONCE(init) do { LOCK(); if (traceOnce) { (init)(); traceOnce = 0; } UNLOCK(); } while (0)
+#else
+static int traceOnce = 1;
+#define LAL_ONCE(init) (traceOnce ? (init)(), traceOnce = 0 : 0)
+#define LOCK()
+#define UNLOCK()
+#endif
+#ifndef LAL_PTHREAD_LOCK
+/* without pthreads, keep the accumulators of each thread (e.g. an OpenMP
+ * thread) in thread-local storage where the compiler supports it */
+#if defined(__GNUC__)
+#define LAL_TRACE_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define LAL_TRACE_THREAD_LOCAL _Thread_local
+#else
+#define LAL_TRACE_THREAD_LOCAL
+#endif
+#endif
+
+/* per-thread accumulators; linked into a global list so that they can be summed */
+typedef struct tagLALTraceThread {
+  UINT8 calls[LAL_TRACE_MAX_SITES];
+  UINT8 bytes[LAL_TRACE_MAX_SITES];
+  INT8 nanoseconds[LAL_TRACE_MAX_SITES];
+  UINT8 threads[LAL_TRACE_MAX_SITES]; /* only used by traceExited */
+  struct tagLALTraceThread *next;
+} LALTraceThread;
+
+/* 0 if LAL_TRACE has not yet been parsed, otherwise 1 if disabled and 2 if
+ * enabled; set last by XLALTraceInit(), so that once non-zero it can be read
+ * without synchronisation */
+static volatile int traceState = 0;
+static int traceJSON = 0;
+static char *traceFile = NULL;
+static char *traceNames[LAL_TRACE_MAX_SITES];
+static INT4 traceNumSites = 0;
+static LALTraceThread *traceThreads = NULL;
+static LALTraceThread traceExited; /* sums of the accumulators of exited threads */
+#ifndef LAL_PTHREAD_LOCK
+static LAL_TRACE_THREAD_LOCAL LALTraceThread *traceThisThread = NULL;
+#endif
+
+/* write summary at exit, to the destination given by LAL_TRACE */
+static void XLALTraceAtExit(void)
+{
+  FILE *fp = stderr;
+  if (traceFile != NULL && (fp = fopen(traceFile, "w")) == NULL) {
+    XLALPrintError("%s: could not open LAL_TRACE file '%s'\n", __func__, traceFile);
+    return;
+  }
+  XLALTraceWriteSummary(fp, traceJSON ? "json" : "csv");
+  if (fp != stderr) {
+    fclose(fp);
+  }
+}
+
+#ifdef LAL_PTHREAD_LOCK
+/* fold the accumulators of an exiting thread into traceExited and free them */
+static void XLALTraceThreadExit(void *ptr)
+{
+  LALTraceThread *thread = ptr;
+  LOCK();
+  for (LALTraceThread **p = &traceThreads; *p != NULL; p = &(*p)->next) {
+    if (*p == thread) {
+      *p = thread->next;
+      break;
+    }
+  }
+  for (INT4 i = 0; i < LAL_TRACE_MAX_SITES; ++i) {
+    if (thread->calls[i] > 0) {
+      traceExited.calls[i] += thread->calls[i];
+      traceExited.bytes[i] += thread->bytes[i];
+      traceExited.nanoseconds[i] += thread->nanoseconds[i];
+      ++traceExited.threads[i];
+    }
+  }
+  UNLOCK();
+  free(thread);
+}
+#endif
+
+/* parse LAL_TRACE; returns non-zero if instrumentation is enabled */
+static int XLALTraceParse(void)
+{
+  const char *env = getenv("LAL_TRACE");
+  if (env == NULL || *env == '\0' || strcmp(env, "0") == 0)
+    return 0;
+
+  size_t fmtlen = strcspn(env, ":");
+  if (XLALStringNCaseCompare("json", env, fmtlen) == 0 && fmtlen == 4) {
+    traceJSON = 1;
+  } else if (!((XLALStringNCaseCompare("csv", env, fmtlen) == 0 && fmtlen == 3) || (fmtlen == 1 && env[0] == '1'))) {
+    lalAbortHook("%s: could not parse LAL_TRACE='%s'\n", __func__, env);
+    return 0;
+  }
+  if (env[fmtlen] == ':' && env[fmtlen + 1] != '\0') {
+    if ((traceFile = malloc(strlen(env + fmtlen + 1) + 1)) == NULL) {
+      lalAbortHook("%s: could not allocate memory\n", __func__);
+      return 0;
+    }
+    strcpy(traceFile, env + fmtlen + 1);
+  }
+
+#ifdef LAL_PTHREAD_LOCK
+  if (pthread_key_create(&traceKey, XLALTraceThreadExit)) {
+    lalAbortHook("%s: pthread_key_create failed\n", __func__);
+    return 0;
+  }
+#endif
+  atexit(XLALTraceAtExit);
+  return 1;
+}
+
+static void XLALTraceInit(void)
+{
+  traceState = XLALTraceParse() ? 2 : 1;
+}
+
+/* return the accumulators of the current thread, creating them on first use */
+static LALTraceThread *XLALTraceThisThread(void)
+{
+#ifdef LAL_PTHREAD_LOCK
+  LALTraceThread *thread = pthread_getspecific(traceKey);
+#else
+  LALTraceThread *thread = traceThisThread;
+#endif
+  if (thread == NULL) {
+    if ((thread = calloc(1, sizeof(*thread))) == NULL) {
+      lalAbortHook("%s: could not allocate memory\n", __func__);
+      return NULL;
+    }
+    LOCK();
+    thread->next = traceThreads;
+    traceThreads = thread;
+    UNLOCK();
+#ifdef LAL_PTHREAD_LOCK
+    if (pthread_setspecific(traceKey, thread)) {
+      lalAbortHook("%s: pthread_setspecific failed\n", __func__);
+      return NULL;
+    }
+#else
+    traceThisThread = thread;
+#endif
+  }
+  return thread;
+}
+
+/**
+ * Return true if instrumentation is enabled by the <tt>LAL_TRACE</tt>
+ * environment variable.
+ */
+int XLALTraceEnabled(void)
+{
+  if (traceState == 0)
+    LAL_ONCE(XLALTraceInit);
+  return traceState == 2;
+}
+
+/**
+ * Register an instrumentation point \c name, and return its index for use
+ * with XLALTraceAccumulate().  Registering the same name again returns the
+ * same index.  Returns -1 if instrumentation is disabled or no more names
+ * can be registered.
+ */
+INT4 XLALTraceRegister(const char *name)
+{
+  if (!XLALTraceEnabled() || name == NULL)
+    return -1;
+  INT4 site = -1;
+  LOCK();
+  for (INT4 i = 0; i < traceNumSites; ++i) {
+    if (strcmp(traceNames[i], name) == 0) {
+      site = i;
+      break;
+    }
+  }
+  if (site < 0 && traceNumSites < LAL_TRACE_MAX_SITES && (traceNames[traceNumSites] = malloc(strlen(name) + 1)) != NULL) {
+    strcpy(traceNames[traceNumSites], name);
+    site = traceNumSites++;
+  }
+  UNLOCK();
+  if (site < 0) {
+    XLALPrintWarning("%s: could not register instrumentation point '%s'\n", __func__, name);
+  }
+  return site;
+}
+
+/**
+ * Return a monotonic time in nanoseconds, for timing code.
+ */
+INT8 XLALTraceNow(void)
+{
+#ifdef HAVE_CLOCK_GETTIME
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((INT8) ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return ((INT8) tv.tv_sec) * 1000000000 + ((INT8) tv.tv_usec) * 1000;
+#endif
+}
+
+/**
+ * Add \c calls calls, \c bytes bytes and \c nanoseconds elapsed time to the
+ * instrumentation point \c site in the accumulators of the current thread.
+ */
+void XLALTraceAccumulate(INT4 site, UINT8 calls, UINT8 bytes, INT8 nanoseconds)
+{
+  if (site < 0 || site >= LAL_TRACE_MAX_SITES || !XLALTraceEnabled())
+    return;
+  LALTraceThread *thread = XLALTraceThisThread();
+  if (thread == NULL)
+    return;
+  thread->calls[site] += calls;
+  thread->bytes[site] += bytes;
+  thread->nanoseconds[site] += nanoseconds;
+}
+
+/**
+ * Reset all accumulators to zero, including those of threads which have
+ * exited.  Should not be called while other threads are accumulating.
+ */
+void XLALTraceReset(void)
+{
+  LOCK();
+  memset(&traceExited, 0, sizeof(traceExited));
+  for (LALTraceThread *thread = traceThreads; thread != NULL; thread = thread->next) {
+    memset(thread->calls, 0, sizeof(thread->calls));
+    memset(thread->bytes, 0, sizeof(thread->bytes));
+    memset(thread->nanoseconds, 0, sizeof(thread->nanoseconds));
+  }
+  UNLOCK();
+}
+
+/**
+ * Write a summary of all instrumentation points which have been called, in
+ * the given \c format, which is either <tt>"csv"</tt> or <tt>"json"</tt>.
+ * For each instrumentation point the summary gives its name, the number of
+ * calls, the total and mean time in seconds, the number of bytes and the
+ * number of threads it was called from.  Threads which have exited are
+ * included.
+ */
+int XLALTraceWriteSummary(FILE *fp, const char *format)
+{
+  XLAL_CHECK(fp != NULL, XLAL_EFAULT);
+  XLAL_CHECK(format != NULL, XLAL_EFAULT);
+  int json = 0;
+  if (XLALStringCaseCompare(format, "json") == 0) {
+    json = 1;
+  } else {
+    XLAL_CHECK(XLALStringCaseCompare(format, "csv") == 0, XLAL_EINVAL, "Unknown format '%s'", format);
+  }
+
+  fprintf(fp, json ? "[\n" : "name,calls,seconds,mean_seconds,bytes,threads\n");
+  int first = 1;
+  LOCK();
+  for (INT4 i = 0; i < traceNumSites; ++i) {
+    UINT8 calls = traceExited.calls[i], bytes = traceExited.bytes[i], threads = traceExited.threads[i];
+    INT8 nanoseconds = traceExited.nanoseconds[i];
+    for (LALTraceThread *thread = traceThreads; thread != NULL; thread = thread->next) {
+      if (thread->calls[i] > 0) {
+        calls += thread->calls[i];
+        bytes += thread->bytes[i];
+        nanoseconds += thread->nanoseconds[i];
+        ++threads;
+      }
+    }
+    if (calls == 0)
+      continue;
+    const double seconds = 1e-9 * nanoseconds;
+    if (json) {
+      fprintf(fp, "%s  {\"name\": \"%s\", \"calls\": %llu, \"seconds\": %.9g, \"mean_seconds\": %.9g, \"bytes\": %llu, \"threads\": %llu}",
+              first ? "" : ",\n", traceNames[i], (unsigned long long) calls, seconds, seconds / calls, (unsigned long long) bytes, (unsigned long long) threads);
+    } else {
+      fprintf(fp, "%s,%llu,%.9g,%.9g,%llu,%llu\n",
+              traceNames[i], (unsigned long long) calls, seconds, seconds / calls, (unsigned long long) bytes, (unsigned long long) threads);
+    }
+    first = 0;
+  }
+  UNLOCK();
+  if (json) {
+    fprintf(fp, "%s]\n", first ? "" : "\n");
+  }
+
+  return XLAL_SUCCESS;
+}
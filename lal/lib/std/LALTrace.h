@@ -0,0 +1,125 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with with program; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301  USA
+ */
+
+#ifndef _LALTRACE_H
+#define _LALTRACE_H
+
+#include <stdio.h>
+#include <lal/LALAtomicDatatypes.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * \defgroup LALTrace_h Header LALTrace.h
+ * \ingroup lal_std
+ * \brief Lightweight run-time instrumentation of hot code paths
+ *
+ * ### Synopsis ###
+ * \code
+ * #include <lal/LALTrace.h>
+ *
+ * XLAL_TRACE_START(timer, "XLALDoSomething");
+ * ... do something with nbytes of data ...
+ * XLAL_TRACE_STOP(timer, nbytes);
+ *
+ * XLAL_TRACE_COUNT("XLALDoSomething:cache-miss", 1, 0);
+ * \endcode
+ *
+ * ### Description ###
+ *
+ * Instrumentation points are identified by a name, and accumulate the
+ * number of calls, the elapsed (monotonic wall-clock) time, and the number
+ * of bytes processed.  Accumulators are kept per thread and are only
+ * summed when a summary is written, so instrumented code running in
+ * several threads does not contend on a lock.
+ *
+ * Instrumentation is switched on by the environment variable
+ * <tt>LAL_TRACE</tt>, which is read once:
+ * - <tt>LAL_TRACE=csv</tt> or <tt>LAL_TRACE=1</tt>: write a CSV summary to
+ *   standard error at exit;
+ * - <tt>LAL_TRACE=json</tt>: write a JSON summary to standard error at exit;
+ * - <tt>LAL_TRACE=csv:</tt><em>file</em> or <tt>LAL_TRACE=json:</tt><em>file</em>:
+ *   write the summary to <em>file</em> instead.
+ *
+ * If <tt>LAL_TRACE</tt> is unset, empty or <tt>0</tt>, each instrumentation
+ * point costs a single test of a cached static variable.  Up to
+ * #LAL_TRACE_MAX_SITES distinct names can be registered.
+ */
+/** @{ */
+
+/** Maximum number of distinct instrumentation point names */
+#define LAL_TRACE_MAX_SITES 256
+
+/** State of a running timer */
+typedef struct tagLALTraceTimer {
+  INT4 site;	/**< Registered instrumentation point, or negative if tracing is disabled */
+  INT8 start;	/**< Start time in nanoseconds */
+} LALTraceTimer;
+
+int XLALTraceEnabled(void);
+INT4 XLALTraceRegister(const char *name);
+INT8 XLALTraceNow(void);
+void XLALTraceAccumulate(INT4 site, UINT8 calls, UINT8 bytes, INT8 nanoseconds);
+void XLALTraceReset(void);
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+int XLALTraceWriteSummary(FILE *fp, const char *format);
+
+/*
+ * Each instrumentation point caches its registered site in a static
+ * variable; concurrent first calls may register the same name twice, which
+ * returns the same site, so the (benign) race only ever stores equal values.
+ */
+
+/**
+ * Declare and start a timer named \c timer for the instrumentation point \c name.
+ */
+#define XLAL_TRACE_START(timer, name) \
+  static INT4 timer##_site_ = -2; \
+  if (timer##_site_ == -2) timer##_site_ = XLALTraceRegister(name); \
+  LALTraceTimer timer = { timer##_site_, (timer##_site_ >= 0) ? XLALTraceNow() : 0 }
+
+/**
+ * Stop the timer \c timer, accumulating one call and \c bytes bytes processed.
+ */
+#define XLAL_TRACE_STOP(timer, bytes) \
+  do { \
+    if ((timer).site >= 0) XLALTraceAccumulate((timer).site, 1, (bytes), XLALTraceNow() - (timer).start); \
+  } while (0)
+
+/**
+ * Accumulate \c count events and \c bytes bytes for the instrumentation point \c name.
+ */
+#define XLAL_TRACE_COUNT(name, count, bytes) \
+  do { \
+    static INT4 site_ = -2; \
+    if (site_ == -2) site_ = XLALTraceRegister(name); \
+    if (site_ >= 0) XLALTraceAccumulate(site_, (count), (bytes), 0); \
+  } while (0)
+
+#endif /* SWIG */
+
+/** @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* _LALTRACE_H */
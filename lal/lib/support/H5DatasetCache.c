@@ -0,0 +1,247 @@
+#ifdef HAVE_HDF5
+
+/*
+ * Process-wide cache of the decoded contents of datasets in HDF5 files
+ * opened for reading.  The first read of a dataset goes through the HDF5
+ * library (and hence through the HDF5 mutex if the library is not itself
+ * threadsafe); the decoded data is then copied into an entry of the cache,
+ * and later reads of the same dataset are served by copying from that
+ * entry without calling the HDF5 library.
+ *
+ * Entries are immutable once inserted and are only freed by
+ * XLALH5CacheClear(), so the data of an entry can be copied without
+ * holding any lock; the list of entries is protected by a reader-writer
+ * lock which is only held while walking or linking the list.  Entries
+ * record the identity (device, inode, size and modification time to the
+ * nanosecond) of the file they were read from, as found when the dataset
+ * was opened, and are not used if the file has since been replaced or
+ * modified.  The numbers of lookups that found and did not find an entry
+ * are counted, for XLALH5CacheQueryHits() and XLALH5CacheQueryMisses().
+ *
+ * Note: malloc and free are used here rather than LALMalloc and LALFree,
+ * since entries may live until exit and must not show up as leaks.
+ */
+
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_once_t lalH5CacheOnce = PTHREAD_ONCE_INIT;
+static pthread_rwlock_t lalH5CacheLock = PTHREAD_RWLOCK_INITIALIZER;
+#define LAL_H5_CACHE_ONCE(init) pthread_once(&lalH5CacheOnce, (init))
+#define LAL_H5_CACHE_RDLOCK pthread_rwlock_rdlock(&lalH5CacheLock);
+#define LAL_H5_CACHE_WRLOCK pthread_rwlock_wrlock(&lalH5CacheLock);
+#define LAL_H5_CACHE_UNLOCK pthread_rwlock_unlock(&lalH5CacheLock);
+#else
+static int lalH5CacheOnce = 1;
+#define LAL_H5_CACHE_ONCE(init) (lalH5CacheOnce ? (init)(), lalH5CacheOnce = 0 : 0)
+#define LAL_H5_CACHE_RDLOCK
+#define LAL_H5_CACHE_WRLOCK
+#define LAL_H5_CACHE_UNLOCK
+#endif
+
+/* lookups hold only the read lock, so the counters are updated atomically */
+#if defined(__GNUC__)
+#define LAL_H5_CACHE_COUNT(n) __sync_fetch_and_add(&(n), 1)
+#define LAL_H5_CACHE_COUNT_GET(n) __sync_fetch_and_add(&(n), 0)
+#define LAL_H5_CACHE_COUNT_RESET(n) __sync_lock_test_and_set(&(n), 0)
+#elif defined(LAL_PTHREAD_LOCK)
+static pthread_mutex_t lalH5CacheCountLock = PTHREAD_MUTEX_INITIALIZER;
+static size_t XLALH5CacheCountOp(size_t *n, int op)
+{
+	size_t value;
+	pthread_mutex_lock(&lalH5CacheCountLock);
+	value = *n;
+	if (op > 0)
+		++(*n);
+	else if (op < 0)
+		*n = 0;
+	pthread_mutex_unlock(&lalH5CacheCountLock);
+	return value;
+}
+#define LAL_H5_CACHE_COUNT(n) XLALH5CacheCountOp(&(n), 1)
+#define LAL_H5_CACHE_COUNT_GET(n) XLALH5CacheCountOp(&(n), 0)
+#define LAL_H5_CACHE_COUNT_RESET(n) XLALH5CacheCountOp(&(n), -1)
+#else
+#define LAL_H5_CACHE_COUNT(n) ((n)++)
+#define LAL_H5_CACHE_COUNT_GET(n) (n)
+#define LAL_H5_CACHE_COUNT_RESET(n) ((n) = 0)
+#endif
+
+/* identity of a file, to detect that it has been replaced or modified */
+typedef struct tagLALH5CacheFileId {
+	dev_t dev;
+	ino_t ino;
+	off_t size;
+	long long mtime; /* nanoseconds */
+} LALH5CacheFileId;
+
+typedef struct tagLALH5CacheEntry {
+	struct tagLALH5CacheEntry *next;
+	LALH5CacheFileId file;
+	size_t nbytes;
+	void *data;
+	char key[]; /* flexible array member must be last */
+} LALH5CacheEntry;
+
+static LALH5CacheEntry *lalH5CacheHead = NULL;
+static size_t lalH5CacheBytes = 0;
+static size_t lalH5CacheLimit = 0;
+static size_t lalH5CacheHits = 0;
+static size_t lalH5CacheMisses = 0;
+
+/* reads the initial cache size limit, in MiB, from the environment */
+static void XLALH5CacheInit(void)
+{
+	const char *env = getenv("LAL_H5_CACHE");
+	if (env && *env)
+		lalH5CacheLimit = (size_t)strtoul(env, NULL, 10) << 20;
+	return;
+}
+
+static int XLALH5CacheEnabled(void)
+{
+	int enabled;
+	LAL_H5_CACHE_ONCE(XLALH5CacheInit);
+	LAL_H5_CACHE_RDLOCK
+	enabled = lalH5CacheLimit > 0;
+	LAL_H5_CACHE_UNLOCK
+	return enabled;
+}
+
+/* gets the identity of the file fname */
+static int XLALH5CacheGetFileId(LALH5CacheFileId *id, const char *fname)
+{
+	struct stat st;
+	if (stat(fname, &st) < 0)
+		return -1;
+	id->dev = st.st_dev;
+	id->ino = st.st_ino;
+	id->size = st.st_size;
+#ifdef __APPLE__
+	id->mtime = st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+	id->mtime = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+	return 0;
+}
+
+static void XLALH5CacheSetLimitInternal(size_t nbytes)
+{
+	LAL_H5_CACHE_ONCE(XLALH5CacheInit);
+	LAL_H5_CACHE_WRLOCK
+	lalH5CacheLimit = nbytes;
+	LAL_H5_CACHE_UNLOCK
+	return;
+}
+
+static int XLALH5CacheEntryMatches(const LALH5CacheEntry *entry, const char *key, const LALH5CacheFileId *id)
+{
+	return entry->file.dev == id->dev && entry->file.ino == id->ino
+		&& entry->file.size == id->size && entry->file.mtime == id->mtime
+		&& strcmp(entry->key, key) == 0;
+}
+
+/*
+ * returns the entry for key in the file id, or NULL if it is not cached,
+ * and counts the lookup as a hit or a miss
+ */
+static const LALH5CacheEntry * XLALH5CacheFind(const char *key, const LALH5CacheFileId *id)
+{
+	const LALH5CacheEntry *entry;
+	LAL_H5_CACHE_RDLOCK
+	for (entry = lalH5CacheHead; entry; entry = entry->next)
+		if (XLALH5CacheEntryMatches(entry, key, id))
+			break;
+	LAL_H5_CACHE_UNLOCK
+	if (entry)
+		LAL_H5_CACHE_COUNT(lalH5CacheHits);
+	else
+		LAL_H5_CACHE_COUNT(lalH5CacheMisses);
+	return entry;
+}
+
+/*
+ * inserts a copy of data as the entry for key in the file id, unless the
+ * cache would then exceed its limit or another thread got there first;
+ * failure to insert is not an error
+ */
+static void XLALH5CacheInsert(const char *key, const LALH5CacheFileId *id, const void *data, size_t nbytes)
+{
+	const LALH5CacheEntry *other;
+	LALH5CacheEntry *entry;
+	size_t keylen;
+
+	/* copy the data before taking the lock */
+	keylen = strlen(key);
+	entry = malloc(sizeof(*entry) + keylen + 1);
+	if (!entry)
+		return;
+	entry->data = malloc(nbytes > 0 ? nbytes : 1);
+	if (!entry->data) {
+		free(entry);
+		return;
+	}
+	memcpy(entry->data, data, nbytes);
+	memcpy(entry->key, key, keylen + 1);
+	entry->file = *id;
+	entry->nbytes = nbytes;
+
+	LAL_H5_CACHE_WRLOCK
+	for (other = lalH5CacheHead; other; other = other->next)
+		if (XLALH5CacheEntryMatches(other, key, id))
+			break;
+	if (other == NULL && lalH5CacheBytes + nbytes <= lalH5CacheLimit) {
+		entry->next = lalH5CacheHead;
+		lalH5CacheHead = entry;
+		lalH5CacheBytes += nbytes;
+		entry = NULL;
+	}
+	LAL_H5_CACHE_UNLOCK
+
+	if (entry) {
+		free(entry->data);
+		free(entry);
+	}
+	return;
+}
+
+static void XLALH5CacheClearInternal(void)
+{
+	LALH5CacheEntry *entry;
+	LAL_H5_CACHE_WRLOCK
+	entry = lalH5CacheHead;
+	while (entry) {
+		LALH5CacheEntry *next = entry->next;
+		free(entry->data);
+		free(entry);
+		entry = next;
+	}
+	lalH5CacheHead = NULL;
+	lalH5CacheBytes = 0;
+	LAL_H5_CACHE_UNLOCK
+	LAL_H5_CACHE_COUNT_RESET(lalH5CacheHits);
+	LAL_H5_CACHE_COUNT_RESET(lalH5CacheMisses);
+	return;
+}
+
+static size_t XLALH5CacheQueryHitsInternal(void)
+{
+	return LAL_H5_CACHE_COUNT_GET(lalH5CacheHits);
+}
+
+static size_t XLALH5CacheQueryMissesInternal(void)
+{
+	return LAL_H5_CACHE_COUNT_GET(lalH5CacheMisses);
+}
+
+#undef LAL_H5_CACHE_ONCE
+#undef LAL_H5_CACHE_RDLOCK
+#undef LAL_H5_CACHE_WRLOCK
+#undef LAL_H5_CACHE_UNLOCK
+#undef LAL_H5_CACHE_COUNT
+#undef LAL_H5_CACHE_COUNT_GET
+#undef LAL_H5_CACHE_COUNT_RESET
+
+#endif /* HAVE_HDF5 */
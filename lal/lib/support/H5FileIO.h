@@ -133,7 +133,10 @@ void XLALH5DatasetFree(LALH5Dataset *dset);
 
 LALH5Dataset * XLALH5DatasetAlloc(LALH5File *file, const char *name, LALTYPECODE dtype, UINT4Vector *dimLength);
 LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File *file, const char *name, LALTYPECODE dtype, size_t length);
+LALH5Dataset * XLALH5DatasetAllocChunked(LALH5File *file, const char *name, LALTYPECODE dtype, UINT4Vector *dimLength, UINT4Vector *chunkLength, int deflate, int shuffle);
 int XLALH5DatasetWrite(LALH5Dataset *dset, void *data);
+int XLALH5DatasetWriteSlab(LALH5Dataset *dset, const void *data, const UINT4Vector *offset, const UINT4Vector *count);
+int XLALH5DatasetAppend(LALH5Dataset *dset, const void *data, size_t length);
 
 /* these routines are deprecated */
 int XLALH5FileGetDatasetNames(LALH5File *file, char *** names, UINT4 *N);
@@ -155,6 +158,12 @@ LALTYPECODE XLALH5DatasetQueryType(LALH5Dataset *dset);
 int XLALH5DatasetQueryNDim(LALH5Dataset *dset);
 UINT4Vector * XLALH5DatasetQueryDims(LALH5Dataset *dset);
 int XLALH5DatasetQueryData(void *data, LALH5Dataset *dset);
+int XLALH5DatasetQueryDataSlab(void *data, LALH5Dataset *dset, const UINT4Vector *offset, const UINT4Vector *count);
+
+void XLALH5CacheSetLimit(size_t nbytes);
+void XLALH5CacheClear(void);
+size_t XLALH5CacheQueryHits(void);
+size_t XLALH5CacheQueryMisses(void);
 
 /* these routines are deprecated */
 int XLALH5DatasetAddScalarAttribute(LALH5Dataset *dset, const char *key, const void *value, LALTYPECODE dtype);
@@ -31,6 +31,9 @@
 /* replace HDF5 routines with threadsafe versions, if necessary */
 #include "H5ThreadSafe.c"
 
+/* cache of the contents of datasets in files opened for reading */
+#include "H5DatasetCache.c"
+
 #define LAL_H5_FILE_MODE_READ  H5F_ACC_RDONLY
 #define LAL_H5_FILE_MODE_WRITE H5F_ACC_TRUNC
 
@@ -50,6 +53,9 @@ struct tagLALH5Dataset {
 	hid_t parent_id;
 	hid_t space_id;
 	hid_t dtype_id; /* note: this is the in-memory type */
+	char *cachekey; /* file name and path of a dataset in a file opened for reading, or NULL if not cacheable */
+	LALH5CacheFileId cachefile; /* identity of the file when the dataset was opened */
+	size_t cachenbytes; /* size of the dataset contents */
 	char name[]; /* flexible array member must be last */
 };
 
@@ -337,6 +343,136 @@ static LALH5File * XLALH5FileOpenRead(const char *path)
 	return file;
 }
 
+/*
+ * selects the hyperslab of the dataspace @p space_id starting at @p offset
+ * with @p count points along each dimension; returns a copy of the dataspace
+ * with the selection in @p filespace_id and a matching contiguous memory
+ * dataspace in @p memspace_id; use H5Sclose() to free both
+ */
+static int XLALH5DataspaceSelectSlab(hid_t *filespace_id, hid_t *memspace_id, hid_t space_id, const UINT4Vector *offset, const UINT4Vector *count)
+{
+	hsize_t *dims;
+	hsize_t *start;
+	hsize_t *block;
+	int rank;
+	int dim;
+
+	rank = threadsafe_H5Sget_simple_extent_ndims(space_id);
+	if (rank < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read rank of dataspace");
+	if (offset->length != (UINT4)rank || count->length != (UINT4)rank)
+		XLAL_ERROR(XLAL_EBADLEN, "Hyperslab has rank %u but dataspace has rank %d", offset->length, rank);
+
+	dims = LALCalloc(3 * rank, sizeof(*dims));
+	if (!dims)
+		XLAL_ERROR(XLAL_ENOMEM);
+	start = dims + rank;
+	block = start + rank;
+
+	if (threadsafe_H5Sget_simple_extent_dims(space_id, dims, NULL) < 0) {
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not read dimensions of dataspace");
+	}
+	for (dim = 0; dim < rank; ++dim) {
+		start[dim] = offset->data[dim];
+		block[dim] = count->data[dim];
+		if (start[dim] + block[dim] > dims[dim]) {
+			unsigned long long length = dims[dim];
+			LALFree(dims);
+			XLAL_ERROR(XLAL_EDOM, "Hyperslab [%u, %u) exceeds dimension %d of length %llu", offset->data[dim], offset->data[dim] + count->data[dim], dim, length);
+		}
+	}
+
+	*filespace_id = threadsafe_H5Scopy(space_id);
+	if (*filespace_id < 0) {
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not copy dataspace");
+	}
+	if (threadsafe_H5Sselect_hyperslab(*filespace_id, H5S_SELECT_SET, start, NULL, block, NULL) < 0) {
+		threadsafe_H5Sclose(*filespace_id);
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not select hyperslab of dataspace");
+	}
+
+	*memspace_id = threadsafe_H5Screate_simple(rank, block, NULL);
+	LALFree(dims);
+	if (*memspace_id < 0) {
+		threadsafe_H5Sclose(*filespace_id);
+		XLAL_ERROR(XLAL_EIO, "Could not create memory dataspace");
+	}
+
+	return 0;
+}
+
+/*
+ * records the cache key, file identity and size of a dataset in a file
+ * opened for reading, so that reads through the dataset cache need no
+ * HDF5 calls or stat() when the data is cached; the dataset is left
+ * uncacheable if the cache is disabled or if any of these cannot be found
+ */
+static void XLALH5DatasetInitCache(LALH5Dataset *dset)
+{
+	char fname[FILENAME_MAX];
+	char *key;
+	ssize_t fnamelen;
+	ssize_t pathlen;
+	size_t nbytes;
+	int saveErrno;
+
+	/* nothing to record if the cache is disabled */
+	if (!XLALH5CacheEnabled())
+		return;
+
+	/* key is the file name and the absolute path of the dataset */
+	fnamelen = threadsafe_H5Fget_name(dset->dataset_id, fname, sizeof(fname));
+	if (fnamelen < 0 || (size_t)fnamelen >= sizeof(fname))
+		return;
+	if (XLALH5CacheGetFileId(&dset->cachefile, fname) < 0)
+		return;
+	pathlen = threadsafe_H5Iget_name(dset->dataset_id, NULL, 0);
+	if (pathlen < 0)
+		return;
+	saveErrno = xlalErrno;
+	nbytes = XLALH5DatasetQueryNBytes(dset);
+	if (nbytes == (size_t)(-1)) {
+		xlalErrno = saveErrno;
+		return;
+	}
+	key = LALMalloc(fnamelen + pathlen + 2);
+	if (!key)
+		return;
+	snprintf(key, fnamelen + 2, "%s:", fname);
+	if (threadsafe_H5Iget_name(dset->dataset_id, key + fnamelen + 1, pathlen + 1) < 0) {
+		LALFree(key);
+		return;
+	}
+	dset->cachekey = key;
+	dset->cachenbytes = nbytes;
+	return;
+}
+
+/*
+ * reads the contents of a dataset in a file opened for reading through
+ * the dataset cache: the data is copied from the cache if it is there,
+ * otherwise it is read from the file and then added to the cache
+ */
+static int XLALH5DatasetQueryCachedData(void *data, LALH5Dataset *dset)
+{
+	const LALH5CacheEntry *entry;
+
+	/* entries are immutable, so the copy needs no lock */
+	entry = XLALH5CacheFind(dset->cachekey, &dset->cachefile);
+	if (entry && entry->nbytes == dset->cachenbytes) {
+		memcpy(data, entry->data, dset->cachenbytes);
+		return 0;
+	}
+
+	if (threadsafe_H5Dread(dset->dataset_id, dset->dtype_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read data from dataset");
+	XLALH5CacheInsert(dset->cachekey, &dset->cachefile, data, dset->cachenbytes);
+	return 0;
+}
+
 #if 0
 static hid_t XLALGetObjectIdentifier(const void *ptr)
 {
@@ -921,6 +1057,7 @@ void XLALH5DatasetFree(LALH5Dataset UNUSED *dset)
 		threadsafe_H5Tclose(dset->dtype_id);
 		threadsafe_H5Sclose(dset->space_id);
 		threadsafe_H5Dclose(dset->dataset_id);
+		LALFree(dset->cachekey);
 		LALFree(dset);
 	}
 	return;
@@ -1084,6 +1221,156 @@ LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File UNUSED *file, const char UNUSED *n
 #endif
 }
 
+/**
+ * @brief Allocates a chunked, extendible, multi-dimensional ::LALH5Dataset
+ * @details
+ * Creates a new HDF5 dataset with name @p name within a HDF5 file
+ * associated with the ::LALH5File @p file structure and allocates a
+ * ::LALH5Dataset structure associated with the dataset, as with
+ * XLALH5DatasetAlloc().  Unlike XLALH5DatasetAlloc(), the dataset is
+ * stored in chunks whose dimensions are given by the UINT4Vector
+ * @p chunkLength, and the chunks can be compressed.  The first
+ * dimension of the dataset is unlimited, so the dataset can be extended
+ * with XLALH5DatasetAppend(); in that case the initial length of the
+ * first dimension in @p dimLength is typically zero.
+ *
+ * If @p chunkLength is \c NULL then each chunk spans all but the first
+ * dimension of the dataset, and enough points of the first dimension
+ * to make chunks of roughly 64 KiB.
+ *
+ * Chunking allows parts of a dataset to be read with
+ * XLALH5DatasetQueryDataSlab() without reading (and decompressing) the
+ * whole dataset, so chunks should be chosen to match the hyperslabs that
+ * will later be read.
+ *
+ * The ::LALH5File @p file passed to this routine must be a file
+ * opened for writing.
+ *
+ * @param file Pointer to a ::LALH5File structure in which to create the dataset.
+ * @param name Pointer to a string with the name of the dataset to create.
+ * @param dtype \c LALTYPECODE value specifying the data type.
+ * @param dimLength Pointer to a UINT4Vector specifying the initial dataspace
+ * dimensions.
+ * @param chunkLength Pointer to a UINT4Vector specifying the chunk
+ * dimensions, or \c NULL to choose them automatically.
+ * @param deflate Level (1 to 9) of gzip compression of each chunk, or 0
+ * for no compression.
+ * @param shuffle If non-zero, apply the byte shuffle filter before
+ * compression, which usually improves compression of numerical data.
+ * @returns A pointer to a ::LALH5Dataset structure associated with the
+ * specified dataset within a HDF5 file.
+ * @retval NULL An error occurred creating the dataset.
+ */
+LALH5Dataset * XLALH5DatasetAllocChunked(LALH5File UNUSED *file, const char UNUSED *name, LALTYPECODE UNUSED dtype, UINT4Vector UNUSED *dimLength, UINT4Vector UNUSED *chunkLength, int UNUSED deflate, int UNUSED shuffle)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	const size_t chunk_bytes = 65536;
+	LALH5Dataset *dset;
+	hsize_t *dims;
+	hsize_t *maxdims;
+	hsize_t *chunk;
+	hid_t dcpl_id;
+	size_t chunk_points;
+	UINT4 dim;
+	size_t namelen;
+
+	if (name == NULL || file == NULL || dimLength == NULL)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
+	if (dimLength->length == 0)
+		XLAL_ERROR_NULL(XLAL_EBADLEN, "Chunked dataset must have rank of at least one");
+	if (chunkLength && chunkLength->length != dimLength->length)
+		XLAL_ERROR_NULL(XLAL_EBADLEN, "Chunk rank must equal dataspace rank");
+	if (deflate < 0 || deflate > 9)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Compression level must be between 0 and 9");
+
+	namelen = strlen(name);
+	dset = LALCalloc(1, sizeof(*dset) + namelen + 1);  /* use flexible array member to record name */
+	if (!dset)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+	/* create datatype */
+	dset->dtype_id = XLALH5TypeFromLALType(dtype);
+	if (dset->dtype_id < 0) {
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	/* copy dimensions to HDF5 type; first dimension is unlimited */
+	dims = LALCalloc(3 * dimLength->length, sizeof(*dims));
+	if (!dims) {
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	maxdims = dims + dimLength->length;
+	chunk = maxdims + dimLength->length;
+	for (dim = 0; dim < dimLength->length; ++dim)
+		maxdims[dim] = dims[dim] = dimLength->data[dim];
+	maxdims[0] = H5S_UNLIMITED;
+
+	/* determine chunk dimensions */
+	if (chunkLength) {
+		for (dim = 0; dim < dimLength->length; ++dim)
+			chunk[dim] = chunkLength->data[dim];
+	} else {
+		chunk_points = chunk_bytes / threadsafe_H5Tget_size(dset->dtype_id);
+		for (dim = 1; dim < dimLength->length; ++dim) {
+			chunk[dim] = dims[dim] > 0 ? dims[dim] : 1;
+			chunk_points /= chunk[dim];
+		}
+		chunk[0] = chunk_points > 0 ? chunk_points : 1;
+	}
+
+	/* create dataset creation property list */
+	dcpl_id = threadsafe_H5Pcreate(H5P_DATASET_CREATE);
+	if (dcpl_id < 0) {
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dims);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create property list for dataset `%s'", name);
+	}
+	if (threadsafe_H5Pset_chunk(dcpl_id, dimLength->length, chunk) < 0
+		|| (shuffle && threadsafe_H5Pset_shuffle(dcpl_id) < 0)
+		|| (deflate && threadsafe_H5Pset_deflate(dcpl_id, deflate) < 0)) {
+		threadsafe_H5Pclose(dcpl_id);
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dims);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not set chunking and filters for dataset `%s'", name);
+	}
+
+	/* create dataspace */
+	dset->space_id = threadsafe_H5Screate_simple(dimLength->length, dims, maxdims);
+	LALFree(dims);
+	if (dset->space_id < 0) {
+		threadsafe_H5Pclose(dcpl_id);
+		threadsafe_H5Tclose(dset->dtype_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create dataspace for dataset `%s'", name);
+	}
+
+	/* create dataset */
+	dset->dataset_id = threadsafe_H5Dcreate2(file->file_id, name, dset->dtype_id, dset->space_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+	threadsafe_H5Pclose(dcpl_id);
+	if (dset->dataset_id < 0) {
+		threadsafe_H5Tclose(dset->dtype_id);
+		threadsafe_H5Sclose(dset->space_id);
+		LALFree(dset);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not create dataset `%s'", name);
+	}
+
+	/* record name of dataset and parent id */
+	snprintf(dset->name, namelen + 1, "%s", name);
+	dset->parent_id = file->file_id;
+
+	return dset;
+#endif
+}
+
 /**
  * @brief Writes data to a ::LALH5Dataset
  * @details
@@ -1107,6 +1394,135 @@ int XLALH5DatasetWrite(LALH5Dataset UNUSED *dset, void UNUSED *data)
 #endif
 }
 
+/**
+ * @brief Writes data to a hyperslab of a ::LALH5Dataset
+ * @details
+ * Writes the data contained in @p data to the hyperslab of the HDF5
+ * dataset associated with the ::LALH5Dataset @p dset structure that
+ * starts at the indices given by the UINT4Vector @p offset and spans
+ * the number of points given by the UINT4Vector @p count along each
+ * dimension.  The buffer @p data is a contiguous array with dimensions
+ * @p count.
+ * @param dset Pointer to a ::LALH5Dataset structure to which to write the data.
+ * @param data Pointer to the data buffer to be written.
+ * @param offset Pointer to a UINT4Vector giving the first index of the
+ * hyperslab along each dimension.
+ * @param count Pointer to a UINT4Vector giving the length of the hyperslab
+ * along each dimension.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetWriteSlab(LALH5Dataset UNUSED *dset, const void UNUSED *data, const UINT4Vector UNUSED *offset, const UINT4Vector UNUSED *count)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hid_t filespace_id;
+	hid_t memspace_id;
+	herr_t status;
+
+	if (dset == NULL || data == NULL || offset == NULL || count == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	if (XLALH5DataspaceSelectSlab(&filespace_id, &memspace_id, dset->space_id, offset, count) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	status = threadsafe_H5Dwrite(dset->dataset_id, dset->dtype_id, memspace_id, filespace_id, H5P_DEFAULT, data);
+	threadsafe_H5Sclose(memspace_id);
+	threadsafe_H5Sclose(filespace_id);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not write data to dataset");
+	return 0;
+#endif
+}
+
+/**
+ * @brief Appends data to an extendible ::LALH5Dataset
+ * @details
+ * Extends the first dimension of the HDF5 dataset associated with the
+ * ::LALH5Dataset @p dset structure by @p length points and writes the
+ * data contained in @p data to the new points.  The buffer @p data is a
+ * contiguous array whose first dimension is @p length and whose other
+ * dimensions are those of the dataset.
+ *
+ * The dataset must have been created with XLALH5DatasetAllocChunked().
+ * @param dset Pointer to a ::LALH5Dataset structure to which to append the data.
+ * @param data Pointer to the data buffer to be appended.
+ * @param length The number of points along the first dimension to append.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetAppend(LALH5Dataset UNUSED *dset, const void UNUSED *data, size_t UNUSED length)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	UINT4Vector *offset;
+	UINT4Vector *count;
+	hsize_t *dims;
+	hid_t space_id;
+	int rank;
+	int dim;
+	int status;
+
+	if (dset == NULL || data == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	if (length == 0)
+		return 0;
+
+	rank = threadsafe_H5Sget_simple_extent_ndims(dset->space_id);
+	if (rank <= 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read rank of dataspace");
+
+	dims = LALCalloc(rank, sizeof(*dims));
+	if (!dims)
+		XLAL_ERROR(XLAL_ENOMEM);
+	if (threadsafe_H5Sget_simple_extent_dims(dset->space_id, dims, NULL) < 0) {
+		LALFree(dims);
+		XLAL_ERROR(XLAL_EIO, "Could not read dimensions of dataspace");
+	}
+
+	/* the new points start at the old end of the first dimension */
+	offset = XLALCreateUINT4Vector(rank);
+	count = XLALCreateUINT4Vector(rank);
+	if (!offset || !count) {
+		XLALDestroyUINT4Vector(count);
+		XLALDestroyUINT4Vector(offset);
+		LALFree(dims);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	for (dim = 0; dim < rank; ++dim) {
+		offset->data[dim] = 0;
+		count->data[dim] = dims[dim];
+	}
+	offset->data[0] = dims[0];
+	count->data[0] = length;
+
+	/* extend dataset and refresh its dataspace */
+	dims[0] += length;
+	status = threadsafe_H5Dset_extent(dset->dataset_id, dims);
+	LALFree(dims);
+	if (status < 0) {
+		XLALDestroyUINT4Vector(count);
+		XLALDestroyUINT4Vector(offset);
+		XLAL_ERROR(XLAL_EIO, "Could not extend dataset `%s'", dset->name);
+	}
+	space_id = threadsafe_H5Dget_space(dset->dataset_id);
+	if (space_id < 0) {
+		XLALDestroyUINT4Vector(count);
+		XLALDestroyUINT4Vector(offset);
+		XLAL_ERROR(XLAL_EIO, "Could not read dataspace of dataset `%s'", dset->name);
+	}
+	threadsafe_H5Sclose(dset->space_id);
+	dset->space_id = space_id;
+
+	status = XLALH5DatasetWriteSlab(dset, data, offset, count);
+	XLALDestroyUINT4Vector(count);
+	XLALDestroyUINT4Vector(offset);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+#endif
+}
+
 /**
  * @brief Reads a ::LALH5Dataset
  * @details
@@ -1173,6 +1589,7 @@ LALH5Dataset * XLALH5DatasetRead(LALH5File UNUSED *file, const char UNUSED *name
 	/* record name of dataset and parent id */
 	snprintf(dset->name, namelen + 1, "%s", name);
 	dset->parent_id = file->file_id;
+	XLALH5DatasetInitCache(dset);
 	return dset;
 #endif
 }
@@ -1323,6 +1740,11 @@ UINT4Vector * XLALH5DatasetQueryDims(LALH5Dataset UNUSED *dset)
  * @p data.  This buffer should be sufficiently large to hold
  * the entire contents of the dataset; this size can be determined
  * with the routine XLALH5DatasetQueryNBytes().
+ *
+ * If the dataset cache is enabled (see XLALH5CacheSetLimit()) both when
+ * @p dset was opened with XLALH5DatasetRead() and now, the data is copied from
+ * the cache without calling the HDF5 library if the dataset has been
+ * read before, and is added to the cache otherwise.
  * @param data Pointer to a memory in which to store the data.
  * @param dset Pointer to a ::LALH5Dataset from which to extract the data.
  * @retval 0 Success.
@@ -1335,6 +1757,11 @@ int XLALH5DatasetQueryData(void UNUSED *data, LALH5Dataset UNUSED *dset)
 #else
 	if (data == NULL || dset == NULL)
 		XLAL_ERROR(XLAL_EFAULT);
+	if (dset->cachekey && XLALH5CacheEnabled()) {
+		if (XLALH5DatasetQueryCachedData(data, dset) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		return 0;
+	}
 	if (threadsafe_H5Dread(dset->dataset_id, dset->dtype_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0) {
 		LALFree(data);
 		XLAL_ERROR(XLAL_EIO, "Could not read data from dataset");
@@ -1343,6 +1770,145 @@ int XLALH5DatasetQueryData(void UNUSED *data, LALH5Dataset UNUSED *dset)
 #endif
 }
 
+/**
+ * @brief Gets the data contained in a hyperslab of a ::LALH5Dataset
+ * @details
+ * This routine reads the hyperslab of a HDF5 dataset associated with
+ * the ::LALH5Dataset @p dset that starts at the indices given by the
+ * UINT4Vector @p offset and spans the number of points given by the
+ * UINT4Vector @p count along each dimension, and stores the data in the
+ * buffer @p data as a contiguous array with dimensions @p count.  Only
+ * the chunks of the dataset that overlap the hyperslab are read from
+ * the file, so this is much cheaper than XLALH5DatasetQueryData() when
+ * only part of a large dataset is needed.
+ *
+ * For example, to read points 1000 to 1999 of row 2 of a two-dimensional
+ * dataset:
+ * @code
+ * UINT4Vector *offset = XLALCreateUINT4Vector(2);
+ * UINT4Vector *count = XLALCreateUINT4Vector(2);
+ * REAL8 data[1000];
+ * offset->data[0] = 2;
+ * offset->data[1] = 1000;
+ * count->data[0] = 1;
+ * count->data[1] = 1000;
+ * XLALH5DatasetQueryDataSlab(data, dset, offset, count);
+ * @endcode
+ * @param data Pointer to a memory in which to store the data.
+ * @param dset Pointer to a ::LALH5Dataset from which to extract the data.
+ * @param offset Pointer to a UINT4Vector giving the first index of the
+ * hyperslab along each dimension.
+ * @param count Pointer to a UINT4Vector giving the length of the hyperslab
+ * along each dimension.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5DatasetQueryDataSlab(void UNUSED *data, LALH5Dataset UNUSED *dset, const UINT4Vector UNUSED *offset, const UINT4Vector UNUSED *count)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hid_t filespace_id;
+	hid_t memspace_id;
+	herr_t status;
+
+	if (data == NULL || dset == NULL || offset == NULL || count == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	if (XLALH5DataspaceSelectSlab(&filespace_id, &memspace_id, dset->space_id, offset, count) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	status = threadsafe_H5Dread(dset->dataset_id, dset->dtype_id, memspace_id, filespace_id, H5P_DEFAULT, data);
+	threadsafe_H5Sclose(memspace_id);
+	threadsafe_H5Sclose(filespace_id);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read data from dataset");
+	return 0;
+#endif
+}
+
+/**
+ * @brief Sets the size limit of the dataset cache
+ * @details
+ * The dataset cache holds the contents of datasets in files opened for
+ * reading, as read by XLALH5DatasetQueryData() and the routines built on
+ * it (such as XLALH5FileReadREAL8Vector()).  The first read of a dataset
+ * goes through the HDF5 library; later reads of the same dataset, from
+ * any thread, are copied from the cache without calling the HDF5
+ * library, and so do not wait on the lock that serializes calls to the
+ * HDF5 library when it is not threadsafe.  This is useful when several
+ * threads load the same reduced-order-model or surrogate data.
+ *
+ * Datasets are added to the cache until it holds @p nbytes bytes of data;
+ * a limit of zero (the default) disables the cache.  The initial limit
+ * can also be set, in MiB, with the environment variable
+ * <tt>LAL_H5_CACHE</tt>.  Cached data is not used if the file it was read
+ * from has since been replaced or modified.  Datasets opened while the
+ * cache is disabled are never read through it.
+ * @param nbytes Maximum number of bytes of data held in the cache.
+ */
+void XLALH5CacheSetLimit(size_t UNUSED nbytes)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR_VOID(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	XLALH5CacheSetLimitInternal(nbytes);
+	return;
+#endif
+}
+
+/**
+ * @brief Frees all data held in the dataset cache
+ * @details
+ * This routine must not be called while other threads may be reading
+ * datasets.  It also resets the counts returned by XLALH5CacheQueryHits()
+ * and XLALH5CacheQueryMisses().  It does not change the size limit of the
+ * cache; see XLALH5CacheSetLimit().
+ */
+void XLALH5CacheClear(void)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR_VOID(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	XLALH5CacheClearInternal();
+	return;
+#endif
+}
+
+/**
+ * @brief Gets the number of reads served from the dataset cache
+ * @details
+ * Returns the number of reads through the dataset cache, since the
+ * program started or since the last call to XLALH5CacheClear(), that
+ * found the data in the cache.
+ * @returns The number of cache hits.
+ * @retval (size_t)(-1) Failure.
+ */
+size_t XLALH5CacheQueryHits(void)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	return XLALH5CacheQueryHitsInternal();
+#endif
+}
+
+/**
+ * @brief Gets the number of reads not served from the dataset cache
+ * @details
+ * Returns the number of reads through the dataset cache, since the
+ * program started or since the last call to XLALH5CacheClear(), that
+ * did not find the data in the cache and so read it from the file.
+ * @returns The number of cache misses.
+ * @retval (size_t)(-1) Failure.
+ */
+size_t XLALH5CacheQueryMisses(void)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	return XLALH5CacheQueryMissesInternal();
+#endif
+}
+
 /** @} */
 
 /**
@@ -3094,7 +3660,8 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 #ifndef HAVE_HDF5
 	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
 #else
-	const size_t chunk_size = 32;
+	const size_t chunk_bytes = 65536;
+	size_t chunk_size;
 	hid_t dtype_id[ncols];
 	hid_t tdtype_id;
 	size_t col;
@@ -3115,6 +3682,11 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 			XLAL_ERROR_NULL(XLAL_EFUNC);
 	}
 
+	/* chunks of roughly 64 KiB, but at least 32 rows */
+	chunk_size = rowsz > 0 ? chunk_bytes / rowsz : 0;
+	if (chunk_size < 32)
+		chunk_size = 32;
+
 	/* make empty table */
 	/* note: table title and dataset name are the same */
 	status = threadsafe_H5TBmake_table(name, file->file_id, name, ncols, 0, rowsz, cols, offsets, dtype_id, chunk_size, NULL, 0, NULL);
@@ -3388,11 +3960,93 @@ int XLALH5TableReadColumns(void UNUSED *data, const LALH5Dataset UNUSED *dset, c
 #ifndef HAVE_HDF5
 	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
 #else
-	if (data == NULL || dset == NULL || offsets == NULL || colsz == NULL)
+	hid_t memtype_id;
+	hid_t filespace_id;
+	hid_t memspace_id;
+	hsize_t start = row0;
+	hsize_t count = nrows;
+	const char *name = cols;
+	herr_t status;
+	int ncols;
+	int pos;
+	size_t col;
+
+	if (data == NULL || dset == NULL || cols == NULL || offsets == NULL || colsz == NULL)
 		XLAL_ERROR(XLAL_EFAULT);
 
-	if (threadsafe_H5TBread_fields_name(dset->parent_id, dset->name, cols, row0, nrows, rowsz, offsets, colsz, data) < 0)
-		XLAL_ERROR(XLAL_EIO);
+	if (nrows == 0)
+		return 0;
+
+	ncols = threadsafe_H5Tget_nmembers(dset->dtype_id);
+	if (ncols < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read type members");
+
+	/* build the memory type by column name rather than with
+	 * H5TBread_fields_name(), which pairs the offsets with the members in
+	 * the order of the file's type;  HDF5 sorts those by offset the first
+	 * time it converts the type, so the pairing could change from one
+	 * read to the next while the dataset is open */
+	memtype_id = threadsafe_H5Tcreate(H5T_COMPOUND, rowsz);
+	if (memtype_id < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not create memory type");
+	for (col = 0; *name != '\0'; ++col) {
+		size_t len = strcspn(name, ",");
+		int found = 0;
+		for (pos = 0; pos < ncols && !found; ++pos) {
+			char *member = threadsafe_H5Tget_member_name(dset->dtype_id, pos);
+			hid_t member_type_id;
+			if (member == NULL)
+				break;
+			if (strlen(member) != len || strncmp(member, name, len) != 0) {
+				free(member);
+				continue;
+			}
+			found = 1;
+			member_type_id = threadsafe_H5Tget_member_type(dset->dtype_id, pos);
+			if (member_type_id < 0)
+				found = -1;
+			else {
+				if ((threadsafe_H5Tget_size(member_type_id) != colsz[col] && threadsafe_H5Tset_size(member_type_id, colsz[col]) < 0)
+				    || threadsafe_H5Tinsert(memtype_id, member, offsets[col], member_type_id) < 0)
+					found = -1;
+				threadsafe_H5Tclose(member_type_id);
+			}
+			free(member);
+		}
+		if (found <= 0) {
+			threadsafe_H5Tclose(memtype_id);
+			if (found == 0)
+				XLAL_ERROR(XLAL_EINVAL, "Column `%.*s' does not exist", (int)len, name);
+			XLAL_ERROR(XLAL_EIO, "Could not create memory type");
+		}
+		name += len;
+		if (*name == ',')
+			++name;
+	}
+
+	filespace_id = threadsafe_H5Dget_space(dset->dataset_id);
+	if (filespace_id < 0) {
+		threadsafe_H5Tclose(memtype_id);
+		XLAL_ERROR(XLAL_EIO, "Could not read dataspace");
+	}
+	if (threadsafe_H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) {
+		threadsafe_H5Sclose(filespace_id);
+		threadsafe_H5Tclose(memtype_id);
+		XLAL_ERROR(XLAL_EIO, "Could not select hyperslab of dataspace");
+	}
+	memspace_id = threadsafe_H5Screate_simple(1, &count, NULL);
+	if (memspace_id < 0) {
+		threadsafe_H5Sclose(filespace_id);
+		threadsafe_H5Tclose(memtype_id);
+		XLAL_ERROR(XLAL_EIO, "Could not create memory dataspace");
+	}
+
+	status = threadsafe_H5Dread(dset->dataset_id, memtype_id, memspace_id, filespace_id, H5P_DEFAULT, data);
+	threadsafe_H5Sclose(memspace_id);
+	threadsafe_H5Sclose(filespace_id);
+	threadsafe_H5Tclose(memtype_id);
+	if (status < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read data");
 
 	return 0;
 #endif
@@ -0,0 +1,241 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/ComplexFFT.h>
+#include <lal/VectorMath.h>
+#include <lal/TriggerInterpolation.h>
+#include <lal/MatchedFilter.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * \addtogroup MatchedFilter_h
+ * @{
+ */
+
+/* buffers used by one thread */
+typedef struct tagMatchedFilterLane {
+  COMPLEX8VectorAligned *zf;            /* frequency-domain product */
+  COMPLEX8VectorAligned *zt;            /* SNR time series */
+  COMPLEX8 *y;                          /* samples around the peak */
+  LanczosTriggerInterpolant *interp;
+} MatchedFilterLane;
+
+struct tagMatchedFilterWorkspace {
+  UINT4 length;
+  UINT4 window;
+  UINT4 nlanes;
+  COMPLEX8FFTPlan *plan;
+  MatchedFilterLane *lane;
+};
+
+/* compute the unnormalised SNR time series of one template into lane->zt */
+static int MatchedFilterLaneSNR( MatchedFilterWorkspace *ws, MatchedFilterLane *lane, const COMPLEX8Vector *data, const COMPLEX8Vector *tmplt )
+{
+  COMPLEX8Vector zf = { ws->length, lane->zf->data };
+  COMPLEX8Vector zt = { ws->length, lane->zt->data };
+  UINT4 n = ws->length;
+  if ( data->length < n )
+    n = data->length;
+  if ( tmplt->length < n )
+    n = tmplt->length;
+
+  XLAL_CHECK( XLALVectorMultiplyConjCOMPLEX8( zf.data, data->data, tmplt->data, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+  memset( zf.data + n, 0, ( ws->length - n ) * sizeof( *zf.data ) );
+  XLAL_CHECK( XLALCOMPLEX8VectorFFT( &zt, &zf, ws->plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/* find and interpolate the peak of |lane->zt| in [first, last) */
+static void MatchedFilterLanePeak( MatchedFilterWorkspace *ws, MatchedFilterLane *lane, UINT4 first, UINT4 last, REAL4 norm, MatchedFilterPeak *peak )
+{
+  const COMPLEX8 *z = lane->zt->data;
+  UINT4 imax = first;
+  REAL4 zmax = -1;
+  UINT4 i;
+
+  for ( i = first; i < last; ++i ) {
+    REAL4 z2 = crealf( z[i] ) * crealf( z[i] ) + cimagf( z[i] ) * cimagf( z[i] );
+    if ( z2 > zmax ) {
+      zmax = z2;
+      imax = i;
+    }
+  }
+
+  peak->index = imax;
+  peak->snr = norm * z[imax];
+
+  if ( lane->interp ) {
+    /* the SNR time series is periodic, so wrap around its ends */
+    const INT4 w = ws->window;
+    const INT4 N = ws->length;
+    double tmax;
+    COMPLEX8 ymax;
+    INT4 k;
+    for ( k = -w; k <= w; ++k )
+      lane->y[k + w] = z[( ( (INT4) imax + k ) % N + N ) % N];
+    /* on failure, keep the loudest sample */
+    if ( XLALCOMPLEX8ApplyLanczosTriggerInterpolant( lane->interp, &tmax, &ymax, &lane->y[w] ) == 0 ) {
+      peak->index = imax + tmax;
+      peak->snr = norm * ymax;
+    }
+  }
+}
+
+/**
+ * Create a workspace for matched filtering with SNR time series of
+ * \c length samples.  If \c window is non-zero, the peaks returned by
+ * XLALMatchedFilterPeaksCOMPLEX8() are interpolated with a Lanczos
+ * trigger interpolant using \c window samples either side of the loudest
+ * sample; otherwise the loudest sample is returned.  \c measurelvl is the
+ * measure level passed to XLALCreateReverseCOMPLEX8FFTPlan().
+ *
+ * Buffers are allocated for as many threads as OpenMP may use.
+ */
+MatchedFilterWorkspace *XLALCreateMatchedFilterWorkspace( UINT4 length, UINT4 window, int measurelvl )
+{
+  MatchedFilterWorkspace *ws;
+  UINT4 l;
+
+  XLAL_CHECK_NULL( length > 0, XLAL_EINVAL, "Length must be positive" );
+  XLAL_CHECK_NULL( 2 * window + 1 <= length, XLAL_EINVAL, "Interpolation window %u is too long for length %u", window, length );
+
+  ws = LALCalloc( 1, sizeof( *ws ) );
+  XLAL_CHECK_NULL( ws, XLAL_ENOMEM );
+  ws->length = length;
+  ws->window = window;
+#ifdef _OPENMP
+  ws->nlanes = omp_get_max_threads();
+#else
+  ws->nlanes = 1;
+#endif
+
+  ws->plan = XLALCreateReverseCOMPLEX8FFTPlan( length, measurelvl );
+  ws->lane = LALCalloc( ws->nlanes, sizeof( *ws->lane ) );
+  if ( !ws->plan || !ws->lane ) {
+    XLALDestroyMatchedFilterWorkspace( ws );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  for ( l = 0; l < ws->nlanes; ++l ) {
+    MatchedFilterLane *lane = &ws->lane[l];
+    lane->zf = XLALCreateCOMPLEX8VectorAligned( length, 32 );
+    lane->zt = XLALCreateCOMPLEX8VectorAligned( length, 32 );
+    if ( !lane->zf || !lane->zt ) {
+      XLALDestroyMatchedFilterWorkspace( ws );
+      XLAL_ERROR_NULL( XLAL_ENOMEM );
+    }
+    if ( window > 0 ) {
+      lane->y = LALMalloc( ( 2 * window + 1 ) * sizeof( *lane->y ) );
+      lane->interp = XLALCreateLanczosTriggerInterpolant( window );
+      if ( !lane->y || !lane->interp ) {
+        XLALDestroyMatchedFilterWorkspace( ws );
+        XLAL_ERROR_NULL( XLAL_EFUNC );
+      }
+    }
+  }
+
+  return ws;
+}
+
+/** Destroy a workspace created by XLALCreateMatchedFilterWorkspace(). */
+void XLALDestroyMatchedFilterWorkspace( MatchedFilterWorkspace *ws )
+{
+  UINT4 l;
+  if ( !ws )
+    return;
+  if ( ws->lane ) {
+    for ( l = 0; l < ws->nlanes; ++l ) {
+      XLALDestroyCOMPLEX8VectorAligned( ws->lane[l].zf );
+      XLALDestroyCOMPLEX8VectorAligned( ws->lane[l].zt );
+      LALFree( ws->lane[l].y );
+      XLALDestroyLanczosTriggerInterpolant( ws->lane[l].interp );
+    }
+    LALFree( ws->lane );
+  }
+  XLALDestroyCOMPLEX8FFTPlan( ws->plan );
+  LALFree( ws );
+}
+
+/**
+ * Compute the complex SNR time series \c snr of the template \c tmplt
+ * against \c data, scaled by \c norm.  \c snr must have the length of the
+ * workspace.  This function must not be called concurrently with the same
+ * workspace.
+ */
+int XLALMatchedFilterSNRCOMPLEX8( COMPLEX8Vector *snr, const COMPLEX8Vector *data, const COMPLEX8Vector *tmplt, REAL4 norm, MatchedFilterWorkspace *ws )
+{
+  MatchedFilterLane *lane;
+  UINT4 i;
+
+  XLAL_CHECK( snr && data && tmplt && ws, XLAL_EFAULT );
+  XLAL_CHECK( snr->length == ws->length, XLAL_EBADLEN, "SNR length %u does not match workspace length %u", snr->length, ws->length );
+
+  lane = &ws->lane[0];
+  XLAL_CHECK( MatchedFilterLaneSNR( ws, lane, data, tmplt ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( i = 0; i < ws->length; ++i )
+    snr->data[i] = norm * lane->zt->data[i];
+
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Filter \c ntemplates templates against the same \c data and store the
+ * interpolated peak of the SNR time series of each template \c k, scaled
+ * by <tt>norms[k]</tt> (or 1 if \c norms is \c NULL), in <tt>peaks[k]</tt>.
+ * Only samples in <tt>[first, last)</tt> are searched for the peak.
+ *
+ * If LAL is built with OpenMP, templates are filtered in parallel; this
+ * function must not be called concurrently with the same workspace.
+ */
+int XLALMatchedFilterPeaksCOMPLEX8( MatchedFilterPeak *peaks, const COMPLEX8Vector *data, const COMPLEX8Vector *const *templates, const REAL4 *norms, UINT4 ntemplates, UINT4 first, UINT4 last, MatchedFilterWorkspace *ws )
+{
+  int errnum = 0;
+  INT4 k;
+
+  XLAL_CHECK( peaks && data && ws, XLAL_EFAULT );
+  XLAL_CHECK( ntemplates == 0 || templates, XLAL_EFAULT );
+  XLAL_CHECK( first < last && last <= ws->length, XLAL_EINVAL, "Invalid range of samples [%u, %u) for length %u", first, last, ws->length );
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(ws->nlanes)
+#endif
+  for ( k = 0; k < (INT4) ntemplates; ++k ) {
+#ifdef _OPENMP
+    MatchedFilterLane *lane = &ws->lane[omp_get_thread_num()];
+#else
+    MatchedFilterLane *lane = &ws->lane[0];
+#endif
+    if ( !templates[k] || MatchedFilterLaneSNR( ws, lane, data, templates[k] ) != XLAL_SUCCESS ) {
+#ifdef _OPENMP
+#pragma omp critical (XLALMatchedFilterPeaksCOMPLEX8)
+#endif
+      errnum = XLAL_EFUNC;
+      continue;
+    }
+    MatchedFilterLanePeak( ws, lane, first, last, norms ? norms[k] : 1, &peaks[k] );
+  }
+  XLAL_CHECK( errnum == 0, errnum );
+
+  return XLAL_SUCCESS;
+}
+
+/** @} */
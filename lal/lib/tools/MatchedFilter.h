@@ -0,0 +1,97 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#ifndef _MATCHEDFILTER_H
+#define _MATCHEDFILTER_H
+
+#include <lal/LALDatatypes.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup MatchedFilter_h Header MatchedFilter.h
+ * \ingroup lal_tools
+ *
+ * \brief Frequency-domain matched filtering of whitened data against a batch
+ * of templates.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/MatchedFilter.h>
+ * \endcode
+ *
+ * The complex SNR time series of a whitened frequency-domain data segment
+ * \f$\tilde{d}_k\f$ and a whitened frequency-domain template
+ * \f$\tilde{h}_k\f$ is
+ * \f[
+ * z_j = \sigma \sum_k \tilde{d}_k \tilde{h}_k^* e^{2 \pi i j k / N},
+ * \f]
+ * where \f$N\f$ is the length of the time series and \f$\sigma\f$ is a
+ * normalisation supplied by the caller (e.g.\ \f$4 \Delta f /
+ * \sqrt{\langle h, h \rangle}\f$).  The data and templates may be shorter
+ * than \f$N\f$ (e.g.\ positive frequencies only); missing frequency bins
+ * are taken to be zero.
+ *
+ * A \c MatchedFilterWorkspace holds the inverse FFT plan, frequency- and
+ * time-domain buffers, and trigger interpolants, all of which are reused
+ * for every template filtered.  XLALMatchedFilterPeaksCOMPLEX8() filters
+ * a batch of templates against the same data segment and returns, for each
+ * template, the peak of \f$|z_j|\f$ within a range of samples,
+ * interpolated with a Lanczos trigger interpolant (see
+ * \ref LanczosTriggerInterpolant).  The conjugate products are computed
+ * with XLALVectorMultiplyConjCOMPLEX8(), which uses SIMD instructions where
+ * available, and if LAL is built with OpenMP, templates are filtered in
+ * parallel, each thread using its own buffers.
+ *
+ * XLALMatchedFilterSNRCOMPLEX8() returns the whole SNR time series for a
+ * single template.
+ */
+/** @{ */
+
+/** Incomplete type for a matched-filter workspace */
+typedef struct tagMatchedFilterWorkspace MatchedFilterWorkspace;
+
+/** The peak of the SNR time series of a template */
+typedef struct tagMatchedFilterPeak {
+  REAL8 index;		/**< Interpolated sample index of the peak of \f$|z_j|\f$ */
+  COMPLEX8 snr;		/**< Interpolated complex SNR at the peak */
+} MatchedFilterPeak;
+
+MatchedFilterWorkspace *XLALCreateMatchedFilterWorkspace(UINT4 length, UINT4 window, int measurelvl);
+void XLALDestroyMatchedFilterWorkspace(MatchedFilterWorkspace *ws);
+int XLALMatchedFilterSNRCOMPLEX8(COMPLEX8Vector *snr, const COMPLEX8Vector *data, const COMPLEX8Vector *tmplt, REAL4 norm, MatchedFilterWorkspace *ws);
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+int XLALMatchedFilterPeaksCOMPLEX8(MatchedFilterPeak *peaks, const COMPLEX8Vector *data, const COMPLEX8Vector *const *templates, const REAL4 *norms, UINT4 ntemplates, UINT4 first, UINT4 last, MatchedFilterWorkspace *ws);
+
+#endif /* SWIG */
+
+/** @} */
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _MATCHEDFILTER_H */
@@ -42,12 +42,12 @@ SEQUENCETYPE *CFUNC (
 	SEQUENCETYPE *new;
 	DATATYPE *data;
 
-	new = XLALMalloc(sizeof(*new));
+	new = XLALArenaMalloc(sizeof(*new));
 
 #ifdef USE_ALIGNED_MEMORY_ROUTINES
-	data = XLALMallocAligned(length * sizeof(*data));
+	data = XLALArenaMallocAligned(length * sizeof(*data));
 #else
-	data = XLALMalloc(length * sizeof(*data));
+	data = XLALArenaMalloc(length * sizeof(*data));
 #endif /*  USE_ALIGNED_MEMORY_ROUTINES */
 
 	/* data == NULL is OK if length == 0 */
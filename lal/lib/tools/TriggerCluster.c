@@ -0,0 +1,330 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/TriggerCluster.h>
+
+/**
+ * \addtogroup TriggerCluster_h
+ * @{
+ */
+
+/* a trigger time and its index in the store, for sorting */
+typedef struct tagTriggerStoreSortKey {
+  INT8 time;
+  size_t index;
+} TriggerStoreSortKey;
+
+static int TriggerStoreSortKeyCmp( const void *a, const void *b )
+{
+  const TriggerStoreSortKey *ka = (const TriggerStoreSortKey *) a;
+  const TriggerStoreSortKey *kb = (const TriggerStoreSortKey *) b;
+  if ( ka->time != kb->time )
+    return ka->time < kb->time ? -1 : 1;
+  /* keep triggers with equal times in their original order */
+  return ka->index < kb->index ? -1 : ( ka->index > kb->index );
+}
+
+/* find the root of i, halving the path as we go */
+static size_t TriggerStoreFind( size_t *parent, size_t i )
+{
+  while ( parent[i] != i ) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+/* join the clusters of i and j; roots are always the earliest trigger */
+static void TriggerStoreUnion( size_t *parent, size_t i, size_t j )
+{
+  size_t ri = TriggerStoreFind( parent, i );
+  size_t rj = TriggerStoreFind( parent, j );
+  if ( ri < rj )
+    parent[rj] = ri;
+  else if ( rj < ri )
+    parent[ri] = rj;
+}
+
+/*
+ * link trigger i with the triggers j in [first, i) within the window;
+ * without a test, linking with the preceding trigger suffices since the
+ * links are transitive
+ */
+static int TriggerStoreSweep( LALTriggerStore *store, size_t first, size_t i, INT8 window, LALTriggerStoreTestFunc test, void *params )
+{
+  size_t j = i;
+  while ( j-- > first && store->time[i] - store->time[j] <= window ) {
+    if ( test ) {
+      int linked = test( store, i, j, params );
+      if ( linked < 0 )
+        return -1;
+      if ( linked )
+        TriggerStoreUnion( store->cluster, i, j );
+    } else {
+      TriggerStoreUnion( store->cluster, i, j );
+      break;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Creates an empty \c LALTriggerStore with room for \c size triggers; the
+ * store grows as needed when triggers are appended.
+ */
+LALTriggerStore *XLALCreateTriggerStore( size_t size )
+{
+  LALTriggerStore *store;
+  store = LALCalloc( 1, sizeof( *store ) );
+  XLAL_CHECK_NULL( store, XLAL_ENOMEM );
+  if ( size > 0 ) {
+    store->time = LALMalloc( size * sizeof( *store->time ) );
+    store->rank = LALMalloc( size * sizeof( *store->rank ) );
+    store->row = LALMalloc( size * sizeof( *store->row ) );
+    store->cluster = LALMalloc( size * sizeof( *store->cluster ) );
+    store->size_of = LALMalloc( size * sizeof( *store->size_of ) );
+    if ( !store->time || !store->rank || !store->row || !store->cluster || !store->size_of ) {
+      XLALDestroyTriggerStore( store );
+      XLAL_ERROR_NULL( XLAL_ENOMEM );
+    }
+  }
+  store->size = size;
+  return store;
+}
+
+/**
+ * Frees a \c LALTriggerStore.  The rows pointed to by the store are not
+ * freed.
+ */
+void XLALDestroyTriggerStore( LALTriggerStore *store )
+{
+  if ( store ) {
+    LALFree( store->time );
+    LALFree( store->rank );
+    LALFree( store->row );
+    LALFree( store->cluster );
+    LALFree( store->size_of );
+    LALFree( store );
+  }
+}
+
+/**
+ * Appends a trigger at \c time nanoseconds with ranking statistic \c rank
+ * to a \c LALTriggerStore; \c row is an opaque pointer to the trigger's row.
+ */
+int XLALTriggerStoreAppend( LALTriggerStore *store, INT8 time, REAL8 rank, void *row )
+{
+  XLAL_CHECK( store, XLAL_EFAULT );
+  if ( store->length == store->size ) {
+    size_t size = store->size > 0 ? 2 * store->size : 64;
+    INT8 *new_time = LALRealloc( store->time, size * sizeof( *store->time ) );
+    XLAL_CHECK( new_time, XLAL_ENOMEM );
+    store->time = new_time;
+    REAL8 *new_rank = LALRealloc( store->rank, size * sizeof( *store->rank ) );
+    XLAL_CHECK( new_rank, XLAL_ENOMEM );
+    store->rank = new_rank;
+    void **new_row = LALRealloc( store->row, size * sizeof( *store->row ) );
+    XLAL_CHECK( new_row, XLAL_ENOMEM );
+    store->row = new_row;
+    size_t *new_cluster = LALRealloc( store->cluster, size * sizeof( *store->cluster ) );
+    XLAL_CHECK( new_cluster, XLAL_ENOMEM );
+    store->cluster = new_cluster;
+    size_t *new_size_of = LALRealloc( store->size_of, size * sizeof( *store->size_of ) );
+    XLAL_CHECK( new_size_of, XLAL_ENOMEM );
+    store->size_of = new_size_of;
+    store->size = size;
+  }
+  store->time[store->length] = time;
+  store->rank[store->length] = rank;
+  store->row[store->length] = row;
+  store->cluster[store->length] = store->length;
+  store->size_of[store->length] = 1;
+  ++store->length;
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Sorts the triggers in a \c LALTriggerStore into forward time order;
+ * triggers with equal times keep their relative order.  If the store is
+ * already sorted, this function returns promptly.
+ */
+int XLALTriggerStoreSort( LALTriggerStore *store )
+{
+  TriggerStoreSortKey *keys;
+  size_t i;
+
+  XLAL_CHECK( store, XLAL_EFAULT );
+
+  /* check whether the triggers are already sorted */
+  for ( i = 1; i < store->length; ++i )
+    if ( store->time[i] < store->time[i - 1] )
+      break;
+  if ( i >= store->length )
+    return XLAL_SUCCESS;
+
+  keys = LALMalloc( store->length * sizeof( *keys ) );
+  XLAL_CHECK( keys, XLAL_ENOMEM );
+  for ( i = 0; i < store->length; ++i ) {
+    keys[i].time = store->time[i];
+    keys[i].index = i;
+  }
+  qsort( keys, store->length, sizeof( *keys ), TriggerStoreSortKeyCmp );
+
+  /* permute the arrays, using the cluster array as scratch space */
+  for ( i = 0; i < store->length; ++i ) {
+    store->time[i] = keys[i].time;
+    store->cluster[i] = keys[i].index;
+  }
+  {
+    REAL8 *rank = LALMalloc( store->length * sizeof( *rank ) );
+    void **row = LALMalloc( store->length * sizeof( *row ) );
+    if ( !rank || !row ) {
+      LALFree( row );
+      LALFree( rank );
+      LALFree( keys );
+      XLAL_ERROR( XLAL_ENOMEM );
+    }
+    for ( i = 0; i < store->length; ++i ) {
+      rank[i] = store->rank[store->cluster[i]];
+      row[i] = store->row[store->cluster[i]];
+    }
+    memcpy( store->rank, rank, store->length * sizeof( *rank ) );
+    memcpy( store->row, row, store->length * sizeof( *row ) );
+    LALFree( row );
+    LALFree( rank );
+  }
+  for ( i = 0; i < store->length; ++i ) {
+    store->cluster[i] = i;
+    store->size_of[i] = 1;
+  }
+
+  LALFree( keys );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Clusters the triggers in a time-sorted \c LALTriggerStore.
+ *
+ * Two triggers are linked if their times differ by no more than \c window
+ * nanoseconds and, if \c test is not \c NULL, <tt>test(store, i, j,
+ * params)</tt> returns 1; clusters are the connected components of the
+ * links.  On return, \c store->cluster[i] is the index of the loudest
+ * trigger in the cluster of trigger \c i (the earliest, if several are
+ * equally loud), and \c store->size_of[i] is the number of triggers in the
+ * cluster of each loudest trigger \c i.
+ *
+ * If \c block is non-zero, the triggers are divided into blocks of
+ * \c block consecutive triggers, which are clustered independently (in
+ * parallel, if LAL is built with OpenMP, in which case \c test must be
+ * safe to call concurrently) before the pairs of triggers straddling
+ * block boundaries are tested.  The result does not depend on \c block.
+ */
+int XLALTriggerStoreCluster( LALTriggerStore *store, INT8 window, LALTriggerStoreTestFunc test, void *params, size_t block )
+{
+  size_t *loudest;
+  size_t *count;
+  size_t nblocks;
+  size_t b;
+  size_t i;
+  int errnum = 0;
+
+  XLAL_CHECK( store, XLAL_EFAULT );
+  XLAL_CHECK( window >= 0, XLAL_EINVAL, "Clustering window must be non-negative" );
+  for ( i = 1; i < store->length; ++i )
+    XLAL_CHECK( store->time[i] >= store->time[i - 1], XLAL_EINVAL, "Triggers must be sorted by time" );
+
+  if ( store->length == 0 )
+    return XLAL_SUCCESS;
+
+  /* each trigger starts in a cluster of its own */
+  for ( i = 0; i < store->length; ++i )
+    store->cluster[i] = i;
+
+  if ( block == 0 || block > store->length )
+    block = store->length;
+  nblocks = ( store->length + block - 1 ) / block;
+
+  /* link triggers within each block; blocks touch disjoint parts of the cluster array */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for ( b = 0; b < nblocks; ++b ) {
+    size_t first = b * block;
+    size_t last = first + block < store->length ? first + block : store->length;
+    size_t k;
+    for ( k = first + 1; k < last; ++k ) {
+      if ( TriggerStoreSweep( store, first, k, window, test, params ) < 0 ) {
+#ifdef _OPENMP
+#pragma omp critical (XLALTriggerStoreCluster)
+#endif
+        errnum = XLAL_EFUNC;
+        break;
+      }
+    }
+  }
+  XLAL_CHECK( errnum == 0, errnum );
+
+  /* link triggers straddling each block boundary with the triggers before it */
+  for ( b = 1; b < nblocks; ++b ) {
+    size_t first = b * block;
+    for ( i = first; i < store->length && store->time[i] - store->time[first - 1] <= window; ++i ) {
+      size_t j = first;
+      while ( j-- > 0 && store->time[i] - store->time[j] <= window ) {
+        if ( test ) {
+          int linked = test( store, i, j, params );
+          XLAL_CHECK( linked >= 0, XLAL_EFUNC );
+          if ( linked )
+            TriggerStoreUnion( store->cluster, i, j );
+        } else {
+          TriggerStoreUnion( store->cluster, i, j );
+          break;
+        }
+      }
+    }
+  }
+
+  /* find the loudest trigger and the number of triggers in each cluster */
+  loudest = LALMalloc( 2 * store->length * sizeof( *loudest ) );
+  XLAL_CHECK( loudest, XLAL_ENOMEM );
+  count = loudest + store->length;
+  for ( i = 0; i < store->length; ++i ) {
+    size_t r = TriggerStoreFind( store->cluster, i );
+    store->cluster[i] = r;
+    if ( r == i ) {
+      loudest[r] = i;
+      count[r] = 0;
+    }
+    if ( store->rank[i] > store->rank[loudest[r]] )
+      loudest[r] = i;
+    ++count[r];
+  }
+  for ( i = 0; i < store->length; ++i )
+    store->size_of[i] = 0;
+  for ( i = 0; i < store->length; ++i ) {
+    size_t r = store->cluster[i];
+    store->cluster[i] = loudest[r];
+    store->size_of[loudest[r]] = count[r];
+  }
+  LALFree( loudest );
+
+  return XLAL_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,103 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#ifndef _TRIGGERCLUSTER_H
+#define _TRIGGERCLUSTER_H
+
+#include <stddef.h>
+#include <lal/LALAtomicDatatypes.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup TriggerCluster_h Header TriggerCluster.h
+ * \ingroup lal_tools
+ *
+ * \brief Array-backed store of triggers with time-sorted sweep-line clustering.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/TriggerCluster.h>
+ * \endcode
+ *
+ * A \c LALTriggerStore holds the time, ranking statistic, and an opaque
+ * pointer to the row (e.g.\ a \c SnglInspiralTable or \c SnglBurst) of
+ * each of a set of triggers in plain arrays.  XLALTriggerStoreSort() sorts
+ * the triggers by time in \f$O(N \log N)\f$, after which
+ * XLALTriggerStoreCluster() groups them into clusters with a single sweep
+ * over the sorted times: two triggers are linked if their times differ by
+ * no more than a window and, optionally, a user-supplied test (for example
+ * an overlap test of metric ellipsoids) accepts the pair; clusters are the
+ * connected components of the links.  Each trigger is only tested against
+ * the triggers preceding it within the window, so clustering costs
+ * \f$O(N k)\f$ tests where \f$k\f$ is the typical number of triggers within
+ * a window.
+ *
+ * Clustering can be divided into blocks of consecutive triggers, which are
+ * clustered independently (in parallel, if LAL is built with OpenMP) and
+ * then joined by testing the pairs of triggers that straddle block
+ * boundaries.
+ *
+ * After clustering, \c cluster[i] is the index of the loudest trigger (the
+ * trigger with the largest ranking statistic) in the cluster of trigger
+ * \c i, so the loudest triggers are those with <tt>cluster[i] == i</tt>.
+ */
+/** @{ */
+
+/** An array-backed store of triggers */
+typedef struct tagLALTriggerStore {
+  size_t length;	/**< Number of triggers in the store */
+  size_t size;		/**< Number of triggers allocated */
+  INT8 *time;		/**< Time of each trigger in nanoseconds */
+  REAL8 *rank;		/**< Ranking statistic of each trigger; larger is louder */
+  void **row;		/**< Opaque pointer to the row of each trigger */
+  size_t *cluster;	/**< Index of the loudest trigger in the cluster of each trigger, set by XLALTriggerStoreCluster() */
+  size_t *size_of;	/**< Number of triggers in the cluster of each loudest trigger, set by XLALTriggerStoreCluster() */
+} LALTriggerStore;
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+/**
+ * Test of whether triggers \c i and \c j of \c store, whose times differ by
+ * no more than the clustering window, belong to the same cluster.  Must
+ * return 1 if they do, 0 if they do not, and a negative value on error.
+ * Must be safe to call concurrently if clustering is done in parallel.
+ */
+typedef int (*LALTriggerStoreTestFunc)(const LALTriggerStore *store, size_t i, size_t j, void *params);
+
+LALTriggerStore *XLALCreateTriggerStore(size_t size);
+void XLALDestroyTriggerStore(LALTriggerStore *store);
+int XLALTriggerStoreAppend(LALTriggerStore *store, INT8 time, REAL8 rank, void *row);
+int XLALTriggerStoreSort(LALTriggerStore *store);
+int XLALTriggerStoreCluster(LALTriggerStore *store, INT8 window, LALTriggerStoreTestFunc test, void *params, size_t block);
+
+#endif /* SWIG */
+
+/** @} */
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _TRIGGERCLUSTER_H */
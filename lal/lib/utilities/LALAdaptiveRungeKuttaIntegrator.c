@@ -28,15 +28,27 @@
           gsl_set_error_handler( saveGSLErrorHandler_ ); \
         }
 
+/* Private state kept alongside the public integrator structure, which is
+ * always its first member; integrators must therefore be created with
+ * XLALAdaptiveRungeKutta4Init() or
+ * XLALAdaptiveRungeKutta4InitEighthOrderInstead() */
+typedef struct tagLALAdaptiveRungeKuttaIntegratorContext {
+    LALAdaptiveRungeKuttaIntegrator integrator;
+    REAL8Array *output;         /* output array kept between integrations */
+    size_t outputcapacity;      /* allocated length of output->data */
+} LALAdaptiveRungeKuttaIntegratorContext;
+
 LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4Init(int dim, int (*dydt) (double t, const double y[], double dydt[], void *params),   /* These are XLAL functions! */
     int (*stop) (double t, const double y[], double dydt[], void *params), double eps_abs, double eps_rel)
 {
+    LALAdaptiveRungeKuttaIntegratorContext *context;
     LALAdaptiveRungeKuttaIntegrator *integrator;
 
     /* allocate our custom integrator structure */
-    if (!(integrator = (LALAdaptiveRungeKuttaIntegrator *) LALCalloc(1, sizeof(LALAdaptiveRungeKuttaIntegrator)))) {
+    if (!(context = (LALAdaptiveRungeKuttaIntegratorContext *) LALCalloc(1, sizeof(LALAdaptiveRungeKuttaIntegratorContext)))) {
         XLAL_ERROR_NULL(XLAL_ENOMEM);
     }
+    integrator = &(context->integrator);
 
     /* allocate the GSL ODE components */
         XLAL_CALLGSL(integrator->step = gsl_odeiv_step_alloc(gsl_odeiv_step_rkf45, dim));
@@ -70,12 +82,14 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4Init(int dim, int (*dydt
 LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4InitEighthOrderInstead(int dim, int (*dydt) (double t, const double y[], double dydt[], void *params),   /* These are XLAL functions! */
     int (*stop) (double t, const double y[], double dydt[], void *params), double eps_abs, double eps_rel)
 {
+    LALAdaptiveRungeKuttaIntegratorContext *context;
     LALAdaptiveRungeKuttaIntegrator *integrator;
 
     /* allocate our custom integrator structure */
-    if (!(integrator = (LALAdaptiveRungeKuttaIntegrator *) LALCalloc(1, sizeof(LALAdaptiveRungeKuttaIntegrator)))) {
+    if (!(context = (LALAdaptiveRungeKuttaIntegratorContext *) LALCalloc(1, sizeof(LALAdaptiveRungeKuttaIntegratorContext)))) {
         XLAL_ERROR_NULL(XLAL_ENOMEM);
     }
+    integrator = &(context->integrator);
 
     /* allocate the GSL ODE components */
     XLAL_CALLGSL(integrator->step = gsl_odeiv_step_alloc(gsl_odeiv_step_rk8pd, dim));
@@ -118,67 +132,107 @@ void XLALAdaptiveRungeKuttaFree(LALAdaptiveRungeKuttaIntegrator * integrator)
         XLAL_CALLGSL(gsl_odeiv_step_free(integrator->step));
 
     LALFree(integrator->sys);
+    XLALDestroyREAL8Array(((LALAdaptiveRungeKuttaIntegratorContext *) integrator)->output);
     LALFree(integrator);
 
     return;
 }
 
-/* Local function to store interpolated step in output array */
-static int storeStateInOutput(REAL8Array ** output, REAL8 t, REAL8 * y, size_t dim, int *outputlen, int count)
+/**
+ * Reconfigure an existing integrator for a new system, so that it can be
+ * reused instead of calling XLALAdaptiveRungeKuttaFree() and
+ * XLALAdaptiveRungeKutta4Init() again.  The stepper type (RKF45 or RK8PD)
+ * is kept.  The GSL stepper and evolver are only reallocated if the
+ * dimension changes, and the output array kept by the integrator between
+ * calls to XLALAdaptiveRungeKutta4Hermite() and
+ * XLALAdaptiveRungeKutta4HermiteReuse() is retained.  The retry count is
+ * reset to its default and stopontestonly is cleared.
+ */
+int XLALAdaptiveRungeKuttaReset(LALAdaptiveRungeKuttaIntegrator * integrator, int dim, int (*dydt) (double t, const double y[], double dydt[], void *params),  /* These are XLAL functions! */
+    int (*stop) (double t, const double y[], double dydt[], void *params), double eps_abs, double eps_rel)
 {
-    REAL8Array *out = *output;
-    int len = *outputlen;
-    size_t i;
+    XLAL_CHECK(integrator && integrator->step && integrator->control && integrator->evolve && integrator->sys, XLAL_EFAULT);
+    XLAL_CHECK(dim > 0, XLAL_EINVAL, "Invalid dimension %d", dim);
+
+    if ((size_t) dim != integrator->sys->dimension) {
+        /* allocate the new stepper and evolver first, so that on failure
+         * the integrator is left as it was */
+        gsl_odeiv_step *step = NULL;
+        gsl_odeiv_evolve *evolve = NULL;
+        XLAL_CALLGSL(step = gsl_odeiv_step_alloc(integrator->step->type, dim));
+        XLAL_CALLGSL(evolve = gsl_odeiv_evolve_alloc(dim));
+        if (!step || !evolve) {
+            if (step)
+                XLAL_CALLGSL(gsl_odeiv_step_free(step));
+            if (evolve)
+                XLAL_CALLGSL(gsl_odeiv_evolve_free(evolve));
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+        XLAL_CALLGSL(gsl_odeiv_evolve_free(integrator->evolve));
+        XLAL_CALLGSL(gsl_odeiv_step_free(integrator->step));
+        integrator->step = step;
+        integrator->evolve = evolve;
+    } else {
+        XLAL_CALLGSL(gsl_odeiv_step_reset(integrator->step));
+        XLAL_CALLGSL(gsl_odeiv_evolve_reset(integrator->evolve));
+    }
 
-    if (count > len) {
-        /* Resize array! Have to make a new array, and copy over. */
-        REAL8Array *new = XLALCreateREAL8ArrayL(2, dim + 1, 2 * len);
+    /* same as gsl_odeiv_control_y_new() */
+    int gslstatus;
+    XLAL_CALLGSL(gslstatus = gsl_odeiv_control_init(integrator->control, eps_abs, eps_rel, 1.0, 0.0));
+    XLAL_CHECK(gslstatus == GSL_SUCCESS, XLAL_EINVAL, "Invalid tolerances eps_abs=%g, eps_rel=%g", eps_abs, eps_rel);
 
-        if (!new) {
-            return XLAL_ENOMEM;
-        }
+    integrator->dydt = dydt;
+    integrator->stop = stop;
 
-        for (i = 0; i < dim + 1; i++) {
-            memcpy(&(new->data[2 * i * len]), &(out->data[i * len]), len * sizeof(REAL8));
-        }
+    integrator->sys->function = dydt;
+    integrator->sys->jacobian = NULL;
+    integrator->sys->dimension = dim;
+    integrator->sys->params = NULL;
 
-        XLALDestroyREAL8Array(out);
-        out = new;
-        len *= 2;
-    }
+    integrator->retries = 6;
+    integrator->stopontestonly = 0;
+    integrator->returncode = 0;
 
-    /* Store the current step. */
-    out->data[count - 1] = t;
-    for (i = 1; i < dim + 1; i++) {
-        out->data[i * len + count - 1] = y[i - 1];
+    return XLAL_SUCCESS;
+}
+
+/* Local function to make sure the integrator's output array can hold
+ * (dim + 1) rows of length len */
+static int reserveOutput(LALAdaptiveRungeKuttaIntegratorContext * context, size_t dim, int len)
+{
+    if (!context->output) {
+        if (!(context->output = XLALCreateREAL8ArrayL(2, dim + 1, len))) {
+            return XLAL_ENOMEM;
+        }
+        context->outputcapacity = (dim + 1) * len;
+    } else if ((dim + 1) * len > context->outputcapacity) {
+        if (!XLALResizeREAL8ArrayL(context->output, 2, dim + 1, len)) {
+            return XLAL_ENOMEM;
+        }
+        context->outputcapacity = (dim + 1) * len;
     }
 
-    *output = out;
-    *outputlen = len;
     return GSL_SUCCESS;
 }
 
-/* Local function to shrink output array to proper size before it's returned */
-static int shrinkOutput(REAL8Array ** output, int *outputlen, int count, size_t dim)
+/* Local function to make sure the output array, which holds (dim + 1) rows
+ * of length *outputlen, has room for count samples */
+static int growOutput(LALAdaptiveRungeKuttaIntegratorContext * context, size_t dim, int *outputlen, int count)
 {
-    REAL8Array *out = *output;
     int len = *outputlen;
-
-    REAL8Array *new = XLALCreateREAL8ArrayL(2, dim + 1, count);
-
-    if (!new) {
-        return XLAL_ENOMEM;
-    }
-
     size_t i;
-    for (i = 0; i < dim + 1; i++) {
-        memcpy(&(new->data[i * count]), &(out->data[i * len]), count * sizeof(REAL8));
-    }
 
-    *output = new;
-    *outputlen = count;
-
-    XLALDestroyREAL8Array(out);
+    if (count > len) {
+        /* Resize array if needed, and move the rows to their new stride */
+        if (reserveOutput(context, dim, 2 * len) == XLAL_ENOMEM) {
+            return XLAL_ENOMEM;
+        }
+        for (i = dim; i > 0; i--) {
+            memmove(&(context->output->data[2 * i * len]), &(context->output->data[i * len]), len * sizeof(REAL8));
+        }
+        *outputlen = 2 * len;
+    }
 
     return GSL_SUCCESS;
 }
@@ -195,46 +249,21 @@ typedef struct {
     double *ytmp;
 } rkf45_state_t;
 
-/**
- * Fourth-order Runge-Kutta ODE integrator using Runge-Kutta-Fehlberg (RKF45)
- * steps with adaptive step size control.  Intended for use in various
- * waveform generation routines such as SpinTaylorT4 and various EOB models.
- *
- * The method is described in
- *
- * Abramowitz & Stegun, Handbook of Mathematical Functions, Tenth Printing,
- * National Bureau of Standards, Washington, DC, 1972
- * (available online at http://people.math.sfu.ca/~cbm/aands/ )
- *
- * This function also includes "on-the-fly" interpolation of the
- * differential equations at regular intervals in-between integration
- * steps. This "on-the-fly" interpolation method is derived and
- * described in the Mathematica notebook "RKF_with_interpolation.nb";
- * see
- * https://www.lsc-group.phys.uwm.edu/ligovirgo/cbcnote/InspiralPipelineDevelopment/120312111836InspiralPipelineDevelopmentImproved%20Adaptive%20Runge-Kutta%20integrator
- *
- * This method is functionally equivalent to XLALAdaptiveRungeKutta4,
- * but is nearly always faster due to the improved interpolation.
- */
-int XLALAdaptiveRungeKutta4Hermite(LALAdaptiveRungeKuttaIntegrator * integrator,       /**< struct holding dydt, stopping test, stepper, etc. */
-    void *params,                                                       /**< params struct used to compute dydt and stopping test */
-    REAL8 * yinit,                                                      /**< pass in initial values of all variables - overwritten to final values */
-    REAL8 tinit,                                                        /**< integration start time */
-    REAL8 tend_in,                                                      /**< maximum integration time */
-    REAL8 deltat,                                                       /**< step size for evenly sampled output */
-    REAL8Array ** yout                                                  /**< array holding the evenly sampled output */
-    )
+/* Local function doing the work of XLALAdaptiveRungeKutta4Hermite() and
+ * XLALAdaptiveRungeKutta4HermiteReuse(): the evenly sampled output is left
+ * in the integrator's output array, as (dim + 1) rows of length *outputlen
+ * of which the first *count samples are filled, and the final interpolated
+ * sample is stored in yinit */
+static int hermiteIntegrate(LALAdaptiveRungeKuttaIntegratorContext * context, void *params, REAL8 * yinit, REAL8 tinit, REAL8 tend_in, REAL8 deltat, int *outputlen, int *count)
 {
+    LALAdaptiveRungeKuttaIntegrator *integrator = &(context->integrator);
     int errnum = 0;
     int status;
     size_t dim, retries, i;
-    int outputlen = 0, count = 0;
-
-    REAL8Array *output = NULL;
 
     REAL8 t, tintp, h;
 
-    REAL8 *ytemp = NULL;
+    REAL8 *data;
 
     REAL8 tend = tend_in;
 
@@ -251,27 +280,20 @@ int XLALAdaptiveRungeKutta4Hermite(LALAdaptiveRungeKuttaIntegrator * integrator,
 
     dim = integrator->sys->dimension;
 
-    outputlen = ((int)(tend_in - tinit) / deltat);
-    //if (outputlen < 0) outputlen = -outputlen;
-    if (outputlen < 0) {
+    *outputlen = ((int)(tend_in - tinit) / deltat);
+    //if (*outputlen < 0) *outputlen = -*outputlen;
+    if (*outputlen < 0) {
         XLALPrintError
             ("XLAL Error - %s: (tend_in - tinit) and deltat must have the same sign\ntend_in: %f, tinit: %f, deltat: %f\n",
             __func__, tend_in, tinit, deltat);
         errnum = XLAL_EINVAL;
         goto bail_out;
     }
-    outputlen += 2;
-
-    output = XLALCreateREAL8ArrayL(2, (dim + 1), outputlen);
+    *outputlen += 2;
 
-    if (!output) {
-        errnum = XLAL_ENOMEM;
-        goto bail_out;
-    }
-
-    ytemp = XLALCalloc(dim, sizeof(REAL8));
-
-    if (!ytemp) {
+    /* The output array kept by the integrator is only reallocated if it is
+     * too short. */
+    if (reserveOutput(context, dim, *outputlen) == XLAL_ENOMEM) {
         errnum = XLAL_ENOMEM;
         goto bail_out;
     }
@@ -285,10 +307,11 @@ int XLALAdaptiveRungeKutta4Hermite(LALAdaptiveRungeKuttaIntegrator * integrator,
     h = deltat;
 
     /* Copy over first step. */
-    output->data[0] = tinit;
+    data = context->output->data;
+    data[0] = tinit;
     for (i = 1; i <= dim; i++)
-        output->data[i * outputlen] = yinit[i - 1];
-    count = 1;
+        data[i * *outputlen] = yinit[i - 1];
+    *count = 1;
 
     /* We are starting a fresh integration; clear GSL step and evolve
      * objects. */
@@ -346,16 +369,18 @@ int XLALAdaptiveRungeKutta4Hermite(LALAdaptiveRungeKuttaIntegrator * integrator,
             REAL8 *k6 = rkfState->k6;
             REAL8 *y0 = rkfState->y0;
 
-            for (i = 0; i < dim; i++) {
-                ytemp[i] = i0 * y0[i] + iend * yinit[i] + hUsed * i1 * k1[i] + hUsed * i6 * k6[i];
-            }
-
-            /* Store the interpolated value in the output array. */
-            count++;
-            if ((status = storeStateInOutput(&output, tintp, ytemp, dim, &outputlen, count)) == XLAL_ENOMEM) {
+            /* Make room for, and store, the interpolated value in the
+             * output array. */
+            (*count)++;
+            if (growOutput(context, dim, outputlen, *count) == XLAL_ENOMEM) {
                 errnum = XLAL_ENOMEM;
                 goto bail_out;
             }
+            data = context->output->data;
+            data[*count - 1] = tintp;
+            for (i = 0; i < dim; i++) {
+                data[(i + 1) * *outputlen + *count - 1] = i0 * y0[i] + iend * yinit[i] + hUsed * i1 * k1[i] + hUsed * i6 * k6[i];
+            }
         }
 
         /* Now that we have recorded the last interpolated step that we
@@ -373,32 +398,122 @@ int XLALAdaptiveRungeKutta4Hermite(LALAdaptiveRungeKuttaIntegrator * integrator,
         }
     }
 
-    /* Now that the interpolation is done, shrink the output array down
-     * to exactly count samples. */
-    shrinkOutput(&output, &outputlen, count, dim);
-
     /* Store the final *interpolated* sample in yinit. */
     for (i = 0; i < dim; i++) {
-        yinit[i] = output->data[(i + 2) * outputlen - 1];
+        yinit[i] = context->output->data[(i + 1) * *outputlen + *count - 1];
     }
 
   bail_out:
 
     XLAL_ENDGSL;
 
-    /* If we have an error, then we should free allocated memory, and
-     * then return. */
-    XLALFree(ytemp);
+    return errnum;
+}
 
+/**
+ * Fourth-order Runge-Kutta ODE integrator using Runge-Kutta-Fehlberg (RKF45)
+ * steps with adaptive step size control.  Intended for use in various
+ * waveform generation routines such as SpinTaylorT4 and various EOB models.
+ *
+ * The method is described in
+ *
+ * Abramowitz & Stegun, Handbook of Mathematical Functions, Tenth Printing,
+ * National Bureau of Standards, Washington, DC, 1972
+ * (available online at http://people.math.sfu.ca/~cbm/aands/ )
+ *
+ * This function also includes "on-the-fly" interpolation of the
+ * differential equations at regular intervals in-between integration
+ * steps. This "on-the-fly" interpolation method is derived and
+ * described in the Mathematica notebook "RKF_with_interpolation.nb";
+ * see
+ * https://www.lsc-group.phys.uwm.edu/ligovirgo/cbcnote/InspiralPipelineDevelopment/120312111836InspiralPipelineDevelopmentImproved%20Adaptive%20Runge-Kutta%20integrator
+ *
+ * This method is functionally equivalent to XLALAdaptiveRungeKutta4,
+ * but is nearly always faster due to the improved interpolation.
+ */
+int XLALAdaptiveRungeKutta4Hermite(LALAdaptiveRungeKuttaIntegrator * integrator,       /**< struct holding dydt, stopping test, stepper, etc. */
+    void *params,                                                       /**< params struct used to compute dydt and stopping test */
+    REAL8 * yinit,                                                      /**< pass in initial values of all variables - overwritten to final values */
+    REAL8 tinit,                                                        /**< integration start time */
+    REAL8 tend_in,                                                      /**< maximum integration time */
+    REAL8 deltat,                                                       /**< step size for evenly sampled output */
+    REAL8Array ** yout                                                  /**< array holding the evenly sampled output */
+    )
+{
+    LALAdaptiveRungeKuttaIntegratorContext *context = (LALAdaptiveRungeKuttaIntegratorContext *) integrator;
+    int errnum;
+    int outputlen = 0, count = 0;
+    size_t dim, i;
+
+    REAL8Array *output = NULL;
+
+    dim = integrator->sys->dimension;
+
+    errnum = hermiteIntegrate(context, params, yinit, tinit, tend_in, deltat, &outputlen, &count);
+
+    /* Copy the output into an array of exactly count samples. */
+    if (!errnum) {
+        output = XLALCreateREAL8ArrayL(2, dim + 1, count);
+        if (!output) {
+            errnum = XLAL_ENOMEM;
+        } else {
+            for (i = 0; i < dim + 1; i++) {
+                memcpy(&(output->data[i * count]), &(context->output->data[i * outputlen]), count * sizeof(REAL8));
+            }
+        }
+    }
+
+    /* If we have an error, then return. */
     if (errnum) {
-        if (output)
-            XLALDestroyREAL8Array(output);
         *yout = NULL;
         XLAL_ERROR(errnum);
     }
 
     *yout = output;
-    return outputlen;
+    return count;
+}
+
+/**
+ * Same as XLALAdaptiveRungeKutta4Hermite(), except that the evenly sampled
+ * output is returned in an array owned by the integrator, which is reused
+ * by the next call and freed by XLALAdaptiveRungeKuttaFree().  The returned
+ * array must not be destroyed by the caller, and is only valid until the
+ * next integration.  Together with XLALAdaptiveRungeKuttaReset(), this lets
+ * repeated integrations run without allocating once the array has grown to
+ * the largest output needed.  Not available from the SWIG bindings, since
+ * the returned array would be invalidated by the next call.
+ */
+int XLALAdaptiveRungeKutta4HermiteReuse(LALAdaptiveRungeKuttaIntegrator * integrator,  /**< struct holding dydt, stopping test, stepper, etc. */
+    void *params,                                                       /**< params struct used to compute dydt and stopping test */
+    REAL8 * yinit,                                                      /**< pass in initial values of all variables - overwritten to final values */
+    REAL8 tinit,                                                        /**< integration start time */
+    REAL8 tend_in,                                                      /**< maximum integration time */
+    REAL8 deltat,                                                       /**< step size for evenly sampled output */
+    REAL8Array ** yout                                                  /**< array holding the evenly sampled output, owned by the integrator */
+    )
+{
+    LALAdaptiveRungeKuttaIntegratorContext *context = (LALAdaptiveRungeKuttaIntegratorContext *) integrator;
+    int errnum;
+    int outputlen = 0, count = 0;
+    size_t dim, i;
+
+    dim = integrator->sys->dimension;
+
+    errnum = hermiteIntegrate(context, params, yinit, tinit, tend_in, deltat, &outputlen, &count);
+    if (errnum) {
+        *yout = NULL;
+        XLAL_ERROR(errnum);
+    }
+
+    /* Move the rows to a stride of exactly count samples, in place. */
+    for (i = 1; i < dim + 1; i++) {
+        memmove(&(context->output->data[i * count]), &(context->output->data[i * outputlen]), count * sizeof(REAL8));
+    }
+    context->output->dimLength->data[0] = dim + 1;
+    context->output->dimLength->data[1] = count;
+
+    *yout = context->output;
+    return count;
 }
 
 int XLALAdaptiveRungeKutta4NoInterpolate(LALAdaptiveRungeKuttaIntegrator * integrator,
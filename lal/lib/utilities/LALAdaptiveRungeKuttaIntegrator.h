@@ -87,6 +87,12 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4InitEighthOrderInstead(
 
 void XLALAdaptiveRungeKuttaFree( LALAdaptiveRungeKuttaIntegrator *integrator );
 
+int XLALAdaptiveRungeKuttaReset( LALAdaptiveRungeKuttaIntegrator *integrator, int dim,
+                             int (* dydt) (double t, const double y[], double dydt[], void * params),
+                             int (* stop) (double t, const double y[], double dydt[], void * params),
+                             double eps_abs, double eps_rel
+                             );
+
 int XLALAdaptiveRungeKutta4( LALAdaptiveRungeKuttaIntegrator *integrator,
                          void *params,
                          REAL8 *yinit,
@@ -119,6 +125,17 @@ int XLALAdaptiveRungeKutta4Hermite( LALAdaptiveRungeKuttaIntegrator *integrator,
                                     REAL8Array **yout
                                     );
 
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALAdaptiveRungeKutta4HermiteReuse( LALAdaptiveRungeKuttaIntegrator *integrator,
+                                    void *params,
+                                    REAL8 *yinit,
+                                    REAL8 tinit,
+                                    REAL8 tend_in,
+                                    REAL8 deltat,
+                                    REAL8Array **yout
+                                    );
+#endif /* SWIG */
+
 /**
  * Fourth-order Runge-Kutta ODE integrator using Runge-Kutta-Fehlberg (RKF45)
  * steps with adaptive step size control.  Intended for use in Fourier domain
@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/AVFactories.h>
 #include <lal/LALRunningMedian.h>
@@ -1499,3 +1500,273 @@ void LALSRunningMedian2( LALStatus *status,
   DETATCHSTATUSPTR( status );
   RETURN( status );
 }
+
+
+/*----------------------------------
+  XLAL running median using an indexed
+  double heap: the lower half of the block
+  is kept in a max-heap, the upper half in
+  a min-heap, and every block slot knows its
+  position in its heap, so that the element
+  leaving the block can be replaced in
+  O(log blocksize) operations.
+  -----------------------------------*/
+struct tagLALRunningMedianWorkspace {
+  UINT4 blocksize;	/* number of elements in a block */
+  UINT4 nlo;		/* size of the lower (max-)heap, (blocksize+1)/2 */
+  UINT4 nhi;		/* size of the upper (min-)heap, blocksize/2 */
+  REAL8 *value;		/* block values, indexed by slot (input index modulo blocksize) */
+  UINT4 *lo;		/* max-heap of slots holding the lower half of the block */
+  UINT4 *hi;		/* min-heap of slots holding the upper half of the block */
+  UINT4 *pos;		/* position of each slot within its heap */
+  BOOLEAN *inhi;		/* whether each slot is in the upper heap */
+  struct rngmed_val_index8 *sortbuf;	/* used to sort the first block */
+};
+
+
+static void rngmed_heap_swap( UINT4 *heap, UINT4 *pos, UINT4 i, UINT4 j ) {
+  const UINT4 tmp = heap[i];
+  heap[i] = heap[j];
+  heap[j] = tmp;
+  pos[heap[i]] = i;
+  pos[heap[j]] = j;
+}
+
+/* true if slot 'a' should be closer to the root than slot 'b' */
+#define RNGMED_HEAP_BEFORE( value, a, b, ismax ) \
+  ( (ismax) ? ( (value)[a] > (value)[b] ) : ( (value)[a] < (value)[b] ) )
+
+static UINT4 rngmed_heap_up( UINT4 *heap, UINT4 *pos, const REAL8 *value, UINT4 i, int ismax ) {
+  while ( i > 0 ) {
+    const UINT4 parent = ( i - 1 ) / 2;
+    if ( !RNGMED_HEAP_BEFORE( value, heap[i], heap[parent], ismax ) )
+      break;
+    rngmed_heap_swap( heap, pos, i, parent );
+    i = parent;
+  }
+  return i;
+}
+
+static void rngmed_heap_down( UINT4 *heap, UINT4 *pos, const REAL8 *value, UINT4 n, UINT4 i, int ismax ) {
+  for (;;) {
+    UINT4 best = i;
+    const UINT4 left = 2 * i + 1, right = 2 * i + 2;
+    if ( left < n && RNGMED_HEAP_BEFORE( value, heap[left], heap[best], ismax ) )
+      best = left;
+    if ( right < n && RNGMED_HEAP_BEFORE( value, heap[right], heap[best], ismax ) )
+      best = right;
+    if ( best == i )
+      break;
+    rngmed_heap_swap( heap, pos, i, best );
+    i = best;
+  }
+}
+
+/* fill the heaps from the first block of the input */
+static void rngmed_heap_init( LALRunningMedianWorkspace *ws ) {
+  const UINT4 bsize = ws->blocksize;
+  for ( UINT4 k = 0; k < bsize; k++ ) {
+    ws->sortbuf[k].data = ws->value[k];
+    ws->sortbuf[k].index = k;
+  }
+  qsort( ws->sortbuf, bsize, sizeof( ws->sortbuf[0] ), rngmed_sortindex8 );
+  /* a descending array is a valid max-heap, an ascending array a valid min-heap */
+  for ( UINT4 i = 0; i < ws->nlo; i++ ) {
+    const UINT4 slot = ws->sortbuf[ws->nlo - 1 - i].index;
+    ws->lo[i] = slot;
+    ws->pos[slot] = i;
+    ws->inhi[slot] = 0;
+  }
+  for ( UINT4 i = 0; i < ws->nhi; i++ ) {
+    const UINT4 slot = ws->sortbuf[ws->nlo + i].index;
+    ws->hi[i] = slot;
+    ws->pos[slot] = i;
+    ws->inhi[slot] = 1;
+  }
+}
+
+/* replace the value in 'slot' and restore the heap invariants */
+static void rngmed_heap_replace( LALRunningMedianWorkspace *ws, UINT4 slot, REAL8 newvalue ) {
+  REAL8 *value = ws->value;
+  value[slot] = newvalue;
+  if ( ws->inhi[slot] ) {
+    const UINT4 i = rngmed_heap_up( ws->hi, ws->pos, value, ws->pos[slot], 0 );
+    rngmed_heap_down( ws->hi, ws->pos, value, ws->nhi, i, 0 );
+  } else {
+    const UINT4 i = rngmed_heap_up( ws->lo, ws->pos, value, ws->pos[slot], 1 );
+    rngmed_heap_down( ws->lo, ws->pos, value, ws->nlo, i, 1 );
+  }
+  /* a single exchange of the roots restores lower half <= upper half */
+  if ( ws->nhi > 0 && value[ws->lo[0]] > value[ws->hi[0]] ) {
+    const UINT4 a = ws->lo[0], b = ws->hi[0];
+    ws->lo[0] = b;
+    ws->hi[0] = a;
+    ws->inhi[a] = 1;
+    ws->inhi[b] = 0;
+    ws->pos[a] = ws->pos[b] = 0;
+    rngmed_heap_down( ws->lo, ws->pos, value, ws->nlo, 0, 1 );
+    rngmed_heap_down( ws->hi, ws->pos, value, ws->nhi, 0, 0 );
+  }
+}
+
+static REAL8 rngmed_heap_median( const LALRunningMedianWorkspace *ws ) {
+  if ( ws->nlo > ws->nhi )
+    return ws->value[ws->lo[0]];
+  else
+    return ( ws->value[ws->lo[0]] + ws->value[ws->hi[0]] ) / 2.0;
+}
+
+
+/**
+ * Create a workspace for the XLAL running median functions, for blocks of
+ * \c blocksize elements. A workspace may be reused for any number of
+ * sequences, but must not be shared between threads.
+ */
+LALRunningMedianWorkspace *XLALCreateRunningMedianWorkspace( UINT4 blocksize )
+{
+  XLAL_CHECK_NULL( blocksize > 0, XLAL_EINVAL, "Invalid input: block length must be >0" );
+
+  LALRunningMedianWorkspace *ws = XLALCalloc( 1, sizeof( *ws ) );
+  XLAL_CHECK_NULL( ws != NULL, XLAL_ENOMEM );
+  ws->blocksize = blocksize;
+  ws->nlo = ( blocksize + 1 ) / 2;
+  ws->nhi = blocksize / 2;
+  ws->value = XLALMalloc( blocksize * sizeof( ws->value[0] ) );
+  ws->lo = XLALMalloc( ws->nlo * sizeof( ws->lo[0] ) );
+  ws->hi = XLALMalloc( ( ws->nhi > 0 ? ws->nhi : 1 ) * sizeof( ws->hi[0] ) );
+  ws->pos = XLALMalloc( blocksize * sizeof( ws->pos[0] ) );
+  ws->inhi = XLALMalloc( blocksize * sizeof( ws->inhi[0] ) );
+  ws->sortbuf = XLALMalloc( blocksize * sizeof( ws->sortbuf[0] ) );
+  if ( !ws->value || !ws->lo || !ws->hi || !ws->pos || !ws->inhi || !ws->sortbuf ) {
+    XLALDestroyRunningMedianWorkspace( ws );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+
+  return ws;
+}
+
+
+/**
+ * Destroy a workspace created by XLALCreateRunningMedianWorkspace().
+ */
+void XLALDestroyRunningMedianWorkspace( LALRunningMedianWorkspace *workspace )
+{
+  if ( workspace == NULL )
+    return;
+  XLALFree( workspace->value );
+  XLALFree( workspace->lo );
+  XLALFree( workspace->hi );
+  XLALFree( workspace->pos );
+  XLALFree( workspace->inhi );
+  XLALFree( workspace->sortbuf );
+  XLALFree( workspace );
+}
+
+
+/**
+ * Return the block length of a running median workspace.
+ */
+UINT4 XLALRunningMedianWorkspaceBlocksize( const LALRunningMedianWorkspace *workspace )
+{
+  XLAL_CHECK_VAL( 0, workspace != NULL, XLAL_EFAULT );
+  return workspace->blocksize;
+}
+
+
+/**
+ * Calculate the running medians of a REAL8Sequence using a given workspace.
+ * With n being the length of \c input and b the workspace block length,
+ * \c medians must be of length (n-b+1). For even block lengths the median is
+ * the mean of the two middle values, as in LALDRunningMedian2().
+ */
+int XLALDRunningMedianWithWorkspace( LALRunningMedianWorkspace *workspace,
+                                     REAL8Sequence *medians,
+                                     const REAL8Sequence *input )
+{
+  XLAL_CHECK( workspace != NULL, XLAL_EFAULT );
+  XLAL_CHECK( medians != NULL && medians->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( input != NULL && input->data != NULL, XLAL_EFAULT );
+  const UINT4 bsize = workspace->blocksize;
+  XLAL_CHECK( bsize <= input->length, XLAL_EINVAL, "Invalid input: block length %u larger than input length %u", bsize, input->length );
+  const UINT4 nmedians = input->length - bsize + 1;
+  XLAL_CHECK( medians->length == nmedians, XLAL_EINVAL, "Invalid input: median array has length %u, expected %u", medians->length, nmedians );
+
+  memcpy( workspace->value, input->data, bsize * sizeof( workspace->value[0] ) );
+  rngmed_heap_init( workspace );
+  medians->data[0] = rngmed_heap_median( workspace );
+
+  for ( UINT4 m = 1, slot = 0; m < nmedians; m++ ) {
+    rngmed_heap_replace( workspace, slot, input->data[m + bsize - 1] );
+    medians->data[m] = rngmed_heap_median( workspace );
+    if ( ++slot == bsize )
+      slot = 0;
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Calculate the running medians of a REAL4Sequence using a given workspace.
+ * See XLALDRunningMedianWithWorkspace().
+ */
+int XLALSRunningMedianWithWorkspace( LALRunningMedianWorkspace *workspace,
+                                     REAL4Sequence *medians,
+                                     const REAL4Sequence *input )
+{
+  XLAL_CHECK( workspace != NULL, XLAL_EFAULT );
+  XLAL_CHECK( medians != NULL && medians->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( input != NULL && input->data != NULL, XLAL_EFAULT );
+  const UINT4 bsize = workspace->blocksize;
+  XLAL_CHECK( bsize <= input->length, XLAL_EINVAL, "Invalid input: block length %u larger than input length %u", bsize, input->length );
+  const UINT4 nmedians = input->length - bsize + 1;
+  XLAL_CHECK( medians->length == nmedians, XLAL_EINVAL, "Invalid input: median array has length %u, expected %u", medians->length, nmedians );
+
+  for ( UINT4 k = 0; k < bsize; k++ )
+    workspace->value[k] = input->data[k];
+  rngmed_heap_init( workspace );
+  medians->data[0] = rngmed_heap_median( workspace );
+
+  for ( UINT4 m = 1, slot = 0; m < nmedians; m++ ) {
+    rngmed_heap_replace( workspace, slot, input->data[m + bsize - 1] );
+    medians->data[m] = rngmed_heap_median( workspace );
+    if ( ++slot == bsize )
+      slot = 0;
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Calculate the running medians of a REAL8Sequence over blocks of
+ * \c blocksize elements. See XLALDRunningMedianWithWorkspace().
+ */
+int XLALDRunningMedian( REAL8Sequence *medians,
+                        const REAL8Sequence *input,
+                        UINT4 blocksize )
+{
+  LALRunningMedianWorkspace *ws = XLALCreateRunningMedianWorkspace( blocksize );
+  XLAL_CHECK( ws != NULL, XLAL_EFUNC );
+  int retn = XLALDRunningMedianWithWorkspace( ws, medians, input );
+  XLALDestroyRunningMedianWorkspace( ws );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * Calculate the running medians of a REAL4Sequence over blocks of
+ * \c blocksize elements. See XLALDRunningMedianWithWorkspace().
+ */
+int XLALSRunningMedian( REAL4Sequence *medians,
+                        const REAL4Sequence *input,
+                        UINT4 blocksize )
+{
+  LALRunningMedianWorkspace *ws = XLALCreateRunningMedianWorkspace( blocksize );
+  XLAL_CHECK( ws != NULL, XLAL_EFUNC );
+  int retn = XLALSRunningMedianWithWorkspace( ws, medians, input );
+  XLALDestroyRunningMedianWorkspace( ws );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
@@ -54,6 +54,15 @@ extern "C" {
  * <tt>LALDRunningMedian()</tt>, but has proven to be a
  * little faster and more stable. Check if it works for you.
  *
+ * <tt>XLALDRunningMedian()</tt> and <tt>XLALSRunningMedian()</tt> compute the
+ * same medians using an indexed double heap, at a cost of O(log b) per median
+ * instead of O(b). They accept any blocksize \f$ b\geq 1 \f$. When many
+ * sequences are processed with the same blocksize, a workspace created by
+ * <tt>XLALCreateRunningMedianWorkspace()</tt> can be passed to
+ * <tt>XLALDRunningMedianWithWorkspace()</tt> or
+ * <tt>XLALSRunningMedianWithWorkspace()</tt> to avoid repeated allocations;
+ * separate threads must use separate workspaces.
+ *
  * ### Algorithm ###
  *
  * For a detailed description of the algorithm see the
@@ -106,6 +115,9 @@ typedef struct tagLALRunningMedianPar
 }
 LALRunningMedianPar;
 
+/** Opaque workspace for the XLAL running median functions */
+typedef struct tagLALRunningMedianWorkspace LALRunningMedianWorkspace;
+
 
 /* Function prototypes. */
 
@@ -137,6 +149,14 @@ LALSRunningMedian2( LALStatus *status,
 		    const REAL4Sequence *input,
 		    LALRunningMedianPar param);
 
+LALRunningMedianWorkspace *XLALCreateRunningMedianWorkspace( UINT4 blocksize );
+void XLALDestroyRunningMedianWorkspace( LALRunningMedianWorkspace *workspace );
+UINT4 XLALRunningMedianWorkspaceBlocksize( const LALRunningMedianWorkspace *workspace );
+int XLALDRunningMedianWithWorkspace( LALRunningMedianWorkspace *workspace, REAL8Sequence *medians, const REAL8Sequence *input );
+int XLALSRunningMedianWithWorkspace( LALRunningMedianWorkspace *workspace, REAL4Sequence *medians, const REAL4Sequence *input );
+int XLALDRunningMedian( REAL8Sequence *medians, const REAL8Sequence *input, UINT4 blocksize );
+int XLALSRunningMedian( REAL4Sequence *medians, const REAL4Sequence *input, UINT4 blocksize );
+
 /** @} */
 
 #ifdef  __cplusplus
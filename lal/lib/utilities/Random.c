@@ -23,6 +23,7 @@
 #include <lal/Random.h>
 #include <lal/Sequence.h>
 #include <lal/XLALError.h>
+#include <lal/LALConstants.h>
 
 /**
  * \defgroup Random_c Module Random.c
@@ -43,6 +44,13 @@
  * The routine <tt>LALNormalDeviates()</tt> fills a vector with normal (Gaussian)
  * deviates with zero mean and unit variance, whereas the function\c XLALNormalDeviate just returns one normal distributed random number.
  *
+ * The routines <tt>XLALPhiloxUniformDeviates()</tt>, <tt>XLALPhiloxNormalDeviates()</tt>
+ * and <tt>XLALPhiloxNormalDeviatesREAL4()</tt> instead use the stateless
+ * counter-based generator Philox4x32-10 \cite salmon2011.  A sample is
+ * identified by a seed, a stream number (e.g. a detector index) and its
+ * index within the stream, so that any block of samples can be generated
+ * independently of any other, e.g. in parallel, with identical results.
+ *
  * ### Operating Instructions ###
  *
  * \code
@@ -254,6 +262,151 @@ REAL4 XLALNormalDeviate( RandomParams *params )
   return deviate;
 }
 
+/*
+ *
+ * Counter-based (Philox4x32-10) routines.
+ *
+ */
+
+/* Philox4x32 multipliers and Weyl key increments, see Salmon et al. (2011) */
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+
+/* number of counters processed at once by the block routines */
+#define PHILOX_BLOCK 64
+
+/**
+ * Apply the Philox4x32-10 bijection to the counter \c ctr under the key
+ * \c key, storing the 128 random bits in \c out.  The function is
+ * stateless: the same counter and key always give the same output.
+ */
+void XLALPhilox4x32( UINT4 out[4], const UINT4 ctr[4], const UINT4 key[2] )
+{
+  UINT4 c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  UINT4 k0 = key[0], k1 = key[1];
+  for ( int round = 0; round < 10; ++round ) {
+    const UINT8 p0 = (UINT8) PHILOX_M0 * c0;
+    const UINT8 p1 = (UINT8) PHILOX_M1 * c2;
+    const UINT4 n0 = (UINT4) ( p1 >> 32 ) ^ c1 ^ k0;
+    const UINT4 n2 = (UINT4) ( p0 >> 32 ) ^ c3 ^ k1;
+    c1 = (UINT4) p1;
+    c3 = (UINT4) p0;
+    c0 = n0;
+    c2 = n2;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+/*
+ * Fill u0[i], u1[i] with the two uniform deviates in (0,1) given by counter
+ * (ctr + i) of the given stream, for i < n.  The loop is free of branches so
+ * that it can be vectorized by the compiler.
+ */
+static void philox_uniform_pairs( REAL8 *u0, REAL8 *u1, UINT8 ctr, UINT4 n, UINT8 seed, UINT8 stream )
+{
+  const UINT4 key[2] = { (UINT4) seed, (UINT4) ( seed >> 32 ) };
+  for ( UINT4 i = 0; i < n; ++i ) {
+    const UINT4 c[4] = { (UINT4) ( ctr + i ), (UINT4) ( ( ctr + i ) >> 32 ), (UINT4) stream, (UINT4) ( stream >> 32 ) };
+    UINT4 x[4];
+    XLALPhilox4x32( x, c, key );
+    /* 53 random bits each, shifted by half a unit so neither 0 nor 1 occurs */
+    const UINT8 b0 = ( ( (UINT8) x[0] << 32 ) | x[1] ) >> 11;
+    const UINT8 b1 = ( ( (UINT8) x[2] << 32 ) | x[3] ) >> 11;
+    u0[i] = ( b0 + 0.5 ) * 0x1p-53;
+    u1[i] = ( b1 + 0.5 ) * 0x1p-53;
+  }
+}
+
+/*
+ * Fill z0[i], z1[i] with the Box-Muller pair of normal deviates given by
+ * counter (ctr + i) of the given stream, for i < n.
+ */
+static void philox_normal_pairs( REAL8 *z0, REAL8 *z1, UINT8 ctr, UINT4 n, UINT8 seed, UINT8 stream )
+{
+  REAL8 u0[PHILOX_BLOCK], u1[PHILOX_BLOCK];
+  philox_uniform_pairs( u0, u1, ctr, n, seed, stream );
+  for ( UINT4 i = 0; i < n; ++i ) {
+    const REAL8 rad = sqrt( -2.0 * log( u0[i] ) );
+    const REAL8 phi = LAL_TWOPI * u1[i];
+    z0[i] = rad * cos( phi );
+    z1[i] = rad * sin( phi );
+  }
+}
+
+/*
+ * Generic driver: sample k of a stream is element (k % 2) of the pair given
+ * by counter (k / 2), so any range of samples can be generated on its own.
+ */
+static void philox_fill( REAL8 *out8, REAL4 *out4, UINT4 length, UINT8 seed, UINT8 stream, UINT8 offset,
+                         void (*pairs)( REAL8 *, REAL8 *, UINT8, UINT4, UINT8, UINT8 ) )
+{
+  REAL8 v0[PHILOX_BLOCK], v1[PHILOX_BLOCK];
+  const UINT8 end = offset + length;
+  for ( UINT8 ctr = offset / 2; 2 * ctr < end; ctr += PHILOX_BLOCK ) {
+    const UINT4 n = ( ( end + 1 ) / 2 - ctr < PHILOX_BLOCK ) ? ( end + 1 ) / 2 - ctr : PHILOX_BLOCK;
+    (*pairs)( v0, v1, ctr, n, seed, stream );
+    for ( UINT4 i = 0; i < n; ++i ) {
+      const UINT8 k = 2 * ( ctr + i );
+      if ( k >= offset ) {
+        if ( out8 ) out8[k - offset] = v0[i];
+        else out4[k - offset] = v0[i];
+      }
+      if ( k + 1 >= offset && k + 1 < end ) {
+        if ( out8 ) out8[k + 1 - offset] = v1[i];
+        else out4[k + 1 - offset] = v1[i];
+      }
+    }
+  }
+}
+
+/**
+ * Fill a vector with uniform deviates in (0,1) from a counter-based
+ * Philox4x32-10 generator.  Element \c i of the vector is sample
+ * <tt>offset + i</tt> of stream \c stream for the given \c seed, and does
+ * not depend on how a stream is split into vectors; distinct (e.g. per
+ * detector) streams are statistically independent.  This allows blocks of
+ * random numbers to be generated in parallel and reproducibly.
+ */
+int XLALPhiloxUniformDeviates( REAL8Vector *deviates, UINT8 seed, UINT8 stream, UINT8 offset )
+{
+  XLAL_CHECK( deviates && deviates->data, XLAL_EFAULT );
+  XLAL_CHECK( deviates->length, XLAL_EBADLEN );
+  philox_fill( deviates->data, NULL, deviates->length, seed, stream, offset, philox_uniform_pairs );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Fill a vector with normal deviates with zero mean and unit variance from
+ * a counter-based Philox4x32-10 generator, using the Box-Muller transform.
+ * Samples are addressed as in XLALPhiloxUniformDeviates().
+ */
+int XLALPhiloxNormalDeviates( REAL8Vector *deviates, UINT8 seed, UINT8 stream, UINT8 offset )
+{
+  XLAL_CHECK( deviates && deviates->data, XLAL_EFAULT );
+  XLAL_CHECK( deviates->length, XLAL_EBADLEN );
+  philox_fill( deviates->data, NULL, deviates->length, seed, stream, offset, philox_normal_pairs );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Single-precision version of XLALPhiloxNormalDeviates(); the deviates are
+ * those of the double-precision version rounded to single precision.
+ */
+int XLALPhiloxNormalDeviatesREAL4( REAL4Vector *deviates, UINT8 seed, UINT8 stream, UINT8 offset )
+{
+  XLAL_CHECK( deviates && deviates->data, XLAL_EFAULT );
+  XLAL_CHECK( deviates->length, XLAL_EBADLEN );
+  philox_fill( NULL, deviates->data, deviates->length, seed, stream, offset, philox_normal_pairs );
+  return XLAL_SUCCESS;
+}
+
 /*
  *
  * LAL Routines.
@@ -101,6 +101,13 @@ REAL4 XLALUniformDeviate( RandomParams *params );
 int XLALNormalDeviates( REAL4Vector *deviates, RandomParams *params );
 REAL4 XLALNormalDeviate( RandomParams *params );
 
+#ifndef SWIG /* exclude from SWIG interface */
+void XLALPhilox4x32( UINT4 out[4], const UINT4 ctr[4], const UINT4 key[2] );
+#endif /* SWIG */
+int XLALPhiloxUniformDeviates( REAL8Vector *deviates, UINT8 seed, UINT8 stream, UINT8 offset );
+int XLALPhiloxNormalDeviates( REAL8Vector *deviates, UINT8 seed, UINT8 stream, UINT8 offset );
+int XLALPhiloxNormalDeviatesREAL4( REAL4Vector *deviates, UINT8 seed, UINT8 stream, UINT8 offset );
+
 void
 LALCreateRandomParams (
     LALStatus        *status,
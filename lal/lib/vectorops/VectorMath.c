@@ -193,6 +193,7 @@ EXPORT_VECTORMATH_DD2D(Max, AVX2, AVX, NONE, NONE)
   EXPORT_VECTORMATH_ANY( NAME ## COMPLEX8, (COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
 
 EXPORT_VECTORMATH_CC2C(Multiply, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_CC2C(MultiplyConj, AVX2, AVX, SSE2, NONE)
 EXPORT_VECTORMATH_CC2C(Add, AVX2, AVX, SSE2, NONE)
 
 // ---------- define exported vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
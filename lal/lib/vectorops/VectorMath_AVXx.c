@@ -184,6 +184,17 @@ local_cmul_ps ( __m256 in1, __m256 in2 )
   return _mm256_permute_ps(in2, 0xd8);
 }
 
+// in1: a0,b0,a1,b1,a2,b2,a3,b3 in2: c0,d0,c1,d1,c2,d2,c3,d3
+UNUSED static inline __m256
+local_cmulconj_ps ( __m256 in1, __m256 in2 )
+{
+  // Negate the imaginary elements of in2
+  // c0,-d0,c1,-d1,c2,-d2,c3,-d3
+  in2 = _mm256_mul_ps(in2, _mm256_setr_ps(1.0, -1.0, 1.0, -1.0, 1.0, -1.0, 1.0, -1.0));
+
+  return local_cmul_ps(in1, in2);
+}
+
 // ========== internal generic AVXx functions ==========
 
 // ---------- generic AVXx operator with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -524,6 +535,7 @@ DEFINE_VECTORMATH_DD2D(Max, local_max_pd)
   DEFINE_VECTORMATH_ANY( XLALVectorMath_CC2C_AVXx, NAME ## COMPLEX8, ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
 
 DEFINE_VECTORMATH_CC2C(Multiply, local_cmul_ps)
+DEFINE_VECTORMATH_CC2C(MultiplyConj, local_cmulconj_ps)
 DEFINE_VECTORMATH_CC2C(Add, local_add_ps)
 
 // ---------- define vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
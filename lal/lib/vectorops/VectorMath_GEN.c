@@ -75,6 +75,11 @@ static inline COMPLEX8 local_cmulf ( COMPLEX8 x, COMPLEX8 y )
   return x * y;
 }
 
+static inline COMPLEX8 local_cmulconjf ( COMPLEX8 x, COMPLEX8 y )
+{
+  return x * conjf ( y );
+}
+
 static inline COMPLEX8 local_caddf ( COMPLEX8 x, COMPLEX8 y )
 {
   return x + y;
@@ -258,6 +263,7 @@ DEFINE_VECTORMATH_DD2D(Max, fmax)
   DEFINE_VECTORMATH_ANY( XLALVectorMath_CC2C_GEN, NAME ## COMPLEX8, ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
 
 DEFINE_VECTORMATH_CC2C(Multiply, local_cmulf)
+DEFINE_VECTORMATH_CC2C(MultiplyConj, local_cmulconjf)
 DEFINE_VECTORMATH_CC2C(Add, local_caddf)
 
 // ---------- define vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
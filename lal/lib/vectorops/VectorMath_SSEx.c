@@ -118,6 +118,17 @@ local_cmul_ps ( __m128 in1, __m128 in2 )
   return _mm_shuffle_ps(result, result,0b11011000);
 }
 
+// in1: a0,b0,a1,b1, in2: c0,d0,c1,d1
+UNUSED static inline __m128
+local_cmulconj_ps ( __m128 in1, __m128 in2 )
+{
+  // Negate the imaginary elements of in2
+  // c0,-d0,c1,-d1
+  in2 = _mm_mul_ps(in2, _mm_setr_ps(1.0, -1.0, 1.0, -1.0));
+
+  return local_cmul_ps(in1, in2);
+}
+
 // ========== internal generic SSEx functions ==========
 
 // ---------- generic SSEx operator with 1 REAL4 vector input to 1 INT4 vector output (S2I) ----------
@@ -461,6 +472,7 @@ DEFINE_VECTORMATH_DD2D(Multiply, local_mul_pd)
   DEFINE_VECTORMATH_ANY( XLALVectorMath_CC2C_SSEx, NAME ## COMPLEX8, ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
 
 DEFINE_VECTORMATH_CC2C(Multiply, local_cmul_ps)
+DEFINE_VECTORMATH_CC2C(MultiplyConj, local_cmulconj_ps)
 DEFINE_VECTORMATH_CC2C(Add, local_add_ps)
 
 // ---------- define vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector inputs to 1 COMPLEX8 vector output (cC2C) ----------
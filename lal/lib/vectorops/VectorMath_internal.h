@@ -122,6 +122,7 @@ DECLARE_VECTORMATH_DD2D(Max, AVX2, AVX, NONE, NONE)
   DECLARE_VECTORMATH_ANY( NAME ## COMPLEX8, ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len ), __VA_ARGS__ )
 
 DECLARE_VECTORMATH_CC2C(Multiply, AVX2, AVX, SSE2, NONE)
+DECLARE_VECTORMATH_CC2C(MultiplyConj, AVX2, AVX, SSE2, NONE)
 DECLARE_VECTORMATH_CC2C(Add, AVX2, AVX, SSE2, NONE)
 
 /* declare internal prototypes of SIMD-specific vector math functions with 1 COMPLEX8 scalar and 1 COMPLEX8 vector input to 1 COMPLEX8 vector output (cC2C) */
@@ -0,0 +1,168 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/Date.h>
+#include <lal/FrequencySeries.h>
+#include <lal/TimeSeries.h>
+#include <lal/TimeFreqFFT.h>
+#include <lal/Units.h>
+#include <lal/RealFFT.h>
+#include <lal/Window.h>
+#include <lal/Random.h>
+
+/*
+ * Feed a time series to a LALStreamingPSD in irregular chunks, and check
+ * that whenever the window is full the streamed PSD equals the batch
+ * estimate over the data the window spans.
+ */
+static int test_method( LALStreamingPSDMethod method, const REAL8TimeSeries *tseries, UINT4 seglen, UINT4 stride, UINT4 numseg, const REAL8Window *window, const REAL8FFTPlan *plan )
+{
+  static const UINT4 chunks[] = { 1, 7, 500, 33, 1024, 3000, 2 };
+  const UINT4 nchunks = sizeof( chunks ) / sizeof( *chunks );
+  const UINT4 span = ( numseg - 1 ) * stride + seglen;
+  LALStreamingPSD *s;
+  REAL8FrequencySeries *batch;
+  UINT4 start = 0;
+  UINT4 totalseg = 0;
+  UINT4 nchecks = 0;
+  UINT4 c = 0;
+
+  s = XLALStreamingPSDNew( seglen, stride, numseg, method, window, plan );
+  batch = XLALCreateREAL8FrequencySeries( "batch", &tseries->epoch, 0.0, 0.0, &lalDimensionlessUnit, seglen / 2 + 1 );
+  if ( ! s || ! batch )
+    return 1;
+
+  while ( start < tseries->data->length )
+  {
+    UINT4 len = chunks[c++ % nchunks];
+    REAL8TimeSeries *chunk;
+    int nnew;
+
+    if ( start + len > tseries->data->length )
+      len = tseries->data->length - start;
+    chunk = XLALCutREAL8TimeSeries( tseries, start, len );
+    nnew = XLALStreamingPSDAdd( s, chunk );
+    XLALDestroyREAL8TimeSeries( chunk );
+    if ( nnew < 0 )
+      return 1;
+    start += len;
+    totalseg += nnew;
+
+    if ( nnew && XLALStreamingPSDGetNSegments( s ) == numseg )
+    {
+      /* the window spans the data starting at the oldest segment */
+      const UINT4 first = ( totalseg - numseg ) * stride;
+      REAL8TimeSeries *record = XLALCutREAL8TimeSeries( tseries, first, span );
+      REAL8FrequencySeries *psd = XLALStreamingPSDGetPSD( s );
+      UINT4 k;
+      int code;
+
+      if ( ! record || ! psd )
+        return 1;
+      if ( method == LAL_STREAMING_PSD_WELCH )
+        code = XLALREAL8AverageSpectrumWelch( batch, record, seglen, stride, window, plan );
+      else if ( method == LAL_STREAMING_PSD_MEDIAN )
+        code = XLALREAL8AverageSpectrumMedian( batch, record, seglen, stride, window, plan );
+      else
+        code = XLALREAL8AverageSpectrumMedianMean( batch, record, seglen, stride, window, plan );
+      if ( code )
+        return 1;
+
+      for ( k = 0; k < psd->data->length; ++k )
+        if ( fabs( psd->data->data[k] - batch->data->data[k] ) > 1e-12 * fabs( batch->data->data[k] ) )
+        {
+          fprintf( stderr, "method %d: bin %u differs: streamed %.17g, batch %.17g\n", method, k, psd->data->data[k], batch->data->data[k] );
+          return 1;
+        }
+      if ( XLALGPSCmp( &psd->epoch, &record->epoch ) || psd->deltaF != batch->deltaF )
+      {
+        fprintf( stderr, "method %d: metadata differs\n", method );
+        return 1;
+      }
+
+      XLALDestroyREAL8FrequencySeries( psd );
+      XLALDestroyREAL8TimeSeries( record );
+      ++nchecks;
+    }
+  }
+
+  /* data that is not contiguous must be rejected */
+  {
+    REAL8TimeSeries *chunk = XLALCutREAL8TimeSeries( tseries, 0, 16 );
+    int code;
+    XLAL_TRY( code = XLALStreamingPSDAdd( s, chunk ), code );
+    XLALDestroyREAL8TimeSeries( chunk );
+    if ( code != XLAL_EDATA )
+    {
+      fprintf( stderr, "method %d: non-contiguous data accepted\n", method );
+      return 1;
+    }
+  }
+
+  fprintf( stdout, "method %d: %u comparisons passed\n", method, nchecks );
+
+  XLALDestroyREAL8FrequencySeries( batch );
+  XLALStreamingPSDFree( s );
+  return nchecks ? 0 : 1;
+}
+
+int main( void )
+{
+  const UINT4 seglen = 256;
+  const UINT4 stride = 128;
+  const UINT4 numseg = 16;
+  const UINT4 length = 16384;
+  const LIGOTimeGPS epoch = { 1000000000, 0 };
+  REAL8TimeSeries *tseries;
+  REAL4Vector *deviates;
+  RandomParams *randpar;
+  REAL8FFTPlan *plan;
+  REAL8Window *window;
+  UINT4 i;
+  int fail = 0;
+
+  tseries = XLALCreateREAL8TimeSeries( "data", &epoch, 0.0, 1.0 / 1024, &lalDimensionlessUnit, length );
+  deviates = XLALCreateREAL4Vector( length );
+  randpar = XLALCreateRandomParams( 1 );
+  XLALNormalDeviates( deviates, randpar );
+  for ( i = 0; i < length; ++i )
+    tseries->data->data[i] = deviates->data[i];
+  XLALDestroyRandomParams( randpar );
+  XLALDestroyREAL4Vector( deviates );
+
+  plan = XLALCreateForwardREAL8FFTPlan( seglen, 0 );
+  window = XLALCreateHannREAL8Window( seglen );
+
+  fail |= test_method( LAL_STREAMING_PSD_WELCH, tseries, seglen, stride, numseg, window, plan );
+  fail |= test_method( LAL_STREAMING_PSD_MEDIAN, tseries, seglen, stride, numseg - 1, window, plan );
+  fail |= test_method( LAL_STREAMING_PSD_MEDIAN, tseries, seglen, stride, numseg, window, plan );
+  fail |= test_method( LAL_STREAMING_PSD_MEDIAN_MEAN, tseries, seglen, stride, numseg, window, plan );
+  /* segments separated by gaps */
+  fail |= test_method( LAL_STREAMING_PSD_WELCH, tseries, seglen, seglen + 100, 4, window, plan );
+
+  XLALDestroyREAL8Window( window );
+  XLALDestroyREAL8FFTPlan( plan );
+  XLALDestroyREAL8TimeSeries( tseries );
+
+  LALCheckMemoryLeaks();
+  return fail;
+}
@@ -0,0 +1,150 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/Sequence.h>
+#include <lal/TimeSeries.h>
+#include <lal/ResampleTimeSeries.h>
+#include <lal/Units.h>
+
+int main(void)
+{
+
+  LALMemoryArenaStats stats;
+
+  /* without an arena, factories allocate as usual */
+  XLAL_CHECK_MAIN(XLALGetMemoryArenaStats(&stats) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(stats.depth == 0 && stats.allocations == 0, XLAL_EFAILED);
+  REAL8Vector *outside = XLALCreateREAL8Vector(100);
+  XLAL_CHECK_MAIN(outside != NULL, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALGetMemoryArenaStats(&stats) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(stats.allocations == 0, XLAL_EFAILED);
+
+  /* popping without an arena is an error */
+  XLAL_CHECK_MAIN(XLALPopMemoryArena() == XLAL_FAILURE && xlalErrno == XLAL_EFAILED, XLAL_EFAILED);
+  XLALClearErrno();
+
+  /* repeated create/destroy cycles inside an arena reuse the same memory */
+  XLAL_CHECK_MAIN(XLALPushMemoryArena(4096) == XLAL_SUCCESS, XLAL_EFUNC);
+  for (int k = 0; k < 1000; ++k) {
+    COMPLEX16Vector *v = XLALCreateCOMPLEX16Vector(64);
+    XLAL_CHECK_MAIN(v != NULL && v->length == 64, XLAL_EFUNC);
+    for (UINT4 i = 0; i < v->length; ++i) {
+      v->data[i] = i + k;
+    }
+    REAL8TimeSeries *ts = XLALCreateREAL8TimeSeries("ts", NULL, 0, 1, &lalDimensionlessUnit, 32);
+    XLAL_CHECK_MAIN(ts != NULL, XLAL_EFUNC);
+    XLALDestroyREAL8TimeSeries(ts);
+    XLALDestroyCOMPLEX16Vector(v);
+  }
+  XLAL_CHECK_MAIN(XLALGetMemoryArenaStats(&stats) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(stats.depth == 1, XLAL_EFAILED);
+  XLAL_CHECK_MAIN(stats.allocations == 5000, XLAL_EFAILED, "allocations = %zu", stats.allocations);
+  XLAL_CHECK_MAIN(stats.blocks == 1, XLAL_EFAILED, "blocks = %zu", stats.blocks);
+
+  /* zero-length allocations return NULL without error, and are safe to free */
+  void *z = XLALArenaMalloc(0);
+  XLAL_CHECK_MAIN(z == NULL && xlalErrno == 0, XLAL_EFAILED);
+  XLALFree(z);
+#ifdef LAL_FFTW3_MEMALIGN_ENABLED
+  z = XLALArenaMallocAligned(0);
+  XLAL_CHECK_MAIN(z == NULL && xlalErrno == 0, XLAL_EFAILED);
+  XLALFreeAligned(z);
+#endif
+  REAL8Vector *empty = XLALCreateREAL8Vector(0);
+  XLAL_CHECK_MAIN(empty != NULL && empty->length == 0, XLAL_EFUNC);
+  XLALDestroyREAL8Vector(empty);
+  XLAL_CHECK_MAIN(XLALGetMemoryArenaStats(&stats) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(stats.allocations == 5001, XLAL_EFAILED, "allocations = %zu", stats.allocations);
+
+  /* objects created outside the arena can be destroyed inside it */
+  XLALDestroyREAL8Vector(outside);
+
+  /* resizing preserves contents, both in place and when moved */
+  REAL8Vector *a = XLALCreateREAL8Vector(10);
+  REAL8Vector *b = XLALCreateREAL8Vector(10);
+  XLAL_CHECK_MAIN(a != NULL && b != NULL, XLAL_EFUNC);
+  for (UINT4 i = 0; i < 10; ++i) {
+    a->data[i] = b->data[i] = i;
+  }
+  XLAL_CHECK_MAIN(XLALResizeREAL8Vector(b, 1000) == b, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALResizeREAL8Vector(a, 2000) == a, XLAL_EFUNC);
+  for (UINT4 i = 0; i < 10; ++i) {
+    XLAL_CHECK_MAIN(a->data[i] == i && b->data[i] == i, XLAL_EFAILED);
+  }
+  XLAL_CHECK_MAIN(((size_t) a->data) % 16 == 0, XLAL_EFAILED);
+
+  /* nested arenas */
+  XLAL_CHECK_MAIN(XLALPushMemoryArena(0) == XLAL_SUCCESS, XLAL_EFUNC);
+  REAL8Sequence *s = XLALCreateREAL8Sequence(100);
+  XLAL_CHECK_MAIN(s != NULL, XLAL_EFUNC);
+  /* resizing an object of the outer arena moves it out of the inner arena */
+  XLAL_CHECK_MAIN(XLALResizeREAL8Vector(b, 5000) == b, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALGetMemoryArenaStats(&stats) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(stats.depth == 2, XLAL_EFAILED);
+  XLAL_CHECK_MAIN(XLALPopMemoryArena() == XLAL_SUCCESS, XLAL_EFUNC);
+  for (UINT4 i = 0; i < 10; ++i) {
+    XLAL_CHECK_MAIN(b->data[i] == i, XLAL_EFAILED);
+  }
+  XLALDestroyREAL8Vector(b);
+  XLALDestroyREAL8Vector(a);
+
+  XLAL_CHECK_MAIN(XLALPopMemoryArena() == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALGetMemoryArenaStats(&stats) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(stats.depth == 0, XLAL_EFAILED);
+
+  /* blocks are reused by later arenas */
+  const size_t blocks = stats.blocks;
+  XLAL_CHECK_MAIN(XLALPushMemoryArena(4096) == XLAL_SUCCESS, XLAL_EFUNC);
+  REAL8Vector *c = XLALCreateREAL8Vector(100);
+  XLAL_CHECK_MAIN(c != NULL, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALPopMemoryArena() == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALGetMemoryArenaStats(&stats) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(stats.blocks == blocks, XLAL_EFAILED);
+
+  /* LALRealloc and LALFree accept factory buffers allocated from an arena:
+   * resampling inside an arena gives the same result as outside it */
+  REAL8TimeSeries *ref = XLALCreateREAL8TimeSeries("ref", NULL, 0, 1.0 / 1024, &lalDimensionlessUnit, 4096);
+  XLAL_CHECK_MAIN(ref != NULL, XLAL_EFUNC);
+  for (UINT4 i = 0; i < ref->data->length; ++i) {
+    ref->data->data[i] = sin(0.05 * i) + 0.5 * cos(0.3 * i);
+  }
+  XLAL_CHECK_MAIN(XLALPushMemoryArena(0) == XLAL_SUCCESS, XLAL_EFUNC);
+  REAL8TimeSeries *ts = XLALCutREAL8TimeSeries(ref, 0, ref->data->length);
+  XLAL_CHECK_MAIN(ts != NULL, XLAL_EFUNC);
+  REAL8Vector *tail = XLALCreateREAL8Vector(10);
+  XLAL_CHECK_MAIN(tail != NULL, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALResampleREAL8TimeSeries(ts, 2 * ref->deltaT) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(XLALResampleREAL8TimeSeries(ref, 2 * ref->deltaT) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(ts->data->length == ref->data->length, XLAL_EFAILED);
+  XLAL_CHECK_MAIN(memcmp(ts->data->data, ref->data->data, ref->data->length * sizeof(REAL8)) == 0, XLAL_EFAILED);
+  LALFree(tail->data);
+  LALFree(tail);
+  XLALDestroyREAL8TimeSeries(ts);
+  XLAL_CHECK_MAIN(XLALPopMemoryArena() == XLAL_SUCCESS, XLAL_EFUNC);
+  XLALDestroyREAL8TimeSeries(ref);
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,142 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+#include <lal/LALTrace.h>
+#include <lal/XLALError.h>
+#include <lal/LALMalloc.h>
+
+static void traced(int n)
+{
+  XLAL_TRACE_START(timer, "traced");
+  volatile double x = 0;
+  for (int i = 0; i < n; ++i) {
+    x += i;
+  }
+  XLAL_TRACE_STOP(timer, n * sizeof(double));
+}
+
+#ifdef LAL_PTHREAD_LOCK
+static void *traced_thread(void *arg)
+{
+  (void) arg;
+  XLAL_TRACE_COUNT("counted", 3, 12);
+  return NULL;
+}
+#endif
+
+int main(void)
+{
+
+  /* enable tracing; summary is written to standard error at exit */
+  XLAL_CHECK_MAIN(setenv("LAL_TRACE", "csv", 1) == 0, XLAL_ESYS);
+  XLAL_CHECK_MAIN(XLALTraceEnabled(), XLAL_EFAILED);
+
+  /* same name gives same site */
+  const INT4 site = XLALTraceRegister("counted");
+  XLAL_CHECK_MAIN(site >= 0, XLAL_EFAILED);
+  XLAL_CHECK_MAIN(XLALTraceRegister("counted") == site, XLAL_EFAILED);
+
+  /* monotonic clock */
+  const INT8 t0 = XLALTraceNow();
+  for (int i = 0; i < 10; ++i) {
+    traced(1000);
+    XLAL_TRACE_COUNT("counted", 2, 8);
+  }
+  XLAL_CHECK_MAIN(XLALTraceNow() >= t0, XLAL_EFAILED);
+
+  /* check summary contents */
+  char buf[4096];
+  FILE *fp = tmpfile();
+  XLAL_CHECK_MAIN(fp != NULL, XLAL_ESYS);
+  XLAL_CHECK_MAIN(XLALTraceWriteSummary(fp, "csv") == XLAL_SUCCESS, XLAL_EFUNC);
+  rewind(fp);
+  XLAL_CHECK_MAIN(fgets(buf, sizeof(buf), fp) != NULL, XLAL_EIO);
+  XLAL_CHECK_MAIN(strncmp(buf, "name,calls,", 11) == 0, XLAL_EFAILED, "Unexpected header '%s'", buf);
+  int found = 0;
+  while (fgets(buf, sizeof(buf), fp) != NULL) {
+    char name[64];
+    unsigned long long calls, bytes, threads;
+    double seconds, mean;
+    XLAL_CHECK_MAIN(sscanf(buf, "%63[^,],%llu,%lg,%lg,%llu,%llu", name, &calls, &seconds, &mean, &bytes, &threads) == 6, XLAL_EFAILED, "Could not parse '%s'", buf);
+    XLAL_CHECK_MAIN(threads == 1, XLAL_EFAILED);
+    if (strcmp(name, "traced") == 0) {
+      XLAL_CHECK_MAIN(calls == 10 && bytes == 10 * 1000 * sizeof(double) && seconds >= 0, XLAL_EFAILED, "Bad entry '%s'", buf);
+      ++found;
+    } else if (strcmp(name, "counted") == 0) {
+      XLAL_CHECK_MAIN(calls == 20 && bytes == 80 && seconds == 0, XLAL_EFAILED, "Bad entry '%s'", buf);
+      ++found;
+    }
+  }
+  XLAL_CHECK_MAIN(found == 2, XLAL_EFAILED);
+  fclose(fp);
+
+  /* reset clears accumulators */
+  XLALTraceReset();
+  fp = tmpfile();
+  XLAL_CHECK_MAIN(fp != NULL, XLAL_ESYS);
+  XLAL_CHECK_MAIN(XLALTraceWriteSummary(fp, "json") == XLAL_SUCCESS, XLAL_EFUNC);
+  rewind(fp);
+  XLAL_CHECK_MAIN(fgets(buf, sizeof(buf), fp) != NULL && strcmp(buf, "[\n") == 0, XLAL_EFAILED);
+  XLAL_CHECK_MAIN(fgets(buf, sizeof(buf), fp) != NULL && strcmp(buf, "]\n") == 0, XLAL_EFAILED);
+  fclose(fp);
+
+#ifdef LAL_PTHREAD_LOCK
+  /* accumulators of exited threads are kept in the summary */
+  pthread_t threads[2];
+  for (int i = 0; i < 2; ++i) {
+    XLAL_CHECK_MAIN(pthread_create(&threads[i], NULL, traced_thread, NULL) == 0, XLAL_ESYS);
+  }
+  for (int i = 0; i < 2; ++i) {
+    XLAL_CHECK_MAIN(pthread_join(threads[i], NULL) == 0, XLAL_ESYS);
+  }
+  XLAL_TRACE_COUNT("counted", 1, 4);
+  fp = tmpfile();
+  XLAL_CHECK_MAIN(fp != NULL, XLAL_ESYS);
+  XLAL_CHECK_MAIN(XLALTraceWriteSummary(fp, "csv") == XLAL_SUCCESS, XLAL_EFUNC);
+  rewind(fp);
+  XLAL_CHECK_MAIN(fgets(buf, sizeof(buf), fp) != NULL, XLAL_EIO);
+  found = 0;
+  while (fgets(buf, sizeof(buf), fp) != NULL) {
+    char name[64];
+    unsigned long long calls, bytes, threads;
+    double seconds, mean;
+    XLAL_CHECK_MAIN(sscanf(buf, "%63[^,],%llu,%lg,%lg,%llu,%llu", name, &calls, &seconds, &mean, &bytes, &threads) == 6, XLAL_EFAILED, "Could not parse '%s'", buf);
+    XLAL_CHECK_MAIN(strcmp(name, "counted") == 0, XLAL_EFAILED, "Unexpected entry '%s'", buf);
+    XLAL_CHECK_MAIN(calls == 7 && bytes == 28 && threads == 3, XLAL_EFAILED, "Bad entry '%s'", buf);
+    ++found;
+  }
+  XLAL_CHECK_MAIN(found == 1, XLAL_EFAILED);
+  fclose(fp);
+#endif
+
+  /* unknown format */
+  XLAL_CHECK_MAIN(XLALTraceWriteSummary(stdout, "xml") == XLAL_FAILURE && xlalErrno == XLAL_EINVAL, XLAL_EFAILED);
+  XLALClearErrno();
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
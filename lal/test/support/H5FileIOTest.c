@@ -291,6 +291,134 @@ DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX8FrequencySeries)
 DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX16FrequencySeries)
 #undef GENERATE_DATA
 
+/* CHUNKED DATASET ROUTINES */
+
+static void test_chunked_slab(void)
+{
+	REAL8 orig[DIM0 * DIM1][DIM2];
+	REAL8 slab[DIM0][DIM2 - 1];
+	UINT4Vector *dims;
+	UINT4Vector *offset;
+	UINT4Vector *length;
+	LALH5File *file;
+	LALH5Dataset *dset;
+	size_t i, j;
+
+	fprintf(stderr, "Testing Append/Slab Read of chunked dataset...");
+
+	for (i = 0; i < DIM0 * DIM1; ++i)
+		for (j = 0; j < DIM2; ++j)
+			orig[i][j] = generate_float_data();
+
+	/* write the rows in DIM1 appends of DIM0 rows each */
+	dims = XLALCreateUINT4Vector(2);
+	dims->data[0] = 0;
+	dims->data[1] = DIM2;
+	file = XLALH5FileOpen(FNAME, "w");
+	dset = XLALH5DatasetAllocChunked(file, DSET, LAL_D_TYPE_CODE, dims, NULL, 6, 1);
+	for (i = 0; i < DIM1; ++i)
+		XLALH5DatasetAppend(dset, orig[i * DIM0], DIM0);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	/* read back a slab that straddles two appends */
+	offset = XLALCreateUINT4Vector(2);
+	length = XLALCreateUINT4Vector(2);
+	offset->data[0] = DIM0 - 1;
+	offset->data[1] = 1;
+	length->data[0] = DIM0;
+	length->data[1] = DIM2 - 1;
+	file = XLALH5FileOpen(FNAME, "r");
+	dset = XLALH5DatasetRead(file, DSET);
+	if (XLALH5DatasetQueryNPoints(dset) != NPTS) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	XLALH5DatasetQueryDataSlab(slab, dset, offset, length);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	for (i = 0; i < DIM0; ++i)
+		if (memcmp(slab[i], &orig[DIM0 - 1 + i][1], sizeof(slab[i]))) {
+			fprintf(stderr, " FAIL\n");
+			exit(1); /* fail */
+		}
+
+	XLALDestroyUINT4Vector(length);
+	XLALDestroyUINT4Vector(offset);
+	XLALDestroyUINT4Vector(dims);
+	fprintf(stderr, " PASS\n");
+}
+
+/* DATASET CACHE ROUTINES */
+
+static void test_cache(void)
+{
+	REAL8Vector *orig;
+	REAL8Vector *copy;
+	LALH5File *file;
+	size_t length;
+	size_t hits;
+	size_t misses;
+	int pass;
+	size_t i;
+
+	fprintf(stderr, "Testing Read of cached dataset...");
+
+	XLALH5CacheClear();
+	XLALH5CacheSetLimit(2 * NPTS * sizeof(REAL8));
+
+	/* the first read of each file misses the cache and the second hits it; */
+	/* the rewritten file is a different size, so its first read must miss */
+	hits = misses = 0;
+	for (pass = 0; pass < 2; ++pass) {
+		length = pass ? NPTS / 2 : NPTS;
+		orig = XLALCreateREAL8Vector(length);
+		for (i = 0; i < length; ++i)
+			orig->data[i] = generate_float_data();
+		file = XLALH5FileOpen(FNAME, "w");
+		XLALH5FileWriteREAL8Vector(file, DSET, orig);
+		XLALH5FileClose(file);
+		for (i = 0; i < 2; ++i) {
+			file = XLALH5FileOpen(FNAME, "r");
+			copy = XLALH5FileReadREAL8Vector(file, DSET);
+			XLALH5FileClose(file);
+			if (i == 0)
+				++misses;
+			else
+				++hits;
+			if (copy->length != length || memcmp(orig->data, copy->data, length * sizeof(*orig->data))) {
+				fprintf(stderr, " FAIL\n");
+				exit(1); /* fail */
+			}
+			if (XLALH5CacheQueryHits() != hits || XLALH5CacheQueryMisses() != misses) {
+				fprintf(stderr, " FAIL\n");
+				exit(1); /* fail */
+			}
+			XLALDestroyREAL8Vector(copy);
+		}
+		XLALDestroyREAL8Vector(orig);
+	}
+
+	/* datasets opened with the cache disabled are not read through it */
+	XLALH5CacheSetLimit(0);
+	file = XLALH5FileOpen(FNAME, "r");
+	copy = XLALH5FileReadREAL8Vector(file, DSET);
+	XLALH5FileClose(file);
+	XLALDestroyREAL8Vector(copy);
+	if (XLALH5CacheQueryHits() != hits || XLALH5CacheQueryMisses() != misses) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+
+	XLALH5CacheClear();
+	if (XLALH5CacheQueryHits() != 0 || XLALH5CacheQueryMisses() != 0) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	fprintf(stderr, " PASS\n");
+}
+
 int main(void)
 {
 	XLALSetErrorHandler(XLALAbortErrorHandler);
@@ -334,6 +462,9 @@ int main(void)
 	test_COMPLEX8FrequencySeries();
 	test_COMPLEX16FrequencySeries();
 
+	test_chunked_slab();
+	test_cache();
+
 	LALCheckMemoryLeaks();
 	return 0;
 }
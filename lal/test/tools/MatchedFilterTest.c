@@ -0,0 +1,140 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/MatchedFilter.h>
+
+#define N 1024
+/* templates occupy the lowest NBINS frequency bins, so the SNR time series is oversampled */
+#define NBINS (N / 4)
+#define NTMPLT 8
+#define WINDOW 8
+
+/* random template with a smooth amplitude; returns its squared norm */
+static REAL8 make_template(COMPLEX8Vector *h)
+{
+	REAL8 hh = 0;
+	UINT4 k;
+	for (k = 0; k < h->length; ++k) {
+		REAL8 amp = 1 / (1.0 + (REAL8) k / h->length);
+		REAL8 phase = LAL_TWOPI * rand() / (RAND_MAX + 1.0);
+		h->data[k] = crectf(amp * cos(phase), amp * sin(phase));
+		hh += amp * amp;
+	}
+	return hh;
+}
+
+/* data is the template delayed by t0 samples */
+static void make_data(COMPLEX8Vector *d, const COMPLEX8Vector *h, REAL8 t0)
+{
+	UINT4 k;
+	for (k = 0; k < d->length; ++k) {
+		REAL8 phase = -LAL_TWOPI * k * t0 / N;
+		d->data[k] = h->data[k] * crectf(cos(phase), sin(phase));
+	}
+}
+
+/* reference SNR time series by direct summation */
+static COMPLEX16 brute_force(const COMPLEX8Vector *d, const COMPLEX8Vector *h, UINT4 j)
+{
+	COMPLEX16 z = 0;
+	UINT4 k;
+	for (k = 0; k < d->length; ++k) {
+		REAL8 phase = LAL_TWOPI * (REAL8) ((UINT8) j * k % N) / N;
+		z += (COMPLEX16) d->data[k] * conj(h->data[k]) * cpolar(1.0, phase);
+	}
+	return z;
+}
+
+int main(void)
+{
+	COMPLEX8Vector *tmplt[NTMPLT];
+	REAL4 norm[NTMPLT];
+	REAL8 t0[NTMPLT];
+	MatchedFilterPeak peak[NTMPLT];
+	COMPLEX8Vector *data = XLALCreateCOMPLEX8Vector(NBINS);
+	COMPLEX8Vector *snr = XLALCreateCOMPLEX8Vector(N);
+	MatchedFilterWorkspace *ws = XLALCreateMatchedFilterWorkspace(N, WINDOW, 0);
+	MatchedFilterWorkspace *ws0 = XLALCreateMatchedFilterWorkspace(N, 0, 0);
+	UINT4 j, k;
+
+	if (!data || !snr || !ws || !ws0)
+		return 1;
+
+	srand(1234);
+	for (k = 0; k < NTMPLT; ++k) {
+		tmplt[k] = XLALCreateCOMPLEX8Vector(NBINS);
+		if (!tmplt[k])
+			return 1;
+		norm[k] = 1 / make_template(tmplt[k]);
+		/* one integer and several fractional delays, one of them wrapping around */
+		t0[k] = k == 0 ? 300 : k == NTMPLT - 1 ? N - 0.4 : 100 + 96.2 * k;
+	}
+
+	/* the SNR time series matches direct summation */
+	make_data(data, tmplt[1], t0[1]);
+	if (XLALMatchedFilterSNRCOMPLEX8(snr, data, tmplt[1], norm[1], ws) != XLAL_SUCCESS)
+		return 1;
+	for (j = 0; j < N; ++j)
+		if (cabs(snr->data[j] - norm[1] * brute_force(data, tmplt[1], j)) > 1e-4) {
+			fprintf(stderr, "MatchedFilterTest: FAIL (SNR time series at sample %u)\n", j);
+			return 1;
+		}
+
+	/* each template recovers its own delay from data containing it */
+	for (k = 0; k < NTMPLT; ++k) {
+		make_data(data, tmplt[k], t0[k]);
+		if (XLALMatchedFilterPeaksCOMPLEX8(peak, data, (const COMPLEX8Vector *const *) tmplt, norm, NTMPLT, 0, N, ws) != XLAL_SUCCESS)
+			return 1;
+		REAL8 dt = fmod(peak[k].index - t0[k] + 1.5 * N, N) - 0.5 * N;
+		if (fabs(dt) > 0.05 || fabs(cabsf(peak[k].snr) - 1) > 0.02) {
+			fprintf(stderr, "MatchedFilterTest: FAIL (template %u: index %g, expected %g, |snr| %g)\n", k, peak[k].index, t0[k], cabsf(peak[k].snr));
+			return 1;
+		}
+		/* other templates are uncorrelated with the data */
+		for (j = 0; j < NTMPLT; ++j)
+			if (j != k && cabsf(peak[j].snr) > 0.5) {
+				fprintf(stderr, "MatchedFilterTest: FAIL (template %u matches data for template %u)\n", j, k);
+				return 1;
+			}
+
+		/* without interpolation, the peak is the loudest sample */
+		if (XLALMatchedFilterPeaksCOMPLEX8(peak, data, (const COMPLEX8Vector *const *) tmplt, norm, NTMPLT, 0, N, ws0) != XLAL_SUCCESS)
+			return 1;
+		if (peak[k].index != fmod(floor(t0[k] + 0.5), N)) {
+			fprintf(stderr, "MatchedFilterTest: FAIL (template %u: loudest sample %g, expected %g)\n", k, peak[k].index, t0[k]);
+			return 1;
+		}
+	}
+
+	for (k = 0; k < NTMPLT; ++k)
+		XLALDestroyCOMPLEX8Vector(tmplt[k]);
+	XLALDestroyCOMPLEX8Vector(data);
+	XLALDestroyCOMPLEX8Vector(snr);
+	XLALDestroyMatchedFilterWorkspace(ws);
+	XLALDestroyMatchedFilterWorkspace(ws0);
+
+	LALCheckMemoryLeaks();
+	fprintf(stderr, "MatchedFilterTest: PASS\n");
+	return 0;
+}
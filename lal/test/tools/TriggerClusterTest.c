@@ -0,0 +1,126 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/TriggerCluster.h>
+
+#define NTRIG 2000
+#define WINDOW 40
+#define FTOL 0.25
+
+/* triggers are linked only if their "frequencies" are close */
+static REAL8 freq[NTRIG];
+
+static int test_freq(const LALTriggerStore *store, size_t i, size_t j, void *params)
+{
+	const REAL8 *f = params;
+	REAL8 df = f[*(const size_t *) store->row[i]] - f[*(const size_t *) store->row[j]];
+	return df < FTOL && df > -FTOL;
+}
+
+/* reference clustering: connected components by brute force */
+static void brute_force(size_t *root, const INT8 *t, const size_t *id, int use_test)
+{
+	size_t i, j, k;
+	int changed = 1;
+	for (i = 0; i < NTRIG; ++i)
+		root[i] = i;
+	while (changed) {
+		changed = 0;
+		for (i = 0; i < NTRIG; ++i)
+			for (j = 0; j < NTRIG; ++j) {
+				INT8 dt = t[i] > t[j] ? t[i] - t[j] : t[j] - t[i];
+				REAL8 df = freq[id[i]] - freq[id[j]];
+				if (dt > WINDOW || root[i] == root[j])
+					continue;
+				if (use_test && !(df < FTOL && df > -FTOL))
+					continue;
+				size_t lo = root[i] < root[j] ? root[i] : root[j];
+				size_t hi = root[i] < root[j] ? root[j] : root[i];
+				for (k = 0; k < NTRIG; ++k)
+					if (root[k] == hi)
+						root[k] = lo;
+				changed = 1;
+			}
+	}
+}
+
+static int check(int use_test, size_t block)
+{
+	static size_t orig[NTRIG];
+	size_t id[NTRIG];
+	LALTriggerStore *store = XLALCreateTriggerStore(0);
+	size_t root[NTRIG];
+	size_t i, j;
+
+	srand(1234);
+	for (i = 0; i < NTRIG; ++i) {
+		orig[i] = i;
+		freq[i] = rand() / (RAND_MAX + 1.0);
+		/* unsorted times */
+		XLALTriggerStoreAppend(store, (rand() % (NTRIG * 20)), rand() / (RAND_MAX + 1.0), &orig[i]);
+	}
+	if (XLALTriggerStoreSort(store) != XLAL_SUCCESS)
+		return 1;
+	for (i = 0; i < NTRIG; ++i)
+		id[i] = *(size_t *) store->row[i];
+	if (XLALTriggerStoreCluster(store, WINDOW, use_test ? test_freq : NULL, freq, block) != XLAL_SUCCESS)
+		return 1;
+
+	brute_force(root, store->time, id, use_test);
+
+	for (i = 0; i < NTRIG; ++i) {
+		size_t loudest = store->cluster[i];
+		size_t n = 0;
+		/* same partition */
+		if (root[loudest] != root[i])
+			return 1;
+		for (j = 0; j < NTRIG; ++j) {
+			if (root[j] == root[i]) {
+				++n;
+				if (store->cluster[j] != loudest || store->rank[j] > store->rank[loudest])
+					return 1;
+			}
+		}
+		if (loudest == i && store->size_of[i] != n)
+			return 1;
+	}
+
+	XLALDestroyTriggerStore(store);
+	return 0;
+}
+
+int main(void)
+{
+	size_t blocks[] = {0, 1, 7, 500};
+	size_t b;
+	int use_test;
+
+	for (use_test = 0; use_test < 2; ++use_test)
+		for (b = 0; b < sizeof(blocks) / sizeof(*blocks); ++b)
+			if (check(use_test, blocks[b])) {
+				fprintf(stderr, "TriggerClusterTest: FAIL (test=%d, block=%zu)\n", use_test, blocks[b]);
+				return 1;
+			}
+
+	LALCheckMemoryLeaks();
+	fprintf(stderr, "TriggerClusterTest: PASS\n");
+	return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/*
+ * Test that an adaptive Runge-Kutta integrator reset with
+ * XLALAdaptiveRungeKuttaReset() for systems of different dimensions gives
+ * the same output as a freshly created integrator, through both
+ * XLALAdaptiveRungeKutta4Hermite() and XLALAdaptiveRungeKutta4HermiteReuse().
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_errno.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/LALAdaptiveRungeKuttaIntegrator.h>
+
+/* harmonic oscillator: y = (cos t, -sin t) */
+static int oscillator( double t, const double y[], double dydt[], void *params )
+{
+  (void) t; (void) params;
+  dydt[0] = y[1];
+  dydt[1] = -y[0];
+  return GSL_SUCCESS;
+}
+
+/* exponential decay at rates 1, 2, 3: y[i] = exp(-(i+1) t) */
+static int decay( double t, const double y[], double dydt[], void *params )
+{
+  (void) t; (void) params;
+  for ( int i = 0; i < 3; ++i ) {
+    dydt[i] = -( i + 1 ) * y[i];
+  }
+  return GSL_SUCCESS;
+}
+
+/* stop the decay once the slowest component falls below a threshold */
+static int decay_stop( double t, const double y[], double dydt[], void *params )
+{
+  (void) t; (void) dydt;
+  return y[0] < *( const double * ) params ? 1 : GSL_SUCCESS;
+}
+
+/* exponential growth: y = exp(t) */
+static int growth( double t, const double y[], double dydt[], void *params )
+{
+  (void) t; (void) params;
+  dydt[0] = y[0];
+  return GSL_SUCCESS;
+}
+
+typedef struct {
+  int dim;
+  int ( *dydt )( double t, const double y[], double dydt[], void *params );
+  int ( *stop )( double t, const double y[], double dydt[], void *params );
+  double eps_abs, eps_rel;
+  double yinit[3];
+  double tinit, tend, deltat;
+  double ( *exact )( int i, double t );
+} Problem;
+
+static double oscillator_exact( int i, double t ) { return i == 0 ? cos( t ) : -sin( t ); }
+static double decay_exact( int i, double t ) { return exp( -( i + 1 ) * t ); }
+static double growth_exact( int i, double t ) { (void) i; return exp( t ); }
+
+static const Problem problems[] = {
+  { 2, oscillator, NULL, 1e-10, 1e-10, { 1, 0, 0 }, 0, 10, 0.1, oscillator_exact },
+  { 3, decay, decay_stop, 1e-10, 1e-10, { 1, 1, 1 }, 0, 10, 0.05, decay_exact },
+  { 1, growth, NULL, 1e-12, 1e-12, { 1, 0, 0 }, 0, 2, 0.01, growth_exact },
+  { 2, oscillator, NULL, 1e-8, 1e-8, { 1, 0, 0 }, 0, 20, 0.2, oscillator_exact },
+  { 3, decay, decay_stop, 1e-9, 1e-9, { 1, 1, 1 }, 0, 10, 0.02, decay_exact },
+};
+
+/* integrate problem p with integrator, returning a copy of the output */
+static REAL8Array *integrate( LALAdaptiveRungeKuttaIntegrator *integrator, const Problem *p, int reuse, int *count )
+{
+  double y[3], threshold = 0.1;
+  REAL8Array *yout = NULL;
+  memcpy( y, p->yinit, sizeof( y ) );
+  if ( reuse ) {
+    XLAL_CHECK_NULL( ( *count = XLALAdaptiveRungeKutta4HermiteReuse( integrator, &threshold, y, p->tinit, p->tend, p->deltat, &yout ) ) > 0, XLAL_EFUNC );
+    /* the output belongs to the integrator, so copy it */
+    REAL8Array *copy = XLALCreateREAL8ArrayL( 2, yout->dimLength->data[0], yout->dimLength->data[1] );
+    XLAL_CHECK_NULL( copy != NULL, XLAL_EFUNC );
+    memcpy( copy->data, yout->data, ( p->dim + 1 ) * ( *count ) * sizeof( REAL8 ) );
+    return copy;
+  }
+  XLAL_CHECK_NULL( ( *count = XLALAdaptiveRungeKutta4Hermite( integrator, &threshold, y, p->tinit, p->tend, p->deltat, &yout ) ) > 0, XLAL_EFUNC );
+  return yout;
+}
+
+int main( void )
+{
+
+  const size_t nproblems = sizeof( problems ) / sizeof( problems[0] );
+
+  /* one integrator, reset for each problem */
+  LALAdaptiveRungeKuttaIntegrator *reused = XLALAdaptiveRungeKutta4Init( problems[0].dim, problems[0].dydt, problems[0].stop, problems[0].eps_abs, problems[0].eps_rel );
+  XLAL_CHECK_MAIN( reused != NULL, XLAL_EFUNC );
+
+  for ( size_t k = 0; k < nproblems; ++k ) {
+    const Problem *p = &problems[k];
+
+    /* reference output from a fresh integrator */
+    LALAdaptiveRungeKuttaIntegrator *fresh = XLALAdaptiveRungeKutta4Init( p->dim, p->dydt, p->stop, p->eps_abs, p->eps_rel );
+    XLAL_CHECK_MAIN( fresh != NULL, XLAL_EFUNC );
+    int count_fresh = 0;
+    REAL8Array *ref = integrate( fresh, p, 0, &count_fresh );
+    XLAL_CHECK_MAIN( ref != NULL, XLAL_EFUNC );
+    const int returncode = fresh->returncode;
+    XLALAdaptiveRungeKuttaFree( fresh );
+
+    /* the reference output is close to the exact solution */
+    for ( int j = 0; j < count_fresh; ++j ) {
+      const double t = ref->data[j];
+      for ( int i = 0; i < p->dim; ++i ) {
+        const double y = ref->data[( i + 1 ) * count_fresh + j];
+        XLAL_CHECK_MAIN( fabs( y - p->exact( i, t ) ) < 1e-3, XLAL_ETOL, "problem %zu: y[%d](%g) = %.10g, expected %.10g", k, i, t, y, p->exact( i, t ) );
+      }
+    }
+
+    /* the reset integrator gives identical output through both entry points */
+    for ( int reuse = 0; reuse <= 1; ++reuse ) {
+      XLAL_CHECK_MAIN( XLALAdaptiveRungeKuttaReset( reused, p->dim, p->dydt, p->stop, p->eps_abs, p->eps_rel ) == XLAL_SUCCESS, XLAL_EFUNC );
+      int count = 0;
+      REAL8Array *out = integrate( reused, p, reuse, &count );
+      XLAL_CHECK_MAIN( out != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( count == count_fresh, XLAL_EFAILED, "problem %zu, reuse=%d: %d samples, expected %d", k, reuse, count, count_fresh );
+      XLAL_CHECK_MAIN( out->dimLength->data[0] == ref->dimLength->data[0] && out->dimLength->data[1] == ref->dimLength->data[1], XLAL_EFAILED, "problem %zu, reuse=%d: output dimensions differ", k, reuse );
+      XLAL_CHECK_MAIN( memcmp( out->data, ref->data, ( p->dim + 1 ) * count * sizeof( REAL8 ) ) == 0, XLAL_EFAILED, "problem %zu, reuse=%d: output differs from a fresh integrator", k, reuse );
+      XLAL_CHECK_MAIN( reused->returncode == returncode, XLAL_EFAILED, "problem %zu, reuse=%d: return code %d, expected %d", k, reuse, reused->returncode, returncode );
+      XLALDestroyREAL8Array( out );
+    }
+
+    XLALDestroyREAL8Array( ref );
+  }
+
+  /* invalid arguments leave the integrator usable */
+  XLAL_CHECK_MAIN( XLALAdaptiveRungeKuttaReset( reused, 0, oscillator, NULL, 1e-10, 1e-10 ) == XLAL_FAILURE && xlalErrno == XLAL_EINVAL, XLAL_EFAILED );
+  XLALClearErrno();
+  {
+    int count = 0;
+    XLAL_CHECK_MAIN( XLALAdaptiveRungeKuttaReset( reused, problems[0].dim, problems[0].dydt, problems[0].stop, problems[0].eps_abs, problems[0].eps_rel ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL8Array *out = integrate( reused, &problems[0], 1, &count );
+    XLAL_CHECK_MAIN( out != NULL, XLAL_EFUNC );
+    XLALDestroyREAL8Array( out );
+  }
+
+  XLALAdaptiveRungeKuttaFree( reused );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
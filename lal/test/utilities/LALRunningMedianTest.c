@@ -110,9 +110,9 @@ int compare_double( double x, double y );
 int compare_single( float x, float y );
 static int rngmed_sortindex(const void *elem1, const void *elem2);
 int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
+		       LALRunningMedianPar param, BOOLEAN verbose, INT4 impl);
 int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
+		       LALRunningMedianPar param, BOOLEAN verbose, INT4 impl);
 
 
 struct rngmed_val_index {
@@ -187,7 +187,7 @@ static int rngmed_sortindex(const void *elem1, const void *elem2){
 
 
 int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl) {
+		       LALRunningMedianPar param, BOOLEAN verbose, INT4 impl) {
 /* Test the LALDRunningMedian (REAL8Sequence) function by
    comparing the reults to individually calculated medians */
 
@@ -204,7 +204,12 @@ int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
   }
 
   /* call running median */
-  if (bmimpl)
+  if (impl == 2) {
+    if ( XLALDRunningMedian( medians, input, param.blocksize ) != XLAL_SUCCESS ) {
+      printf("ERROR: XLALDRunningMedian failed with xlalErrno %d\n",xlalErrno);
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+  } else if (impl == 1)
     LALDRunningMedian2( stat, medians, input, param );
   else
     LALDRunningMedian( stat, medians, input, param );
@@ -267,7 +272,7 @@ int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
 
 
 int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
-		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl) {
+		       LALRunningMedianPar param, BOOLEAN verbose, INT4 impl) {
 /* Test the LALSRunningMedian (REAL4Sequence) function by
    comparing the reults to individually calculated medians */
 
@@ -284,7 +289,12 @@ int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
   }
 
   /* call running median */
-  if (bmimpl)
+  if (impl == 2) {
+    if ( XLALSRunningMedian( medians, input, param.blocksize ) != XLAL_SUCCESS ) {
+      printf("ERROR: XLALSRunningMedian failed with xlalErrno %d\n",xlalErrno);
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+  } else if (impl == 1)
     LALSRunningMedian2( stat, medians, input, param );
   else
     LALSRunningMedian( stat, medians, input, param );
@@ -680,6 +690,46 @@ int main( int argc, char **argv )
     printf("  PASS: LALSRunningMedian2(%d,%d)\n",length,param.blocksize);
   }
 
+  /* test the XLAL double-heap implementation for odd, even and small blocksizes */
+  {
+    UINT4 xlalBlocksizes[] = { param.blocksize, param.blocksize + 1, 3, 2, 1 };
+    for ( UINT4 n = 0; n < sizeof(xlalBlocksizes)/sizeof(xlalBlocksizes[0]); n++ ) {
+      param.blocksize = xlalBlocksizes[n];
+
+      if(testDRunningMedian(&stat,input8,length,param,verbose,2)) {
+        EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+      } else {
+        printf("  PASS: XLALDRunningMedian(%d,%d)\n",length,param.blocksize);
+      }
+
+      if(testSRunningMedian(&stat,input4,length,param,verbose,2)) {
+        EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+      } else {
+        printf("  PASS: XLALSRunningMedian(%d,%d)\n",length,param.blocksize);
+      }
+    }
+  }
+
+  /* test that the XLAL implementation rejects invalid input */
+  {
+    REAL8Sequence *xlalMedians8 = XLALCreateREAL8Vector( length - blocksize + 2 );
+    int errnum;
+    XLAL_TRY( XLALDRunningMedian( xlalMedians8, input8, 0 ), errnum );
+    if ( errnum == 0 ) {
+      EXIT( LALRUNNINGMEDIANTESTC_EERR, argv0, LALRUNNINGMEDIANTESTC_MSGEERR );
+    }
+    XLAL_TRY( XLALDRunningMedian( xlalMedians8, input8, length + 1 ), errnum );
+    if ( errnum == 0 ) {
+      EXIT( LALRUNNINGMEDIANTESTC_EERR, argv0, LALRUNNINGMEDIANTESTC_MSGEERR );
+    }
+    XLAL_TRY( XLALDRunningMedian( xlalMedians8, input8, blocksize ), errnum );
+    if ( errnum == 0 ) {
+      EXIT( LALRUNNINGMEDIANTESTC_EERR, argv0, LALRUNNINGMEDIANTESTC_MSGEERR );
+    }
+    printf("  PASS: XLALDRunningMedian with invalid input results in error\n");
+    XLALDestroyREAL8Vector( xlalMedians8 );
+  }
+
 
   /* free dummy input memory */
   LALDDestroyVector(&stat,&input8);
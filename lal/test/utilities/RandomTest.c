@@ -19,6 +19,7 @@
 #include <config.h>
 
 #include <stdio.h>
+#include <math.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -173,6 +174,93 @@ main (int argc, char *argv[])
   }
 
 
+  /*
+   *
+   * Check counter-based generator against the Philox4x32-10 known-answer
+   * vectors, and that blocks of deviates do not depend on how a stream is
+   * split into vectors.
+   *
+   */
+
+
+  {
+    const UINT4 ctr[3][4] = { { 0, 0, 0, 0 }, { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } };
+    const UINT4 key[3][2] = { { 0, 0 }, { 0xffffffff, 0xffffffff }, { 0xa4093822, 0x299f31d0 } };
+    const UINT4 kat[3][4] = { { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }, { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }, { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+    REAL8Vector *whole;
+    REAL8Vector *part;
+    REAL8 mean = 0;
+    REAL8 var = 0;
+    UINT4 k;
+
+    if (verbose)
+    {
+      printf ("\n===== Test Counter-Based Routines =====\n");
+    }
+
+    for (k = 0; k < 3; ++k)
+    {
+      UINT4 out[4];
+      XLALPhilox4x32 (out, ctr[k], key[k]);
+      if (memcmp (out, kat[k], sizeof(out)))
+        exit (1);
+    }
+
+    whole = XLALCreateREAL8Vector (10 * numPoints);
+    part  = XLALCreateREAL8Vector (37);
+    if (!whole || !part)
+      exit (1);
+
+    if (XLALPhiloxNormalDeviates (whole, 42, 3, 5))
+      exit (1);
+    for (i = 0; i < whole->length; ++i)
+    {
+      mean += whole->data[i];
+      var  += whole->data[i] * whole->data[i];
+    }
+    mean /= whole->length;
+    var  /= whole->length;
+    if (verbose)
+    {
+      printf ("mean = %g, variance = %g\n", mean, var);
+    }
+    if (fabs (mean) > 0.05 || fabs (var - 1) > 0.05)
+      exit (1);
+
+    /* both even and odd offsets and lengths */
+    for (k = 5; k + 37 <= 5 + whole->length; k += 36 + (k % 2))
+    {
+      part->length = 36 + (k % 2);
+      if (XLALPhiloxNormalDeviates (part, 42, 3, k))
+        exit (1);
+      if (memcmp (part->data, whole->data + k - 5, part->length * sizeof(*part->data)))
+        exit (1);
+    }
+
+    /* single precision deviates are rounded double precision deviates */
+    if (XLALPhiloxNormalDeviatesREAL4 (vector, 42, 3, 5))
+      exit (1);
+    for (i = 0; i < vector->length; ++i)
+    {
+      if (vector->data[i] != (REAL4) whole->data[i])
+        exit (1);
+    }
+
+    /* uniform deviates lie in (0,1) */
+    part->length = 37;
+    if (XLALPhiloxUniformDeviates (part, 42, 3, 0))
+      exit (1);
+    for (i = 0; i < part->length; ++i)
+    {
+      if (!(part->data[i] > 0 && part->data[i] < 1))
+        exit (1);
+    }
+
+    XLALDestroyREAL8Vector (part);
+    XLALDestroyREAL8Vector (whole);
+  }
+
+
   /*
    *
    * Check to make sure that correct error codes are generated.
@@ -378,6 +378,7 @@ main ( int argc, char *argv[] )
   TESTBENCH_VECTORMATH_DD2D(Scale,xInD[0],xIn2D);
 
   TESTBENCH_VECTORMATH_CC2C(Multiply,xInC,xIn2C);
+  TESTBENCH_VECTORMATH_CC2C(MultiplyConj,xInC,xIn2C);
   TESTBENCH_VECTORMATH_CC2C(Add,xInC,xIn2C);
 
   TESTBENCH_VECTORMATH_CC2C(Scale,xInC[0],xIn2C);
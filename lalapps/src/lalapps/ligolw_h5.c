@@ -0,0 +1,221 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/*
+ * Convert the sngl_inspiral, sngl_burst, sim_inspiral and sim_burst tables
+ * of a file between LIGO Light Weight XML and HDF5 (see LIGOMetadataH5.h).
+ * The direction of the conversion is chosen from the extension of the
+ * output file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALgetopt.h>
+#include <lal/H5FileIO.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOLwXMLBurstRead.h>
+#include <lal/LIGOLwXMLInspiralRead.h>
+#include <lal/LIGOMetadataH5.h>
+#include <lal/LIGOMetadataInspiralUtils.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/SnglBurstUtils.h>
+#include <LALAppsVCSInfo.h>
+
+#include "config.h"
+
+#define USAGE \
+"Usage: lalapps_ligolw_h5 [options]\n"\
+"\n"\
+"  --help                 display this message\n"\
+"  --version              output version information and exit\n"\
+"  --input FILE           read tables from FILE\n"\
+"  --output FILE          write tables to FILE; if FILE ends in .h5 or .hdf5\n"\
+"                         the input is LIGO Light Weight XML and the output\n"\
+"                         is HDF5, otherwise the other way round\n"\
+"\n"\
+"Converts the sngl_inspiral, sngl_burst, sim_inspiral and sim_burst tables.\n"
+
+static int is_h5(const char *path)
+{
+  const char *ext = strrchr(path, '.');
+  return ext && (!strcmp(ext, ".h5") || !strcmp(ext, ".hdf5"));
+}
+
+static void free_sim_inspiral(SimInspiralTable *head)
+{
+  while (head) {
+    SimInspiralTable *next = head->next;
+    LALFree(head);
+    head = next;
+  }
+}
+
+static void free_sngl_inspiral(SnglInspiralTable *head)
+{
+  while (head) {
+    SnglInspiralTable *next = head->next;
+    XLALFreeSnglInspiral(&head);
+    head = next;
+  }
+}
+
+static int xml_to_h5(const char *input, const char *output)
+{
+  LALH5File *file = NULL;
+  SnglInspiralTable *sngl_inspiral = NULL;
+  SnglBurst *sngl_burst = NULL;
+  SimInspiralTable *sim_inspiral = NULL;
+  SimBurst *sim_burst = NULL;
+  int status = 1;
+
+  file = XLALH5FileOpen(output, "w");
+  if (!file)
+    goto done;
+
+  if (XLALLIGOLwHasTable(input, "sngl_inspiral") > 0) {
+    if (LALSnglInspiralTableFromLIGOLw(&sngl_inspiral, input, 0, -1) < 0
+        || XLALWriteH5SnglInspiralTable(file, sngl_inspiral) < 0)
+      goto done;
+  }
+  if (XLALLIGOLwHasTable(input, "sngl_burst") > 0) {
+    sngl_burst = XLALSnglBurstTableFromLIGOLw(input);
+    if ((!sngl_burst && xlalErrno) || XLALWriteH5SnglBurstTable(file, sngl_burst) < 0)
+      goto done;
+  }
+  if (XLALLIGOLwHasTable(input, "sim_inspiral") > 0) {
+    if (SimInspiralTableFromLIGOLw(&sim_inspiral, input, 0, 0) < 0
+        || XLALWriteH5SimInspiralTable(file, sim_inspiral) < 0)
+      goto done;
+  }
+  if (XLALLIGOLwHasTable(input, "sim_burst") > 0) {
+    sim_burst = XLALSimBurstTableFromLIGOLw(input, NULL, NULL);
+    if ((!sim_burst && xlalErrno) || XLALWriteH5SimBurstTable(file, sim_burst) < 0)
+      goto done;
+  }
+  status = 0;
+
+done:
+  free_sngl_inspiral(sngl_inspiral);
+  XLALDestroySnglBurstTable(sngl_burst);
+  free_sim_inspiral(sim_inspiral);
+  XLALDestroySimBurstTable(sim_burst);
+  if (file)
+    XLALH5FileClose(file);
+  return status;
+}
+
+static int h5_to_xml(const char *input, const char *output)
+{
+  LALH5File *file = NULL;
+  LIGOLwXMLStream *xml = NULL;
+  SnglInspiralTable *sngl_inspiral = NULL;
+  SnglBurst *sngl_burst = NULL;
+  SimInspiralTable *sim_inspiral = NULL;
+  SimBurst *sim_burst = NULL;
+  int status = 1;
+
+  file = XLALH5FileOpen(input, "r");
+  if (!file)
+    goto done;
+  xml = XLALOpenLIGOLwXMLFile(output);
+  if (!xml)
+    goto done;
+
+  if (XLALH5FileCheckDatasetExists(file, "sngl_inspiral")) {
+    sngl_inspiral = XLALSnglInspiralTableFromH5(file);
+    if ((!sngl_inspiral && xlalErrno) || XLALWriteLIGOLwXMLSnglInspiralTable(xml, sngl_inspiral) < 0)
+      goto done;
+  }
+  if (XLALH5FileCheckDatasetExists(file, "sngl_burst")) {
+    sngl_burst = XLALSnglBurstTableFromH5(file);
+    if ((!sngl_burst && xlalErrno) || XLALWriteLIGOLwXMLSnglBurstTable(xml, sngl_burst) < 0)
+      goto done;
+  }
+  if (XLALH5FileCheckDatasetExists(file, "sim_inspiral")) {
+    sim_inspiral = XLALSimInspiralTableFromH5(file);
+    if ((!sim_inspiral && xlalErrno) || XLALWriteLIGOLwXMLSimInspiralTable(xml, sim_inspiral) < 0)
+      goto done;
+  }
+  if (XLALH5FileCheckDatasetExists(file, "sim_burst")) {
+    sim_burst = XLALSimBurstTableFromH5(file);
+    if ((!sim_burst && xlalErrno) || XLALWriteLIGOLwXMLSimBurstTable(xml, sim_burst) < 0)
+      goto done;
+  }
+  status = 0;
+
+done:
+  free_sngl_inspiral(sngl_inspiral);
+  XLALDestroySnglBurstTable(sngl_burst);
+  free_sim_inspiral(sim_inspiral);
+  XLALDestroySimBurstTable(sim_burst);
+  if (xml && XLALCloseLIGOLwXMLFile(xml) < 0)
+    status = 1;
+  if (file)
+    XLALH5FileClose(file);
+  return status;
+}
+
+int main(int argc, char *argv[])
+{
+  const char *input = NULL;
+  const char *output = NULL;
+  struct LALoption long_options[] = {
+    {"help", no_argument, 0, 'h'},
+    {"version", no_argument, 0, 'V'},
+    {"input", required_argument, 0, 'i'},
+    {"output", required_argument, 0, 'o'},
+    {0, 0, 0, 0}
+  };
+  int c;
+
+  while ((c = LALgetopt_long_only(argc, argv, "hVi:o:", long_options, NULL)) != -1) {
+    switch (c) {
+    case 'h':
+      fprintf(stdout, USAGE);
+      exit(0);
+    case 'V':
+      XLALOutputVCSInfo(stderr, lalAppsVCSInfoList, 0, "%% ");
+      exit(0);
+    case 'i':
+      input = LALoptarg;
+      break;
+    case 'o':
+      output = LALoptarg;
+      break;
+    default:
+      fprintf(stderr, USAGE);
+      exit(1);
+    }
+  }
+
+  if (!input || !output) {
+    fprintf(stderr, "--input and --output must be specified\n" USAGE);
+    exit(1);
+  }
+
+  if (is_h5(output) ? xml_to_h5(input, output) : h5_to_xml(input, output)) {
+    fprintf(stderr, "error converting %s to %s\n", input, output);
+    exit(1);
+  }
+
+  LALCheckMemoryLeaks();
+  return 0;
+}
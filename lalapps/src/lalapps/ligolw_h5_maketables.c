@@ -0,0 +1,317 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/*
+ * Test helper for ligolw_h5_test.sh.  Writes
+ *
+ *   ligolw_h5_tables.xml   sngl_inspiral, sngl_burst, sim_inspiral and
+ *                          sim_burst tables of NROWS rows each
+ *   ligolw_h5_partial.h5   a sngl_burst table with only some of its columns
+ *   ligolw_h5_partial.xml  the LIGO Light Weight XML that should be made
+ *                          from ligolw_h5_partial.h5
+ *
+ * NROWS is more than the number of rows converted in one block.  String
+ * columns take a few distinct values, including the empty string.  The
+ * numeric values have short decimal forms, which LIGO Light Weight XML
+ * prints exactly, so converting ligolw_h5_tables.xml to HDF5 and back must
+ * give the same file.  Columns that the XML readers ignore are left at the
+ * values the readers give them.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConfig.h>
+#include <lal/Date.h>
+#include <lal/H5FileIO.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/SnglBurstUtils.h>
+
+#define NROWS 5000
+
+static const char *ifos[] = {"H1", "L1", "V1", ""};
+static const char *channels[] = {"GDS-CALIB_STRAIN", "LSC-STRAIN", ""};
+static const char *inspiral_waveforms[] = {"TaylorF2threePointFivePN", "SpinTaylorT4threePointFivePN", "IMRPhenomPv2pseudoFourPN"};
+
+#define PICK(list, i) ((list)[(i) % XLAL_NUM_ELEM(list)])
+
+static SnglInspiralTable *make_sngl_inspiral(int n)
+{
+  SnglInspiralTable *head = NULL, **next = &head;
+  for (int i = 0; i < n; i++) {
+    SnglInspiralTable *row = LALCalloc(1, sizeof(*row));
+    if (!row)
+      return NULL;
+    snprintf(row->ifo, sizeof(row->ifo), "%s", PICK(ifos, i));
+    snprintf(row->search, sizeof(row->search), "%s", i % 2 ? "FindChirpSPtwoPN" : "");
+    snprintf(row->channel, sizeof(row->channel), "%s", PICK(channels, i));
+    XLALGPSSet(&row->end, 1000000000 + i, (i * 7919) % 1000000000);
+    row->template_duration = (i % 512) * 0.125;
+    row->eff_distance = (i % 1000) * 0.5;
+    row->mass1 = 1 + (i % 97) * 0.25;
+    row->mass2 = 1 + (i % 89) * 0.25;
+    row->snr = 4 + (i % 301) * 0.0625;
+    row->chisq = (i % 123) * 0.5;
+    row->chisq_dof = 2 * (i % 16);
+    row->sigmasq = (i % 4099) * 1024.0;
+    row->Gamma[3] = -(i % 17) * 0.25;
+    row->spin1z = ((i % 9) - 4) * 0.125;
+    row->event_id = i;
+    *next = row;
+    next = &row->next;
+  }
+  return head;
+}
+
+static SnglBurst *make_sngl_burst(int n)
+{
+  SnglBurst *head = NULL, **next = &head;
+  for (int i = 0; i < n; i++) {
+    SnglBurst *row = XLALCreateSnglBurst();
+    if (!row)
+      return NULL;
+    row->process_id = i % 3;
+    snprintf(row->ifo, sizeof(row->ifo), "%s", PICK(ifos, i));
+    snprintf(row->search, sizeof(row->search), "%s", i % 5 ? "excesspower" : "StringCusp");
+    snprintf(row->channel, sizeof(row->channel), "%s", PICK(channels, i + 1));
+    XLALGPSSet(&row->start_time, 1000000000 + i, 0);
+    XLALGPSSet(&row->peak_time, 1000000000 + i, (i * 104729) % 1000000000);
+    row->duration = (i % 64) * 0.015625;
+    row->central_freq = 32 + (i % 1000) * 0.5;
+    row->bandwidth = (i % 100) * 0.25;
+    row->amplitude = (i % 77) * 0.125;
+    row->snr = (i % 211) * 0.25;
+    row->confidence = (i % 53) * 0.5;
+    row->chisq = (i % 4001) * 0.25;
+    row->chisq_dof = 2 * (i % 31);
+    row->event_id = i;
+    *next = row;
+    next = &row->next;
+  }
+  return head;
+}
+
+static SimInspiralTable *make_sim_inspiral(int n)
+{
+  SimInspiralTable *head = NULL, **next = &head;
+  for (int i = 0; i < n; i++) {
+    SimInspiralTable *row = LALCalloc(1, sizeof(*row));
+    if (!row)
+      return NULL;
+    row->process_id = i % 2;
+    snprintf(row->waveform, sizeof(row->waveform), "%s", PICK(inspiral_waveforms, i));
+    XLALGPSSet(&row->geocent_end_time, 1000000000 + 10 * i, (i * 15485863) % 1000000000);
+    XLALGPSSet(&row->h_end_time, 1000000000 + 10 * i, 0);
+    snprintf(row->source, sizeof(row->source), "%s", i % 7 ? "" : "M31");
+    row->mass1 = 1 + (i % 41) * 0.5;
+    row->mass2 = 1 + (i % 43) * 0.5;
+    row->distance = 1 + (i % 1000) * 0.25;
+    row->longitude = (i % 25) * 0.25;
+    row->latitude = ((i % 13) - 6) * 0.25;
+    row->inclination = (i % 12) * 0.25;
+    row->spin2x = ((i % 5) - 2) * 0.125;
+    row->f_lower = 10 + (i % 3) * 5;
+    row->eff_dist_h = (i % 333) * 0.5;
+    row->numrel_mode_min = i % 3;
+    row->numrel_mode_max = 2 + i % 3;
+    snprintf(row->numrel_data, sizeof(row->numrel_data), "%s", i % 11 ? "" : "nr_data.h5");
+    row->amp_order = i % 6;
+    snprintf(row->taper, sizeof(row->taper), "%s", i % 2 ? "TAPER_START" : "TAPER_NONE");
+    row->bandpass = i % 2;
+    row->simulation_id = i;
+    *next = row;
+    next = &row->next;
+  }
+  return head;
+}
+
+static SimBurst *make_sim_burst(int n)
+{
+  SimBurst *head = NULL, **next = &head;
+  for (int i = 0; i < n; i++) {
+    SimBurst *row = XLALCreateSimBurst();
+    if (!row)
+      return NULL;
+    row->process_id = 0;
+    row->ra = (i % 25) * 0.25;
+    row->dec = ((i % 13) - 6) * 0.25;
+    row->psi = (i % 12) * 0.25;
+    XLALGPSSet(&row->time_geocent_gps, 1000000000 + 10 * i, (i * 7) % 1000000000);
+    row->time_geocent_gmst = (i % 24) * 0.25;
+    /* the XML reader only reads the columns used by each waveform */
+    switch (i % 3) {
+    case 0:
+      snprintf(row->waveform, sizeof(row->waveform), "SineGaussian");
+      row->duration = (i % 64) * 0.015625;
+      row->frequency = 32 + (i % 1000) * 0.5;
+      row->bandwidth = (i % 100) * 0.25;
+      row->q = 3 + (i % 30);
+      row->pol_ellipse_angle = (i % 8) * 0.125;
+      row->pol_ellipse_e = (i % 4) * 0.25;
+      row->hrss = (1 + i % 100) / 1e22;
+      break;
+    case 1:
+      snprintf(row->waveform, sizeof(row->waveform), "BTLWNB");
+      row->duration = (i % 64) * 0.015625;
+      row->frequency = 32 + (i % 1000) * 0.5;
+      row->bandwidth = (i % 100) * 0.25;
+      row->pol_ellipse_angle = (i % 8) * 0.125;
+      row->pol_ellipse_e = (i % 4) * 0.25;
+      row->egw_over_rsquared = (1 + i % 100) / 1e10;
+      row->waveform_number = 4000000000UL + (unsigned long) i;
+      break;
+    default:
+      snprintf(row->waveform, sizeof(row->waveform), "Impulse");
+      row->amplitude = (1 + i % 100) / 1e20;
+      break;
+    }
+    row->time_slide_id = i % 4;
+    row->simulation_id = i;
+    *next = row;
+    next = &row->next;
+  }
+  return head;
+}
+
+static int write_tables(const char *path)
+{
+  SnglInspiralTable *sngl_inspiral = make_sngl_inspiral(NROWS);
+  SnglBurst *sngl_burst = make_sngl_burst(NROWS);
+  SimInspiralTable *sim_inspiral = make_sim_inspiral(NROWS);
+  SimBurst *sim_burst = make_sim_burst(NROWS);
+  LIGOLwXMLStream *xml = NULL;
+  int status = 1;
+
+  if (!sngl_inspiral || !sngl_burst || !sim_inspiral || !sim_burst)
+    goto done;
+  xml = XLALOpenLIGOLwXMLFile(path);
+  if (!xml)
+    goto done;
+  if (XLALWriteLIGOLwXMLSnglInspiralTable(xml, sngl_inspiral) < 0
+      || XLALWriteLIGOLwXMLSnglBurstTable(xml, sngl_burst) < 0
+      || XLALWriteLIGOLwXMLSimInspiralTable(xml, sim_inspiral) < 0
+      || XLALWriteLIGOLwXMLSimBurstTable(xml, sim_burst) < 0)
+    goto done;
+  status = 0;
+
+done:
+  if (xml && XLALCloseLIGOLwXMLFile(xml) < 0)
+    status = 1;
+  while (sngl_inspiral) {
+    SnglInspiralTable *next = sngl_inspiral->next;
+    LALFree(sngl_inspiral);
+    sngl_inspiral = next;
+  }
+  XLALDestroySnglBurstTable(sngl_burst);
+  while (sim_inspiral) {
+    SimInspiralTable *next = sim_inspiral->next;
+    LALFree(sim_inspiral);
+    sim_inspiral = next;
+  }
+  XLALDestroySimBurstTable(sim_burst);
+  return status;
+}
+
+/* a sngl_burst table with only the ifo, peak_time, peak_time_ns, snr and
+ * event_id columns, written directly with the H5FileIO table routines;
+ * the missing columns must be read as zero */
+struct partial_row {
+  INT4 ifo;
+  INT4 peak_time;
+  INT4 peak_time_ns;
+  REAL4 snr;
+  INT8 event_id;
+};
+
+static int write_partial(const char *h5path, const char *xmlpath)
+{
+  const char *cols[] = {"event_id", "ifo", "peak_time", "peak_time_ns", "snr"};
+  const LALTYPECODE types[] = {LAL_I8_TYPE_CODE, LAL_I4_TYPE_CODE, LAL_I4_TYPE_CODE, LAL_I4_TYPE_CODE, LAL_S_TYPE_CODE};
+  const size_t offsets[] = {offsetof(struct partial_row, event_id), offsetof(struct partial_row, ifo), offsetof(struct partial_row, peak_time), offsetof(struct partial_row, peak_time_ns), offsetof(struct partial_row, snr)};
+  const size_t colsz[] = {sizeof(INT8), sizeof(INT4), sizeof(INT4), sizeof(INT4), sizeof(REAL4)};
+  /* the dictionary of the ifo column: "H1", "L1", "V1" and "" */
+  char dict[] = "H1\0L1\0V1\0";
+  struct partial_row *rows = LALMalloc(NROWS * sizeof(*rows));
+  SnglBurst *head = NULL, **next = &head;
+  LALH5File *file = NULL;
+  LALH5Dataset *dset = NULL;
+  LIGOLwXMLStream *xml = NULL;
+  int status = 1;
+
+  if (!rows)
+    goto done;
+  for (int i = 0; i < NROWS; i++) {
+    SnglBurst *row = LALCalloc(1, sizeof(*row));
+    if (!row)
+      goto done;
+    rows[i].ifo = i % XLAL_NUM_ELEM(ifos);
+    rows[i].peak_time = 1000000000 + i;
+    rows[i].peak_time_ns = (i * 104729) % 1000000000;
+    rows[i].snr = (i % 211) * 0.25;
+    rows[i].event_id = i;
+    snprintf(row->ifo, sizeof(row->ifo), "%s", ifos[rows[i].ifo]);
+    XLALGPSSet(&row->peak_time, rows[i].peak_time, rows[i].peak_time_ns);
+    row->snr = rows[i].snr;
+    row->event_id = rows[i].event_id;
+    *next = row;
+    next = &row->next;
+  }
+
+  file = XLALH5FileOpen(h5path, "w");
+  if (!file)
+    goto done;
+  dset = XLALH5TableAlloc(file, "sngl_burst", XLAL_NUM_ELEM(cols), cols, types, offsets, sizeof(*rows));
+  if (!dset || XLALH5TableAppend(dset, offsets, colsz, NROWS, sizeof(*rows), rows) < 0)
+    goto done;
+  XLALH5DatasetFree(dset);
+  dset = XLALH5DatasetAlloc1D(file, "sngl_burst:ifo", LAL_CHAR_TYPE_CODE, sizeof(dict));
+  if (!dset || XLALH5DatasetWrite(dset, dict) < 0)
+    goto done;
+
+  xml = XLALOpenLIGOLwXMLFile(xmlpath);
+  if (!xml || XLALWriteLIGOLwXMLSnglBurstTable(xml, head) < 0)
+    goto done;
+  status = 0;
+
+done:
+  if (xml && XLALCloseLIGOLwXMLFile(xml) < 0)
+    status = 1;
+  XLALH5DatasetFree(dset);
+  if (file)
+    XLALH5FileClose(file);
+  LALFree(rows);
+  XLALDestroySnglBurstTable(head);
+  return status;
+}
+
+int main(void)
+{
+#ifndef LAL_HDF5_ENABLED
+  fprintf(stderr, "HDF5 support not enabled; skipping\n");
+  return 77;
+#else
+  if (write_tables("ligolw_h5_tables.xml")
+      || write_partial("ligolw_h5_partial.h5", "ligolw_h5_partial.xml"))
+    return 1;
+  LALCheckMemoryLeaks();
+  return 0;
+#endif
+}
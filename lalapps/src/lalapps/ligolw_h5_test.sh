@@ -0,0 +1,33 @@
+## write the test tables; the helper exits with 77 if there is no HDF5 support
+./ligolw_h5_maketables || exit $?
+
+## converting XML to HDF5 and back must give the same file
+echo "lalapps_ligolw_h5 --input ligolw_h5_tables.xml --output ligolw_h5_tables.h5"
+if ! ./lalapps_ligolw_h5 --input ligolw_h5_tables.xml --output ligolw_h5_tables.h5; then
+    echo "lalapps_ligolw_h5 failed to convert ligolw_h5_tables.xml to HDF5"
+    exit 1
+fi
+echo "lalapps_ligolw_h5 --input ligolw_h5_tables.h5 --output ligolw_h5_tables_out.xml"
+if ! ./lalapps_ligolw_h5 --input ligolw_h5_tables.h5 --output ligolw_h5_tables_out.xml; then
+    echo "lalapps_ligolw_h5 failed to convert ligolw_h5_tables.h5 to XML"
+    exit 1
+fi
+echo "cmp ligolw_h5_tables.xml ligolw_h5_tables_out.xml"
+if ! cmp ligolw_h5_tables.xml ligolw_h5_tables_out.xml; then
+    echo "ligolw_h5_tables.xml and ligolw_h5_tables_out.xml should compare equal"
+    exit 1
+fi
+
+## columns missing from the HDF5 table must be written as zero
+echo "lalapps_ligolw_h5 --input ligolw_h5_partial.h5 --output ligolw_h5_partial_out.xml"
+if ! ./lalapps_ligolw_h5 --input ligolw_h5_partial.h5 --output ligolw_h5_partial_out.xml; then
+    echo "lalapps_ligolw_h5 failed to convert ligolw_h5_partial.h5 to XML"
+    exit 1
+fi
+echo "cmp ligolw_h5_partial.xml ligolw_h5_partial_out.xml"
+if ! cmp ligolw_h5_partial.xml ligolw_h5_partial_out.xml; then
+    echo "ligolw_h5_partial.xml and ligolw_h5_partial_out.xml should compare equal"
+    exit 1
+fi
+
+rm -f ligolw_h5_tables.xml ligolw_h5_tables.h5 ligolw_h5_tables_out.xml ligolw_h5_partial.h5 ligolw_h5_partial.xml ligolw_h5_partial_out.xml
@@ -285,6 +285,8 @@ int main(int argc, char *argv[]){
     static HOUGHDemodPar   parDem;  /* demodulation parameters or  */
     static HOUGHSizePar    parSize;
     static HOUGHMapTotal   ht;   /* the total Hough map */
+    HOUGHMapTotal *htSpin = NULL; /* the total Hough maps for each spin-down value */
+    UINT8FrequencyIndexVector *freqIndSpin = NULL; /* trajectories for each spin-down value */
     static UINT8Vector     *hist; /* histogram of number counts for a single map */
     static UINT8Vector     *histTotal; /* number count histogram for all maps */
     static HoughStats      stats;  /* statistical information about a Hough map */
@@ -306,7 +308,8 @@ int main(int argc, char *argv[]){
     static HoughSignificantEventVector nStarEventVec;
     
     /* miscellaneous */
-    INT4   iHmap, nSpin1Max ;
+    INT4   iHmap, nSpin1Max, nSpinUpMax, nSpinDownMax;
+    UINT4  numSpin, iSpin;
     UINT4  mObsCoh, mObsCohBest;
     INT8   f0Bin, fLastBin, fBin;
     REAL8  alpha, delta, timeBase, deltaF, f1jump;
@@ -878,6 +881,9 @@ int main(int argc, char *argv[]){
         /* ***** for spin-down case ****/
         nSpin1Max = uvar_nfSizeCylinder - 1 - uvar_nSpinUp;
         /* nSpin1Max = floor(uvar_nfSizeCylinder/2.0) ;*/
+        nSpinUpMax = floor(uvar_nSpinUp/uvar_spindownJump);
+        nSpinDownMax = floor(nSpin1Max/uvar_spindownJump);
+        numSpin = nSpinUpMax + nSpinDownMax + 1;
         
         
         if ( XLALUserVarWasSet( &uvar_deltaF1dot ) )
@@ -954,6 +960,16 @@ int main(int argc, char *argv[]){
             ht.mObsCoh = mObsCohBest;
             ht.deltaF = deltaF;
             
+            /* one Hough map and trajectory per spin-down value, which are built together */
+            htSpin = (HOUGHMapTotal *)LALCalloc(numSpin, sizeof(HOUGHMapTotal));
+            freqIndSpin = (UINT8FrequencyIndexVector *)LALCalloc(numSpin, sizeof(UINT8FrequencyIndexVector));
+            for (iSpin = 0; iSpin < numSpin; iSpin++) {
+                htSpin[iSpin] = ht;
+                htSpin[iSpin].map = (HoughTT *)LALMalloc(xSide*ySide*sizeof(HoughTT));
+                freqIndSpin[iSpin] = freqInd;
+                freqIndSpin[iSpin].data = (UINT8 *)LALMalloc(mObsCohBest*sizeof(UINT8));
+            }
+            
             
             /*  Search frequency interval possible using the same LUTs */
             fBinSearch = fBin;
@@ -975,7 +991,18 @@ int main(int argc, char *argv[]){
                 ht.spinRes.length = 1;
                 ht.spinRes.data = NULL;
                 ht.spinRes.data = (REAL8 *)LALCalloc(ht.spinRes.length, sizeof(REAL8));
-                for ( n = floor(uvar_nSpinUp/uvar_spindownJump); n >= - floor(nSpin1Max/uvar_spindownJump); --n) {
+                /* construct paths in time-freq plane for all spindown values */
+                for ( n = nSpinUpMax, iSpin = 0; n >= - nSpinDownMax; --n, ++iSpin) {
+                    f1dis = + n * f1jump;
+                    for (j = 0 ; j < mObsCohBest; ++j){
+                        freqIndSpin[iSpin].data[j] = fBinSearch + floor(best.timeDiffV->data[j]*f1dis + 0.5);
+                    }
+                }
+                
+                /* build the Hough maps for all spindown values at once */
+                XLAL_CHECK_MAIN( XLALHOUGHConstructHMTBatch( htSpin, freqIndSpin, numSpin, &phmdVS, uvar_weighAM || uvar_weighNoise ) == XLAL_SUCCESS, XLAL_EFUNC );
+                
+                for ( n = nSpinUpMax, iSpin = 0; n >= - nSpinDownMax; --n, ++iSpin) {
                     /*for ( n = 0; n <= floor(nSpin1Max/uvar_spindownJump); ++n) {*/
                     /* f1dis = - n * f1jump; */
                     /*loop over all spindown values */
@@ -983,29 +1010,20 @@ int main(int argc, char *argv[]){
                     f1dis = + n * f1jump;
                     ht.spinRes.data[0] =  f1dis * deltaF;
                     
-                    /* construct path in time-freq plane */
-                    for (j = 0 ; j < mObsCohBest; ++j){
-                        freqInd.data[j] = fBinSearch + floor(best.timeDiffV->data[j]*f1dis + 0.5);
-                    }
-                    
-                    if (uvar_weighAM || uvar_weighNoise) {
-                        LAL_CALL( LALHOUGHConstructHMT_W( &status, &ht, &freqInd, &phmdVS ), &status );
-                    }
-                    else {
-                        LAL_CALL( LALHOUGHConstructHMT( &status, &ht, &freqInd, &phmdVS ), &status );
-                    }
+                    htSpin[iSpin].f0Bin = ht.f0Bin;
+                    htSpin[iSpin].spinRes = ht.spinRes;
                     
                     
                     /* ********************* perfom stat. analysis on the maps ****************** */
                     
                     if ( uvar_EnableExtraInfo ) {
                         
-                        LAL_CALL( LALHoughStatistics ( &status, &stats, &ht), &status );
+                        LAL_CALL( LALHoughStatistics ( &status, &stats, &htSpin[iSpin]), &status );
                         LAL_CALL( LALStereo2SkyLocation (&status, &sourceLocation,
                                                          stats.maxIndex[0], stats.maxIndex[1], &patch, &parDem), &status);
                         
                         /*LAL_CALL( LALHoughHistogram ( &status, &hist, &ht), &status);*/
-                        LAL_CALL( LALHoughHistogramSignificance ( &status, hist, &ht, meanN, sigmaN,
+                        LAL_CALL( LALHoughHistogramSignificance ( &status, hist, &htSpin[iSpin], meanN, sigmaN,
                                                                  minSignificance, maxSignificance), &status);
                         
                         for(j = 0; j < histTotal->length; j++){
@@ -1014,14 +1032,14 @@ int main(int argc, char *argv[]){
                     }
                     
                     /* select candidates from hough maps */
-                    LAL_CALL( GetToplistFromHoughmap( &status, toplist, &ht, &patch, &parDem, meanN, sigmaN), &status);
+                    LAL_CALL( GetToplistFromHoughmap( &status, toplist, &htSpin[iSpin], &patch, &parDem, meanN, sigmaN), &status);
                     
                     
                     /* ***** print results *********************** */
                     
                     if( uvar_EnableExtraInfo )
                     {
-                        if( PrintExtraInfo( fileMaps, &fp1, iHmap, &ht, &sourceLocation, &stats, fBinSearch, deltaF))
+                        if( PrintExtraInfo( fileMaps, &fp1, iHmap, &htSpin[iSpin], &sourceLocation, &stats, fBinSearch, deltaF))
                             return DRIVEHOUGHCOLOR_EFILE;
                     }
                     
@@ -1048,6 +1066,12 @@ int main(int argc, char *argv[]){
             LALFree(patch.xCoor);
             LALFree(patch.yCoor);
             LALFree(ht.map);
+            for (iSpin = 0; iSpin < numSpin; iSpin++) {
+                LALFree(htSpin[iSpin].map);
+                LALFree(freqIndSpin[iSpin].data);
+            }
+            LALFree(htSpin);
+            LALFree(freqIndSpin);
             
             LALHOUGHDestroyLUTs( &status, &lutV);
             
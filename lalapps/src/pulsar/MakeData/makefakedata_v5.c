@@ -102,6 +102,7 @@ typedef struct
   CHAR *outSFTdir;		/**< Output directory for SFTs */
   CHAR *outLabel;		/**< 'misc' entry in SFT-filenames, and description entry of output frame filenames */
   BOOLEAN outSingleSFT;	        /**< use to output a single concatenated SFT */
+  BOOLEAN outSFTsStreaming;	/**< generate and write SFTs one at a time, with bounded memory */
 
   CHAR *TDDfile;		/**< Filename for ASCII output time-series */
   CHAR *logfile;		/**< name of logfile */
@@ -144,6 +145,7 @@ typedef struct
   LALStringVector *injectionSources;	///< Source parameters to inject: comma-separated list of file-patterns and/or direct config-strings ('{...}')
 
   INT4 randSeed;		/**< allow user to specify random-number seed for reproducible noise-realizations */
+  BOOLEAN randCounterBased;	/**< use counter-based random numbers, reproducible per detector and sample */
 
 } UserVariables_t;
 
@@ -193,6 +195,7 @@ main(int argc, char *argv[])
   DataParams.multiNoiseFloor    = GV.multiNoiseFloor;
   DataParams.multiTimestamps 	= (*GV.multiTimestamps);
   DataParams.randSeed           = uvar.randSeed;
+  DataParams.randCounterBased   = uvar.randCounterBased;
   DataParams.SFTWindowType      = uvar.SFTWindowType;
   DataParams.SFTWindowBeta      = uvar.SFTWindowBeta;
   DataParams.sourceDeltaT       = uvar.sourceDeltaT;
@@ -200,6 +203,32 @@ main(int argc, char *argv[])
   DataParams.fMin               = GV.fminOut;
   DataParams.Band               = GV.BandOut;
 
+  // streaming mode: generate SFTs one at a time and write them straight to disk
+  if ( uvar.outSFTsStreaming )
+    {
+      XLAL_CHECK ( uvar.outSFTdir != NULL && is_directory ( uvar.outSFTdir ), XLAL_EINVAL, "--outSFTsStreaming requires a valid --outSFTdir\n" );
+      XLAL_CHECK ( GV.multiNoiseCatalogView == NULL && GV.inputMultiTS == NULL && uvar.TDDfile == NULL && GV.outFrameDir == NULL, XLAL_EINVAL,
+                   "--outSFTsStreaming is incompatible with --noiseSFTs, --inFrames, --TDDfile and --outFrameDir\n" );
+
+      /* generate comment string */
+      CHAR *logstr;
+      XLAL_CHECK ( (logstr = XLALUserVarGetLog ( UVAR_LOGFMT_CMDLINE )) != NULL, XLAL_EFUNC );
+      char *comment = XLALCalloc ( 1, len = strlen ( logstr ) + strlen(GV.VCSInfoString) + 512 );
+      XLAL_CHECK ( comment != NULL, XLAL_ENOMEM, "XLALCalloc(1,%zu) failed.\n", len );
+      sprintf ( comment, "Generated by:\n%s\n%s\n", logstr, GV.VCSInfoString );
+
+      XLAL_CHECK ( XLALCWMakeFakeMultiDataToDir ( uvar.outSFTdir, uvar.outSingleSFT, comment, uvar.outLabel, injectionSources, &DataParams, GV.edat ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      XLALFree ( logstr );
+      XLALFree ( comment );
+      XLALDestroyPulsarParamsVector ( injectionSources );
+      XLALFreeMem ( &GV );	/* free the config-struct */
+
+      LALCheckMemoryLeaks();
+
+      return 0;
+    } // if outSFTsStreaming
+
   XLAL_CHECK ( XLALCWMakeFakeMultiData ( &mSFTs, &mTseries, injectionSources, &DataParams, GV.edat ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   XLALDestroyPulsarParamsVector ( injectionSources );
@@ -616,6 +645,7 @@ XLALInitUserVars ( UserVariables_t *uvar, int argc, char *argv[] )
   XLALRegisterUvarMember( outSFTdir,          STRING, 'n', OPTIONAL, "Output SFTs:  directory for output SFTs");
   XLALRegisterUvarMember(  outLabel,	         STRING, 0, OPTIONAL, "'misc' entry in SFT-filenames or 'description' entry of frame filenames" );
   XLALRegisterUvarMember( TDDfile,            STRING, 't', OPTIONAL, "Filename to output time-series into");
+  XLALRegisterUvarMember( outSFTsStreaming,   BOOLEAN, 0, OPTIONAL, "Generate SFTs one at a time (in parallel with OpenMP) and write them directly to --outSFTdir, using memory for only a few SFTs. Noise is counter-based and requires --randSeed");
 
   XLALRegisterUvarMember( logfile,            STRING, 'l', OPTIONAL, "Filename for log-output");
 
@@ -648,6 +678,7 @@ XLALInitUserVars ( UserVariables_t *uvar, int argc, char *argv[] )
   /* noise */
   XLALRegisterUvarMember( noiseSFTs,          STRING, 'D', OPTIONAL, "Noise-SFTs to be added to signal (Used also to set IFOs and timestamps, and frequency range unless separately specified.)");
   XLALRegisterUvarMember( randSeed,           INT4, 0, OPTIONAL, "Specify random-number seed for reproducible noise (0 means use /dev/urandom for seeding).");
+  XLALRegisterUvarMember( randCounterBased,   BOOLEAN, 0, DEVELOPER, "Generate noise with a counter-based random-number generator: noise depends only on --randSeed, detector and GPS sample time, not on timestamps or SFT layout (requires --randSeed != 0).");
 
   /* frame input/output options */
 #ifdef HAVE_LIBLALFRAME
@@ -347,3 +347,85 @@ if ! eval $diff_cmd; then
     echo "error: $dumps_split and $dumps_fromframes should be equal."
     exit 1
 fi
+
+echo
+echo "--------------------------------------------------"
+echo "Test streaming SFT generation"
+echo "--------------------------------------------------"
+
+## counter-based noise is independent of how the data is split into SFTs,
+## so streaming and in-memory generation of pure noise must agree bit-for-bit
+## ('-e 0' requires bitwise-identical SFT data)
+mfdv5_cmd_Base="$mfdv5_CODE --IFOs=${IFO1},${IFO2} --sqrtSX=${sqrtSn1},${sqrtSn2} --randSeed=1 --randCounterBased --startTime=${s1_refTime} --duration=$(( 5 * Tsft )) --fmin=$fmin --Band=$Band --outSFTdir=${testDIR}"
+
+cmdline="$mfdv5_cmd_Base --outLabel=mfdv5noisenostream"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
+cmdline="$mfdv5_cmd_Base --outLabel=mfdv5noisestream --outSFTsStreaming"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
+for IFO in H L; do
+    cmdline="$cmp_CODE -V -e 0 -1 '${testDIR}/${IFO}-*_mfdv5noisenostream-*.sft' -2 '${testDIR}/${IFO}-*_mfdv5noisestream-*.sft'"
+    echo ${cmdline}
+    if ! eval $cmdline; then
+        echo "Failed. Noise SFTs produced with and without --outSFTsStreaming are not bitwise identical!"
+        exit 2
+    else
+        echo "OK."
+    fi
+done
+
+## with signals, streaming SFTs must not depend on the number of threads or on the output file layout
+mfdv5_cmd_Base="$mfdv5_CODE --IFOs=${IFO1},${IFO2} --sqrtSX=${sqrtSn1},${sqrtSn2} --randSeed=1 --randCounterBased --startTime=${s1_refTime} --duration=$(( 5 * Tsft )) --fmin=$fmin --Band=$Band --injectionSources='${injString}' --outSFTdir=${testDIR}"
+
+cmdline="OMP_NUM_THREADS=1 $mfdv5_cmd_Base --outLabel=mfdv5stream --outSFTsStreaming"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
+cmdline="OMP_NUM_THREADS=3 $mfdv5_cmd_Base --outLabel=mfdv5streamT3 --outSFTsStreaming --outSingleSFT=False"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
+for IFO in H L; do
+    cmdline="$cmp_CODE -V -e 0 -1 '${testDIR}/${IFO}-*_mfdv5stream-*.sft' -2 '${testDIR}/${IFO}-*_mfdv5streamT3-*.sft'"
+    echo ${cmdline}
+    if ! eval $cmdline; then
+        echo "Failed. Streamed SFTs produced with 1 and 3 threads are not bitwise identical!"
+        exit 2
+    else
+        echo "OK."
+    fi
+done
+
+## signals are generated per SFT when streaming, so agree with in-memory generation only numerically
+cmdline="$mfdv5_cmd_Base --outLabel=mfdv5nostream"
+echo $cmdline;
+if ! eval $cmdline; then
+    echo "Error.. something failed when running '$mfdv5_CODE' ..."
+    exit 1
+fi
+
+for IFO in H L; do
+    cmdline="$cmp_CODE -V -e ${tol} -1 '${testDIR}/${IFO}-*_mfdv5nostream-*.sft' -2 '${testDIR}/${IFO}-*_mfdv5stream-*.sft'"
+    echo ${cmdline}
+    if ! eval $cmdline; then
+        echo "Failed. SFTs produced with and without --outSFTsStreaming differ by more than ${tol}!"
+        exit 2
+    else
+        echo "OK."
+    fi
+done
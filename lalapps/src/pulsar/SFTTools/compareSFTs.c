@@ -28,6 +28,8 @@
 
 #include <LALAppsVCSInfo.h>
 
+#include <string.h>
+
 #include <lal/Date.h>
 #include <lal/UserInput.h>
 #include <lal/SFTfileIO.h>
@@ -101,6 +103,28 @@ main(int argc, char *argv[])
       XLAL_CHECK_MAIN ( sft1->deltaF == sft2->deltaF, XLAL_EINVAL, "ERROR SFT %d: deltaF differs: %fHz vs %fHz\n", i, sft1->deltaF, sft2->deltaF );
     } /* for i < numSFTs */
 
+  /* ---------- zero tolerance: require bitwise-identical SFT data ----------*/
+  if ( uvar.relErrorMax == 0 )
+    {
+      int differ = 0;
+      for ( UINT4 i=0; i < SFTs1->length; i++ )
+        {
+          if ( memcmp ( SFTs1->data[i].data->data, SFTs2->data[i].data->data, SFTs1->data[i].data->length * sizeof(SFTs1->data[i].data->data[0]) ) != 0 )
+            {
+              XLALPrintError ("SFT %d: data not bitwise identical\n", i );
+              differ = 1;
+            }
+        }
+      if ( uvar.verbose ) {
+        printf ("COMPARE: %d SFTs %s\n", SFTs1->length, differ ? "differ" : "bitwise identical" );
+      }
+      XLALDestroySFTVector ( SFTs1 );
+      XLALDestroySFTVector ( SFTs2 );
+      XLALDestroyUserVars();
+      LALCheckMemoryLeaks();
+      return differ;
+    }
+
   /*---------- now do some actual comparisons ----------*/
   XLAL_CHECK_MAIN ( (diffs = subtractSFTVectors ( SFTs1, SFTs2)) != NULL, XLAL_EFUNC );
 
@@ -195,7 +219,7 @@ initUserVars ( UserInput_t *uvar )
   XLAL_CHECK ( XLALRegisterUvarMember( sftBname1,       STRING,  '1', REQUIRED, "Path and basefilename for SFTs1") == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK ( XLALRegisterUvarMember( sftBname2,       STRING,  '2', REQUIRED, "Path and basefilename for SFTs2") == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK ( XLALRegisterUvarMember( verbose,         BOOLEAN, 'V', OPTIONAL, "Verbose output of differences") == XLAL_SUCCESS, XLAL_EFUNC );
-  XLAL_CHECK ( XLALRegisterUvarMember( relErrorMax,     REAL8,   'e', OPTIONAL, "Maximal relative error acceptable to 'pass' comparison") == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALRegisterUvarMember( relErrorMax,     REAL8,   'e', OPTIONAL, "Maximal relative error acceptable to 'pass' comparison (0: require bitwise-identical SFT data)") == XLAL_SUCCESS, XLAL_EFUNC );
 
   return XLAL_SUCCESS;
 
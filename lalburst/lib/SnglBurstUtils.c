@@ -22,6 +22,7 @@
 #include <lal/Date.h>
 #include <lal/LIGOMetadataTables.h>
 #include <lal/SnglBurstUtils.h>
+#include <lal/TriggerCluster.h>
 #include <lal/XLALError.h>
 
 
@@ -155,6 +156,91 @@ int XLALCompareSnglBurstByPeakTimeAndSNR(
 }
 
 
+/*
+ * Adapts a SnglBurst pair test to XLALTriggerStoreCluster().
+ */
+
+
+struct SnglBurstClusterTest {
+	int (*testfunc)(const SnglBurst *, const SnglBurst *);
+};
+
+
+static int XLALSnglBurstClusterTest(const LALTriggerStore *store, size_t i, size_t j, void *params)
+{
+	const struct SnglBurstClusterTest *test = params;
+	return test->testfunc(store->row[j], store->row[i]);
+}
+
+
+/**
+ * Cluster a list of SnglBurst events by peak time.  Events whose peak
+ * times are no more than window seconds apart and, if testfunc is not
+ * NULL, for which testfunc(a, b) returns 1 (a being the earlier event) are
+ * linked; each connected group of linked events is replaced by its event
+ * with the largest SNR.  The other events are freed, and the list is left
+ * sorted by peak time.  testfunc must return 0 if the events are not
+ * linked, and a negative value on error.
+ *
+ * The events are sorted and clustered in an array, so the cost is O(N log
+ * N) plus one testfunc call per pair of events within the window.
+ */
+int XLALClusterSnglBurstByPeakTime(
+	SnglBurst **head,
+	REAL8 window,
+	int (*testfunc)(const SnglBurst *, const SnglBurst *)
+)
+{
+	struct SnglBurstClusterTest test = {testfunc};
+	LALTriggerStore *store;
+	SnglBurst *event;
+	SnglBurst **next;
+	size_t i;
+
+	if(!head)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(window < 0)
+		XLAL_ERROR(XLAL_EINVAL, "window must be non-negative");
+
+	/* empty list --> no-op */
+	if(!*head)
+		return 0;
+
+	/* construct a time-sorted array of pointers into the list */
+	store = XLALCreateTriggerStore(XLALSnglBurstTableLength(*head));
+	if(!store)
+		XLAL_ERROR(XLAL_EFUNC);
+	for(event = *head; event; event = event->next)
+		if(XLALTriggerStoreAppend(store, XLALGPSToINT8NS(&event->peak_time), event->snr, event) < 0) {
+			XLALDestroyTriggerStore(store);
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+
+	/* cluster, leaving the list untouched on failure */
+	if(XLALTriggerStoreSort(store) < 0 || XLALTriggerStoreCluster(store, (INT8) (window * 1e9 + 0.5), testfunc ? XLALSnglBurstClusterTest : NULL, &test, 0) < 0) {
+		XLALDestroyTriggerStore(store);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	/* re-link the list from the loudest event of each cluster, freeing the rest */
+	next = head;
+	for(i = 0; i < store->length; i++) {
+		event = store->row[i];
+		if(store->cluster[i] == i) {
+			*next = event;
+			next = &event->next;
+		} else
+			XLALDestroySnglBurst(event);
+	}
+	*next = NULL;
+
+	XLALDestroyTriggerStore(store);
+
+	/* success */
+	return 0;
+}
+
+
 /**
  * Create a SnglBurst structure.
  */
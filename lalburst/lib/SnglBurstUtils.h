@@ -65,6 +65,13 @@ XLALCompareSnglBurstByPeakTimeAndSNR(
 	const SnglBurst * const *b
 );
 
+int
+XLALClusterSnglBurstByPeakTime(
+	SnglBurst **head,
+	REAL8 window,
+	int (*testfunc)(const SnglBurst *, const SnglBurst *)
+);
+
 SnglBurst *
 XLALCreateSnglBurst(
 	void
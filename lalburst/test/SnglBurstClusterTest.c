@@ -0,0 +1,160 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/*
+ * Check XLALClusterSnglBurstByPeakTime() against the iterative pairwise
+ * clustering used by lalapps_StringSearch.  The two agree when every pair of
+ * events in a cluster is linked, so events are drawn in groups narrower
+ * than the window and separated by more than it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/Date.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/SnglBurstUtils.h>
+
+#define NGROUP 200
+#define MAXPERGROUP 8
+#define WINDOW 0.5
+#define SPREAD 0.4
+#define SPACING 5.0
+
+/* events are linked only if their central frequencies are equal */
+static int test_freq(const SnglBurst *a, const SnglBurst *b)
+{
+	return a->central_freq == b->central_freq;
+}
+
+static int compare_time(const SnglBurst *a, const SnglBurst *b)
+{
+	double delta_t = XLALGPSDiff(&a->peak_time, &b->peak_time);
+	return delta_t <= WINDOW && delta_t >= -WINDOW;
+}
+
+/* reference clustering: merge linked pairs until the list stops changing,
+ * keeping the event with the largest SNR, as in lalapps_StringSearch */
+static void reference_cluster(SnglBurst **list, int use_test)
+{
+	int did_cluster;
+	SnglBurst *a, *b, *prev;
+
+	do {
+		did_cluster = 0;
+		for(a = *list; a; a = a->next)
+			for(prev = a, b = a->next; b; b = prev->next) {
+				if(compare_time(a, b) && (!use_test || test_freq(a, b))) {
+					if(b->snr > a->snr) {
+						SnglBurst *next = a->next;
+						*a = *b;
+						a->next = next;
+					}
+					prev->next = b->next;
+					XLALDestroySnglBurst(b);
+					did_cluster = 1;
+				} else
+					prev = b;
+			}
+	} while(did_cluster);
+}
+
+/* a random list of events, in random order */
+static SnglBurst *make_events(unsigned seed)
+{
+	SnglBurst *head = NULL;
+	long id = 0;
+
+	srand(seed);
+	for(int g = 0; g < NGROUP; g++) {
+		int n = 1 + rand() % MAXPERGROUP;
+		for(int k = 0; k < n; k++) {
+			SnglBurst *event = XLALCreateSnglBurst();
+			if(!event)
+				return NULL;
+			XLALGPSSet(&event->peak_time, 1000000000, 0);
+			XLALGPSAdd(&event->peak_time, g * SPACING + SPREAD * rand() / (RAND_MAX + 1.0));
+			event->snr = 1.0 + 100.0 * rand() / (RAND_MAX + 1.0);
+			event->central_freq = (rand() % 2) ? 100.0 : 1000.0;
+			event->event_id = id++;
+			/* insert at a random position */
+			SnglBurst **pos = &head;
+			for(int skip = rand() % (id); skip > 0 && *pos; skip--)
+				pos = &(*pos)->next;
+			event->next = *pos;
+			*pos = event;
+		}
+	}
+	return head;
+}
+
+static int check(int use_test)
+{
+	SnglBurst *events = make_events(1729);
+	SnglBurst *reference = make_events(1729);
+	SnglBurst *a, *b;
+	int n = 0;
+
+	if(!events || !reference)
+		return 1;
+
+	if(XLALClusterSnglBurstByPeakTime(&events, WINDOW, use_test ? test_freq : NULL) < 0)
+		return 1;
+	reference_cluster(&reference, use_test);
+	if(!XLALSortSnglBurst(&reference, XLALCompareSnglBurstByPeakTimeAndSNR))
+		return 1;
+
+	for(a = events, b = reference; a && b; a = a->next, b = b->next, n++)
+		if(a->event_id != b->event_id || XLALGPSCmp(&a->peak_time, &b->peak_time) || a->snr != b->snr) {
+			fprintf(stderr, "SnglBurstClusterTest: FAIL (%s test: event %d is %ld, expected %ld)\n", use_test ? "with" : "without", n, a->event_id, b->event_id);
+			return 1;
+		}
+	if(a || b) {
+		fprintf(stderr, "SnglBurstClusterTest: FAIL (%s test: %d events, expected %d)\n", use_test ? "with" : "without", XLALSnglBurstTableLength(events), XLALSnglBurstTableLength(reference));
+		return 1;
+	}
+	/* without the test there is exactly one event per group */
+	if(!use_test && n != NGROUP) {
+		fprintf(stderr, "SnglBurstClusterTest: FAIL (%d clusters, expected %d)\n", n, NGROUP);
+		return 1;
+	}
+
+	XLALDestroySnglBurstTable(events);
+	XLALDestroySnglBurstTable(reference);
+	return 0;
+}
+
+int main(void)
+{
+	SnglBurst *empty = NULL;
+
+	if(check(0) || check(1))
+		return 1;
+
+	/* an empty list is a no-op, and a negative window is an error */
+	if(XLALClusterSnglBurstByPeakTime(&empty, WINDOW, NULL) != 0 || empty)
+		return 1;
+	XLALSetSilentErrorHandler();
+	if(XLALClusterSnglBurstByPeakTime(&empty, -1.0, NULL) != XLAL_FAILURE || xlalErrno != XLAL_EINVAL)
+		return 1;
+	XLALClearErrno();
+
+	LALCheckMemoryLeaks();
+	fprintf(stderr, "SnglBurstClusterTest: PASS\n");
+	return 0;
+}
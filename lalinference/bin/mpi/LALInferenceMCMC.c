@@ -100,6 +100,8 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     ----------------------------------------------\n\
     (--adapt-temps)     Adapt the spacing between temperatures for uniform swap acceptance\n\
     (--temp-skip N)     Number of steps between temperature swap proposals (100)\n\
+    (--async-swaps)     Swap only between neighbouring processes, with non-blocking messages,\n\
+                        on alternating even and odd pairs of the ladder\n\
     (--tempKill N)      Iteration number to stop temperature swapping (Niter)\n\
     (--ntemps N)         Number of temperature chains in ladder (as many as needed)\n\
     (--temp-min T)      Lowest temperature for parallel tempering (1.0)\n\
@@ -165,6 +167,9 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
         //runState->parallelSwap = &LALInferenceMCMCMCswap;
         fprintf(stderr, "ERROR: MCMCMC sampling hasn't been brought up-to-date since restructuring.\n");
         return XLAL_FAILURE;
+    } else if (LALInferenceGetProcParamVal(command_line, "--async-swaps")) {
+        /* Parallel tempering swap with non-blocking exchanges between neighbouring processes */
+        runState->parallelSwap = &LALInferencePTswapAsync;
     } else {
         /* Standard parallel tempering swap. */
         runState->parallelSwap = &LALInferencePTswap;
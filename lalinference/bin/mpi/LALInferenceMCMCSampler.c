@@ -25,6 +25,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
 #include <sys/times.h>
 #ifdef HAVE_UNISTD_H
@@ -211,6 +212,11 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 	ProcessParamsTable *ppt=NULL;
 	int local_exitFlag=0;
 	int local_saveStateFlag=0;
+    /* With asynchronous swaps, the root's save-state, exit and run-complete flags are
+     * broadcast without blocking, and acted upon by all processes on the following cycle */
+    INT4 async = (runState->parallelSwap == &LALInferencePTswapAsync);
+    INT4 control[3] = {0, 0, 0};
+    MPI_Request control_request = MPI_REQUEST_NULL;
 
     memset(&status, 0, sizeof(status));
 
@@ -374,6 +380,21 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     // iterate:
     step_last_acl_check = runState->threads[0].step;
     while (!runComplete) {
+        /* Complete the exchanges of the last swap cycle that do not hold chains over this one */
+        if (async) {
+            verbose_file = NULL;
+            if (tempVerbose) {
+                sprintf(verbose_filename, "PTMCMC.tempswaps.%u.%2.2d", randomseed, MPIrank);
+                verbose_file = fopen(verbose_filename, "a");
+            }
+            if (LALInferenceCompletePTswapAsync(runState, verbose_file) != XLAL_SUCCESS) {
+                fprintf(stderr, "Process %i failed to complete temperature swaps\n", MPIrank);
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+            if (tempVerbose)
+                fclose(verbose_file);
+        }
+
         #pragma omp parallel for private(thread)
         for (t = 0; t < n_local_threads; t++) {
             FILE *outfile = NULL;
@@ -384,6 +405,10 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 
             thread = &runState->threads[t];
 
+            /* Hold chains whose states are being exchanged with a neighbouring process */
+            if (async && LALInferencePTswapAsyncHolds(runState, t))
+                continue;
+
             for (i=0; i<temp_skip; i++) {
                 /* Increment iteration counter */
                 thread->step += 1;
@@ -456,12 +481,29 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         }
 
 		/* Synchronise interruptions */
+        if (async) {
+            /* Complete the broadcast posted at the end of the previous cycle */
+            MPI_Wait(&control_request, MPI_STATUS_IGNORE);
+            local_saveStateFlag = control[0];
+            local_exitFlag = control[1];
+
+            /* Settle all exchanges before saving or exiting */
+            if (local_saveStateFlag || local_exitFlag || control[2]) {
+                if (LALInferenceFlushPTswapAsync(runState, NULL) != XLAL_SUCCESS) {
+                    fprintf(stderr, "Process %i failed to complete temperature swaps\n", MPIrank);
+                    MPI_Abort(MPI_COMM_WORLD, 1);
+                }
+                if (adapt_temps)
+                    LALInferenceFlushAdaptLadderAsync(runState);
+            }
+        } else {
 		if(MPIrank==0){
                     local_saveStateFlag=__master_saveStateFlag;
                     local_exitFlag=__master_exitFlag;
 		}
 		MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
 		MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        }
         INT4 saveattempts=0;
         INT4 retrydelay=5; /* 5 seconds before initial retry */
         INT4 retcode=XLAL_SUCCESS;
@@ -506,6 +548,10 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 				exit(CondorExitCode);
 		}
 
+        /* Stop on the root's decision from the previous cycle */
+        if (async && control[2])
+            break;
+
         /* Open swap file if going verbose */
         verbose_file = NULL;
         if (tempVerbose) {
@@ -513,12 +559,24 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
             verbose_file = fopen(verbose_filename, "a");
         }
 
-        /* Excute swap proposal. */
-        runState->parallelSwap(runState, verbose_file);
+        /* Excute swap proposal; a failed asynchronous swap leaves its neighbours waiting, so abort */
+        if (async) {
+            INT4 swapcode;
+            XLAL_TRY(runState->parallelSwap(runState, verbose_file), swapcode);
+            if (swapcode != XLAL_SUCCESS) {
+                fprintf(stderr, "Process %i failed to swap temperatures: %s\n", MPIrank, XLALErrorString(swapcode));
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+        } else
+            runState->parallelSwap(runState, verbose_file);
 
         /* Modify temperatures to strive for uniform swap acceptance rates */
-        if (adapt_temps)
-            LALInferenceAdaptLadder(runState);
+        if (adapt_temps) {
+            if (async)
+                LALInferenceAdaptLadderAsync(runState);
+            else
+                LALInferenceAdaptLadder(runState);
+        }
 
         if (tempVerbose)
             fclose(verbose_file);
@@ -561,7 +619,16 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         }
 
         /* Broadcast the root's decision on run completion */
-        MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (async) {
+            if (MPIrank == 0) {
+                control[0] = __master_saveStateFlag;
+                control[1] = __master_exitFlag;
+                control[2] = runComplete;
+            }
+            MPI_Ibcast(control, 3, MPI_INT, 0, MPI_COMM_WORLD, &control_request);
+            runComplete = 0;
+        } else
+            MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
     }// while (!runComplete)
     LALInferenceWriteMCMCSamples(runState);
     MPI_Barrier(MPI_COMM_WORLD);
@@ -674,6 +741,28 @@ void mcmc_step(LALInferenceRunState *runState, LALInferenceThreadState *thread)
 //-----------------------------------------
 // Temperature adaptation à la arXiv:1501.05823
 //-----------------------------------------
+/* Update the ladder from the swap acceptance ratios of its chains */
+static void adapt_ladder_temperatures(REAL8 *temperatures, const INT4 *nsteps, const REAL8 *acceptance_ratios,
+                                      INT4 ntemps, INT4 adaptLength, INT4 temp_skip) {
+    REAL8 delta = 0;
+    for (INT4 t=1; t < ntemps-1; t++) {
+        REAL8 steps = adaptLength + nsteps[t-1];
+
+        // Modulate temperature adjustments with a hyperbolic decay.
+        REAL8 decay = adaptLength / (steps + adaptLength);
+        REAL8 kappa = decay / (10*temp_skip);
+
+        // Construct temperature adjustments.
+        REAL8 dS = kappa * (acceptance_ratios[t-1] - acceptance_ratios[t]);
+
+        // Compute new ladder (hottest and coldest chains don't move).
+        REAL8 deltaT = (temperatures[t] - temperatures[t-1]) * exp(dS);
+        delta += deltaT;
+
+        temperatures[t] =  delta + temperatures[0];
+    }
+}
+
 void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
     INT4 MPIrank, MPIsize;
     INT4 n_local_threads, ntemps;
@@ -724,25 +813,8 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
                acceptance_ratios, n_local_threads, MPI_DOUBLE,
                0, MPI_COMM_WORLD);
 
-    if (MPIrank == 0) {
-        REAL8 delta = 0;
-        for (t=1; t < ntemps-1; t++) {
-            REAL8 steps = adaptLength + nsteps[t-1];
-
-            // Modulate temperature adjustments with a hyperbolic decay.
-            REAL8 decay = adaptLength / (steps + adaptLength);
-            REAL8 kappa = decay / (10*temp_skip);
-
-            // Construct temperature adjustments.
-            REAL8 dS = kappa * (acceptance_ratios[t-1] - acceptance_ratios[t]);
-
-            // Compute new ladder (hottest and coldest chains don't move).
-            REAL8 deltaT = (temperatures[t] - temperatures[t-1]) * exp(dS);
-            delta += deltaT;
-
-            temperatures[t] =  delta + temperatures[0];
-        }
-    }
+    if (MPIrank == 0)
+        adapt_ladder_temperatures(temperatures, nsteps, acceptance_ratios, ntemps, adaptLength, temp_skip);
 
     MPI_Scatter(temperatures, n_local_threads, MPI_DOUBLE,
                 local_temperatures, n_local_threads, MPI_DOUBLE,
@@ -762,9 +834,199 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState) {
     return;
 }
 
+/* Collectives posted by LALInferenceAdaptLadderAsync(), which are completed on the following cycle */
+static struct {
+    INT4 initialised;
+    INT4 gather_pending;        /** Swap statistics are being gathered on the root */
+    INT4 scatter_pending;       /** The updated ladder is being scattered from the root */
+    MPI_Request gather_requests[2];
+    MPI_Request scatter_request;
+    INT4 *local_nsteps, *nsteps;
+    REAL8 *local_acceptance_ratios, *acceptance_ratios;
+    REAL8 *local_temperatures;
+    REAL8 *temperatures;        /** Current ladder, kept by the root */
+} AdaptLadderAsync;
+
+/* Update the ladder on the root from the gathered statistics, and start distributing it */
+static void scatter_adapted_ladder(LALInferenceRunState *runState) {
+    INT4 MPIrank, MPIsize;
+    INT4 n_local_threads = runState->nthreads;
+
+    INT4 adaptLength = LALInferenceGetINT4Variable(runState->algorithmParams, "adaptLength");
+    INT4 temp_skip = LALInferenceGetINT4Variable(runState->algorithmParams, "tskip");
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+
+    MPI_Waitall(2, AdaptLadderAsync.gather_requests, MPI_STATUSES_IGNORE);
+    AdaptLadderAsync.gather_pending = 0;
+
+    if (MPIrank == 0)
+        adapt_ladder_temperatures(AdaptLadderAsync.temperatures, AdaptLadderAsync.nsteps,
+                                  AdaptLadderAsync.acceptance_ratios, MPIsize*n_local_threads, adaptLength, temp_skip);
+
+    MPI_Iscatter(AdaptLadderAsync.temperatures, n_local_threads, MPI_DOUBLE,
+                 AdaptLadderAsync.local_temperatures, n_local_threads, MPI_DOUBLE,
+                 0, MPI_COMM_WORLD, &AdaptLadderAsync.scatter_request);
+    AdaptLadderAsync.scatter_pending = 1;
+}
+
+static void apply_scattered_temperatures(LALInferenceRunState *runState) {
+    MPI_Wait(&AdaptLadderAsync.scatter_request, MPI_STATUS_IGNORE);
+    for (INT4 t=0; t<runState->nthreads; t++)
+        runState->threads[t].temperature = AdaptLadderAsync.local_temperatures[t];
+    AdaptLadderAsync.scatter_pending = 0;
+}
+
+/* Temperature adaptation as in LALInferenceAdaptLadder(), pipelined over cycles: the swap statistics
+ * gathered on one cycle update the ladder on the next, which is applied on the cycle after that.
+ * Every collective is completed one cycle after it is posted, so no process waits on the others
+ * unless they fall a whole cycle behind. */
+void LALInferenceAdaptLadderAsync(LALInferenceRunState *runState) {
+    INT4 MPIsize;
+    INT4 n_local_threads, ntemps;
+    INT4 t;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+
+    n_local_threads = runState->nthreads;
+    ntemps = MPIsize*n_local_threads;
+
+    /* Return if running with only a single temperature */
+    if (ntemps == 1)
+        return;
+
+    /* Have the root start from the current ladder */
+    if (!AdaptLadderAsync.initialised) {
+        AdaptLadderAsync.local_nsteps = XLALCalloc(n_local_threads, sizeof(INT4));
+        AdaptLadderAsync.local_acceptance_ratios = XLALCalloc(n_local_threads, sizeof(REAL8));
+        AdaptLadderAsync.local_temperatures = XLALCalloc(n_local_threads, sizeof(REAL8));
+        AdaptLadderAsync.nsteps = XLALCalloc(ntemps, sizeof(INT4));
+        AdaptLadderAsync.acceptance_ratios = XLALCalloc(ntemps, sizeof(REAL8));
+        AdaptLadderAsync.temperatures = XLALCalloc(ntemps, sizeof(REAL8));
+
+        for (t=0; t<n_local_threads; t++)
+            AdaptLadderAsync.local_temperatures[t] = runState->threads[t].temperature;
+        MPI_Gather(AdaptLadderAsync.local_temperatures, n_local_threads, MPI_DOUBLE,
+                   AdaptLadderAsync.temperatures, n_local_threads, MPI_DOUBLE,
+                   0, MPI_COMM_WORLD);
+
+        AdaptLadderAsync.initialised = 1;
+    }
+
+    /* Apply the ladder scattered on the previous cycle */
+    if (AdaptLadderAsync.scatter_pending)
+        apply_scattered_temperatures(runState);
+
+    /* Update the ladder from the statistics gathered on the previous cycle, and distribute it */
+    if (AdaptLadderAsync.gather_pending)
+        scatter_adapted_ladder(runState);
+
+    /* Gather this cycle's statistics */
+    for (t=0; t<n_local_threads; t++) {
+        AdaptLadderAsync.local_nsteps[t] = runState->threads[t].step;
+
+        REAL8 acc_ratio = 0.0;
+        for (INT4 i=0; i<runState->threads[t].temp_swap_window; i++)
+            acc_ratio += (REAL8)runState->threads[t].temp_swap_accepts[i] / runState->threads[t].temp_swap_window;
+        AdaptLadderAsync.local_acceptance_ratios[t] = acc_ratio;
+    }
+
+    MPI_Igather(AdaptLadderAsync.local_nsteps, n_local_threads, MPI_INT,
+                AdaptLadderAsync.nsteps, n_local_threads, MPI_INT,
+                0, MPI_COMM_WORLD, &AdaptLadderAsync.gather_requests[0]);
+    MPI_Igather(AdaptLadderAsync.local_acceptance_ratios, n_local_threads, MPI_DOUBLE,
+                AdaptLadderAsync.acceptance_ratios, n_local_threads, MPI_DOUBLE,
+                0, MPI_COMM_WORLD, &AdaptLadderAsync.gather_requests[1]);
+    AdaptLadderAsync.gather_pending = 1;
+
+    return;
+}
+
+void LALInferenceFlushAdaptLadderAsync(LALInferenceRunState *runState) {
+    if (!AdaptLadderAsync.initialised)
+        return;
+
+    if (AdaptLadderAsync.scatter_pending)
+        apply_scattered_temperatures(runState);
+
+    if (AdaptLadderAsync.gather_pending) {
+        scatter_adapted_ladder(runState);
+        apply_scattered_temperatures(runState);
+    }
+
+    XLALFree(AdaptLadderAsync.local_nsteps);
+    XLALFree(AdaptLadderAsync.local_acceptance_ratios);
+    XLALFree(AdaptLadderAsync.local_temperatures);
+    XLALFree(AdaptLadderAsync.nsteps);
+    XLALFree(AdaptLadderAsync.acceptance_ratios);
+    XLALFree(AdaptLadderAsync.temperatures);
+    memset(&AdaptLadderAsync, 0, sizeof(AdaptLadderAsync));
+
+    return;
+}
+
 //-----------------------------------------
 // Swap routines:
 //-----------------------------------------
+
+/* Log of the acceptance ratio for swapping the states of a cold and a hot chain.  Both ranks
+ * taking part in an asynchronous swap evaluate this with identical arguments, so they always
+ * reach the same decision. */
+static REAL8 PTswap_log_ratio(REAL8 cold_temp, REAL8 cold_like, REAL8 hot_temp, REAL8 hot_like) {
+    REAL8 logThreadSwap = 1.0/cold_temp - 1.0/hot_temp;
+    logThreadSwap *= hot_like - cold_like;
+    return logThreadSwap;
+}
+
+/* Propose a swap between two chains handled by this process */
+static void local_PTswap(LALInferenceRunState *runState, LALInferenceThreadState *cold_thread, LALInferenceThreadState *hot_thread,
+                         INT4 cold_ind, INT4 hot_ind, FILE *swapfile) {
+    INT4 swapAccepted;
+    REAL8 logThreadSwap, temp_prior, temp_like;
+    LALInferenceVariables *temp_params;
+
+    /* Determine if swap is accepted */
+    logThreadSwap = PTswap_log_ratio(cold_thread->temperature, cold_thread->currentLikelihood,
+                                     hot_thread->temperature, hot_thread->currentLikelihood);
+
+    if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+        swapAccepted = 1;
+    else
+        swapAccepted = 0;
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+    /* Print to file if verbose is chosen */
+    if (swapfile != NULL) {
+        REAL8 acc_frac = 0.0;
+        for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+            acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+        cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
+        fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+                cold_thread->step, cold_ind, cold_thread->temperature,
+                hot_ind, hot_thread->temperature,
+                logThreadSwap, cold_thread->currentLikelihood,
+                hot_thread->currentLikelihood, swapAccepted, acc_frac);
+    }
+
+    if (swapAccepted) {
+        temp_params = hot_thread->currentParams;
+        temp_prior = hot_thread->currentPrior;
+        temp_like = hot_thread->currentLikelihood;
+
+        hot_thread->currentParams = cold_thread->currentParams;
+        hot_thread->currentPrior = cold_thread->currentPrior;
+        hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+
+        cold_thread->currentParams = temp_params;
+        cold_thread->currentPrior = temp_prior;
+        cold_thread->currentLikelihood = temp_like;
+    }
+
+    return;
+}
+
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 MPIrank, MPIsize;
     MPI_Status MPIstatus;
@@ -775,10 +1037,9 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     INT4 swapAccepted;
     INT4 *cold_inds;
     REAL8 adjCurrentLikelihood, adjCurrentPrior;
-    REAL8 logThreadSwap, temp_prior, temp_like, cold_temp;
+    REAL8 logThreadSwap, cold_temp;
     LALInferenceThreadState *cold_thread = &runState->threads[0];
     LALInferenceThreadState *hot_thread;
-    LALInferenceVariables *temp_params;
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
     MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
@@ -815,44 +1076,7 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
                 cold_thread = &runState->threads[cold_ind % n_local_threads];
                 hot_thread = &runState->threads[hot_ind % n_local_threads];
 
-                /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
-
-                if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
-                    swapAccepted = 1;
-                else
-                    swapAccepted = 0;
-                cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
-                cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
-
-                /* Print to file if verbose is chosen */
-                if (swapfile != NULL) {
-                    REAL8 acc_frac = 0.0;
-                    for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
-                        acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
-                    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter % cold_thread->temp_swap_window] = swapAccepted;
-                    fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
-                            cold_thread->step, cold_ind, cold_thread->temperature,
-                            hot_ind, hot_thread->temperature,
-                            logThreadSwap, cold_thread->currentLikelihood,
-                            hot_thread->currentLikelihood, swapAccepted, acc_frac);
-                }
-
-                if (swapAccepted) {
-                    temp_params = hot_thread->currentParams;
-                    temp_prior = hot_thread->currentPrior;
-                    temp_like = hot_thread->currentLikelihood;
-
-                    hot_thread->currentParams = cold_thread->currentParams;
-                    hot_thread->currentPrior = cold_thread->currentPrior;
-                    hot_thread->currentLikelihood = cold_thread->currentLikelihood;
-
-                    cold_thread->currentParams = temp_params;
-                    cold_thread->currentPrior = temp_prior;
-                    cold_thread->currentLikelihood = temp_like;
-                }
-
+                local_PTswap(runState, cold_thread, hot_thread, cold_ind, hot_ind, swapfile);
             }
         } else {
             if (MPIrank == cold_rank) {
@@ -904,8 +1128,7 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
                 MPI_Recv(&adjCurrentLikelihood, 1, MPI_DOUBLE, cold_rank, PT_COM, MPI_COMM_WORLD, &MPIstatus);
 
                 /* Determine if swap is accepted and tell the other chain */
-                logThreadSwap = 1.0/cold_temp - 1.0/hot_thread->temperature;
-                logThreadSwap *= hot_thread->currentLikelihood - adjCurrentLikelihood;
+                logThreadSwap = PTswap_log_ratio(cold_temp, adjCurrentLikelihood, hot_thread->temperature, hot_thread->currentLikelihood);
                 if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
                     swapAccepted = 1;
                 else
@@ -961,6 +1184,229 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
     return;
 }
 
+/* Layout of the messages exchanged by LALInferencePTswapAsync() */
+typedef enum {
+    PT_ASYNC_TEMPERATURE,
+    PT_ASYNC_LIKELIHOOD,
+    PT_ASYNC_PRIOR,
+    PT_ASYNC_UNIFORM,    /** Uniform deviate drawn by the colder chain, used by both ranks */
+    PT_ASYNC_NPAR,
+    PT_ASYNC_PARAMS      /** Start of the non-fixed parameters */
+} LALInferencePTswapAsyncMessage;
+
+/* Exchanges posted by LALInferencePTswapAsync().  If this process has other chains to step,
+ * the chains whose states are in flight are held, i.e. not stepped, and the exchanges are
+ * completed on the following swap cycle.  Otherwise the exchanges are completed just before
+ * the chains are next stepped, so that they overlap the rest of the current cycle. */
+static struct {
+    INT4 pending;        /** Exchanges have been posted and not yet completed */
+    INT4 hold;           /** The chains in flight are held over the next cycle */
+    INT4 cold_side;      /** This process holds the colder chain of the pair (last, last+1) */
+    INT4 hot_side;       /** This process holds the hotter chain of the pair (first-1, first) */
+    INT4 first, last;    /** Ladder indices of the coldest and hottest chains of this process */
+    INT4 nPar;
+    INT4 nrequests;
+    MPI_Request requests[4];
+    REAL8 *cold_send, *cold_recv;
+    REAL8 *hot_send, *hot_recv;
+} PTswapAsync;
+
+static void pack_PTswap_message(LALInferenceThreadState *thread, REAL8 uniform, INT4 nPar, REAL8 *message) {
+    message[PT_ASYNC_TEMPERATURE] = thread->temperature;
+    message[PT_ASYNC_LIKELIHOOD] = thread->currentLikelihood;
+    message[PT_ASYNC_PRIOR] = thread->currentPrior;
+    message[PT_ASYNC_UNIFORM] = uniform;
+    message[PT_ASYNC_NPAR] = nPar;
+    LALInferenceCopyVariablesToArray(thread->currentParams, &message[PT_ASYNC_PARAMS]);
+}
+
+/* Complete the exchanges posted by the last call to LALInferencePTswapAsync() and apply the swaps.
+ * The buffers are always released; a mismatch in the number of parameters is seen by both
+ * processes of the pair, so neither applies the swap and neither is left waiting. */
+static INT4 complete_PTswapAsync(LALInferenceRunState *runState, FILE *swapfile) {
+    INT4 n_local_threads = runState->nthreads;
+    INT4 errnum = 0;
+
+    if (!PTswapAsync.pending)
+        return XLAL_SUCCESS;
+
+    MPI_Waitall(PTswapAsync.nrequests, PTswapAsync.requests, MPI_STATUSES_IGNORE);
+
+    /* Both processes of a pair now hold the same temperatures, likelihoods and
+     * uniform deviate, and so reach the same decision without further messages */
+    if (PTswapAsync.cold_side) {
+        LALInferenceThreadState *cold_thread = &runState->threads[n_local_threads-1];
+        REAL8 *cold_send = PTswapAsync.cold_send, *cold_recv = PTswapAsync.cold_recv;
+        INT4 swapAccepted;
+        REAL8 logThreadSwap;
+
+        if ((INT4)cold_recv[PT_ASYNC_NPAR] != PTswapAsync.nPar) {
+            XLALPrintError("%s: Chains %i and %i have different numbers of parameters\n", __func__, PTswapAsync.last, PTswapAsync.last+1);
+            errnum = XLAL_EINVAL;
+        } else {
+            logThreadSwap = PTswap_log_ratio(cold_send[PT_ASYNC_TEMPERATURE], cold_send[PT_ASYNC_LIKELIHOOD],
+                                             cold_recv[PT_ASYNC_TEMPERATURE], cold_recv[PT_ASYNC_LIKELIHOOD]);
+            swapAccepted = (logThreadSwap > 0) || (log(cold_send[PT_ASYNC_UNIFORM]) < logThreadSwap);
+
+            cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+            cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+            /* Print to file if verbose is chosen */
+            if (swapfile != NULL) {
+                REAL8 acc_frac = 0.0;
+                for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+                    acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+                fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\n",
+                        cold_thread->step, PTswapAsync.last, cold_send[PT_ASYNC_TEMPERATURE],
+                        PTswapAsync.last+1, cold_recv[PT_ASYNC_TEMPERATURE],
+                        logThreadSwap, cold_send[PT_ASYNC_LIKELIHOOD],
+                        cold_recv[PT_ASYNC_LIKELIHOOD], swapAccepted, acc_frac);
+            }
+
+            if (swapAccepted) {
+                cold_thread->currentLikelihood = cold_recv[PT_ASYNC_LIKELIHOOD];
+                cold_thread->currentPrior = cold_recv[PT_ASYNC_PRIOR];
+                LALInferenceCopyArrayToVariables(&cold_recv[PT_ASYNC_PARAMS], cold_thread->currentParams);
+            }
+        }
+    }
+    if (PTswapAsync.hot_side) {
+        LALInferenceThreadState *hot_thread = &runState->threads[0];
+        REAL8 *hot_send = PTswapAsync.hot_send, *hot_recv = PTswapAsync.hot_recv;
+        INT4 swapAccepted;
+        REAL8 logThreadSwap;
+
+        if ((INT4)hot_recv[PT_ASYNC_NPAR] != PTswapAsync.nPar) {
+            XLALPrintError("%s: Chains %i and %i have different numbers of parameters\n", __func__, PTswapAsync.first-1, PTswapAsync.first);
+            errnum = XLAL_EINVAL;
+        } else {
+            logThreadSwap = PTswap_log_ratio(hot_recv[PT_ASYNC_TEMPERATURE], hot_recv[PT_ASYNC_LIKELIHOOD],
+                                             hot_send[PT_ASYNC_TEMPERATURE], hot_send[PT_ASYNC_LIKELIHOOD]);
+            swapAccepted = (logThreadSwap > 0) || (log(hot_recv[PT_ASYNC_UNIFORM]) < logThreadSwap);
+
+            if (swapAccepted) {
+                hot_thread->currentLikelihood = hot_recv[PT_ASYNC_LIKELIHOOD];
+                hot_thread->currentPrior = hot_recv[PT_ASYNC_PRIOR];
+                LALInferenceCopyArrayToVariables(&hot_recv[PT_ASYNC_PARAMS], hot_thread->currentParams);
+            }
+        }
+    }
+
+    XLALFree(PTswapAsync.cold_send);
+    XLALFree(PTswapAsync.cold_recv);
+    XLALFree(PTswapAsync.hot_send);
+    XLALFree(PTswapAsync.hot_recv);
+    PTswapAsync.cold_send = PTswapAsync.cold_recv = NULL;
+    PTswapAsync.hot_send = PTswapAsync.hot_recv = NULL;
+    PTswapAsync.cold_side = PTswapAsync.hot_side = 0;
+    PTswapAsync.nrequests = 0;
+    PTswapAsync.pending = 0;
+    PTswapAsync.hold = 0;
+
+    if (errnum)
+        XLAL_ERROR(errnum);
+
+    return XLAL_SUCCESS;
+}
+
+void LALInferencePTswapAsync(LALInferenceRunState *runState, FILE *swapfile) {
+    static INT4 cycle = 0;
+    INT4 MPIrank, MPIsize;
+    INT4 n_local_threads, ntemps;
+    INT4 first, last, parity, t;
+    INT4 nPar, msgLen;
+    INT4 errnum = 0;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+
+    n_local_threads = runState->nthreads;
+    ntemps = MPIsize*n_local_threads;
+
+    /* Return if running with only a single temperature */
+    if (ntemps == 1)
+        return;
+
+    /* Complete the exchanges posted on the previous cycle; the held chains have not moved since */
+    if (complete_PTswapAsync(runState, swapfile) != XLAL_SUCCESS)
+        errnum = xlalErrno;
+
+    /* Alternate between the even pairs (0,1), (2,3), ... and the odd pairs (1,2), (3,4), ... of the ladder */
+    parity = cycle % 2;
+    cycle++;
+
+    /* Ladder indices of the coldest and hottest chains of this process */
+    first = MPIrank*n_local_threads;
+    last = first + n_local_threads - 1;
+
+    nPar = LALInferenceGetVariableDimensionNonFixed(runState->threads[0].currentParams);
+    msgLen = PT_ASYNC_PARAMS + nPar;
+
+    PTswapAsync.first = first;
+    PTswapAsync.last = last;
+    PTswapAsync.nPar = nPar;
+    PTswapAsync.cold_side = (MPIrank < MPIsize-1) && (last % 2 == parity);
+    PTswapAsync.hot_side = (MPIrank > 0) && ((first-1) % 2 == parity);
+
+    /* Post the exchange of states with the neighbouring processes */
+    if (PTswapAsync.cold_side) {
+        PTswapAsync.cold_send = XLALMalloc(msgLen * sizeof(REAL8));
+        PTswapAsync.cold_recv = XLALMalloc(msgLen * sizeof(REAL8));
+        pack_PTswap_message(&runState->threads[n_local_threads-1], gsl_rng_uniform(runState->GSLrandom), nPar, PTswapAsync.cold_send);
+        MPI_Irecv(PTswapAsync.cold_recv, msgLen, MPI_DOUBLE, MPIrank+1, PT_COM, MPI_COMM_WORLD, &PTswapAsync.requests[PTswapAsync.nrequests++]);
+        MPI_Isend(PTswapAsync.cold_send, msgLen, MPI_DOUBLE, MPIrank+1, PT_COM, MPI_COMM_WORLD, &PTswapAsync.requests[PTswapAsync.nrequests++]);
+    }
+    if (PTswapAsync.hot_side) {
+        PTswapAsync.hot_send = XLALMalloc(msgLen * sizeof(REAL8));
+        PTswapAsync.hot_recv = XLALMalloc(msgLen * sizeof(REAL8));
+        pack_PTswap_message(&runState->threads[0], 0.0, nPar, PTswapAsync.hot_send);
+        MPI_Irecv(PTswapAsync.hot_recv, msgLen, MPI_DOUBLE, MPIrank-1, PT_COM, MPI_COMM_WORLD, &PTswapAsync.requests[PTswapAsync.nrequests++]);
+        MPI_Isend(PTswapAsync.hot_send, msgLen, MPI_DOUBLE, MPIrank-1, PT_COM, MPI_COMM_WORLD, &PTswapAsync.requests[PTswapAsync.nrequests++]);
+    }
+    PTswapAsync.pending = (PTswapAsync.nrequests > 0);
+
+    /* Swap chains within this process; none of these swaps involves a chain whose state has been sent */
+    for (t = 0; t < n_local_threads-1; t++) {
+        if ((first + t) % 2 == parity)
+            local_PTswap(runState, &runState->threads[t], &runState->threads[t+1], first+t, first+t+1, swapfile);
+    }
+
+    /* Hold the chains in flight over the next cycle while the other chains of this process are
+     * stepped.  If that would hold every chain of this process, as with one chain per process,
+     * the exchanges are instead left in flight until LALInferenceCompletePTswapAsync() is called
+     * before the next steps, overlapping the ladder adaptation and convergence checks. */
+    PTswapAsync.hold = PTswapAsync.pending && (PTswapAsync.cold_side + PTswapAsync.hot_side < n_local_threads);
+
+    if (errnum)
+        XLAL_ERROR_VOID(errnum);
+
+    return;
+}
+
+INT4 LALInferencePTswapAsyncHolds(LALInferenceRunState *runState, INT4 t) {
+    if (!PTswapAsync.pending || !PTswapAsync.hold)
+        return 0;
+
+    return (PTswapAsync.cold_side && t == runState->nthreads-1) || (PTswapAsync.hot_side && t == 0);
+}
+
+INT4 LALInferenceCompletePTswapAsync(LALInferenceRunState *runState, FILE *swapfile) {
+    if (PTswapAsync.hold)
+        return XLAL_SUCCESS;
+
+    if (complete_PTswapAsync(runState, swapfile) != XLAL_SUCCESS)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+INT4 LALInferenceFlushPTswapAsync(LALInferenceRunState *runState, FILE *swapfile) {
+    if (complete_PTswapAsync(runState, swapfile) != XLAL_SUCCESS)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
 
 // UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile) {
 //     INT4 MPIrank;
@@ -60,9 +60,31 @@ typedef enum {
 /* Temperature ladder adaptation */
 void LALInferenceAdaptLadder(LALInferenceRunState *runState);
 
+/* Temperature ladder adaptation with non-blocking collectives, each completed on the following cycle */
+void LALInferenceAdaptLadderAsync(LALInferenceRunState *runState);
+
+/* Complete the collectives of LALInferenceAdaptLadderAsync() and apply the resulting ladder */
+void LALInferenceFlushAdaptLadderAsync(LALInferenceRunState *runState);
+
 /* Standard parallel temperature swap proposal function */
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile);
 
+/* Parallel temperature swap proposal function which only exchanges states between neighbouring
+   processes, with a single non-blocking message each way, on alternating even and odd pairs of the ladder.
+   If the process has other chains to step, the chains involved are held and the exchanges are completed
+   on the following call; otherwise they are completed by LALInferenceCompletePTswapAsync() */
+void LALInferencePTswapAsync(LALInferenceRunState *runState, FILE *swapfile);
+
+/* Non-zero if local chain t is held while its state is exchanged by LALInferencePTswapAsync() */
+INT4 LALInferencePTswapAsyncHolds(LALInferenceRunState *runState, INT4 t);
+
+/* Complete the exchanges posted by the last call to LALInferencePTswapAsync() which do not hold
+   chains; to be called before the chains are stepped */
+INT4 LALInferenceCompletePTswapAsync(LALInferenceRunState *runState, FILE *swapfile);
+
+/* Complete all exchanges posted by the last call to LALInferencePTswapAsync() */
+INT4 LALInferenceFlushPTswapAsync(LALInferenceRunState *runState, FILE *swapfile);
+
 /* Metropolis-coupled MCMC swap proposal, when the likelihood is not identical between chains */
 //UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile);
 
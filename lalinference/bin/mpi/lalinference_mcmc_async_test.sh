@@ -0,0 +1,43 @@
+## smoke test of lalinference_mcmc with --async-swaps on 2 to 4 processes;
+## with two chains per process, so that both local and inter-process swaps
+## are made while the chains in flight are held, and with one chain per
+## process, where every swap is an inter-process exchange and nothing is held
+
+if ! command -v mpirun >/dev/null 2>&1; then
+    echo "mpirun not found, skipping test"
+    exit 77
+fi
+
+export OMP_NUM_THREADS=1
+
+## Open MPI refuses to start more processes than there are cores
+mpirun="mpirun"
+if mpirun --version 2>&1 | grep -q "Open MPI"; then
+    mpirun="mpirun --oversubscribe"
+fi
+
+for nper in 2 1; do
+for np in 2 3 4; do
+    outfile="async_test_${np}_${nper}.h5"
+    rm -f ${outfile}*
+
+    cmdline="${mpirun} -np ${np} ./lalinference_mcmc --correlatedGaussianLikelihood --approx SpinTaylorT4 \
+--ifo H1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --dataseed 1234 \
+--psdlength 32 --psdstart 0 --seglen 4 --srate 512 --trigtime 40 --H1-flow 20 \
+--async-swaps --adapt-temps --ntemps $(( nper * np )) --temp-skip 10 --nsteps 500 --skip 10 \
+--randomseed 1234 --outfile ${outfile}"
+    echo ${cmdline}
+    if ! eval timeout 600 ${cmdline}; then
+        echo "Error.. lalinference_mcmc --async-swaps failed on ${np} processes with ${nper} chains each"
+        exit 1
+    fi
+
+    for f in ${outfile} $(i=1; while [ $i -lt ${np} ]; do printf "${outfile}.%2.2d " $i; i=$(( i + 1 )); done); do
+        if [ ! -s ${f} ]; then
+            echo "Error.. lalinference_mcmc --async-swaps on ${np} processes with ${nper} chains each did not write ${f}"
+            exit 1
+        fi
+    done
+    echo "OK."
+done
+done
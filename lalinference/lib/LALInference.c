@@ -24,6 +24,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <lal/LALInference.h>
 #include <lal/Units.h>
@@ -4422,6 +4423,202 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
   }
 }
 
+/* Builds the basis for nFreqs frequencies, given either by freqs (if non-NULL) or by i*deltaF.
+ * The cubic coefficients of each spline interval are taken from the GSL splines through the
+ * unit vectors e_j, in the form used by GSL, so that the basis is consistent with the GSL
+ * spline evaluation; each in-range frequency only stores its interval and offset. */
+static LALInferenceSplineCalibrationBasis *create_spline_calibration_basis(REAL8Vector *logfreqs, REAL8 deltaF, UINT4 nFreqs, const REAL8 *freqs) {
+  LALInferenceSplineCalibrationBasis *basis = NULL;
+  gsl_interp_accel *acc = NULL;
+  gsl_interp *interp = NULL;
+  REAL8 *unit = NULL, *logf = NULL;
+
+  XLAL_CHECK_NULL(logfreqs != NULL && logfreqs->length >= gsl_interp_type_min_size(gsl_interp_cspline), XLAL_EINVAL, "need at least %u spline nodes", gsl_interp_type_min_size(gsl_interp_cspline));
+
+  const UINT4 N = logfreqs->length;
+
+  basis = XLALCalloc(1, sizeof(*basis));
+  XLAL_CHECK_NULL(basis != NULL, XLAL_ENOMEM);
+  basis->nNodes = N;
+  basis->nFreqs = nFreqs;
+  basis->deltaF = (freqs == NULL) ? deltaF : 0.0;
+  basis->logfreqs = XLALMalloc(N*sizeof(REAL8));
+  basis->index = XLALMalloc((nFreqs > 0 ? nFreqs : 1)*sizeof(UINT4));
+  logf = XLALMalloc((nFreqs > 0 ? nFreqs : 1)*sizeof(REAL8));
+  unit = XLALCalloc(N, sizeof(REAL8));
+  if (basis->logfreqs == NULL || basis->index == NULL || logf == NULL || unit == NULL) {
+    XLALPrintError("%s: could not allocate memory\n", __func__);
+    goto error;
+  }
+  memcpy(basis->logfreqs, logfreqs->data, N*sizeof(REAL8));
+  if (freqs != NULL) {
+    basis->freqs = XLALMalloc((nFreqs > 0 ? nFreqs : 1)*sizeof(REAL8));
+    if (basis->freqs == NULL) {
+      XLALPrintError("%s: could not allocate memory\n", __func__);
+      goto error;
+    }
+    memcpy(basis->freqs, freqs, nFreqs*sizeof(REAL8));
+  }
+
+  /* Find the frequencies inside the range of the spline nodes */
+  REAL8 lowf = exp(logfreqs->data[0]);
+  REAL8 highf = exp(logfreqs->data[N-1]);
+  basis->nRows = 0;
+  for (UINT4 i = 0; i < nFreqs; i++) {
+    REAL8 f = (freqs != NULL) ? freqs[i] : deltaF*i;
+    if (f >= lowf && f <= highf) {
+      basis->index[basis->nRows] = i;
+      logf[basis->nRows] = log(f);
+      basis->nRows++;
+    }
+  }
+
+  basis->interval = XLALMalloc((basis->nRows > 0 ? basis->nRows : 1)*sizeof(UINT4));
+  basis->offset = XLALMalloc((basis->nRows > 0 ? basis->nRows : 1)*sizeof(REAL8));
+  basis->coeffs = XLALMalloc(4*(N-1)*N*sizeof(REAL8));
+  interp = gsl_interp_alloc(gsl_interp_cspline, N);
+  acc = gsl_interp_accel_alloc();
+  if (basis->interval == NULL || basis->offset == NULL || basis->coeffs == NULL || interp == NULL || acc == NULL) {
+    XLALPrintError("%s: could not allocate memory\n", __func__);
+    goto error;
+  }
+
+  /* On interval m the spline is y_m + t*(b_m + t*(c_m + t*d_m)), with t the offset from node m;
+   * b_m and c_m follow from the derivatives at node m, and d_m from the second derivative at
+   * node m+1, which is continuous */
+  for (UINT4 j = 0; j < N; j++) {
+    unit[j] = 1.0;
+    gsl_interp_init(interp, logfreqs->data, unit, N);
+    gsl_interp_accel_reset(acc);
+    for (UINT4 m = 0; m < N-1; m++) {
+      REAL8 *c = basis->coeffs + 4*m*N + j;
+      const REAL8 h = logfreqs->data[m+1] - logfreqs->data[m];
+      const REAL8 c2 = 0.5*gsl_interp_eval_deriv2(interp, logfreqs->data, unit, logfreqs->data[m], acc);
+      const REAL8 c2next = 0.5*gsl_interp_eval_deriv2(interp, logfreqs->data, unit, logfreqs->data[m+1], acc);
+      c[0] = unit[m];
+      c[N] = gsl_interp_eval_deriv(interp, logfreqs->data, unit, logfreqs->data[m], acc);
+      c[2*N] = c2;
+      c[3*N] = (c2next - c2)/(3.0*h);
+    }
+    unit[j] = 0.0;
+  }
+
+  /* Interval of each in-range frequency, chosen as by GSL */
+  gsl_interp_accel_reset(acc);
+  for (UINT4 r = 0; r < basis->nRows; r++) {
+    UINT4 m = gsl_interp_accel_find(acc, logfreqs->data, N, logf[r]);
+    if (m > N-2) m = N-2;
+    basis->interval[r] = m;
+    basis->offset[r] = logf[r] - logfreqs->data[m];
+  }
+
+  gsl_interp_free(interp);
+  gsl_interp_accel_free(acc);
+  XLALFree(unit);
+  XLALFree(logf);
+  return basis;
+
+ error:
+  if (interp != NULL) gsl_interp_free(interp);
+  if (acc != NULL) gsl_interp_accel_free(acc);
+  XLALFree(unit);
+  XLALFree(logf);
+  LALInferenceDestroySplineCalibrationBasis(basis);
+  XLAL_ERROR_NULL(XLAL_ENOMEM);
+}
+
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasis(REAL8Vector *logfreqs,
+					REAL8 deltaF,
+					UINT4 nFreqs) {
+  XLAL_CHECK_NULL(deltaF > 0.0, XLAL_EINVAL, "deltaF must be positive");
+  LALInferenceSplineCalibrationBasis *basis = create_spline_calibration_basis(logfreqs, deltaF, nFreqs, NULL);
+  XLAL_CHECK_NULL(basis != NULL, XLAL_EFUNC);
+  return basis;
+}
+
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasisFromFrequencies(REAL8Vector *logfreqs,
+					REAL8Sequence *freqs) {
+  XLAL_CHECK_NULL(freqs != NULL, XLAL_EFAULT);
+  LALInferenceSplineCalibrationBasis *basis = create_spline_calibration_basis(logfreqs, 0.0, freqs->length, freqs->data);
+  XLAL_CHECK_NULL(basis != NULL, XLAL_EFUNC);
+  return basis;
+}
+
+void LALInferenceDestroySplineCalibrationBasis(LALInferenceSplineCalibrationBasis *basis) {
+  if (basis == NULL) return;
+  XLALFree(basis->logfreqs);
+  XLALFree(basis->freqs);
+  XLALFree(basis->index);
+  XLALFree(basis->interval);
+  XLALFree(basis->offset);
+  XLALFree(basis->coeffs);
+  XLALFree(basis);
+}
+
+void LALInferenceModelClearSplineCalibrationBases(LALInferenceModel *model) {
+  if (model == NULL) return;
+  for (UINT4 k = 0; k < model->nSpcalBasis; k++) {
+    LALInferenceDestroySplineCalibrationBasis(model->spcalBasis[k]);
+  }
+  XLALFree(model->spcalBasis);
+  model->spcalBasis = NULL;
+  model->nSpcalBasis = 0;
+}
+
+int LALInferenceSplineCalibrationBasisMatches(const LALInferenceSplineCalibrationBasis *basis,
+					REAL8Vector *logfreqs,
+					REAL8 deltaF,
+					UINT4 nFreqs,
+					REAL8Sequence *freqs) {
+  if (basis == NULL || logfreqs == NULL) return 0;
+  if (basis->nNodes != logfreqs->length || memcmp(basis->logfreqs, logfreqs->data, logfreqs->length*sizeof(REAL8)) != 0) return 0;
+  if (freqs != NULL) {
+    return basis->freqs != NULL && basis->nFreqs == freqs->length && memcmp(basis->freqs, freqs->data, freqs->length*sizeof(REAL8)) == 0;
+  }
+  return basis->freqs == NULL && basis->nFreqs == nFreqs && basis->deltaF == deltaF;
+}
+
+int LALInferenceSplineCalibrationFactorFromBasis(const LALInferenceSplineCalibrationBasis *basis,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					COMPLEX16 *calFactor) {
+  XLAL_CHECK(basis != NULL && deltaAmps != NULL && deltaPhases != NULL && calFactor != NULL, XLAL_EINVAL, "bad input");
+  XLAL_CHECK(deltaAmps->length == basis->nNodes && deltaPhases->length == basis->nNodes, XLAL_EINVAL, "input lengths differ");
+
+  const UINT4 N = basis->nNodes;
+  const REAL8 *amps = deltaAmps->data;
+  const REAL8 *phases = deltaPhases->data;
+  REAL8 a[4] = {0.0, 0.0, 0.0, 0.0}, p[4] = {0.0, 0.0, 0.0, 0.0};
+  UINT4 m = N;
+
+  /* Outside the range of the spline nodes dA = dPhi = 0 */
+  for (UINT4 i = 0; i < basis->nFreqs; i++) {
+    calFactor[i] = 1.0;
+  }
+
+  for (UINT4 r = 0; r < basis->nRows; r++) {
+    /* Cubic coefficients of the amplitude and phase splines on this interval; frequencies
+     * are usually sorted, so these are computed about once per interval */
+    if (basis->interval[r] != m) {
+      m = basis->interval[r];
+      for (UINT4 k = 0; k < 4; k++) {
+        const REAL8 *c = basis->coeffs + (4*m + k)*N;
+        a[k] = p[k] = 0.0;
+        for (UINT4 j = 0; j < N; j++) {
+          a[k] += c[j]*amps[j];
+          p[k] += c[j]*phases[j];
+        }
+      }
+    }
+    const REAL8 t = basis->offset[r];
+    const REAL8 dA = a[0] + t*(a[1] + t*(a[2] + t*a[3]));
+    const REAL8 dPhi = p[0] + t*(p[1] + t*(p[2] + t*p[3]));
+    calFactor[basis->index[r]] = (1.0 + dA)*(2.0 + I*dPhi)/(2.0 - I*dPhi);
+  }
+
+  return XLAL_SUCCESS;
+}
+
 void LALInferenceFprintSplineCalibrationHeader(FILE *output, LALInferenceThreadState *thread) {
     INT4 i, nifo;
     char **ifo_names = NULL;
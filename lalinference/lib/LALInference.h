@@ -372,6 +372,58 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
 					REAL8Sequence *freqNodesQuad,
 					COMPLEX16Sequence **calFactorROQQuad);
 
+/**
+ * Precomputed basis for the spline calibration model of
+ * LALInferenceSplineCalibrationFactor().  The cubic spline through the node
+ * values is linear in those values, so for fixed node frequencies the cubic
+ * coefficients of each interval between nodes are a matrix-vector product of
+ * a coefficient matrix with the amplitude and phase node values; each
+ * evaluation frequency then only needs its interval and offset.
+ */
+typedef struct tagLALInferenceSplineCalibrationBasis
+{
+  UINT4 nNodes;      /** Number of spline nodes */
+  REAL8 *logfreqs;   /** Log-frequencies of the spline nodes */
+  UINT4 nFreqs;      /** Number of frequencies at which the calibration factor is evaluated */
+  REAL8 deltaF;      /** Spacing of the frequencies \f$f_i = i \, \delta f\f$, or 0 if they are given by \c freqs */
+  REAL8 *freqs;      /** Frequencies at which the calibration factor is evaluated, or NULL if uniformly spaced */
+  UINT4 nRows;       /** Number of frequencies inside the range of the spline nodes */
+  UINT4 *index;      /** Indices of the frequencies inside the range of the spline nodes */
+  UINT4 *interval;   /** Spline interval of each frequency inside the range of the spline nodes */
+  REAL8 *offset;     /** Log-frequency offset of each frequency inside the range of the spline nodes from the lower node of its interval */
+  REAL8 *coeffs;     /** \c 4*(nNodes-1) by \c nNodes matrix giving the cubic coefficients of each interval from the node values, in row-major order */
+} LALInferenceSplineCalibrationBasis;
+
+/** Build the spline calibration basis for the frequencies
+    \f$f_i = i \, \delta f\f$, \f$0 \le i < n\f$, of a frequency series. */
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasis(REAL8Vector *logfreqs,
+					REAL8 deltaF,
+					UINT4 nFreqs);
+
+/** Build the spline calibration basis for an arbitrary set of
+    frequencies, e.g.\ the frequency nodes of a ROQ likelihood. */
+LALInferenceSplineCalibrationBasis *LALInferenceCreateSplineCalibrationBasisFromFrequencies(REAL8Vector *logfreqs,
+					REAL8Sequence *freqs);
+
+void LALInferenceDestroySplineCalibrationBasis(LALInferenceSplineCalibrationBasis *basis);
+
+/** Returns true if \c basis was built for the spline nodes \c logfreqs and
+    the given frequencies (\c deltaF and \c nFreqs, or \c freqs if non-NULL). */
+int LALInferenceSplineCalibrationBasisMatches(const LALInferenceSplineCalibrationBasis *basis,
+					REAL8Vector *logfreqs,
+					REAL8 deltaF,
+					UINT4 nFreqs,
+					REAL8Sequence *freqs);
+
+/** Equivalent to LALInferenceSplineCalibrationFactor() (up to rounding
+    errors), but evaluates the spline calibration curve at the \c
+    basis->nFreqs frequencies of a precomputed basis; \c calFactor must hold
+    \c basis->nFreqs elements. */
+int LALInferenceSplineCalibrationFactorFromBasis(const LALInferenceSplineCalibrationBasis *basis,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					COMPLEX16 *calFactor);
+
 
 //Wrapper for template computation
 //(relies on LAL libraries for implementation) <- could be a #DEFINE ?
@@ -472,9 +524,14 @@ typedef struct tagLALInferenceModel
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
+  UINT4                        nSpcalBasis; /** Number of elements of \c spcalBasis */
+  LALInferenceSplineCalibrationBasis **spcalBasis; /** Spline calibration bases for each detector, built on first use by the likelihood */
 
 } LALInferenceModel;
 
+/** Free the spline calibration bases cached in \c model by the likelihood. */
+void LALInferenceModelClearSplineCalibrationBases(LALInferenceModel *model);
+
 
 /**
  * Type declaration for variables init function, can be user-declared.
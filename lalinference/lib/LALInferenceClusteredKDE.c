@@ -1232,6 +1232,14 @@ void LALInferenceKmeansBuildKDE(LALInferenceKmeans *kmeans) {
     for (i = 0; i < kmeans->k; i++) {
         LALInferenceKmeansConstructMask(kmeans, kmeans->mask, i);
         kmeans->KDEs[i] = LALInferenceNewKDEfromMat(kmeans->data, kmeans->mask);
+
+        /* Large clusters are evaluated through a kd-tree.  If the tree can't
+         * be built the exact kernel sum is used instead. */
+        if (kmeans->KDEs[i] && kmeans->KDEs[i]->npts >= LALINFERENCE_KDE_TREE_MIN_PTS &&
+            isfinite(kmeans->KDEs[i]->log_norm_factor)) {
+            if (LALInferenceKDEBuildTree(kmeans->KDEs[i], LALINFERENCE_KDE_TREE_RTOL) != XLAL_SUCCESS)
+                XLALClearErrno();
+        }
     }
 }
 
@@ -1665,6 +1665,675 @@ REAL8 LALInferenceEnrichCOMPLEX16Basis(const REAL8Vector *delta,
 }
 
 
+/* default number of training set rows read (or viewed) in one go by the blocked basis generation */
+#define ROQ_DEFAULT_BLOCK_ROWS 1024
+
+/* number of training set rows in each tile handed to a single thread */
+#define ROQ_TILE_ROWS 32
+
+/* internal functions for the blocked basis generation */
+static const REAL8 *roq_training_set_rows(LALInferenceROQTrainingSet *TS, size_t firstrow, size_t nrows, REAL8 *buf);
+static void roq_weight_vector(REAL8 *out, const REAL8 *in, const REAL8Vector *delta, size_t cols, UINT4 iscomplex);
+static void roq_block_scales(const REAL8 *T, size_t nrows, size_t cols, UINT4 iscomplex, const REAL8Vector *delta, REAL8 *scale, REAL8 *resid);
+static int roq_project_block(const REAL8 *T, size_t nrows, size_t cols, UINT4 iscomplex, const REAL8 *WB, size_t nb, const REAL8 *scale, REAL8 *resid);
+static int roq_project_training_set(LALInferenceROQTrainingSet *TS, const REAL8 *WB, size_t nb, const REAL8 *scale, REAL8 *resid, size_t blocksize, REAL8 *buf);
+static REAL8 roq_generate_basis_blocked(REAL8 **RBdata, size_t *nRB, const REAL8Vector *delta, REAL8 tolerance, LALInferenceROQTrainingSet *TS, UINT4Vector **greedypoints, size_t blocksize);
+
+
+/**
+ * \brief Provide an in-memory real training set to the blocked basis generation functions
+ *
+ * The training set is not copied (so must remain valid while the returned structure is in use)
+ * and, unlike in \c LALInferenceGenerateREAL8OrthonormalBasis, it will not be modified.
+ *
+ * @param[in] TS A \c REAL8Array matrix containing the training set, where the number of waveforms
+ * is given by the rows and the waveform points by the columns.
+ *
+ * @return A \c LALInferenceROQTrainingSet structure (to be freed with \c LALInferenceRemoveROQTrainingSet)
+ */
+LALInferenceROQTrainingSet *LALInferenceCreateREAL8ROQTrainingSet(const REAL8Array *TS){
+  XLAL_CHECK_NULL( TS != NULL, XLAL_EFAULT, "Training set array is NULL!" );
+  XLAL_CHECK_NULL( TS->dimLength->length == 2, XLAL_EINVAL, "Training set array must have only two dimensions" );
+
+  LALInferenceROQTrainingSet *ts = XLALCalloc(1, sizeof(LALInferenceROQTrainingSet));
+  XLAL_CHECK_NULL( ts != NULL, XLAL_ENOMEM );
+
+  ts->rows = TS->dimLength->data[0];
+  ts->cols = TS->dimLength->data[1];
+  ts->iscomplex = 0;
+  ts->data = TS->data;
+  ts->fp = NULL;
+
+  return ts;
+}
+
+
+/**
+ * \brief Provide an in-memory complex training set to the blocked basis generation functions
+ *
+ * The training set is not copied (so must remain valid while the returned structure is in use)
+ * and, unlike in \c LALInferenceGenerateCOMPLEX16OrthonormalBasis, it will not be modified.
+ *
+ * @param[in] TS A \c COMPLEX16Array matrix containing the training set, where the number of
+ * waveforms is given by the rows and the waveform points by the columns.
+ *
+ * @return A \c LALInferenceROQTrainingSet structure (to be freed with \c LALInferenceRemoveROQTrainingSet)
+ */
+LALInferenceROQTrainingSet *LALInferenceCreateCOMPLEX16ROQTrainingSet(const COMPLEX16Array *TS){
+  XLAL_CHECK_NULL( TS != NULL, XLAL_EFAULT, "Training set array is NULL!" );
+  XLAL_CHECK_NULL( TS->dimLength->length == 2, XLAL_EINVAL, "Training set array must have only two dimensions" );
+
+  LALInferenceROQTrainingSet *ts = XLALCalloc(1, sizeof(LALInferenceROQTrainingSet));
+  XLAL_CHECK_NULL( ts != NULL, XLAL_ENOMEM );
+
+  ts->rows = TS->dimLength->data[0];
+  ts->cols = TS->dimLength->data[1];
+  ts->iscomplex = 1;
+  ts->data = (REAL8 *)TS->data;
+  ts->fp = NULL;
+
+  return ts;
+}
+
+
+/**
+ * \brief Stream a training set from a binary file to the blocked basis generation functions
+ *
+ * The file must contain the training set waveforms as consecutive rows of native-endian
+ * double precision values (with real and imaginary parts interleaved for complex waveforms),
+ * i.e. the same memory layout as the \c data of a \c REAL8Array or \c COMPLEX16Array. Only
+ * a block of rows is read into memory at any one time.
+ *
+ * @param[in] filename The name of the file containing the training set
+ * @param[in] rows The number of waveforms in the file (if zero this will be set from the file size)
+ * @param[in] cols The number of points in each waveform
+ * @param[in] iscomplex Set if the waveforms are complex
+ *
+ * @return A \c LALInferenceROQTrainingSet structure (to be freed with \c LALInferenceRemoveROQTrainingSet)
+ */
+LALInferenceROQTrainingSet *LALInferenceOpenROQTrainingSetFile(const char *filename,
+                                                               size_t rows,
+                                                               size_t cols,
+                                                               UINT4 iscomplex){
+  XLAL_CHECK_NULL( filename != NULL, XLAL_EFAULT, "Training set file name is NULL!" );
+  XLAL_CHECK_NULL( cols > 0, XLAL_EINVAL, "Training set waveforms must have a non-zero length" );
+
+  size_t rowbytes = cols * (iscomplex ? 2 : 1) * sizeof(REAL8);
+
+  FILE *fp = fopen(filename, "rb");
+  XLAL_CHECK_NULL( fp != NULL, XLAL_EIO, "Could not open training set file '%s'", filename );
+
+  /* check the file size is consistent with the given dimensions */
+  if ( fseek(fp, 0, SEEK_END) != 0 ){
+    fclose(fp);
+    XLAL_ERROR_NULL( XLAL_EIO, "Could not seek in training set file '%s'", filename );
+  }
+  long nbytes = ftell(fp);
+  rewind(fp);
+
+  if ( nbytes < 0 || (size_t)nbytes % rowbytes != 0 ){
+    fclose(fp);
+    XLAL_ERROR_NULL( XLAL_EIO, "Size of training set file '%s' is not a multiple of the waveform length", filename );
+  }
+  if ( rows == 0 ){ rows = (size_t)nbytes / rowbytes; }
+  if ( rows == 0 || rows > (size_t)nbytes / rowbytes ){
+    fclose(fp);
+    XLAL_ERROR_NULL( XLAL_EIO, "Training set file '%s' does not contain the expected number of waveforms", filename );
+  }
+
+  LALInferenceROQTrainingSet *ts = XLALCalloc(1, sizeof(LALInferenceROQTrainingSet));
+  if ( ts == NULL ){
+    fclose(fp);
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+
+  ts->rows = rows;
+  ts->cols = cols;
+  ts->iscomplex = iscomplex ? 1 : 0;
+  ts->data = NULL;
+  ts->fp = fp;
+
+  return ts;
+}
+
+
+/** \brief Free a training set structure (closing any file that it is streamed from)
+ *
+ * @param[in] TS The training set structure
+ */
+void LALInferenceRemoveROQTrainingSet(LALInferenceROQTrainingSet *TS){
+  if ( TS == NULL ){ return; }
+
+  if ( TS->fp != NULL ){ fclose(TS->fp); }
+
+  XLALFree( TS );
+}
+
+
+/** \brief Get a block of rows of a training set
+ *
+ * For an in-memory training set this returns a pointer into the training set itself,
+ * otherwise the rows are read from file into \c buf.
+ *
+ * @param[in] TS The training set
+ * @param[in] firstrow The first row required
+ * @param[in] nrows The number of rows required
+ * @param[in] buf A buffer of at least \c nrows rows into which to read from file
+ *
+ * @return A pointer to the start of the block of rows
+ */
+static const REAL8 *roq_training_set_rows(LALInferenceROQTrainingSet *TS, size_t firstrow, size_t nrows, REAL8 *buf){
+  size_t rowlen = TS->cols * (TS->iscomplex ? 2 : 1);
+
+  if ( TS->data != NULL ){ return TS->data + firstrow*rowlen; }
+
+  XLAL_CHECK_NULL( fseek(TS->fp, (long)(firstrow*rowlen*sizeof(REAL8)), SEEK_SET) == 0, XLAL_EIO, "Could not seek to row %zu of training set file", firstrow );
+  XLAL_CHECK_NULL( fread(buf, sizeof(REAL8), nrows*rowlen, TS->fp) == nrows*rowlen, XLAL_EIO, "Could not read rows %zu-%zu of training set file", firstrow, firstrow + nrows - 1 );
+
+  return buf;
+}
+
+
+/** \brief Multiply a (real or complex) vector by the inner product weight(s)
+ *
+ * @param[out] out The weighted vector
+ * @param[in] in The vector to weight
+ * @param[in] delta The weight(s), either a single value or one per vector element
+ * @param[in] cols The number of (real or complex) vector elements
+ * @param[in] iscomplex Set if the vectors are complex
+ */
+static void roq_weight_vector(REAL8 *out, const REAL8 *in, const REAL8Vector *delta, size_t cols, UINT4 iscomplex){
+  for ( size_t k = 0; k < cols; k++ ){
+    REAL8 w = ( delta->length == 1 ) ? delta->data[0] : delta->data[k];
+
+    if ( iscomplex ){
+      out[2*k] = w*in[2*k];
+      out[2*k+1] = w*in[2*k+1];
+    }
+    else{ out[k] = w*in[k]; }
+  }
+}
+
+
+/** \brief Get the scale factors that normalise a block of training set rows
+ *
+ * Rows with zero norm are given a scale factor of zero, and a residual of zero, so that they will
+ * never be selected for the basis.
+ *
+ * @param[in] T The block of training set rows
+ * @param[in] nrows The number of rows in the block
+ * @param[in] cols The number of (real or complex) points in each row
+ * @param[in] iscomplex Set if the rows are complex
+ * @param[in] delta The inner product weight(s)
+ * @param[out] scale The inverse norm of each row
+ * @param[out] resid The squared residual of each normalised row with an empty basis
+ */
+static void roq_block_scales(const REAL8 *T, size_t nrows, size_t cols, UINT4 iscomplex, const REAL8Vector *delta, REAL8 *scale, REAL8 *resid){
+  size_t rowlen = cols * (iscomplex ? 2 : 1);
+
+#pragma omp parallel for schedule(static)
+  for ( size_t i = 0; i < nrows; i++ ){
+    const REAL8 *row = T + i*rowlen;
+    REAL8 nrm2 = 0.;
+
+    for ( size_t k = 0; k < cols; k++ ){
+      REAL8 w = ( delta->length == 1 ) ? delta->data[0] : delta->data[k];
+
+      if ( iscomplex ){ nrm2 += w*(row[2*k]*row[2*k] + row[2*k+1]*row[2*k+1]); }
+      else{ nrm2 += w*row[k]*row[k]; }
+    }
+
+    scale[i] = ( nrm2 > 0. ) ? 1./sqrt(nrm2) : 0.;
+    resid[i] = ( nrm2 > 0. ) ? 1. : 0.;
+  }
+}
+
+
+/** \brief Remove the projections of a block of training set rows onto a set of basis vectors
+ *
+ * The block is split into tiles of \c ROQ_TILE_ROWS rows that are shared between threads, and
+ * for each tile the projections onto all \c nb basis vectors are computed with a single matrix
+ * product. The squared projections of each (normalised) row are subtracted from its squared
+ * residual, so that small residuals do not lose precision against a sum close to one.
+ *
+ * @param[in] T The block of training set rows
+ * @param[in] nrows The number of rows in the block
+ * @param[in] cols The number of (real or complex) points in each row
+ * @param[in] iscomplex Set if the rows are complex
+ * @param[in] WB The \c nb basis vectors multiplied by the inner product weights
+ * @param[in] nb The number of basis vectors
+ * @param[in] scale The inverse norm of each row
+ * @param[in,out] resid The squared residual of each normalised row
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if a thread could not allocate its buffer
+ */
+static int roq_project_block(const REAL8 *T, size_t nrows, size_t cols, UINT4 iscomplex, const REAL8 *WB, size_t nb, const REAL8 *scale, REAL8 *resid){
+  size_t ntiles = (nrows + ROQ_TILE_ROWS - 1) / ROQ_TILE_ROWS;
+  int failed = 0;
+
+#pragma omp parallel
+  {
+    /* products of a whole tile with the basis, allocated once per thread */
+    REAL8 *P = XLALMalloc(ROQ_TILE_ROWS*nb*(iscomplex ? 2 : 1)*sizeof(REAL8));
+    if ( P == NULL ){
+#pragma omp critical
+      failed = 1;
+    }
+
+#pragma omp for schedule(dynamic)
+    for ( size_t t = 0; t < ntiles; t++ ){
+      size_t r0 = t*ROQ_TILE_ROWS;
+      size_t nr = ( r0 + ROQ_TILE_ROWS > nrows ) ? nrows - r0 : ROQ_TILE_ROWS;
+
+      if ( P == NULL ){ continue; }
+
+      if ( iscomplex ){
+        gsl_matrix_complex_const_view A = gsl_matrix_complex_const_view_array(T + 2*r0*cols, nr, cols);
+        gsl_matrix_complex_const_view B = gsl_matrix_complex_const_view_array(WB, nb, cols);
+        gsl_matrix_complex_view C = gsl_matrix_complex_view_array(P, nr, nb);
+
+        /* conjugate transpose, so the weighted basis is the conjugated vector in each inner product */
+        gsl_blas_zgemm(CblasNoTrans, CblasConjTrans, GSL_COMPLEX_ONE, &A.matrix, &B.matrix, GSL_COMPLEX_ZERO, &C.matrix);
+
+        for ( size_t i = 0; i < nr; i++ ){
+          REAL8 p2 = 0.;
+          for ( size_t j = 0; j < nb; j++ ){ p2 += P[2*(i*nb+j)]*P[2*(i*nb+j)] + P[2*(i*nb+j)+1]*P[2*(i*nb+j)+1]; }
+          resid[r0+i] -= scale[r0+i]*scale[r0+i]*p2;
+        }
+      }
+      else{
+        gsl_matrix_const_view A = gsl_matrix_const_view_array(T + r0*cols, nr, cols);
+        gsl_matrix_const_view B = gsl_matrix_const_view_array(WB, nb, cols);
+        gsl_matrix_view C = gsl_matrix_view_array(P, nr, nb);
+
+        gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1., &A.matrix, &B.matrix, 0., &C.matrix);
+
+        for ( size_t i = 0; i < nr; i++ ){
+          REAL8 p2 = 0.;
+          for ( size_t j = 0; j < nb; j++ ){ p2 += P[i*nb+j]*P[i*nb+j]; }
+          resid[r0+i] -= scale[r0+i]*scale[r0+i]*p2;
+        }
+      }
+    }
+
+    XLALFree( P );
+  }
+
+  XLAL_CHECK( !failed, XLAL_ENOMEM );
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Remove the projections of the whole training set onto a set of basis vectors
+ *
+ * The training set is passed through block by block, so that at most \c blocksize rows of a
+ * streamed training set are held in memory.
+ *
+ * @param[in] TS The training set
+ * @param[in] WB The \c nb basis vectors multiplied by the inner product weights
+ * @param[in] nb The number of basis vectors
+ * @param[in] scale The inverse norm of each training set row
+ * @param[in,out] resid The squared residual of each normalised row
+ * @param[in] blocksize The number of rows in each block
+ * @param[in] buf A buffer of \c blocksize rows for reading a streamed training set
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if the training set could not be read
+ */
+static int roq_project_training_set(LALInferenceROQTrainingSet *TS, const REAL8 *WB, size_t nb, const REAL8 *scale, REAL8 *resid, size_t blocksize, REAL8 *buf){
+  for ( size_t first = 0; first < TS->rows; first += blocksize ){
+    size_t nr = ( first + blocksize > TS->rows ) ? TS->rows - first : blocksize;
+    const REAL8 *T = roq_training_set_rows(TS, first, nr, buf);
+    XLAL_CHECK( T != NULL, XLAL_EFUNC );
+
+    XLAL_CHECK( roq_project_block(T, nr, TS->cols, TS->iscomplex, WB, nb, scale + first, resid + first) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief The greedy basis generation shared by the real and complex blocked functions
+ *
+ * This follows the same greedy algorithm as \c LALInferenceGenerateREAL8OrthonormalBasis and
+ * \c LALInferenceGenerateCOMPLEX16OrthonormalBasis, but rather than normalising the training
+ * set in place the inverse norm of each waveform is stored, and the projection errors of the
+ * whole training set are updated with tiled matrix products spread across threads.
+ *
+ * @param[in,out] RBdata The basis vectors (as consecutive rows of doubles); any input vectors
+ * are used as the starting basis. This is returned (possibly reallocated) even on failure, and
+ * must be freed by the caller.
+ * @param[in,out] nRB The number of basis vectors
+ * @param[in] delta The inner product weight(s)
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation
+ * @param[in] TS The training set
+ * @param[out] greedypoints The training set rows added to the basis
+ * @param[in] blocksize The number of training set rows processed in each block
+ *
+ * @return The maximum projection error for the final reduced basis
+ */
+static REAL8 roq_generate_basis_blocked(REAL8 **RBdata, size_t *nRB, const REAL8Vector *delta, REAL8 tolerance, LALInferenceROQTrainingSet *TS, UINT4Vector **greedypoints, size_t blocksize){
+  size_t rows = TS->rows, cols = TS->cols;
+  UINT4 iscomplex = TS->iscomplex;
+  size_t rowlen = cols * (iscomplex ? 2 : 1);
+  size_t dim_RB = *nRB, max_RB = *nRB + rows, capacity = *nRB;
+  REAL8 *rb = *RBdata;
+  REAL8 *scale = NULL, *resid = NULL, *wb = NULL, *buf = NULL, *WRB = NULL;
+  UCHAR *used = NULL;
+  UINT4Vector *gpts = NULL; /* selected greedy points (row selection) */
+  size_t ngpts = 0;
+  gsl_vector *ortho_basis = NULL, *ru = NULL;
+  gsl_vector_complex *cortho_basis = NULL, *cru = NULL;
+  gsl_vector_view deltaview;
+  const REAL8 *T = NULL;
+  REAL8 worst_err = 0.;     /* errors in greedy sweep */
+  UINT4 worst_app = 0;      /* worst error stored */
+  REAL8 ret = XLAL_REAL8_FAIL_NAN;
+
+  if ( blocksize == 0 ){ blocksize = ROQ_DEFAULT_BLOCK_ROWS; }
+  if ( blocksize > rows ){ blocksize = rows; }
+
+  scale = XLALCalloc(rows, sizeof(REAL8));
+  resid = XLALCalloc(rows, sizeof(REAL8));
+  used = XLALCalloc(rows, sizeof(UCHAR));
+  wb = XLALMalloc(rowlen*sizeof(REAL8));
+  buf = ( TS->data == NULL ) ? XLALMalloc(blocksize*rowlen*sizeof(REAL8)) : NULL;
+  XLAL_CHECK_FAIL( scale != NULL && resid != NULL && used != NULL && wb != NULL && ( TS->data != NULL || buf != NULL ), XLAL_ENOMEM );
+
+  gpts = XLALCreateUINT4Vector(rows);
+  XLAL_CHECK_FAIL( gpts != NULL, XLAL_EFUNC );
+
+  XLAL_CALLGSL( deltaview = gsl_vector_view_array(delta->data, delta->length) );
+
+  /* get the normalisation of each training set waveform */
+  for ( size_t first = 0; first < rows; first += blocksize ){
+    size_t nr = ( first + blocksize > rows ) ? rows - first : blocksize;
+    T = roq_training_set_rows(TS, first, nr, buf);
+    XLAL_CHECK_FAIL( T != NULL, XLAL_EFUNC );
+    roq_block_scales(T, nr, cols, iscomplex, delta, scale + first, resid + first);
+  }
+
+  if ( dim_RB > 0 ){
+    /* project the training set onto the whole of the existing basis in one pass */
+    WRB = XLALMalloc(dim_RB*rowlen*sizeof(REAL8));
+    XLAL_CHECK_FAIL( WRB != NULL, XLAL_ENOMEM );
+    for ( size_t j = 0; j < dim_RB; j++ ){ roq_weight_vector(WRB + j*rowlen, rb + j*rowlen, delta, cols, iscomplex); }
+    XLAL_CHECK_FAIL( roq_project_training_set(TS, WRB, dim_RB, scale, resid, blocksize, buf) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  else{
+    /* initialize algorithm with first training set value */
+    capacity = ( rows < 64 ) ? rows : 64;
+    rb = XLALMalloc(capacity*rowlen*sizeof(REAL8));
+    XLAL_CHECK_FAIL( rb != NULL, XLAL_ENOMEM );
+
+    T = roq_training_set_rows(TS, 0, 1, buf);
+    XLAL_CHECK_FAIL( T != NULL, XLAL_EFUNC );
+    for ( size_t k = 0; k < rowlen; k++ ){ rb[k] = scale[0]*T[k]; }
+
+    gpts->data[ngpts++] = 0;
+    used[0] = 1;
+    dim_RB = 1;
+
+    roq_weight_vector(wb, rb, delta, cols, iscomplex);
+    XLAL_CHECK_FAIL( roq_project_training_set(TS, wb, 1, scale, resid, blocksize, buf) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  if ( iscomplex ){
+    XLAL_CALLGSL( cortho_basis = gsl_vector_complex_alloc(cols) );
+    XLAL_CALLGSL( cru = gsl_vector_complex_alloc(max_RB + 1) );
+    XLAL_CHECK_FAIL( cortho_basis != NULL && cru != NULL, XLAL_ENOMEM );
+  }
+  else{
+    XLAL_CALLGSL( ortho_basis = gsl_vector_alloc(cols) );
+    XLAL_CALLGSL( ru = gsl_vector_alloc(max_RB + 1) );
+    XLAL_CHECK_FAIL( ortho_basis != NULL && ru != NULL, XLAL_ENOMEM );
+  }
+
+  /* loop to find reduced basis */
+  while ( ngpts < rows ){
+    /* find worst represented training set element */
+    worst_err = 0.0;
+    for ( size_t i = 0; i < rows; i++ ){
+      if ( worst_err < resid[i] ){
+        worst_err = resid[i];
+        worst_app = i;
+      }
+    }
+
+    /* when enriching, make sure that all training elements get added to the basis even if
+       their errors are very small (see LALInferenceGenerateREAL8OrthonormalBasis) */
+    if ( tolerance == 0. && used[worst_app] ){
+      for ( size_t i = 0; i < rows; i++ ){
+        if ( !used[i] ){
+          worst_app = i;
+          break;
+        }
+      }
+    }
+
+    /* orthogonalise the (normalised) worst approximated solution against the basis using IMGS */
+    T = roq_training_set_rows(TS, worst_app, 1, buf);
+    XLAL_CHECK_FAIL( T != NULL, XLAL_EFUNC );
+
+    REAL8 nrm = 0.;
+    if ( iscomplex ){
+      for ( size_t k = 0; k < cols; k++ ){
+        gsl_complex z;
+        GSL_SET_COMPLEX(&z, scale[worst_app]*T[2*k], scale[worst_app]*T[2*k+1]);
+        gsl_vector_complex_set(cortho_basis, k, z);
+      }
+      gsl_matrix_complex_const_view RBview = gsl_matrix_complex_const_view_array(rb, dim_RB, cols);
+      iterated_modified_gm_complex(cru, cortho_basis, &RBview.matrix, &deltaview.vector, dim_RB);
+      nrm = GSL_REAL(gsl_vector_complex_get(cru, dim_RB));
+    }
+    else{
+      for ( size_t k = 0; k < cols; k++ ){ gsl_vector_set(ortho_basis, k, scale[worst_app]*T[k]); }
+      gsl_matrix_const_view RBview = gsl_matrix_const_view_array(rb, dim_RB, cols);
+      iterated_modified_gm(ru, ortho_basis, &RBview.matrix, &deltaview.vector, dim_RB);
+      nrm = gsl_vector_get(ru, dim_RB);
+    }
+
+    /* check normalisation of generated orthogonal basis is not NaN (cause by a new orthogonal basis
+      having zero residual with the current basis) - if this is the case do not add the new basis. */
+    if ( gsl_isnan(nrm) ){ break; }
+
+    /* add to reduced basis */
+    if ( dim_RB == capacity ){
+      size_t newcapacity = ( 2*capacity < max_RB ) ? 2*capacity : max_RB;
+      REAL8 *newrb = XLALRealloc(rb, newcapacity*rowlen*sizeof(REAL8));
+      XLAL_CHECK_FAIL( newrb != NULL, XLAL_ENOMEM );
+      rb = newrb;
+      capacity = newcapacity;
+    }
+    memcpy(rb + dim_RB*rowlen, iscomplex ? cortho_basis->data : ortho_basis->data, rowlen*sizeof(REAL8));
+
+    gpts->data[ngpts++] = worst_app;
+    used[worst_app] = 1;
+    ++dim_RB;
+
+    /* decide if another greedy sweep is needed */
+    if ( worst_err < tolerance || ngpts == rows ){ break; }
+
+    /* update projections of the training set with the new basis */
+    roq_weight_vector(wb, rb + (dim_RB-1)*rowlen, delta, cols, iscomplex);
+    XLAL_CHECK_FAIL( roq_project_training_set(TS, wb, 1, scale, resid, blocksize, buf) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  *greedypoints = XLALResizeUINT4Vector( gpts, ngpts );
+  XLAL_CHECK_FAIL( *greedypoints != NULL || ngpts == 0, XLAL_EFUNC );
+  gpts = NULL;
+  ret = worst_err;
+
+XLAL_FAIL:
+  *RBdata = rb;
+  *nRB = dim_RB;
+
+  gsl_vector_complex_free(cortho_basis);
+  gsl_vector_complex_free(cru);
+  gsl_vector_free(ortho_basis);
+  gsl_vector_free(ru);
+  XLALDestroyUINT4Vector( gpts );
+  XLALFree( scale );
+  XLALFree( resid );
+  XLALFree( used );
+  XLALFree( wb );
+  XLALFree( buf );
+  XLALFree( WRB );
+
+  return ret;
+}
+
+
+/**
+ * \brief Create a orthonormal basis set from a training set of real waveforms using a blocked,
+ * multi-threaded algorithm
+ *
+ * This produces the same reduced basis as \c LALInferenceGenerateREAL8OrthonormalBasis, but the
+ * projection errors of the training set are updated at each greedy step using tiled matrix
+ * products that are shared between OpenMP threads. The training set is provided through a
+ * \c LALInferenceROQTrainingSet, so can either be held in memory (in which case it is not
+ * modified) or be streamed from a file, \c blocksize rows at a time.
+ *
+ * If \c RB already contains a basis, then the training set is first projected onto the whole
+ * of that basis in one pass, and the basis is then enriched from the training set. In this case
+ * \c greedypoints only contains the indices of the training set rows that have been added.
+ *
+ * @param[in,out] RB A \c REAL8Array to return the reduced basis (containing any starting basis).
+ * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
+ * This can be a vector containing just one value.
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
+ * @param[in] TS The training set of real waveforms.
+ * @param[out] greedypoints A \c UINT4Vector to return the indices of the training set rows that
+ * have been used to form the reduced basis.
+ * @param[in] blocksize The number of training set rows processed (or read from file) in one go. If
+ * this is zero a default value is used.
+ *
+ * @return A \c REAL8 with the maximum projection error for the final reduced basis.
+ *
+ * \sa LALInferenceGenerateREAL8OrthonormalBasis
+ */
+REAL8 LALInferenceGenerateREAL8OrthonormalBasisBlocked(REAL8Array **RB,
+                                                       const REAL8Vector *delta,
+                                                       REAL8 tolerance,
+                                                       LALInferenceROQTrainingSet *TS,
+                                                       UINT4Vector **greedypoints,
+                                                       size_t blocksize){
+  XLAL_CHECK_REAL8( RB != NULL && greedypoints != NULL, XLAL_EFAULT );
+  XLAL_CHECK_REAL8( TS != NULL, XLAL_EFAULT, "Training set is NULL!" );
+  XLAL_CHECK_REAL8( !TS->iscomplex, XLAL_EINVAL, "Training set must contain real waveforms" );
+  XLAL_CHECK_REAL8( delta != NULL, XLAL_EFAULT, "Vector of 'delta' values is NULL!" );
+  XLAL_CHECK_REAL8( delta->length == 1 || delta->length == TS->cols, XLAL_EINVAL, "Vector of weights must either contain a single value, or be the same length as the training set waveforms." );
+  XLAL_CHECK_REAL8( tolerance >= 0., XLAL_EINVAL, "Tolerance is less than zero!" );
+
+  REAL8 *rbdata = NULL;
+  size_t nrb = 0;
+
+  if ( *RB != NULL ){
+    XLAL_CHECK_REAL8( (*RB)->dimLength->length == 2, XLAL_EINVAL, "Reduced basis set array must have only two dimensions" );
+    XLAL_CHECK_REAL8( (*RB)->dimLength->data[1] == TS->cols, XLAL_EINVAL, "Reduced basis and training set waveforms have different lengths" );
+    nrb = (*RB)->dimLength->data[0];
+    rbdata = XLALMalloc(nrb*TS->cols*sizeof(REAL8));
+    XLAL_CHECK_REAL8( rbdata != NULL, XLAL_ENOMEM );
+    memcpy(rbdata, (*RB)->data, nrb*TS->cols*sizeof(REAL8));
+  }
+
+  REAL8 maxprojerr = roq_generate_basis_blocked(&rbdata, &nrb, delta, tolerance, TS, greedypoints, blocksize);
+  XLAL_CHECK_FAIL( !XLAL_IS_REAL8_FAIL_NAN(maxprojerr), XLAL_EFUNC );
+
+  UINT4Vector *dims = XLALCreateUINT4Vector( 2 );
+  XLAL_CHECK_FAIL( dims != NULL, XLAL_EFUNC );
+  dims->data[0] = nrb;
+  dims->data[1] = TS->cols;
+  if ( *RB != NULL ){ XLALDestroyREAL8Array( *RB ); }
+  *RB = XLALCreateREAL8Array( dims );
+  XLALDestroyUINT4Vector( dims );
+  XLAL_CHECK_FAIL( *RB != NULL, XLAL_EFUNC );
+  memcpy((*RB)->data, rbdata, nrb*TS->cols*sizeof(REAL8));
+  XLALFree( rbdata );
+
+  return maxprojerr;
+
+XLAL_FAIL:
+  XLALFree( rbdata );
+  return XLAL_REAL8_FAIL_NAN;
+}
+
+
+/**
+ * \brief Create a orthonormal basis set from a training set of complex waveforms using a blocked,
+ * multi-threaded algorithm
+ *
+ * This produces the same reduced basis as \c LALInferenceGenerateCOMPLEX16OrthonormalBasis, but
+ * the projection errors of the training set are updated at each greedy step using tiled matrix
+ * products that are shared between OpenMP threads. The training set is provided through a
+ * \c LALInferenceROQTrainingSet, so can either be held in memory (in which case it is not
+ * modified) or be streamed from a file, \c blocksize rows at a time.
+ *
+ * If \c RB already contains a basis, then the training set is first projected onto the whole
+ * of that basis in one pass, and the basis is then enriched from the training set. In this case
+ * \c greedypoints only contains the indices of the training set rows that have been added.
+ *
+ * @param[in,out] RB A \c COMPLEX16Array to return the reduced basis (containing any starting basis).
+ * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
+ * This can be a vector containing just one value.
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
+ * @param[in] TS The training set of complex waveforms.
+ * @param[out] greedypoints A \c UINT4Vector to return the indices of the training set rows that
+ * have been used to form the reduced basis.
+ * @param[in] blocksize The number of training set rows processed (or read from file) in one go. If
+ * this is zero a default value is used.
+ *
+ * @return A \c REAL8 with the maximum projection error for the final reduced basis.
+ *
+ * \sa LALInferenceGenerateCOMPLEX16OrthonormalBasis
+ */
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisBlocked(COMPLEX16Array **RB,
+                                                           const REAL8Vector *delta,
+                                                           REAL8 tolerance,
+                                                           LALInferenceROQTrainingSet *TS,
+                                                           UINT4Vector **greedypoints,
+                                                           size_t blocksize){
+  XLAL_CHECK_REAL8( RB != NULL && greedypoints != NULL, XLAL_EFAULT );
+  XLAL_CHECK_REAL8( TS != NULL, XLAL_EFAULT, "Training set is NULL!" );
+  XLAL_CHECK_REAL8( TS->iscomplex, XLAL_EINVAL, "Training set must contain complex waveforms" );
+  XLAL_CHECK_REAL8( delta != NULL, XLAL_EFAULT, "Vector of 'delta' values is NULL!" );
+  XLAL_CHECK_REAL8( delta->length == 1 || delta->length == TS->cols, XLAL_EINVAL, "Vector of weights must either contain a single value, or be the same length as the training set waveforms." );
+  XLAL_CHECK_REAL8( tolerance >= 0., XLAL_EINVAL, "Tolerance is less than zero!" );
+
+  REAL8 *rbdata = NULL;
+  size_t nrb = 0;
+
+  if ( *RB != NULL ){
+    XLAL_CHECK_REAL8( (*RB)->dimLength->length == 2, XLAL_EINVAL, "Reduced basis set array must have only two dimensions" );
+    XLAL_CHECK_REAL8( (*RB)->dimLength->data[1] == TS->cols, XLAL_EINVAL, "Reduced basis and training set waveforms have different lengths" );
+    nrb = (*RB)->dimLength->data[0];
+    rbdata = XLALMalloc(nrb*TS->cols*sizeof(COMPLEX16));
+    XLAL_CHECK_REAL8( rbdata != NULL, XLAL_ENOMEM );
+    memcpy(rbdata, (*RB)->data, nrb*TS->cols*sizeof(COMPLEX16));
+  }
+
+  REAL8 maxprojerr = roq_generate_basis_blocked(&rbdata, &nrb, delta, tolerance, TS, greedypoints, blocksize);
+  XLAL_CHECK_FAIL( !XLAL_IS_REAL8_FAIL_NAN(maxprojerr), XLAL_EFUNC );
+
+  UINT4Vector *dims = XLALCreateUINT4Vector( 2 );
+  XLAL_CHECK_FAIL( dims != NULL, XLAL_EFUNC );
+  dims->data[0] = nrb;
+  dims->data[1] = TS->cols;
+  if ( *RB != NULL ){ XLALDestroyCOMPLEX16Array( *RB ); }
+  *RB = XLALCreateCOMPLEX16Array( dims );
+  XLALDestroyUINT4Vector( dims );
+  XLAL_CHECK_FAIL( *RB != NULL, XLAL_EFUNC );
+  memcpy((*RB)->data, rbdata, nrb*TS->cols*sizeof(COMPLEX16));
+  XLALFree( rbdata );
+
+  return maxprojerr;
+
+XLAL_FAIL:
+  XLALFree( rbdata );
+  return XLAL_REAL8_FAIL_NAN;
+}
+
+
 /**
  * \brief Create a real empirical interpolant from a set of orthonormal basis functions
  *
@@ -28,6 +28,8 @@
 #include <lal/LALInference.h>
 #include <lal/XLALError.h>
 
+#include <stdio.h>
+
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_blas.h>
@@ -52,6 +54,20 @@ typedef struct tagLALInferenceCOMPLEXROQInterpolant{
   UINT4 *nodes;           /**< The nodes (indices) for the interpolation */
 }LALInferenceCOMPLEXROQInterpolant;
 
+/**
+ * A structure providing blocks of rows of a (real or complex) training set to the
+ * blocked reduced basis generation functions. The training set can either be held
+ * in memory, or be streamed from a binary file so that it never has to be held in
+ * memory in its entirety.
+ */
+typedef struct tagLALInferenceROQTrainingSet{
+  size_t rows;        /**< The number of waveforms in the training set */
+  size_t cols;        /**< The number of points in each training set waveform */
+  UINT4 iscomplex;    /**< Set if the training set waveforms are complex */
+  REAL8 *data;        /**< The training set data, if held in memory (or \c NULL if streamed from a file) */
+  FILE *fp;           /**< The file from which the training set is streamed (or \c NULL if held in memory) */
+}LALInferenceROQTrainingSet;
+
 /* function to create or enrich a real orthonormal basis set from a training set of models */
 REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RB,
                                                 const REAL8Vector *delta,
@@ -65,6 +81,30 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RB,
                                                     COMPLEX16Array **TS,
                                                     UINT4Vector **greedypoints);
 
+/* functions to provide a training set to the blocked reduced basis generation functions */
+LALInferenceROQTrainingSet *LALInferenceCreateREAL8ROQTrainingSet(const REAL8Array *TS);
+LALInferenceROQTrainingSet *LALInferenceCreateCOMPLEX16ROQTrainingSet(const COMPLEX16Array *TS);
+LALInferenceROQTrainingSet *LALInferenceOpenROQTrainingSetFile(const char *filename,
+                                                               size_t rows,
+                                                               size_t cols,
+                                                               UINT4 iscomplex);
+void LALInferenceRemoveROQTrainingSet(LALInferenceROQTrainingSet *TS);
+
+/* blocked, multi-threaded versions of the functions to create or enrich an orthonormal basis set */
+REAL8 LALInferenceGenerateREAL8OrthonormalBasisBlocked(REAL8Array **RB,
+                                                       const REAL8Vector *delta,
+                                                       REAL8 tolerance,
+                                                       LALInferenceROQTrainingSet *TS,
+                                                       UINT4Vector **greedypoints,
+                                                       size_t blocksize);
+
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisBlocked(COMPLEX16Array **RB,
+                                                           const REAL8Vector *delta,
+                                                           REAL8 tolerance,
+                                                           LALInferenceROQTrainingSet *TS,
+                                                           UINT4Vector **greedypoints,
+                                                           size_t blocksize);
+
 /* functions to test the basis */
 void LALInferenceValidateREAL8OrthonormalBasis(REAL8Vector **projerr,
                                                const REAL8Vector *delta,
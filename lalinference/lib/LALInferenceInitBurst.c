@@ -240,6 +240,8 @@ LALInferenceModel * LALInferenceInitBurstModel(LALInferenceRunState *state)
   LALInferenceModel *model = XLALMalloc(sizeof(LALInferenceModel));
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
+  model->nSpcalBasis = 0;
+  model->spcalBasis = NULL;
   LALInferenceVariables *currentParams=model->params;
 
   UINT4 signal_flag=1;
@@ -929,6 +929,8 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   LALInferenceModel *model = XLALMalloc(sizeof(LALInferenceModel));
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
+  model->nSpcalBasis = 0;
+  model->spcalBasis = NULL;
   model->eos_fam = NULL;
 
   UINT4 signal_flag=1;
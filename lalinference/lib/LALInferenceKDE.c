@@ -195,6 +195,8 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde) {
 
         if (kde->npts > 0) gsl_matrix_free(kde->data);
 
+        LALInferenceKDEClearTree(kde);
+
         XLALFree(kde->lower_bound_types);
         XLALFree(kde->upper_bound_types);
         XLALFree(kde->lower_bounds);
@@ -250,6 +252,9 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     INT4 i, j;
     INT4 status;
 
+    /* Any kd-tree was built with the old bandwidth */
+    LALInferenceKDEClearTree(kde);
+
     /* If data set is empty, set the normalization to infinity */
     if (kde->npts == 0) {
         kde->log_norm_factor = INFINITY;
@@ -288,11 +293,390 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
 }
 
 
+/* Maximum number of points in a leaf of a KDE kd-tree */
+#define KDE_TREE_LEAF_SIZE 32
+
+/* Maximum depth of a KDE kd-tree (median splits keep it well below this) */
+#define KDE_TREE_MAX_DEPTH 128
+
+/**
+ * kd-tree of the points of a KDE in kernel-whitened coordinates.
+ *
+ * Points are whitened with the inverse of the lower Cholesky factor of the
+ *  kernel covariance, so each kernel is a unit spherical Gaussian.  The points
+ *  are stored in tree order, one dimension after another, so that each leaf
+ *  is a contiguous block of every coordinate.
+ */
+typedef struct
+tagKDETree
+{
+    INT4 dim;                   /**< Dimension of points. */
+    INT4 npts;                  /**< Number of points. */
+    INT4 nnodes;                /**< Number of nodes in the tree. */
+    INT4 maxnodes;              /**< Number of allocated nodes. */
+    REAL8 rtol;                 /**< Relative error tolerance of evaluations. */
+    REAL8 *coords;              /**< Whitened coordinates, coords[k*npts + j]. */
+    INT4 *start;                /**< First point of each node. */
+    INT4 *count;                /**< Number of points in each node. */
+    INT4 *left;                 /**< Left child of each node (-1 for a leaf). */
+    INT4 *right;                /**< Right child of each node (-1 for a leaf). */
+    REAL8 *lo;                  /**< Lower corner of each node's bounding box. */
+    REAL8 *hi;                  /**< Upper corner of each node's bounding box. */
+} LALInferenceKDETree;
+
+static INT4 kde_tree_add_node(LALInferenceKDETree *tree, REAL8 *pts, INT4 *idx, INT4 start, INT4 count, INT4 depth);
+static void kde_tree_box_dist2(const LALInferenceKDETree *tree, INT4 node, const REAL8 *q, REAL8 *dmin2, REAL8 *dmax2);
+static REAL8 kde_tree_leaf_sum(const LALInferenceKDETree *tree, INT4 node, const REAL8 *q, REAL8 shift, REAL8 *min_energy);
+static REAL8 kde_tree_log_sum(const LALInferenceKDETree *tree, const REAL8 *q);
+
+
+/**
+ * Build a kd-tree to accelerate evaluation of a KDE.
+ *
+ * Once built, LALInferenceKDEEvaluatePoint() traverses the tree rather than
+ *  summing over every point, approximating the contribution of any node whose
+ *  kernel values span less than its share of \a rtol times the running total.
+ *  The total relative error of each evaluation is then bounded by \a rtol,
+ *  and nodes far from the evaluation point are skipped.  With \a rtol of zero
+ *  the evaluation is exact.  The tree must be rebuilt if the bandwidth of the
+ *  KDE is changed.
+ * @param[in] kde  The kernel density estimate to build the tree for.
+ * @param[in] rtol The relative error tolerance of evaluations.
+ * @return XLAL_SUCCESS, or XLAL_FAILURE if the KDE cannot be evaluated.
+ */
+INT4 LALInferenceKDEBuildTree(LALInferenceKDE *kde, REAL8 rtol) {
+    INT4 dim = kde->dim;
+    INT4 npts = kde->npts;
+    INT4 i, j;
+
+    XLAL_CHECK(rtol >= 0., XLAL_EINVAL, "Relative error tolerance must be non-negative");
+
+    LALInferenceKDEClearTree(kde);
+
+    /* Nothing to build if the KDE cannot be evaluated */
+    XLAL_CHECK(npts > 0 && !isinf(kde->log_norm_factor), XLAL_EINVAL,
+               "KDE is empty or has a singular covariance");
+
+    LALInferenceKDETree *tree = XLALCalloc(1, sizeof(LALInferenceKDETree));
+    XLAL_CHECK(tree != NULL, XLAL_ENOMEM);
+    tree->dim = dim;
+    tree->npts = npts;
+    tree->rtol = rtol;
+
+    /* The tree is attached to the KDE so that it is freed on failure */
+    kde->tree = tree;
+
+    /* Whiten the points: solve L y = x for each point */
+    REAL8 *pts = XLALMalloc(npts * dim * sizeof(REAL8));
+    INT4 *idx = XLALMalloc(npts * sizeof(INT4));
+    if (pts == NULL || idx == NULL) {
+        LALInferenceKDEClearTree(kde);
+        XLALFree(pts);
+        XLALFree(idx);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+    for (j = 0; j < npts; j++) {
+        gsl_vector_view y = gsl_vector_view_array(pts + j*dim, dim);
+        gsl_vector_const_view x = gsl_matrix_const_row(kde->data, j);
+        gsl_vector_memcpy(&y.vector, &x.vector);
+        gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                       kde->cholesky_decomp_cov_lower, &y.vector);
+        idx[j] = j;
+    }
+
+    /* Median splits give leaves of at least KDE_TREE_LEAF_SIZE/2 points */
+    tree->maxnodes = 4 * (npts / KDE_TREE_LEAF_SIZE) + 4;
+    tree->start = XLALMalloc(tree->maxnodes * sizeof(INT4));
+    tree->count = XLALMalloc(tree->maxnodes * sizeof(INT4));
+    tree->left = XLALMalloc(tree->maxnodes * sizeof(INT4));
+    tree->right = XLALMalloc(tree->maxnodes * sizeof(INT4));
+    tree->lo = XLALMalloc(tree->maxnodes * dim * sizeof(REAL8));
+    tree->hi = XLALMalloc(tree->maxnodes * dim * sizeof(REAL8));
+    if (!(tree->start && tree->count && tree->left && tree->right &&
+          tree->lo && tree->hi)) {
+        LALInferenceKDEClearTree(kde);
+        XLALFree(pts);
+        XLALFree(idx);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+
+    if (kde_tree_add_node(tree, pts, idx, 0, npts, 0) != 0) {
+        LALInferenceKDEClearTree(kde);
+        XLALFree(pts);
+        XLALFree(idx);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    /* Store the whitened points in tree order, one dimension at a time */
+    tree->coords = XLALMalloc(npts * dim * sizeof(REAL8));
+    if (tree->coords == NULL) {
+        LALInferenceKDEClearTree(kde);
+        XLALFree(pts);
+        XLALFree(idx);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+    for (j = 0; j < npts; j++) {
+        for (i = 0; i < dim; i++)
+            tree->coords[i*npts + j] = pts[idx[j]*dim + i];
+    }
+
+    XLALFree(pts);
+    XLALFree(idx);
+
+    return XLAL_SUCCESS;
+}
+
+
+/**
+ * Free the kd-tree of a KDE.
+ *
+ * Subsequent evaluations of the KDE sum exactly over every point.
+ * @param[in] kde The kernel density estimate to free the tree of.
+ */
+void LALInferenceKDEClearTree(LALInferenceKDE *kde) {
+    LALInferenceKDETree *tree = kde->tree;
+
+    if (tree) {
+        XLALFree(tree->coords);
+        XLALFree(tree->start);
+        XLALFree(tree->count);
+        XLALFree(tree->left);
+        XLALFree(tree->right);
+        XLALFree(tree->lo);
+        XLALFree(tree->hi);
+        XLALFree(tree);
+    }
+
+    kde->tree = NULL;
+}
+
+
+/* Recursively add a node of the tree, splitting the points at the median of
+ * the widest dimension of their bounding box.  Returns the index of the node. */
+static INT4 kde_tree_add_node(LALInferenceKDETree *tree, REAL8 *pts,
+                              INT4 *idx, INT4 start, INT4 count, INT4 depth) {
+    INT4 dim = tree->dim;
+    INT4 i, j, k;
+
+    XLAL_CHECK(depth < KDE_TREE_MAX_DEPTH, XLAL_EMAXITER, "kd-tree is too deep");
+
+    if (tree->nnodes == tree->maxnodes) {
+        /* Arrays are only replaced once grown, so that on failure the tree
+         * still owns every array and can be freed */
+        INT4 maxnodes = 2 * tree->maxnodes;
+        INT4 *new_start = XLALRealloc(tree->start, maxnodes * sizeof(INT4));
+        if (new_start) tree->start = new_start;
+        INT4 *new_count = XLALRealloc(tree->count, maxnodes * sizeof(INT4));
+        if (new_count) tree->count = new_count;
+        INT4 *new_left = XLALRealloc(tree->left, maxnodes * sizeof(INT4));
+        if (new_left) tree->left = new_left;
+        INT4 *new_right = XLALRealloc(tree->right, maxnodes * sizeof(INT4));
+        if (new_right) tree->right = new_right;
+        REAL8 *new_lo = XLALRealloc(tree->lo, maxnodes * dim * sizeof(REAL8));
+        if (new_lo) tree->lo = new_lo;
+        REAL8 *new_hi = XLALRealloc(tree->hi, maxnodes * dim * sizeof(REAL8));
+        if (new_hi) tree->hi = new_hi;
+        XLAL_CHECK(new_start && new_count && new_left && new_right &&
+                   new_lo && new_hi, XLAL_ENOMEM);
+        tree->maxnodes = maxnodes;
+    }
+
+    INT4 node = tree->nnodes++;
+    REAL8 *lo = tree->lo + node*dim;
+    REAL8 *hi = tree->hi + node*dim;
+
+    tree->start[node] = start;
+    tree->count[node] = count;
+    tree->left[node] = -1;
+    tree->right[node] = -1;
+
+    /* Bounding box */
+    for (k = 0; k < dim; k++) {
+        lo[k] = INFINITY;
+        hi[k] = -INFINITY;
+    }
+    for (j = start; j < start + count; j++) {
+        for (k = 0; k < dim; k++) {
+            REAL8 val = pts[idx[j]*dim + k];
+            if (val < lo[k]) lo[k] = val;
+            if (val > hi[k]) hi[k] = val;
+        }
+    }
+
+    if (count <= KDE_TREE_LEAF_SIZE)
+        return node;
+
+    INT4 split = 0;
+    for (k = 1; k < dim; k++) {
+        if (hi[k] - lo[k] > hi[split] - lo[split])
+            split = k;
+    }
+
+    /* All points coincide, so there's nothing to gain from splitting */
+    if (hi[split] == lo[split])
+        return node;
+
+    /* Partially sort the points so the median is in place (quickselect) */
+    INT4 nleft = count / 2;
+    INT4 l = start, r = start + count - 1, m = start + nleft;
+    while (l < r) {
+        REAL8 pivot = pts[idx[(l + r)/2]*dim + split];
+        i = l;
+        j = r;
+        while (i <= j) {
+            while (pts[idx[i]*dim + split] < pivot) i++;
+            while (pts[idx[j]*dim + split] > pivot) j--;
+            if (i <= j) {
+                INT4 tmp = idx[i];
+                idx[i] = idx[j];
+                idx[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (m <= j)
+            r = j;
+        else if (m >= i)
+            l = i;
+        else
+            break;
+    }
+
+    INT4 left = kde_tree_add_node(tree, pts, idx, start, nleft, depth+1);
+    XLAL_CHECK(left >= 0, XLAL_EFUNC);
+    INT4 right = kde_tree_add_node(tree, pts, idx, start + nleft, count - nleft, depth+1);
+    XLAL_CHECK(right >= 0, XLAL_EFUNC);
+
+    tree->left[node] = left;
+    tree->right[node] = right;
+
+    return node;
+}
+
+
+/* Minimum and maximum squared distances from a point to a node's bounding box */
+static void kde_tree_box_dist2(const LALInferenceKDETree *tree, INT4 node,
+                               const REAL8 *q, REAL8 *dmin2, REAL8 *dmax2) {
+    INT4 dim = tree->dim;
+    const REAL8 *lo = tree->lo + node*dim;
+    const REAL8 *hi = tree->hi + node*dim;
+    REAL8 mn = 0., mx = 0.;
+
+    for (INT4 k = 0; k < dim; k++) {
+        REAL8 dlo = q[k] - lo[k];
+        REAL8 dhi = hi[k] - q[k];
+        REAL8 near = (dlo < 0.) ? -dlo : ((dhi < 0.) ? -dhi : 0.);
+        REAL8 far = (dlo > dhi) ? dlo : dhi;
+        mn += near*near;
+        mx += far*far;
+    }
+
+    *dmin2 = mn;
+    *dmax2 = mx;
+}
+
+
+/* Exact sum of exp(-(energy - shift)/2) over the points of a leaf, also
+ * returning the minimum energy.  The energies are accumulated one dimension
+ * at a time over contiguous coordinates, so the loops vectorise.  Leaves are
+ * processed in blocks, as a leaf of coincident points can be large. */
+static REAL8 kde_tree_leaf_sum(const LALInferenceKDETree *tree, INT4 node,
+                               const REAL8 *q, REAL8 shift, REAL8 *min_energy) {
+    INT4 npts = tree->npts;
+    INT4 end = tree->start[node] + tree->count[node];
+    REAL8 energy[KDE_TREE_LEAF_SIZE];
+    REAL8 sum = 0., emin = INFINITY;
+    INT4 start, count, j, k;
+
+    for (start = tree->start[node]; start < end; start += count) {
+        count = (end - start < KDE_TREE_LEAF_SIZE) ? end - start : KDE_TREE_LEAF_SIZE;
+
+        for (j = 0; j < count; j++)
+            energy[j] = 0.;
+
+        for (k = 0; k < tree->dim; k++) {
+            const REAL8 *c = tree->coords + k*npts + start;
+            const REAL8 qk = q[k];
+            for (j = 0; j < count; j++) {
+                REAL8 d = c[j] - qk;
+                energy[j] += d*d;
+            }
+        }
+
+        for (j = 0; j < count; j++) {
+            if (energy[j] < emin) emin = energy[j];
+            sum += exp(-0.5*(energy[j] - shift));
+        }
+    }
+
+    if (min_energy)
+        *min_energy = emin;
+
+    return sum;
+}
+
+
+/* Log of the sum of unit Gaussian kernels at a whitened point, to within the
+ * relative error tolerance of the tree. */
+static REAL8 kde_tree_log_sum(const LALInferenceKDETree *tree, const REAL8 *q) {
+    INT4 stack[KDE_TREE_MAX_DEPTH + 1];
+    INT4 nstack = 0;
+    INT4 node = 0;
+    REAL8 dmin2, dmax2, dmin2_l, dmin2_r, shift;
+
+    /* Descend to the nearest leaf to set the scale of the sum, which keeps
+     * the kernel values finite far from all points */
+    while (tree->left[node] >= 0) {
+        kde_tree_box_dist2(tree, tree->left[node], q, &dmin2_l, &dmax2);
+        kde_tree_box_dist2(tree, tree->right[node], q, &dmin2_r, &dmax2);
+        node = (dmin2_l <= dmin2_r) ? tree->left[node] : tree->right[node];
+    }
+    kde_tree_leaf_sum(tree, node, q, 0., &shift);
+
+    /* Each node may be approximated if its error is within its share of the
+     * tolerance, rtol * sum * count / npts, using the running sum (which only
+     * grows) as the estimate of the final sum */
+    REAL8 sum = 0.;
+    REAL8 tol = 2. * tree->rtol / tree->npts;
+
+    stack[nstack++] = 0;
+    while (nstack > 0) {
+        node = stack[--nstack];
+
+        kde_tree_box_dist2(tree, node, q, &dmin2, &dmax2);
+        REAL8 kmax = exp(-0.5*(dmin2 - shift));
+        REAL8 kmin = exp(-0.5*(dmax2 - shift));
+
+        if (kmax - kmin <= tol * sum) {
+            sum += 0.5 * tree->count[node] * (kmax + kmin);
+        } else if (tree->left[node] < 0) {
+            sum += kde_tree_leaf_sum(tree, node, q, shift, NULL);
+        } else {
+            /* Visit the nearer child first, so the sum grows quickly */
+            INT4 left = tree->left[node], right = tree->right[node];
+            kde_tree_box_dist2(tree, left, q, &dmin2_l, &dmax2);
+            kde_tree_box_dist2(tree, right, q, &dmin2_r, &dmax2);
+            if (dmin2_l <= dmin2_r) {
+                stack[nstack++] = right;
+                stack[nstack++] = left;
+            } else {
+                stack[nstack++] = left;
+                stack[nstack++] = right;
+            }
+        }
+    }
+
+    return log(sum) - 0.5*shift;
+}
+
+
 /**
  * Evaluate the (log) PDF from a KDE at a single point.
  *
  * Calculate the (log) value of the probability density function estimate from
- * a kernel density estimate at a single point.
+ * a kernel density estimate at a single point.  If a kd-tree has been built
+ * with LALInferenceKDEBuildTree() it is used in place of the sum over all
+ * points.
  * @param[in] kde   The kernel density estimate to evaluate.
  * @param[in] point An array containing the point to evaluate the PDF at.
  * @return The value of the estimated probability density function at \a point.
@@ -368,9 +752,28 @@ REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
         }
     }
 
+    REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
+
+    /* Evaluate with the kd-tree of whitened points if there is one */
+    if (kde->tree) {
+        for (i = 0; i < n_evals; i++) {
+            gsl_vector_view pt = gsl_matrix_row(points, i);
+            gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                           kde->cholesky_decomp_cov_lower, &pt.vector);
+            eval_results[i] = kde_tree_log_sum(kde->tree, pt.vector.data) -
+                                kde->log_norm_factor;
+        }
+
+        REAL8 result = log_add_exps(eval_results, n_evals);
+
+        gsl_matrix_free(points);
+        XLALFree(eval_results);
+
+        return result;
+    }
+
     /* Loop over list of reflected and cycled points */
     REAL8* results = XLALMalloc(npts * sizeof(REAL8));
-    REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
 
     /* Loop over reflected and cycled set of points */
     for (i = 0; i < n_evals; i++) {
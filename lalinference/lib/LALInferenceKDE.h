@@ -28,6 +28,7 @@
 #include <lal/LALInference.h>
 
 struct tagkmeans;
+struct tagKDETree;
 
 /**
  * Structure containing the Guassian kernel density of a set of samples.
@@ -51,8 +52,17 @@ tagKDE
     LALInferenceParamVaryType * upper_bound_types; /**< Array of param boundary types */
     REAL8 * lower_bounds;              /**< Lower param bounds */
     REAL8 * upper_bounds;              /**< Upper param bounds */
+
+    struct tagKDETree *tree;           /**< Optional kd-tree of the kernel-whitened data,
+                                            used to accelerate evaluation of the KDE. */
 } LALInferenceKDE;
 
+/** Minimum number of points for which the clustered-KDE builds a kd-tree for evaluation. */
+#define LALINFERENCE_KDE_TREE_MIN_PTS 256
+
+/** Default relative error tolerance of kd-tree evaluations of a KDE. */
+#define LALINFERENCE_KDE_TREE_RTOL 1e-8
+
 /* Allocate, fill, and tune a Gaussian kernel density estimate given an array of points. */
 LALInferenceKDE *LALInferenceNewKDE(REAL8 *pts, INT4 npts, INT4 dim, INT4 *mask);
 
@@ -71,6 +81,12 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde);
 /* Evaluate the (log) PDF from a KDE at a single point. */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point);
 
+/* Build a kd-tree to accelerate evaluation of a KDE, to a given relative error tolerance. */
+INT4 LALInferenceKDEBuildTree(LALInferenceKDE *kde, REAL8 rtol);
+
+/* Free the kd-tree of a KDE, returning to exact evaluation over all points. */
+void LALInferenceKDEClearTree(LALInferenceKDE *kde);
+
 /* Draw a sample from a kernel density estimate. */
 REAL8 *LALInferenceDrawKDESample(LALInferenceKDE *kde, gsl_rng *rng);
 
@@ -34,6 +34,7 @@
 #include <lal/FrequencySeries.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/LALInferenceDistanceMarg.h>
+#include <lal/LALTrace.h>
 
 #include <gsl/gsl_sf_bessel.h>
 #include <gsl/gsl_sf_dawson.h>
@@ -100,6 +101,29 @@ static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, RE
   return(XLAL_SUCCESS);
 }
 
+/* Returns the spline calibration basis with index k cached in the model, building it on first
+ * use or rebuilding it if the spline nodes or frequencies have changed */
+static LALInferenceSplineCalibrationBasis *get_calib_spline_basis(LALInferenceModel *model, UINT4 k, REAL8Vector *logfreqs, REAL8 deltaF, UINT4 nFreqs, REAL8Sequence *freqs);
+static LALInferenceSplineCalibrationBasis *get_calib_spline_basis(LALInferenceModel *model, UINT4 k, REAL8Vector *logfreqs, REAL8 deltaF, UINT4 nFreqs, REAL8Sequence *freqs)
+{
+  if (k >= model->nSpcalBasis) {
+    model->spcalBasis = XLALRealloc(model->spcalBasis, (k+1)*sizeof(model->spcalBasis[0]));
+    XLAL_CHECK_NULL(model->spcalBasis != NULL, XLAL_ENOMEM);
+    for (UINT4 i = model->nSpcalBasis; i <= k; i++) model->spcalBasis[i] = NULL;
+    model->nSpcalBasis = k+1;
+  }
+  if (!LALInferenceSplineCalibrationBasisMatches(model->spcalBasis[k], logfreqs, deltaF, nFreqs, freqs)) {
+    LALInferenceDestroySplineCalibrationBasis(model->spcalBasis[k]);
+    if (freqs != NULL) {
+      model->spcalBasis[k] = LALInferenceCreateSplineCalibrationBasisFromFrequencies(logfreqs, freqs);
+    } else {
+      model->spcalBasis[k] = LALInferenceCreateSplineCalibrationBasis(logfreqs, deltaF, nFreqs);
+    }
+    XLAL_CHECK_NULL(model->spcalBasis[k] != NULL, XLAL_EFUNC);
+  }
+  return model->spcalBasis[k];
+}
+
 void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 {
     char help[]="\
@@ -117,6 +141,7 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
     (--margtimephi)                  Using marginalised in time and phase likelihood\n\
     (--margdist)                     Using marginalisation in distance with d^2 prior (compatible with --margphi and --margtimephi)\n\
     (--margdist-comoving)            Using marginalisation in distance with uniform-in-comoving-volume prior (compatible with --margphi and --margtimephi)\n\
+    (--margdist-cache FILE)          Cache the distance marginalisation lookup tables in FILE.margphi and FILE.nomargphi, reusing them on later runs with the same prior\n\
     \n";
 
     /* Print command line arguments if help requested */
@@ -185,6 +210,23 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
       runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
    }
 
+   /* Build the distance marginalisation lookup table up front, before any
+    * threads are started, optionally using an on-disk cache */
+   if (thread->model && LALInferenceCheckVariable(thread->model->params, "MARGDIST")) {
+       REAL8 dist_min, dist_max;
+       INT4 cosmology = 0;
+       INT4 margphi = (runState->likelihood==&LALInferenceMarginalisedPhaseLogLikelihood ||
+                       runState->likelihood==&LALInferenceMarginalisedTimePhaseLogLikelihood);
+       ProcessParamsTable *ppt = LALInferenceGetProcParamVal(commandLine, "--margdist-cache");
+       LALInferenceGetMinMaxPrior(thread->model->params, "logdistance", &dist_min, &dist_max);
+       if (LALInferenceCheckVariable(thread->model->params, "MARGDIST_COSMOLOGY"))
+           cosmology = LALInferenceGetINT4Variable(thread->model->params, "MARGDIST_COSMOLOGY");
+       if (LALInferenceInitMarginalDistanceTable(exp(dist_min), exp(dist_max), cosmology, margphi, ppt ? ppt->value : NULL) != XLAL_SUCCESS) {
+           fprintf(stderr, "ERROR: unable to initialise distance marginalisation lookup table. Exiting...\n");
+           exit(1);
+       }
+   }
+
    /* Try to determine a model-less likelihood, if such a thing makes sense */
    if (runState->likelihood==&LALInferenceUndecomposedFreqDomainLogLikelihood || runState->likelihood==&LALInferenceMarginalisedPhaseLogLikelihood ){
 
@@ -315,10 +357,13 @@ REAL8 LALInferenceUndecomposedFreqDomainLogLikelihood(LALInferenceVariables *cur
                                                       LALInferenceIFOData *data,
                                                       LALInferenceModel *model)
 {
-  return LALInferenceFusedFreqDomainLogLikelihood(currentParams,
+  XLAL_TRACE_START(timer, "LALInferenceUndecomposedFreqDomainLogLikelihood");
+  REAL8 logL = LALInferenceFusedFreqDomainLogLikelihood(currentParams,
                                                  data,
                                                  model,
                                                   GAUSSIAN);
+  XLAL_TRACE_STOP(timer, 0);
+  return logL;
 }
 
 
@@ -687,13 +732,15 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
           phases = NULL;
 	  /* get_calib_spline creates and fills the logfreqs, amps, phases arrays */
 	  get_calib_spline(currentParams, dataPtr->name, &logfreqs, &amps, &phases);
+	  /* the spline nodes are fixed, so the calibration curves are evaluated with bases cached in the model */
 	  if (model->roq_flag) {
-
-             LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases,
-						model->roq->frequencyNodesLinear,
-						&(model->roq->calFactorLinear),
-						model->roq->frequencyNodesQuadratic,
-						&(model->roq->calFactorQuadratic));
+	    LALInferenceSplineCalibrationBasis *basisLin = get_calib_spline_basis(model, 2*ifo, logfreqs, 0.0, 0, model->roq->frequencyNodesLinear);
+	    LALInferenceSplineCalibrationBasis *basisQuad = get_calib_spline_basis(model, 2*ifo+1, logfreqs, 0.0, 0, model->roq->frequencyNodesQuadratic);
+	    if (basisLin == NULL || basisQuad == NULL
+	        || LALInferenceSplineCalibrationFactorFromBasis(basisLin, amps, phases, model->roq->calFactorLinear->data) != XLAL_SUCCESS
+	        || LALInferenceSplineCalibrationFactorFromBasis(basisQuad, amps, phases, model->roq->calFactorQuadratic->data) != XLAL_SUCCESS) {
+	      XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to compute spline calibration factors");
+	    }
 	  }
 
 	  else{
@@ -704,7 +751,10 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
                        &lalDimensionlessUnit,
                        dataPtr->freqData->data->length);
 	    }
-          LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+	    LALInferenceSplineCalibrationBasis *basis = get_calib_spline_basis(model, 2*ifo, logfreqs, calFactor->deltaF, calFactor->data->length, NULL);
+	    if (basis == NULL || LALInferenceSplineCalibrationFactorFromBasis(basis, amps, phases, calFactor->data->data) != XLAL_SUCCESS) {
+	      XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to compute spline calibration factors");
+	    }
 	}
 	if(logfreqs) XLALDestroyREAL8Vector(logfreqs);
 	if(amps) XLALDestroyREAL8Vector(amps);
@@ -1406,34 +1456,113 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   return(loglikelihood);
 }
 
-double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
+/* Lookup tables for the distance-marginalised likelihood. One table is built
+ * for each combination of prior range, cosmology and phase marginalisation,
+ * and kept for the life of the process. */
+typedef struct tagLALInferenceMarginalDistanceTable {
+    double dist_min, dist_max;
+    int cosmology, margphi;
+    double log_norm;
+    log_radial_integrator *integrator;
+    struct tagLALInferenceMarginalDistanceTable *next;
+} LALInferenceMarginalDistanceTable;
+
+static LALInferenceMarginalDistanceTable *marginal_distance_tables = NULL;
+
+/* Base name of the on-disk cache of the tables, or NULL if not caching. The
+ * tables with and without phase marginalisation are cached in separate files,
+ * so that runs which differ only in --margphi do not overwrite each other's
+ * table. */
+static char *marginal_distance_cachefile = NULL;
+
+#define MARGINAL_DISTANCE_TABLE_SIZE 2000 /* CHECKME: fudge factor of 5 compared to bayestar */
+#define MARGINAL_DISTANCE_PMAX 100000 /* CHECKME: Max SNR allowed ? */
+
+/* Find the table for the given arguments, building it if it does not yet
+ * exist. Must be called from within the LALInferenceMarginalDistance critical
+ * section. */
+static LALInferenceMarginalDistanceTable *marginal_distance_get_table(double dist_min, double dist_max, int cosmology, int margphi)
 {
-        static const size_t default_log_radial_integrator_size = 400;
-        double loglikelihood=0;
-        static double log_norm = 0;
-        static log_radial_integrator *integrator;
+    LALInferenceMarginalDistanceTable *table;
+    char *cachefile = NULL;
+    for (table = marginal_distance_tables; table; table = table->next)
+        if (table->dist_min == dist_min && table->dist_max == dist_max && table->cosmology == cosmology && table->margphi == margphi)
+            return table;
+
+    printf("Initialising distance integration lookup table\n");
+    table = malloc(sizeof(*table));
+    if (!table)
+        return NULL;
+    if (marginal_distance_cachefile)
+    {
+        const size_t len = strlen(marginal_distance_cachefile) + sizeof(".nomargphi");
+        cachefile = malloc(len);
+        if (!cachefile)
+        {
+            free(table);
+            return NULL;
+        }
+        snprintf(cachefile, len, "%s.%s", marginal_distance_cachefile, margphi ? "margphi" : "nomargphi");
+    }
+    table->integrator = log_radial_integrator_init_cached(
+                            dist_min,
+                            dist_max,
+                            2, /* Power of distance in prior */
+                            cosmology,
+                            MARGINAL_DISTANCE_PMAX,
+                            MARGINAL_DISTANCE_TABLE_SIZE,
+                            !margphi,
+                            cachefile);
+    free(cachefile);
+    if (!table->integrator)
+    {
+        free(table);
+        return NULL;
+    }
+    table->dist_min = dist_min;
+    table->dist_max = dist_max;
+    table->cosmology = cosmology;
+    table->margphi = margphi;
+    /* distance prior normalisation */
+    table->log_norm = log_radial_integrator_eval(table->integrator, 0, 0, -INFINITY, -INFINITY);
+    table->next = marginal_distance_tables;
+    marginal_distance_tables = table;
+    return table;
+}
 
-        double pmax = 100000; /* CHECKME: Max SNR allowed ? */
-        #pragma omp critical
+int LALInferenceInitMarginalDistanceTable(double dist_min, double dist_max, int cosmology, int margphi, const char *cachefile)
+{
+    LALInferenceMarginalDistanceTable *table;
+    int nomem = 0;
+    #pragma omp critical (LALInferenceMarginalDistance)
+    {
+        /* later tables, for example those built by the likelihood with the
+         * other phase marginalisation, are cached under the same base name */
+        if (cachefile && !(marginal_distance_cachefile && strcmp(marginal_distance_cachefile, cachefile) == 0))
         {
-            if (integrator == NULL)
-            {
-                printf("Initialising distance integration lookup table\n");
-                /* Initialise the integrator for the first time */
-                integrator = log_radial_integrator_init(
-                                dist_min,
-                                dist_max,
-                                2, /* Power of distance in prior */
-                                cosmology,
-                                pmax,
-                                default_log_radial_integrator_size * 5, /* CHECKME: fudge factor of 5 compared to bayestar */
-                                !margphi);
-                /* distance prior normalisation */
-                log_norm = log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY);
-            }
+            free(marginal_distance_cachefile);
+            marginal_distance_cachefile = malloc(strlen(cachefile) + 1);
+            if (marginal_distance_cachefile)
+                strcpy(marginal_distance_cachefile, cachefile);
+            else
+                nomem = 1;
         }
-        #pragma omp barrier
-        if (!integrator) XLAL_ERROR(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
+        table = nomem ? NULL : marginal_distance_get_table(dist_min, dist_max, cosmology, margphi);
+    }
+    XLAL_CHECK(!nomem, XLAL_ENOMEM);
+    XLAL_CHECK(table != NULL, XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
+    return XLAL_SUCCESS;
+}
+
+double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
+{
+        double loglikelihood=0;
+        const double pmax = MARGINAL_DISTANCE_PMAX;
+        LALInferenceMarginalDistanceTable *table;
+
+        #pragma omp critical (LALInferenceMarginalDistance)
+        table = marginal_distance_get_table(dist_min, dist_max, cosmology, margphi);
+        if (!table) XLAL_ERROR(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
         
         if (isnan(OptimalSNR) || isnan(d_inner_h) || pmax<OptimalSNR)
         {
@@ -1442,8 +1571,8 @@ double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_ma
         }
         else
         {
-            double marg_l = log_radial_integrator_eval(integrator, OptimalSNR , d_inner_h, log(OptimalSNR), log(d_inner_h));
-            loglikelihood = marg_l - log_norm; /* Normalise prior */
+            double marg_l = log_radial_integrator_eval(table->integrator, OptimalSNR , d_inner_h, log(OptimalSNR), log(d_inner_h));
+            loglikelihood = marg_l - table->log_norm; /* Normalise prior */
         }
         return (loglikelihood);
 }
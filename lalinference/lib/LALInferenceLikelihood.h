@@ -184,6 +184,14 @@ REAL8 LALInferenceMarginalisedTimePhaseLogLikelihood(LALInferenceVariables *curr
     margphi: 0 = use gaussian likelihood, 1 = phase-marginalised bessel likelihood */
 double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi);
 
+/** Build the lookup table used by LALInferenceMarginalDistanceLogLikelihood() for the given
+  * distance prior range, cosmology and margphi flag. If cachefile is not NULL the table is
+  * read from cachefile.margphi or cachefile.nomargphi, according to margphi, when it matches,
+  * and written to it otherwise; tables built later by the likelihood use the same files.
+  * Calling this before sampling avoids building the table inside a threaded likelihood
+  * evaluation. */
+int LALInferenceInitMarginalDistanceTable(double dist_min, double dist_max, int cosmology, int margphi, const char *cachefile);
+
 
 /**
  * Returns the log-likelihood marginalised over the time dimension
@@ -469,6 +469,7 @@ LALInferenceVariables *LALInferenceParseProposalArgs(LALInferenceRunState *runSt
     if (singleadapt){
       LALInferenceModel *model = LALInferenceInitCBCModel(runState);
       LALInferenceSetupAdaptiveProposals(propArgs, model->params);
+      LALInferenceModelClearSplineCalibrationBases(model);
       XLALFree(model);
     }
 
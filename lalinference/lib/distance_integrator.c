@@ -17,6 +17,10 @@
  * MA  02110-1301  USA
  */
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
 #include "bayestar_cosmology.h"
 #include "omp_interruptible.h"
 
@@ -266,8 +270,90 @@ double log_radial_integral(double r1, double r2, double p, double b, int k,
 }
 
 
+/* On-disk cache of the tabulated integral. The file holds a short header
+ * recording the arguments the table was built with, followed by the
+ * size * size table of log integrals in native byte order. */
+static const char log_radial_cache_magic[8] = {'L','I','D','M','A','R','G','1'};
+
+typedef struct tag_log_radial_cache_header {
+    char magic[8];
+    double r1, r2, pmax;
+    int32_t k, cosmology, gaussian, pad;
+    uint64_t size;
+} log_radial_cache_header;
+
+static void log_radial_cache_header_init(log_radial_cache_header *header,
+    double r1, double r2, int k, int cosmology, double pmax, size_t size,
+    int gaussian)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, log_radial_cache_magic, sizeof(header->magic));
+    header->r1 = r1;
+    header->r2 = r2;
+    header->pmax = pmax;
+    header->k = k;
+    header->cosmology = cosmology;
+    header->gaussian = gaussian;
+    header->size = size;
+}
+
+/* Read a cached table into z0, returning 1 if the file exists and was built
+ * with exactly the same arguments, 0 otherwise. */
+static int log_radial_cache_read(const char *filename,
+    const log_radial_cache_header *expected, double *z0)
+{
+    log_radial_cache_header header;
+    const size_t n = expected->size * expected->size;
+    int ok = 0;
+    FILE *fp = fopen(filename, "rb");
+    if (!fp)
+        return 0;
+    if (fread(&header, sizeof(header), 1, fp) == 1
+        && memcmp(&header, expected, sizeof(header)) == 0
+        && fread(z0, sizeof(*z0), n, fp) == n)
+        ok = 1;
+    fclose(fp);
+    return ok;
+}
+
+/* Write the table to filename. The data go to a temporary file which is
+ * renamed into place, so that concurrent jobs never see a partial table. */
+static int log_radial_cache_write(const char *filename,
+    const log_radial_cache_header *header, const double *z0)
+{
+    const size_t n = header->size * header->size;
+    const size_t len = strlen(filename) + 32;
+    char *tmpname = malloc(len);
+    int ok = 0;
+    FILE *fp;
+    if (!tmpname)
+        return 0;
+    snprintf(tmpname, len, "%s.tmp.%ld", filename, (long) getpid());
+    fp = fopen(tmpname, "wb");
+    if (fp)
+    {
+        ok = fwrite(header, sizeof(*header), 1, fp) == 1
+            && fwrite(z0, sizeof(*z0), n, fp) == n;
+        ok = (fclose(fp) == 0) && ok;
+        ok = ok && rename(tmpname, filename) == 0;
+        if (!ok)
+            remove(tmpname);
+    }
+    free(tmpname);
+    return ok;
+}
+
+
 log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, int cosmology,
                                                   double pmax, size_t size, int gaussian)
+{
+    return log_radial_integrator_init_cached(r1, r2, k, cosmology, pmax, size, gaussian, NULL);
+}
+
+
+log_radial_integrator *log_radial_integrator_init_cached(double r1, double r2, int k, int cosmology,
+                                                         double pmax, size_t size, int gaussian,
+                                                         const char *cachefile)
 {
     log_radial_integrator *integrator = NULL;
     bicubic_interp *region0 = NULL;
@@ -296,7 +382,18 @@ log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, i
     */
     /* const double umax = xmax - vmax; */ /* unused */
 
-    if(cosmology) dVC_dVL_init();
+    log_radial_cache_header header;
+    int cached = 0;
+    log_radial_cache_header_init(&header, r1, r2, k, cosmology, pmax, size, gaussian);
+
+    if(cosmology && !dVC_dVL_interp) dVC_dVL_init();
+
+    if (cachefile)
+    {
+        cached = log_radial_cache_read(cachefile, &header, z0);
+        if (cached)
+            fprintf(stderr, "Read distance integration lookup table from %s\n", cachefile);
+    }
     
     int interrupted=0;
     OMP_BEGIN_INTERRUPTIBLE
@@ -304,8 +401,10 @@ log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, i
     /* Temporarily turn off gsl_error handler which isn't thread safe. */
     gsl_error_handler_t *old_handler = gsl_set_error_handler_off();
 
+    /* Skip the quadrature entirely if the table was read from the cache. */
+    const size_t ntable = cached ? 0 : size * size;
     #pragma omp parallel for
-    for (size_t i = 0; i < size * size; i ++)
+    for (size_t i = 0; i < ntable; i ++)
     {
 
         if (OMP_WAS_INTERRUPTED)
@@ -326,6 +425,14 @@ log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, i
 	if (OMP_WAS_INTERRUPTED)
         goto done;
 
+    if (cachefile && !cached)
+    {
+        if (log_radial_cache_write(cachefile, &header, z0))
+            fprintf(stderr, "Wrote distance integration lookup table to %s\n", cachefile);
+        else
+            fprintf(stderr, "Warning: unable to write distance integration lookup table to %s\n", cachefile);
+    }
+
     region0 = bicubic_interp_init(z0, size, size, xmin, ymin, d, d);
 
     for (size_t i = 0; i < size; i ++)
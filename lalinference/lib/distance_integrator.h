@@ -43,6 +43,16 @@ double log_radial_integral(double r1, double r2, double p, double b, int k,
  */
 log_radial_integrator *log_radial_integrator_init(double r1, double r2, int k, int cosmology, double pmax, size_t size, int gaussian);
 
+/**
+ * As log_radial_integrator_init(), but keep the tabulated integral in an
+ * on-disk cache. If \a cachefile holds a table built with identical
+ * arguments it is read instead of repeating the quadrature; otherwise the
+ * table is computed and written to \a cachefile. Failing to write the
+ * cache is not an error. If \a cachefile is NULL no cache is used.
+ * @param cachefile Path of the cache file, or NULL
+ */
+log_radial_integrator *log_radial_integrator_init_cached(double r1, double r2, int k, int cosmology, double pmax, size_t size, int gaussian, const char *cachefile);
+
 /**
  * Free an integrator
  */
@@ -5,6 +5,7 @@
 
 #include <time.h>
 #include <math.h>
+#include <string.h>
 
 /* check whether to include omp.h for use of multiple cores */
 #ifdef HAVE_OPENMP
@@ -120,14 +121,82 @@ int main(void) {
     }
   }
 
-  /* create reduced orthonormal basis from training set for linear part */
+  /* create reduced orthonormal bases with the blocked algorithm (before the training sets get normalised) */
+  REAL8Array *RBblocked = NULL, *RBstream = NULL, *TScopy = NULL;
+  COMPLEX16Array *cRBblocked = NULL, *cTScopy = NULL;
+  UINT4Vector *gdptsblocked = NULL, *gdptsstream = NULL;
+  LALInferenceROQTrainingSet *rts = NULL;
   REAL8 maxprojerr = 0.;
+
+  TScopy = XLALCreateREAL8Array( TS->dimLength );
+  memcpy(TScopy->data, TS->data, TSsize*wl*sizeof(REAL8));
+  cTScopy = XLALCreateCOMPLEX16Array( cTS->dimLength );
+  memcpy(cTScopy->data, cTS->data, TSsize*wl*sizeof(COMPLEX16));
+
+  rts = LALInferenceCreateREAL8ROQTrainingSet(TS);
+  maxprojerr = LALInferenceGenerateREAL8OrthonormalBasisBlocked(&RBblocked, fweights, tolerance, rts, &gdptsblocked, 100);
+  LALInferenceRemoveROQTrainingSet( rts );
+  fprintf(stderr, "No. linear nodes (real, blocked) = %d, %d x %d; Maximum projection err. = %le\n", RBblocked->dimLength->data[0], RBblocked->dimLength->data[0], RBblocked->dimLength->data[1], maxprojerr);
+
+  /* stream the same training set from a file, which should give an identical basis */
+  FILE *tsfp = fopen("LALInferenceGenerateROQTest_ts.dat", "wb");
+  if ( tsfp == NULL ) { return 1; }
+  if ( fwrite(TS->data, sizeof(REAL8), TSsize*wl, tsfp) != TSsize*wl ) {
+    fclose(tsfp);
+    remove("LALInferenceGenerateROQTest_ts.dat");
+    return 1;
+  }
+  fclose(tsfp);
+  rts = LALInferenceOpenROQTrainingSetFile("LALInferenceGenerateROQTest_ts.dat", 0, wl, 0);
+  if ( rts == NULL || rts->rows != TSsize ) {
+    remove("LALInferenceGenerateROQTest_ts.dat");
+    return 1;
+  }
+  LALInferenceGenerateREAL8OrthonormalBasisBlocked(&RBstream, fweights, tolerance, rts, &gdptsstream, 100);
+  LALInferenceRemoveROQTrainingSet( rts );
+  remove("LALInferenceGenerateROQTest_ts.dat");
+  if ( gdptsstream->length != gdptsblocked->length || memcmp(gdptsstream->data, gdptsblocked->data, gdptsblocked->length*sizeof(UINT4)) ) {
+    fprintf(stderr, "Error... streamed and in-memory blocked bases differ\n");
+    return 1;
+  }
+  XLALDestroyREAL8Array( RBstream );
+  XLALDestroyUINT4Vector( gdptsstream );
+  XLALDestroyUINT4Vector( gdptsblocked );
+
+  /* check the blocked basis represents the training set to within the tolerance */
+  if ( LALInferenceTestREAL8OrthonormalBasis(fweights, 10.*tolerance, RBblocked, &TScopy) != XLAL_SUCCESS ) {
+    fprintf(stderr, "Error... blocked real basis does not meet the tolerance\n");
+    return 1;
+  }
+
+  rts = LALInferenceCreateCOMPLEX16ROQTrainingSet(cTS);
+  maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasisBlocked(&cRBblocked, fweights, tolerance, rts, &gdptsblocked, 0);
+  LALInferenceRemoveROQTrainingSet( rts );
+  XLALDestroyUINT4Vector( gdptsblocked );
+  fprintf(stderr, "No. linear nodes (complex, blocked) = %d, %d x %d; Maximum projection err. = %le\n", cRBblocked->dimLength->data[0], cRBblocked->dimLength->data[0], cRBblocked->dimLength->data[1], maxprojerr);
+
+  if ( LALInferenceTestCOMPLEX16OrthonormalBasis(fweights, 10.*tolerance, cRBblocked, &cTScopy) != XLAL_SUCCESS ) {
+    fprintf(stderr, "Error... blocked complex basis does not meet the tolerance\n");
+    return 1;
+  }
+  XLALDestroyREAL8Array( TScopy );
+  XLALDestroyCOMPLEX16Array( cTScopy );
+
+  /* create reduced orthonormal basis from training set for linear part */
   maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBlinear, fweights, tolerance, &TS, &gdpts);
   XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. linear nodes (real) = %d, %d x %d; Maximum projection err. = %le\n", RBlinear->dimLength->data[0], RBlinear->dimLength->data[0], RBlinear->dimLength->data[1], maxprojerr);
   maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasis(&cRBlinear, fweights, tolerance, &cTS, &gdpts);
   XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. linear nodes (complex) = %d, %d x %d; Maximum projection err. = %le\n", cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[1], maxprojerr);
+
+  /* the blocked algorithm should give the same size of basis as the standard algorithm */
+  if ( RBblocked->dimLength->data[0] != RBlinear->dimLength->data[0] || cRBblocked->dimLength->data[0] != cRBlinear->dimLength->data[0] ) {
+    fprintf(stderr, "Error... blocked and standard bases have different sizes\n");
+    return 1;
+  }
+  XLALDestroyREAL8Array( RBblocked );
+  XLALDestroyCOMPLEX16Array( cRBblocked );
   maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBquad, fweights, tolerance, &TSquad, &gdpts);
   XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. quadratic nodes (real)  = %d, %d x %d; Maximum projection err. = %le\n", RBquad->dimLength->data[0], RBquad->dimLength->data[0], RBquad->dimLength->data[1], maxprojerr);
@@ -0,0 +1,125 @@
+/*
+ *  LALInferenceKDETest.c:  Unit tests for the tree-accelerated KDE evaluation.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALInferenceKDE.h>
+
+/* number of sample points in the KDE, and number of evaluation points */
+#define NPTS 4000
+#define NEVAL 200
+#define DIM 3
+
+/* tolerance used for the approximate tree, and the allowed error in log(pdf) */
+#define RTOL 1e-3
+#define LOGTOL 1e-2
+
+int main(void) {
+  INT4 i, j;
+  REAL8 *pts = NULL, *eval = NULL, *exact = NULL;
+  REAL8 maxerr;
+  LALInferenceKDE *kde = NULL;
+  gsl_rng *rng = NULL;
+
+  rng = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(rng, 5);
+
+  /* correlated, bimodal point cloud */
+  pts = XLALMalloc(NPTS * DIM * sizeof(REAL8));
+  for (i = 0; i < NPTS; i++) {
+    REAL8 x = gsl_ran_gaussian(rng, 1.0) + (i % 2 ? 4.0 : 0.0);
+    REAL8 y = 0.8 * x + gsl_ran_gaussian(rng, 0.5);
+    REAL8 z = gsl_ran_gaussian(rng, 3.0);
+    pts[i*DIM] = x;
+    pts[i*DIM+1] = y;
+    pts[i*DIM+2] = z;
+  }
+
+  eval = XLALMalloc(NEVAL * DIM * sizeof(REAL8));
+  for (i = 0; i < NEVAL; i++)
+    for (j = 0; j < DIM; j++)
+      eval[i*DIM+j] = pts[(i*17 % NPTS)*DIM+j] + gsl_ran_gaussian(rng, 2.0);
+
+  kde = LALInferenceNewKDE(pts, NPTS, DIM, NULL);
+  if (!kde) {
+    fprintf(stderr, "Error: could not create KDE\n");
+    return 1;
+  }
+
+  exact = XLALMalloc(NEVAL * sizeof(REAL8));
+  for (i = 0; i < NEVAL; i++)
+    exact[i] = LALInferenceKDEEvaluatePoint(kde, &eval[i*DIM]);
+
+  /* a tree with zero tolerance never approximates, so must agree to rounding */
+  if (LALInferenceKDEBuildTree(kde, 0.0) != XLAL_SUCCESS) {
+    fprintf(stderr, "Error: could not build exact KDE tree\n");
+    return 1;
+  }
+
+  maxerr = 0.0;
+  for (i = 0; i < NEVAL; i++) {
+    REAL8 val = LALInferenceKDEEvaluatePoint(kde, &eval[i*DIM]);
+    if (fabs(val - exact[i]) > maxerr)
+      maxerr = fabs(val - exact[i]);
+  }
+  if (maxerr > 1e-9) {
+    fprintf(stderr, "Error: exact tree evaluation differs from direct sum by %le\n", maxerr);
+    return 1;
+  }
+
+  /* an approximating tree should stay within the requested tolerance */
+  if (LALInferenceKDEBuildTree(kde, RTOL) != XLAL_SUCCESS) {
+    fprintf(stderr, "Error: could not build approximate KDE tree\n");
+    return 1;
+  }
+
+  maxerr = 0.0;
+  for (i = 0; i < NEVAL; i++) {
+    REAL8 val = LALInferenceKDEEvaluatePoint(kde, &eval[i*DIM]);
+    if (fabs(val - exact[i]) > maxerr)
+      maxerr = fabs(val - exact[i]);
+  }
+  if (maxerr > LOGTOL) {
+    fprintf(stderr, "Error: approximate tree evaluation differs from direct sum by %le\n", maxerr);
+    return 1;
+  }
+
+  /* resetting the bandwidth must drop the tree, leaving exact evaluation */
+  LALInferenceSetKDEBandwidth(kde);
+  if (kde->tree != NULL) {
+    fprintf(stderr, "Error: KDE tree not removed when bandwidth was reset\n");
+    return 1;
+  }
+
+  LALInferenceDestroyKDE(kde);
+  XLALFree(pts);
+  XLALFree(eval);
+  XLALFree(exact);
+  gsl_rng_free(rng);
+
+  LALCheckMemoryLeaks();
+
+  return 0;
+}
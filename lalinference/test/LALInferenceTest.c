@@ -59,6 +59,9 @@ int LALInferenceProcessParamLine_TEST_CHARFILE(void);
 /*  LALInferenceExecuteFT tests */
 int LALInferenceExecuteFTTEST_NULLPLAN(void);
 
+/*  LALInferenceSplineCalibrationBasis tests */
+int LALInferenceSplineCalibrationBasisTEST(void);
+
 int main(void){
     
 	int failureCount = 0;
@@ -77,6 +80,8 @@ int main(void){
 	printf("\n");
 	failureCount += LALInferenceExecuteFTTEST_NULLPLAN();
 	printf("\n");
+	failureCount += LALInferenceSplineCalibrationBasisTEST();
+	printf("\n");
 	printf("Test results: %i failure(s).\n", failureCount);
 
 	return failureCount;
@@ -357,6 +362,90 @@ int LALInferenceExecuteFTTEST_NULLPLAN(void){
 }
 
 
+/*****************     TEST CODE for LALInferenceSplineCalibrationBasis     *****************/
+/* Test that the calibration factors computed with a precomputed basis agree with
+   LALInferenceSplineCalibrationFactor() and LALInferenceSplineCalibrationFactorROQ(). */
+
+int LALInferenceSplineCalibrationBasisTEST(void){
+
+    TEST_HEADER();
+
+    const UINT4 ncal = 10, length = 4097, nnodes = 200;
+    const REAL8 deltaF = 0.5, fmin = 20.0, fmax = 1800.0, tol = 1e-12;
+    LIGOTimeGPS epoch = {0, 0};
+    UINT4 i;
+
+    REAL8Vector *logfreqs = XLALCreateREAL8Vector(ncal);
+    REAL8Vector *amps = XLALCreateREAL8Vector(ncal);
+    REAL8Vector *phases = XLALCreateREAL8Vector(ncal);
+    for (i = 0; i < ncal; i++) {
+        logfreqs->data[i] = log(fmin) + i*(log(fmax) - log(fmin))/(ncal - 1);
+        amps->data[i] = 0.1*sin(1.3*i);
+        phases->data[i] = 0.05*cos(0.7*i);
+    }
+
+    /* Uniform frequency grid */
+    COMPLEX16FrequencySeries *calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors", &epoch, 0, deltaF, &lalDimensionlessUnit, length);
+    COMPLEX16 *calFactorBasis = XLALCalloc(length, sizeof(COMPLEX16));
+    LALInferenceSplineCalibrationBasis *basis = LALInferenceCreateSplineCalibrationBasis(logfreqs, deltaF, length);
+    if (basis == NULL) {
+        TEST_FAIL("Could not create spline calibration basis; XLAL error: %s.", XLALErrorString(xlalErrno));
+    } else {
+        if (!LALInferenceSplineCalibrationBasisMatches(basis, logfreqs, deltaF, length, NULL)
+            || LALInferenceSplineCalibrationBasisMatches(basis, logfreqs, 2*deltaF, length, NULL)) {
+            TEST_FAIL("Spline calibration basis does not match the frequencies it was built for.");
+        }
+        if (LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor) != XLAL_SUCCESS
+            || LALInferenceSplineCalibrationFactorFromBasis(basis, amps, phases, calFactorBasis) != XLAL_SUCCESS) {
+            TEST_FAIL("Could not compute calibration factors; XLAL error: %s.", XLALErrorString(xlalErrno));
+        }
+        for (i = 0; i < length; i++) {
+            if (cabs(calFactorBasis[i] - calFactor->data->data[i]) > tol) {
+                TEST_FAIL("Calibration factors differ at bin %u: %g%+gi != %g%+gi.", i, creal(calFactorBasis[i]), cimag(calFactorBasis[i]), creal(calFactor->data->data[i]), cimag(calFactor->data->data[i]));
+                break;
+            }
+        }
+    }
+    LALInferenceDestroySplineCalibrationBasis(basis);
+
+    /* Irregular frequency nodes in shuffled order, partly outside the range of the spline nodes */
+    REAL8Sequence *nodes = XLALCreateREAL8Sequence(nnodes);
+    COMPLEX16Sequence *calFactorNodes = XLALCreateCOMPLEX16Sequence(nnodes);
+    COMPLEX16Sequence *calFactorQuad = XLALCreateCOMPLEX16Sequence(nnodes);
+    for (i = 0; i < nnodes; i++) {
+        nodes->data[i] = 10.0 + 2000.0*pow((REAL8)((37*i) % nnodes)/(nnodes - 1), 2);
+    }
+    basis = LALInferenceCreateSplineCalibrationBasisFromFrequencies(logfreqs, nodes);
+    if (basis == NULL) {
+        TEST_FAIL("Could not create spline calibration basis; XLAL error: %s.", XLALErrorString(xlalErrno));
+    } else {
+        if (LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases, nodes, &calFactorNodes, nodes, &calFactorQuad) != XLAL_SUCCESS
+            || LALInferenceSplineCalibrationFactorFromBasis(basis, amps, phases, calFactorBasis) != XLAL_SUCCESS) {
+            TEST_FAIL("Could not compute calibration factors; XLAL error: %s.", XLALErrorString(xlalErrno));
+        }
+        for (i = 0; i < nnodes; i++) {
+            if (cabs(calFactorBasis[i] - calFactorNodes->data[i]) > tol) {
+                TEST_FAIL("Calibration factors differ at node %u: %g%+gi != %g%+gi.", i, creal(calFactorBasis[i]), cimag(calFactorBasis[i]), creal(calFactorNodes->data[i]), cimag(calFactorNodes->data[i]));
+                break;
+            }
+        }
+    }
+    LALInferenceDestroySplineCalibrationBasis(basis);
+
+    XLALDestroyCOMPLEX16Sequence(calFactorQuad);
+    XLALDestroyCOMPLEX16Sequence(calFactorNodes);
+    XLALDestroyREAL8Sequence(nodes);
+    XLALFree(calFactorBasis);
+    XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+    XLALDestroyREAL8Vector(phases);
+    XLALDestroyREAL8Vector(amps);
+    XLALDestroyREAL8Vector(logfreqs);
+
+    TEST_FOOTER();
+
+}
+
+
 /******************************************
  * 
  * Old tests
@@ -0,0 +1,102 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with with program; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301  USA
+ */
+
+
+#include <lal/distance_integrator.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_math.h>
+#include <assert.h>
+#include <stdio.h>
+
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#define CACHEFILE "test_distance_integrator.dat"
+#define SIZE 64
+
+
+static void compare_integrators(const log_radial_integrator *a,
+    const log_radial_integrator *b, const char *desc)
+{
+    for (double p = 0.5; p < 50; p *= 1.5)
+    {
+        for (double b_over_p = 0.1; b_over_p < 4; b_over_p *= 1.7)
+        {
+            const double bb = b_over_p * p;
+            const double result = log_radial_integrator_eval(
+                b, p, bb, log(p), log(bb));
+            const double expected = log_radial_integrator_eval(
+                a, p, bb, log(p), log(bb));
+            gsl_test_abs(result, expected, 0,
+                "testing %s for p=%g, b=%g", desc, p, bb);
+        }
+    }
+}
+
+
+int main(int UNUSED argc, char UNUSED **argv)
+{
+    log_radial_integrator *direct, *written, *read, *other;
+
+    remove(CACHEFILE);
+
+    direct = log_radial_integrator_init(1, 1000, 2, 0, 1000, SIZE, 0);
+    assert(direct);
+
+    /* No cache file yet: the table is computed and written out */
+    written = log_radial_integrator_init_cached(
+        1, 1000, 2, 0, 1000, SIZE, 0, CACHEFILE);
+    assert(written);
+    compare_integrators(direct, written, "distance integrator written to cache");
+
+    /* Same arguments: the table is read back and must agree exactly */
+    read = log_radial_integrator_init_cached(
+        1, 1000, 2, 0, 1000, SIZE, 0, CACHEFILE);
+    assert(read);
+    compare_integrators(direct, read, "distance integrator read from cache");
+
+    /* Different prior range: the stale cache must not be used */
+    other = log_radial_integrator_init_cached(
+        1, 2000, 2, 0, 1000, SIZE, 0, CACHEFILE);
+    assert(other);
+    log_radial_integrator_free(direct);
+    direct = log_radial_integrator_init(1, 2000, 2, 0, 1000, SIZE, 0);
+    assert(direct);
+    compare_integrators(direct, other, "distance integrator with mismatched cache");
+
+    /* Different likelihood (no phase marginalisation): the stale cache must not be used */
+    log_radial_integrator_free(other);
+    other = log_radial_integrator_init_cached(
+        1, 2000, 2, 0, 1000, SIZE, 1, CACHEFILE);
+    assert(other);
+    log_radial_integrator_free(direct);
+    direct = log_radial_integrator_init(1, 2000, 2, 0, 1000, SIZE, 1);
+    assert(direct);
+    compare_integrators(direct, other, "gaussian distance integrator with mismatched cache");
+
+    log_radial_integrator_free(direct);
+    log_radial_integrator_free(written);
+    log_radial_integrator_free(read);
+    log_radial_integrator_free(other);
+    remove(CACHEFILE);
+
+    return gsl_test_summary();
+}
@@ -24,9 +24,14 @@
 #include <lal/ComplexFFT.h>
 #include <lal/XLALError.h>
 #include <lal/FrequencySeries.h>
+#include <lal/VectorMath.h>
 #include <lal/LALInspiralSBankOverlap.h>
 #include <sys/types.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define MAX_NUM_WS 32  /* maximum number of workspaces */
 #define CHECK_OOM(ptr, msg) if (!(ptr)) { XLALPrintError((msg)); XLAL_ERROR_NULL(XLAL_ENOMEM); }
 
@@ -81,17 +86,9 @@ static WS *get_workspace(WS *workspace_cache, const size_t n) {
     return ptr;
 }
 
-/* by default, complex arithmetic will call built-in function __muldc3, which does a lot of error checking for inf and nan; just do it manually */
+/* by default, complex arithmetic will call built-in function __muldc3, which does a lot of error checking for inf and nan; use the SIMD vector routine instead */
 static void multiply_conjugate(COMPLEX8 * restrict out, COMPLEX8 *a, COMPLEX8 *b, const size_t size) {
-    size_t k = 0;
-    for (;k < size; ++k) {
-        const float ar = crealf(a[k]);
-        const float br = crealf(b[k]);
-        const float ai = cimagf(a[k]);
-        const float bi = cimagf(b[k]);
-        __real__ out[k] = ar * br + ai * bi;
-        __imag__ out[k] = ar * -bi + ai * br;
-    }
+    XLALVectorMultiplyConjCOMPLEX8(out, a, b, size);
 }
 
 static double abs_real(const COMPLEX8 x) {
@@ -353,3 +350,239 @@ REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySerie
     /* Return match */
     return 4. * proposal->deltaF * sqrt(max);
 }
+
+/*
+ * Batch evaluation: score one proposal against many templates.  The match
+ * of template k is computed by match_func(batch, k, thread), where thread
+ * selects the workspace caches to use.
+ */
+
+typedef REAL8 (*SBankMatchFunc)(const void *batch, size_t k, size_t thread);
+
+static int compute_match_batch(REAL8 *matches, size_t *first_cover, size_t ntmplts, REAL8 min_match, size_t ncaches, SBankMatchFunc match_func, const void *batch) {
+    size_t cover = ntmplts;
+    long k;
+    int errnum = 0;
+    (void) ncaches;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(ncaches)
+#endif
+    for (k = 0; k < (long) ntmplts; ++k) {
+        size_t thread = 0;
+        int skip;
+        REAL8 match;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#pragma omp critical (SBankComputeMatchBatch)
+#endif
+        skip = errnum || (size_t) k > cover;
+
+        /* a template before this one already covers the proposal */
+        if (skip) {
+            matches[k] = 0.;
+            continue;
+        }
+
+        match = match_func(batch, k, thread);
+        matches[k] = match;
+        if (isnan(match)) {
+#ifdef _OPENMP
+#pragma omp critical (SBankComputeMatchBatch)
+#endif
+            errnum = XLAL_EFUNC;
+        } else if (match > min_match) {
+#ifdef _OPENMP
+#pragma omp critical (SBankComputeMatchBatch)
+#endif
+            if ((size_t) k < cover)
+                cover = k;
+        }
+    }
+    XLAL_CHECK(errnum == 0, errnum);
+
+    /* templates after the first cover may have been scored before it was found */
+    for (k = cover + 1; k < (long) ntmplts; ++k)
+        matches[k] = 0.;
+    if (first_cover)
+        *first_cover = cover;
+    return XLAL_SUCCESS;
+}
+
+typedef struct {
+    const COMPLEX8FrequencySeries *proposal;
+    const COMPLEX8FrequencySeries *const *tmplts;
+    WS **workspace_caches;
+} MatchBatch;
+
+static REAL8 match_batch_func(const void *batch, size_t k, size_t thread) {
+    const MatchBatch *b = batch;
+    return XLALInspiralSBankComputeMatch(b->proposal, b->tmplts[k], b->workspace_caches[thread]);
+}
+
+/*
+ * Computes matches[k] = XLALInspiralSBankComputeMatch(proposal, tmplts[k])
+ * for ntmplts templates.  If LAL is built with OpenMP, up to ncaches
+ * templates are scored in parallel, thread i using the workspace cache
+ * workspace_caches[i] (each created with XLALCreateSBankWorkspaceCache).
+ *
+ * Scoring stops early once a template whose match exceeds min_match is
+ * found: *first_cover (if not NULL) is set to the index of the first such
+ * template in the order given, or to ntmplts if there is none, and the
+ * matches of the templates after it are set to zero.  The result is the
+ * same as scoring the templates one at a time in order.  Pass a min_match
+ * of INFINITY to score every template.
+ */
+int XLALInspiralSBankComputeMatchBatch(REAL8 *matches, size_t *first_cover, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *tmplts, size_t ntmplts, REAL8 min_match, WS **workspace_caches, size_t ncaches) {
+    MatchBatch batch = {proposal, tmplts, workspace_caches};
+    XLAL_CHECK(matches && proposal && (tmplts || ntmplts == 0) && workspace_caches, XLAL_EFAULT);
+    XLAL_CHECK(ncaches > 0, XLAL_EINVAL, "At least one workspace cache is required");
+    return compute_match_batch(matches, first_cover, ntmplts, min_match, ncaches, match_batch_func, &batch);
+}
+
+typedef struct {
+    const COMPLEX8FrequencySeries *proposal;
+    const COMPLEX8FrequencySeries *const *hps;
+    const COMPLEX8FrequencySeries *const *hcs;
+    const REAL8 *hphccorrs;
+    WS **workspace_caches1;
+    WS **workspace_caches2;
+} MatchMaxSkyLocBatch;
+
+static REAL8 match_max_sky_loc_batch_func(const void *batch, size_t k, size_t thread) {
+    const MatchMaxSkyLocBatch *b = batch;
+    return XLALInspiralSBankComputeMatchMaxSkyLoc(b->hps[k], b->hcs[k], b->hphccorrs[k], b->proposal, b->workspace_caches1[thread], b->workspace_caches2[thread]);
+}
+
+/*
+ * As XLALInspiralSBankComputeMatchBatch, but computes
+ * XLALInspiralSBankComputeMatchMaxSkyLoc(hps[k], hcs[k], hphccorrs[k],
+ * proposal) for each template k; thread i uses the workspace caches
+ * workspace_caches1[i] and workspace_caches2[i].
+ */
+int XLALInspiralSBankComputeMatchMaxSkyLocBatch(REAL8 *matches, size_t *first_cover, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *hps, const COMPLEX8FrequencySeries *const *hcs, const REAL8 *hphccorrs, size_t ntmplts, REAL8 min_match, WS **workspace_caches1, WS **workspace_caches2, size_t ncaches) {
+    MatchMaxSkyLocBatch batch = {proposal, hps, hcs, hphccorrs, workspace_caches1, workspace_caches2};
+    XLAL_CHECK(matches && proposal && ((hps && hcs && hphccorrs) || ntmplts == 0) && workspace_caches1 && workspace_caches2, XLAL_EFAULT);
+    XLAL_CHECK(ncaches > 0, XLAL_EINVAL, "At least one workspace cache is required");
+    return compute_match_batch(matches, first_cover, ntmplts, min_match, ncaches, match_max_sky_loc_batch_func, &batch);
+}
+
+/*
+ * Containers for the batch functions that can be built from the SWIG
+ * bindings, e.g. by lalinspiral.sbank.bank.Bank.covers().
+ */
+
+/*
+ * Creates an array of length waveforms, all NULL; the waveforms are
+ * not owned by the array, and are not destroyed with it.
+ */
+SBankWaveformVector *XLALCreateSBankWaveformVector(UINT4 length) {
+    SBankWaveformVector *waveforms = XLALCalloc(1, sizeof(*waveforms));
+    XLAL_CHECK_NULL(waveforms, XLAL_ENOMEM);
+    if (length > 0) {
+        waveforms->data = XLALCalloc(length, sizeof(*waveforms->data));
+        if (!waveforms->data) {
+            XLALFree(waveforms);
+            XLAL_ERROR_NULL(XLAL_ENOMEM);
+        }
+    }
+    waveforms->length = length;
+    return waveforms;
+}
+
+void XLALDestroySBankWaveformVector(SBankWaveformVector *waveforms) {
+    if (!waveforms)
+        return;
+    XLALFree(waveforms->data);
+    XLALFree(waveforms);
+}
+
+/*
+ * Sets element k of waveforms to waveform, which is borrowed: it is not
+ * freed with the array, and must outlive its use by the array.  Unlike
+ * assigning to the array from the SWIG bindings, this does not take
+ * ownership of the waveform away from its wrapping object.
+ */
+int XLALSetSBankWaveformVectorElement(SBankWaveformVector *waveforms, UINT4 k, const COMPLEX8FrequencySeries *waveform) {
+    XLAL_CHECK(waveforms && waveform, XLAL_EFAULT);
+    XLAL_CHECK(k < waveforms->length, XLAL_EDOM, "Index %u is out of range for %u waveforms", k, waveforms->length);
+    waveforms->data[k] = (COMPLEX8FrequencySeries *) waveform;
+    return XLAL_SUCCESS;
+}
+
+/*
+ * Creates length workspace caches, or one per OpenMP thread if length is
+ * zero.
+ */
+SBankWorkspaceCacheVector *XLALCreateSBankWorkspaceCacheVector(UINT4 length) {
+    SBankWorkspaceCacheVector *workspace_caches;
+    UINT4 i;
+    if (length == 0) {
+        length = 1;
+#ifdef _OPENMP
+        length = omp_get_max_threads();
+#endif
+    }
+    workspace_caches = XLALCalloc(1, sizeof(*workspace_caches));
+    XLAL_CHECK_NULL(workspace_caches, XLAL_ENOMEM);
+    workspace_caches->data = XLALCalloc(length, sizeof(*workspace_caches->data));
+    if (!workspace_caches->data) {
+        XLALFree(workspace_caches);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    workspace_caches->length = length;
+    for (i = 0; i < length; ++i) {
+        workspace_caches->data[i] = XLALCreateSBankWorkspaceCache();
+        if (!workspace_caches->data[i]) {
+            XLALDestroySBankWorkspaceCacheVector(workspace_caches);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
+    }
+    return workspace_caches;
+}
+
+void XLALDestroySBankWorkspaceCacheVector(SBankWorkspaceCacheVector *workspace_caches) {
+    UINT4 i;
+    if (!workspace_caches)
+        return;
+    for (i = 0; i < workspace_caches->length; ++i)
+        if (workspace_caches->data[i])
+            XLALDestroySBankWorkspaceCache(workspace_caches->data[i]);
+    XLALFree(workspace_caches->data);
+    XLALFree(workspace_caches);
+}
+
+/*
+ * As XLALInspiralSBankComputeMatchBatch, for the templates tmplts, using
+ * the workspace caches workspace_caches.  matches must have the length of
+ * tmplts; the index of the first template that covers the proposal is
+ * that of the first match above min_match, the matches after it being
+ * zero.
+ */
+int XLALInspiralSBankComputeMatchVector(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const SBankWaveformVector *tmplts, REAL8 min_match, SBankWorkspaceCacheVector *workspace_caches) {
+    UINT4 k;
+    XLAL_CHECK(matches && tmplts && workspace_caches, XLAL_EFAULT);
+    XLAL_CHECK(matches->length == tmplts->length, XLAL_EBADLEN, "Need one match per template");
+    if (tmplts->length == 0)
+        return XLAL_SUCCESS;
+    for (k = 0; k < tmplts->length; ++k)
+        XLAL_CHECK(tmplts->data[k], XLAL_EFAULT, "Template %u is NULL", k);
+    return XLALInspiralSBankComputeMatchBatch(matches->data, NULL, proposal, (const COMPLEX8FrequencySeries *const *) tmplts->data, tmplts->length, min_match, workspace_caches->data, workspace_caches->length);
+}
+
+/*
+ * As XLALInspiralSBankComputeMatchMaxSkyLocBatch, for the templates with
+ * polarizations hps and hcs and correlations hphccorrs, using the
+ * workspace caches workspace_caches1 and workspace_caches2.
+ */
+int XLALInspiralSBankComputeMatchMaxSkyLocVector(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const SBankWaveformVector *hps, const SBankWaveformVector *hcs, const REAL8Vector *hphccorrs, REAL8 min_match, SBankWorkspaceCacheVector *workspace_caches1, SBankWorkspaceCacheVector *workspace_caches2) {
+    UINT4 k;
+    XLAL_CHECK(matches && hps && hcs && hphccorrs && workspace_caches1 && workspace_caches2, XLAL_EFAULT);
+    XLAL_CHECK(matches->length == hps->length && hcs->length == hps->length && hphccorrs->length == hps->length, XLAL_EBADLEN, "Need one polarization pair, correlation and match per template");
+    XLAL_CHECK(workspace_caches1->length == workspace_caches2->length, XLAL_EBADLEN, "Need the same number of workspace caches for each polarization");
+    if (hps->length == 0)
+        return XLAL_SUCCESS;
+    for (k = 0; k < hps->length; ++k)
+        XLAL_CHECK(hps->data[k] && hcs->data[k], XLAL_EFAULT, "Template %u is NULL", k);
+    return XLALInspiralSBankComputeMatchMaxSkyLocBatch(matches->data, NULL, proposal, (const COMPLEX8FrequencySeries *const *) hps->data, (const COMPLEX8FrequencySeries *const *) hcs->data, hphccorrs->data, hps->length, min_match, workspace_caches1->data, workspace_caches2->data, workspace_caches1->length);
+}
@@ -20,3 +20,39 @@ REAL8 XLALInspiralSBankComputeRealMatch(const COMPLEX8FrequencySeries *inj, cons
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLoc(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
 
 REAL8 XLALInspiralSBankComputeMatchMaxSkyLocNoPhase(const COMPLEX8FrequencySeries *hp, const COMPLEX8FrequencySeries *hc, const REAL8 hphccorr, const COMPLEX8FrequencySeries *proposal, WS *workspace_cache1, WS *workspace_cache2);
+
+/* an array of whitened, normalized waveforms, e.g. the templates of a bank near a proposal; the waveforms are not owned by the array, and are set with XLALSetSBankWaveformVectorElement() */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IGNORE_MEMBERS(tagSBankWaveformVector, data));
+#endif /* SWIG */
+typedef struct tagSBankWaveformVector {
+    UINT4 length;
+    COMPLEX8FrequencySeries **data;
+} SBankWaveformVector;
+
+/* one workspace cache per thread, for scoring templates in parallel */
+typedef struct tagSBankWorkspaceCacheVector {
+#ifdef SWIG /* SWIG interface directives */
+    SWIGLAL(ARRAY_1D(SBankWorkspaceCacheVector, WS*, data, UINT4, length));
+#endif /* SWIG */
+    UINT4 length;
+    WS **data;
+} SBankWorkspaceCacheVector;
+
+SBankWaveformVector *XLALCreateSBankWaveformVector(UINT4 length);
+void XLALDestroySBankWaveformVector(SBankWaveformVector *waveforms);
+int XLALSetSBankWaveformVectorElement(SBankWaveformVector *waveforms, UINT4 k, const COMPLEX8FrequencySeries *waveform);
+SBankWorkspaceCacheVector *XLALCreateSBankWorkspaceCacheVector(UINT4 length);
+void XLALDestroySBankWorkspaceCacheVector(SBankWorkspaceCacheVector *workspace_caches);
+
+int XLALInspiralSBankComputeMatchVector(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const SBankWaveformVector *tmplts, REAL8 min_match, SBankWorkspaceCacheVector *workspace_caches);
+
+int XLALInspiralSBankComputeMatchMaxSkyLocVector(REAL8Vector *matches, const COMPLEX8FrequencySeries *proposal, const SBankWaveformVector *hps, const SBankWaveformVector *hcs, const REAL8Vector *hphccorrs, REAL8 min_match, SBankWorkspaceCacheVector *workspace_caches1, SBankWorkspaceCacheVector *workspace_caches2);
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+int XLALInspiralSBankComputeMatchBatch(REAL8 *matches, size_t *first_cover, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *tmplts, size_t ntmplts, REAL8 min_match, WS **workspace_caches, size_t ncaches);
+
+int XLALInspiralSBankComputeMatchMaxSkyLocBatch(REAL8 *matches, size_t *first_cover, const COMPLEX8FrequencySeries *proposal, const COMPLEX8FrequencySeries *const *hps, const COMPLEX8FrequencySeries *const *hcs, const REAL8 *hphccorrs, size_t ntmplts, REAL8 min_match, WS **workspace_caches1, WS **workspace_caches2, size_t ncaches);
+
+#endif /* SWIG */
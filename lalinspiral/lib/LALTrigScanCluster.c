@@ -29,6 +29,7 @@
 #include <lal/LIGOMetadataInspiralUtils.h>
 #include <lal/TrigScanEThincaCommon.h>
 #include <lal/LALTrigScanCluster.h>
+#include <lal/TriggerCluster.h>
 
 /**
  * \author Sengupta, Anand. S. and Gupchup, Jayant A.
@@ -44,6 +45,9 @@
  * to append stragglers (i.e. clusters of only 1 trigger). Upon success, the
  * return value will be #XLAL_SUCCESS, with the \c SnglInspiralTable having
  * been clustered. At present, the only clustering method implemented is #T0T3Tc.
+ * The triggers are clustered with a sweep over their end times using the
+ * \c LALTriggerStore of \ref TriggerCluster_h, so each trigger is only
+ * tested for ellipsoid overlap with the triggers near it in time.
  *
  * <tt>XLALTrigScanCreateCluster()</tt> takes in a \c TriggerErrorList
  * containing the triggers, their position vectors and ellipsoid matrices. It
@@ -71,6 +75,46 @@
  *
  */
 
+/* Overlap test of the error ellipsoids of the triggers in rows j < i of */
+/* the store, for use with XLALTriggerStoreCluster() */
+static int XLALTrigScanEllipsoidsOverlap( const LALTriggerStore *store,
+                                          size_t i, size_t j, void *params )
+
+{
+  fContactWorkSpace *workSpace = (fContactWorkSpace *) params;
+  TriggerErrorList  *listA     = (TriggerErrorList *) store->row[j];
+  TriggerErrorList  *listB     = (TriggerErrorList *) store->row[i];
+  REAL8             originalTimeA;
+  REAL8             originalTimeB;
+  REAL8             fContactValue;
+
+  XLAL_CALLGSL( originalTimeA = gsl_vector_get( listA->position, 0 ) );
+  XLAL_CALLGSL( originalTimeB = gsl_vector_get( listB->position, 0 ) );
+
+  /* Measure times relative to the earlier trigger to avoid precision problems */
+  XLALSetTimeInPositionVector( listA->position, 0 );
+  XLALSetTimeInPositionVector( listB->position,
+            (REAL8) ( ( store->time[i] - store->time[j] ) * 1.0e-9 ) );
+
+  /* check for the intersection of the ellipsoids */
+  workSpace->invQ1 = listA->err_matrix;
+  workSpace->invQ2 = listB->err_matrix;
+  fContactValue = XLALCheckOverlapOfEllipsoids( listA->position,
+               listB->position, workSpace );
+
+  /* Reset the times to their original values */
+  XLALSetTimeInPositionVector( listA->position, originalTimeA );
+  XLALSetTimeInPositionVector( listB->position, originalTimeB );
+
+  if ( XLAL_IS_REAL8_FAIL_NAN( fContactValue ) )
+  {
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+
+  return fContactValue <= 1.0;
+}
+
+
 int XLALTrigScanClusterTriggers( SnglInspiralTable **table,
                                  trigScanType      method,
                                  REAL8             scaleFactor,
@@ -80,11 +124,14 @@ int XLALTrigScanClusterTriggers( SnglInspiralTable **table,
   SnglInspiralTable *tableHead     = NULL;
   SnglInspiralTable *thisTable     = NULL;
   TriggerErrorList  *errorList     = NULL;
-  TrigScanCluster   *clusterHead   = NULL;
-  TrigScanCluster   *thisCluster   = NULL;
+  TriggerErrorList  *thisErrorList = NULL;
+  LALTriggerStore   *store         = NULL;
+  fContactWorkSpace *workSpace     = NULL;
+  size_t            i;
 
   /* The maximum time difference associated with an ellipsoid */
   REAL8 tcMax;
+  INT8  maxTimeDiff;
 
 #ifndef LAL_NDEBUG
   if ( !table )
@@ -144,117 +191,78 @@ int XLALTrigScanClusterTriggers( SnglInspiralTable **table,
     XLAL_ERROR( XLAL_EFUNC );
   }
 
-  /* Now create the list of clusters. Keep going until errorlist is exhausted */
-  while ( errorList )
+  /* Put the triggers in a time-sorted array for the sweep-line clustering */
+  store = XLALCreateTriggerStore( XLALCountSnglInspiral( tableHead ) );
+  if ( !store )
   {
-    TrigScanCluster *newCluster = NULL;
-
-    newCluster = XLALTrigScanCreateCluster( &errorList, tcMax );
-    /* The next line is to keep track of memory in case of failure */
-    if ( errorList )
-      *table = errorList->trigger;
-    else
-      *table = NULL;
-
-    if ( !newCluster )
-    {
-
-      thisCluster = clusterHead;
-
-      while ( thisCluster )
-      {
-         TrigScanCluster *tmpCluster = thisCluster;
-         thisCluster = thisCluster->next;
-         XLALTrigScanDestroyCluster( tmpCluster, TRIGSCAN_ERROR );
-      }
-      if ( errorList ) XLALDestroyTriggerErrorList( errorList );
-
-      XLAL_ERROR( XLAL_EFUNC );
-    }
-    /* Add the cluster to the list */
-    if ( !clusterHead )
-    {
-      clusterHead = thisCluster = newCluster;
-    }
-    else
-    {
-      thisCluster = thisCluster->next = newCluster;
-    }
+    XLALDestroyTriggerErrorList( errorList );
+    XLAL_ERROR( XLAL_EFUNC );
   }
-
-  /* Remove stragglers if necessary */
-  if ( !appendStragglers )
+  for ( thisErrorList = errorList; thisErrorList; thisErrorList = thisErrorList->next )
   {
-    if ( XLALTrigScanRemoveStragglers( &clusterHead ) == XLAL_FAILURE )
+    if ( XLALTriggerStoreAppend( store, XLALGPSToINT8NS( &(thisErrorList->trigger->end) ),
+           thisErrorList->trigger->snr, thisErrorList ) != XLAL_SUCCESS )
     {
-      thisCluster = clusterHead;
-
-      while ( thisCluster )
-      {
-         TrigScanCluster *tmpCluster = thisCluster;
-         thisCluster = thisCluster->next;
-         XLALTrigScanDestroyCluster( tmpCluster, TRIGSCAN_ERROR );
-      }
-
+      XLALDestroyTriggerStore( store );
+      XLALDestroyTriggerErrorList( errorList );
       XLAL_ERROR( XLAL_EFUNC );
     }
-
-    if ( !clusterHead )
-    {
-      XLALPrintWarning( "All triggers were stragglers! All have been removed.\n" );
-      return XLAL_SUCCESS;
-    }
   }
 
-  /* Keep the loudest trigger in each cluster */
-  for ( thisCluster = clusterHead; thisCluster; thisCluster = thisCluster->next )
+  /* Create the workspace for checking ellipsoid overlap */
+  workSpace = XLALInitFContactWorkSpace( 3, NULL, NULL, gsl_min_fminimizer_brent, 1.0e-2 );
+  if ( !workSpace )
   {
-    if ( XLALTrigScanKeepLoudestTrigger( thisCluster ) == XLAL_FAILURE )
-    {
-      thisCluster = clusterHead;
-
-      while ( thisCluster )
-      {
-         TrigScanCluster *tmpCluster = thisCluster;
-         thisCluster = thisCluster->next;
-         XLALTrigScanDestroyCluster( tmpCluster, TRIGSCAN_ERROR );
-      }
-
-      XLAL_ERROR( XLAL_EFUNC );
-    }
+    XLALDestroyTriggerStore( store );
+    XLALDestroyTriggerErrorList( errorList );
+    XLAL_ERROR( XLAL_EFUNC );
   }
 
-  /* Re-link the lists ready for returning */
-  if ( XLALTrigScanReLinkLists( clusterHead ) == XLAL_FAILURE )
+  /* Triggers more than twice the max time error apart cannot overlap; the */
+  /* overlap test modifies the position vectors, so cluster in one block */
+  maxTimeDiff = (INT8)( (2.0 * tcMax + 1.0e-5) * 1.0e9 );
+  if ( XLALTriggerStoreSort( store ) != XLAL_SUCCESS
+       || XLALTriggerStoreCluster( store, maxTimeDiff, XLALTrigScanEllipsoidsOverlap, workSpace, 0 ) != XLAL_SUCCESS )
   {
-    thisCluster = clusterHead;
+    XLALFreeFContactWorkSpace( workSpace );
+    XLALDestroyTriggerStore( store );
+    XLALDestroyTriggerErrorList( errorList );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+  XLALFreeFContactWorkSpace( workSpace );
 
-    while ( thisCluster )
+  /* Keep the loudest trigger in each cluster, removing stragglers if */
+  /* necessary; the store is time-ordered, so the result is too */
+  *table = thisTable = NULL;
+  for ( i = 0; i < store->length; i++ )
+  {
+    thisErrorList = (TriggerErrorList *) store->row[i];
+    if ( store->cluster[i] == i && ( appendStragglers || store->size_of[i] > 1 ) )
     {
-       TrigScanCluster *tmpCluster = thisCluster;
-       thisCluster = thisCluster->next;
-       XLALTrigScanDestroyCluster( tmpCluster, TRIGSCAN_ERROR );
+      if ( thisTable )
+        thisTable = thisTable->next = thisErrorList->trigger;
+      else
+        *table = thisTable = thisErrorList->trigger;
+    }
+    else
+    {
+      XLALFreeSnglInspiral( &(thisErrorList->trigger) );
     }
-
-    XLAL_ERROR( XLAL_EFUNC );
   }
+  if ( thisTable )
+    thisTable->next = NULL;
 
-  *table = clusterHead->element->trigger;
-
-  /* Since trigScan can have multiple clusters at similar times */
-  /* We sort the list to ensure time-ordering */
-  *table = XLALSortSnglInspiral( *table, LALCompareSnglInspiralByTime );
-  XLALPrintInfo( "Returning %d clustered triggers.\n", XLALCountSnglInspiral( *table ) );
+  XLALDestroyTriggerStore( store );
+  XLALDestroyTriggerErrorList( errorList );
 
-  /* Free the memory */
-  thisCluster = clusterHead;
-  while ( thisCluster )
+  if ( !*table )
   {
-     TrigScanCluster *tmpCluster = thisCluster;
-     thisCluster = thisCluster->next;
-     XLALTrigScanDestroyCluster( tmpCluster, TRIGSCAN_SUCCESS );
+    XLALPrintWarning( "All triggers were stragglers! All have been removed.\n" );
+    return XLAL_SUCCESS;
   }
 
+  XLALPrintInfo( "Returning %d clustered triggers.\n", XLALCountSnglInspiral( *table ) );
+
   return XLAL_SUCCESS;
 }
 
@@ -25,7 +25,7 @@ from six.moves import range
 import numpy as np
 
 from lal.iterutils import inorder, uniq
-from lalinspiral import CreateSBankWorkspaceCache
+from lalinspiral import CreateSBankWorkspaceCache, CreateSBankWorkspaceCacheVector
 from .psds import get_neighborhood_ASD, get_PSD, get_neighborhood_df_fmax
 from . import waveforms
 
@@ -75,6 +75,8 @@ class Bank(object):
         else:
             # The max over skyloc stuff needs a second cache
             self._workspace_cache = [CreateSBankWorkspaceCache(), CreateSBankWorkspaceCache()]
+            # and one cache per thread to score templates in parallel
+            self._workspace_caches = [CreateSBankWorkspaceCacheVector(0), CreateSBankWorkspaceCacheVector(0)]
             self.compute_match = self._brute_match
 
     def __len__(self):
@@ -185,6 +187,13 @@ class Bank(object):
 
         df_start = max(df_end, 0) if self.iterative_match_df_max is None else max(df_end, self.iterative_max_df_max)
 
+        # if every template is matched once, at df_end, score them in
+        # parallel when they all have the same batch match
+        if not self.use_metric and not self.coarse_match_df and df_start == df_end:
+            batch_match = getattr(tmpbank[0], "batch_brute_match", None)
+            if batch_match is not None and all(getattr(tmplt, "batch_brute_match", None) is batch_match for tmplt in tmpbank):
+                return self._batch_covers(tmpbank, proposal, min_match, df_end, f_max, batch_match)
+
         # find and test matches
         for tmplt in tmpbank:
 
@@ -242,6 +251,42 @@ class Bank(object):
 
         return (max_match, template)
 
+    def _batch_covers(self, tmpbank, proposal, min_match, df, f_max, batch_match):
+        """
+        As covers(), for templates which are matched once each, at df.
+        The templates are scored one per thread at a time, so at most a
+        few more waveforms are generated than by scoring them in turn.
+        """
+        max_match = 0
+        template = None
+        PSD = get_PSD(df, self.flow, f_max, self.noise_model)
+        chunk = len(self._workspace_caches[0].data)
+
+        for start in range(0, len(tmpbank), chunk):
+            tmplts = tmpbank[start:start + chunk]
+            matches = batch_match(tmplts, proposal, df, min_match, self._workspace_caches, PSD=PSD)
+            if not self.cache_waveforms:
+                for tmplt in tmplts:
+                    tmplt.clear()
+
+            for tmplt, match in zip(tmplts, matches):
+                self._nmatch += 1
+                if match == 0:
+                    err_msg = "Match is 0. This might indicate that you have "
+                    err_msg += "the df value too high. Please try setting the "
+                    err_msg += "iterative-match-df-max value lower."
+                    raise ValueError(err_msg)
+
+                if match > min_match:
+                    return (match, tmplt)
+
+                # record match and template params for highest match
+                if match > max_match:
+                    max_match = match
+                    template = tmplt
+
+        return (max_match, template)
+
     def max_match(self, proposal):
         match, best_tmplt_ind = self.argmax_match(proposal)
         if not match: return (0., 0)
@@ -27,6 +27,7 @@ import lal
 import lalsimulation as lalsim
 from lal import MSUN_SI, MTSUN_SI, PC_SI, PI, CreateREAL8Vector, CreateCOMPLEX8FrequencySeries
 from lalinspiral import InspiralSBankComputeMatch, InspiralSBankComputeRealMatch, InspiralSBankComputeMatchMaxSkyLoc, InspiralSBankComputeMatchMaxSkyLocNoPhase
+from lalinspiral import CreateSBankWaveformVector, SetSBankWaveformVectorElement, InspiralSBankComputeMatchVector, InspiralSBankComputeMatchMaxSkyLocVector
 from lalinspiral.sbank.psds import get_neighborhood_PSD, get_ASD
 from lalinspiral.sbank.tau0tau3 import m1m2_to_tau0tau3
 
@@ -406,6 +407,21 @@ class AlignedSpinTemplate(object):
     def brute_match(self, other, df, workspace_cache, **kwargs):
         return InspiralSBankComputeMatch(self.get_whitened_normalized(df, **kwargs), other.get_whitened_normalized(df, **kwargs), workspace_cache[0])
 
+    @staticmethod
+    def batch_brute_match(tmplts, other, df, min_match, workspace_caches, **kwargs):
+        """
+        Return the brute_match() of each of tmplts with other, scored in
+        parallel with one of workspace_caches per thread.  Scoring stops
+        at the first match above min_match; the matches after it are 0.
+        """
+        proposal = other.get_whitened_normalized(df, **kwargs)
+        wfs = CreateSBankWaveformVector(len(tmplts))
+        for k, tmplt in enumerate(tmplts):
+            SetSBankWaveformVectorElement(wfs, k, tmplt.get_whitened_normalized(df, **kwargs))
+        matches = CreateREAL8Vector(len(tmplts))
+        InspiralSBankComputeMatchVector(matches, proposal, wfs, min_match, workspace_caches[0])
+        return matches.data
+
     def clear(self):
         self._wf = {}
 
@@ -728,6 +744,23 @@ class PrecessingSpinTemplate(AlignedSpinTemplate):
                                                   proposal, workspace_cache[0],
                                                   workspace_cache[1])
 
+    @staticmethod
+    def batch_brute_match(tmplts, other, df, min_match, workspace_caches, **kwargs):
+        proposal = other.get_whitened_normalized(df, **kwargs)
+        hps = CreateSBankWaveformVector(len(tmplts))
+        hcs = CreateSBankWaveformVector(len(tmplts))
+        hphccorrs = CreateREAL8Vector(len(tmplts))
+        for k, tmplt in enumerate(tmplts):
+            hp, hc, hphccorrs.data[k] = tmplt.get_whitened_normalized_comps(df, **kwargs)
+            SetSBankWaveformVectorElement(hps, k, hp)
+            SetSBankWaveformVectorElement(hcs, k, hc)
+        matches = CreateREAL8Vector(len(tmplts))
+        InspiralSBankComputeMatchMaxSkyLocVector(matches, proposal, hps, hcs,
+                                                 hphccorrs, min_match,
+                                                 workspace_caches[0],
+                                                 workspace_caches[1])
+        return matches.data
+
     @classmethod
     def from_sngl(cls, sngl, bank):
         # FIXME: Using alpha columns to hold theta, phi, iota, psi
@@ -904,6 +937,8 @@ class HigherOrderModeTemplate(PrecessingSpinTemplate):
 
     Uses maximization over sky-location and amplitude, but *not* phase.
     """
+    batch_brute_match = None
+
     def brute_match(self, other, df, workspace_cache, **kwargs):
 
         # Template generates hp and hc
@@ -929,6 +964,8 @@ class EOBNRHigherOrderModeTemplate(IMRPrecessingSpinTemplate,
 class EOBNRHigherOrderModeAmpMaxTemplate(IMRPrecessingSpinTemplate):
     """Class for EOBNRHM templates."""
     approximant = "EOBNRv2HM_ROM"
+    batch_brute_match = None
+
     def brute_match(self, other, df, workspace_cache, **kwargs):
 
         tmplt =  self.get_whitened_normalized(df, **kwargs)
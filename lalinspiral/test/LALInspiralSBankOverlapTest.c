@@ -0,0 +1,191 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Check that the batch SBank match routines agree with scoring the
+ * templates one at a time.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
+#include <lal/LALInspiralSBankOverlap.h>
+
+#define LENGTH 513
+#define DELTAF 0.25
+#define NTMPLT 40
+#define NCACHES 4
+#define MIN_MATCH 0.97
+
+static REAL8 uniform(void) {
+    return rand() / (RAND_MAX + 1.0);
+}
+
+/* normalize so that the match of h with itself is 1 */
+static void normalize(COMPLEX8FrequencySeries *h) {
+    REAL8 hh = 0.;
+    size_t k;
+    for (k = 0; k < h->data->length; ++k)
+        hh += crealf(h->data->data[k]) * crealf(h->data->data[k]) + cimagf(h->data->data[k]) * cimagf(h->data->data[k]);
+    for (k = 0; k < h->data->length; ++k)
+        h->data->data[k] /= sqrt(4. * DELTAF * hh);
+}
+
+static COMPLEX8FrequencySeries *create(void) {
+    LIGOTimeGPS epoch = LIGOTIMEGPSZERO;
+    return XLALCreateCOMPLEX8FrequencySeries("h", &epoch, 0., DELTAF, &lalDimensionlessUnit, LENGTH);
+}
+
+int main(void) {
+    COMPLEX8FrequencySeries *proposal = create();
+    COMPLEX8FrequencySeries *tmplts[NTMPLT];
+    COMPLEX8FrequencySeries *hcs[NTMPLT];
+    REAL8 hphccorrs[NTMPLT];
+    REAL8 serial[NTMPLT], batch[NTMPLT];
+    WS *caches1[NCACHES], *caches2[NCACHES];
+    SBankWaveformVector *tmpltvec, *hcvec;
+    SBankWorkspaceCacheVector *cachevec1, *cachevec2;
+    REAL8Vector *corrvec, *matchvec;
+    size_t i, k, cover, expected;
+
+    srand(2718);
+    for (k = 0; k < LENGTH; ++k)
+        proposal->data->data[k] = cpolar(1., LAL_TWOPI * uniform());
+    normalize(proposal);
+
+    /* templates are the proposal, shifted by whole samples, with decreasing amounts of noise */
+    for (i = 0; i < NTMPLT; ++i) {
+        REAL8 dt = (rand() % (2 * (LENGTH - 1))) / (2 * (LENGTH - 1) * DELTAF);
+        REAL8 eps = 2. * (NTMPLT - i) / NTMPLT;
+        tmplts[i] = create();
+        hcs[i] = create();
+        for (k = 0; k < LENGTH; ++k)
+            tmplts[i]->data->data[k] = proposal->data->data[k] * (cpolar(1., LAL_TWOPI * k * DELTAF * dt) + eps * cpolar(uniform(), LAL_TWOPI * uniform()));
+        normalize(tmplts[i]);
+        /* an orthogonal cross polarization */
+        for (k = 0; k < LENGTH; ++k)
+            hcs[i]->data->data[k] = I * tmplts[i]->data->data[k];
+        hphccorrs[i] = 0.;
+    }
+
+    for (i = 0; i < NCACHES; ++i) {
+        caches1[i] = XLALCreateSBankWorkspaceCache();
+        caches2[i] = XLALCreateSBankWorkspaceCache();
+    }
+
+    /* the containers used from the SWIG bindings, one cache per thread */
+    tmpltvec = XLALCreateSBankWaveformVector(NTMPLT);
+    hcvec = XLALCreateSBankWaveformVector(NTMPLT);
+    corrvec = XLALCreateREAL8Vector(NTMPLT);
+    matchvec = XLALCreateREAL8Vector(NTMPLT);
+    cachevec1 = XLALCreateSBankWorkspaceCacheVector(0);
+    cachevec2 = XLALCreateSBankWorkspaceCacheVector(0);
+    if (!tmpltvec || !hcvec || !corrvec || !matchvec || !cachevec1 || !cachevec2)
+        return 1;
+    for (i = 0; i < NTMPLT; ++i) {
+        if (XLALSetSBankWaveformVectorElement(tmpltvec, i, tmplts[i]) || XLALSetSBankWaveformVectorElement(hcvec, i, hcs[i]))
+            return 1;
+        corrvec->data[i] = hphccorrs[i];
+    }
+    if (XLALSetSBankWaveformVectorElement(tmpltvec, NTMPLT, tmplts[0]) != XLAL_FAILURE || xlalErrno != XLAL_EDOM) {
+        fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (out-of-range element was set)\n");
+        return 1;
+    }
+    XLALClearErrno();
+
+    /* score every template */
+    expected = NTMPLT;
+    for (i = 0; i < NTMPLT; ++i) {
+        serial[i] = XLALInspiralSBankComputeMatch(proposal, tmplts[i], caches1[0]);
+        if (expected == NTMPLT && serial[i] > MIN_MATCH)
+            expected = i;
+    }
+    if (expected == NTMPLT || expected == 0) {
+        fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (no template covers the proposal after the first)\n");
+        return 1;
+    }
+    if (XLALInspiralSBankComputeMatchBatch(batch, &cover, proposal, (const COMPLEX8FrequencySeries *const *) tmplts, NTMPLT, INFINITY, caches1, NCACHES) != XLAL_SUCCESS)
+        return 1;
+    for (i = 0; i < NTMPLT; ++i)
+        if (cover != NTMPLT || fabs(batch[i] - serial[i]) > 1e-6) {
+            fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (match %zu: batch %g, serial %g)\n", i, batch[i], serial[i]);
+            return 1;
+        }
+
+    /* stop at the first template that covers the proposal */
+    if (XLALInspiralSBankComputeMatchBatch(batch, &cover, proposal, (const COMPLEX8FrequencySeries *const *) tmplts, NTMPLT, MIN_MATCH, caches1, NCACHES) != XLAL_SUCCESS)
+        return 1;
+    if (cover != expected) {
+        fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (first cover %zu, expected %zu)\n", cover, expected);
+        return 1;
+    }
+    for (i = 0; i < NTMPLT; ++i)
+        if (fabs(batch[i] - (i <= expected ? serial[i] : 0.)) > 1e-6) {
+            fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (early exit, match %zu: batch %g, serial %g)\n", i, batch[i], serial[i]);
+            return 1;
+        }
+    if (XLALInspiralSBankComputeMatchVector(matchvec, proposal, tmpltvec, MIN_MATCH, cachevec1) != XLAL_SUCCESS)
+        return 1;
+    for (i = 0; i < NTMPLT; ++i)
+        if (fabs(matchvec->data[i] - batch[i]) > 1e-6) {
+            fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (vector, match %zu: vector %g, batch %g)\n", i, matchvec->data[i], batch[i]);
+            return 1;
+        }
+
+    /* the same with the sky-location-maximized match */
+    for (i = 0; i < NTMPLT; ++i)
+        serial[i] = XLALInspiralSBankComputeMatchMaxSkyLoc(tmplts[i], hcs[i], hphccorrs[i], proposal, caches1[0], caches2[0]);
+    if (XLALInspiralSBankComputeMatchMaxSkyLocBatch(batch, &cover, proposal, (const COMPLEX8FrequencySeries *const *) tmplts, (const COMPLEX8FrequencySeries *const *) hcs, hphccorrs, NTMPLT, INFINITY, caches1, caches2, NCACHES) != XLAL_SUCCESS)
+        return 1;
+    for (i = 0; i < NTMPLT; ++i)
+        if (fabs(batch[i] - serial[i]) > 1e-6) {
+            fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (sky location match %zu: batch %g, serial %g)\n", i, batch[i], serial[i]);
+            return 1;
+        }
+    if (XLALInspiralSBankComputeMatchMaxSkyLocVector(matchvec, proposal, tmpltvec, hcvec, corrvec, INFINITY, cachevec1, cachevec2) != XLAL_SUCCESS)
+        return 1;
+    for (i = 0; i < NTMPLT; ++i)
+        if (fabs(matchvec->data[i] - serial[i]) > 1e-6) {
+            fprintf(stderr, "LALInspiralSBankOverlapTest: FAIL (sky location vector, match %zu: vector %g, serial %g)\n", i, matchvec->data[i], serial[i]);
+            return 1;
+        }
+
+    XLALDestroySBankWaveformVector(tmpltvec);
+    XLALDestroySBankWaveformVector(hcvec);
+    XLALDestroySBankWorkspaceCacheVector(cachevec1);
+    XLALDestroySBankWorkspaceCacheVector(cachevec2);
+    XLALDestroyREAL8Vector(corrvec);
+    XLALDestroyREAL8Vector(matchvec);
+
+    for (i = 0; i < NCACHES; ++i) {
+        XLALDestroySBankWorkspaceCache(caches1[i]);
+        XLALDestroySBankWorkspaceCache(caches2[i]);
+    }
+    for (i = 0; i < NTMPLT; ++i) {
+        XLALDestroyCOMPLEX8FrequencySeries(tmplts[i]);
+        XLALDestroyCOMPLEX8FrequencySeries(hcs[i]);
+    }
+    XLALDestroyCOMPLEX8FrequencySeries(proposal);
+
+    LALCheckMemoryLeaks();
+    fprintf(stderr, "LALInspiralSBankOverlapTest: PASS\n");
+    return 0;
+}
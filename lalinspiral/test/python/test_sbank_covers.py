@@ -0,0 +1,91 @@
+# -*- coding: utf-8 -*-
+#
+# This program is free software; you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation; either version 2 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+# Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+"""Test that sbank Bank.covers(), which scores templates in parallel
+through the SWIG bindings, agrees with the serial matches and frees all
+waveforms
+"""
+
+import gc
+import sys
+
+import pytest
+
+import lal
+
+pytest.importorskip("glue")
+from lalinspiral.sbank.bank import Bank, _find_neighborhood  # noqa: E402
+from lalinspiral.sbank.psds import noise_models, get_neighborhood_df_fmax, get_PSD  # noqa: E402
+from lalinspiral.sbank import waveforms  # noqa: E402
+
+FLOW = 40.
+MIN_MATCH = 0.97
+
+# (template class, bank template parameters, proposal parameters)
+COVERS_TEST_DATA = [
+    (
+        waveforms.TaylorF2RedSpinTemplate,
+        [(1.4, 1.4, 0., 0.), (1.45, 1.35, 0., 0.), (1.5, 1.3, 0.1, 0.), (1.6, 1.2, 0., 0.)],
+        (1.42, 1.38, 0., 0.),
+    ),
+    (
+        waveforms.SpinTaylorF2Template,
+        [(1.4, 1.4, 0.1, 0., 0.2, 0., 0., 0., 0.5, 0.3, 0.4, 0.2, 0.),
+         (1.45, 1.35, 0.1, 0., 0.2, 0., 0., 0., 0.5, 0.3, 0.4, 0.2, 0.),
+         (1.5, 1.3, 0., 0., 0.1, 0., 0., 0., 0.5, 0.3, 0.4, 0.2, 0.)],
+        (1.42, 1.38, 0.1, 0., 0.2, 0., 0., 0., 0.5, 0.3, 0.4, 0.2, 0.),
+    ),
+]
+
+
+def _check_covers(tmplt_class, params, proposal_params):
+    bank = Bank(noise_models["aLIGOZeroDetHighPower"], FLOW)
+    for p in params:
+        bank.insort(tmplt_class(*p, bank=bank))
+    proposal = tmplt_class(*proposal_params, bank=bank)
+
+    # score twice, so that waveforms handed to the batch match a second
+    # time are still owned by the templates
+    for _ in range(2):
+        match, tmplt = bank.covers(proposal, MIN_MATCH)
+        assert tmplt is not None
+        assert 0 < match <= 1 + 1e-6
+
+        # the first template in the order of covers() which covers the
+        # proposal, or the best one, must be the one found serially
+        low, high = _find_neighborhood(bank._nhoods, proposal.tau0, bank.nhood_size)
+        nhood = sorted(bank._templates[low:high], key=lambda t: abs(t.tau0 - proposal.tau0))
+        df, f_max = get_neighborhood_df_fmax(nhood + [proposal], bank.flow)
+        PSD = get_PSD(df, bank.flow, f_max, bank.noise_model)
+        serial = [bank.compute_match(t, proposal, df, PSD=PSD) for t in nhood]
+        covering = [m for m in serial if m > MIN_MATCH]
+        expected = covering[0] if covering else max(serial)
+        assert match == pytest.approx(expected, abs=1e-5)
+
+
+@pytest.mark.parametrize("tmplt_class, params, proposal_params", COVERS_TEST_DATA)
+def test_covers(tmplt_class, params, proposal_params):
+    _check_covers(tmplt_class, params, proposal_params)
+
+    # every waveform handed to the batch match must be freed with its
+    # template
+    gc.collect()
+    lal.CheckMemoryLeaks()
+
+
+if __name__ == '__main__':
+    args = sys.argv[1:] or ["-v", "-rs", "--junit-xml=junit-sbank_covers.xml"]
+    sys.exit(pytest.main(args=[__file__] + args))
@@ -0,0 +1,855 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with with program; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301  USA
+ */
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/H5FileIO.h>
+#include <lal/LALMalloc.h>
+#include <lal/LIGOMetadataH5.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/XLALError.h>
+
+
+/*
+ * ============================================================================
+ *
+ *                              Column Descriptions
+ *
+ * ============================================================================
+ */
+
+
+/* number of rows converted per block when reading or writing */
+#define H5_BLOCK_ROWS 4096
+
+
+typedef enum {
+	H5_COLUMN_INT4,
+	H5_COLUMN_LONG,
+	H5_COLUMN_ULONG,
+	H5_COLUMN_REAL4,
+	H5_COLUMN_REAL8,
+	H5_COLUMN_STRING
+} H5ColumnKind;
+
+
+/* a column of a table:  its name, how it's stored, and where it is in the
+ * row structure */
+typedef struct {
+	const char *name;
+	H5ColumnKind kind;
+	size_t offset;
+	size_t size;
+} H5Column;
+
+
+#define H5_COLUMN(type, kind, name, member) {#name, H5_COLUMN_ ## kind, offsetof(type, member), sizeof(((type *) 0)->member)}
+
+
+static const H5Column sngl_inspiral_columns[] = {
+	H5_COLUMN(SnglInspiralTable, LONG, process_id, process_id),
+	H5_COLUMN(SnglInspiralTable, STRING, ifo, ifo),
+	H5_COLUMN(SnglInspiralTable, STRING, search, search),
+	H5_COLUMN(SnglInspiralTable, STRING, channel, channel),
+	H5_COLUMN(SnglInspiralTable, INT4, end_time, end.gpsSeconds),
+	H5_COLUMN(SnglInspiralTable, INT4, end_time_ns, end.gpsNanoSeconds),
+	H5_COLUMN(SnglInspiralTable, REAL8, end_time_gmst, end_time_gmst),
+	H5_COLUMN(SnglInspiralTable, INT4, impulse_time, impulse_time.gpsSeconds),
+	H5_COLUMN(SnglInspiralTable, INT4, impulse_time_ns, impulse_time.gpsNanoSeconds),
+	H5_COLUMN(SnglInspiralTable, REAL8, template_duration, template_duration),
+	H5_COLUMN(SnglInspiralTable, REAL8, event_duration, event_duration),
+	H5_COLUMN(SnglInspiralTable, REAL4, amplitude, amplitude),
+	H5_COLUMN(SnglInspiralTable, REAL4, eff_distance, eff_distance),
+	H5_COLUMN(SnglInspiralTable, REAL4, coa_phase, coa_phase),
+	H5_COLUMN(SnglInspiralTable, REAL4, mass1, mass1),
+	H5_COLUMN(SnglInspiralTable, REAL4, mass2, mass2),
+	H5_COLUMN(SnglInspiralTable, REAL4, mchirp, mchirp),
+	H5_COLUMN(SnglInspiralTable, REAL4, mtotal, mtotal),
+	H5_COLUMN(SnglInspiralTable, REAL4, eta, eta),
+	H5_COLUMN(SnglInspiralTable, REAL4, kappa, kappa),
+	H5_COLUMN(SnglInspiralTable, REAL4, chi, chi),
+	H5_COLUMN(SnglInspiralTable, REAL4, tau0, tau0),
+	H5_COLUMN(SnglInspiralTable, REAL4, tau2, tau2),
+	H5_COLUMN(SnglInspiralTable, REAL4, tau3, tau3),
+	H5_COLUMN(SnglInspiralTable, REAL4, tau4, tau4),
+	H5_COLUMN(SnglInspiralTable, REAL4, tau5, tau5),
+	H5_COLUMN(SnglInspiralTable, REAL4, ttotal, ttotal),
+	H5_COLUMN(SnglInspiralTable, REAL4, psi0, psi0),
+	H5_COLUMN(SnglInspiralTable, REAL4, psi3, psi3),
+	H5_COLUMN(SnglInspiralTable, REAL4, alpha, alpha),
+	H5_COLUMN(SnglInspiralTable, REAL4, alpha1, alpha1),
+	H5_COLUMN(SnglInspiralTable, REAL4, alpha2, alpha2),
+	H5_COLUMN(SnglInspiralTable, REAL4, alpha3, alpha3),
+	H5_COLUMN(SnglInspiralTable, REAL4, alpha4, alpha4),
+	H5_COLUMN(SnglInspiralTable, REAL4, alpha5, alpha5),
+	H5_COLUMN(SnglInspiralTable, REAL4, alpha6, alpha6),
+	H5_COLUMN(SnglInspiralTable, REAL4, beta, beta),
+	H5_COLUMN(SnglInspiralTable, REAL4, f_final, f_final),
+	H5_COLUMN(SnglInspiralTable, REAL4, snr, snr),
+	H5_COLUMN(SnglInspiralTable, REAL4, chisq, chisq),
+	H5_COLUMN(SnglInspiralTable, INT4, chisq_dof, chisq_dof),
+	H5_COLUMN(SnglInspiralTable, REAL4, bank_chisq, bank_chisq),
+	H5_COLUMN(SnglInspiralTable, INT4, bank_chisq_dof, bank_chisq_dof),
+	H5_COLUMN(SnglInspiralTable, REAL4, cont_chisq, cont_chisq),
+	H5_COLUMN(SnglInspiralTable, INT4, cont_chisq_dof, cont_chisq_dof),
+	H5_COLUMN(SnglInspiralTable, REAL8, sigmasq, sigmasq),
+	H5_COLUMN(SnglInspiralTable, REAL4, rsqveto_duration, rsqveto_duration),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma0, Gamma[0]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma1, Gamma[1]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma2, Gamma[2]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma3, Gamma[3]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma4, Gamma[4]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma5, Gamma[5]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma6, Gamma[6]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma7, Gamma[7]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma8, Gamma[8]),
+	H5_COLUMN(SnglInspiralTable, REAL4, Gamma9, Gamma[9]),
+	H5_COLUMN(SnglInspiralTable, REAL4, spin1x, spin1x),
+	H5_COLUMN(SnglInspiralTable, REAL4, spin1y, spin1y),
+	H5_COLUMN(SnglInspiralTable, REAL4, spin1z, spin1z),
+	H5_COLUMN(SnglInspiralTable, REAL4, spin2x, spin2x),
+	H5_COLUMN(SnglInspiralTable, REAL4, spin2y, spin2y),
+	H5_COLUMN(SnglInspiralTable, REAL4, spin2z, spin2z),
+	H5_COLUMN(SnglInspiralTable, LONG, event_id, event_id)
+};
+
+
+static const H5Column sngl_burst_columns[] = {
+	H5_COLUMN(SnglBurst, LONG, process_id, process_id),
+	H5_COLUMN(SnglBurst, STRING, ifo, ifo),
+	H5_COLUMN(SnglBurst, STRING, search, search),
+	H5_COLUMN(SnglBurst, STRING, channel, channel),
+	H5_COLUMN(SnglBurst, INT4, start_time, start_time.gpsSeconds),
+	H5_COLUMN(SnglBurst, INT4, start_time_ns, start_time.gpsNanoSeconds),
+	H5_COLUMN(SnglBurst, INT4, peak_time, peak_time.gpsSeconds),
+	H5_COLUMN(SnglBurst, INT4, peak_time_ns, peak_time.gpsNanoSeconds),
+	H5_COLUMN(SnglBurst, REAL4, duration, duration),
+	H5_COLUMN(SnglBurst, REAL4, central_freq, central_freq),
+	H5_COLUMN(SnglBurst, REAL4, bandwidth, bandwidth),
+	H5_COLUMN(SnglBurst, REAL4, amplitude, amplitude),
+	H5_COLUMN(SnglBurst, REAL4, snr, snr),
+	H5_COLUMN(SnglBurst, REAL4, confidence, confidence),
+	H5_COLUMN(SnglBurst, REAL8, chisq, chisq),
+	H5_COLUMN(SnglBurst, REAL8, chisq_dof, chisq_dof),
+	H5_COLUMN(SnglBurst, LONG, event_id, event_id)
+};
+
+
+static const H5Column sim_inspiral_columns[] = {
+	H5_COLUMN(SimInspiralTable, LONG, process_id, process_id),
+	H5_COLUMN(SimInspiralTable, STRING, waveform, waveform),
+	H5_COLUMN(SimInspiralTable, INT4, geocent_end_time, geocent_end_time.gpsSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, geocent_end_time_ns, geocent_end_time.gpsNanoSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, h_end_time, h_end_time.gpsSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, h_end_time_ns, h_end_time.gpsNanoSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, l_end_time, l_end_time.gpsSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, l_end_time_ns, l_end_time.gpsNanoSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, g_end_time, g_end_time.gpsSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, g_end_time_ns, g_end_time.gpsNanoSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, t_end_time, t_end_time.gpsSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, t_end_time_ns, t_end_time.gpsNanoSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, v_end_time, v_end_time.gpsSeconds),
+	H5_COLUMN(SimInspiralTable, INT4, v_end_time_ns, v_end_time.gpsNanoSeconds),
+	H5_COLUMN(SimInspiralTable, REAL8, end_time_gmst, end_time_gmst),
+	H5_COLUMN(SimInspiralTable, STRING, source, source),
+	H5_COLUMN(SimInspiralTable, REAL4, mass1, mass1),
+	H5_COLUMN(SimInspiralTable, REAL4, mass2, mass2),
+	H5_COLUMN(SimInspiralTable, REAL4, mchirp, mchirp),
+	H5_COLUMN(SimInspiralTable, REAL4, eta, eta),
+	H5_COLUMN(SimInspiralTable, REAL4, distance, distance),
+	H5_COLUMN(SimInspiralTable, REAL4, longitude, longitude),
+	H5_COLUMN(SimInspiralTable, REAL4, latitude, latitude),
+	H5_COLUMN(SimInspiralTable, REAL4, inclination, inclination),
+	H5_COLUMN(SimInspiralTable, REAL4, coa_phase, coa_phase),
+	H5_COLUMN(SimInspiralTable, REAL4, polarization, polarization),
+	H5_COLUMN(SimInspiralTable, REAL4, psi0, psi0),
+	H5_COLUMN(SimInspiralTable, REAL4, psi3, psi3),
+	H5_COLUMN(SimInspiralTable, REAL4, alpha, alpha),
+	H5_COLUMN(SimInspiralTable, REAL4, alpha1, alpha1),
+	H5_COLUMN(SimInspiralTable, REAL4, alpha2, alpha2),
+	H5_COLUMN(SimInspiralTable, REAL4, alpha3, alpha3),
+	H5_COLUMN(SimInspiralTable, REAL4, alpha4, alpha4),
+	H5_COLUMN(SimInspiralTable, REAL4, alpha5, alpha5),
+	H5_COLUMN(SimInspiralTable, REAL4, alpha6, alpha6),
+	H5_COLUMN(SimInspiralTable, REAL4, beta, beta),
+	H5_COLUMN(SimInspiralTable, REAL4, spin1x, spin1x),
+	H5_COLUMN(SimInspiralTable, REAL4, spin1y, spin1y),
+	H5_COLUMN(SimInspiralTable, REAL4, spin1z, spin1z),
+	H5_COLUMN(SimInspiralTable, REAL4, spin2x, spin2x),
+	H5_COLUMN(SimInspiralTable, REAL4, spin2y, spin2y),
+	H5_COLUMN(SimInspiralTable, REAL4, spin2z, spin2z),
+	H5_COLUMN(SimInspiralTable, REAL4, theta0, theta0),
+	H5_COLUMN(SimInspiralTable, REAL4, phi0, phi0),
+	H5_COLUMN(SimInspiralTable, REAL4, f_lower, f_lower),
+	H5_COLUMN(SimInspiralTable, REAL4, f_final, f_final),
+	H5_COLUMN(SimInspiralTable, REAL4, eff_dist_h, eff_dist_h),
+	H5_COLUMN(SimInspiralTable, REAL4, eff_dist_l, eff_dist_l),
+	H5_COLUMN(SimInspiralTable, REAL4, eff_dist_g, eff_dist_g),
+	H5_COLUMN(SimInspiralTable, REAL4, eff_dist_t, eff_dist_t),
+	H5_COLUMN(SimInspiralTable, REAL4, eff_dist_v, eff_dist_v),
+	H5_COLUMN(SimInspiralTable, REAL4, qmParameter1, qmParameter1),
+	H5_COLUMN(SimInspiralTable, REAL4, qmParameter2, qmParameter2),
+	H5_COLUMN(SimInspiralTable, INT4, numrel_mode_min, numrel_mode_min),
+	H5_COLUMN(SimInspiralTable, INT4, numrel_mode_max, numrel_mode_max),
+	H5_COLUMN(SimInspiralTable, STRING, numrel_data, numrel_data),
+	H5_COLUMN(SimInspiralTable, INT4, amp_order, amp_order),
+	H5_COLUMN(SimInspiralTable, STRING, taper, taper),
+	H5_COLUMN(SimInspiralTable, INT4, bandpass, bandpass),
+	H5_COLUMN(SimInspiralTable, LONG, simulation_id, simulation_id)
+};
+
+
+static const H5Column sim_burst_columns[] = {
+	H5_COLUMN(SimBurst, LONG, process_id, process_id),
+	H5_COLUMN(SimBurst, STRING, waveform, waveform),
+	H5_COLUMN(SimBurst, REAL8, ra, ra),
+	H5_COLUMN(SimBurst, REAL8, dec, dec),
+	H5_COLUMN(SimBurst, REAL8, psi, psi),
+	H5_COLUMN(SimBurst, INT4, time_geocent_gps, time_geocent_gps.gpsSeconds),
+	H5_COLUMN(SimBurst, INT4, time_geocent_gps_ns, time_geocent_gps.gpsNanoSeconds),
+	H5_COLUMN(SimBurst, REAL8, time_geocent_gmst, time_geocent_gmst),
+	H5_COLUMN(SimBurst, REAL8, duration, duration),
+	H5_COLUMN(SimBurst, REAL8, frequency, frequency),
+	H5_COLUMN(SimBurst, REAL8, bandwidth, bandwidth),
+	H5_COLUMN(SimBurst, REAL8, q, q),
+	H5_COLUMN(SimBurst, REAL8, pol_ellipse_angle, pol_ellipse_angle),
+	H5_COLUMN(SimBurst, REAL8, pol_ellipse_e, pol_ellipse_e),
+	H5_COLUMN(SimBurst, REAL8, amplitude, amplitude),
+	H5_COLUMN(SimBurst, REAL8, hrss, hrss),
+	H5_COLUMN(SimBurst, REAL8, egw_over_rsquared, egw_over_rsquared),
+	H5_COLUMN(SimBurst, ULONG, waveform_number, waveform_number),
+	H5_COLUMN(SimBurst, LONG, time_slide_id, time_slide_id),
+	H5_COLUMN(SimBurst, LONG, simulation_id, simulation_id)
+};
+
+
+#undef H5_COLUMN
+
+
+static LALTYPECODE H5ColumnType(H5ColumnKind kind)
+{
+	switch(kind) {
+	case H5_COLUMN_INT4:
+	case H5_COLUMN_STRING:
+		return LAL_I4_TYPE_CODE;
+	case H5_COLUMN_LONG:
+		return LAL_I8_TYPE_CODE;
+	case H5_COLUMN_ULONG:
+		return LAL_U8_TYPE_CODE;
+	case H5_COLUMN_REAL4:
+		return LAL_S_TYPE_CODE;
+	case H5_COLUMN_REAL8:
+	default:
+		return LAL_D_TYPE_CODE;
+	}
+}
+
+
+static size_t H5ColumnSize(H5ColumnKind kind)
+{
+	switch(kind) {
+	case H5_COLUMN_INT4:
+	case H5_COLUMN_STRING:
+		return sizeof(INT4);
+	case H5_COLUMN_LONG:
+		return sizeof(INT8);
+	case H5_COLUMN_ULONG:
+		return sizeof(UINT8);
+	case H5_COLUMN_REAL4:
+		return sizeof(REAL4);
+	case H5_COLUMN_REAL8:
+	default:
+		return sizeof(REAL8);
+	}
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                            String Dictionaries
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * the distinct values of a string column, stored as the concatenation of
+ * nul-terminated strings, with an open-addressed hash table for finding
+ * a value's index when writing
+ */
+
+
+typedef struct {
+	char *data;
+	size_t nbytes;
+	size_t size;
+	size_t *offset;
+	size_t n;
+	size_t n_alloc;
+	size_t *slot;
+	size_t n_slot;
+} H5Dictionary;
+
+
+static void H5DictionaryFree(H5Dictionary *dict)
+{
+	LALFree(dict->data);
+	LALFree(dict->offset);
+	LALFree(dict->slot);
+	memset(dict, 0, sizeof(*dict));
+}
+
+
+static size_t H5DictionaryHash(const char *s, size_t len)
+{
+	/* FNV-1a */
+	size_t hash = 2166136261u;
+	while(len--)
+		hash = (hash ^ (unsigned char) *s++) * 16777619u;
+	return hash;
+}
+
+
+/* returns the index of value s of length len, adding it if it's new */
+static INT4 H5DictionaryIndex(H5Dictionary *dict, const char *s, size_t len)
+{
+	size_t i;
+
+	/* keep the hash table at most half full */
+	if(2 * (dict->n + 1) > dict->n_slot) {
+		size_t n_slot = dict->n_slot ? 2 * dict->n_slot : 64;
+		size_t *slot = LALCalloc(n_slot, sizeof(*slot));
+		if(!slot)
+			XLAL_ERROR(XLAL_ENOMEM);
+		for(i = 0; i < dict->n; i++) {
+			const char *t = dict->data + dict->offset[i];
+			size_t j = H5DictionaryHash(t, strlen(t)) & (n_slot - 1);
+			while(slot[j])
+				j = (j + 1) & (n_slot - 1);
+			slot[j] = i + 1;
+		}
+		LALFree(dict->slot);
+		dict->slot = slot;
+		dict->n_slot = n_slot;
+	}
+
+	/* slots hold index + 1, so 0 is empty */
+	i = H5DictionaryHash(s, len) & (dict->n_slot - 1);
+	while(dict->slot[i]) {
+		const char *t = dict->data + dict->offset[dict->slot[i] - 1];
+		if(!strncmp(t, s, len) && t[len] == '\0')
+			return dict->slot[i] - 1;
+		i = (i + 1) & (dict->n_slot - 1);
+	}
+
+	if(dict->n >= (size_t) INT32_MAX)
+		XLAL_ERROR(XLAL_ESIZE, "too many distinct strings in column");
+
+	if(dict->nbytes + len + 1 > dict->size) {
+		size_t size = dict->size ? 2 * dict->size : 1024;
+		char *data;
+		while(dict->nbytes + len + 1 > size)
+			size *= 2;
+		data = LALRealloc(dict->data, size);
+		if(!data)
+			XLAL_ERROR(XLAL_ENOMEM);
+		dict->data = data;
+		dict->size = size;
+	}
+	if(dict->n >= dict->n_alloc) {
+		size_t n_alloc = dict->n_alloc ? 2 * dict->n_alloc : 16;
+		size_t *offset = LALRealloc(dict->offset, n_alloc * sizeof(*offset));
+		if(!offset)
+			XLAL_ERROR(XLAL_ENOMEM);
+		dict->offset = offset;
+		dict->n_alloc = n_alloc;
+	}
+
+	memcpy(dict->data + dict->nbytes, s, len);
+	dict->data[dict->nbytes + len] = '\0';
+	dict->offset[dict->n] = dict->nbytes;
+	dict->nbytes += len + 1;
+	dict->slot[i] = dict->n + 1;
+	return dict->n++;
+}
+
+
+/* reads the dictionary dataset of a string column, if there is one */
+static int H5DictionaryRead(H5Dictionary *dict, LALH5File *file, const char *table_name, const char *column_name)
+{
+	char name[256];
+	LALH5Dataset *dset;
+	size_t i;
+
+	snprintf(name, sizeof(name), "%s:%s", table_name, column_name);
+	if(!XLALH5FileCheckDatasetExists(file, name))
+		return 0;
+
+	dset = XLALH5DatasetRead(file, name);
+	if(!dset)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(XLALH5DatasetQueryType(dset) != LAL_CHAR_TYPE_CODE) {
+		XLALH5DatasetFree(dset);
+		XLAL_ERROR(XLAL_ETYPE, "dataset `%s' is not a string dictionary", name);
+	}
+	dict->nbytes = XLALH5DatasetQueryNBytes(dset);
+	dict->size = dict->nbytes + 1;
+	dict->data = LALMalloc(dict->size);
+	if(!dict->data) {
+		XLALH5DatasetFree(dset);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	if(XLALH5DatasetQueryData(dict->data, dset) < 0) {
+		XLALH5DatasetFree(dset);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALH5DatasetFree(dset);
+	/* make sure the last string is terminated */
+	dict->data[dict->nbytes] = '\0';
+
+	for(i = 0; i < dict->nbytes; i += strlen(dict->data + i) + 1) {
+		if(dict->n >= dict->n_alloc) {
+			size_t n_alloc = dict->n_alloc ? 2 * dict->n_alloc : 16;
+			size_t *offset = LALRealloc(dict->offset, n_alloc * sizeof(*offset));
+			if(!offset)
+				XLAL_ERROR(XLAL_ENOMEM);
+			dict->offset = offset;
+			dict->n_alloc = n_alloc;
+		}
+		dict->offset[dict->n++] = i;
+	}
+
+	return 0;
+}
+
+
+static int H5DictionaryWrite(const H5Dictionary *dict, LALH5File *file, const char *table_name, const char *column_name)
+{
+	char name[256];
+	LALH5Dataset *dset;
+
+	if(!dict->n)
+		return 0;
+
+	snprintf(name, sizeof(name), "%s:%s", table_name, column_name);
+	dset = XLALH5DatasetAlloc1D(file, name, LAL_CHAR_TYPE_CODE, dict->nbytes);
+	if(!dset)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(XLALH5DatasetWrite(dset, dict->data) < 0) {
+		XLALH5DatasetFree(dset);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALH5DatasetFree(dset);
+
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                              Generic Tables
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * all the row structures begin with the pointer to the next row, so the
+ * linked lists can be walked without knowing the row type
+ */
+
+
+static const void *next_row(const void *row)
+{
+	return *(void * const *) row;
+}
+
+
+static void free_rows(void *row)
+{
+	while(row) {
+		void *next = *(void **) row;
+		LALFree(row);
+		row = next;
+	}
+}
+
+
+static int XLALWriteH5Table(LALH5File *file, const char *table_name, const H5Column *columns, size_t ncols, const void *head)
+{
+	const char *names[ncols];
+	LALTYPECODE types[ncols];
+	size_t offsets[ncols];
+	size_t colsz[ncols];
+	size_t rowsz = 0;
+	H5Dictionary *dict = NULL;
+	unsigned char *buf = NULL;
+	LALH5Dataset *dset;
+	const void *row;
+	size_t nrows = 0;
+	size_t col;
+
+	if(!file)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	/* the rows are packed, in the order of the column descriptions */
+	for(col = 0; col < ncols; col++) {
+		names[col] = columns[col].name;
+		types[col] = H5ColumnType(columns[col].kind);
+		offsets[col] = rowsz;
+		colsz[col] = H5ColumnSize(columns[col].kind);
+		rowsz += colsz[col];
+	}
+
+	dset = XLALH5TableAlloc(file, table_name, ncols, names, types, offsets, rowsz);
+	if(!dset)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	dict = LALCalloc(ncols, sizeof(*dict));
+	buf = LALMalloc(H5_BLOCK_ROWS * rowsz);
+	if(!dict || !buf) {
+		XLALH5DatasetFree(dset);
+		LALFree(dict);
+		LALFree(buf);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	for(row = head; row; row = next_row(row)) {
+		unsigned char *dst = buf + nrows * rowsz;
+		for(col = 0; col < ncols; col++) {
+			const char *src = (const char *) row + columns[col].offset;
+			INT8 i8;
+			UINT8 u8;
+			INT4 index;
+			switch(columns[col].kind) {
+			case H5_COLUMN_LONG:
+				i8 = *(const long *) src;
+				memcpy(dst + offsets[col], &i8, sizeof(i8));
+				break;
+			case H5_COLUMN_ULONG:
+				u8 = *(const unsigned long *) src;
+				memcpy(dst + offsets[col], &u8, sizeof(u8));
+				break;
+			case H5_COLUMN_STRING:
+				index = H5DictionaryIndex(&dict[col], src, strnlen(src, columns[col].size));
+				if(index < 0)
+					goto error;
+				memcpy(dst + offsets[col], &index, sizeof(index));
+				break;
+			default:
+				memcpy(dst + offsets[col], src, colsz[col]);
+				break;
+			}
+		}
+		if(++nrows == H5_BLOCK_ROWS) {
+			if(XLALH5TableAppend(dset, offsets, colsz, nrows, rowsz, buf) < 0)
+				goto error;
+			nrows = 0;
+		}
+	}
+	if(nrows && XLALH5TableAppend(dset, offsets, colsz, nrows, rowsz, buf) < 0)
+		goto error;
+
+	for(col = 0; col < ncols; col++)
+		if(columns[col].kind == H5_COLUMN_STRING && H5DictionaryWrite(&dict[col], file, table_name, columns[col].name) < 0)
+			goto error;
+
+	for(col = 0; col < ncols; col++)
+		H5DictionaryFree(&dict[col]);
+	LALFree(dict);
+	LALFree(buf);
+	XLALH5DatasetFree(dset);
+	return 0;
+
+error:
+	for(col = 0; col < ncols; col++)
+		H5DictionaryFree(&dict[col]);
+	LALFree(dict);
+	LALFree(buf);
+	XLALH5DatasetFree(dset);
+	XLAL_ERROR(XLAL_EFUNC, "error writing %s table", table_name);
+}
+
+
+static int XLALH5TableToRows(void **rows, LALH5File *file, const char *table_name, const H5Column *columns, size_t ncols, size_t row_size)
+{
+	size_t layout[ncols];
+	const H5Column *selected[ncols];
+	size_t offsets[ncols];
+	size_t colsz[ncols];
+	char fields[ncols * 64];
+	size_t nselected = 0;
+	size_t rowsz = 0;
+	H5Dictionary *dict = NULL;
+	unsigned char *buf = NULL;
+	LALH5Dataset *dset;
+	void *head = NULL;
+	void **next = &head;
+	size_t nrows, nfilecols;
+	size_t row0;
+	size_t col;
+	int pos;
+
+	*rows = NULL;
+	if(!file)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	for(col = 0; col < ncols; col++) {
+		layout[col] = rowsz;
+		rowsz += H5ColumnSize(columns[col].kind);
+	}
+
+	dset = XLALH5DatasetRead(file, table_name);
+	if(!dset)
+		XLAL_ERROR(XLAL_EFUNC, "cannot read %s table", table_name);
+	nrows = XLALH5TableQueryNRows(dset);
+	nfilecols = XLALH5TableQueryNColumns(dset);
+
+	dict = LALCalloc(ncols, sizeof(*dict));
+	if(!dict) {
+		XLALH5DatasetFree(dset);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	/* the fields are read in the order they appear in the file;  columns
+	 * we don't know about are ignored and missing columns are left 0 */
+	fields[0] = '\0';
+	for(pos = 0; pos < (int) nfilecols; pos++) {
+		char name[64];
+		if(XLALH5TableQueryColumnName(name, sizeof(name), dset, pos) < 0)
+			goto error;
+		for(col = 0; col < ncols; col++)
+			if(!strcmp(name, columns[col].name))
+				break;
+		if(col >= ncols)
+			continue;
+		if(XLALH5TableQueryColumnType(dset, pos) != H5ColumnType(columns[col].kind)) {
+			XLALPrintError("%s(): column %s of %s table has wrong type\n", __func__, name, table_name);
+			goto error;
+		}
+		if(columns[col].kind == H5_COLUMN_STRING && H5DictionaryRead(&dict[col], file, table_name, name) < 0)
+			goto error;
+		if(nselected)
+			strcat(fields, ",");
+		strcat(fields, name);
+		selected[nselected] = &columns[col];
+		offsets[nselected] = layout[col];
+		colsz[nselected] = H5ColumnSize(columns[col].kind);
+		nselected++;
+	}
+
+	buf = LALMalloc(H5_BLOCK_ROWS * rowsz);
+	if(!buf) {
+		XLALPrintError("%s(): out of memory\n", __func__);
+		goto error;
+	}
+
+	for(row0 = 0; row0 < nrows; row0 += H5_BLOCK_ROWS) {
+		size_t n = nrows - row0 < H5_BLOCK_ROWS ? nrows - row0 : H5_BLOCK_ROWS;
+		size_t i;
+
+		if(nselected && XLALH5TableReadColumns(buf, dset, fields, offsets, colsz, row0, n, rowsz) < 0)
+			goto error;
+
+		for(i = 0; i < n; i++) {
+			const unsigned char *src = buf + i * rowsz;
+			char *row = LALCalloc(1, row_size);
+			size_t k;
+			if(!row) {
+				XLALPrintError("%s(): out of memory\n", __func__);
+				goto error;
+			}
+			*next = row;
+			next = (void **) row;
+
+			for(k = 0; k < nselected; k++) {
+				char *dst = row + selected[k]->offset;
+				INT8 i8;
+				UINT8 u8;
+				INT4 index;
+				switch(selected[k]->kind) {
+				case H5_COLUMN_LONG:
+					memcpy(&i8, src + offsets[k], sizeof(i8));
+					*(long *) dst = i8;
+					break;
+				case H5_COLUMN_ULONG:
+					memcpy(&u8, src + offsets[k], sizeof(u8));
+					*(unsigned long *) dst = u8;
+					break;
+				case H5_COLUMN_STRING:
+					memcpy(&index, src + offsets[k], sizeof(index));
+					if(index < 0 || (size_t) index >= dict[selected[k] - columns].n) {
+						XLALPrintError("%s(): row %zu of %s table has invalid %s\n", __func__, row0 + i, table_name, selected[k]->name);
+						goto error;
+					}
+					snprintf(dst, selected[k]->size, "%s", dict[selected[k] - columns].data + dict[selected[k] - columns].offset[index]);
+					break;
+				default:
+					memcpy(dst, src + offsets[k], colsz[k]);
+					break;
+				}
+			}
+		}
+	}
+
+	for(col = 0; col < ncols; col++)
+		H5DictionaryFree(&dict[col]);
+	LALFree(dict);
+	LALFree(buf);
+	XLALH5DatasetFree(dset);
+	*rows = head;
+	return 0;
+
+error:
+	for(col = 0; col < ncols; col++)
+		H5DictionaryFree(&dict[col]);
+	LALFree(dict);
+	LALFree(buf);
+	XLALH5DatasetFree(dset);
+	free_rows(head);
+	XLAL_ERROR(XLAL_EFUNC, "error reading %s table", table_name);
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                              Table Writers
+ *
+ * ============================================================================
+ */
+
+
+/**
+ * Write a \c sngl_inspiral table to a dataset named \c sngl_inspiral in
+ * an HDF5 file or group opened for writing.  Returns 0 on success, < 0 on
+ * failure.
+ */
+int XLALWriteH5SnglInspiralTable(LALH5File *file, const SnglInspiralTable *sngl_inspiral)
+{
+	if(XLALWriteH5Table(file, "sngl_inspiral", sngl_inspiral_columns, XLAL_NUM_ELEM(sngl_inspiral_columns), sngl_inspiral) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Write a \c sngl_burst table to a dataset named \c sngl_burst in an HDF5
+ * file or group opened for writing.  Returns 0 on success, < 0 on failure.
+ */
+int XLALWriteH5SnglBurstTable(LALH5File *file, const SnglBurst *sngl_burst)
+{
+	if(XLALWriteH5Table(file, "sngl_burst", sngl_burst_columns, XLAL_NUM_ELEM(sngl_burst_columns), sngl_burst) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Write a \c sim_inspiral table to a dataset named \c sim_inspiral in an
+ * HDF5 file or group opened for writing.  Returns 0 on success, < 0 on
+ * failure.
+ */
+int XLALWriteH5SimInspiralTable(LALH5File *file, const SimInspiralTable *sim_inspiral)
+{
+	if(XLALWriteH5Table(file, "sim_inspiral", sim_inspiral_columns, XLAL_NUM_ELEM(sim_inspiral_columns), sim_inspiral) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Write a \c sim_burst table to a dataset named \c sim_burst in an HDF5
+ * file or group opened for writing.  Returns 0 on success, < 0 on failure.
+ */
+int XLALWriteH5SimBurstTable(LALH5File *file, const SimBurst *sim_burst)
+{
+	if(XLALWriteH5Table(file, "sim_burst", sim_burst_columns, XLAL_NUM_ELEM(sim_burst_columns), sim_burst) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                              Table Readers
+ *
+ * ============================================================================
+ */
+
+
+/**
+ * Read the \c sngl_inspiral table from an HDF5 file or group.  Returns a
+ * pointer to the head of a linked list of rows, or NULL on failure or if
+ * the table is empty.
+ */
+SnglInspiralTable *XLALSnglInspiralTableFromH5(LALH5File *file)
+{
+	void *head;
+	if(XLALH5TableToRows(&head, file, "sngl_inspiral", sngl_inspiral_columns, XLAL_NUM_ELEM(sngl_inspiral_columns), sizeof(SnglInspiralTable)) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
+
+
+/**
+ * Read the \c sngl_burst table from an HDF5 file or group.  Returns a
+ * pointer to the head of a linked list of rows, or NULL on failure or if
+ * the table is empty.
+ */
+SnglBurst *XLALSnglBurstTableFromH5(LALH5File *file)
+{
+	void *head;
+	if(XLALH5TableToRows(&head, file, "sngl_burst", sngl_burst_columns, XLAL_NUM_ELEM(sngl_burst_columns), sizeof(SnglBurst)) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
+
+
+/**
+ * Read the \c sim_inspiral table from an HDF5 file or group.  Returns a
+ * pointer to the head of a linked list of rows, or NULL on failure or if
+ * the table is empty.
+ */
+SimInspiralTable *XLALSimInspiralTableFromH5(LALH5File *file)
+{
+	void *head;
+	if(XLALH5TableToRows(&head, file, "sim_inspiral", sim_inspiral_columns, XLAL_NUM_ELEM(sim_inspiral_columns), sizeof(SimInspiralTable)) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
+
+
+/**
+ * Read the \c sim_burst table from an HDF5 file or group.  Returns a
+ * pointer to the head of a linked list of rows, or NULL on failure or if
+ * the table is empty.
+ */
+SimBurst *XLALSimBurstTableFromH5(LALH5File *file)
+{
+	void *head;
+	if(XLALH5TableToRows(&head, file, "sim_burst", sim_burst_columns, XLAL_NUM_ELEM(sim_burst_columns), sizeof(SimBurst)) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return head;
+}
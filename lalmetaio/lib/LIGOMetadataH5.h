@@ -0,0 +1,115 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with with program; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301  USA
+ */
+
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ *
+ * \brief Routines to read and write LIGO metadata tables in HDF5 files.
+ *
+ * ### Description ###
+ *
+ * These routines store \c sngl_inspiral, \c sngl_burst, \c sim_inspiral
+ * and \c sim_burst tables as HDF5 compound tables (see H5FileIO.h), a
+ * columnar binary alternative to LIGO Light Weight XML.  Each table is
+ * stored in a dataset named after the table, e.g.\ \c sngl_burst, with
+ * one column per column of the LIGO Light Weight XML table and the same
+ * column names.  Numeric columns are stored in binary with their native
+ * types, so no text is formatted or parsed.
+ *
+ * String columns (\c ifo, \c channel, etc.) are stored as an \c INT4
+ * column of indices into a dictionary of the distinct values of the
+ * column.  The dictionary is stored as the concatenation of the
+ * nul-terminated strings in a \c CHAR dataset named after the column,
+ * e.g.\ <tt>sngl_burst:ifo</tt>.  Trigger tables typically hold only a
+ * handful of distinct values in each string column, so this costs four
+ * bytes per row.
+ *
+ * Rows are written and read in blocks, so memory use is bounded however
+ * large the table.  The readers return the same linked lists as the LIGO
+ * Light Weight XML readers; rows are allocated one at a time with
+ * LALCalloc() and can be freed with the usual routines.  Columns missing
+ * from the file are left zeroed.
+ */
+
+
+#ifndef _LIGOMETADATAH5_H
+#define _LIGOMETADATAH5_H
+
+
+#include <lal/H5FileIO.h>
+#include <lal/LIGOMetadataTables.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+
+int XLALWriteH5SnglInspiralTable(
+	LALH5File *file,
+	const SnglInspiralTable *sngl_inspiral
+);
+
+
+int XLALWriteH5SnglBurstTable(
+	LALH5File *file,
+	const SnglBurst *sngl_burst
+);
+
+
+int XLALWriteH5SimInspiralTable(
+	LALH5File *file,
+	const SimInspiralTable *sim_inspiral
+);
+
+
+int XLALWriteH5SimBurstTable(
+	LALH5File *file,
+	const SimBurst *sim_burst
+);
+
+
+SnglInspiralTable *XLALSnglInspiralTableFromH5(
+	LALH5File *file
+);
+
+
+SnglBurst *XLALSnglBurstTableFromH5(
+	LALH5File *file
+);
+
+
+SimInspiralTable *XLALSimInspiralTableFromH5(
+	LALH5File *file
+);
+
+
+SimBurst *XLALSimBurstTableFromH5(
+	LALH5File *file
+);
+
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LIGOMETADATAH5_H */
@@ -28,6 +28,8 @@
 
 // ---------- includes
 #include <math.h>
+#include <errno.h>
+#include <string.h>
 
 // GSL includes
 
@@ -46,6 +48,12 @@
 #include <lal/ExtrapolatePulsarSpins.h>
 #include <lal/ConfigFile.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 // ---------- local defines
 
 // ---------- local macro definitions
@@ -351,8 +359,16 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
   if ( sqrtSn > 0)
     {
       REAL8 noiseSigma = sqrtSn * sqrt ( 0.5 * fSamp );
-      INT4 randSeed = (dataParams->randSeed == 0) ? 0 : (dataParams->randSeed + detectorIndex);	// seed=0 means to use /dev/urandom, so don't touch it
-      XLAL_CHECK ( XLALAddGaussianNoise ( Tseries_sum, noiseSigma, randSeed ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( dataParams->randCounterBased )
+        {
+          XLAL_CHECK ( dataParams->randSeed != 0, XLAL_EINVAL, "Counter-based noise generation requires a non-zero random seed\n" );
+          XLAL_CHECK ( XLALAddGaussianNoiseCounterBased ( Tseries_sum, noiseSigma, dataParams->randSeed, detectorIndex ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+      else
+        {
+          INT4 randSeed = (dataParams->randSeed == 0) ? 0 : (dataParams->randSeed + detectorIndex);	// seed=0 means to use /dev/urandom, so don't touch it
+          XLAL_CHECK ( XLALAddGaussianNoise ( Tseries_sum, noiseSigma, randSeed ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
     }
 
   // convert final signal+Gaussian-noise timeseries into REAL8 precision:
@@ -394,6 +410,230 @@ XLALCWMakeFakeData ( SFTVector **SFTvect,
 
 } // XLALCWMakeFakeData()
 
+/**
+ * Streaming version of XLALCWMakeFakeMultiData(), which generates signal and noise
+ * one SFT at a time and writes the SFTs directly to disk, instead of holding the
+ * full time-series of each detector in memory.
+ *
+ * Each SFT is generated on its own time-stretch of length Tsft with the exact
+ * (per-sample) signal model, so no overlap between neighbouring stretches is needed.
+ * Gaussian noise is generated with XLALAddGaussianNoiseCounterBased() using the
+ * detector index as stream, so that it does not depend on how the data is split
+ * into SFTs; this requires a non-zero \c dataParams->randSeed if any noise is requested.
+ * Noise SFTs are then bit-for-bit identical to those of XLALCWMakeFakeMultiData() with
+ * \c randCounterBased set, unless gaps between SFTs force the latter to a higher sampling rate.
+ *
+ * SFTs are generated in parallel when OpenMP is available, and written in
+ * timestamp order as they become available, so that memory usage is bounded by
+ * a few SFTs per thread. Input time-series (\c dataParams->inputMultiTS) are not supported.
+ */
+int
+XLALCWMakeFakeMultiDataToDir ( const char *dirname,				///< [in] directory to write SFTs to
+                               BOOLEAN singleFile,				///< [in] write a single merged SFT file per detector, otherwise one file per SFT
+                               const char *SFTcomment,				///< [in] optional comment for SFT headers (can be NULL)
+                               const char *Misc,				///< [in] optional 'Misc' field of SFT filenames (can be NULL)
+                               const PulsarParamsVector *injectionSources,	///< [in] (optional) array of sources inject
+                               const CWMFDataParams *dataParams,		///< [in] parameters specifying the type of data to generate
+                               const EphemerisData *edat			///< [in] ephemeris data
+                               )
+{
+  XLAL_CHECK ( dirname != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( dataParams != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( edat != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( dataParams->inputMultiTS == NULL, XLAL_EINVAL, "Input time-series are not supported when streaming SFTs to disk\n" );
+
+  const MultiLIGOTimeGPSVector *multiTimestamps = &(dataParams->multiTimestamps);
+
+  // check multi-detector input
+  XLAL_CHECK ( dataParams->multiIFO.length >= 1, XLAL_EINVAL );
+  UINT4 numDet = dataParams->multiIFO.length;
+  XLAL_CHECK ( multiTimestamps->length == numDet, XLAL_EINVAL, "Inconsistent number of IFOs: detInfo says '%d', multiTimestamps says '%d'\n", numDet, multiTimestamps->length );
+  XLAL_CHECK ( dataParams->multiNoiseFloor.length == numDet, XLAL_EINVAL );
+
+  // check Tsft, consistent over detectors, and noise seed
+  REAL8 Tsft = multiTimestamps->data[0]->deltaT;
+  XLAL_CHECK ( Tsft > 0, XLAL_EINVAL, "Got invalid Tsft = %g must be > 0\n", Tsft );
+  UINT4 numSFTsTotal = 0;
+  for ( UINT4 X=0; X < numDet; X ++ ) {
+    XLAL_CHECK ( multiTimestamps->data[X]->deltaT == Tsft, XLAL_EINVAL, "Inconsistent Tsft, for Tsft[X=0]=%g, while Tsft[X=%d]=%g\n", Tsft, X, multiTimestamps->data[X]->deltaT );
+    XLAL_CHECK ( multiTimestamps->data[X]->length > 0, XLAL_EINVAL );
+    XLAL_CHECK ( dataParams->multiNoiseFloor.sqrtSn[X] <= 0 || dataParams->randSeed != 0, XLAL_EINVAL, "Streaming noise generation requires a non-zero random seed\n" );
+    numSFTsTotal += multiTimestamps->data[X]->length;
+  }
+
+  // generate each SFT in the effective SFT band: avoids repeating the band-adjustment
+  // in XLALCWMakeFakeData() for every SFT, the requested band is extracted below
+  UINT4 firstBinEff, numBinsEff;
+  XLAL_CHECK ( XLALFindCoveringSFTBins ( &firstBinEff, &numBinsEff, dataParams->fMin, dataParams->Band, Tsft ) == XLAL_SUCCESS, XLAL_EFUNC );
+  CWMFDataParams chunkParams = (*dataParams);
+  chunkParams.fMin = firstBinEff / Tsft;
+  chunkParams.Band = (numBinsEff - 1.0) / Tsft;
+  chunkParams.randCounterBased = 1;
+
+  // the effective band must be a fixed point of the band-adjustment in XLALCWMakeFakeData(),
+  // so that each SFT is generated at the same sampling rate fSamp = 2*Band_eff, and hence on
+  // the same noise sample grid, as the full-band request would be
+  {
+    UINT4 firstBinChunk, numBinsChunk;
+    XLAL_CHECK ( XLALFindCoveringSFTBins ( &firstBinChunk, &numBinsChunk, chunkParams.fMin, chunkParams.Band, Tsft ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( (firstBinChunk == firstBinEff) && (numBinsChunk == numBinsEff), XLAL_EERR,
+                 "Effective band [%.16g, %.16g] Hz is not stable under SFT-bin covering: bins [%u, %u) became [%u, %u)\n",
+                 chunkParams.fMin, chunkParams.fMin + chunkParams.Band, firstBinEff, firstBinEff + numBinsEff, firstBinChunk, firstBinChunk + numBinsChunk );
+    UINT4 n0_fSamp = (UINT4) round ( Tsft * 2.0 * chunkParams.Band );
+    XLAL_CHECK ( n0_fSamp == 2 * (numBinsEff - 1), XLAL_EERR, "Effective sampling rate %u/%g differs from full-band rate %u/%g\n", n0_fSamp, Tsft, 2 * (numBinsEff - 1), Tsft );
+
+    // each SFT is generated on its own, so gaps never raise the sampling rate here
+    for ( UINT4 X=0; X < numDet; X ++ )
+      {
+        UINT4 n1_fSamp;
+        XLAL_CHECK ( XLALFindSmallestValidSamplingRate ( &n1_fSamp, n0_fSamp, multiTimestamps->data[X] ) == XLAL_SUCCESS, XLAL_EFUNC );
+        if ( n1_fSamp != n0_fSamp ) {
+          XLALPrintWarning ( "%s: gaps in timestamps of detector X=%u require sampling rate %u/%g for in-memory generation, SFTs are streamed at %u/%g\n",
+                             __func__, X, n1_fSamp, Tsft, n0_fSamp, Tsft );
+        }
+      }
+  }
+
+  // open merged SFT files, if requested
+  FILE **fps = NULL;
+  if ( singleFile )
+    {
+      XLAL_CHECK ( (fps = XLALCalloc ( numDet, sizeof(fps[0]) )) != NULL, XLAL_ENOMEM );
+      int openerr = 0;
+      for ( UINT4 X=0; X < numDet && openerr == 0; X ++ )
+        {
+          const LIGOTimeGPSVector *ts = multiTimestamps->data[X];
+          const LIGOTimeGPS *epochStart = &(ts->data[0]);
+          const LIGOTimeGPS *epochEnd   = &(ts->data[ts->length-1]);
+          UINT4 Tspan = epochEnd->gpsSeconds - epochStart->gpsSeconds + (UINT4)Tsft;
+          if ( epochStart->gpsNanoSeconds > 0) {
+            Tspan += 1;
+          }
+          if ( epochEnd->gpsNanoSeconds > 0) {
+            Tspan += 1;
+          }
+          CHAR *detPrefix = XLALGetChannelPrefix ( dataParams->multiIFO.sites[X].frDetector.name );
+          char *filename = NULL;
+          CHAR *path = NULL;
+          if ( detPrefix == NULL
+               || (filename = XLALOfficialSFTFilename ( detPrefix[0], detPrefix[1], ts->length, (UINT4)Tsft, epochStart->gpsSeconds, Tspan, Misc )) == NULL
+               || (path = XLALCalloc ( 1, strlen ( dirname ) + 1 + strlen ( filename ) + 1 )) == NULL )
+            {
+              openerr = XLAL_EFUNC;
+            }
+          else
+            {
+              sprintf ( path, "%s/%s", dirname, filename );
+              if ( (fps[X] = fopen ( path, "wb" )) == NULL ) {
+                XLALPrintError ( "%s: Failed to open '%s' for writing: %s\n", __func__, path, strerror(errno) );
+                openerr = XLAL_EIO;
+              }
+            }
+          XLALFree ( path );
+          XLALFree ( filename );
+          XLALFree ( detPrefix );
+        } // for X < numDet
+      if ( openerr != 0 )
+        {
+          for ( UINT4 X=0; X < numDet; X ++ ) {
+            if ( fps[X] != NULL ) {
+              fclose ( fps[X] );
+            }
+          }
+          XLALFree ( fps );
+          XLAL_ERROR ( openerr );
+        }
+    } // if singleFile
+
+  // generate and write SFTs, over all detectors and timestamps
+  int errcode = 0;
+#pragma omp parallel
+  {
+    // per-thread copy of the parameters, with a single timestamp for the current detector
+    CWMFDataParams params = chunkParams;
+    LIGOTimeGPSVector *ts1 = XLALCreateTimestampVector ( 1 );
+    LIGOTimeGPSVector **tsList = XLALCalloc ( numDet, sizeof(tsList[0]) );
+    if ( ts1 == NULL || tsList == NULL )
+      {
+#pragma omp critical (XLALCWMakeFakeMultiDataToDir)
+        errcode = XLAL_ENOMEM;
+      }
+    else
+      {
+        ts1->deltaT = Tsft;
+        memcpy ( tsList, multiTimestamps->data, numDet * sizeof(tsList[0]) );
+        params.multiTimestamps.data = tsList;
+      }
+
+#pragma omp for ordered schedule(dynamic)
+    for ( UINT4 i = 0; i < numSFTsTotal; i ++ )
+      {
+        UINT4 X = 0, k = i;
+        while ( k >= multiTimestamps->data[X]->length ) {
+          k -= multiTimestamps->data[X]->length;
+          X ++;
+        }
+
+        // generate the SFT
+        SFTVector *sftEff = NULL, *sft = NULL;
+#pragma omp flush(errcode)
+        if ( errcode == 0 )
+          {
+            ts1->data[0] = multiTimestamps->data[X]->data[k];
+            params.multiTimestamps.data[X] = ts1;
+            if ( XLALCWMakeFakeData ( &sftEff, NULL, injectionSources, &params, X, edat ) != XLAL_SUCCESS
+                 || (sft = XLALExtractStrictBandFromSFTVector ( sftEff, dataParams->fMin, dataParams->Band )) == NULL )
+              {
+#pragma omp critical (XLALCWMakeFakeMultiDataToDir)
+                errcode = XLAL_EFUNC;
+              }
+            params.multiTimestamps.data[X] = multiTimestamps->data[X];
+          }
+        XLALDestroySFTVector ( sftEff );
+
+        // write the SFTs in timestamp order
+#pragma omp ordered
+        {
+#pragma omp flush(errcode)
+          if ( errcode == 0 && sft != NULL )
+            {
+              int retn;
+              if ( singleFile ) {
+                retn = XLALWriteSFT2fp ( &(sft->data[0]), fps[X], SFTcomment );
+              } else {
+                retn = XLALWriteSFTVector2Dir ( sft, dirname, SFTcomment, Misc );
+              }
+              if ( retn != XLAL_SUCCESS )
+                {
+#pragma omp critical (XLALCWMakeFakeMultiDataToDir)
+                  errcode = XLAL_EFUNC;
+                }
+            }
+        } // omp ordered
+        XLALDestroySFTVector ( sft );
+
+      } // for i < numSFTsTotal
+
+    XLALDestroyTimestampVector ( ts1 );
+    XLALFree ( tsList );
+  } // omp parallel
+
+  if ( fps != NULL )
+    {
+      for ( UINT4 X=0; X < numDet; X ++ ) {
+        if ( fps[X] != NULL ) {
+          fclose ( fps[X] );
+        }
+      }
+      XLALFree ( fps );
+    }
+
+  XLAL_CHECK ( errcode == 0, errcode );
+
+  return XLAL_SUCCESS;
+
+} // XLALCWMakeFakeMultiDataToDir()
+
 
 /**
  * Generate a (heterodyned) REAL4 timeseries of a CW signal for given pulsarParams,
@@ -79,6 +79,7 @@ typedef struct tagCWMFDataParams
   const char *SFTWindowType;			//!< window to apply to the SFT timeseries
   REAL8 SFTWindowBeta;				//!< 'beta' parameter required for *some* windows [otherwise must be 0]
   UINT4 randSeed;				//!< seed value for random-number generator
+  BOOLEAN randCounterBased;			//!< use the counter-based generator of XLALAddGaussianNoiseCounterBased(), with detector index as stream
   MultiREAL8TimeSeries *inputMultiTS;		//!< [optional] input time-series for signals+noise to be added to
   REAL8 sourceDeltaT;                           //!< [optional] source-frame sampling period. '0' means to use the previous internal defaults
 } CWMFDataParams;
@@ -101,6 +102,8 @@ int XLALCWMakeFakeMultiData ( MultiSFTVector **multiSFTs, MultiREAL8TimeSeries *
                               const PulsarParamsVector *injectionSources, const CWMFDataParams *dataParams, const EphemerisData *edat );
 int XLALCWMakeFakeData ( SFTVector **SFTVect, REAL8TimeSeries **Tseries,
                          const PulsarParamsVector *injectionSources, const CWMFDataParams *dataParams, UINT4 detectorIndex, const EphemerisData *edat );
+int XLALCWMakeFakeMultiDataToDir ( const char *dirname, BOOLEAN singleFile, const char *SFTcomment, const char *Misc,
+                                   const PulsarParamsVector *injectionSources, const CWMFDataParams *dataParams, const EphemerisData *edat );
 
 REAL4TimeSeries *
 XLALGenerateCWSignalTS ( const PulsarParams *pulsarParams, const LALDetector *site, LIGOTimeGPS startTime, REAL8 duration, REAL8 fSamp, REAL8 fHet, const EphemerisData *edat, REAL8 sourceDeltaT );
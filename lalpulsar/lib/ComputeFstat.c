@@ -33,10 +33,18 @@
 #endif
 
 #include <lal/LALString.h>
+#include <lal/LALTrace.h>
 #include <lal/LALSIMD.h>
 #include <lal/NormalizeSFTRngMed.h>
 #include <lal/ExtrapolatePulsarSpins.h>
 #include <lal/VectorMath.h>
+#include <lal/SinCosLUT.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
 
 // ---------- Internal struct definitions ---------- //
 
@@ -51,6 +59,8 @@ struct tagFstatInput {
   int *workspace_refcount;				// Reference counter for the shared workspace 'common.workspace'
   FstatMethodFuncs method_funcs;			// Function pointers for F-statistic method
   void *method_data;					// F-statistic method data
+  UINT4 numThreadWorkspaces;				// Number of per-thread workspaces allocated by XLALComputeFstatVector()
+  void **threadWorkspaces;				// Per-thread workspaces used by XLALComputeFstatVector()
 };
 
 // ---------- Internal prototypes ---------- //
@@ -757,15 +767,12 @@ XLALGetFstatInputDetectorStates ( const FstatInput* input       ///< [in] \c Fst
 } // XLALGetFstatInputDetectorStates()
 
 ///
-/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
+/// Check input, (re)allocate a results structure, and initialise it for the Doppler point 'doppler'
+/// extrapolated to the SFT mid-time, as expected by the method compute functions
 ///
-int
-XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a \c FstatResults results structure; if \c NULL, allocate here.
-                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
-                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
-                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
-                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
-                   )
+static int
+XLALPrepareFstatResults ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler,
+                          const UINT4 numFreqBins, const FstatQuantities whatToCompute )
 {
   // Check input
   XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
@@ -878,17 +885,188 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
   }
   (*Fstats)->whatWasComputed = whatToCompute;
 
+  return XLAL_SUCCESS;
+
+} // XLALPrepareFstatResults()
+
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
+///
+int
+XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a \c FstatResults results structure; if \c NULL, allocate here.
+                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
+                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
+                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
+                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                   )
+{
+  XLAL_CHECK ( XLALPrepareFstatResults ( Fstats, input, doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   // Call the appropriate method function to compute the F-statistic
-  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_TRACE_START(timer, "XLALComputeFstat");
+  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_TRACE_STOP(timer, 0);
+  XLAL_TRACE_COUNT("XLALComputeFstat:freqBins", numFreqBins, 0);
 
-  (*Fstats)->doppler = (*doppler);
   // Record the internal reference time used, which is required to compute a correct global signal phase
-  (*Fstats)->refTimePhase = midDoppler.refTime;
+  (*Fstats)->refTimePhase = input->common.midTime;
+  (*Fstats)->doppler = (*doppler);
 
   return XLAL_SUCCESS;
 
 } // XLALComputeFstat()
 
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies for a batch of Doppler points.
+///
+/// The results are identical to calling XLALComputeFstat() for each of the Doppler points in turn.
+/// Methods able to share work between templates do so: for \a Resamp, a batch of binary-orbit templates
+/// at the same sky position shares the sky-dependent buffers, and the detector-frame timeseries is
+/// interpolated onto the source-frame samples of all templates in a single pass.
+///
+int
+XLALComputeFstatBatch ( FstatResults **Fstats,                  ///< [in/out] Array of \c numDopplers pointers to \c FstatResults results structures; any \c NULL pointer is allocated here.
+                        FstatInput *input,                      ///< [in] Input data structure created by one of the setup functions.
+                        const PulsarDopplerParams *dopplers,    ///< [in] Array of \c numDopplers Doppler parameters at which to compute \f$2\mathcal{F}\f$
+                        const UINT4 numDopplers,                ///< [in] Number of Doppler points in the batch
+                        const UINT4 numFreqBins,                ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
+                        const FstatQuantities whatToCompute     ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                        )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( dopplers != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( numDopplers > 0, XLAL_EINVAL);
+
+  for ( UINT4 i = 0; i < numDopplers; ++i ) {
+    XLAL_CHECK ( XLALPrepareFstatResults ( &Fstats[i], input, &dopplers[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Call the appropriate method function to compute the F-statistic
+  XLAL_TRACE_START(timer, "XLALComputeFstatBatch");
+  if ( input->method_funcs.compute_batch_func != NULL )
+    {
+      XLAL_CHECK ( (input->method_funcs.compute_batch_func) ( Fstats, numDopplers, &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  else
+    {
+      for ( UINT4 i = 0; i < numDopplers; ++i ) {
+        XLAL_CHECK ( (input->method_funcs.compute_func) ( Fstats[i], &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+    }
+  XLAL_TRACE_STOP(timer, 0);
+  XLAL_TRACE_COUNT("XLALComputeFstat:freqBins", numDopplers * numFreqBins, 0);
+
+  for ( UINT4 i = 0; i < numDopplers; ++i )
+    {
+      // Record the internal reference time used, which is required to compute a correct global signal phase
+      Fstats[i]->refTimePhase = input->common.midTime;
+      Fstats[i]->doppler = dopplers[i];
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatBatch()
+
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies for the same Doppler point on all segments
+/// of a semicoherent search, given by an \c FstatInputVector.
+///
+/// The results are identical to calling XLALComputeFstat() on each segment in turn. If compiled with OpenMP,
+/// the segments are distributed dynamically over the available threads. Segments that share a workspace (via
+/// \c FstatOptionalArgs.prevInput) cannot use it concurrently, so each thread is then given its own workspace,
+/// which is enlarged to fit all segments and kept in the first element of \c inputs for re-use in later calls;
+/// FFT plans are still shared between segments of equal length.
+///
+int
+XLALComputeFstatVector ( FstatResults **Fstats,                 ///< [in/out] Array of \c inputs->length pointers to \c FstatResults results structures; any \c NULL pointer is allocated here.
+                         FstatInputVector *inputs,              ///< [in] Input data structures of all segments, created with the same F-statistic method.
+                         const PulsarDopplerParams *doppler,    ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
+                         const UINT4 numFreqBins,               ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed.
+                         const FstatQuantities whatToCompute    ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                         )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( inputs != NULL && inputs->length > 0 && inputs->data != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( doppler != NULL, XLAL_EINVAL);
+
+  const UINT4 numSegments = inputs->length;
+  FstatInput *input0 = inputs->data[0];
+  for ( UINT4 n = 0; n < numSegments; ++n ) {
+    XLAL_CHECK ( inputs->data[n] != NULL, XLAL_EINVAL );
+    XLAL_CHECK ( inputs->data[n]->method == input0->method, XLAL_EINVAL, "All segments must use the same F-statistic method" );
+    XLAL_CHECK ( XLALPrepareFstatResults ( &Fstats[n], inputs->data[n], doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Determine number of threads
+  UINT4 numThreads = 1;
+#ifdef _OPENMP
+  numThreads = MYMIN ( (UINT4) omp_get_max_threads(), numSegments );
+#endif
+
+  // Allocate per-thread workspaces, each large enough for all segments
+  const BOOLEAN useThreadWorkspaces = ( numThreads > 1 ) && ( input0->method_funcs.workspace_fit_func != NULL );
+  if ( useThreadWorkspaces )
+    {
+      if ( numThreads > input0->numThreadWorkspaces )
+        {
+          XLAL_CHECK ( (input0->threadWorkspaces = XLALRealloc ( input0->threadWorkspaces, numThreads * sizeof(input0->threadWorkspaces[0]) )) != NULL, XLAL_ENOMEM );
+          for ( UINT4 t = input0->numThreadWorkspaces; t < numThreads; ++t ) {
+            input0->threadWorkspaces[t] = NULL;
+          }
+          input0->numThreadWorkspaces = numThreads;
+        }
+      for ( UINT4 t = 0; t < numThreads; ++t )
+        {
+          for ( UINT4 n = 0; n < numSegments; ++n ) {
+            XLAL_CHECK ( (input0->method_funcs.workspace_fit_func) ( &input0->threadWorkspaces[t], inputs->data[n]->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+          }
+        }
+    }
+
+  // Initialise sin/cos lookup table here, rather than concurrently in several threads
+  XLALSinCosLUTInit();
+
+  // Call the appropriate method function to compute the F-statistic on each segment
+  XLAL_TRACE_START(timer, "XLALComputeFstatVector");
+  int errcode = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for ( UINT4 n = 0; n < numSegments; ++n )
+    {
+#pragma omp flush(errcode)
+      if ( errcode == 0 )
+        {
+          FstatInput *input = inputs->data[n];
+          FstatCommon common = input->common;
+#ifdef _OPENMP
+          if ( useThreadWorkspaces ) {
+            common.workspace = input0->threadWorkspaces[omp_get_thread_num()];
+          }
+#endif
+          if ( (input->method_funcs.compute_func) ( Fstats[n], &common, input->method_data ) != XLAL_SUCCESS )
+            {
+#pragma omp critical (XLALComputeFstatVector)
+              errcode = XLAL_EFUNC;
+            }
+        }
+    } // for n < numSegments
+  XLAL_CHECK ( errcode == 0, errcode );
+  XLAL_TRACE_STOP(timer, 0);
+  XLAL_TRACE_COUNT("XLALComputeFstat:freqBins", numSegments * numFreqBins, 0);
+
+  for ( UINT4 n = 0; n < numSegments; ++n )
+    {
+      // Record the internal reference time used, which is required to compute a correct global signal phase
+      Fstats[n]->refTimePhase = inputs->data[n]->common.midTime;
+      Fstats[n]->doppler = (*doppler);
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatVector()
+
 ///
 /// Free all memory associated with a \c FstatInput structure.
 ///
@@ -913,6 +1091,14 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
   XLALDestroyMultiNoiseWeights ( input->common.multiNoiseWeights );
   XLALDestroyMultiDetectorStateSeries ( input->common.multiDetectorStates );
 
+  // Free per-thread workspaces
+  for ( UINT4 t = 0; t < input->numThreadWorkspaces; ++t ) {
+    if ( input->threadWorkspaces[t] != NULL ) {
+      (input->method_funcs.workspace_destroy_func) ( input->threadWorkspaces[t] );
+    }
+  }
+  XLALFree ( input->threadWorkspaces );
+
   // Release a reference to 'common.workspace'; if there are no more outstanding references ...
   if ( --(*input->workspace_refcount) == 0 ) {
     XLALPrintInfo( "%s: workspace reference count = %i, freeing workspace\n", __func__, *input->workspace_refcount );
@@ -1448,6 +1634,8 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
   (*slice)->common.multiTimestamps     = multiTimestamps;
   (*slice)->common.multiDetectorStates = multiDetectorStates;
   (*slice)->common.multiNoiseWeights   = multiNoiseWeights;
+  (*slice)->numThreadWorkspaces        = 0;    // per-thread workspaces are not shared with timeslices
+  (*slice)->threadWorkspaces           = NULL;
 
   (*slice)->method_data = XLALFstatInputTimeslice_Demod ( input->method_data, iStart, iEnd );
   XLAL_CHECK ( (*slice)->method_data != NULL, XLAL_EFUNC );
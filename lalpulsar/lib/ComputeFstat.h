@@ -367,6 +367,12 @@ SWIGLAL(INOUT_STRUCTS(FstatResults**, Fstats));
 #endif
 int XLALComputeFstat ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler,
                        const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+#ifndef SWIG // exclude from SWIG interface
+int XLALComputeFstatBatch ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *dopplers, const UINT4 numDopplers,
+                            const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+int XLALComputeFstatVector ( FstatResults **Fstats, FstatInputVector *inputs, const PulsarDopplerParams *doppler,
+                             const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+#endif // SWIG
 
 void XLALDestroyFstatInput ( FstatInput* input );
 void XLALDestroyFstatResults ( FstatResults* Fstats );
@@ -49,6 +49,8 @@
 
 // ----- local constants ----------
 
+#define RESAMP_GENERIC_MAX_BATCH 16	// maximal number of binary templates resampled together by XLALComputeFstatBatch(), to bound the batch buffer memory
+
 // ----- local macros ----------
 
 // ----- local types ----------
@@ -95,6 +97,16 @@ typedef struct
   UINT4 decimateFFT;					// output every n-th frequency bin, with n>1 iff (dFreq > 1/Tspan), and was internally decreased by n
   fftwf_plan fftplan;					// FFT plan
 
+  // ----- batch buffering [see XLALComputeFstatResampGenericBatch()] -----
+  UINT4 numBatchAlloc;					// number of templates the batch buffers are allocated for
+  MultiSSBtimes **batchBinaryTimes;			// SRC times of each template, including both sky- and binary corrections
+  MultiCOMPLEX8TimeSeries **batch_SRC_a;		// SRC-frame timeseries of each template, multiplied by AM function a(t)
+  MultiCOMPLEX8TimeSeries **batch_SRC_b;		// SRC-frame timeseries of each template, multiplied by AM function b(t)
+  REAL8Vector **batchSRCtimes_DET;			// SRC-frame timesteps of each template translated into detector frame [for a single detector]
+  COMPLEX8Vector **batchTStmp1_SRC;			// heterodyne correction * a(t) of each template [for a single detector]
+  COMPLEX8Vector **batchTStmp2_SRC;			// heterodyne correction * b(t) of each template [for a single detector]
+  COMPLEX8Vector **batchTS_SRC_a;			// pointers to the single-detector SRC-frame timeseries * a(t) of each template [not owned]
+
   // ----- timing -----
   BOOLEAN collectTiming;				// flag whether or not to collect timing information
   FstatTimingGeneric timingGeneric;			// measured (generic) F-statistic timing values
@@ -110,11 +122,16 @@ int XLALExtractResampledTimeseries_ResampGeneric ( MultiCOMPLEX8TimeSeries **mul
 int XLALGetFstatTiming_ResampGeneric ( const void *method_data, FstatTimingGeneric *timingGeneric, FstatTimingModel *timingModel );
 
 static int XLALComputeFstatResampGeneric ( FstatResults* Fstats, const FstatCommon *common, void *method_data );
+static int XLALComputeFstatResampGenericBatch ( FstatResults **Fstats, UINT4 numDopplers, const FstatCommon *common, void *method_data );
 static int XLALApplySpindownAndFreqShiftGeneric ( COMPLEX8 *xOut, const COMPLEX8TimeSeries *xIn, const PulsarDopplerParams *doppler, REAL8 freqShift );
 static int XLALBarycentricResampleMultiCOMPLEX8TimeSeriesGeneric ( ResampGenericMethodData *resamp, const PulsarDopplerParams *thisPoint, const FstatCommon *common );
+static int XLALBarycentricResampleBatchGeneric ( ResampGenericMethodData *resamp, FstatResults **Fstats, UINT4 numDopplers, const FstatCommon *common );
+static int XLALAllocBatchBuffer_ResampGeneric ( ResampGenericMethodData *resamp, UINT4 numBatch );
 static int XLALComputeFaFb_ResampGeneric ( ResampGenericMethodData *resamp, ResampGenericWorkspace *ws, const PulsarDopplerParams thisPoint, REAL8 dFreq, UINT4 numFreqBins, const COMPLEX8TimeSeries *TimeSeries_SRC_a, const COMPLEX8TimeSeries *TimeSeries_SRC_b );
 static void XLALGetFFTPlanHints ( int * planMode, double * planGenTimeoutSeconds );
 static void XLALDestroyResampGenericWorkspace ( void *workspace );
+static int XLALFitResampGenericWorkspace ( ResampGenericWorkspace **workspace, UINT4 numSamplesFFT, UINT4 numSamplesMax_SRC );
+static int XLALFitResampGenericWorkspaceToMethodData ( void **workspace, const void *method_data );
 static void XLALDestroyResampGenericMethodData ( void* method_data );
 
 // ==================== function definitions ====================
@@ -140,6 +157,79 @@ static void XLALDestroyResampGenericWorkspace ( void *workspace )
 
 } // XLALDestroyResampGenericWorkspace()
 
+///
+/// Allocates a workspace, or enlarges a given one, to hold zero-padded timeseries of length 'numSamplesFFT'
+/// and SRC-frame timeseries of length 'numSamplesMax_SRC'
+///
+static int
+XLALFitResampGenericWorkspace ( ResampGenericWorkspace **workspace, UINT4 numSamplesFFT, UINT4 numSamplesMax_SRC )
+{
+  ResampGenericWorkspace *ws = (*workspace);
+  if ( ws != NULL )
+    {
+      if ( numSamplesFFT > ws->numSamplesFFTAlloc )
+        {
+          fftw_free ( ws->FabX_Raw );
+          XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+          fftw_free ( ws->TS_FFT );
+          XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+
+          ws->numSamplesFFTAlloc = numSamplesFFT;
+        }
+
+      // adjust maximal SRC-frame timeseries length, if necessary
+      if ( numSamplesMax_SRC > ws->TStmp1_SRC->length ) {
+        XLAL_CHECK ( (ws->TStmp1_SRC->data = XLALRealloc ( ws->TStmp1_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+        ws->TStmp1_SRC->length = numSamplesMax_SRC;
+        XLAL_CHECK ( (ws->TStmp2_SRC->data = XLALRealloc ( ws->TStmp2_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+        ws->TStmp2_SRC->length = numSamplesMax_SRC;
+        XLAL_CHECK ( (ws->SRCtimes_DET->data = XLALRealloc ( ws->SRCtimes_DET->data, numSamplesMax_SRC * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+        ws->SRCtimes_DET->length = numSamplesMax_SRC;
+      }
+
+    } // end: if workspace given
+  else
+    {
+      XLAL_CHECK ( (ws = XLALCalloc ( 1, sizeof(*ws))) != NULL, XLAL_ENOMEM );
+      (*workspace) = ws;	// from here on, can be freed by XLALDestroyResampGenericWorkspace()
+      XLAL_CHECK ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+
+      XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      ws->numSamplesFFTAlloc = numSamplesFFT;
+
+    } // end: if we create a new workspace
+
+  return XLAL_SUCCESS;
+
+} // XLALFitResampGenericWorkspace()
+
+///
+/// Allocates a workspace, or enlarges a given one, such that it can be used for computing the F-statistic with 'method_data'
+///
+static int
+XLALFitResampGenericWorkspaceToMethodData ( void **workspace, const void *method_data )
+{
+  XLAL_CHECK ( workspace != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( method_data != NULL, XLAL_EFAULT );
+
+  const ResampGenericMethodData *resamp = (const ResampGenericMethodData*) method_data;
+  UINT4 numSamplesMax_SRC = 0;
+  for ( UINT4 X = 0; X < resamp->multiTimeSeries_SRC_a->length; X ++ ) {
+    numSamplesMax_SRC = MYMAX ( numSamplesMax_SRC, resamp->multiTimeSeries_SRC_a->data[X]->data->length );
+  }
+
+  ResampGenericWorkspace *ws = (ResampGenericWorkspace*) (*workspace);
+  int retn = XLALFitResampGenericWorkspace ( &ws, resamp->numSamplesFFT, numSamplesMax_SRC );
+  (*workspace) = ws;
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} // XLALFitResampGenericWorkspaceToMethodData()
+
 static void XLALDestroyResampGenericMethodData ( void* method_data )
 {
 
@@ -154,6 +244,24 @@ static void XLALDestroyResampGenericMethodData ( void* method_data )
   XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
   XLALDestroyMultiSSBtimes ( resamp->multiBinaryTimes );
 
+  // ----- free batch buffer
+  for ( UINT4 i = 0; i < resamp->numBatchAlloc; i ++ )
+    {
+      XLALDestroyMultiSSBtimes ( resamp->batchBinaryTimes[i] );
+      XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->batch_SRC_a[i] );
+      XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->batch_SRC_b[i] );
+      XLALDestroyREAL8Vector ( resamp->batchSRCtimes_DET[i] );
+      XLALDestroyCOMPLEX8Vector ( resamp->batchTStmp1_SRC[i] );
+      XLALDestroyCOMPLEX8Vector ( resamp->batchTStmp2_SRC[i] );
+    }
+  XLALFree ( resamp->batchBinaryTimes );
+  XLALFree ( resamp->batch_SRC_a );
+  XLALFree ( resamp->batch_SRC_b );
+  XLALFree ( resamp->batchSRCtimes_DET );
+  XLALFree ( resamp->batchTStmp1_SRC );
+  XLALFree ( resamp->batchTStmp2_SRC );
+  XLALFree ( resamp->batchTS_SRC_a );
+
   LAL_FFTW_WISDOM_LOCK;
   fftwf_destroy_plan ( resamp->fftplan );
   LAL_FFTW_WISDOM_UNLOCK;
@@ -162,6 +270,62 @@ static void XLALDestroyResampGenericMethodData ( void* method_data )
 
 } // XLALDestroyResampGenericMethodData()
 
+///
+/// Allocates a multi-detector SRC-frame timeseries with the same layout as 'multiTS'
+///
+static MultiCOMPLEX8TimeSeries *
+XLALCreateMultiTimeSeriesLike_ResampGeneric ( const MultiCOMPLEX8TimeSeries *multiTS )
+{
+  MultiCOMPLEX8TimeSeries *ret;
+  XLAL_CHECK_NULL ( (ret = XLALCalloc ( 1, sizeof(*ret) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (ret->data = XLALCalloc ( multiTS->length, sizeof(ret->data[0]) )) != NULL, XLAL_ENOMEM );
+  ret->length = multiTS->length;
+  for ( UINT4 X = 0; X < multiTS->length; X ++ )
+    {
+      const COMPLEX8TimeSeries *tsX = multiTS->data[X];
+      XLAL_CHECK_NULL ( (ret->data[X] = XLALCreateCOMPLEX8TimeSeries ( tsX->name, &tsX->epoch, tsX->f0, tsX->deltaT, &tsX->sampleUnits, tsX->data->length )) != NULL, XLAL_EFUNC );
+    }
+  return ret;
+} // XLALCreateMultiTimeSeriesLike_ResampGeneric()
+
+///
+/// Allocates the batch buffers for (at least) 'numBatch' templates
+///
+static int
+XLALAllocBatchBuffer_ResampGeneric ( ResampGenericMethodData *resamp, UINT4 numBatch )
+{
+  if ( numBatch <= resamp->numBatchAlloc ) {
+    return XLAL_SUCCESS;
+  }
+
+  UINT4 numSamplesMax_SRC = 0;
+  for ( UINT4 X = 0; X < resamp->multiTimeSeries_SRC_a->length; X ++ ) {
+    numSamplesMax_SRC = MYMAX ( numSamplesMax_SRC, resamp->multiTimeSeries_SRC_a->data[X]->data->length );
+  }
+
+  XLAL_CHECK ( (resamp->batchBinaryTimes  = XLALRealloc ( resamp->batchBinaryTimes,  numBatch * sizeof(resamp->batchBinaryTimes[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (resamp->batch_SRC_a       = XLALRealloc ( resamp->batch_SRC_a,       numBatch * sizeof(resamp->batch_SRC_a[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (resamp->batch_SRC_b       = XLALRealloc ( resamp->batch_SRC_b,       numBatch * sizeof(resamp->batch_SRC_b[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (resamp->batchSRCtimes_DET = XLALRealloc ( resamp->batchSRCtimes_DET, numBatch * sizeof(resamp->batchSRCtimes_DET[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (resamp->batchTStmp1_SRC   = XLALRealloc ( resamp->batchTStmp1_SRC,   numBatch * sizeof(resamp->batchTStmp1_SRC[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (resamp->batchTStmp2_SRC   = XLALRealloc ( resamp->batchTStmp2_SRC,   numBatch * sizeof(resamp->batchTStmp2_SRC[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( (resamp->batchTS_SRC_a     = XLALRealloc ( resamp->batchTS_SRC_a,     numBatch * sizeof(resamp->batchTS_SRC_a[0]) )) != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = resamp->numBatchAlloc; i < numBatch; i ++ )
+    {
+      resamp->batchBinaryTimes[i] = NULL;	// allocated by XLALAddMultiBinaryTimes()
+      resamp->batchTS_SRC_a[i] = NULL;
+      XLAL_CHECK ( (resamp->batch_SRC_a[i] = XLALCreateMultiTimeSeriesLike_ResampGeneric ( resamp->multiTimeSeries_SRC_a )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (resamp->batch_SRC_b[i] = XLALCreateMultiTimeSeriesLike_ResampGeneric ( resamp->multiTimeSeries_SRC_b )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (resamp->batchSRCtimes_DET[i] = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (resamp->batchTStmp1_SRC[i] = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (resamp->batchTStmp2_SRC[i] = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      resamp->numBatchAlloc = i + 1;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALAllocBatchBuffer_ResampGeneric()
+
 int
 XLALSetupFstatResampGeneric ( void **method_data,
                               FstatCommon *common,
@@ -185,8 +349,10 @@ XLALSetupFstatResampGeneric ( void **method_data,
 
   // Set method function pointers
   funcs->compute_func = XLALComputeFstatResampGeneric;
+  funcs->compute_batch_func = XLALComputeFstatResampGenericBatch;
   funcs->method_data_destroy_func = XLALDestroyResampGenericMethodData;
   funcs->workspace_destroy_func = XLALDestroyResampGenericWorkspace;
+  funcs->workspace_fit_func = XLALFitResampGenericWorkspaceToMethodData;
 
   // Extra band needed for resampling: Hamming-windowed sinc used for interpolation has a transition bandwith of
   // TB=(4/L)*fSamp, where L=2*Dterms+1 is the window-length, and here fSamp=Band (i.e. the full SFT frequency band)
@@ -278,42 +444,8 @@ XLALSetupFstatResampGeneric ( void **method_data,
 
   // ---- re-use shared workspace, or allocate here ----------
   ResampGenericWorkspace *ws = (ResampGenericWorkspace*) common->workspace;
-  if ( ws != NULL )
-    {
-      if ( numSamplesFFT > ws->numSamplesFFTAlloc )
-        {
-          fftw_free ( ws->FabX_Raw );
-          XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-          fftw_free ( ws->TS_FFT );
-          XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-
-          ws->numSamplesFFTAlloc = numSamplesFFT;
-        }
-
-      // adjust maximal SRC-frame timeseries length, if necessary
-      if ( numSamplesMax_SRC > ws->TStmp1_SRC->length ) {
-        XLAL_CHECK ( (ws->TStmp1_SRC->data = XLALRealloc ( ws->TStmp1_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-        ws->TStmp1_SRC->length = numSamplesMax_SRC;
-        XLAL_CHECK ( (ws->TStmp2_SRC->data = XLALRealloc ( ws->TStmp2_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-        ws->TStmp2_SRC->length = numSamplesMax_SRC;
-        XLAL_CHECK ( (ws->SRCtimes_DET->data = XLALRealloc ( ws->SRCtimes_DET->data, numSamplesMax_SRC * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
-        ws->SRCtimes_DET->length = numSamplesMax_SRC;
-      }
-
-    } // end: if shared workspace given
-  else
-    {
-      XLAL_CHECK ( (ws = XLALCalloc ( 1, sizeof(*ws))) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-
-      XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      ws->numSamplesFFTAlloc = numSamplesFFT;
-
-      common->workspace = ws;
-    } // end: if we create our own workspace
+  XLAL_CHECK ( XLALFitResampGenericWorkspace ( &ws, numSamplesFFT, numSamplesMax_SRC ) == XLAL_SUCCESS, XLAL_EFUNC );
+  common->workspace = ws;
 
   // ----- compute and buffer FFT plan ----------
   int fft_plan_flags=FFTW_MEASURE;
@@ -634,6 +766,86 @@ XLALComputeFstatResampGeneric ( FstatResults* Fstats,
 
 } // XLALComputeFstatResampGeneric()
 
+///
+/// Exchanges the SRC-frame timeseries of template 'i' in the batch buffer with the resampling buffer
+///
+static void
+XLALSwapBatchBuffer_ResampGeneric ( ResampGenericMethodData *resamp, UINT4 i )
+{
+  MultiCOMPLEX8TimeSeries *tmp;
+  tmp = resamp->multiTimeSeries_SRC_a;
+  resamp->multiTimeSeries_SRC_a = resamp->batch_SRC_a[i];
+  resamp->batch_SRC_a[i] = tmp;
+  tmp = resamp->multiTimeSeries_SRC_b;
+  resamp->multiTimeSeries_SRC_b = resamp->batch_SRC_b[i];
+  resamp->batch_SRC_b[i] = tmp;
+} // XLALSwapBatchBuffer_ResampGeneric()
+
+///
+/// Computes the F-statistic for a batch of templates: binary-orbit templates at the same sky-position are resampled together
+/// by XLALBarycentricResampleBatchGeneric() in blocks of at most #RESAMP_GENERIC_MAX_BATCH templates, then {Fa,Fb} are computed
+/// from the SRC-frame timeseries of each template in turn; all other batches are computed one template at a time
+///
+static int
+XLALComputeFstatResampGenericBatch ( FstatResults **Fstats,
+                                     UINT4 numDopplers,
+                                     const FstatCommon *common,
+                                     void *method_data
+                                     )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( common != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( method_data != NULL, XLAL_EFAULT );
+  for ( UINT4 i = 0; i < numDopplers; i ++ ) {
+    XLAL_CHECK ( Fstats[i] != NULL, XLAL_EFAULT );
+  }
+
+  ResampGenericMethodData *resamp = (ResampGenericMethodData*) method_data;
+
+  // can only share the resampling between binary templates with identical sky-position and reference time
+  BOOLEAN batchResample = ( numDopplers > 1 );
+  for ( UINT4 i = 0; batchResample && (i < numDopplers); i ++ )
+    {
+      const PulsarDopplerParams *doppler_i = &(Fstats[i]->doppler);
+      batchResample = (doppler_i->asini > 0) &&
+        (doppler_i->Alpha == Fstats[0]->doppler.Alpha) && (doppler_i->Delta == Fstats[0]->doppler.Delta) &&
+        ( GPSDIFF ( doppler_i->refTime, Fstats[0]->doppler.refTime ) == 0 );
+    }
+  if ( ! batchResample )
+    {
+      for ( UINT4 i = 0; i < numDopplers; i ++ ) {
+        XLAL_CHECK ( XLALComputeFstatResampGeneric ( Fstats[i], common, resamp ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+      return XLAL_SUCCESS;
+    }
+
+  XLAL_CHECK ( XLALAllocBatchBuffer_ResampGeneric ( resamp, MYMIN ( numDopplers, RESAMP_GENERIC_MAX_BATCH ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  for ( UINT4 i0 = 0; i0 < numDopplers; i0 += RESAMP_GENERIC_MAX_BATCH )
+    {
+      UINT4 numBatch = MYMIN ( RESAMP_GENERIC_MAX_BATCH, numDopplers - i0 );
+      XLAL_CHECK ( XLALBarycentricResampleBatchGeneric ( resamp, &Fstats[i0], numBatch, common ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // swap the SRC-frame timeseries of each template into the resampling buffer, which XLALComputeFstatResampGeneric() then re-uses;
+      // the last template of the block stays in the buffer, consistent with 'prev_doppler'
+      // [note: the timing model therefore does not include the barycentering of batched templates]
+      for ( UINT4 i = 0; i < numBatch; i ++ )
+        {
+          XLALSwapBatchBuffer_ResampGeneric ( resamp, i );
+          resamp->prev_doppler = Fstats[i0 + i]->doppler;
+          XLAL_CHECK ( XLALComputeFstatResampGeneric ( Fstats[i0 + i], common, resamp ) == XLAL_SUCCESS, XLAL_EFUNC );
+          if ( i + 1 < numBatch ) {
+            XLALSwapBatchBuffer_ResampGeneric ( resamp, i );
+          }
+        } // for i < numBatch
+
+    } // for i0 < numDopplers
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatResampGenericBatch()
+
 
 static int
 XLALComputeFaFb_ResampGeneric ( ResampGenericMethodData *resamp,				//!< [in,out] buffered resampling data and workspace
@@ -807,6 +1019,180 @@ XLALApplySpindownAndFreqShiftGeneric ( COMPLEX8 *restrict xOut,      			///< [ou
 
 } // XLALApplySpindownAndFreqShiftGeneric()
 
+///
+/// Computes and buffers the sky-dependent quantities (antenna-patterns and SSB timings) for the sky-position and reference time of 'thisPoint'
+///
+static int
+XLALComputeSkyBuffer_ResampGeneric ( ResampGenericMethodData *resamp,	// [in/out] resampling input and buffer
+                                     const PulsarDopplerParams *thisPoint,	// [in] current skypoint and reftime
+                                     const FstatCommon *common		// [in] various input quantities and parameters used here
+                                     )
+{
+  UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
+
+  SkyPosition skypos;
+  skypos.system = COORDINATESYSTEM_EQUATORIAL;
+  skypos.longitude = thisPoint->Alpha;
+  skypos.latitude  = thisPoint->Delta;
+
+  XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
+  XLAL_CHECK ( (resamp->multiAMcoef = XLALComputeMultiAMCoeffs ( common->multiDetectorStates, common->multiNoiseWeights, skypos )) != NULL, XLAL_EFUNC );
+  resamp->Mmunu = resamp->multiAMcoef->Mmunu;
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      resamp->MmunuX[X].Ad = resamp->multiAMcoef->data[X]->A;
+      resamp->MmunuX[X].Bd = resamp->multiAMcoef->data[X]->B;
+      resamp->MmunuX[X].Cd = resamp->multiAMcoef->data[X]->C;
+      resamp->MmunuX[X].Ed = 0;
+      resamp->MmunuX[X].Dd = resamp->multiAMcoef->data[X]->D;
+    }
+
+  XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
+  XLAL_CHECK ( (resamp->multiSSBtimes = XLALGetMultiSSBtimes ( common->multiDetectorStates, skypos, thisPoint->refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeSkyBuffer_ResampGeneric()
+
+///
+/// Computes the detector-frame times 'ti_DET' corresponding to the uniformly-spaced SRC-frame samples of detector X,
+/// and the heterodyne and AM correction factors to be applied to the interpolated timeseries; also sets the SRC-frame
+/// epoch and heterodyne frequency of the output timeseries
+///
+static int
+XLALComputeSRCtimesDET_ResampGeneric ( REAL8Vector *ti_DET,				// [out] detector-frame times of SRC-frame samples
+                                       COMPLEX8Vector *TStmp1_SRC,			// [out] heterodyne correction * a(t)
+                                       COMPLEX8Vector *TStmp2_SRC,			// [out] heterodyne correction * b(t)
+                                       COMPLEX8TimeSeries *TimeSeries_SRCX_a,		// [in/out] SRC-frame timeseries * a(t) [only header and length used]
+                                       COMPLEX8TimeSeries *TimeSeries_SRCX_b,		// [in/out] SRC-frame timeseries * b(t) [only header and length used]
+                                       const COMPLEX8TimeSeries *TimeSeries_DETX,	// [in] detector-frame timeseries
+                                       const LIGOTimeGPSVector *Timestamps_DETX,	// [in] SFT timestamps
+                                       const SSBtimes *SRCtimesX,			// [in] SRC-frame timings
+                                       const AMCoeffs *AMcoefX,				// [in] antenna-pattern functions
+                                       REAL8 Tsft					// [in] SFT length
+                                       )
+{
+  const REAL4 signumLUT[2] = {1, -1};
+
+  // useful shorthands
+  REAL8 fHet            = TimeSeries_DETX->f0;
+  REAL8 dt_SRC          = TimeSeries_SRCX_a->deltaT;
+  REAL8 refTime8        = GPSGETREAL8 ( &SRCtimesX->refTime );
+  UINT4 numSFTsX        = Timestamps_DETX->length;
+  UINT4 numSamples_DETX = TimeSeries_DETX->data->length;
+  UINT4 numSamples_SRCX = TimeSeries_SRCX_a->data->length;
+
+  // sanity checks on input data
+  XLAL_CHECK ( numSamples_SRCX == TimeSeries_SRCX_b->data->length, XLAL_EINVAL );
+  XLAL_CHECK ( dt_SRC == TimeSeries_SRCX_b->deltaT, XLAL_EINVAL );
+  XLAL_CHECK ( numSamples_DETX > 0, XLAL_EINVAL, "Input timeseries has zero samples. Can't handle that!\n" );
+  XLAL_CHECK ( (SRCtimesX->DeltaT->length == numSFTsX) && (SRCtimesX->Tdot->length == numSFTsX), XLAL_EINVAL );
+  XLAL_CHECK ( ti_DET->length >= numSamples_SRCX, XLAL_EINVAL );
+  XLAL_CHECK ( (TStmp1_SRC->length >= numSamples_SRCX) && (TStmp2_SRC->length >= numSamples_SRCX), XLAL_EINVAL );
+
+  TimeSeries_SRCX_a->f0 = fHet;
+  TimeSeries_SRCX_b->f0 = fHet;
+  // set SRC-frame time-series start-time
+  REAL8 tStart_SRC_0 = refTime8 + SRCtimesX->DeltaT->data[0] - (0.5*Tsft) * SRCtimesX->Tdot->data[0];
+  LIGOTimeGPS epoch;
+  GPSSETREAL8 ( epoch, tStart_SRC_0 );
+  TimeSeries_SRCX_a->epoch = epoch;
+  TimeSeries_SRCX_b->epoch = epoch;
+
+  // make sure detector-frame timesteps to interpolate to are initialized to 0, in case of gaps
+  memset ( ti_DET->data, 0, ti_DET->length * sizeof(ti_DET->data[0]) );
+
+  memset ( TStmp1_SRC->data, 0, TStmp1_SRC->length * sizeof(TStmp1_SRC->data[0]) );
+  memset ( TStmp2_SRC->data, 0, TStmp2_SRC->length * sizeof(TStmp2_SRC->data[0]) );
+
+  REAL8 tStart_DET_0 = GPSGETREAL8 ( &(Timestamps_DETX->data[0]) );// START time of the SFT at the detector
+
+  // loop over SFT timestamps and compute the detector frame time samples corresponding to uniformly sampled SRC time samples
+  for ( UINT4 alpha = 0; alpha < numSFTsX; alpha ++ )
+    {
+      // define some useful shorthands
+      REAL8 Tdot_al       = SRCtimesX->Tdot->data [ alpha ];		// the instantaneous time derivitive dt_SRC/dt_DET at the MID-POINT of the SFT
+      REAL8 tMid_SRC_al   = refTime8 + SRCtimesX->DeltaT->data[alpha];	// MID-POINT time of the SFT at the SRC
+      REAL8 tStart_SRC_al = tMid_SRC_al - 0.5 * Tsft * Tdot_al;		// approximate START time of the SFT at the SRC
+      REAL8 tEnd_SRC_al   = tMid_SRC_al + 0.5 * Tsft * Tdot_al;		// approximate END time of the SFT at the SRC
+
+      REAL8 tStart_DET_al = GPSGETREAL8 ( &(Timestamps_DETX->data[alpha]) );// START time of the SFT at the detector
+      REAL8 tMid_DET_al   = tStart_DET_al + 0.5 * Tsft;			// MID-POINT time of the SFT at the detector
+
+      // indices of first and last SRC-frame sample corresponding to this SFT
+      UINT4 iStart_SRC_al = lround ( (tStart_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the start of the SFT
+      UINT4 iEnd_SRC_al   = lround ( (tEnd_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the end of the SFT
+
+      // truncate to actual SRC-frame timeseries
+      iStart_SRC_al = MYMIN ( iStart_SRC_al, numSamples_SRCX - 1);
+      iEnd_SRC_al   = MYMIN ( iEnd_SRC_al, numSamples_SRCX - 1);
+      UINT4 numSamplesSFT_SRC_al = iEnd_SRC_al - iStart_SRC_al + 1;		// the number of samples in the SRC-frame for this SFT
+
+      REAL4 a_al = AMcoefX->a->data[alpha];
+      REAL4 b_al = AMcoefX->b->data[alpha];
+      for ( UINT4 j = 0; j < numSamplesSFT_SRC_al; j++ )
+        {
+          UINT4 iSRC_al_j  = iStart_SRC_al + j;
+
+          // for each time sample in the SRC frame, we estimate the corresponding detector time,
+          // using a linear approximation expanding around the midpoint of each SFT
+          REAL8 t_SRC = tStart_SRC_0 + iSRC_al_j * dt_SRC;
+          ti_DET->data [ iSRC_al_j ] = tMid_DET_al + ( t_SRC - tMid_SRC_al ) / Tdot_al;
+
+          // pre-compute correction factors due to non-zero heterodyne frequency of input
+          REAL8 tDiff = iSRC_al_j * dt_SRC + (tStart_DET_0 - ti_DET->data [ iSRC_al_j ]); 	// tSRC_al_j - tDET(tSRC_al_j)
+          REAL8 cycles = fmod ( fHet * tDiff, 1.0 );				// the accumulated heterodyne cycles
+
+          // use a look-up-table for speed to compute real and imaginary phase
+          REAL4 cosphase, sinphase;                                   // the real and imaginary parts of the phase correction
+          XLAL_CHECK( XLALSinCos2PiLUT ( &sinphase, &cosphase, -cycles ) == XLAL_SUCCESS, XLAL_EFUNC );
+          COMPLEX8 ei2piphase = crectf ( cosphase, sinphase );
+
+          // apply AM coefficients a(t), b(t) to SRC frame timeseries [alternate sign to get final FFT return DC in the middle]
+          REAL4 signum = signumLUT [ (iSRC_al_j % 2) ];	// alternating sign, avoid branching
+          ei2piphase *= signum;
+          TStmp1_SRC->data [ iSRC_al_j ] = ei2piphase * a_al;
+          TStmp2_SRC->data [ iSRC_al_j ] = ei2piphase * b_al;
+        } // for j < numSamples_SRC_al
+
+    } // for  alpha < numSFTsX
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeSRCtimesDET_ResampGeneric()
+
+///
+/// Checks the input timeseries and timestamps of all detectors for consistency with the SRC-frame buffer
+///
+static int
+XLALCheckResampleInput_ResampGeneric ( const ResampGenericMethodData *resamp,	// [in] resampling input and buffer
+                                       const FstatCommon *common		// [in] various input quantities and parameters used here
+                                       )
+{
+  XLAL_CHECK ( resamp != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( common != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( resamp->multiTimeSeries_DET != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( resamp->multiTimeSeries_SRC_a != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( resamp->multiTimeSeries_SRC_b != NULL, XLAL_EINVAL );
+
+  UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
+  XLAL_CHECK ( resamp->multiTimeSeries_SRC_a->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors tsDET(%d) != tsSRC(%d)\n", numDetectors, resamp->multiTimeSeries_SRC_a->length );
+  XLAL_CHECK ( resamp->multiTimeSeries_SRC_b->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors tsDET(%d) != tsSRC(%d)\n", numDetectors, resamp->multiTimeSeries_SRC_b->length );
+
+  REAL8 fHet = resamp->multiTimeSeries_DET->data[0]->f0;
+  REAL8 Tsft = common->multiTimestamps->data[0]->deltaT;
+  for ( UINT4 X = 0; X < numDetectors; X++ )
+    {
+      REAL8 fHetX = resamp->multiTimeSeries_DET->data[X]->f0;
+      XLAL_CHECK ( fabs( fHet - fHetX ) < LAL_REAL8_EPS * fHet, XLAL_EINVAL, "Input timeseries must have identical heterodyning frequency 'f0(X=%d)' (%.16g != %.16g)\n", X, fHet, fHetX );
+      REAL8 TsftX = common->multiTimestamps->data[X]->deltaT;
+      XLAL_CHECK ( Tsft == TsftX, XLAL_EINVAL, "Input timestamps must have identical stepsize 'Tsft(X=%d)' (%.16g != %.16g)\n", X, Tsft, TsftX );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALCheckResampleInput_ResampGeneric()
+
 ///
 /// Performs barycentric resampling on a multi-detector timeseries, updates resampling buffer with results
 ///
@@ -822,17 +1208,11 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeriesGeneric ( ResampGenericMethodData
 {
   // check input sanity
   XLAL_CHECK ( thisPoint != NULL, XLAL_EINVAL );
-  XLAL_CHECK ( common != NULL, XLAL_EINVAL );
-  XLAL_CHECK ( resamp != NULL, XLAL_EINVAL );
-  XLAL_CHECK ( resamp->multiTimeSeries_DET != NULL, XLAL_EINVAL );
-  XLAL_CHECK ( resamp->multiTimeSeries_SRC_a != NULL, XLAL_EINVAL );
-  XLAL_CHECK ( resamp->multiTimeSeries_SRC_b != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( XLALCheckResampleInput_ResampGeneric ( resamp, common ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   ResampGenericWorkspace *ws = (ResampGenericWorkspace*) common->workspace;
 
   UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
-  XLAL_CHECK ( resamp->multiTimeSeries_SRC_a->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors tsDET(%d) != tsSRC(%d)\n", numDetectors, resamp->multiTimeSeries_SRC_a->length );
-  XLAL_CHECK ( resamp->multiTimeSeries_SRC_b->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors tsDET(%d) != tsSRC(%d)\n", numDetectors, resamp->multiTimeSeries_SRC_b->length );
 
   // ============================== BEGIN: handle buffering =============================
   BOOLEAN same_skypos = (resamp->prev_doppler.Alpha == thisPoint->Alpha) && (resamp->prev_doppler.Delta == thisPoint->Delta);
@@ -865,26 +1245,7 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeriesGeneric ( ResampGenericMethodData
   // only if different sky-position: re-compute antenna-patterns and SSB timings, re-use from buffer otherwise
   if ( ! ( same_skypos && same_refTime ) )
     {
-      SkyPosition skypos;
-      skypos.system = COORDINATESYSTEM_EQUATORIAL;
-      skypos.longitude = thisPoint->Alpha;
-      skypos.latitude  = thisPoint->Delta;
-
-      XLALDestroyMultiAMCoeffs ( resamp->multiAMcoef );
-      XLAL_CHECK ( (resamp->multiAMcoef = XLALComputeMultiAMCoeffs ( common->multiDetectorStates, common->multiNoiseWeights, skypos )) != NULL, XLAL_EFUNC );
-      resamp->Mmunu = resamp->multiAMcoef->Mmunu;
-      for ( UINT4 X = 0; X < numDetectors; X ++ )
-        {
-          resamp->MmunuX[X].Ad = resamp->multiAMcoef->data[X]->A;
-          resamp->MmunuX[X].Bd = resamp->multiAMcoef->data[X]->B;
-          resamp->MmunuX[X].Cd = resamp->multiAMcoef->data[X]->C;
-          resamp->MmunuX[X].Ed = 0;
-          resamp->MmunuX[X].Dd = resamp->multiAMcoef->data[X]->D;
-        }
-
-      XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
-      XLAL_CHECK ( (resamp->multiSSBtimes = XLALGetMultiSSBtimes ( common->multiDetectorStates, skypos, thisPoint->refTime, common->SSBprec )) != NULL, XLAL_EFUNC );
-
+      XLAL_CHECK ( XLALComputeSkyBuffer_ResampGeneric ( resamp, thisPoint, common ) == XLAL_SUCCESS, XLAL_EFUNC );
     } // if cannot re-use buffered solution ie if !(same_skypos && same_binary)
 
   if ( thisPoint->asini > 0 ) { // binary case
@@ -898,116 +1259,25 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeriesGeneric ( ResampGenericMethodData
   resamp->prev_doppler = (*thisPoint);
 
   // shorthands
-  REAL8 fHet = resamp->multiTimeSeries_DET->data[0]->f0;
   REAL8 Tsft = common->multiTimestamps->data[0]->deltaT;
-  REAL8 dt_SRC = resamp->multiTimeSeries_SRC_a->data[0]->deltaT;
-
-  const REAL4 signumLUT[2] = {1, -1};
 
   // loop over detectors X
   for ( UINT4 X = 0; X < numDetectors; X++)
     {
       // shorthand pointers: input
       const COMPLEX8TimeSeries *TimeSeries_DETX = resamp->multiTimeSeries_DET->data[X];
-      const LIGOTimeGPSVector  *Timestamps_DETX = common->multiTimestamps->data[X];
-      const SSBtimes *SRCtimesX                 = multiSRCtimes->data[X];
-      const AMCoeffs *AMcoefX			= resamp->multiAMcoef->data[X];
 
       // shorthand pointers: output
       COMPLEX8TimeSeries *TimeSeries_SRCX_a     = resamp->multiTimeSeries_SRC_a->data[X];
       COMPLEX8TimeSeries *TimeSeries_SRCX_b     = resamp->multiTimeSeries_SRC_b->data[X];
       REAL8Vector *ti_DET = ws->SRCtimes_DET;
-
-      // useful shorthands
-      REAL8 refTime8        = GPSGETREAL8 ( &SRCtimesX->refTime );
-      UINT4 numSFTsX        = Timestamps_DETX->length;
-      UINT4 numSamples_DETX = TimeSeries_DETX->data->length;
       UINT4 numSamples_SRCX = TimeSeries_SRCX_a->data->length;
 
-      // sanity checks on input data
-      XLAL_CHECK ( numSamples_SRCX == TimeSeries_SRCX_b->data->length, XLAL_EINVAL );
-      XLAL_CHECK ( dt_SRC == TimeSeries_SRCX_a->deltaT, XLAL_EINVAL );
-      XLAL_CHECK ( dt_SRC == TimeSeries_SRCX_b->deltaT, XLAL_EINVAL );
-      XLAL_CHECK ( numSamples_DETX > 0, XLAL_EINVAL, "Input timeseries for detector X=%d has zero samples. Can't handle that!\n", X );
-      XLAL_CHECK ( (SRCtimesX->DeltaT->length == numSFTsX) && (SRCtimesX->Tdot->length == numSFTsX), XLAL_EINVAL );
-      REAL8 fHetX = resamp->multiTimeSeries_DET->data[X]->f0;
-      XLAL_CHECK ( fabs( fHet - fHetX ) < LAL_REAL8_EPS * fHet, XLAL_EINVAL, "Input timeseries must have identical heterodyning frequency 'f0(X=%d)' (%.16g != %.16g)\n", X, fHet, fHetX );
-      REAL8 TsftX = common->multiTimestamps->data[X]->deltaT;
-      XLAL_CHECK ( Tsft == TsftX, XLAL_EINVAL, "Input timestamps must have identical stepsize 'Tsft(X=%d)' (%.16g != %.16g)\n", X, Tsft, TsftX );
+      XLAL_CHECK ( XLALComputeSRCtimesDET_ResampGeneric ( ti_DET, ws->TStmp1_SRC, ws->TStmp2_SRC, TimeSeries_SRCX_a, TimeSeries_SRCX_b,
+                                                          TimeSeries_DETX, common->multiTimestamps->data[X], multiSRCtimes->data[X], resamp->multiAMcoef->data[X], Tsft ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-      TimeSeries_SRCX_a->f0 = fHet;
-      TimeSeries_SRCX_b->f0 = fHet;
-      // set SRC-frame time-series start-time
-      REAL8 tStart_SRC_0 = refTime8 + SRCtimesX->DeltaT->data[0] - (0.5*Tsft) * SRCtimesX->Tdot->data[0];
-      LIGOTimeGPS epoch;
-      GPSSETREAL8 ( epoch, tStart_SRC_0 );
-      TimeSeries_SRCX_a->epoch = epoch;
-      TimeSeries_SRCX_b->epoch = epoch;
-
-      // make sure all output samples are initialized to zero first, in case of gaps
-      memset ( TimeSeries_SRCX_a->data->data, 0, TimeSeries_SRCX_a->data->length * sizeof(TimeSeries_SRCX_a->data->data[0]) );
-      memset ( TimeSeries_SRCX_b->data->data, 0, TimeSeries_SRCX_b->data->length * sizeof(TimeSeries_SRCX_b->data->data[0]) );
-      // make sure detector-frame timesteps to interpolate to are initialized to 0, in case of gaps
-      memset ( ws->SRCtimes_DET->data, 0, ws->SRCtimes_DET->length * sizeof(ws->SRCtimes_DET->data[0]) );
-
-      memset ( ws->TStmp1_SRC->data, 0, ws->TStmp1_SRC->length * sizeof(ws->TStmp1_SRC->data[0]) );
-      memset ( ws->TStmp2_SRC->data, 0, ws->TStmp2_SRC->length * sizeof(ws->TStmp2_SRC->data[0]) );
-
-      REAL8 tStart_DET_0 = GPSGETREAL8 ( &(Timestamps_DETX->data[0]) );// START time of the SFT at the detector
-
-      // loop over SFT timestamps and compute the detector frame time samples corresponding to uniformly sampled SRC time samples
-      for ( UINT4 alpha = 0; alpha < numSFTsX; alpha ++ )
-        {
-          // define some useful shorthands
-          REAL8 Tdot_al       = SRCtimesX->Tdot->data [ alpha ];		// the instantaneous time derivitive dt_SRC/dt_DET at the MID-POINT of the SFT
-          REAL8 tMid_SRC_al   = refTime8 + SRCtimesX->DeltaT->data[alpha];	// MID-POINT time of the SFT at the SRC
-          REAL8 tStart_SRC_al = tMid_SRC_al - 0.5 * Tsft * Tdot_al;		// approximate START time of the SFT at the SRC
-          REAL8 tEnd_SRC_al   = tMid_SRC_al + 0.5 * Tsft * Tdot_al;		// approximate END time of the SFT at the SRC
-
-          REAL8 tStart_DET_al = GPSGETREAL8 ( &(Timestamps_DETX->data[alpha]) );// START time of the SFT at the detector
-          REAL8 tMid_DET_al   = tStart_DET_al + 0.5 * Tsft;			// MID-POINT time of the SFT at the detector
-
-          // indices of first and last SRC-frame sample corresponding to this SFT
-          UINT4 iStart_SRC_al = lround ( (tStart_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the start of the SFT
-          UINT4 iEnd_SRC_al   = lround ( (tEnd_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the end of the SFT
-
-          // truncate to actual SRC-frame timeseries
-          iStart_SRC_al = MYMIN ( iStart_SRC_al, numSamples_SRCX - 1);
-          iEnd_SRC_al   = MYMIN ( iEnd_SRC_al, numSamples_SRCX - 1);
-          UINT4 numSamplesSFT_SRC_al = iEnd_SRC_al - iStart_SRC_al + 1;		// the number of samples in the SRC-frame for this SFT
-
-          REAL4 a_al = AMcoefX->a->data[alpha];
-          REAL4 b_al = AMcoefX->b->data[alpha];
-          for ( UINT4 j = 0; j < numSamplesSFT_SRC_al; j++ )
-            {
-              UINT4 iSRC_al_j  = iStart_SRC_al + j;
-
-              // for each time sample in the SRC frame, we estimate the corresponding detector time,
-              // using a linear approximation expanding around the midpoint of each SFT
-              REAL8 t_SRC = tStart_SRC_0 + iSRC_al_j * dt_SRC;
-              ti_DET->data [ iSRC_al_j ] = tMid_DET_al + ( t_SRC - tMid_SRC_al ) / Tdot_al;
-
-              // pre-compute correction factors due to non-zero heterodyne frequency of input
-              REAL8 tDiff = iSRC_al_j * dt_SRC + (tStart_DET_0 - ti_DET->data [ iSRC_al_j ]); 	// tSRC_al_j - tDET(tSRC_al_j)
-              REAL8 cycles = fmod ( fHet * tDiff, 1.0 );				// the accumulated heterodyne cycles
-
-              // use a look-up-table for speed to compute real and imaginary phase
-              REAL4 cosphase, sinphase;                                   // the real and imaginary parts of the phase correction
-              XLAL_CHECK( XLALSinCos2PiLUT ( &sinphase, &cosphase, -cycles ) == XLAL_SUCCESS, XLAL_EFUNC );
-              COMPLEX8 ei2piphase = crectf ( cosphase, sinphase );
-
-              // apply AM coefficients a(t), b(t) to SRC frame timeseries [alternate sign to get final FFT return DC in the middle]
-              REAL4 signum = signumLUT [ (iSRC_al_j % 2) ];	// alternating sign, avoid branching
-              ei2piphase *= signum;
-              ws->TStmp1_SRC->data [ iSRC_al_j ] = ei2piphase * a_al;
-              ws->TStmp2_SRC->data [ iSRC_al_j ] = ei2piphase * b_al;
-            } // for j < numSamples_SRC_al
-
-        } // for  alpha < numSFTsX
-
-      XLAL_CHECK ( ti_DET->length >= TimeSeries_SRCX_a->data->length, XLAL_EINVAL );
       UINT4 bak_length = ti_DET->length;
-      ti_DET->length = TimeSeries_SRCX_a->data->length;
+      ti_DET->length = numSamples_SRCX;
       XLAL_CHECK ( XLALSincInterpolateCOMPLEX8TimeSeries ( TimeSeries_SRCX_a->data, ti_DET, TimeSeries_DETX, resamp->Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
       ti_DET->length = bak_length;
 
@@ -1029,6 +1299,95 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeriesGeneric ( ResampGenericMethodData
 
 } // XLALBarycentricResampleMultiCOMPLEX8TimeSeriesGeneric()
 
+///
+/// Performs barycentric resampling on a multi-detector timeseries for a batch of binary-orbit templates at the same sky-position
+/// and reference time, storing the SRC-frame timeseries of template 'i' in the batch buffer 'batch_SRC_a[i]', 'batch_SRC_b[i]'.
+///
+/// The antenna-patterns and SSB timings are computed (or taken from the buffer) only once, and the detector-frame timeseries
+/// of each detector is interpolated onto the SRC-frame samples of all templates in a single pass, see XLALSincInterpolateCOMPLEX8TimeSeriesBatch()
+///
+static int
+XLALBarycentricResampleBatchGeneric ( ResampGenericMethodData *resamp,	// [in/out] resampling input and buffer
+                                      FstatResults **Fstats,		// [in] batch of results structs holding the templates
+                                      UINT4 numDopplers,		// [in] number of templates in the batch
+                                      const FstatCommon *common		// [in] various input quantities and parameters used here
+                                      )
+{
+  XLAL_CHECK ( XLALCheckResampleInput_ResampGeneric ( resamp, common ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( numDopplers <= resamp->numBatchAlloc, XLAL_EINVAL );
+
+  const PulsarDopplerParams *thisPoint = &(Fstats[0]->doppler);
+  UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
+
+  // re-compute antenna-patterns and SSB timings only if sky-position or reference time differ from buffer
+  BOOLEAN same_skypos = (resamp->prev_doppler.Alpha == thisPoint->Alpha) && (resamp->prev_doppler.Delta == thisPoint->Delta);
+  BOOLEAN same_refTime = ( GPSDIFF ( resamp->prev_doppler.refTime, thisPoint->refTime ) == 0 );
+  if ( ! ( same_skypos && same_refTime ) )
+    {
+      XLAL_CHECK ( XLALComputeSkyBuffer_ResampGeneric ( resamp, thisPoint, common ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // the buffered SRC-frame timeseries no longer correspond to the buffered sky-position
+      XLAL_INIT_MEM ( resamp->prev_doppler );
+      resamp->prev_doppler.Alpha = thisPoint->Alpha;
+      resamp->prev_doppler.Delta = thisPoint->Delta;
+      resamp->prev_doppler.refTime = thisPoint->refTime;
+      resamp->prev_doppler.asini = -1;
+    }
+
+  // SRC-frame timings of all templates
+  for ( UINT4 i = 0; i < numDopplers; i ++ )
+    {
+      XLAL_CHECK ( XLALAddMultiBinaryTimes ( &resamp->batchBinaryTimes[i], resamp->multiSSBtimes, &(Fstats[i]->doppler) ) == XLAL_SUCCESS, XLAL_EFUNC );
+      resamp->timingGeneric.NBufferMisses ++;
+    }
+
+  REAL8 Tsft = common->multiTimestamps->data[0]->deltaT;
+
+  // loop over detectors X
+  for ( UINT4 X = 0; X < numDetectors; X++ )
+    {
+      const COMPLEX8TimeSeries *TimeSeries_DETX = resamp->multiTimeSeries_DET->data[X];
+      UINT4 numSamples_SRCX = resamp->multiTimeSeries_SRC_a->data[X]->data->length;
+
+      // detector-frame times and correction factors for all templates
+      for ( UINT4 i = 0; i < numDopplers; i ++ )
+        {
+          XLAL_CHECK ( XLALComputeSRCtimesDET_ResampGeneric ( resamp->batchSRCtimes_DET[i], resamp->batchTStmp1_SRC[i], resamp->batchTStmp2_SRC[i],
+                                                              resamp->batch_SRC_a[i]->data[X], resamp->batch_SRC_b[i]->data[X],
+                                                              TimeSeries_DETX, common->multiTimestamps->data[X], resamp->batchBinaryTimes[i]->data[X], resamp->multiAMcoef->data[X], Tsft ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+
+      // interpolate detector-frame timeseries onto SRC-frame samples of all templates in one pass
+      for ( UINT4 i = 0; i < numDopplers; i ++ )
+        {
+          resamp->batchSRCtimes_DET[i]->length = numSamples_SRCX;
+          resamp->batchTS_SRC_a[i] = resamp->batch_SRC_a[i]->data[X]->data;
+        }
+      int errcode = XLALSincInterpolateCOMPLEX8TimeSeriesBatch ( resamp->batchTS_SRC_a, resamp->batchSRCtimes_DET, numDopplers, TimeSeries_DETX, resamp->Dterms );
+      for ( UINT4 i = 0; i < numDopplers; i ++ ) {
+        resamp->batchSRCtimes_DET[i]->length = resamp->batchTStmp1_SRC[i]->length;
+      }
+      XLAL_CHECK ( errcode == XLAL_SUCCESS, XLAL_EFUNC );
+
+      // apply heterodyne correction and AM-functions a(t) and b(t) to interpolated timeseries
+      for ( UINT4 i = 0; i < numDopplers; i ++ )
+        {
+          COMPLEX8 *TS_SRCX_a = resamp->batch_SRC_a[i]->data[X]->data->data;
+          COMPLEX8 *TS_SRCX_b = resamp->batch_SRC_b[i]->data[X]->data->data;
+          const COMPLEX8 *TStmp1 = resamp->batchTStmp1_SRC[i]->data;
+          const COMPLEX8 *TStmp2 = resamp->batchTStmp2_SRC[i]->data;
+          for ( UINT4 j = 0; j < numSamples_SRCX; j ++ )
+            {
+              TS_SRCX_b[j] = TS_SRCX_a[j] * TStmp2[j];
+              TS_SRCX_a[j] *= TStmp1[j];
+            } // for j < numSamples_SRCX
+        } // for i < numDopplers
+
+    } // for X < numDetectors
+
+  return XLAL_SUCCESS;
+
+} // XLALBarycentricResampleBatchGeneric()
+
 static void
 XLALGetFFTPlanHints ( int * planMode,
                       double * planGenTimeoutSeconds
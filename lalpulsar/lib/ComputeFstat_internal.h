@@ -69,8 +69,12 @@ typedef struct {
   int (*compute_func) (					// F-statistic method computation function
     FstatResults *, const FstatCommon *, void *
     );
+  int (*compute_batch_func) (				// Optional: F-statistic computation over a batch of templates [NULL: loop over compute_func]
+    FstatResults **, UINT4, const FstatCommon *, void *
+    );
   void (*method_data_destroy_func) ( void * );		// F-statistic method data destructor function
   void (*workspace_destroy_func) ( void * );		// Workspace destructor function
+  int (*workspace_fit_func) ( void **, const void * );	// Optional: allocate or enlarge a workspace to be usable with the given method data
 } FstatMethodFuncs;
 
 // ---------- Shared internal functions ---------- //
@@ -19,6 +19,12 @@
 
 #include <lal/LALHough.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 /** \cond DONT_DOXYGEN */
 
 #ifdef __GNUC__
@@ -580,6 +586,278 @@ void LALHOUGHConstructHMT_W (LALStatus                  *status,	/**< pointer to
 
 
 
+/*
+ * Clip the rows affected by a border to the map, as LALHOUGHAddPHMD2HD() does
+ */
+static inline void HOUGHClipBorderRows ( const HOUGHBorder *borderP, UINT2 ySide, INT4 *yLower, INT4 *yUpper )
+{
+  *yLower = ( borderP->yLower < 0 ) ? 0 : borderP->yLower;
+  *yUpper = ( borderP->yUpper >= ySide ) ? ySide - 1 : borderP->yUpper;
+}
+
+/*
+ * Check once that all the pixels marked by the borders of a phmd lie within
+ * a Hough map derivative of xSide+1 columns, so that they need not be
+ * checked each time the phmd is added to a map
+ */
+static int HOUGHCheckPHMDBorders ( const HOUGHphmd *phmd, UINT2 xSide, UINT2 ySide )
+{
+  const UINT4 numBorders = phmd->lengthLeft + phmd->lengthRight;
+  for ( UINT4 b = 0; b < numBorders; ++b ) {
+    const HOUGHBorder *borderP = ( b < phmd->lengthLeft ) ? phmd->leftBorderP[b] : phmd->rightBorderP[b - phmd->lengthLeft];
+    XLAL_CHECK ( borderP != NULL && borderP->xPixel != NULL, XLAL_EFAULT );
+    if ( borderP->yLower < 0 || borderP->yUpper >= ySide ) {
+      XLALPrintWarning ( "%s: clipping border rows [%d,%d] to [0,%d]\n", __func__, borderP->yLower, borderP->yUpper, ySide - 1 );
+    }
+    INT4 yLower, yUpper;
+    HOUGHClipBorderRows ( borderP, ySide, &yLower, &yUpper );
+    INT4 xMin = xSide, xMax = 0;
+    for ( INT4 j = yLower; j <= yUpper; ++j ) {
+      xMin = ( borderP->xPixel[j] < xMin ) ? borderP->xPixel[j] : xMin;
+      xMax = ( borderP->xPixel[j] > xMax ) ? borderP->xPixel[j] : xMax;
+    }
+    XLAL_CHECK ( yLower > yUpper || ( xMin >= 0 && xMax <= xSide ), XLAL_EDOM, "Border pixels [%d,%d] outside Hough map derivative of %d columns\n", xMin, xMax, xSide + 1 );
+  }
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Add (sign = +1) or subtract (sign = -1) a phmd to an integer Hough map
+ * derivative stored column by column, i.e. pixel (x,y) is hd[x*ySide + y].
+ * In this layout the first column correction is a contiguous vector addition.
+ */
+static void HOUGHAddPHMD2IntHD ( INT4 *hd, const HOUGHphmd *phmd, UINT2 ySide, INT4 sign )
+{
+  const UCHAR *firstColumn = phmd->firstColumn;
+  for ( UINT4 j = 0; j < ySide; ++j ) {
+    hd[j] += sign * firstColumn[j];
+  }
+
+  /* left borders =>  +1 increase */
+  for ( UINT4 b = 0; b < phmd->lengthLeft; ++b ) {
+    const HOUGHBorder *borderP = phmd->leftBorderP[b];
+    const COORType *xPixel = borderP->xPixel;
+    INT4 yLower, yUpper;
+    HOUGHClipBorderRows ( borderP, ySide, &yLower, &yUpper );
+    for ( INT4 j = yLower; j <= yUpper; ++j ) {
+      hd[xPixel[j] * ySide + j] += sign;
+    }
+  }
+
+  /* right borders =>  -1 decrease */
+  for ( UINT4 b = 0; b < phmd->lengthRight; ++b ) {
+    const HOUGHBorder *borderP = phmd->rightBorderP[b];
+    const COORType *xPixel = borderP->xPixel;
+    INT4 yLower, yUpper;
+    HOUGHClipBorderRows ( borderP, ySide, &yLower, &yUpper );
+    for ( INT4 j = yLower; j <= yUpper; ++j ) {
+      hd[xPixel[j] * ySide + j] -= sign;
+    }
+  }
+}
+
+/*
+ * Integrate an integer Hough map derivative stored column by column; all
+ * rows are integrated together, so the inner loop is a vector addition.
+ */
+static void HOUGHIntegrIntHD2HT ( HoughTT *map, const INT4 *hd, INT4 *row, UINT2 xSide, UINT2 ySide )
+{
+  memset ( row, 0, ySide * sizeof ( row[0] ) );
+  for ( UINT4 i = 0; i < xSide; ++i ) {
+    const INT4 *column = hd + i * ySide;
+    for ( UINT4 j = 0; j < ySide; ++j ) {
+      row[j] += column[j];
+    }
+    for ( UINT4 j = 0; j < ySide; ++j ) {
+      map[j * xSide + i] = row[j];
+    }
+  }
+}
+
+/*
+ * Add a weighted phmd to a Hough map derivative, in the same order of
+ * operations as LALHOUGHAddPHMD2HD_W(), so that the result is identical
+ */
+static void HOUGHAddPHMD2HD_W ( HoughDT *hd, const HOUGHphmd *phmd, UINT2 xSide, UINT2 ySide )
+{
+  const HoughDT weight = phmd->weight;
+  for ( UINT4 k = 0; k < ySide; ++k ) {
+    hd[k * ( xSide + 1 )] += phmd->firstColumn[k] * weight;
+  }
+  for ( UINT4 b = 0; b < phmd->lengthLeft; ++b ) {
+    const HOUGHBorder *borderP = phmd->leftBorderP[b];
+    INT4 yLower, yUpper;
+    HOUGHClipBorderRows ( borderP, ySide, &yLower, &yUpper );
+    for ( INT4 j = yLower; j <= yUpper; ++j ) {
+      hd[j * ( xSide + 1 ) + borderP->xPixel[j]] += weight;
+    }
+  }
+  for ( UINT4 b = 0; b < phmd->lengthRight; ++b ) {
+    const HOUGHBorder *borderP = phmd->rightBorderP[b];
+    INT4 yLower, yUpper;
+    HOUGHClipBorderRows ( borderP, ySide, &yLower, &yUpper );
+    for ( INT4 j = yLower; j <= yUpper; ++j ) {
+      hd[j * ( xSide + 1 ) + borderP->xPixel[j]] -= weight;
+    }
+  }
+}
+
+/**
+ * Construct a set of total Hough maps, one for each of \c numMaps
+ * time-frequency trajectories <tt>freqInd[0..numMaps-1]</tt> (typically one per
+ * spin-down value), from the same cylinder of partial Hough map derivatives.
+ * The result for each map is the same as calling LALHOUGHConstructHMT()
+ * (or LALHOUGHConstructHMT_W() if \c weighted is true) on each trajectory.
+ *
+ * The maps are built in parallel with OpenMP, if available, and the borders
+ * of each phmd are checked once rather than for every pixel of every map.
+ * Unweighted maps are accumulated as integer derivatives, and each map is
+ * obtained from the previous one by only replacing the phmds for which the
+ * trajectories differ, which is usually a small fraction of them for
+ * neighbouring spin-downs.
+ */
+int XLALHOUGHConstructHMTBatch ( HOUGHMapTotal *ht,				/**< [out] array of \c numMaps Hough maps */
+				 const UINT8FrequencyIndexVector *freqInd,	/**< [in] array of \c numMaps time-frequency trajectories */
+				 UINT4 numMaps,					/**< [in] number of maps */
+				 const PHMDVectorSequence *phmdVS,		/**< [in] cylinder of partial Hough map derivatives */
+				 BOOLEAN weighted				/**< [in] whether to use the weights of the phmds */
+				 )
+{
+  XLAL_CHECK ( ht != NULL && freqInd != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( phmdVS != NULL && phmdVS->phmd != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( numMaps > 0, XLAL_EINVAL );
+  XLAL_CHECK ( phmdVS->length > 0 && phmdVS->nfSize > 0, XLAL_EINVAL );
+  XLAL_CHECK ( phmdVS->breakLine < phmdVS->nfSize, XLAL_EINVAL );
+
+  const UINT4 length = phmdVS->length;
+  const UINT4 nfSize = phmdVS->nfSize;
+  const UINT2 xSide = ht[0].xSide;
+  const UINT2 ySide = ht[0].ySide;
+  XLAL_CHECK ( xSide > 0 && ySide > 0, XLAL_EINVAL );
+
+  for ( UINT4 m = 0; m < numMaps; ++m ) {
+    XLAL_CHECK ( ht[m].map != NULL && freqInd[m].data != NULL, XLAL_EFAULT );
+    XLAL_CHECK ( ht[m].xSide == xSide && ht[m].ySide == ySide, XLAL_EINVAL, "Size mismatch between Hough maps\n" );
+    XLAL_CHECK ( freqInd[m].length == length && freqInd[m].deltaF == phmdVS->deltaF, XLAL_EINVAL, "Size mismatch between trajectory %u and phmds\n", m );
+    for ( UINT4 k = 0; k < length; ++k ) {
+      XLAL_CHECK ( freqInd[m].data[k] >= phmdVS->fBinMin && freqInd[m].data[k] - phmdVS->fBinMin < nfSize, XLAL_EDOM,
+                   "Frequency bin %" LAL_UINT8_FORMAT " of trajectory %u outside phmd cylinder\n", freqInd[m].data[k], m );
+    }
+  }
+
+  /* rows of the cylinder used by each trajectory, and which phmds have been checked */
+  UINT4 *rows = XLALMalloc ( numMaps * length * sizeof ( rows[0] ) );
+  UCHAR *checked = XLALCalloc ( nfSize * length, sizeof ( checked[0] ) );
+  int errcode = ( rows == NULL || checked == NULL ) ? XLAL_ENOMEM : 0;
+  for ( UINT4 m = 0; errcode == 0 && m < numMaps; ++m ) {
+    for ( UINT4 k = 0; errcode == 0 && k < length; ++k ) {
+      const UINT4 j = ( freqInd[m].data[k] - phmdVS->fBinMin + phmdVS->breakLine ) % nfSize;
+      rows[m * length + k] = j;
+      if ( !checked[j * length + k] ) {
+        checked[j * length + k] = 1;
+        if ( HOUGHCheckPHMDBorders ( &( phmdVS->phmd[j * length + k] ), xSide, ySide ) != XLAL_SUCCESS ) {
+          errcode = XLAL_EFUNC;
+        }
+      }
+    }
+  }
+  XLALFree ( checked );
+  if ( errcode != 0 ) {
+    XLALFree ( rows );
+    XLAL_ERROR ( errcode );
+  }
+
+  const size_t hdSize = ( (size_t) xSide + 1 ) * ySide;
+
+#pragma omp parallel
+  {
+    INT4 *hdInt = NULL, *row = NULL;
+    HoughDT *hdW = NULL;
+    if ( weighted ) {
+      hdW = XLALMalloc ( hdSize * sizeof ( hdW[0] ) );
+    } else {
+      hdInt = XLALMalloc ( hdSize * sizeof ( hdInt[0] ) );
+      row = XLALMalloc ( ySide * sizeof ( row[0] ) );
+    }
+    if ( weighted ? ( hdW == NULL ) : ( hdInt == NULL || row == NULL ) )
+      {
+#pragma omp critical (XLALHOUGHConstructHMTBatch)
+        errcode = XLAL_ENOMEM;
+      }
+
+    /* index of the last map built by this thread, whose derivative is still in hdInt */
+    INT8 prev = -1;
+
+#pragma omp for schedule(static)
+    for ( UINT4 m = 0; m < numMaps; ++m )
+      {
+#pragma omp flush(errcode)
+        if ( errcode != 0 ) {
+          continue;
+        }
+        const UINT4 *rowsm = rows + m * length;
+
+        if ( weighted )
+          {
+            memset ( hdW, 0, hdSize * sizeof ( hdW[0] ) );
+            for ( UINT4 k = 0; k < length; ++k ) {
+              HOUGHAddPHMD2HD_W ( hdW, &( phmdVS->phmd[rowsm[k] * length + k] ), xSide, ySide );
+            }
+            /* integrate each row (x-direction), as LALHOUGHIntegrHD2HT() */
+            for ( UINT4 j = 0; j < ySide; ++j ) {
+              HoughTT accumulator = 0;
+              for ( UINT4 i = 0; i < xSide; ++i ) {
+                ht[m].map[j * xSide + i] = ( accumulator += hdW[j * ( xSide + 1 ) + i] );
+              }
+            }
+          }
+        else
+          {
+            /* count the phmds which differ from the previous map built by this thread */
+            UINT4 numChanged = length;
+            const UINT4 *rowsp = ( m > 0 ) ? rowsm - length : NULL;
+            if ( prev >= 0 && (UINT4) prev + 1 == m ) {
+              numChanged = 0;
+              for ( UINT4 k = 0; k < length; ++k ) {
+                numChanged += ( rowsm[k] != rowsp[k] );
+              }
+            }
+            if ( 2 * numChanged < length )
+              {
+                for ( UINT4 k = 0; k < length; ++k ) {
+                  if ( rowsm[k] != rowsp[k] ) {
+                    HOUGHAddPHMD2IntHD ( hdInt, &( phmdVS->phmd[rowsp[k] * length + k] ), ySide, -1 );
+                    HOUGHAddPHMD2IntHD ( hdInt, &( phmdVS->phmd[rowsm[k] * length + k] ), ySide, +1 );
+                  }
+                }
+              }
+            else
+              {
+                memset ( hdInt, 0, hdSize * sizeof ( hdInt[0] ) );
+                for ( UINT4 k = 0; k < length; ++k ) {
+                  HOUGHAddPHMD2IntHD ( hdInt, &( phmdVS->phmd[rowsm[k] * length + k] ), ySide, +1 );
+                }
+              }
+            HOUGHIntegrIntHD2HT ( ht[m].map, hdInt, row, xSide, ySide );
+          }
+        prev = m;
+
+      } /* for m < numMaps */
+
+    XLALFree ( hdInt );
+    XLALFree ( row );
+    XLALFree ( hdW );
+  } /* omp parallel */
+
+  XLALFree ( rows );
+  XLAL_CHECK ( errcode == 0, errcode );
+
+  return XLAL_SUCCESS;
+
+} /* XLALHOUGHConstructHMTBatch() */
+
+
+
 /**
  * Adds weight factors for set of partial hough map derivatives -- the
  * weights must be calculated outside this function.
@@ -35,6 +35,12 @@
 #include <lal/Window.h>
 #include <lal/Random.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 #include <lal/GeneratePulsarSignal.h>
 
 /*----------------------------------------------------------------------*/
@@ -1048,6 +1054,62 @@ XLALAddGaussianNoise ( REAL4TimeSeries *inSeries, REAL4 sigma, INT4 seed )
 } /* XLALAddGaussianNoise() */
 
 
+/**
+ * Generate Gaussian noise with standard-deviation sigma, add it to inSeries,
+ * using the counter-based generator XLALPhiloxNormalDeviatesREAL4().
+ *
+ * The noise sample at GPS time \f$t\f$ is sample \f$\mathrm{round}(t/\Delta t)\f$ of
+ * random stream \c stream (e.g. a detector index) for the given \c seed.  The noise
+ * added at a given time is therefore independent of how the data is divided into
+ * time series, and the series is generated in parallel blocks when OpenMP is
+ * available, with results independent of the number of threads.
+ */
+int
+XLALAddGaussianNoiseCounterBased ( REAL4TimeSeries *inSeries, REAL4 sigma, UINT8 seed, UINT8 stream )
+{
+  XLAL_CHECK ( inSeries != NULL && inSeries->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( inSeries->deltaT > 0, XLAL_EDOM );
+
+  const REAL8 firstSample = round ( XLALGPSGetREAL8 ( &inSeries->epoch ) / inSeries->deltaT );
+  XLAL_CHECK ( firstSample >= 0, XLAL_EDOM, "Counter-based noise requires a non-negative GPS epoch\n" );
+  const UINT8 offset = (UINT8) firstSample;
+
+  const UINT4 numPoints = inSeries->data->length;
+  const UINT4 blockLength = 65536;
+  const UINT4 numBlocks = ( numPoints + blockLength - 1 ) / blockLength;
+
+  REAL4Vector *v1;
+  XLAL_CHECK ( (v1 = XLALCreateREAL4Vector ( numPoints )) != NULL, XLAL_EFUNC );
+
+  int errcode = 0;
+#pragma omp parallel for schedule(static)
+  for ( UINT4 b = 0; b < numBlocks; b++ )
+    {
+      REAL4Vector block;
+      block.data = v1->data + (size_t) b * blockLength;
+      block.length = ( numPoints - b * blockLength < blockLength ) ? numPoints - b * blockLength : blockLength;
+      if ( XLALPhiloxNormalDeviatesREAL4 ( &block, seed, stream, offset + (UINT8) b * blockLength ) != XLAL_SUCCESS )
+        {
+#pragma omp critical (XLALAddGaussianNoiseCounterBased)
+          errcode = XLAL_EFUNC;
+        }
+    }
+  if ( errcode ) {
+    XLALDestroyREAL4Vector ( v1 );
+    XLAL_ERROR ( errcode );
+  }
+
+  for (UINT4 i = 0; i < numPoints; i++ ) {
+    inSeries->data->data[i] += sigma * v1->data[i];
+  }
+
+  XLALDestroyREAL4Vector ( v1 );
+
+  return XLAL_SUCCESS;
+
+} /* XLALAddGaussianNoiseCounterBased() */
+
+
 
 /**
  * Destroy a MultiREAL4TimeSeries, NULL-robust
@@ -352,6 +352,7 @@ SFTVector *XLALSignalToSFTs ( const REAL4TimeSeries *signalvec, const SFTParams
 int XLALConvertGPS2SSB ( LIGOTimeGPS *SSBout, LIGOTimeGPS GPSin, const PulsarSignalParams *params );
 int XLALConvertSSB2GPS ( LIGOTimeGPS *GPSout, LIGOTimeGPS GPSin, const PulsarSignalParams *params );
 int XLALAddGaussianNoise ( REAL4TimeSeries *inSeries, REAL4 sigma, INT4 seed );
+int XLALAddGaussianNoiseCounterBased ( REAL4TimeSeries *inSeries, REAL4 sigma, UINT8 seed, UINT8 stream );
 
 void XLALDestroyMultiREAL4TimeSeries ( MultiREAL4TimeSeries *multiTS );
 void XLALDestroyMultiREAL8TimeSeries ( MultiREAL8TimeSeries *multiTS );
@@ -1542,9 +1542,9 @@ void observatoryEarth( REAL8 obsEarth[3],     /**< [out] The x, y, z coordinates
                        REAL8 dpsi,            /**< [in] dpsi for Earth nutation */
                        REAL8 deps             /**< [in] deps for Earth nutation */
                       ){
-  static REAL8 erad; /* observatory distance from Earth centre */
-  static REAL8 hlt;  /* observatory latitude */
-  static REAL8 alng; /* observatory longitude */
+  REAL8 erad; /* observatory distance from Earth centre */
+  REAL8 hlt;  /* observatory latitude */
+  REAL8 alng; /* observatory longitude */
   REAL8 tmjd = 44244. + ( XLALGPSGetREAL8( tgps ) + 51.184 )/86400.;
 
   INT4 j = 0;
@@ -1558,7 +1558,7 @@ void observatoryEarth( REAL8 obsEarth[3],     /**< [out] The x, y, z coordinates
 
   alng = atan2(-det.location[1], det.location[0]);
 
-  static REAL8 siteCoord[3];
+  REAL8 siteCoord[3];
   REAL8 eeq[3], prn[3][3];
 
   siteCoord[0] = erad * cos(hlt);
@@ -246,6 +246,13 @@ void LALHOUGHConstructHMT_W  (LALStatus                  *status,
 			      PHMDVectorSequence         *phmdVS
 			      );
 
+int XLALHOUGHConstructHMTBatch ( HOUGHMapTotal *ht,
+				 const UINT8FrequencyIndexVector *freqInd,
+				 UINT4 numMaps,
+				 const PHMDVectorSequence *phmdVS,
+				 BOOLEAN weighted
+				 );
+
 void LALHOUGHWeighSpacePHMD  (LALStatus            *status,
 			      PHMDVectorSequence   *phmdVS,
 			      REAL8Vector *weightV
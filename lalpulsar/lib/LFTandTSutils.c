@@ -865,6 +865,51 @@ XLALCheckVectorComparisonTolerances ( const VectorComparison *result,	///< [in]
 
 } // XLALCheckVectorComparisonTolerances()
 
+// windowed-sinc interpolation of the regularly-spaced samples 'x' at time 't' since the first sample,
+// using the window 'win' of length 2*Dterms+1: see XLALSincInterpolateCOMPLEX8TimeSeries() for details
+static inline COMPLEX8
+sinc_interpolate_COMPLEX8_sample ( REAL8 t, const COMPLEX8 *x, UINT4 numSamplesIn, REAL8 dt, REAL8 oodt, const REAL8 *win, UINT4 Dterms )
+{
+  // samples outside of input timeseries are returned as 0
+  if ( (t < 0) || (t > (numSamplesIn-1)*dt) )	// avoid any extrapolations!
+    {
+      return 0;
+    }
+
+  REAL8 t_by_dt = t  * oodt;
+  INT8 jstar = lround ( t_by_dt );		// bin closest to 't', guaranteed to be in [0, numSamples-1]
+
+  if ( fabs ( t_by_dt - jstar ) < LD_SMALL4 )	// avoid numerical problems near peak
+    {
+      return x[jstar];	// known analytic solution for exact bin
+    }
+
+  INT4 jStart0 = jstar - Dterms;
+  UINT4 jEnd0 = jstar + Dterms;
+  UINT4 jStart = MYMAX ( jStart0, 0 );
+  UINT4 jEnd   = MYMIN ( jEnd0, numSamplesIn - 1 );
+
+  REAL4 delta_jStart = (t_by_dt - jStart);
+  REAL4 sin0, cos0;
+  XLALSinCosLUT ( &sin0, &cos0, LAL_PI * delta_jStart );
+  REAL4 sin0oopi = sin0 * OOPI;
+
+  COMPLEX8 y_l = 0;
+  REAL8 delta_j = delta_jStart;
+  for ( UINT8 j = jStart; j <= jEnd; j ++ )
+    {
+      COMPLEX8 Cj = win[j - jStart0] * sin0oopi / delta_j;
+
+      y_l += Cj * x[j];
+
+      sin0oopi = -sin0oopi;		// sin-term flips sign every step
+      delta_j --;
+    } // for j in [j* - Dterms, ... ,j* + Dterms]
+
+  return y_l;
+
+} // sinc_interpolate_COMPLEX8_sample()
+
 /** Interpolate a given regularly-spaced COMPLEX8 timeseries 'ts_in = x_in(j * dt)' onto new samples
  *  'y_out(t_out)' using *windowed* Shannon sinc interpolation, windowed to (2*Dterms+1) terms, namely
  * \f[
@@ -919,55 +964,70 @@ XLALSincInterpolateCOMPLEX8TimeSeries ( COMPLEX8Vector *y_out,		///< [out] outpu
 
   for ( UINT4 l = 0; l < numSamplesOut; l ++ )
     {
-      REAL8 t = t_out->data[l] - tmin;		// measure time since start of input timeseries
-
-      // samples outside of input timeseries are returned as 0
-      if ( (t < 0) || (t > (numSamplesIn-1)*dt) )	// avoid any extrapolations!
-        {
-          y_out->data[l] = 0;
-          continue;
-        }
+      y_out->data[l] = sinc_interpolate_COMPLEX8_sample ( t_out->data[l] - tmin, ts_in->data->data, numSamplesIn, dt, oodt, win->data->data, Dterms );
+    } // for l < numSamplesOut
 
-      REAL8 t_by_dt = t  * oodt;
-      INT8 jstar = lround ( t_by_dt );		// bin closest to 't', guaranteed to be in [0, numSamples-1]
+  XLALDestroyREAL8Window ( win );
 
-      if ( fabs ( t_by_dt - jstar ) < LD_SMALL4 )	// avoid numerical problems near peak
-        {
-          y_out->data[l] = ts_in->data->data[jstar];	// known analytic solution for exact bin
-          continue;
-        }
+  return XLAL_SUCCESS;
 
-      INT4 jStart0 = jstar - Dterms;
-      UINT4 jEnd0 = jstar + Dterms;
-      UINT4 jStart = MYMAX ( jStart0, 0 );
-      UINT4 jEnd   = MYMIN ( jEnd0, numSamplesIn - 1 );
+} // XLALSincInterpolateCOMPLEX8TimeSeries()
 
-      REAL4 delta_jStart = (t_by_dt - jStart);
-      REAL4 sin0, cos0;
-      XLALSinCosLUT ( &sin0, &cos0, LAL_PI * delta_jStart );
-      REAL4 sin0oopi = sin0 * OOPI;
+/**
+ * Interpolate a regularly-spaced COMPLEX8 timeseries onto several sets of output times at once,
+ * see XLALSincInterpolateCOMPLEX8TimeSeries() for details of the windowed-sinc interpolation.
+ *
+ * The results are identical to calling XLALSincInterpolateCOMPLEX8TimeSeries() for each pair ('y_out[i]', 't_out[i]'),
+ * but the window is only computed once, and the output samples are computed interleaved, i.e. sample 'l' of all sets
+ * in turn: when the output times of the different sets are close to each other (e.g. for neighbouring binary-orbit
+ * templates), the input samples in the kernel are only loaded from memory once for the whole batch.
+ */
+int
+XLALSincInterpolateCOMPLEX8TimeSeriesBatch ( COMPLEX8Vector **y_out,		///< [out] 'numSets' output series of interpolated y-values [y_out[i] must be same size as t_out[i]]
+                                             REAL8Vector **t_out,		///< [in] 'numSets' series of output time-steps to interpolate input to
+                                             UINT4 numSets,			///< [in] number of sets of output time-steps
+                                             const COMPLEX8TimeSeries *ts_in,	///< [in] regularly-spaced input timeseries
+                                             UINT4 Dterms			///< [in] window sinc kernel sum to +-Dterms around max
+                                             )
+{
+  XLAL_CHECK ( y_out != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( t_out != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( ts_in != NULL, XLAL_EINVAL );
 
-      COMPLEX8 y_l = 0;
-      REAL8 delta_j = delta_jStart;
-      for ( UINT8 j = jStart; j <= jEnd; j ++ )
-        {
-          COMPLEX8 Cj = win->data->data[j - jStart0] * sin0oopi / delta_j;
+  UINT4 numSamplesOut = 0;
+  for ( UINT4 i = 0; i < numSets; i ++ )
+    {
+      XLAL_CHECK ( y_out[i] != NULL, XLAL_EINVAL );
+      XLAL_CHECK ( t_out[i] != NULL, XLAL_EINVAL );
+      XLAL_CHECK ( y_out[i]->length == t_out[i]->length, XLAL_EINVAL );
+      numSamplesOut = MYMAX ( numSamplesOut, t_out[i]->length );
+    }
 
-          y_l += Cj * ts_in->data->data[j];
+  UINT4 numSamplesIn = ts_in->data->length;
+  REAL8 dt = ts_in->deltaT;
+  REAL8 tmin = XLALGPSGetREAL8 ( &(ts_in->epoch) );	// time of first bin in input timeseries
 
-          sin0oopi = -sin0oopi;		// sin-term flips sign every step
-          delta_j --;
-        } // for j in [j* - Dterms, ... ,j* + Dterms]
+  REAL8Window *win;
+  UINT4 winLen = 2 * Dterms + 1;
+  XLAL_CHECK ( (win = XLALCreateHammingREAL8Window ( winLen )) != NULL, XLAL_EFUNC );
 
-      y_out->data[l] = y_l;
+  const REAL8 oodt = 1.0 / dt;
 
+  for ( UINT4 l = 0; l < numSamplesOut; l ++ )
+    {
+      for ( UINT4 i = 0; i < numSets; i ++ )
+        {
+          if ( l < t_out[i]->length ) {
+            y_out[i]->data[l] = sinc_interpolate_COMPLEX8_sample ( t_out[i]->data[l] - tmin, ts_in->data->data, numSamplesIn, dt, oodt, win->data->data, Dterms );
+          }
+        } // for i < numSets
     } // for l < numSamplesOut
 
   XLALDestroyREAL8Window ( win );
 
   return XLAL_SUCCESS;
 
-} // XLALSincInterpolateCOMPLEX8TimeSeries()
+} // XLALSincInterpolateCOMPLEX8TimeSeriesBatch()
 
 /** Interpolate a given regularly-spaced COMPLEX8 frequency-series 'fs_in = x_in( k * df)' onto new samples
  *  'y_out(f_out)' using (complex) Sinc interpolation (obtained from Dirichlet kernel in large-N limit), truncated to (2*Dterms+1) terms, namely
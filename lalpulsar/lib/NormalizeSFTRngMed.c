@@ -20,6 +20,25 @@
 
 #include <lal/NormalizeSFTRngMed.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
+/* Per-thread buffers handed down from the parallel SFT loops, so that no
+ * allocation happens per SFT */
+typedef struct tagNormalizeSFTWorkspace {
+  LALRunningMedianWorkspace *rngmedWS;	/* running-median workspace for the block size, or NULL */
+  REAL8Vector *periodo;			/* periodogram buffer, at least as long as any SFT */
+} NormalizeSFTWorkspace;
+
+static NormalizeSFTWorkspace *CreateNormalizeSFTWorkspace ( UINT4 blockSize, UINT4 maxLength );
+static void DestroyNormalizeSFTWorkspace ( NormalizeSFTWorkspace *ws );
+static int NormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS, NormalizeSFTWorkspace *ws );
+static int SFTtoRngmed ( REAL8FrequencySeries *rngmed, const SFTtype *sft, UINT4 blockSize, NormalizeSFTWorkspace *ws );
+static int PeriodoToRngmed ( REAL8FrequencySeries *rngmed, const REAL8FrequencySeries *periodo, UINT4 blockSize, LALRunningMedianWorkspace *rngmedWS );
+
 /**
  * \addtogroup NormalizeSFTRngMed_h
  * \author Badri Krishnan and Alicia Sintes
@@ -59,6 +78,10 @@
  * of SFT vectors and also returns a collection of power-estimates for these vectors using
  * the Running median method.
  *
+ * The running medians are computed with XLALDRunningMedian(), and the SFTs of
+ * an SFT vector (or multi-SFT vector) are normalized in parallel if lalpulsar
+ * is built with OpenMP support.
+ *
  */
 
 /**
@@ -70,6 +93,14 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
                    UINT4                blockSize,	/**< Running median block size for rngmed calculation */
                    const REAL8          assumeSqrtS	/**< If >0, instead assume sqrt(S) value *instead* of calculating PSD from running median */
                    )
+{
+  XLAL_CHECK ( NormalizeSFT ( rngmed, sft, blockSize, assumeSqrtS, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+} /* XLALNormalizeSFT() */
+
+/* XLALNormalizeSFT() with optional per-thread buffers */
+static int
+NormalizeSFT ( REAL8FrequencySeries *rngmed, SFTtype *sft, UINT4 blockSize, const REAL8 assumeSqrtS, NormalizeSFTWorkspace *ws )
 {
   /* check input argments */
   XLAL_CHECK (sft && sft->data && sft->data->data && sft->data->length > 0, XLAL_EINVAL, "Invalid NULL or zero-length input in 'sft'" );
@@ -83,7 +114,7 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
 
   if ( assumeSqrtS == 0)
     { /* calculate the rngmed */
-      XLAL_CHECK ( XLALSFTtoRngmed (rngmed, sft, blockSize) == XLAL_SUCCESS, XLAL_EFUNC, "XLALSFTtoRngmed() failed" );
+      XLAL_CHECK ( SFTtoRngmed (rngmed, sft, blockSize, ws) == XLAL_SUCCESS, XLAL_EFUNC, "XLALSFTtoRngmed() failed" );
     }
   else
     {
@@ -113,7 +144,7 @@ XLALNormalizeSFT ( REAL8FrequencySeries *rngmed, 	/**< [out] rng-median smoothed
 
   return XLAL_SUCCESS;
 
-} /* XLALNormalizeSFT() */
+} /* NormalizeSFT() */
 
 
 /**
@@ -131,24 +162,59 @@ XLALNormalizeSFTVect ( SFTVector  *sftVect,		/**< [in/out] pointer to a vector o
   /* memory allocation of rngmed using length of first sft -- assume all sfts have the same length*/
   UINT4 lengthsft = sftVect->data->data->length;
 
-  /* allocate memory for a single rngmed */
-  REAL8FrequencySeries *rngmed;
-  XLAL_CHECK ( ( rngmed = XLALCalloc(1, sizeof(*rngmed))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,%zu)", sizeof(*rngmed) );
-  XLAL_CHECK ( ( rngmed->data = XLALCreateREAL8Vector ( lengthsft ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector ( %d ) failed.", lengthsft );
+  int errcode = XLAL_SUCCESS;
 
-  /* loop over sfts and normalize them */
+  /* the periodogram buffer must hold the longest SFT */
+  UINT4 maxlength = 0;
   for (UINT4 j = 0; j < sftVect->length; j++)
     {
-      SFTtype *sft = &sftVect->data[j];
+      XLAL_CHECK ( sftVect->data[j].data != NULL, XLAL_EINVAL, "Invalid NULL data in SFT %u", j );
+      if ( sftVect->data[j].data->length > maxlength )
+        maxlength = sftVect->data[j].data->length;
+    }
 
-      /* call sft normalization function */
-      XLAL_CHECK ( XLALNormalizeSFT ( rngmed, sft, blockSize, assumeSqrtS ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALNormalizeSFT() failed." );
+#pragma omp parallel
+  {
+    /* allocate memory for a single rngmed and normalization buffers per thread */
+    REAL8FrequencySeries *rngmed = XLALCalloc(1, sizeof(*rngmed));
+    NormalizeSFTWorkspace *ws = CreateNormalizeSFTWorkspace ( assumeSqrtS == 0 ? blockSize : 0, maxlength );
+    if ( rngmed == NULL || ( rngmed->data = XLALCreateREAL8Vector ( lengthsft ) ) == NULL || ws == NULL )
+      {
+#pragma omp critical (XLALNormalizeSFTVect)
+        errcode = XLAL_ENOMEM;
+      }
 
-    } /* for j < sftVect->length */
+    /* loop over sfts and normalize them */
+#pragma omp for schedule(dynamic)
+    for (UINT4 j = 0; j < sftVect->length; j++)
+      {
+        int per_thread_errcode;
+#pragma omp flush(errcode)
+        if ( errcode != XLAL_SUCCESS || rngmed == NULL || rngmed->data == NULL || ws == NULL )
+          continue;
+
+        SFTtype *sft = &sftVect->data[j];
+
+        /* call sft normalization function */
+        per_thread_errcode = NormalizeSFT ( rngmed, sft, blockSize, assumeSqrtS, ws );
+        if ( per_thread_errcode != XLAL_SUCCESS )
+          {
+#pragma omp critical (XLALNormalizeSFTVect)
+            errcode = XLAL_EFUNC;
+          }
+
+      } /* for j < sftVect->length */
+
+    /* free memory for psd */
+    if ( rngmed != NULL )
+      {
+        XLALDestroyREAL8Vector ( rngmed->data );
+        XLALFree(rngmed);
+      }
+    DestroyNormalizeSFTWorkspace ( ws );
+  } /* omp parallel */
 
-  /* free memory for psd */
-  XLALDestroyREAL8Vector ( rngmed->data );
-  XLALFree(rngmed);
+  XLAL_CHECK ( errcode == XLAL_SUCCESS, errcode, "XLALNormalizeSFT() failed." );
 
   return XLAL_SUCCESS;
 
@@ -178,6 +244,7 @@ XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector
   XLAL_CHECK_NULL ( ( multiPSD->data = XLALCalloc ( numifo, sizeof(*multiPSD->data))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", numifo, sizeof(*multiPSD->data) );
 
   /* loop over ifos */
+  UINT4 numsftTot = 0, maxlength = 0;
   for ( UINT4 X = 0; X < numifo; X++ )
     {
       UINT4 numsft = multsft->data[X]->length;
@@ -188,23 +255,65 @@ XLALNormalizeMultiSFTVect ( MultiSFTVector *multsft,		/**< [in/out] multi-vector
       multiPSD->data[X]->length = numsft;
       XLAL_CHECK_NULL ( (multiPSD->data[X]->data = XLALCalloc ( numsft, sizeof(*(multiPSD->data[X]->data)))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc ( %d, %zu)", numsft, sizeof(*(multiPSD->data[X]->data)) );
 
-      /* loop over sfts for this IFO X */
+      /* memory allocation of psd vectors for the sfts of this IFO X */
       for ( UINT4 j = 0; j < numsft; j++ )
         {
-          SFTtype *sft = &multsft->data[X]->data[j];
-
-          /* memory allocation of psd vector for this SFT */
-          UINT4 lengthsft = sft->data->length;
+          UINT4 lengthsft = multsft->data[X]->data[j].data->length;
           XLAL_CHECK_NULL ( (multiPSD->data[X]->data[j].data = XLALCreateREAL8Vector ( lengthsft ) ) != NULL, XLAL_EFUNC, "XLALCreateREAL8Vector(%d) failed.", lengthsft );
+          if ( lengthsft > maxlength )
+            maxlength = lengthsft;
+        } /* for j < numsft */
 
-          /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
-          const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
+      numsftTot += numsft;
 
-          XLAL_CHECK_NULL( XLALNormalizeSFT ( &multiPSD->data[X]->data[j], sft, blockSize, assumeSqrtS ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALNormalizeSFT() failed");
+    } /* for X < numifo */
 
-        } /* for j < numsft */
+  /* loop over all sfts of all IFOs together, for parallelisation */
+  int errcode = XLAL_SUCCESS;
+#pragma omp parallel
+  {
+    /* allocate normalization buffers per thread */
+    NormalizeSFTWorkspace *ws = CreateNormalizeSFTWorkspace ( blockSize, maxlength );
+    if ( ws == NULL )
+      {
+#pragma omp critical (XLALNormalizeMultiSFTVect)
+        errcode = XLAL_ENOMEM;
+      }
 
-    } /* for X < numifo */
+#pragma omp for schedule(dynamic)
+  for ( UINT4 indx = 0; indx < numsftTot; indx++ )
+    {
+      int per_thread_errcode;
+#pragma omp flush(errcode)
+      if ( errcode != XLAL_SUCCESS || ws == NULL )
+        continue;
+
+      /* break single index into 'X' and 'j' */
+      UINT4 X = 0, j = indx;
+      while ( j >= multsft->data[X]->length )
+        {
+          j -= multsft->data[X]->length;
+          X++;
+        }
+
+      SFTtype *sft = &multsft->data[X]->data[j];
+
+      /* if assumeSqrtSX is not given, pass 0.0 to calculate PSD from running median */
+      const REAL8 assumeSqrtS = (assumeSqrtSX != NULL) ? assumeSqrtSX->sqrtSn[X] : 0.0;
+
+      per_thread_errcode = NormalizeSFT ( &multiPSD->data[X]->data[j], sft, blockSize, assumeSqrtS, ws );
+      if ( per_thread_errcode != XLAL_SUCCESS )
+        {
+#pragma omp critical (XLALNormalizeMultiSFTVect)
+          errcode = XLAL_EFUNC;
+        }
+
+    } /* for indx < numsftTot */
+
+    DestroyNormalizeSFTWorkspace ( ws );
+  } /* omp parallel */
+
+  XLAL_CHECK_NULL ( errcode == XLAL_SUCCESS, errcode, "XLALNormalizeSFT() failed");
 
   return multiPSD;
 
@@ -219,6 +328,14 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
                   const SFTtype *sft,		/**< [in]  input SFT */
                   UINT4 blockSize		/**< Running median block size */
                   )
+{
+  XLAL_CHECK ( SFTtoRngmed ( rngmed, sft, blockSize, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+} /* XLALSFTtoRngmed() */
+
+/* XLALSFTtoRngmed() with optional per-thread buffers */
+static int
+SFTtoRngmed ( REAL8FrequencySeries *rngmed, const SFTtype *sft, UINT4 blockSize, NormalizeSFTWorkspace *ws )
 {
   /* check argments */
   XLAL_CHECK ( sft != NULL, XLAL_EINVAL, "Invalid NULL pointer passed in 'sft'" );
@@ -233,16 +350,34 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
 
   UINT4 length = sft->data->length;
 
+  /* use the periodogram buffer of the workspace if given */
   REAL8FrequencySeries periodo;
-  XLAL_CHECK ( (periodo.data = XLALCreateREAL8Vector ( length )) != NULL, XLAL_EFUNC, "Failed to allocate periodo.data of length %d", length);
+  REAL8Vector periodoData;
+  if ( ws != NULL )
+    {
+      XLAL_CHECK ( ws->periodo->length >= length, XLAL_EINVAL, "Periodogram buffer of length %d is shorter than the SFT (%d)", ws->periodo->length, length );
+      periodoData.length = length;
+      periodoData.data = ws->periodo->data;
+      periodo.data = &periodoData;
+    }
+  else
+    {
+      XLAL_CHECK ( (periodo.data = XLALCreateREAL8Vector ( length )) != NULL, XLAL_EFUNC, "Failed to allocate periodo.data of length %d", length);
+    }
 
   /* calculate the periodogram */
-  XLAL_CHECK ( XLALSFTtoPeriodogram ( &periodo, sft ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALSFTtoPeriodogram() failed.\n");
+  int retn = XLALSFTtoPeriodogram ( &periodo, sft );
 
   /* calculate the rngmed */
-  if ( blockSize > 0 )
+  if ( retn != XLAL_SUCCESS )
+    {
+      XLALPrintError ( "%s: Call to XLALSFTtoPeriodogram() failed.\n", __func__ );
+    }
+  else if ( blockSize > 0 )
     {
-      XLAL_CHECK ( XLALPeriodoToRngmed ( rngmed, &periodo, blockSize ) == XLAL_SUCCESS, XLAL_EFUNC, "Call to XLALPeriodoToRngmed() failed." );
+      retn = PeriodoToRngmed ( rngmed, &periodo, blockSize, ws ? ws->rngmedWS : NULL );
+      if ( retn != XLAL_SUCCESS )
+        XLALPrintError ( "%s: Call to XLALPeriodoToRngmed() failed.\n", __func__ );
     }
   else	// blockSize==0 means don't use any running-median, just *copy* the periodogram contents into the output
     {
@@ -255,12 +390,14 @@ XLALSFTtoRngmed ( REAL8FrequencySeries *rngmed,	/**< [out] running-median smooth
     }
 
   /* free memory */
-  XLALFree ( periodo.data->data );
-  XLALFree ( periodo.data );
+  if ( ws == NULL )
+    XLALDestroyREAL8Vector ( periodo.data );
+
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
 
   return XLAL_SUCCESS;
 
-} /* XLALSFTtoRngmed() */
+} /* SFTtoRngmed() */
 
 /**
  * Calculate the "periodogram" of an SFT, ie the modulus-squares of the SFT-data.
@@ -314,6 +451,14 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
                       const REAL8FrequencySeries  *periodo,	/**< [in] input periodogram */
                       UINT4 blockSize				/**< Running median block size */
                       )
+{
+  XLAL_CHECK ( PeriodoToRngmed ( rngmed, periodo, blockSize, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+} /* XLALPeriodoToRngmed() */
+
+/* XLALPeriodoToRngmed() with an optional running-median workspace for blockSize */
+static int
+PeriodoToRngmed ( REAL8FrequencySeries *rngmed, const REAL8FrequencySeries *periodo, UINT4 blockSize, LALRunningMedianWorkspace *rngmedWS )
 {
   /* check input argments are not NULL */
   XLAL_CHECK ( periodo != NULL && periodo->data != NULL && periodo->data->data && periodo->data->length > 0,
@@ -334,8 +479,6 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
 
   UINT4 blocks2 = blockSize/2; /* integer division, round down */
 
-  LALRunningMedianPar rngMedPar;
-  rngMedPar.blocksize = blockSize;
   REAL8Sequence mediansV, inputV;
   inputV.length = length;
   inputV.data = periodo->data->data;
@@ -343,9 +486,15 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
   mediansV.length = medianVLength;
   mediansV.data = rngmed->data->data + blocks2;
 
-  LALStatus XLAL_INIT_DECL(status);
-  LALDRunningMedian2 ( &status, &mediansV, &inputV, rngMedPar);
-  XLAL_CHECK ( status.statusCode == 0, XLAL_EFAILED, "LALDRunningMedian2() failed with statusCode = %d", status.statusCode );
+  if ( rngmedWS != NULL )
+    {
+      XLAL_CHECK ( XLALRunningMedianWorkspaceBlocksize ( rngmedWS ) == blockSize, XLAL_EINVAL, "Running-median workspace is for block size %d, not %d", XLALRunningMedianWorkspaceBlocksize ( rngmedWS ), blockSize );
+      XLAL_CHECK ( XLALDRunningMedianWithWorkspace ( rngmedWS, &mediansV, &inputV ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALDRunningMedianWithWorkspace() failed" );
+    }
+  else
+    {
+      XLAL_CHECK ( XLALDRunningMedian ( &mediansV, &inputV, blockSize ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALDRunningMedian() failed" );
+    }
 
   /* copy values in the wings */
   for ( UINT4 j=0; j<blocks2; j++)
@@ -365,7 +514,34 @@ XLALPeriodoToRngmed ( REAL8FrequencySeries  *rngmed,		/**< [out] resulting 'smoo
 
   return XLAL_SUCCESS;
 
-} /* XLALPeriodoToRngmed() */
+} /* PeriodoToRngmed() */
+
+
+/* Create per-thread buffers for normalizing SFTs of up to maxLength bins;
+ * no running-median workspace is needed if blockSize is zero */
+static NormalizeSFTWorkspace *
+CreateNormalizeSFTWorkspace ( UINT4 blockSize, UINT4 maxLength )
+{
+  NormalizeSFTWorkspace *ws = XLALCalloc ( 1, sizeof(*ws) );
+  XLAL_CHECK_NULL ( ws != NULL, XLAL_ENOMEM );
+  if ( ( blockSize > 0 && ( ws->rngmedWS = XLALCreateRunningMedianWorkspace ( blockSize ) ) == NULL )
+       || ( ws->periodo = XLALCreateREAL8Vector ( maxLength > 0 ? maxLength : 1 ) ) == NULL )
+    {
+      DestroyNormalizeSFTWorkspace ( ws );
+      XLAL_ERROR_NULL ( XLAL_EFUNC );
+    }
+  return ws;
+} /* CreateNormalizeSFTWorkspace() */
+
+static void
+DestroyNormalizeSFTWorkspace ( NormalizeSFTWorkspace *ws )
+{
+  if ( ws == NULL )
+    return;
+  XLALDestroyRunningMedianWorkspace ( ws->rngmedWS );
+  XLALDestroyREAL8Vector ( ws->periodo );
+  XLALFree ( ws );
+} /* DestroyNormalizeSFTWorkspace() */
 
 
 /**
@@ -51,6 +51,7 @@
 
 #include <lal/LALStdio.h>
 #include <lal/LALString.h>
+#include <lal/LALTrace.h>
 #include <lal/FileIO.h>
 #include <lal/SFTfileIO.h>
 #include <lal/StringVector.h>
@@ -747,6 +748,8 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
   if(!catalog)
     XLALLOADSFTSERROR(XLAL_EINVAL);
 
+  XLAL_TRACE_START(timer, "XLALLoadSFTs");
+
   /* determine number of SFTs, i.e. number of different GPS timestamps.
      The catalog should be sorted by GPS time, so just count changes.
      Record the 'index' of GPS time in the 'isft' field of the locator,
@@ -1009,6 +1012,8 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
   XLALFree(locatalog.data);
   XLALDestroySFT(thisSFT);
 
+  XLAL_TRACE_STOP(timer, ((UINT8) sftVector->length) * (lastbin + 1 - firstbin) * sizeof(COMPLEX8));
+
   return(sftVector);
 
 } /* XLALLoadSFTs() */
@@ -281,6 +281,89 @@ main ( int argc, char *argv[] )
 
     } // for iSky < numSkyPoints
 
+  // ----- test XLALComputeFstatBatch(): results must be identical to XLALComputeFstat() for each template,
+  // for a batch of binary-orbit templates at the same sky-position (case 0), and at different sky-positions (case 1)
+  {
+#define NUM_BATCH 5
+    const UINT4 numFreqBinsBatch = 100;
+    const FstatQuantities whatToComputeBatch = (FSTATQ_2F | FSTATQ_FAFB | FSTATQ_2F_PER_DET);
+    for ( UINT4 iCase = 0; iCase < 2; iCase ++ )
+      {
+        PulsarDopplerParams dopplers[NUM_BATCH];
+        for ( UINT4 i = 0; i < NUM_BATCH; i ++ )
+          {
+            dopplers[i] = Doppler;
+            dopplers[i].asini = 0.005 + 0.001 * i;
+            dopplers[i].period = 19 * 3600 + 0.1 * dPeriod * i;
+            dopplers[i].ecc = 0.01 * i;
+          }
+        if ( iCase == 1 ) {
+          dopplers[NUM_BATCH-1].Alpha += dSky;
+        }
+
+        for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+          {
+            if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+              continue;
+            }
+            FstatResults *results_batch[NUM_BATCH] = { NULL };
+            FstatResults *results_single = NULL;
+            XLAL_CHECK ( XLALComputeFstatBatch ( results_batch, input_seg2[iMethod], dopplers, NUM_BATCH, numFreqBinsBatch, whatToComputeBatch ) == XLAL_SUCCESS, XLAL_EFUNC );
+            for ( UINT4 i = 0; i < NUM_BATCH; i ++ )
+              {
+                XLAL_CHECK ( XLALComputeFstat ( &results_single, input_seg2[iMethod], &dopplers[i], numFreqBinsBatch, whatToComputeBatch ) == XLAL_SUCCESS, XLAL_EFUNC );
+                XLALPrintInfo ("Comparing batch and single results for method '%s', case %u, template %u\n", XLALGetFstatInputMethodName(input_seg2[iMethod]), iCase, i );
+                XLAL_CHECK ( memcmp ( results_batch[i]->twoF, results_single->twoF, numFreqBinsBatch * sizeof(results_single->twoF[0]) ) == 0, XLAL_EFAILED );
+                XLAL_CHECK ( memcmp ( results_batch[i]->Fa, results_single->Fa, numFreqBinsBatch * sizeof(results_single->Fa[0]) ) == 0, XLAL_EFAILED );
+                XLAL_CHECK ( memcmp ( results_batch[i]->Fb, results_single->Fb, numFreqBinsBatch * sizeof(results_single->Fb[0]) ) == 0, XLAL_EFAILED );
+                for ( UINT4 X = 0; X < numDetectors; X ++ ) {
+                  XLAL_CHECK ( memcmp ( results_batch[i]->twoFPerDet[X], results_single->twoFPerDet[X], numFreqBinsBatch * sizeof(results_single->twoFPerDet[X][0]) ) == 0, XLAL_EFAILED );
+                }
+                XLAL_CHECK ( XLALGPSCmp ( &results_batch[i]->refTimePhase, &results_single->refTimePhase ) == 0, XLAL_EFAILED );
+                XLAL_CHECK ( results_batch[i]->doppler.asini == dopplers[i].asini, XLAL_EFAILED );
+                XLALDestroyFstatResults ( results_batch[i] );
+              } // for i < NUM_BATCH
+            XLALDestroyFstatResults ( results_single );
+          } // for iMethod < FMETHOD_END
+      } // for iCase < 2
+#undef NUM_BATCH
+  }
+
+  // ----- test XLALComputeFstatVector(): results must be identical to XLALComputeFstat() on each segment
+  {
+    const UINT4 numFreqBinsVec = 100;
+    const FstatQuantities whatToComputeVec = (FSTATQ_2F | FSTATQ_FAFB | FSTATQ_2F_PER_DET);
+    for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+      {
+        if ( !XLALFstatMethodIsAvailable(iMethod) || (iMethod == FMETHOD_DEMOD_BEST) || (iMethod == FMETHOD_RESAMP_BEST) ) {
+          continue;
+        }
+        FstatInput *segments[2] = { input_seg1[iMethod], input_seg2[iMethod] };
+        FstatInputVector inputs = { .length = 2, .data = segments };
+        FstatResults *results_vec[2] = { NULL, NULL };
+        FstatResults *results_single = NULL;
+        for ( UINT4 iCall = 0; iCall < 2; iCall ++ )	// second call re-uses the per-thread workspaces and results
+          {
+            XLAL_CHECK ( XLALComputeFstatVector ( results_vec, &inputs, &Doppler, numFreqBinsVec, whatToComputeVec ) == XLAL_SUCCESS, XLAL_EFUNC );
+            for ( UINT4 n = 0; n < inputs.length; n ++ )
+              {
+                XLAL_CHECK ( XLALComputeFstat ( &results_single, inputs.data[n], &Doppler, numFreqBinsVec, whatToComputeVec ) == XLAL_SUCCESS, XLAL_EFUNC );
+                XLALPrintInfo ("Comparing vector and single results for method '%s', call %u, segment %u\n", XLALGetFstatInputMethodName(inputs.data[n]), iCall, n );
+                XLAL_CHECK ( memcmp ( results_vec[n]->twoF, results_single->twoF, numFreqBinsVec * sizeof(results_single->twoF[0]) ) == 0, XLAL_EFAILED );
+                XLAL_CHECK ( memcmp ( results_vec[n]->Fa, results_single->Fa, numFreqBinsVec * sizeof(results_single->Fa[0]) ) == 0, XLAL_EFAILED );
+                XLAL_CHECK ( memcmp ( results_vec[n]->Fb, results_single->Fb, numFreqBinsVec * sizeof(results_single->Fb[0]) ) == 0, XLAL_EFAILED );
+                for ( UINT4 X = 0; X < numDetectors; X ++ ) {
+                  XLAL_CHECK ( memcmp ( results_vec[n]->twoFPerDet[X], results_single->twoFPerDet[X], numFreqBinsVec * sizeof(results_single->twoFPerDet[X][0]) ) == 0, XLAL_EFAILED );
+                }
+                XLAL_CHECK ( XLALGPSCmp ( &results_vec[n]->refTimePhase, &results_single->refTimePhase ) == 0, XLAL_EFAILED );
+              } // for n < inputs.length
+          } // for iCall < 2
+        XLALDestroyFstatResults ( results_vec[0] );
+        XLALDestroyFstatResults ( results_vec[1] );
+        XLALDestroyFstatResults ( results_single );
+      } // for iMethod < FMETHOD_END
+  }
+
   // ----- test XLALFstatInputTimeslice()
   // setup optional Fstat arguments
   optionalArgs.FstatMethod = FMETHOD_DEMOD_BEST; // only use demod best
@@ -0,0 +1,151 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/*********************************************************************************/
+/**
+ * \file
+ * \brief Test for XLALAddGaussianNoiseCounterBased(): noise must not depend on the
+ * number of OpenMP threads or on how the data is split into time series, and must
+ * have the requested mean and variance.
+ *
+ */
+#include <math.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <lal/Date.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/GeneratePulsarSignal.h>
+
+// sampling chosen so that every sample time is an exact GPS time
+#define NUM_SAMPLES	300000
+#define DELTA_T		(1.0 / 512)
+#define SIGMA		2.0
+#define SEED		7
+#define STREAM		1
+
+static REAL4TimeSeries *make_noise ( UINT4 offset, UINT4 length, UINT8 stream );
+
+int main(void)
+{
+
+  // ----- reference: single thread, whole series in one go
+#ifdef _OPENMP
+  const int maxThreads = omp_get_max_threads();
+  omp_set_num_threads ( 1 );
+#endif
+  REAL4TimeSeries *ref;
+  XLAL_CHECK_MAIN ( (ref = make_noise ( 0, NUM_SAMPLES, STREAM )) != NULL, XLAL_EFUNC );
+
+  // ----- sample mean and variance
+  REAL8 mean = 0, var = 0;
+  for ( UINT4 i = 0; i < NUM_SAMPLES; i ++ )
+    {
+      mean += ref->data->data[i];
+      var  += ref->data->data[i] * ref->data->data[i];
+    }
+  mean /= NUM_SAMPLES;
+  var = var / NUM_SAMPLES - mean * mean;
+  const REAL8 tolMean = 5 * SIGMA / sqrt ( NUM_SAMPLES );
+  const REAL8 tolVar  = 5 * SIGMA * SIGMA * sqrt ( 2.0 / NUM_SAMPLES );
+  XLALPrintInfo ( "mean = %g (tol %g), variance = %g (expected %g, tol %g)\n", mean, tolMean, var, SIGMA * SIGMA, tolVar );
+  XLAL_CHECK_MAIN ( fabs ( mean ) < tolMean, XLAL_ETOL, "Sample mean %g exceeds tolerance %g\n", mean, tolMean );
+  XLAL_CHECK_MAIN ( fabs ( var - SIGMA * SIGMA ) < tolVar, XLAL_ETOL, "Sample variance %g differs from %g by more than %g\n", var, SIGMA * SIGMA, tolVar );
+
+  // ----- reproducible for any number of threads
+#ifdef _OPENMP
+  for ( int numThreads = 2; numThreads <= 4; numThreads ++ )
+    {
+      omp_set_num_threads ( numThreads );
+      REAL4TimeSeries *ts;
+      XLAL_CHECK_MAIN ( (ts = make_noise ( 0, NUM_SAMPLES, STREAM )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN ( memcmp ( ts->data->data, ref->data->data, NUM_SAMPLES * sizeof(ref->data->data[0]) ) == 0, XLAL_EFAILED,
+                        "Noise generated with %d threads differs from single-threaded noise\n", numThreads );
+      XLALDestroyREAL4TimeSeries ( ts );
+    }
+  omp_set_num_threads ( maxThreads );
+#endif
+
+  // ----- reproducible for any split into time series, including lengths which are not multiples of the internal blocks
+  const UINT4 chunkLengths[] = { 1, 997, 65536, 70001 };
+  for ( UINT4 c = 0; c < sizeof(chunkLengths) / sizeof(chunkLengths[0]); c ++ )
+    {
+      const UINT4 chunkLength = chunkLengths[c];
+      // single-sample chunks are only checked around the start and the internal block boundaries
+      const UINT4 stride = ( chunkLength == 1 ) ? 65535 : chunkLength;
+      for ( UINT4 offset = 0; offset < NUM_SAMPLES; offset += stride )
+        {
+          const UINT4 length = ( NUM_SAMPLES - offset < chunkLength ) ? NUM_SAMPLES - offset : chunkLength;
+          REAL4TimeSeries *ts;
+          XLAL_CHECK_MAIN ( (ts = make_noise ( offset, length, STREAM )) != NULL, XLAL_EFUNC );
+          XLAL_CHECK_MAIN ( memcmp ( ts->data->data, ref->data->data + offset, length * sizeof(ref->data->data[0]) ) == 0, XLAL_EFAILED,
+                            "Noise in samples [%u, %u) differs from the same samples of the whole series\n", offset, offset + length );
+          XLALDestroyREAL4TimeSeries ( ts );
+        }
+    }
+
+  // ----- noise is added to the input series
+  {
+    REAL4TimeSeries *ts;
+    LIGOTimeGPS epoch = ref->epoch;
+    XLAL_CHECK_MAIN ( (ts = XLALCreateREAL4TimeSeries ( "noise", &epoch, 0, DELTA_T, &lalStrainUnit, NUM_SAMPLES )) != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < NUM_SAMPLES; i ++ ) {
+      ts->data->data[i] = 1.0;
+    }
+    XLAL_CHECK_MAIN ( XLALAddGaussianNoiseCounterBased ( ts, SIGMA, SEED, STREAM ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < NUM_SAMPLES; i ++ ) {
+      XLAL_CHECK_MAIN ( ts->data->data[i] == 1.0f + ref->data->data[i], XLAL_EFAILED, "Noise was not added to input sample %u\n", i );
+    }
+    XLALDestroyREAL4TimeSeries ( ts );
+  }
+
+  // ----- different streams are different
+  {
+    REAL4TimeSeries *ts;
+    XLAL_CHECK_MAIN ( (ts = make_noise ( 0, NUM_SAMPLES, STREAM + 1 )) != NULL, XLAL_EFUNC );
+    UINT4 numEqual = 0;
+    for ( UINT4 i = 0; i < NUM_SAMPLES; i ++ ) {
+      numEqual += ( ts->data->data[i] == ref->data->data[i] );
+    }
+    XLAL_CHECK_MAIN ( numEqual < 10, XLAL_EFAILED, "Streams %d and %d share %u of %d samples\n", STREAM, STREAM + 1, numEqual, NUM_SAMPLES );
+    XLALDestroyREAL4TimeSeries ( ts );
+  }
+
+  XLALDestroyREAL4TimeSeries ( ref );
+
+  LALCheckMemoryLeaks();
+
+  return XLAL_SUCCESS;
+
+} // main()
+
+// generate noise in samples [offset, offset+length) of the test series
+static REAL4TimeSeries *
+make_noise ( UINT4 offset, UINT4 length, UINT8 stream )
+{
+  LIGOTimeGPS epoch = { 1000000000, 0 };
+  XLALGPSAdd ( &epoch, offset * DELTA_T );
+  REAL4TimeSeries *ts;
+  XLAL_CHECK_NULL ( (ts = XLALCreateREAL4TimeSeries ( "noise", &epoch, 0, DELTA_T, &lalStrainUnit, length )) != NULL, XLAL_EFUNC );
+  memset ( ts->data->data, 0, length * sizeof(ts->data->data[0]) );
+  XLAL_CHECK_NULL ( XLALAddGaussianNoiseCounterBased ( ts, SIGMA, SEED, stream ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return ts;
+} // make_noise()
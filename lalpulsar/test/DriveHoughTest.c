@@ -62,7 +62,9 @@
  * Then the program builds the set
  * of \c phmd, updates the cylinder and computes a Hough map at a given
  * frequency using only one horizontal line set of \c phmd, and outputs the
- * result into a file.
+ * result into a file. Finally, it checks that XLALHOUGHConstructHMTBatch()
+ * reproduces the unweighted and weighted Hough maps of several trajectories
+ * computed one at a time.
  *
  * By default, running this program with no arguments simply tests the subroutines,
  * producing an output file called <tt>OutHough.asc</tt>.  All default parameters are set from
@@ -84,6 +86,9 @@
  * LALHOUGHupdateSpacePHMDup()
  * LALHOUGHInitializeHT()
  * LALHOUGHConstructHMT()
+ * LALHOUGHConstructHMT_W()
+ * LALHOUGHWeighSpacePHMD()
+ * XLALHOUGHConstructHMTBatch()
  * LALPrintError()
  * LALMalloc()
  * LALFree()
@@ -103,12 +108,14 @@
 #define TESTDRIVEHOUGHC_EARG  2
 #define TESTDRIVEHOUGHC_EBAD  3
 #define TESTDRIVEHOUGHC_EFILE 4
+#define TESTDRIVEHOUGHC_ECMP  5
 
 #define TESTDRIVEHOUGHC_MSGENORM "Normal exit"
 #define TESTDRIVEHOUGHC_MSGESUB  "Subroutine failed"
 #define TESTDRIVEHOUGHC_MSGEARG  "Error parsing arguments"
 #define TESTDRIVEHOUGHC_MSGEBAD  "Bad argument values"
 #define TESTDRIVEHOUGHC_MSGEFILE "Could not create output file"
+#define TESTDRIVEHOUGHC_MSGECMP  "Batch and single Hough maps differ"
 /** @} */
 
 /** \cond DONT_DOXYGEN */
@@ -490,6 +497,66 @@ int main(int argc, char *argv[]){
   fclose( fp );
 
 
+  /******************************************************************/
+  /* compare batch construction of Hough maps, for several          */
+  /* trajectories, against the maps computed one at a time          */
+  /******************************************************************/
+
+  {
+    static HOUGHMapTotal htB[NFSIZE];
+    static UINT8FrequencyIndexVector freqIndB[NFSIZE];
+    REAL8Vector *weightV = NULL;
+    UINT4 m, w;
+
+    for (m=0; m<NFSIZE; ++m){
+      htB[m].xSide = xSide;
+      htB[m].ySide = ySide;
+      htB[m].map = (HoughTT *)LALMalloc(xSide*ySide*sizeof(HoughTT));
+      freqIndB[m].length = MOBSCOH;
+      freqIndB[m].deltaF = DF;
+      freqIndB[m].data = (UINT8 *)LALMalloc(MOBSCOH*sizeof(UINT8));
+      for (j=0; j<MOBSCOH; ++j){   /* neighbouring spin-down trajectories */
+        freqIndB[m].data[j] = phmdVS.fBinMin + (m*j)/MOBSCOH;
+      }
+    }
+
+    weightV = XLALCreateREAL8Vector( MOBSCOH );
+    for (j=0; j<MOBSCOH; ++j){
+      weightV->data[j] = 0.5 + 0.1*j;
+    }
+
+    for (w=0; w<2; ++w){   /* unweighted, then weighted maps */
+      if ( w ) {
+        SUB( LALHOUGHWeighSpacePHMD( &status, &phmdVS, weightV ), &status );
+      }
+      if ( XLALHOUGHConstructHMTBatch( htB, freqIndB, NFSIZE, &phmdVS, w ) != XLAL_SUCCESS ) {
+        ERROR( TESTDRIVEHOUGHC_ESUB, TESTDRIVEHOUGHC_MSGESUB,
+               "Function call \"XLALHOUGHConstructHMTBatch()\" failed:" );
+        return TESTDRIVEHOUGHC_ESUB;
+      }
+      for (m=0; m<NFSIZE; ++m){
+        if ( w ) {
+          SUB( LALHOUGHConstructHMT_W( &status, &ht, &freqIndB[m], &phmdVS ), &status );
+        } else {
+          SUB( LALHOUGHConstructHMT( &status, &ht, &freqIndB[m], &phmdVS ), &status );
+        }
+        for (i=0; i<(UINT4)(xSide*ySide); ++i){
+          if ( htB[m].map[i] != ht.map[i] ) {
+            ERROR( TESTDRIVEHOUGHC_ECMP, TESTDRIVEHOUGHC_MSGECMP, 0 );
+            return TESTDRIVEHOUGHC_ECMP;
+          }
+        }
+      }
+    }
+
+    XLALDestroyREAL8Vector( weightV );
+    for (m=0; m<NFSIZE; ++m){
+      LALFree( htB[m].map );
+      LALFree( freqIndB[m].data );
+    }
+  }
+
+
   /******************************************************************/
   /* Free memory and exit */
   /******************************************************************/
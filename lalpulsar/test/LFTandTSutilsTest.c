@@ -241,6 +241,31 @@ test_XLALSincInterpolateCOMPLEX8TimeSeries ( void )
     } // for j < numSamplesOut
 
   XLAL_CHECK ( XLALSincInterpolateCOMPLEX8TimeSeries ( tsOut->data, times_out, tsIn, Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // ---------- batch interpolation must reproduce single interpolation exactly, here for a second set of shifted and fewer time-samples
+  {
+    UINT4 numSamplesOut2 = numSamplesOut / 2;
+    REAL8Vector *times_out2;
+    XLAL_CHECK ( (times_out2 = XLALCreateREAL8Vector ( numSamplesOut2 )) != NULL, XLAL_EFUNC );
+    for ( UINT4 j = 0; j < numSamplesOut2; j ++ ) {
+      times_out2->data[j] = times_out->data[j] + 0.37 * dt;
+    }
+    COMPLEX8Vector *y_single2, *y_batch[2];
+    XLAL_CHECK ( (y_single2 = XLALCreateCOMPLEX8Vector ( numSamplesOut2 )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( (y_batch[0] = XLALCreateCOMPLEX8Vector ( numSamplesOut )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( (y_batch[1] = XLALCreateCOMPLEX8Vector ( numSamplesOut2 )) != NULL, XLAL_EFUNC );
+    REAL8Vector *t_batch[2] = { times_out, times_out2 };
+
+    XLAL_CHECK ( XLALSincInterpolateCOMPLEX8TimeSeries ( y_single2, times_out2, tsIn, Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALSincInterpolateCOMPLEX8TimeSeriesBatch ( y_batch, t_batch, 2, tsIn, Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( memcmp ( y_batch[0]->data, tsOut->data->data, numSamplesOut * sizeof(COMPLEX8) ) == 0, XLAL_ETOL, "Batch interpolation differs from single interpolation for set 0\n" );
+    XLAL_CHECK ( memcmp ( y_batch[1]->data, y_single2->data, numSamplesOut2 * sizeof(COMPLEX8) ) == 0, XLAL_ETOL, "Batch interpolation differs from single interpolation for set 1\n" );
+
+    XLALDestroyREAL8Vector ( times_out2 );
+    XLALDestroyCOMPLEX8Vector ( y_single2 );
+    XLALDestroyCOMPLEX8Vector ( y_batch[0] );
+    XLALDestroyCOMPLEX8Vector ( y_batch[1] );
+  }
   XLALDestroyREAL8Vector ( times_out );
 
   // ---------- check accuracy of interpolation
@@ -0,0 +1,715 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+/**
+ * @defgroup lalsim_bench lalsim-bench
+ * @ingroup lalsimulation_programs
+ *
+ * @brief Benchmarks waveform generation across approximants
+ *
+ * ### Synopsis
+ *
+ *     lalsim-bench [options]
+ *
+ * ### Description
+ *
+ * The `lalsim-bench` utility times XLALSimInspiralChooseTDWaveform() and
+ * XLALSimInspiralChooseFDWaveform() for a list of approximants over a grid
+ * of masses, aligned spins, starting frequencies (i.e. durations) and sample
+ * rates.  Each grid point is generated once untimed, to absorb one-off costs
+ * such as loading reduced-order-model data (the latency of this first call is
+ * reported separately), and then repeatedly to measure the distribution of
+ * per-call latencies.  One row per grid point is written in CSV or JSON
+ * format, giving the minimum, median, mean, 90th percentile and maximum
+ * latency, the peak number of bytes allocated through LALMalloc() during a
+ * call, and the peak resident set size of the process.
+ *
+ * Grid points which an approximant cannot generate (e.g. outside its range
+ * of validity, or with missing data files) are reported with status `error`
+ * and do not stop the benchmark.
+ *
+ * If a baseline file written by a previous run of `lalsim-bench` in CSV
+ * format is given, the median latency of each grid point is compared against
+ * the baseline and the utility exits with status 2 if any grid point is
+ * slower by more than the given tolerance.
+ *
+ * ### Options
+ * [default values in brackets]
+ *
+ * <DL>
+ * <DT>`-h`, `--help`
+ * <DD>print a help message and exit</DD>
+ * <DT>`-v`, `--verbose`
+ * <DD>verbose output</DD>
+ * <DT>`-a` APPROXS, `--approximants=`APPROXS
+ * <DD>comma-separated list of approximants [see usage]</DD>
+ * <DT>`-D` domain, `--domain=`DOMAIN
+ * <DD>domain for waveform generation when both are available {"time", "freq"}
+ * [use frequency domain if available]</DD>
+ * <DT>`-M` M1S, `--m1=`M1S
+ * <DD>comma-separated list of primary masses in solar masses [1.4,10,30]</DD>
+ * <DT>`-m` M2S, `--m2=`M2S
+ * <DD>comma-separated list of secondary masses in solar masses [1.4,10,30];
+ * only grid points with m1 >= m2 are used</DD>
+ * <DT>`-z` CHIS, `--spinz=`CHIS
+ * <DD>comma-separated list of aligned dimensionless spins of both bodies [0]</DD>
+ * <DT>`-f` FMINS, `--f-min=`FMINS
+ * <DD>comma-separated list of starting frequencies in Hertz [20]</DD>
+ * <DT>`-R` SRATES, `--sample-rate=`SRATES
+ * <DD>comma-separated list of sample rates in Hertz [4096]</DD>
+ * <DT>`-n` N, `--repeats=`N
+ * <DD>number of timed calls per grid point [10]</DD>
+ * <DT>`-F` FORMAT, `--format=`FORMAT
+ * <DD>output format {"csv", "json"} [csv]</DD>
+ * <DT>`-o` FILE, `--output=`FILE
+ * <DD>output file [standard output]</DD>
+ * <DT>`-b` FILE, `--baseline=`FILE
+ * <DD>CSV output of a previous run to compare against</DD>
+ * <DT>`-t` TOL, `--tolerance=`TOL
+ * <DD>allowed fractional increase in median latency over the baseline [0.2]</DD>
+ * <DT>`-A`, `--arena`
+ * <DD>allocate LAL vectors and series from a memory arena during each timed
+ * call; the first call, which loads any ROM data, is made outside the arena;
+ * see XLALPushMemoryArena()</DD>
+ * </DL>
+ *
+ * ### Environment
+ *
+ * Allocation statistics, the peak number of bytes allocated and the largest
+ * number of allocations made during a timed call, require LAL memory
+ * debugging to be enabled, e.g. with `LAL_DEBUG_LEVEL=memdbg`; otherwise they
+ * are reported as -1.  Since memory
+ * debugging slows down allocation, latencies should be compared between runs
+ * with the same `LAL_DEBUG_LEVEL`.
+ *
+ * ### Exit Status
+ *
+ * The `lalsim-bench` utility exits 0 on success, 1 if an error occurs, and 2
+ * if a regression against the baseline is found.
+ *
+ * ### Example
+ *
+ * The commands:
+ *
+ *     lalsim-bench --approximants=TaylorF2,IMRPhenomD --f-min=10,20 > base.csv
+ *     lalsim-bench --approximants=TaylorF2,IMRPhenomD --f-min=10,20 --baseline=base.csv
+ *
+ * time TaylorF2 and IMRPhenomD for 6 mass pairs and 2 starting frequencies,
+ * and then repeat the measurement and compare it against the first.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include <lal/LALgetopt.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDatatypes.h>
+#include <lal/LALDebugLevel.h>
+#include <lal/LALMalloc.h>
+#include <lal/LALString.h>
+#include <lal/LALTrace.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALSimInspiral.h>
+
+/* default values of parameters */
+#define DEFAULT_APPROXS "TaylorF2,IMRPhenomD,IMRPhenomXAS,IMRPhenomXHM,IMRPhenomXPHM,SEOBNRv4_ROM,NRSur7dq4,SpinTaylorT4,TEOBResumS"
+#define DEFAULT_M1S "1.4,10,30"
+#define DEFAULT_M2S "1.4,10,30"
+#define DEFAULT_CHIS "0"
+#define DEFAULT_FMINS "20"
+#define DEFAULT_SRATES "4096"
+#define DEFAULT_REPEATS 10
+#define DEFAULT_TOLERANCE 0.2
+#define DEFAULT_DISTANCE 100.0
+
+/* maximum number of entries in a comma-separated list */
+#define MAX_LIST 64
+
+/* a comma-separated list of numbers */
+struct list {
+    size_t length;
+    double data[MAX_LIST];
+};
+
+/* parameters given in command line arguments */
+struct params {
+    int verbose;
+    int arena;
+    int domain;
+    int json;
+    int repeats;
+    double tolerance;
+    size_t napprox;
+    Approximant approx[MAX_LIST];
+    struct list m1;
+    struct list m2;
+    struct list chi;
+    struct list f_min;
+    struct list srate;
+    const char *output;
+    const char *baseline;
+};
+
+/* result of benchmarking one grid point */
+struct result {
+    const char *approx;
+    const char *domain;
+    double m1;
+    double m2;
+    double chi;
+    double f_min;
+    double srate;
+    const char *status;
+    size_t length;
+    double first;
+    double min;
+    double median;
+    double mean;
+    double p90;
+    double max;
+    long alloc_peak;
+    long allocs;
+    long max_rss;
+};
+
+/* a baseline entry read from a previous CSV output */
+struct baseline {
+    size_t length;
+    struct {
+        char key[128];
+        double median;
+    } *data;
+};
+
+int usage(const char *program);
+struct params parseargs(int argc, char **argv);
+double imr_time_bound(double f_min, double m1, double m2, double s1z, double s2z);
+int generate(struct params *p, int arena, Approximant approx, int domain, double m1, double m2, double chi, double f_min, double srate, size_t *length);
+int bench(struct result *r, struct params *p, Approximant approx, double m1, double m2, double chi, double f_min, double srate);
+int output_result(FILE *fp, const struct result *r, int json, int first);
+int read_baseline(struct baseline *b, const char *fname);
+const char *result_key(char *key, size_t len, const char *approx, const char *domain, double m1, double m2, double chi, double f_min, double srate);
+int compare_double(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+    struct params p;
+    struct baseline b = { 0, NULL };
+    FILE *fp = stdout;
+    int first = 1;
+    int regressions = 0;
+
+    p = parseargs(argc, argv);
+
+    if (p.baseline && read_baseline(&b, p.baseline) < 0) {
+        fprintf(stderr, "error: could not read baseline file %s\n", p.baseline);
+        exit(1);
+    }
+
+    if (p.output && (fp = fopen(p.output, "w")) == NULL) {
+        fprintf(stderr, "error: could not open output file %s\n", p.output);
+        exit(1);
+    }
+
+    if (p.json)
+        fprintf(fp, "[\n");
+    else
+        fprintf(fp, "approximant,domain,m1,m2,chi,f_min,srate,status,length,first_s,min_s,median_s,mean_s,p90_s,max_s,alloc_peak_bytes,allocs_per_call,max_rss_kb\n");
+
+    for (size_t a = 0; a < p.napprox; ++a)
+        for (size_t i1 = 0; i1 < p.m1.length; ++i1)
+            for (size_t i2 = 0; i2 < p.m2.length; ++i2)
+                for (size_t ic = 0; ic < p.chi.length; ++ic)
+                    for (size_t jf = 0; jf < p.f_min.length; ++jf)
+                        for (size_t js = 0; js < p.srate.length; ++js) {
+                            struct result r;
+                            if (p.m1.data[i1] < p.m2.data[i2])
+                                continue;
+                            bench(&r, &p, p.approx[a], p.m1.data[i1], p.m2.data[i2], p.chi.data[ic], p.f_min.data[jf], p.srate.data[js]);
+                            output_result(fp, &r, p.json, first);
+                            fflush(fp);
+                            first = 0;
+
+                            /* compare with the baseline */
+                            if (b.length > 0 && strcmp(r.status, "ok") == 0) {
+                                char key[128];
+                                result_key(key, sizeof(key), r.approx, r.domain, r.m1, r.m2, r.chi, r.f_min, r.srate);
+                                for (size_t k = 0; k < b.length; ++k) {
+                                    if (strcmp(key, b.data[k].key) == 0 && r.median > (1.0 + p.tolerance) * b.data[k].median) {
+                                        fprintf(stderr, "regression: %s: median %g s, baseline %g s\n", key, r.median, b.data[k].median);
+                                        ++regressions;
+                                    }
+                                }
+                            }
+                        }
+
+    if (p.json)
+        fprintf(fp, "%s]\n", first ? "" : "\n");
+    if (fp != stdout)
+        fclose(fp);
+
+    XLALFree(b.data);
+    LALCheckMemoryLeaks();
+    return regressions > 0 ? 2 : 0;
+}
+
+/* generates and destroys a single waveform, allocating from a memory arena
+ * if arena is non-zero; returns the number of samples generated in length,
+ * or a negative value on failure */
+int generate(struct params *p, int arena, Approximant approx, int domain, double m1, double m2, double chi, double f_min, double srate, size_t *length)
+{
+    const double distance = DEFAULT_DISTANCE * 1e6 * LAL_PC_SI;
+    int ret;
+
+    m1 *= LAL_MSUN_SI;
+    m2 *= LAL_MSUN_SI;
+
+    if (arena && XLALPushMemoryArena(0) < 0)
+        return -1;
+
+    if (domain == LAL_SIM_DOMAIN_FREQUENCY) {
+        COMPLEX16FrequencySeries *htilde_plus = NULL;
+        COMPLEX16FrequencySeries *htilde_cross = NULL;
+        double chirplen, deltaF;
+        int chirplen_exp;
+
+        /* frequency resolution is determined by the next power of two
+         * greater than the duration, as in lalsim-inspiral */
+        chirplen = imr_time_bound(f_min, m1, m2, chi, chi) * srate;
+        frexp(chirplen, &chirplen_exp);
+        chirplen = ldexp(1.0, chirplen_exp);
+        deltaF = srate / chirplen;
+
+        ret = XLALSimInspiralChooseFDWaveform(&htilde_plus, &htilde_cross, m1, m2, 0, 0, chi, 0, 0, chi, distance, 0, 0, 0, 0, 0, deltaF, f_min, 0.5 * srate, 0, NULL, approx);
+        *length = htilde_plus ? htilde_plus->data->length : 0;
+        XLALDestroyCOMPLEX16FrequencySeries(htilde_cross);
+        XLALDestroyCOMPLEX16FrequencySeries(htilde_plus);
+    } else {
+        REAL8TimeSeries *h_plus = NULL;
+        REAL8TimeSeries *h_cross = NULL;
+
+        ret = XLALSimInspiralChooseTDWaveform(&h_plus, &h_cross, m1, m2, 0, 0, chi, 0, 0, chi, distance, 0, 0, 0, 0, 0, 1.0 / srate, f_min, 0, NULL, approx);
+        *length = h_plus ? h_plus->data->length : 0;
+        XLALDestroyREAL8TimeSeries(h_cross);
+        XLALDestroyREAL8TimeSeries(h_plus);
+    }
+
+    if (arena)
+        XLALPopMemoryArena();
+
+    if (p->verbose && ret < 0)
+        fprintf(stderr, "generation of %s failed: %s\n", XLALSimInspiralGetStringFromApproximant(approx), XLALErrorString(xlalErrno));
+    XLALClearErrno();
+    return ret;
+}
+
+/* benchmarks a single grid point */
+int bench(struct result *r, struct params *p, Approximant approx, double m1, double m2, double chi, double f_min, double srate)
+{
+    const int memtrack = (lalDebugLevel & LALMEMPADBIT) != 0;
+    int isfd = XLALSimInspiralImplementedFDApproximants(approx);
+    int istd = XLALSimInspiralImplementedTDApproximants(approx);
+    int domain;
+    double *times;
+    struct rusage usage;
+    INT8 start;
+
+    /* choose domain */
+    switch (p->domain) {
+    case LAL_SIM_DOMAIN_TIME:
+        domain = istd ? LAL_SIM_DOMAIN_TIME : LAL_SIM_DOMAIN_FREQUENCY;
+        break;
+    case LAL_SIM_DOMAIN_FREQUENCY:
+        domain = isfd ? LAL_SIM_DOMAIN_FREQUENCY : LAL_SIM_DOMAIN_TIME;
+        break;
+    default:
+        domain = isfd ? LAL_SIM_DOMAIN_FREQUENCY : LAL_SIM_DOMAIN_TIME;
+        break;
+    }
+
+    memset(r, 0, sizeof(*r));
+    r->approx = XLALSimInspiralGetStringFromApproximant(approx);
+    r->domain = domain == LAL_SIM_DOMAIN_FREQUENCY ? "freq" : "time";
+    r->m1 = m1;
+    r->m2 = m2;
+    r->chi = chi;
+    r->f_min = f_min;
+    r->srate = srate;
+    r->alloc_peak = -1;
+    r->allocs = -1;
+    r->status = "ok";
+
+    if (p->verbose)
+        fprintf(stderr, "benchmarking %s in %s domain: m1=%g m2=%g chi=%g f_min=%g srate=%g\n", r->approx, r->domain, m1, m2, chi, f_min, srate);
+
+    if (!istd && !isfd) {
+        r->status = "unsupported";
+        return -1;
+    }
+
+    /* first call: includes one-off costs; never uses the arena, since data
+     * loaded on first use (e.g. ROM tables) persists beyond the call */
+    start = XLALTraceNow();
+    if (generate(p, 0, approx, domain, m1, m2, chi, f_min, srate, &r->length) < 0) {
+        r->status = "error";
+        return -1;
+    }
+    r->first = 1e-9 * (XLALTraceNow() - start);
+
+    /* timed calls */
+    times = XLALMalloc(p->repeats * sizeof(*times));
+    if (!times) {
+        r->status = "error";
+        return -1;
+    }
+    for (int k = 0; k < p->repeats; ++k) {
+        size_t length;
+        size_t base = lalMallocTotal;
+        size_t count = lalMallocCount;
+        LALMemoryArenaStats arena_before, arena_after;
+        if (memtrack)
+            lalMallocTotalPeak = base;
+        XLALGetMemoryArenaStats(&arena_before);
+        start = XLALTraceNow();
+        if (generate(p, p->arena, approx, domain, m1, m2, chi, f_min, srate, &length) < 0) {
+            r->status = "error";
+            XLALFree(times);
+            return -1;
+        }
+        times[k] = 1e-9 * (XLALTraceNow() - start);
+        XLALGetMemoryArenaStats(&arena_after);
+        if (memtrack && (long)(lalMallocTotalPeak - base) > r->alloc_peak)
+            r->alloc_peak = lalMallocTotalPeak - base;
+        /* allocations from an arena are not seen by memory debugging */
+        if (memtrack && (long)(lalMallocCount - count + arena_after.allocations - arena_before.allocations) > r->allocs)
+            r->allocs = lalMallocCount - count + arena_after.allocations - arena_before.allocations;
+    }
+
+    /* latency distribution */
+    qsort(times, p->repeats, sizeof(*times), compare_double);
+    r->min = times[0];
+    r->max = times[p->repeats - 1];
+    r->median = (p->repeats % 2) ? times[p->repeats / 2] : 0.5 * (times[p->repeats / 2 - 1] + times[p->repeats / 2]);
+    r->p90 = times[(size_t) ceil(0.9 * p->repeats) - 1];
+    for (int k = 0; k < p->repeats; ++k)
+        r->mean += times[k] / p->repeats;
+    XLALFree(times);
+
+    /* peak resident set size of the process so far */
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        r->max_rss = usage.ru_maxrss;
+
+    return 0;
+}
+
+/* writes the result of one grid point */
+int output_result(FILE *fp, const struct result *r, int json, int first)
+{
+    if (json)
+        fprintf(fp, "%s  {\"approximant\": \"%s\", \"domain\": \"%s\", \"m1\": %g, \"m2\": %g, \"chi\": %g, \"f_min\": %g, \"srate\": %g, "
+            "\"status\": \"%s\", \"length\": %zu, \"first_s\": %.6e, \"min_s\": %.6e, \"median_s\": %.6e, \"mean_s\": %.6e, "
+            "\"p90_s\": %.6e, \"max_s\": %.6e, \"alloc_peak_bytes\": %ld, \"allocs_per_call\": %ld, \"max_rss_kb\": %ld}",
+            first ? "" : ",\n", r->approx, r->domain, r->m1, r->m2, r->chi, r->f_min, r->srate, r->status, r->length,
+            r->first, r->min, r->median, r->mean, r->p90, r->max, r->alloc_peak, r->allocs, r->max_rss);
+    else
+        fprintf(fp, "%s,%s,%g,%g,%g,%g,%g,%s,%zu,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%ld,%ld,%ld\n",
+            r->approx, r->domain, r->m1, r->m2, r->chi, r->f_min, r->srate, r->status, r->length,
+            r->first, r->min, r->median, r->mean, r->p90, r->max, r->alloc_peak, r->allocs, r->max_rss);
+    return 0;
+}
+
+/* returns the key identifying a grid point */
+const char *result_key(char *key, size_t len, const char *approx, const char *domain, double m1, double m2, double chi, double f_min, double srate)
+{
+    snprintf(key, len, "%s,%s,%g,%g,%g,%g,%g", approx, domain, m1, m2, chi, f_min, srate);
+    return key;
+}
+
+/* reads the successful grid points of a previous CSV output */
+int read_baseline(struct baseline *b, const char *fname)
+{
+    char line[1024];
+    FILE *fp = fopen(fname, "r");
+    if (!fp)
+        return -1;
+    while (fgets(line, sizeof(line), fp)) {
+        char approx[64], domain[16], status[16];
+        double m1, m2, chi, f_min, srate, first, min, median;
+        size_t length;
+        if (sscanf(line, "%63[^,],%15[^,],%lg,%lg,%lg,%lg,%lg,%15[^,],%zu,%lg,%lg,%lg", approx, domain, &m1, &m2, &chi, &f_min, &srate, status, &length, &first, &min, &median) != 12)
+            continue;   /* header or malformed line */
+        if (strcmp(status, "ok") != 0)
+            continue;
+        void *data = XLALRealloc(b->data, (b->length + 1) * sizeof(*b->data));
+        if (!data) {
+            fclose(fp);
+            return -1;  /* b->data still holds the entries read so far */
+        }
+        b->data = data;
+        result_key(b->data[b->length].key, sizeof(b->data[b->length].key), approx, domain, m1, m2, chi, f_min, srate);
+        b->data[b->length].median = median;
+        ++b->length;
+    }
+    fclose(fp);
+    return 0;
+}
+
+int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* routine to crudely overestimate the duration of the inspiral, merger, and ringdown */
+double imr_time_bound(double f_min, double m1, double m2, double s1z, double s2z)
+{
+    double tchirp, tmerge;
+    double s;
+
+    /* lower bound on the chirp time starting at f_min */
+    tchirp = XLALSimInspiralChirpTimeBound(f_min, m1, m2, s1z, s2z);
+
+    /* upper bound on the final black hole spin */
+    s = XLALSimInspiralFinalBlackHoleSpinBound(s1z, s2z);
+
+    /* lower bound on the final plunge, merger, and ringdown time */
+    tmerge = XLALSimInspiralMergeTimeBound(m1, m2) + XLALSimInspiralRingdownTimeBound(m1 + m2, s);
+
+    return tchirp + tmerge;
+}
+
+/* parses a comma-separated list of numbers */
+static void parse_list(struct list *l, const char *s, const char *name)
+{
+    char *copy = XLALStringDuplicate(s);
+    char *rest = copy;
+    char *tok;
+    l->length = 0;
+    while ((tok = XLALStringToken(&rest, ",", 0))) {
+        char *end;
+        if (l->length == MAX_LIST) {
+            fprintf(stderr, "error: too many values for %s\n", name);
+            exit(1);
+        }
+        l->data[l->length++] = strtod(tok, &end);
+        if (*end != '\0') {
+            fprintf(stderr, "error: invalid value %s for %s\n", tok, name);
+            exit(1);
+        }
+    }
+    XLALFree(copy);
+}
+
+/* parses a comma-separated list of approximants */
+static void parse_approxs(struct params *p, const char *s)
+{
+    char *copy = XLALStringDuplicate(s);
+    char *rest = copy;
+    char *tok;
+    p->napprox = 0;
+    while ((tok = XLALStringToken(&rest, ",", 0))) {
+        int approx = XLALSimInspiralGetApproximantFromString(tok);
+        if (approx == XLAL_FAILURE) {
+            fprintf(stderr, "error: invalid approximant %s\n", tok);
+            exit(1);
+        }
+        if (p->napprox == MAX_LIST) {
+            fprintf(stderr, "error: too many approximants\n");
+            exit(1);
+        }
+        p->approx[p->napprox++] = approx;
+    }
+    XLALFree(copy);
+}
+
+/* prints the usage message */
+int usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [options]\n", program);
+    fprintf(stderr, "options [default values in brackets]:\n");
+    fprintf(stderr, "\t-h, --help               \tprint this message and exit\n");
+    fprintf(stderr, "\t-v, --verbose            \tverbose output\n");
+    fprintf(stderr, "\t-a APPROXS, --approximants=APPROXS\n\t\tcomma-separated list of approximants\n\t\t[%s]\n", DEFAULT_APPROXS);
+    fprintf(stderr, "\t-D domain, --domain=DOMAIN      \n\t\tdomain for waveform generation when both are available\n\t\t{\"time\", \"freq\"} [freq if available]\n");
+    fprintf(stderr, "\t-M M1S, --m1=M1S                \n\t\tcomma-separated list of primary masses in solar masses [%s]\n", DEFAULT_M1S);
+    fprintf(stderr, "\t-m M2S, --m2=M2S                \n\t\tcomma-separated list of secondary masses in solar masses [%s]\n", DEFAULT_M2S);
+    fprintf(stderr, "\t-z CHIS, --spinz=CHIS           \n\t\tcomma-separated list of aligned spins of both bodies [%s]\n", DEFAULT_CHIS);
+    fprintf(stderr, "\t-f FMINS, --f-min=FMINS         \n\t\tcomma-separated list of starting frequencies in Hertz [%s]\n", DEFAULT_FMINS);
+    fprintf(stderr, "\t-R SRATES, --sample-rate=SRATES \n\t\tcomma-separated list of sample rates in Hertz [%s]\n", DEFAULT_SRATES);
+    fprintf(stderr, "\t-n N, --repeats=N               \n\t\tnumber of timed calls per grid point [%d]\n", DEFAULT_REPEATS);
+    fprintf(stderr, "\t-F FORMAT, --format=FORMAT      \n\t\toutput format {\"csv\", \"json\"} [csv]\n");
+    fprintf(stderr, "\t-o FILE, --output=FILE          \n\t\toutput file [standard output]\n");
+    fprintf(stderr, "\t-b FILE, --baseline=FILE        \n\t\tCSV output of a previous run to compare against\n");
+    fprintf(stderr, "\t-t TOL, --tolerance=TOL         \n\t\tallowed fractional increase in median latency over baseline [%g]\n", DEFAULT_TOLERANCE);
+    fprintf(stderr, "\t-A, --arena              \tallocate from a memory arena during each call\n");
+    return 0;
+}
+
+/* returns the long name of the option with value c; option_index is only
+ * set by LALgetopt_long_only() when the long form of an option is given */
+static const char *option_name(const struct LALoption *long_options, int c)
+{
+    for (; long_options->name; ++long_options)
+        if (long_options->val == c)
+            return long_options->name;
+    return "unknown option";
+}
+
+/* sets params to default values and parses the command line arguments */
+struct params parseargs(int argc, char **argv)
+{
+    struct params p = {
+        .verbose = 0,
+        .arena = 0,
+        .domain = -1,
+        .json = 0,
+        .repeats = DEFAULT_REPEATS,
+        .tolerance = DEFAULT_TOLERANCE,
+        .output = NULL,
+        .baseline = NULL
+    };
+    struct LALoption long_options[] = {
+        {"help", no_argument, 0, 'h'},
+        {"verbose", no_argument, 0, 'v'},
+        {"arena", no_argument, 0, 'A'},
+        {"approximants", required_argument, 0, 'a'},
+        {"domain", required_argument, 0, 'D'},
+        {"m1", required_argument, 0, 'M'},
+        {"m2", required_argument, 0, 'm'},
+        {"spinz", required_argument, 0, 'z'},
+        {"f-min", required_argument, 0, 'f'},
+        {"sample-rate", required_argument, 0, 'R'},
+        {"repeats", required_argument, 0, 'n'},
+        {"format", required_argument, 0, 'F'},
+        {"output", required_argument, 0, 'o'},
+        {"baseline", required_argument, 0, 'b'},
+        {"tolerance", required_argument, 0, 't'},
+        {0, 0, 0, 0}
+    };
+    char args[] = "hvAa:D:M:m:z:f:R:n:F:o:b:t:";
+
+    parse_approxs(&p, DEFAULT_APPROXS);
+    parse_list(&p.m1, DEFAULT_M1S, "m1");
+    parse_list(&p.m2, DEFAULT_M2S, "m2");
+    parse_list(&p.chi, DEFAULT_CHIS, "spinz");
+    parse_list(&p.f_min, DEFAULT_FMINS, "f-min");
+    parse_list(&p.srate, DEFAULT_SRATES, "sample-rate");
+
+    while (1) {
+        int option_index = 0;
+        int c;
+
+        c = LALgetopt_long_only(argc, argv, args, long_options, &option_index);
+        if (c == -1)    /* end of options */
+            break;
+
+        switch (c) {
+        case 0:        /* if option set a flag, nothing else to do */
+            if (long_options[option_index].flag)
+                break;
+            else {
+                fprintf(stderr, "error parsing option %s with argument %s\n", long_options[option_index].name, LALoptarg);
+                exit(1);
+            }
+        case 'h':      /* help */
+            usage(argv[0]);
+            exit(0);
+        case 'v':      /* verbose */
+            p.verbose = 1;
+            break;
+        case 'A':      /* arena */
+            p.arena = 1;
+            break;
+        case 'a':      /* approximants */
+            parse_approxs(&p, LALoptarg);
+            break;
+        case 'D':      /* domain */
+            switch (*LALoptarg) {
+            case 'T':
+            case 't':
+                p.domain = LAL_SIM_DOMAIN_TIME;
+                break;
+            case 'F':
+            case 'f':
+                p.domain = LAL_SIM_DOMAIN_FREQUENCY;
+                break;
+            default:
+                fprintf(stderr, "error: invalid value %s for %s\n", LALoptarg, option_name(long_options, c));
+                exit(1);
+            }
+            break;
+        case 'M':      /* m1 */
+            parse_list(&p.m1, LALoptarg, "m1");
+            break;
+        case 'm':      /* m2 */
+            parse_list(&p.m2, LALoptarg, "m2");
+            break;
+        case 'z':      /* spinz */
+            parse_list(&p.chi, LALoptarg, "spinz");
+            break;
+        case 'f':      /* f-min */
+            parse_list(&p.f_min, LALoptarg, "f-min");
+            break;
+        case 'R':      /* sample-rate */
+            parse_list(&p.srate, LALoptarg, "sample-rate");
+            break;
+        case 'n':      /* repeats */
+            p.repeats = atoi(LALoptarg);
+            if (p.repeats < 1) {
+                fprintf(stderr, "error: invalid value %s for %s\n", LALoptarg, option_name(long_options, c));
+                exit(1);
+            }
+            break;
+        case 'F':      /* format */
+            if (XLALStringCaseCompare(LALoptarg, "json") == 0)
+                p.json = 1;
+            else if (XLALStringCaseCompare(LALoptarg, "csv") == 0)
+                p.json = 0;
+            else {
+                fprintf(stderr, "error: invalid value %s for %s\n", LALoptarg, option_name(long_options, c));
+                exit(1);
+            }
+            break;
+        case 'o':      /* output */
+            p.output = LALoptarg;
+            break;
+        case 'b':      /* baseline */
+            p.baseline = LALoptarg;
+            break;
+        case 't':      /* tolerance */
+            p.tolerance = atof(LALoptarg);
+            break;
+        case '?':
+        default:
+            fprintf(stderr, "unknown error while parsing options\n");
+            exit(1);
+        }
+    }
+    if (LALoptind < argc) {
+        fprintf(stderr, "extraneous command line arguments:\n");
+        while (LALoptind < argc)
+            fprintf(stderr, "%s\n", argv[LALoptind++]);
+        exit(1);
+    }
+
+    return p;
+}
@@ -948,8 +948,9 @@ int IMRPhenomTPHM_EvolveOrbit(
     size_t length1 = floor(tint1/pWF->dtM);
 
     /* run the integration; note: time is measured in \hat{t} = t / M.
-     Integration is indeed perform until tend - dtM to avoid an extra final point. */
-    len = XLALAdaptiveRungeKutta4Hermite(integrator, &params, yinit,
+     Integration is indeed perform until tend - dtM to avoid an extra final point.
+     The output array yout belongs to the integrator. */
+    len = XLALAdaptiveRungeKutta4HermiteReuse(integrator, &params, yinit,
             tint1, tend - pWF->dtM, pWF->dtM, &yout);
 
     // Check if integration failed.
@@ -957,6 +958,8 @@ int IMRPhenomTPHM_EvolveOrbit(
     {
         XLALPrintError("XLAL Error - %s: integration failed (yout == NULL)\n",
                        __func__);
+        LALFree(Tparams);
+        XLALAdaptiveRungeKuttaFree(integrator);
         XLAL_ERROR(XLAL_EFUNC);
     }
 
@@ -964,6 +967,8 @@ int IMRPhenomTPHM_EvolveOrbit(
     if (!len) 
     {
         XLALPrintError("XLAL Error - %s: integration failed with errorcode %d.\n", __func__, intreturn);
+        LALFree(Tparams);
+        XLALAdaptiveRungeKuttaFree(integrator);
         XLAL_ERROR(XLAL_EFUNC);
     }
 
@@ -1004,7 +1009,6 @@ int IMRPhenomTPHM_EvolveOrbit(
     if ( !*V || !*S1x || !*S1y || !*S1z || !*S2x || !*S2y || !*S2z
              || !*LNhatx || !*LNhaty || !*LNhatz || !*E1x || !*E1y || !*E1z )
     {
-        XLALDestroyREAL8Array(yout);
         LALFree(Tparams);
         XLALAdaptiveRungeKuttaFree(integrator);
         XLAL_ERROR(XLAL_EFUNC);
@@ -1031,10 +1035,9 @@ int IMRPhenomTPHM_EvolveOrbit(
         (*E1z)->data->data[j]     = yout->data[12*len+i];
     }
 
-    // Free PN Taylor struct and integrator. If tmin!=tref and a second integration step is needed, will be defined again, to avoid possible overwritting.
+    // Free PN Taylor struct. If tmin!=tref and a second integration step is needed, it will be defined again, to avoid possible overwritting.
+    // The integrator is kept and reset for the second integration step, reusing its workspace and output array.
     LALFree(Tparams);
-    XLALAdaptiveRungeKuttaFree(integrator);
-    XLALDestroyREAL8Array(yout);
 
     /********* Integration from tref to tmin ******/
     /* If tref!=tmin, quantities have to be evolved backwards from tref to tmin.
@@ -1045,8 +1048,7 @@ int IMRPhenomTPHM_EvolveOrbit(
 
       /* Initialize objects and variables needed for the RK integrator */
 
-      LALAdaptiveRungeKuttaIntegrator *integrator2 = NULL;
-      REAL8Array *yout2;   // time series of variables returned from integrator 
+      REAL8Array *yout2;   // time series of variables returned from integrator, owned by it
       REAL8 yinit2[12];
 
       /* Put initial values into a single array for the integrator */
@@ -1077,30 +1079,39 @@ int IMRPhenomTPHM_EvolveOrbit(
       // Passed to actually performed backward integration. For t' in the integration, v(t) will be evaluated at t = tint1 - t'
       params.ToffSign = -tint1; 
 
-      /* Set up integrator */
-      integrator2 = XLALAdaptiveRungeKutta4Init(12,
+      /* Reset integrator for the second integration step */
+      if( XLALAdaptiveRungeKuttaReset(integrator, 12,
                 XLALSimIMRPhenomTPHMSpinDerivatives,
                 StoppingTest,
-                LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
+                LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE) != XLAL_SUCCESS )
+      {
+          XLALAdaptiveRungeKuttaFree(integrator);
+          LALFree(Tparams);
+          XLAL_ERROR(XLAL_EFUNC);
+      }
 
       /* Stop integration only when ending time is achieved */
-      integrator2->stopontestonly = 0;
+      integrator->stopontestonly = 0;
 
       /* Perform integration. Formally is done from dtM to tint1 = -tmin + tref, but physically is done from tref to tmin. */
-      len2 = XLALAdaptiveRungeKutta4Hermite(integrator2, &params, yinit2,
+      len2 = XLALAdaptiveRungeKutta4HermiteReuse(integrator, &params, yinit2,
              pWF->dtM, tint1, pWF->dtM, &yout2);
 
       /* Check if integration failed */
+      intreturn = integrator->returncode;
       if (!yout2)
       {
           XLALPrintError("XLAL Error - %s: integration failed (yout == NULL)\n",
                        __func__);
+          XLALAdaptiveRungeKuttaFree(integrator);
+          LALFree(Tparams);
           XLAL_ERROR(XLAL_EFUNC);
       }
-      intreturn = integrator->returncode;
       if (!len2) 
       {
           XLALPrintError("XLAL Error - %s: integration failed with errorcode %d.\n", __func__, intreturn);
+          XLALAdaptiveRungeKuttaFree(integrator);
+          LALFree(Tparams);
           XLAL_ERROR(XLAL_EFUNC);
       }
 
@@ -1124,11 +1135,11 @@ int IMRPhenomTPHM_EvolveOrbit(
           (*E1z)->data->data[j]     = yout2->data[12*len2+i];
       }
 
-      // Free integrator, PN coef struct and ouput array.
-      XLALAdaptiveRungeKuttaFree(integrator2);
-      XLALDestroyREAL8Array(yout2);
+      // Free PN coef struct.
       LALFree(Tparams);
     }
+
+    XLALAdaptiveRungeKuttaFree(integrator);
     
     // Free gsl spline objects
     gsl_spline_free(spline_v);
@@ -107,6 +107,8 @@ struct approximant v4PHM = {.name = "SEOBNRv4PHM", .number = 402};
 #define FREE_ALL                                                               \
   if (ICvalues != NULL)                                                        \
     XLALDestroyREAL8Vector(ICvalues);                                          \
+  if (integrator != NULL)                                                      \
+    XLALAdaptiveRungeKuttaFree(integrator);                                    \
   if (dynamicsAdaS != NULL)                                                    \
     XLALDestroyREAL8Array(dynamicsAdaS);                                       \
   if (seobdynamicsAdaS != NULL)                                                \
@@ -2059,6 +2061,8 @@ static int SEOBConvertSpinAlignedDynamicsToGenericSpins(
  */
 static int SEOBIntegrateDynamics(
     REAL8Array **dynamics, /**<< Output: pointer to array for the dynamics */
+    LALAdaptiveRungeKuttaIntegrator **integratorPtr, /**<< Input/Output: integrator,
+                      created if NULL and reset for this integration otherwise */
     UINT4 *retLenOut,      /**<< Output: length of the output dynamics */
     REAL8Vector *ICvalues, /**<< Input: vector with initial conditions */
     REAL8 EPS_ABS, /**<< Input: absolute accuracy for adaptive Runge-Kutta
@@ -2088,6 +2092,9 @@ static int SEOBIntegrateDynamics(
 
   /* Integrator */
   LALAdaptiveRungeKuttaIntegrator *integrator = NULL;
+  int (*dydt)(double t, const double y[], double dydt[], void *params) = NULL;
+  int (*stop)(double t, const double y[], double dydt[], void *params) = NULL;
+  UINT4 dim = 0;
 
   /* Flags */
   UINT4 SpinsAlmostAligned = seobParams->alignedSpins;
@@ -2146,31 +2153,31 @@ static int SEOBIntegrateDynamics(
      */
     if (tstart > 0) {
       // High sampling
-      integrator = XLALAdaptiveRungeKutta4Init(
-          nb_Hamiltonian_variables_spinsaligned, XLALSpinAlignedHcapDerivative,
-          XLALSpinPrecAlignedHiSRStopCondition, EPS_ABS, EPS_REL);
+      dim = nb_Hamiltonian_variables_spinsaligned;
+      dydt = XLALSpinAlignedHcapDerivative;
+      stop = XLALSpinPrecAlignedHiSRStopCondition;
     } else {
       // Low sampling
-      integrator = XLALAdaptiveRungeKutta4Init(
-          nb_Hamiltonian_variables_spinsaligned, XLALSpinAlignedHcapDerivative,
-          XLALEOBSpinPrecAlignedStopCondition, EPS_ABS, EPS_REL);
+      dim = nb_Hamiltonian_variables_spinsaligned;
+      dydt = XLALSpinAlignedHcapDerivative;
+      stop = XLALEOBSpinPrecAlignedStopCondition;
     }
   } else {
     if (flagHamiltonianDerivative ==
         FLAG_SEOBNRv4P_HAMILTONIAN_DERIVATIVE_ANALYTICAL) {
-      integrator = XLALAdaptiveRungeKutta4Init(
-          nb_Hamiltonian_variables, XLALSpinPrecHcapExactDerivative,
-          XLALEOBSpinPrecStopConditionBasedOnPR, EPS_ABS, EPS_REL);
+      dim = nb_Hamiltonian_variables;
+      dydt = XLALSpinPrecHcapExactDerivative;
+      stop = XLALEOBSpinPrecStopConditionBasedOnPR;
     } else if (flagHamiltonianDerivative ==
                FLAG_SEOBNRv4P_HAMILTONIAN_DERIVATIVE_NUMERICAL) {
       if (tstart > 0) {
-        integrator = XLALAdaptiveRungeKutta4Init(
-            nb_Hamiltonian_variables, XLALSpinPrecHcapNumericalDerivative,
-            XLALEOBSpinPrecStopConditionBasedOnPR, EPS_ABS, EPS_REL);
+        dim = nb_Hamiltonian_variables;
+        dydt = XLALSpinPrecHcapNumericalDerivative;
+        stop = XLALEOBSpinPrecStopConditionBasedOnPR;
       } else {
-        integrator = XLALAdaptiveRungeKutta4Init(
-            nb_Hamiltonian_variables, XLALSpinPrecHcapNumericalDerivative,
-            XLALEOBSpinPrecStopConditionBasedOnPR, EPS_ABS, EPS_REL);
+        dim = nb_Hamiltonian_variables;
+        dydt = XLALSpinPrecHcapNumericalDerivative;
+        stop = XLALEOBSpinPrecStopConditionBasedOnPR;
       }
 
     } else {
@@ -2180,6 +2187,16 @@ static int SEOBIntegrateDynamics(
       XLAL_ERROR(XLAL_EINVAL);
     }
   }
+  /* Reuse the integrator of a previous integration if there is one */
+  if (*integratorPtr == NULL)
+    *integratorPtr =
+        XLALAdaptiveRungeKutta4Init(dim, dydt, stop, EPS_ABS, EPS_REL);
+  else if (XLALAdaptiveRungeKuttaReset(*integratorPtr, dim, dydt, stop,
+                                       EPS_ABS, EPS_REL) != XLAL_SUCCESS) {
+    XLALAdaptiveRungeKuttaFree(*integratorPtr);
+    *integratorPtr = NULL;
+  }
+  integrator = *integratorPtr;
   if (!integrator) {
     XLALPrintError(
         "XLAL Error - %s: failure in the initialization of the integrator.\n",
@@ -2255,7 +2272,6 @@ static int SEOBIntegrateDynamics(
     XLALDestroyREAL8Array(dynamics_spinaligned);
   XLALDestroyREAL8Vector(values_spinaligned);
   XLALDestroyREAL8Vector(values);
-  XLALAdaptiveRungeKuttaFree(integrator);
 
   return XLAL_SUCCESS;
 }
@@ -4836,6 +4852,7 @@ int XLALSimIMRSpinPrecEOBWaveformAll(
 
   /* Cast, in order of appearance */
   REAL8Vector *ICvalues = NULL;
+  LALAdaptiveRungeKuttaIntegrator *integrator = NULL;
   REAL8Array *dynamicsAdaS = NULL;
   SEOBdynamics *seobdynamicsAdaS = NULL;
   REAL8Vector *seobvalues_tstartHiS = NULL;
@@ -5132,7 +5149,7 @@ int XLALSimIMRSpinPrecEOBWaveformAll(
   REAL8 tstartAdaS = 0.; /* t=0 will set at the starting time */
   /* Note: the timesampling step deltaT is used internally only to initialize
    * adaptive step */
-  if (SEOBIntegrateDynamics(&dynamicsAdaS, &retLenAdaS, ICvalues, EPS_ABS,
+  if (SEOBIntegrateDynamics(&dynamicsAdaS, &integrator, &retLenAdaS, ICvalues, EPS_ABS,
                             EPS_REL, deltaT, deltaT_min, tstartAdaS, tendAdaS,
                             &seobParams, flagConstantSampling,
                             flagHamiltonianDerivative) == XLAL_FAILURE) {
@@ -5219,7 +5236,7 @@ int XLALSimIMRSpinPrecEOBWaveformAll(
                                 integrator->stopontestonly */
   flagConstantSampling = 1;
   /* Note: here deltaT_min = 0. will simply be ignored, we use fixed steps */
-  if (SEOBIntegrateDynamics(&dynamicsHiS, &retLenHiS, ICvaluesHiS, EPS_ABS,
+  if (SEOBIntegrateDynamics(&dynamicsHiS, &integrator, &retLenHiS, ICvaluesHiS, EPS_ABS,
                             EPS_REL, deltaTHiS, 0., tstartHiS, tendHiS,
                             &seobParams, flagConstantSampling,
                             flagHamiltonianDerivative) == XLAL_FAILURE) {
@@ -5231,6 +5248,10 @@ int XLALSimIMRSpinPrecEOBWaveformAll(
     XLAL_ERROR(XLAL_EFUNC);
   }
 
+  /* Both integrations are done, the integrator is not needed any more */
+  XLALAdaptiveRungeKuttaFree(integrator);
+  integrator = NULL;
+
   /* Compute derived quantities for the high-sampling dynamics */
   if (SEOBComputeExtendedSEOBdynamics(&seobdynamicsHiS, dynamicsHiS, retLenHiS,
                                       &seobParams, flagHamiltonianDerivative,
@@ -33,6 +33,7 @@
 #include <lal/LALConstants.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALString.h>
+#include <lal/LALTrace.h>
 #include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
 #include <lal/FrequencySeries.h>
@@ -449,6 +450,8 @@ int XLALSimInspiralChooseTDWaveform(
      * otherwise do nothing */
     f_ref = fixReferenceFrequency(f_ref, f_min, approximant);
 
+    XLAL_TRACE_START(timer, "XLALSimInspiralChooseTDWaveform");
+
     switch (approximant)
     {
         /* non-spinning inspiral-only models */
@@ -1231,6 +1234,8 @@ int XLALSimInspiralChooseTDWaveform(
 
     if (ret == XLAL_FAILURE) XLAL_ERROR(XLAL_EFUNC);
 
+    XLAL_TRACE_STOP(timer, 2 * (*hplus)->data->length * sizeof(REAL8));
+
     return ret;
 }
 
@@ -1334,6 +1339,8 @@ int XLALSimInspiralChooseFDWaveform(
     cfac = cos(inclination);
     pfac = 0.5 * (1. + cfac*cfac);
 
+    XLAL_TRACE_START(timer, "XLALSimInspiralChooseFDWaveform");
+
     switch (approximant)
     {
         /* inspiral-only models */
@@ -2359,6 +2366,8 @@ int XLALSimInspiralChooseFDWaveform(
       ret = XLALSimLorentzInvarianceViolationTerm(hptilde, hctilde, m1/LAL_MSUN_SI, m2/LAL_MSUN_SI, distance, LALparams);
     if (ret == XLAL_FAILURE) XLAL_ERROR(XLAL_EFUNC);
 
+    XLAL_TRACE_STOP(timer, 2 * (*hptilde)->data->length * sizeof(COMPLEX16));
+
     return ret;
 }
 
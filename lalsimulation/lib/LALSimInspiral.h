@@ -207,6 +207,7 @@ extern "C" {
  * @defgroup LALSimInspiralWaveformFlags_c         Module LALSimInspiralWaveformFlags.c
  * @defgroup LALSimInspiralTestGRParams_c          Module LALSimInspiralTestGRParams.c
  * @defgroup LALSimInspiralWaveformTaper_c         Module LALSimInspiralWaveformTaper.c
+ * @defgroup LALSimInspiralMultiband_c            Module LALSimInspiralMultiband.c
  * @defgroup LALSimInspiralNRSur4d2s_c             Module LALSimInspiralNRSur4d2s.c
  * @defgroup LALSimIMRNRHybSur3dq8_c               Module LALSimIMRNRHybSur3dq8.c
  * @}
@@ -708,6 +709,14 @@ int XLALSimInspiralTaylorF2Core(COMPLEX16FrequencySeries **htilde, const REAL8Se
 
 int XLALSimInspiralTaylorF2(COMPLEX16FrequencySeries **htilde, const REAL8 phi_ref, const REAL8 deltaF, const REAL8 m1_SI, const REAL8 m2_SI, const REAL8 S1z, const REAL8 S2z, const REAL8 fStart, const REAL8 fEnd, const REAL8 f_ref, const REAL8 r, LALDict *LALpars);
 
+#ifndef SWIG /* exclude from SWIG interface */
+/** Incomplete type for the workspace of XLALSimInspiralTaylorF2CoreBatch() */
+typedef struct tagLALSimInspiralTaylorF2Workspace LALSimInspiralTaylorF2Workspace;
+LALSimInspiralTaylorF2Workspace *XLALCreateSimInspiralTaylorF2Workspace(const REAL8Sequence *freqs);
+void XLALDestroySimInspiralTaylorF2Workspace(LALSimInspiralTaylorF2Workspace *ws);
+int XLALSimInspiralTaylorF2CoreBatch(COMPLEX16 *const *htilde, const REAL8 *m1_SI, const REAL8 *m2_SI, const REAL8 *S1z, const REAL8 *S2z, const UINT4 ntemplates, const REAL8 phi_ref, const REAL8 f_ref, const REAL8 shft, const REAL8 r, LALDict *LALparams, LALSimInspiralTaylorF2Workspace *ws);
+#endif /* SWIG */
+
 /* TaylorF2Ecc functions */
 /* in module LALSimInspiralTaylorF2Ecc.c */
 int XLALSimInspiralTaylorF2CoreEcc(COMPLEX16FrequencySeries **htilde, const REAL8Sequence *freqs, const REAL8 phi_ref, const REAL8 m1_SI, const REAL8 m2_SI, const REAL8 f_ref, const REAL8 shft, const REAL8 r, const REAL8 eccentricity, LALDict *LALparams, PNPhasingSeries *pfaP);
@@ -875,6 +884,13 @@ int XLALSimNRSur4d2sFrequencySequence(COMPLEX16FrequencySeries **hptilde, COMPLE
 int XLALSimInspiralREAL4WaveTaper(REAL4Vector *signalvec, LALSimInspiralApplyTaper bookends);
 int XLALSimInspiralREAL8WaveTaper(REAL8Vector *signalvec, LALSimInspiralApplyTaper bookends);
 
+/* multibanded evaluation of frequency-domain waveforms */
+/* in module LALSimInspiralMultiband.c */
+
+REAL8Sequence *XLALSimInspiralMultibandFrequencies(REAL8 m1, REAL8 m2, REAL8 deltaF, REAL8 f_min, REAL8 f_max, REAL8 tolerance);
+int XLALSimInspiralInterpolateFDWaveform(COMPLEX16FrequencySeries *htilde, const COMPLEX16FrequencySeries *hcoarse, const REAL8Sequence *frequencies);
+int XLALSimInspiralChooseFDWaveformMultiband(COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde, REAL8 phiRef, REAL8 m1, REAL8 m2, REAL8 S1x, REAL8 S1y, REAL8 S1z, REAL8 S2x, REAL8 S2y, REAL8 S2z, REAL8 f_ref, REAL8 distance, REAL8 inclination, LALDict *LALpars, Approximant approximant, REAL8 deltaF, REAL8 f_min, REAL8 f_max, REAL8 tolerance);
+
 /* in module LALSimInspiralTEOBResumROM.c */
 
 int XLALSimInspiralTEOBResumROM(REAL8TimeSeries **hPlus, REAL8TimeSeries **hCross, REAL8 phiRef, REAL8 deltaT, REAL8 fLow, REAL8 fRef, REAL8 distance, REAL8 inclination, REAL8 m1SI, REAL8 m2SI, REAL8 lambda1, REAL8 lambda2);
@@ -0,0 +1,410 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+#include <math.h>
+#include <string.h>
+#include <complex.h>
+#include <lal/LALSimInspiral.h>
+#include <lal/LALConstants.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Sequence.h>
+#include <lal/VectorMath.h>
+#include <LALSimInspiralWaveformCache.h>
+
+/**
+ * @addtogroup LALSimInspiralMultiband_c
+ * @brief Routines to evaluate frequency-domain waveforms on a coarse,
+ * non-uniform frequency grid and interpolate them to a uniform one.
+ *
+ * Evaluating a frequency-domain approximant at every bin of a long segment
+ * is wasteful: the amplitude and phase of an inspiral vary slowly compared
+ * to the bin spacing except at high frequencies, where the signal spends
+ * little time.  XLALSimInspiralMultibandFrequencies() chooses a subset of
+ * the bins whose spacing grows with frequency, set by the leading-order
+ * chirp time
+ * \f[
+ * \tau(f) = \frac{5}{256} \mathcal{M}^{-5/3} (\pi f)^{-8/3}
+ * \f]
+ * so that linear interpolation of the phase, whose second derivative is
+ * \f$2\pi\,d\tau/df\f$, and of the amplitude, which falls as
+ * \f$f^{-7/6}\f$, is accurate to a given tolerance.  Any approximant
+ * supported by XLALSimInspiralChooseFDWaveformSequence() is evaluated at
+ * those bins and XLALSimInspiralInterpolateFDWaveform() fills in the rest,
+ * with the sines and cosines of the interpolated phase computed with
+ * XLALVectorSinCosREAL4(), which uses SIMD instructions where available.
+ * XLALSimInspiralChooseFDWaveformMultiband() does both.
+ *
+ * @{
+ */
+
+/* safety factor on the frequency at which the chirp time is evaluated, to
+ * allow for higher post-Newtonian orders, as in LALInference */
+#define MULTIBAND_SAFETY 1.1
+
+/* spacing of the coarse grid at frequency f */
+static REAL8 MultibandSpacing(REAL8 f, REAL8 Mc, REAL8 fisco, REAL8 tolerance)
+{
+    REAL8 fs, tau, dtaudf, dfphase, dfamp;
+
+    /* the merger and ringdown are resolved with the spacing at the ISCO */
+    if (f > fisco)
+        f = fisco;
+    fs = f / MULTIBAND_SAFETY;
+
+    /* the error of linear interpolation of the phase over df is at most
+     * (pi/4) |dtau/df| df^2 */
+    tau = 5. / 256. * pow(Mc, -5. / 3.) * pow(LAL_PI * fs, -8. / 3.);
+    dtaudf = 8. * tau / (3. * fs);
+    dfphase = sqrt(4. * tolerance / (LAL_PI * dtaudf));
+
+    /* and that of the relative amplitude (91/288) (df/f)^2 */
+    dfamp = f * sqrt(288. * tolerance / 91.);
+
+    return dfphase < dfamp ? dfphase : dfamp;
+}
+
+/**
+ * Return the frequencies, all integer multiples of \c deltaF between
+ * \c f_min and \c f_max, at which to evaluate a frequency-domain waveform
+ * of a binary with component masses \c m1 and \c m2 (kg) so that
+ * XLALSimInspiralInterpolateFDWaveform() reproduces it to within about
+ * \c tolerance in relative amplitude and in phase (rad).
+ *
+ * The spacing is set by the Newtonian chirp time and is held fixed above
+ * the Schwarzschild ISCO frequency; it at most doubles from one interval
+ * to the next and the first interval is a single bin, as required to
+ * unwrap the phase.  \c tolerance must not exceed 0.1.
+ */
+REAL8Sequence *XLALSimInspiralMultibandFrequencies(
+    REAL8 m1,                   /**< mass of companion 1 (kg) */
+    REAL8 m2,                   /**< mass of companion 2 (kg) */
+    REAL8 deltaF,               /**< frequency resolution of the fine grid (Hz) */
+    REAL8 f_min,                /**< starting GW frequency (Hz) */
+    REAL8 f_max,                /**< ending GW frequency (Hz) */
+    REAL8 tolerance             /**< interpolation error tolerance */
+)
+{
+    REAL8Sequence *frequencies;
+    REAL8 M, Mc, fisco;
+    UINT4 kmin, kmax, k, step, n;
+
+    XLAL_CHECK_NULL(m1 > 0 && m2 > 0, XLAL_EDOM, "Masses must be positive");
+    XLAL_CHECK_NULL(deltaF > 0, XLAL_EDOM, "deltaF must be positive");
+    XLAL_CHECK_NULL(f_min > 0 && f_max > f_min, XLAL_EDOM, "Invalid frequency range [%g, %g]", f_min, f_max);
+    XLAL_CHECK_NULL(tolerance > 0 && tolerance <= 0.1, XLAL_EDOM, "Tolerance %g must be in (0, 0.1]", tolerance);
+
+    kmin = ceil(f_min / deltaF);
+    kmax = floor(f_max / deltaF);
+    XLAL_CHECK_NULL(kmax > kmin, XLAL_EDOM, "Frequency range [%g, %g] is shorter than deltaF = %g", f_min, f_max, deltaF);
+
+    M = (m1 + m2) / LAL_MSUN_SI * LAL_MTSUN_SI;
+    Mc = pow(m1 * m2, 3. / 5.) * pow(m1 + m2, -1. / 5.) / LAL_MSUN_SI * LAL_MTSUN_SI;
+    fisco = 1. / (pow(6., 1.5) * LAL_PI * M);
+
+    /* there are at most as many points as bins */
+    frequencies = XLALCreateREAL8Sequence(kmax - kmin + 1);
+    XLAL_CHECK_NULL(frequencies, XLAL_EFUNC);
+
+    k = kmin;
+    step = 1;
+    n = 0;
+    frequencies->data[n++] = k * deltaF;
+    frequencies->data[n++] = ++k * deltaF;
+    while (k < kmax) {
+        UINT4 s = floor(MultibandSpacing(k * deltaF, Mc, fisco, tolerance) / deltaF);
+        if (s < 1)
+            s = 1;
+        if (s > 2 * step)
+            s = 2 * step;
+        step = s;
+        k = k + s < kmax ? k + s : kmax;
+        frequencies->data[n++] = k * deltaF;
+    }
+
+    if (!XLALShrinkREAL8Sequence(frequencies, 0, n)) {
+        XLALDestroyREAL8Sequence(frequencies);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    return frequencies;
+}
+
+/* interpolate the non-zero intervals of hc, given at the bins bin[0..n-1],
+ * into h; the interior of intervals with a zero end point is left
+ * untouched */
+static int MultibandInterpolate(COMPLEX16 *h, const COMPLEX16 *hc, const UINT4 *bin, UINT4 n)
+{
+    const UINT4 span = bin[n - 1] - bin[0];
+    REAL4VectorAligned *theta, *s, *c;
+    REAL8 slope = 0.;
+    int haveslope = 0;
+    UINT4 i, j;
+
+    theta = XLALCreateREAL4VectorAligned(span, 32);
+    s = XLALCreateREAL4VectorAligned(span, 32);
+    c = XLALCreateREAL4VectorAligned(span, 32);
+    if (!theta || !s || !c) {
+        XLALDestroyREAL4VectorAligned(theta);
+        XLALDestroyREAL4VectorAligned(s);
+        XLALDestroyREAL4VectorAligned(c);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+    memset(theta->data, 0, span * sizeof(*theta->data));
+
+    /* phase increments from the start of each interval; the phase change
+     * over an interval is only known modulo 2 pi, so take the branch
+     * closest to the slope of the previous interval (or of the preceding
+     * bin if it has already been filled in).  A slope ambiguous by 2 pi
+     * per bin is harmless, as all intervals span whole bins. */
+    for (j = 0; j + 1 < n; ++j) {
+        const UINT4 nbins = bin[j + 1] - bin[j];
+        REAL8 dphi;
+        if (hc[j] == 0. || hc[j + 1] == 0.) {
+            haveslope = 0;
+            continue;
+        }
+        dphi = carg(hc[j + 1] * conj(hc[j]));
+        if (!haveslope && bin[j] > 0 && h[bin[j] - 1] != 0.) {
+            slope = carg(hc[j] * conj(h[bin[j] - 1]));
+            haveslope = 1;
+        }
+        if (haveslope)
+            dphi += LAL_TWOPI * round((slope * nbins - dphi) / LAL_TWOPI);
+        slope = dphi / nbins;
+        haveslope = 1;
+        /* reduce in double precision before handing over to REAL4 */
+        for (i = 0; i < nbins; ++i) {
+            REAL8 phi = slope * i;
+            theta->data[bin[j] - bin[0] + i] = phi - LAL_TWOPI * round(phi / LAL_TWOPI);
+        }
+    }
+
+    if (XLALVectorSinCosREAL4(s->data, c->data, theta->data, span) != XLAL_SUCCESS) {
+        XLALDestroyREAL4VectorAligned(theta);
+        XLALDestroyREAL4VectorAligned(s);
+        XLALDestroyREAL4VectorAligned(c);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    /* linear interpolation of the amplitude, rotated from the phase at the
+     * start of each interval */
+    for (j = 0; j + 1 < n; ++j) {
+        const UINT4 nbins = bin[j + 1] - bin[j];
+        REAL8 a0, a1;
+        COMPLEX16 u;
+        if (hc[j] == 0. || hc[j + 1] == 0.) {
+            h[bin[j]] = hc[j];
+            continue;
+        }
+        a0 = cabs(hc[j]);
+        a1 = cabs(hc[j + 1]);
+        u = hc[j] / a0;
+        for (i = 0; i < nbins; ++i) {
+            const UINT4 l = bin[j] - bin[0] + i;
+            const REAL8 x = (REAL8) i / nbins;
+            h[bin[j] + i] = ((1. - x) * a0 + x * a1) * u * crect(c->data[l], s->data[l]);
+        }
+    }
+    h[bin[n - 1]] = hc[n - 1];
+
+    XLALDestroyREAL4VectorAligned(theta);
+    XLALDestroyREAL4VectorAligned(s);
+    XLALDestroyREAL4VectorAligned(c);
+    return XLAL_SUCCESS;
+}
+
+/* bins of the fine grid corresponding to the given frequencies */
+static UINT4 *MultibandBins(const COMPLEX16FrequencySeries *htilde, const REAL8Sequence *frequencies)
+{
+    UINT4 *bin;
+    UINT4 j;
+
+    bin = LALMalloc(frequencies->length * sizeof(*bin));
+    XLAL_CHECK_NULL(bin, XLAL_ENOMEM);
+    for (j = 0; j < frequencies->length; ++j) {
+        const REAL8 k = round((frequencies->data[j] - htilde->f0) / htilde->deltaF);
+        if (k < 0 || k >= htilde->data->length || fabs(frequencies->data[j] - htilde->f0 - k * htilde->deltaF) > 1e-6 * htilde->deltaF || (j > 0 && k <= bin[j - 1])) {
+            LALFree(bin);
+            XLAL_ERROR_NULL(XLAL_EINVAL, "Frequency %g is not on the grid of the output, or frequencies are not increasing", frequencies->data[j]);
+        }
+        bin[j] = k;
+    }
+    return bin;
+}
+
+/**
+ * Interpolate a frequency-domain waveform \c hcoarse, given at the
+ * increasing \c frequencies, to the bins of \c htilde.  Every frequency
+ * must be a bin of \c htilde.
+ *
+ * The amplitude is interpolated linearly and so is the phase, which is
+ * unwrapped by continuing the slope of the previous interval; the first
+ * interval, and the first after any zero sample, should therefore span a
+ * single bin, as do those returned by
+ * XLALSimInspiralMultibandFrequencies().  The interior of intervals with
+ * a zero end point, and bins outside the frequencies, are set to zero.
+ */
+int XLALSimInspiralInterpolateFDWaveform(
+    COMPLEX16FrequencySeries *htilde,           /**< output waveform on the fine grid */
+    const COMPLEX16FrequencySeries *hcoarse,    /**< waveform at the coarse frequencies */
+    const REAL8Sequence *frequencies            /**< coarse frequencies (Hz) */
+)
+{
+    UINT4 *bin;
+    int ret;
+
+    XLAL_CHECK(htilde && hcoarse && frequencies, XLAL_EFAULT);
+    XLAL_CHECK(htilde->deltaF > 0, XLAL_EINVAL, "deltaF must be positive");
+    XLAL_CHECK(hcoarse->data->length == frequencies->length, XLAL_EBADLEN, "Waveform length %u does not match number of frequencies %u", hcoarse->data->length, frequencies->length);
+    XLAL_CHECK(frequencies->length > 1, XLAL_EBADLEN, "At least two frequencies are required");
+
+    bin = MultibandBins(htilde, frequencies);
+    XLAL_CHECK(bin, XLAL_EFUNC);
+    memset(htilde->data->data, 0, htilde->data->length * sizeof(*htilde->data->data));
+    ret = MultibandInterpolate(htilde->data->data, hcoarse->data->data, bin, frequencies->length);
+    LALFree(bin);
+    XLAL_CHECK(ret == XLAL_SUCCESS, XLAL_EFUNC);
+
+    return XLAL_SUCCESS;
+}
+
+/* whether only one end point of interval j is zero */
+static int MultibandIntervalIsCut(const COMPLEX16 *hc, UINT4 j)
+{
+    return (hc[j] == 0.) != (hc[j + 1] == 0.);
+}
+
+/**
+ * Compute the plus and cross polarizations of a frequency-domain waveform
+ * at the bins of spacing \c deltaF between \c f_min and \c f_max by
+ * evaluating it at the frequencies given by
+ * XLALSimInspiralMultibandFrequencies() and interpolating with
+ * XLALSimInspiralInterpolateFDWaveform().  The waveform is generated by
+ * XLALSimInspiralChooseFDWaveformSequence(), so any approximant it supports
+ * may be used; the arguments have the same meaning.
+ *
+ * The outputs start at zero frequency and end at \c f_max, and are zero
+ * below \c f_min.  Where the waveform switches on or off between two
+ * coarse frequencies (e.g. at the cutoff of an inspiral-only approximant)
+ * it is evaluated at every bin in between.
+ */
+int XLALSimInspiralChooseFDWaveformMultiband(
+    COMPLEX16FrequencySeries **hptilde,     /**< FD plus polarization */
+    COMPLEX16FrequencySeries **hctilde,     /**< FD cross polarization */
+    REAL8 phiRef,                           /**< reference orbital phase (rad) */
+    REAL8 m1,                               /**< mass of companion 1 (kg) */
+    REAL8 m2,                               /**< mass of companion 2 (kg) */
+    REAL8 S1x,                              /**< x-component of the dimensionless spin of object 1 */
+    REAL8 S1y,                              /**< y-component of the dimensionless spin of object 1 */
+    REAL8 S1z,                              /**< z-component of the dimensionless spin of object 1 */
+    REAL8 S2x,                              /**< x-component of the dimensionless spin of object 2 */
+    REAL8 S2y,                              /**< y-component of the dimensionless spin of object 2 */
+    REAL8 S2z,                              /**< z-component of the dimensionless spin of object 2 */
+    REAL8 f_ref,                            /**< Reference frequency (Hz) */
+    REAL8 distance,                         /**< distance of source (m) */
+    REAL8 inclination,                      /**< inclination of source (rad) */
+    LALDict *LALpars,                       /**< LALDictionary containing non-mandatory variables/flags */
+    Approximant approximant,                /**< post-Newtonian approximant to use for waveform production */
+    REAL8 deltaF,                           /**< sampling interval (Hz) */
+    REAL8 f_min,                            /**< starting GW frequency (Hz) */
+    REAL8 f_max,                            /**< ending GW frequency (Hz) */
+    REAL8 tolerance                         /**< interpolation error tolerance */
+)
+{
+    REAL8Sequence *frequencies = NULL;
+    REAL8Sequence *fine = NULL;
+    COMPLEX16FrequencySeries *hpc = NULL, *hcc = NULL;
+    COMPLEX16FrequencySeries *hpf = NULL, *hcf = NULL;
+    UINT4 *bin = NULL;
+    UINT4 i, j, l, n, nfine;
+
+    XLAL_CHECK(hptilde && hctilde, XLAL_EFAULT);
+    XLAL_CHECK(*hptilde == NULL && *hctilde == NULL, XLAL_EFAULT);
+
+    frequencies = XLALSimInspiralMultibandFrequencies(m1, m2, deltaF, f_min, f_max, tolerance);
+    if (!frequencies)
+        goto error;
+    n = frequencies->length;
+    if (XLALSimInspiralChooseFDWaveformSequence(&hpc, &hcc, phiRef, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref, distance, inclination, LALpars, approximant, frequencies) < 0)
+        goto error;
+
+    *hptilde = XLALCreateCOMPLEX16FrequencySeries(hpc->name, &hpc->epoch, 0., deltaF, &hpc->sampleUnits, (size_t) floor(f_max / deltaF) + 1);
+    *hctilde = XLALCreateCOMPLEX16FrequencySeries(hcc->name, &hcc->epoch, 0., deltaF, &hcc->sampleUnits, (size_t) floor(f_max / deltaF) + 1);
+    if (!*hptilde || !*hctilde)
+        goto error;
+    memset((*hptilde)->data->data, 0, (*hptilde)->data->length * sizeof(*(*hptilde)->data->data));
+    memset((*hctilde)->data->data, 0, (*hctilde)->data->length * sizeof(*(*hctilde)->data->data));
+    bin = MultibandBins(*hptilde, frequencies);
+    if (!bin)
+        goto error;
+
+    /* evaluate the waveform at every bin of intervals where it switches on
+     * or off; the first coarse frequency is kept as the first frequency of
+     * the sequence, so that the reference frequency keeps its meaning */
+    nfine = 0;
+    for (j = 0; j + 1 < n; ++j)
+        if (MultibandIntervalIsCut(hpc->data->data, j) || MultibandIntervalIsCut(hcc->data->data, j))
+            nfine += bin[j + 1] - bin[j] - 1;
+    if (nfine > 0) {
+        fine = XLALCreateREAL8Sequence(nfine + 1);
+        if (!fine)
+            goto error;
+        fine->data[0] = frequencies->data[0];
+        l = 1;
+        for (j = 0; j + 1 < n; ++j)
+            if (MultibandIntervalIsCut(hpc->data->data, j) || MultibandIntervalIsCut(hcc->data->data, j))
+                for (i = bin[j] + 1; i < bin[j + 1]; ++i)
+                    fine->data[l++] = i * deltaF;
+        if (XLALSimInspiralChooseFDWaveformSequence(&hpf, &hcf, phiRef, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref, distance, inclination, LALpars, approximant, fine) < 0)
+            goto error;
+        l = 1;
+        for (j = 0; j + 1 < n; ++j)
+            if (MultibandIntervalIsCut(hpc->data->data, j) || MultibandIntervalIsCut(hcc->data->data, j))
+                for (i = bin[j] + 1; i < bin[j + 1]; ++i, ++l) {
+                    (*hptilde)->data->data[i] = hpf->data->data[l];
+                    (*hctilde)->data->data[i] = hcf->data->data[l];
+                }
+    }
+
+    if (MultibandInterpolate((*hptilde)->data->data, hpc->data->data, bin, n) != XLAL_SUCCESS)
+        goto error;
+    if (MultibandInterpolate((*hctilde)->data->data, hcc->data->data, bin, n) != XLAL_SUCCESS)
+        goto error;
+
+    LALFree(bin);
+    XLALDestroyREAL8Sequence(frequencies);
+    XLALDestroyREAL8Sequence(fine);
+    XLALDestroyCOMPLEX16FrequencySeries(hpc);
+    XLALDestroyCOMPLEX16FrequencySeries(hcc);
+    XLALDestroyCOMPLEX16FrequencySeries(hpf);
+    XLALDestroyCOMPLEX16FrequencySeries(hcf);
+    return XLAL_SUCCESS;
+
+error:
+    LALFree(bin);
+    XLALDestroyREAL8Sequence(frequencies);
+    XLALDestroyREAL8Sequence(fine);
+    XLALDestroyCOMPLEX16FrequencySeries(hpc);
+    XLALDestroyCOMPLEX16FrequencySeries(hcc);
+    XLALDestroyCOMPLEX16FrequencySeries(hpf);
+    XLALDestroyCOMPLEX16FrequencySeries(hcf);
+    XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
+    XLALDestroyCOMPLEX16FrequencySeries(*hctilde);
+    *hptilde = *hctilde = NULL;
+    XLAL_ERROR(XLAL_EFUNC);
+}
+
+/** @} */
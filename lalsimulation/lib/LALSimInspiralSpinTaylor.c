@@ -97,12 +97,27 @@ static int XLALSimInspiralSpinTaylorT1DerivativesAvg(double t,
 static int XLALSimInspiralSpinTaylorT5DerivativesAvg(double t,
 	const double values[], double dvalues[], void *mparams);
 static int XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(
-    REAL8Array **yout, REAL8 m1, REAL8 m2, REAL8 fStart, REAL8 fEnd, REAL8 s1x,
+    REAL8Array **yout, LALAdaptiveRungeKuttaIntegrator **integratorPtr,
+    REAL8 m1, REAL8 m2, REAL8 fStart, REAL8 fEnd, REAL8 s1x,
     REAL8 s1y, REAL8 s1z, REAL8 s2x, REAL8 s2y, REAL8 s2z, REAL8 lnhatx,
     REAL8 lnhaty, REAL8 lnhatz, REAL8 e1x, REAL8 e1y, REAL8 e1z, REAL8 lambda1,
     REAL8 lambda2, REAL8 quadparam1, REAL8 quadparam2,
     LALSimInspiralSpinOrder spinO, LALSimInspiralTidalOrder tideO, INT4 phaseO,
     Approximant approx);
+static int XLALSimInspiralSpinTaylorPNEvolveOrbitWithIntegrator(
+    REAL8TimeSeries **V, REAL8TimeSeries **Phi, REAL8TimeSeries **S1x,
+    REAL8TimeSeries **S1y, REAL8TimeSeries **S1z, REAL8TimeSeries **S2x,
+    REAL8TimeSeries **S2y, REAL8TimeSeries **S2z, REAL8TimeSeries **LNhatx,
+    REAL8TimeSeries **LNhaty, REAL8TimeSeries **LNhatz, REAL8TimeSeries **E1x,
+    REAL8TimeSeries **E1y, REAL8TimeSeries **E1z, const REAL8 deltaT,
+    const REAL8 m1_SI, const REAL8 m2_SI, const REAL8 fStart, const REAL8 fEnd,
+    const REAL8 s1x, const REAL8 s1y, const REAL8 s1z, const REAL8 s2x,
+    const REAL8 s2y, const REAL8 s2z, const REAL8 lnhatx, const REAL8 lnhaty,
+    const REAL8 lnhatz, const REAL8 e1x, const REAL8 e1y, const REAL8 e1z,
+    const REAL8 lambda1, const REAL8 lambda2, const REAL8 quadparam1,
+    const REAL8 quadparam2, const LALSimInspiralSpinOrder spinO,
+    const LALSimInspiralTidalOrder tideO, const INT4 phaseO, const INT4 lscorr,
+    const Approximant approx, LALAdaptiveRungeKuttaIntegrator **integratorPtr);
 static int XLALSimInspiralSpinTaylorDriverFourier(
     COMPLEX16FrequencySeries **hplus, COMPLEX16FrequencySeries **hcross,
     REAL8 fMin, REAL8 fMax, REAL8 deltaF, INT4 kMax, REAL8 phiRef, REAL8 v0,
@@ -1511,7 +1526,7 @@ static int XLALSimInspiralSpinTaylorDriverFourier(
         fS = fStart;
         fE = 0.;
         /* Evolve the dynamical variables */
-        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&y,
+        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&y, NULL,
                 m1, m2, fS, fE, s1x, s1y, s1z, s2x, s2y, s2z,
                 lnhatx, lnhaty, lnhatz, e1x, e1y, e1z, lambda1, lambda2,
                 quadparam1, quadparam2, spinO, tideO, phaseO, approx);
@@ -1532,7 +1547,7 @@ static int XLALSimInspiralSpinTaylorDriverFourier(
         fS = fStart;
         fE = 0.;
         /* Evolve the dynamical variables */
-        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&y,
+        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&y, NULL,
                 m1, m2, fS, fE, s1x, s1y, s1z, s2x, s2y, s2z,
                 lnhatx, lnhaty, lnhatz, e1x, e1y, e1z, lambda1, lambda2,
                 quadparam1, quadparam2, spinO, tideO, phaseO, approx);
@@ -1550,11 +1565,12 @@ static int XLALSimInspiralSpinTaylorDriverFourier(
     else /* Start in middle, integrate backward and forward, stitch together */
     {
         REAL8Array *yStart=NULL, *yEnd=NULL;
+        LALAdaptiveRungeKuttaIntegrator *integrator=NULL;
 
         /* Integrate backward to fStart */
         fS = fRef;
         fE = fStart;
-        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&yStart,
+        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&yStart, &integrator,
                 m1, m2, fS, fE, s1x, s1y, s1z, s2x, s2y,
                 s2z, lnhatx, lnhaty, lnhatz, e1x, e1y, e1z, lambda1, lambda2,
                 quadparam1, quadparam2, spinO, tideO, phaseO, approx);
@@ -1570,10 +1586,11 @@ static int XLALSimInspiralSpinTaylorDriverFourier(
         /* Integrate forward to end of waveform */
         fS = fRef;
         fE = 0.;
-        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&yEnd,
+        n = XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(&yEnd, &integrator,
                 m1, m2, fS, fE, s1x, s1y, s1z, s2x, s2y,
                 s2z, lnhatx, lnhaty, lnhatz, e1x, e1y, e1z, lambda1, lambda2,
                 quadparam1, quadparam2, spinO, tideO, phaseO, approx);
+        XLALAdaptiveRungeKuttaFree(integrator);
 
         /* Apply phase shift so orbital phase has desired value at fRef */
         iRefPhi = ((yEnd->dimLength->data[1])<<1)-1;
@@ -3256,18 +3273,20 @@ int XLALSimInspiralSpinTaylorDriver(
         REAL8TimeSeries *LNhatx1=NULL, *LNhaty1=NULL, *LNhatz1=NULL, *E1x1=NULL, *E1y1=NULL, *E1z1=NULL;
         REAL8TimeSeries *V2=NULL, *Phi2=NULL, *S1x2=NULL, *S1y2=NULL, *S1z2=NULL, *S2x2=NULL, *S2y2=NULL, *S2z2=NULL;
         REAL8TimeSeries *LNhatx2=NULL, *LNhaty2=NULL, *LNhatz2=NULL, *E1x2=NULL, *E1y2=NULL, *E1z2=NULL;
+        LALAdaptiveRungeKuttaIntegrator *integrator=NULL;
 
         /* Integrate backward to fStart */
         fS = fRef;
         fE = fStart;
-        n = XLALSimInspiralSpinTaylorPNEvolveOrbit(&V1, &Phi1,
+        n = XLALSimInspiralSpinTaylorPNEvolveOrbitWithIntegrator(&V1, &Phi1,
                 &S1x1, &S1y1, &S1z1, &S2x1, &S2y1, &S2z1,
                 &LNhatx1, &LNhaty1, &LNhatz1, &E1x1, &E1y1, &E1z1,
                 deltaT, m1_SI, m2_SI, fS, fE, s1x, s1y, s1z, s2x, s2y,
                 s2z, lnhatx, lnhaty, lnhatz, e1xphi, e1yphi, e1zphi, lambda1, lambda2,
-	        quadparam1, quadparam2, spinO, tideO, phaseO, lscorr, approx);
+	        quadparam1, quadparam2, spinO, tideO, phaseO, lscorr, approx, &integrator);
         if( n < 0 )
         {
+            XLALAdaptiveRungeKuttaFree(integrator);
             XLAL_ERROR(XLAL_EFUNC);
         }
 
@@ -3282,12 +3301,13 @@ int XLALSimInspiralSpinTaylorDriver(
         /* Integrate forward to end of waveform */
         fS = fRef;
         fE = XLALSimInspiralWaveformParamsLookupFinalFreq(LALparams);
-        n = XLALSimInspiralSpinTaylorPNEvolveOrbit(&V2, &Phi2,
+        n = XLALSimInspiralSpinTaylorPNEvolveOrbitWithIntegrator(&V2, &Phi2,
                 &S1x2, &S1y2, &S1z2, &S2x2, &S2y2, &S2z2,
                 &LNhatx2, &LNhaty2, &LNhatz2, &E1x2, &E1y2, &E1z2,
                 deltaT, m1_SI, m2_SI, fS, fE, s1x, s1y, s1z, s2x, s2y,
                 s2z, lnhatx, lnhaty, lnhatz, e1xphi, e1yphi, e1zphi, lambda1, lambda2,
-		quadparam1, quadparam2, spinO, tideO, phaseO, lscorr, approx);
+		quadparam1, quadparam2, spinO, tideO, phaseO, lscorr, approx, &integrator);
+        XLALAdaptiveRungeKuttaFree(integrator);
         if( n < 0 )
         {
             XLAL_ERROR(XLAL_EFUNC);
@@ -3544,6 +3564,54 @@ INT4 XLALSimInspiralSpinTaylorHlmModes(SphHarmTimeSeries **hlm,  /**< OUTPUT */
 
 }
 
+/**
+ * Create an integrator for the orbit-averaged equations of approximant
+ * approx, or, if *integrator already exists, reset it for them so that its
+ * GSL workspace and output array are reused.
+ */
+static int XLALSimInspiralSpinTaylorIntegratorInitOrReset(
+        LALAdaptiveRungeKuttaIntegrator **integrator, /**< integrator [created or reset] */
+        Approximant approx              /**< PN approximant (SpinTaylorT1/T5/T4) */
+        )
+{
+    int (*dydt)(double t, const double values[], double dvalues[], void *mparams);
+
+    if( approx == SpinTaylorT4 )
+        dydt = XLALSimInspiralSpinTaylorT4DerivativesAvg;
+    else if( approx == SpinTaylorT5 )
+        dydt = XLALSimInspiralSpinTaylorT5DerivativesAvg;
+    else if( approx == SpinTaylorT1 )
+        dydt = XLALSimInspiralSpinTaylorT1DerivativesAvg;
+    else
+    {
+        XLALPrintError("XLAL Error - %s: Approximant must be one of SpinTaylorT1, SpinTaylorT5, SpinTaylorT4, but %i provided\n",
+                __func__, approx);
+        XLAL_ERROR(XLAL_EINVAL);
+    }
+
+    if( *integrator )
+    {
+        if( XLALAdaptiveRungeKuttaReset(*integrator, LAL_NUM_ST4_VARIABLES,
+                dydt, XLALSimInspiralSpinTaylorStoppingTest,
+                LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE) != XLAL_SUCCESS )
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+    else
+    {
+        *integrator = XLALAdaptiveRungeKutta4Init(LAL_NUM_ST4_VARIABLES,
+                dydt, XLALSimInspiralSpinTaylorStoppingTest,
+                LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
+        if( !*integrator )
+        {
+            XLALPrintError("XLAL Error - %s: Cannot allocate integrator\n",
+                    __func__);
+            XLAL_ERROR(XLAL_EFUNC);
+        }
+    }
+
+    return XLAL_SUCCESS;
+}
+
 /**
  * This function evolves the orbital equations for a precessing binary using
  * the \"TaylorT5/T4\" approximant for solving the orbital dynamics
@@ -3572,6 +3640,7 @@ INT4 XLALSimInspiralSpinTaylorHlmModes(SphHarmTimeSeries **hlm,  /**< OUTPUT */
  */
 static int XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(
         REAL8Array **yout,              /**< array holding the unevenly sampled output [returned] */
+        LALAdaptiveRungeKuttaIntegrator **integratorPtr, /**< integrator to reuse, created if NULL and kept for the caller to free, or NULL to use a private one */
         REAL8 m1,                       /**< mass of companion 1 (kg) */
         REAL8 m2,                       /**< mass of companion 2 (kg) */
         REAL8 fStart,                   /**< starting GW frequency */
@@ -3701,35 +3770,16 @@ static int XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(
     yinit[12] = e1y;
     yinit[13] = e1z;
 
-    /* initialize the integrator */
-    if( approx == SpinTaylorT4 )
-        integrator = XLALAdaptiveRungeKutta4Init(LAL_NUM_ST4_VARIABLES,
-                XLALSimInspiralSpinTaylorT4DerivativesAvg,
-                XLALSimInspiralSpinTaylorStoppingTest,
-                LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
-    else if( approx == SpinTaylorT5 )
-        integrator = XLALAdaptiveRungeKutta4Init(LAL_NUM_ST4_VARIABLES,
-                XLALSimInspiralSpinTaylorT5DerivativesAvg,
-                XLALSimInspiralSpinTaylorStoppingTest,
-                LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
-    else if( approx == SpinTaylorT1 )
-        integrator = XLALAdaptiveRungeKutta4Init(LAL_NUM_ST4_VARIABLES,
-                XLALSimInspiralSpinTaylorT1DerivativesAvg,
-                XLALSimInspiralSpinTaylorStoppingTest,
-                LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
-    else
+    /* initialize the integrator, or reset the one passed in */
+    integrator = integratorPtr ? *integratorPtr : NULL;
+    if( XLALSimInspiralSpinTaylorIntegratorInitOrReset(&integrator, approx) != XLAL_SUCCESS )
     {
-        XLALPrintError("XLAL Error - %s: Approximant must be one of SpinTaylorT1, SpinTaylorT5, SpinTaylorT4, but %i provided\n",
-                __func__, approx);
-        XLAL_ERROR(XLAL_EINVAL);
-
-    }
-    if( !integrator )
-    {
-        XLALPrintError("XLAL Error - %s: Cannot allocate integrator\n",
-                __func__);
+        if( !integratorPtr )
+            XLALAdaptiveRungeKuttaFree(integrator);
         XLAL_ERROR(XLAL_EFUNC);
     }
+    if( integratorPtr )
+        *integratorPtr = integrator;
 
     /* stop the integration only when the test is true */
     integrator->stopontestonly = 1;
@@ -3739,7 +3789,8 @@ static int XLALSimInspiralSpinTaylorPNEvolveOrbitIrregularIntervals(
             0.0, lengths/Msec, &y);
 
     intreturn = integrator->returncode;
-    XLALAdaptiveRungeKuttaFree(integrator);
+    if( !integratorPtr )
+        XLALAdaptiveRungeKuttaFree(integrator);
 
     if (!len)
     {
@@ -4232,33 +4283,10 @@ int XLALSimInspiralInitialConditionsPrecessingApproxs(
   return XLAL_SUCCESS;
 } // End of XLALSimInspiralInitialConditionsPrecessingApproxs()
 
-/**
- * This function evolves the orbital equations for a precessing binary using
- * the \"TaylorT1/T5/T4\" approximant for solving the orbital dynamics
- * (see arXiv:0907.0700 for a review of the various PN approximants).
- *
- * It returns time series of the \"orbital velocity\", orbital phase,
- * and components for both individual spin vectors, the \"Newtonian\"
- * orbital angular momentum (which defines the instantaneous plane)
- * and "E1", a basis vector in the instantaneous orbital plane.
- * Note that LNhat and E1 completely specify the instantaneous orbital plane.
- * It also returns the time and phase of the final time step
- *
- * For input, the function takes the two masses, the initial orbital phase,
- * Values of S1, S2, LNhat, E1 vectors at starting time,
- * the desired time step size, the starting GW frequency,
- * and PN order at which to evolve the phase,
- *
- * NOTE: All vectors are given in the frame
- * where the z-axis is set by the angular momentum at reference frequency,
- * the x-axis is chosen orthogonal to it, and the y-axis is given by the RH rule.
- * Initial values must be passed in this frame, and the time series of the
- * vector components will also be returned in this frame.
- *
- * Review completed on git hash ...
- *
- */
-int XLALSimInspiralSpinTaylorPNEvolveOrbit(
+/* Implementation of XLALSimInspiralSpinTaylorPNEvolveOrbit(); if integratorPtr
+ * is not NULL, the integrator it holds is reset and reused, or created and
+ * kept for the caller to free */
+static int XLALSimInspiralSpinTaylorPNEvolveOrbitWithIntegrator(
 	REAL8TimeSeries **V,            /**< post-Newtonian parameter [returned]*/
 	REAL8TimeSeries **Phi,          /**< orbital phase            [returned]*/
 	REAL8TimeSeries **S1x,	        /**< Spin1 vector x component [returned]*/
@@ -4298,7 +4326,8 @@ int XLALSimInspiralSpinTaylorPNEvolveOrbit(
 	const LALSimInspiralTidalOrder tideO, /**< twice PN order of tidal effects */
 	const INT4 phaseO,                    /**< twice post-Newtonian order */
 	const INT4 lscorr,                    /**< flag to control L_S terms */
-	const Approximant approx              /**< PN approximant (SpinTaylorT1/T5/T4) */
+	const Approximant approx,             /**< PN approximant (SpinTaylorT1/T5/T4) */
+	LALAdaptiveRungeKuttaIntegrator **integratorPtr /**< integrator to reuse, created if NULL and kept for the caller to free, or NULL to use a private one */
 	)
 {
     INT4 intreturn;
@@ -4420,56 +4449,42 @@ int XLALSimInspiralSpinTaylorPNEvolveOrbit(
     yinit[12] = e1y;
     yinit[13] = e1z;
 
-    /* initialize the integrator */
-    if( approx == SpinTaylorT4 )
-      integrator = XLALAdaptiveRungeKutta4Init(LAL_NUM_ST4_VARIABLES,
-					       XLALSimInspiralSpinTaylorT4DerivativesAvg,
-					       XLALSimInspiralSpinTaylorStoppingTest,
-					       LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
-    else if( approx == SpinTaylorT5 )
-      integrator = XLALAdaptiveRungeKutta4Init(LAL_NUM_ST4_VARIABLES,
-					       XLALSimInspiralSpinTaylorT5DerivativesAvg,
-					       XLALSimInspiralSpinTaylorStoppingTest,
-					       LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
-    else if( approx == SpinTaylorT1 )
-      integrator = XLALAdaptiveRungeKutta4Init(LAL_NUM_ST4_VARIABLES,
-					       XLALSimInspiralSpinTaylorT1DerivativesAvg,
-					       XLALSimInspiralSpinTaylorStoppingTest,
-					       LAL_ST4_ABSOLUTE_TOLERANCE, LAL_ST4_RELATIVE_TOLERANCE);
-    else
+    /* initialize the integrator, or reset the one passed in */
+    integrator = integratorPtr ? *integratorPtr : NULL;
+    if( XLALSimInspiralSpinTaylorIntegratorInitOrReset(&integrator, approx) != XLAL_SUCCESS )
     {
-        XLALPrintError("XLAL Error - %s: Approximant must be one of SpinTaylorT1, SpinTaylorT5, SpinTaylorT4, but %i provided\n",
-                __func__, approx);
-        XLAL_ERROR(XLAL_EINVAL);
-
-    }
-    if( !integrator )
-    {
-        XLALPrintError("XLAL Error - %s: Cannot allocate integrator\n", 
-                __func__);
+        if( !integratorPtr )
+            XLALAdaptiveRungeKuttaFree(integrator);
+        LALFree(params);
         XLAL_ERROR(XLAL_EFUNC);
     }
+    if( integratorPtr )
+        *integratorPtr = integrator;
 
     /* stop the integration only when the test is true */
     integrator->stopontestonly = 1;
 
-    /* run the integration; note: time is measured in \hat{t} = t / M */
-    len = XLALAdaptiveRungeKutta4Hermite(integrator, params, yinit,
+    /* run the integration; note: time is measured in \hat{t} = t / M.
+     * The output array 'yout' belongs to the integrator. */
+    len = XLALAdaptiveRungeKutta4HermiteReuse(integrator, params, yinit,
             0.0, lengths/Msec, sgn*deltaT/Msec, &yout);
 
+    intreturn = integrator->returncode;
+    LALFree(params);
+
     if (!yout)
     {
+        if( !integratorPtr )
+            XLALAdaptiveRungeKuttaFree(integrator);
         XLALPrintError("XLAL Error - %s: integration failed (yout == NULL)\n",
                        __func__);
         XLAL_ERROR(XLAL_EFUNC);
     }
 
-    intreturn = integrator->returncode;
-    XLALAdaptiveRungeKuttaFree(integrator);
-    LALFree(params);
-
     if (!len) 
     {
+        if( !integratorPtr )
+            XLALAdaptiveRungeKuttaFree(integrator);
         XLALPrintError("XLAL Error - %s: integration failed with errorcode %d.\n", __func__, intreturn);
         XLAL_ERROR(XLAL_EFUNC);
     }
@@ -4553,7 +4568,8 @@ int XLALSimInspiralSpinTaylorPNEvolveOrbit(
     if ( !*V || !*Phi || !*S1x || !*S1y || !*S1z || !*S2x || !*S2y || !*S2z
              || !*LNhatx || !*LNhaty || !*LNhatz || !*E1x || !*E1y || !*E1z )
     {
-        XLALDestroyREAL8Array(yout);
+        if( !integratorPtr )
+            XLALAdaptiveRungeKuttaFree(integrator);
         XLAL_ERROR(XLAL_EFUNC);
     }
 
@@ -4588,12 +4604,89 @@ int XLALSimInspiralSpinTaylorPNEvolveOrbit(
         (*E1z)->data->data[j] 		= yout->data[14*len+i];
     }
 
-    XLALDestroyREAL8Array(yout);
+    if( !integratorPtr )
+        XLALAdaptiveRungeKuttaFree(integrator);
 
     return XLAL_SUCCESS;
 }
 
 
+/**
+ * This function evolves the orbital equations for a precessing binary using
+ * the \"TaylorT1/T5/T4\" approximant for solving the orbital dynamics
+ * (see arXiv:0907.0700 for a review of the various PN approximants).
+ *
+ * It returns time series of the \"orbital velocity\", orbital phase,
+ * and components for both individual spin vectors, the \"Newtonian\"
+ * orbital angular momentum (which defines the instantaneous plane)
+ * and "E1", a basis vector in the instantaneous orbital plane.
+ * Note that LNhat and E1 completely specify the instantaneous orbital plane.
+ * It also returns the time and phase of the final time step
+ *
+ * For input, the function takes the two masses, the initial orbital phase,
+ * Values of S1, S2, LNhat, E1 vectors at starting time,
+ * the desired time step size, the starting GW frequency,
+ * and PN order at which to evolve the phase,
+ *
+ * NOTE: All vectors are given in the frame
+ * where the z-axis is set by the angular momentum at reference frequency,
+ * the x-axis is chosen orthogonal to it, and the y-axis is given by the RH rule.
+ * Initial values must be passed in this frame, and the time series of the
+ * vector components will also be returned in this frame.
+ *
+ * Review completed on git hash ...
+ *
+ */
+int XLALSimInspiralSpinTaylorPNEvolveOrbit(
+	REAL8TimeSeries **V,            /**< post-Newtonian parameter [returned]*/
+	REAL8TimeSeries **Phi,          /**< orbital phase            [returned]*/
+	REAL8TimeSeries **S1x,	        /**< Spin1 vector x component [returned]*/
+	REAL8TimeSeries **S1y,	        /**< "    "    "  y component [returned]*/
+	REAL8TimeSeries **S1z,	        /**< "    "    "  z component [returned]*/
+	REAL8TimeSeries **S2x,	        /**< Spin2 vector x component [returned]*/
+	REAL8TimeSeries **S2y,	        /**< "    "    "  y component [returned]*/
+	REAL8TimeSeries **S2z,	        /**< "    "    "  z component [returned]*/
+	REAL8TimeSeries **LNhatx,       /**< unit orbital ang. mom. x [returned]*/
+	REAL8TimeSeries **LNhaty,       /**< "    "    "  y component [returned]*/
+	REAL8TimeSeries **LNhatz,       /**< "    "    "  z component [returned]*/
+	REAL8TimeSeries **E1x,	        /**< orb. plane basis vector x[returned]*/
+	REAL8TimeSeries **E1y,	        /**< "    "    "  y component [returned]*/
+	REAL8TimeSeries **E1z,	        /**< "    "    "  z component [returned]*/
+	const REAL8 deltaT,   	        /**< sampling interval (s) */
+	const REAL8 m1_SI,     	        /**< mass of companion 1 (kg) */
+	const REAL8 m2_SI,     	        /**< mass of companion 2 (kg) */
+	const REAL8 fStart,             /**< starting GW frequency */
+	const REAL8 fEnd,               /**< ending GW frequency, fEnd=0 means integrate as far forward as possible */
+	const REAL8 s1x,                /**< initial value of S1x */
+	const REAL8 s1y,                /**< initial value of S1y */
+	const REAL8 s1z,                /**< initial value of S1z */
+	const REAL8 s2x,                /**< initial value of S2x */
+	const REAL8 s2y,                /**< initial value of S2y */
+	const REAL8 s2z,                /**< initial value of S2z */
+	const REAL8 lnhatx,             /**< initial value of LNhatx */
+	const REAL8 lnhaty,             /**< initial value of LNhaty */
+	const REAL8 lnhatz,             /**< initial value of LNhatz */
+	const REAL8 e1x,                /**< initial value of E1x */
+	const REAL8 e1y,                /**< initial value of E1y */
+	const REAL8 e1z,                /**< initial value of E1z */
+	const REAL8 lambda1,            /**< (tidal deformability of mass 1) / (mass of body 1)^5 (dimensionless) */
+	const REAL8 lambda2,            /**< (tidal deformability of mass 2) / (mass of body 2)^5 (dimensionless) */
+	const REAL8 quadparam1,         /**< phenom. parameter describing induced quad. moment of body 1 (=1 for BHs, ~2-12 for NSs) */
+	const REAL8 quadparam2,         /**< phenom. parameter describing induced quad. moment of body 2 (=1 for BHs, ~2-12 for NSs) */
+	const LALSimInspiralSpinOrder spinO,  /**< twice PN order of spin effects */
+	const LALSimInspiralTidalOrder tideO, /**< twice PN order of tidal effects */
+	const INT4 phaseO,                    /**< twice post-Newtonian order */
+	const INT4 lscorr,                    /**< flag to control L_S terms */
+	const Approximant approx              /**< PN approximant (SpinTaylorT1/T5/T4) */
+	)
+{
+    return XLALSimInspiralSpinTaylorPNEvolveOrbitWithIntegrator(V, Phi, S1x,
+            S1y, S1z, S2x, S2y, S2z, LNhatx, LNhaty, LNhatz, E1x, E1y, E1z,
+            deltaT, m1_SI, m2_SI, fStart, fEnd, s1x, s1y, s1z, s2x, s2y, s2z,
+            lnhatx, lnhaty, lnhatz, e1x, e1y, e1z, lambda1, lambda2,
+            quadparam1, quadparam2, spinO, tideO, phaseO, lscorr, approx, NULL);
+}
+
 /**
  * Driver routine to compute a precessing post-Newtonian inspiral waveform
  * with phasing computed from energy balance using the so-called \"T4\" method.
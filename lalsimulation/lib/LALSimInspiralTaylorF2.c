@@ -35,9 +35,12 @@
 #include <lal/Units.h>
 #include <lal/XLALError.h>
 #include <lal/AVFactories.h>
+#include <lal/VectorMath.h>
 #include "LALSimInspiralPNCoefficients.c"
 
-#ifndef _OPENMP
+#ifdef _OPENMP
+#include <omp.h>
+#else
 #define omp ignore
 #endif
 
@@ -596,6 +599,315 @@ int XLALSimInspiralTaylorF2(
 
     return ret;
 }
+
+/* buffers used by one thread */
+typedef struct tagTaylorF2Lane {
+    REAL4VectorAligned *theta;  /* reduced phase */
+    REAL4VectorAligned *s;      /* sine of the phase */
+    REAL4VectorAligned *c;      /* cosine of the phase */
+} TaylorF2Lane;
+
+struct tagLALSimInspiralTaylorF2Workspace {
+    UINT4 length;
+    UINT4 nlanes;
+    REAL8 *f;       /* frequencies */
+    REAL8 *x;       /* f^(1/3) */
+    REAL8 *logx;    /* log(f^(1/3)) */
+    REAL8 *xm5;     /* f^(-5/3) */
+    REAL8 *xm7_2;   /* f^(-7/6) */
+    TaylorF2Lane *lane;
+};
+
+/**
+ * Create a workspace for XLALSimInspiralTaylorF2CoreBatch() at the given
+ * frequencies.  The powers and logarithms of the frequencies, which do not
+ * depend on the template, are computed here once.  Buffers are allocated
+ * for as many threads as OpenMP may use.
+ */
+LALSimInspiralTaylorF2Workspace *XLALCreateSimInspiralTaylorF2Workspace(
+        const REAL8Sequence *freqs     /**< frequency points at which to evaluate the waveforms (Hz) */
+        )
+{
+    LALSimInspiralTaylorF2Workspace *ws;
+    UINT4 i, l, n;
+
+    XLAL_CHECK_NULL(freqs, XLAL_EFAULT);
+    XLAL_CHECK_NULL(freqs->length > 0, XLAL_EBADLEN, "No frequencies given");
+    n = freqs->length;
+
+    ws = LALCalloc(1, sizeof(*ws));
+    XLAL_CHECK_NULL(ws, XLAL_ENOMEM);
+    ws->length = n;
+#ifdef _OPENMP
+    ws->nlanes = omp_get_max_threads();
+#else
+    ws->nlanes = 1;
+#endif
+
+    ws->f = LALMalloc(5 * n * sizeof(*ws->f));
+    ws->lane = LALCalloc(ws->nlanes, sizeof(*ws->lane));
+    if (!ws->f || !ws->lane) {
+        XLALDestroySimInspiralTaylorF2Workspace(ws);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    ws->x = ws->f + n;
+    ws->logx = ws->x + n;
+    ws->xm5 = ws->logx + n;
+    ws->xm7_2 = ws->xm5 + n;
+
+    for (i = 0; i < n; i++) {
+        const REAL8 f = freqs->data[i];
+        REAL8 x;
+        if (!(f > 0)) {
+            XLALDestroySimInspiralTaylorF2Workspace(ws);
+            XLAL_ERROR_NULL(XLAL_EDOM, "Frequency %g is not positive", f);
+        }
+        x = cbrt(f);
+        ws->f[i] = f;
+        ws->x[i] = x;
+        ws->logx[i] = log(x);
+        ws->xm5[i] = 1. / (x * x * x * x * x);
+        ws->xm7_2[i] = 1. / (x * x * x * sqrt(x));
+    }
+
+    for (l = 0; l < ws->nlanes; l++) {
+        TaylorF2Lane *lane = &ws->lane[l];
+        lane->theta = XLALCreateREAL4VectorAligned(n, 32);
+        lane->s = XLALCreateREAL4VectorAligned(n, 32);
+        lane->c = XLALCreateREAL4VectorAligned(n, 32);
+        if (!lane->theta || !lane->s || !lane->c) {
+            XLALDestroySimInspiralTaylorF2Workspace(ws);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
+    }
+
+    return ws;
+}
+
+/** Destroy a workspace created by XLALCreateSimInspiralTaylorF2Workspace(). */
+void XLALDestroySimInspiralTaylorF2Workspace(
+        LALSimInspiralTaylorF2Workspace *ws    /**< workspace */
+        )
+{
+    UINT4 l;
+    if (!ws)
+        return;
+    if (ws->lane) {
+        for (l = 0; l < ws->nlanes; l++) {
+            XLALDestroyREAL4VectorAligned(ws->lane[l].theta);
+            XLALDestroyREAL4VectorAligned(ws->lane[l].s);
+            XLALDestroyREAL4VectorAligned(ws->lane[l].c);
+        }
+        LALFree(ws->lane);
+    }
+    LALFree(ws->f);
+    LALFree(ws);
+}
+
+/* evaluate one template; use[k] says whether the v^k phasing term is
+ * included at the requested PN and tidal orders */
+static int TaylorF2BatchTemplate(
+        COMPLEX16 *data,
+        const LALSimInspiralTaylorF2Workspace *ws,
+        TaylorF2Lane *lane,
+        const int *use,
+        INT4 amplitudeO,
+        REAL8 m1_SI, REAL8 m2_SI, REAL8 S1z, REAL8 S2z,
+        REAL8 phi_ref, REAL8 f_ref, REAL8 shft, REAL8 r,
+        LALDict *p
+        )
+{
+    const REAL8 m1 = m1_SI / LAL_MSUN_SI;
+    const REAL8 m2 = m2_SI / LAL_MSUN_SI;
+    const REAL8 m = m1 + m2;
+    const REAL8 eta = m1 * m2 / (m * m);
+    const REAL8 piM = LAL_PI * m * LAL_MTSUN_SI;
+    /* v = c f^(1/3) */
+    const REAL8 c = cbrt(piM);
+    const REAL8 logc = log(c);
+    const UINT4 n = ws->length;
+    REAL8 a[PN_PHASING_SERIES_MAX_ORDER + 1];
+    REAL8 b5, b6, ck, amp0, phase0;
+    REAL8 ft2 = 0., ft3 = 0., ft4 = 0., ft5 = 0., ft6 = 0., fl6 = 0., ft7 = 0.;
+    REAL8 et2 = 0., et4 = 0., et6 = 0.;
+    PNPhasingSeries pfa;
+    UINT4 i;
+    INT4 k;
+
+    XLALSimInspiralPNPhasing_F2(&pfa, m1, m2, S1z, S2z, S1z*S1z, S2z*S2z, S1z*S2z, p);
+
+    /* in terms of x = f^(1/3), the phasing is
+     * x^-5 sum_k a_k x^k + (b5 + b6 x) log(x) */
+    for (k = 0, ck = pow(c, -5.); k <= PN_PHASING_SERIES_MAX_ORDER; k++, ck *= c)
+        a[k] = use[k] ? pfa.v[k] * ck : 0.;
+    b5 = use[5] ? pfa.vlogv[5] : 0.;
+    b6 = use[6] ? pfa.vlogv[6] * c : 0.;
+    a[5] += b5 * logc;
+    a[6] += b6 * logc;
+
+    /* reference phasing, see XLALSimInspiralTaylorF2Core() */
+    phase0 = -2. * phi_ref - LAL_PI_4;
+    if (f_ref != 0.) {
+        const REAL8 xref = cbrt(f_ref);
+        REAL8 poly = 0.;
+        for (k = PN_PHASING_SERIES_MAX_ORDER; k >= 0; k--)
+            poly = poly * xref + a[k];
+        phase0 -= poly / pow(xref, 5.) + (b5 + b6 * xref) * log(xref);
+    }
+
+    /* amplitude is amp0 f^(-7/6) sqrt(E(v) / F(v)), with the energy and flux
+     * corrections of the SPA amplitude, see XLALSimInspiralTaylorF2Core() */
+    amp0 = -4. * m1 * m2 / r * LAL_MRSUN_SI * LAL_MTSUN_SI * sqrt(LAL_PI/12.L);
+    amp0 *= sqrt(-2. * XLALSimInspiralPNEnergy_0PNCoeff(eta) / XLALSimInspiralPNFlux_0PNCoeff(eta)) * pow(c, -3.5);
+    switch (amplitudeO)
+    {
+        case 7:
+            ft7 = XLALSimInspiralPNFlux_7PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 6:
+            ft6 = XLALSimInspiralPNFlux_6PNCoeff(eta);
+            fl6 = XLALSimInspiralPNFlux_6PNLogCoeff(eta);
+            et6 = 4. * XLALSimInspiralPNEnergy_6PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 5:
+            ft5 = XLALSimInspiralPNFlux_5PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 4:
+            ft4 = XLALSimInspiralPNFlux_4PNCoeff(eta);
+            et4 = 3. * XLALSimInspiralPNEnergy_4PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 3:
+            ft3 = XLALSimInspiralPNFlux_3PNCoeff(eta);
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+            __attribute__ ((fallthrough));
+#endif
+        case 2:
+            ft2 = XLALSimInspiralPNFlux_2PNCoeff(eta);
+            et2 = 2. * XLALSimInspiralPNEnergy_2PNCoeff(eta);
+            break;
+        default:
+            break;
+    }
+
+    /* phase, reduced in double precision before handing over to REAL4 */
+    for (i = 0; i < n; i++) {
+        const REAL8 x = ws->x[i];
+        REAL8 poly = a[PN_PHASING_SERIES_MAX_ORDER];
+        REAL8 phasing;
+        for (k = PN_PHASING_SERIES_MAX_ORDER - 1; k >= 0; k--)
+            poly = poly * x + a[k];
+        phasing = poly * ws->xm5[i] + (b5 + b6 * x) * ws->logx[i] + shft * ws->f[i] + phase0;
+        lane->theta->data[i] = phasing - LAL_TWOPI * round(phasing / LAL_TWOPI);
+    }
+    XLAL_CHECK(XLALVectorSinCosREAL4(lane->s->data, lane->c->data, lane->theta->data, n) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    if (amplitudeO == -1 || amplitudeO == 0) {
+        for (i = 0; i < n; i++) {
+            const REAL8 amp = amp0 * ws->xm7_2[i];
+            data[i] = amp * lane->c->data[i] - amp * lane->s->data[i] * 1.0j;
+        }
+    } else {
+        for (i = 0; i < n; i++) {
+            const REAL8 v = c * ws->x[i];
+            const REAL8 logv = logc + ws->logx[i];
+            const REAL8 v2 = v * v;
+            const REAL8 flux = 1. + v2 * (ft2 + v * (ft3 + v * (ft4 + v * (ft5 + v * (ft6 + fl6 * logv + v * ft7)))));
+            const REAL8 dEnergy = 1. + v2 * (et2 + v2 * (et4 + v2 * et6));
+            const REAL8 amp = amp0 * ws->xm7_2[i] * sqrt(dEnergy / flux);
+            data[i] = amp * lane->c->data[i] - amp * lane->s->data[i] * 1.0j;
+        }
+    }
+
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Evaluate a bank of aligned-spin TaylorF2 templates at the frequencies of
+ * the workspace \c ws, writing template \c k to <tt>htilde[k]</tt>, which
+ * must have room for as many samples as there are frequencies.  The
+ * arguments and the PN orders and tidal parameters in \c p have the same
+ * meaning as for XLALSimInspiralTaylorF2Core(), and are shared by all
+ * templates.
+ *
+ * Nothing is allocated: the powers and logarithms of the frequencies are
+ * precomputed in the workspace, so that each template costs a polynomial
+ * evaluation per frequency, and the sine and cosine of the phase, reduced
+ * to \f$[-\pi, \pi]\f$ in double precision, are computed with
+ * XLALVectorSinCosREAL4(), which uses SIMD instructions where available.
+ * The waveforms therefore agree with XLALSimInspiralTaylorF2Core() to
+ * single precision.  If LALSimulation is built with OpenMP, templates are
+ * evaluated in parallel; this function must not be called concurrently
+ * with the same workspace.
+ */
+int XLALSimInspiralTaylorF2CoreBatch(
+        COMPLEX16 *const *htilde,              /**< FD waveforms (output) */
+        const REAL8 *m1_SI,                    /**< masses of companion 1 (kg) */
+        const REAL8 *m2_SI,                    /**< masses of companion 2 (kg) */
+        const REAL8 *S1z,                      /**< z components of the spin of companion 1 */
+        const REAL8 *S2z,                      /**< z components of the spin of companion 2 */
+        const UINT4 ntemplates,                /**< number of templates */
+        const REAL8 phi_ref,                   /**< reference orbital phase (rad) */
+        const REAL8 f_ref,                     /**< Reference GW frequency (Hz) - if 0 reference point is coalescence */
+        const REAL8 shft,                      /**< time shift to be applied to frequency-domain phase (sec)*/
+        const REAL8 r,                         /**< distance of source (m) */
+        LALDict *p,                            /**< Linked list containing the extra testing GR parameters >*/
+        LALSimInspiralTaylorF2Workspace *ws    /**< workspace */
+        )
+{
+    int use[PN_PHASING_SERIES_MAX_ORDER + 1];
+    INT4 phaseO, tideO, amplitudeO;
+    int errnum = 0;
+    INT4 k;
+
+    XLAL_CHECK(ws, XLAL_EFAULT);
+    XLAL_CHECK(ntemplates == 0 || (htilde && m1_SI && m2_SI && S1z && S2z), XLAL_EFAULT);
+    if (f_ref < 0) XLAL_ERROR(XLAL_EDOM);
+    if (r <= 0) XLAL_ERROR(XLAL_EDOM);
+
+    /* PN orders are looked up and validated once for all templates */
+    phaseO = XLALSimInspiralWaveformParamsLookupPNPhaseOrder(p);
+    if (phaseO == -1)
+        phaseO = 7;
+    if (phaseO < 0 || phaseO > 7)
+        XLAL_ERROR(XLAL_ETYPE, "Invalid phase PN order %d", phaseO);
+    tideO = XLALSimInspiralWaveformParamsLookupPNTidalOrder(p);
+    if (tideO == LAL_SIM_INSPIRAL_TIDAL_ORDER_DEFAULT)
+        tideO = LAL_SIM_INSPIRAL_TIDAL_ORDER_7PN;
+    if (tideO != LAL_SIM_INSPIRAL_TIDAL_ORDER_0PN && tideO != LAL_SIM_INSPIRAL_TIDAL_ORDER_5PN && tideO != LAL_SIM_INSPIRAL_TIDAL_ORDER_6PN && tideO != LAL_SIM_INSPIRAL_TIDAL_ORDER_65PN && tideO != LAL_SIM_INSPIRAL_TIDAL_ORDER_7PN && tideO != LAL_SIM_INSPIRAL_TIDAL_ORDER_75PN)
+        XLAL_ERROR(XLAL_EINVAL, "Invalid tidal PN order %d", tideO);
+    amplitudeO = XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(p);
+    if (amplitudeO < -1 || amplitudeO == 1 || amplitudeO > 7)
+        XLAL_ERROR(XLAL_ETYPE, "Invalid amplitude PN order %d", amplitudeO);
+    for (k = 0; k <= PN_PHASING_SERIES_MAX_ORDER; k++)
+        use[k] = k <= 7 ? k <= phaseO : (k == 10 || k >= 12) && k <= tideO;
+
+    XLAL_CHECK(XLALSimInspiralSetQuadMonParamsFromLambdas(p) == XLAL_SUCCESS, XLAL_EFUNC, "Failed to set quadparams from Universal relation.\n");
+
+    #pragma omp parallel for schedule(dynamic) num_threads(ws->nlanes)
+    for (k = 0; k < (INT4) ntemplates; k++) {
+#ifdef _OPENMP
+        TaylorF2Lane *lane = &ws->lane[omp_get_thread_num()];
+#else
+        TaylorF2Lane *lane = &ws->lane[0];
+#endif
+        if (!htilde[k] || !(m1_SI[k] > 0) || !(m2_SI[k] > 0) || TaylorF2BatchTemplate(htilde[k], ws, lane, use, amplitudeO, m1_SI[k], m2_SI[k], S1z[k], S2z[k], phi_ref, f_ref, shft, r, p) != XLAL_SUCCESS) {
+            #pragma omp critical (XLALSimInspiralTaylorF2CoreBatch)
+            errnum = XLAL_EFUNC;
+        }
+    }
+    XLAL_CHECK(errnum == 0, errnum, "Failed to evaluate some templates");
+
+    return XLAL_SUCCESS;
+}
+
 #include "LALSimInspiralTaylorF2Ecc.c"
 
 /** @} */
@@ -42,6 +42,10 @@
 #include <lal/Window.h>
 #include "check_series_macros.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 /*
  * ============================================================================
  *
@@ -198,6 +202,88 @@ static void highfreq_kernel(double *cached_kernel, int kernel_length, double res
 };
 
 
+/*
+ * Allocate the output time series of XLALSimDetectorStrainREAL8TimeSeries()
+ * for the given detector and interpolation kernel length, with its epoch
+ * set to the time at which the start of the input passes through the
+ * detector, less half the kernel length, rounded to an integer sample.
+ */
+static REAL8TimeSeries *detector_strain_series_create(const REAL8TimeSeries *hplus, REAL8 right_ascension, REAL8 declination, const LALDetector *detector, int kernel_length, double arm_length_samples)
+{
+	REAL8TimeSeries *h = NULL;
+	double geometric_delay;
+	LIGOTimeGPS t;	/* a time */
+	double dt;	/* an offset */
+	char *name;
+
+	/* generate name */
+
+	name = XLALMalloc(strlen(detector->frDetector.prefix) + 11);
+	if(!name)
+		goto error;
+	sprintf(name, "%s injection", detector->frDetector.prefix);
+
+	/* allocate output time series.  the time series' duration is
+	 * adjusted to account for Doppler-induced dilation of the
+	 * waveform, and is padded to accomodate ringing of the
+	 * interpolation kernel.  the sign of dt follows from the
+	 * observation that time stamps in the output time series are
+	 * mapped to time stamps in the input time series by adding the
+	 * output of XLALTimeDelayFromEarthCenter(), so if that number is
+	 * larger at the start of the waveform than at the end then the
+	 * output time series must be longer than the input.  (the Earth's
+	 * rotation is not super-luminal so we don't have to account for
+	 * time reversals in the mapping) */
+
+	/* time (at geocentre) of end of waveform */
+	t = hplus->epoch;
+	if(!XLALGPSAdd(&t, hplus->data->length * hplus->deltaT)) {
+		XLALFree(name);
+		goto error;
+	}
+	/* change in geometric delay from start to end */
+	dt = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &hplus->epoch) - XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
+	/* allocate, lengthen sequence to incorporate time delay caused by
+	 * beyond-long-wavelength effect */
+	h = XLALCreateREAL8TimeSeries(name, &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length + kernel_length - 1 + ceil(dt / hplus->deltaT) + lround(4.0 * arm_length_samples));
+	XLALFree(name);
+	if(!h)
+		goto error;
+
+	/* shift the epoch so that the start of the input time series
+	 * passes through this detector at the time of the sample at offset
+	 * (kernel_length-1)/2   we assume the kernel is sufficiently short
+	 * that it doesn't matter whether we compute the geometric delay at
+	 * the start or middle of the kernel. */
+
+	geometric_delay = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &h->epoch);
+	if(XLAL_IS_REAL8_FAIL_NAN(geometric_delay))
+		goto error;
+	if(!XLALGPSAdd(&h->epoch, geometric_delay - (kernel_length - 1) / 2 * h->deltaT))
+		goto error;
+
+	/* round epoch to an integer sample boundary so that
+	 * XLALSimAddInjectionREAL8TimeSeries() can use no-op code path.
+	 * note:  we assume a sample boundary occurs on the integer second.
+	 * if this isn't the case (e.g, time-shifted injections or some GEO
+	 * data) that's OK, but we might end up paying for a second
+	 * sub-sample time shift when adding the the time series into the
+	 * target data stream in XLALSimAddInjectionREAL8TimeSeries().
+	 * don't bother checking for errors, this is changing the timestamp
+	 * by less than 1 sample, if we're that close to overflowing it'll
+	 * be caught when the output samples are computed. */
+
+	dt = XLALGPSModf(&dt, &h->epoch);
+	XLALGPSAdd(&h->epoch, round(dt / h->deltaT) * h->deltaT - dt);
+
+	return h;
+
+error:
+	XLALDestroyREAL8TimeSeries(h);
+	XLAL_ERROR_NULL(XLAL_EFUNC);
+}
+
+
 /**
  * @brief Transforms the waveform polarizations into a detector strain
  * @details
@@ -279,8 +365,6 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	double fycross = XLAL_REAL8_FAIL_NAN;
 	double geometric_delay = XLAL_REAL8_FAIL_NAN;
 	LIGOTimeGPS t;	/* a time */
-	double dt;	/* an offset */
-	char *name;
 	REAL8TimeSeries *h = NULL;
 	unsigned i;
 
@@ -297,66 +381,12 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 		XLAL_ERROR_NULL(XLAL_EBADLEN);
 	}
 
-	/* generate name */
+	/* allocate output time series */
 
-	name = XLALMalloc(strlen(detector->frDetector.prefix) + 11);
-	if(!name)
-		goto error;
-	sprintf(name, "%s injection", detector->frDetector.prefix);
-
-	/* allocate output time series.  the time series' duration is
-	 * adjusted to account for Doppler-induced dilation of the
-	 * waveform, and is padded to accomodate ringing of the
-	 * interpolation kernel.  the sign of dt follows from the
-	 * observation that time stamps in the output time series are
-	 * mapped to time stamps in the input time series by adding the
-	 * output of XLALTimeDelayFromEarthCenter(), so if that number is
-	 * larger at the start of the waveform than at the end then the
-	 * output time series must be longer than the input.  (the Earth's
-	 * rotation is not super-luminal so we don't have to account for
-	 * time reversals in the mapping) */
-
-	/* time (at geocentre) of end of waveform */
-	t = hplus->epoch;
-	if(!XLALGPSAdd(&t, hplus->data->length * hplus->deltaT)) {
-		XLALFree(name);
-		goto error;
-	}
-	/* change in geometric delay from start to end */
-	dt = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &hplus->epoch) - XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
-	/* allocate, lengthen sequence to incorporate time delay caused by
-	 * beyond-long-wavelength effect */
-	h = XLALCreateREAL8TimeSeries(name, &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length + kernel_length - 1 + ceil(dt / hplus->deltaT) + lround(4.0 * arm_length_samples));
-	XLALFree(name);
+	h = detector_strain_series_create(hplus, right_ascension, declination, detector, kernel_length, arm_length_samples);
 	if(!h)
 		goto error;
 
-	/* shift the epoch so that the start of the input time series
-	 * passes through this detector at the time of the sample at offset
-	 * (kernel_length-1)/2   we assume the kernel is sufficiently short
-	 * that it doesn't matter whether we compute the geometric delay at
-	 * the start or middle of the kernel. */
-
-	geometric_delay = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &h->epoch);
-	if(XLAL_IS_REAL8_FAIL_NAN(geometric_delay))
-		goto error;
-	if(!XLALGPSAdd(&h->epoch, geometric_delay - (kernel_length - 1) / 2 * h->deltaT))
-		goto error;
-
-	/* round epoch to an integer sample boundary so that
-	 * XLALSimAddInjectionREAL8TimeSeries() can use no-op code path.
-	 * note:  we assume a sample boundary occurs on the integer second.
-	 * if this isn't the case (e.g, time-shifted injections or some GEO
-	 * data) that's OK, but we might end up paying for a second
-	 * sub-sample time shift when adding the the time series into the
-	 * target data stream in XLALSimAddInjectionREAL8TimeSeries().
-	 * don't bother checking for errors, this is changing the timestamp
-	 * by less than 1 sample, if we're that close to overflowing it'll
-	 * be caught in the loop below. */
-
-	dt = XLALGPSModf(&dt, &h->epoch);
-	XLALGPSAdd(&h->epoch, round(dt / h->deltaT) * h->deltaT - dt);
-
 	/* Compute signals at the times of samples in hplus in advance.
 	 * It reduces the computational cost for interpolation */
 
@@ -446,6 +476,350 @@ error:
 }
 
 
+/*
+ * state for one detector of XLALSimDetectorStrainNetworkREAL8TimeSeries()
+ */
+
+
+struct network_strain_detector {
+	const LALDetector *detector;
+	REAL8TimeSeries *h;
+	int kernel_length;
+	struct highfreq_kernel_data xdata;
+	struct highfreq_kernel_data ydata;
+	/* detector response and geometric delay on the coarse time grid */
+	double *armlen;
+	double *xcos;
+	double *ycos;
+	double *fxplus;
+	double *fxcross;
+	double *fyplus;
+	double *fycross;
+	double *delay;
+};
+
+
+/* linear interpolation of a quantity tabulated on the coarse time grid */
+static double network_grid_interp(const double *grid, int k, double frac)
+{
+	return grid[k] + frac * (grid[k + 1] - grid[k]);
+}
+
+
+/* fused evaluation of the x and y arm interpolators:  the two kernels
+ * are applied to the two signals in a single loop over contiguous
+ * memory */
+static double network_interp_eval(const double *xkernel, const double *ykernel, const double *xsignal, const double *ysignal, int kernel_length, int length, int start)
+{
+	int first = start < 0 ? -start : 0;
+	int last = start + kernel_length > length ? length - start : kernel_length;
+	double val = 0.0;
+	int j;
+
+	for(j = first; j < last; j++)
+		val += xkernel[j] * xsignal[start + j] + ykernel[j] * ysignal[start + j];
+
+	return val;
+}
+
+
+static int network_strain_detector(struct network_strain_detector *det, const REAL8TimeSeries *hplus, const REAL8TimeSeries *hcross, const LIGOTimeGPS *grid_epoch, double grid_interval, unsigned grid_length)
+{
+	const int kernel_length = det->kernel_length;
+	/* see TimeSeriesInterp.c for the meaning of this */
+	const double noop_threshold = 1. / (4 * kernel_length);
+	const double deltaT = hplus->deltaT;
+	const int length = hplus->data->length;
+	double *xsignal = XLALMalloc(length * sizeof(*xsignal));
+	double *ysignal = XLALMalloc(length * sizeof(*ysignal));
+	double *xkernel = XLALMalloc(kernel_length * sizeof(*xkernel));
+	double *ykernel = XLALMalloc(kernel_length * sizeof(*ykernel));
+	/* offsets of the input and output series from the grid epoch */
+	const double input_offset = XLALGPSDiff(&hplus->epoch, grid_epoch);
+	const double output_offset = XLALGPSDiff(&det->h->epoch, grid_epoch);
+	/* offset of the output series from the input series */
+	const double output_input_offset = XLALGPSDiff(&det->h->epoch, &hplus->epoch);
+	/* >= 1 --> impossible.  forces kernel init on first use */
+	double residual = 2.;
+	int kernel_k = -1;
+	unsigned i;
+
+	if(!xsignal || !ysignal || !xkernel || !ykernel) {
+		XLALFree(xsignal);
+		XLALFree(ysignal);
+		XLALFree(xkernel);
+		XLALFree(ykernel);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	/* project the input onto the two arms, with the detector response
+	 * interpolated to the times of the input samples.  as in
+	 * XLALSimDetectorStrainREAL8TimeSeries() the geometric delay is
+	 * neglected here */
+	for(i = 0; i < (unsigned) length; i++) {
+		double u = (input_offset + i * deltaT) / grid_interval;
+		int k = floor(u);
+		double frac;
+		if(k < 0)
+			k = 0;
+		else if(k > (int) grid_length - 2)
+			k = grid_length - 2;
+		frac = u - k;
+		xsignal[i] = network_grid_interp(det->fxplus, k, frac) * hplus->data->data[i] + network_grid_interp(det->fxcross, k, frac) * hcross->data->data[i];
+		ysignal[i] = network_grid_interp(det->fyplus, k, frac) * hplus->data->data[i] + network_grid_interp(det->fycross, k, frac) * hcross->data->data[i];
+	}
+
+	/* compute output sample by sample */
+	for(i = 0; i < det->h->data->length; i++) {
+		double u = (output_offset + i * deltaT) / grid_interval;
+		int k = floor(u);
+		double frac, x;
+		int start;
+		if(k < 0)
+			k = 0;
+		else if(k > (int) grid_length - 2)
+			k = grid_length - 2;
+		frac = u - k;
+
+		/* real-valued index of the sample in the input series at
+		 * the geocentre */
+		x = (output_input_offset + i * deltaT + network_grid_interp(det->delay, k, frac)) / deltaT;
+		if(!isfinite(x)) {
+			XLALFree(xsignal);
+			XLALFree(ysignal);
+			XLALFree(xkernel);
+			XLALFree(ykernel);
+			XLAL_ERROR(XLAL_EDOM);
+		}
+		start = lround(x);
+
+		/* need new kernels?  they are recomputed when the
+		 * residual has changed by more than the no-op threshold,
+		 * or when the detector response has been updated */
+		if(fabs(start - x - residual) >= noop_threshold || k != kernel_k) {
+			residual = start - x;
+			kernel_k = k;
+			det->xdata.T = det->ydata.T = network_grid_interp(det->armlen, k, frac) / (LAL_C_SI * deltaT);
+			det->xdata.armcos = network_grid_interp(det->xcos, k, frac);
+			det->ydata.armcos = network_grid_interp(det->ycos, k, frac);
+			highfreq_kernel(xkernel, kernel_length, residual, &det->xdata);
+			highfreq_kernel(ykernel, kernel_length, residual, &det->ydata);
+		}
+
+		det->h->data->data[i] = network_interp_eval(xkernel, ykernel, xsignal, ysignal, kernel_length, length, start - (kernel_length - 1) / 2);
+	}
+
+	XLALFree(xsignal);
+	XLALFree(ysignal);
+	XLALFree(xkernel);
+	XLALFree(ykernel);
+	return 0;
+}
+
+
+/**
+ * @brief Transforms the waveform polarizations into the strains of a
+ * network of detectors
+ * @details
+ * Equivalent to calling XLALSimDetectorStrainREAL8TimeSeries() once for
+ * each detector in the network, but sharing the work that does not
+ * depend on the detector.  The output time series have the same epochs,
+ * lengths and units as those returned by
+ * XLALSimDetectorStrainREAL8TimeSeries().
+ *
+ * @param[out] h Array of n_detectors pointers, set to the strain time
+ * series as seen in each detector
+ * @param[in] hplus Pointer to a REAL8TimeSeries containing the plus polarization waveform
+ * @param[in] hcross Pointer to a REAL8TimeSeries containing the cross polarization waveform
+ * @param[in] right_ascension The right ascension of the source in radians
+ * @param[in] declination The declination of the source in radians
+ * @param[in] psi The polarization angle giving the orientation of the wave co-ordinate system in radians
+ * @param[in] detectors Array of n_detectors LALDetector structures
+ * @param[in] n_detectors Number of detectors in the network
+ *
+ * @retval 0 Success
+ * @retval <0 Failure
+ *
+ * @note
+ * Sidereal time is computed once, on a 250 ms grid common to all
+ * detectors.  On that grid the antenna response and geometric delay of
+ * each detector are tabulated and then interpolated linearly to the time
+ * of each sample, instead of being held fixed for 250 ms at a time as in
+ * XLALSimDetectorStrainREAL8TimeSeries(); the results of the two functions
+ * therefore differ by the size of the errors quoted there.  The two arm
+ * interpolation kernels are also regenerated whenever the detector
+ * response changes, and are applied to the projected signals in a single
+ * pass.  The detectors are processed in parallel if LALSimulation is
+ * built with OpenMP support.
+ */
+int XLALSimDetectorStrainNetworkREAL8TimeSeries(
+	REAL8TimeSeries **h,
+	const REAL8TimeSeries *hplus,
+	const REAL8TimeSeries *hcross,
+	REAL8 right_ascension,
+	REAL8 declination,
+	REAL8 psi,
+	const LALDetector *detectors,
+	UINT4 n_detectors
+)
+{
+	unsigned det_resp_interval;
+	double grid_interval;
+	struct network_strain_detector *dets = NULL;
+	double *gmst = NULL;
+	LIGOTimeGPS grid_epoch;
+	double grid_duration;
+	unsigned grid_length;
+	int errcode = XLAL_SUCCESS;
+	unsigned d, k;
+
+	/* check input */
+
+	if(!h || !detectors || n_detectors < 1)
+		XLAL_ERROR(XLAL_EFAULT);
+	LAL_CHECK_VALID_SERIES(hplus, XLAL_FAILURE);
+	LAL_CHECK_VALID_SERIES(hcross, XLAL_FAILURE);
+	LAL_CHECK_CONSISTENT_TIME_SERIES(hplus, hcross, XLAL_FAILURE);
+	for(d = 0; d < n_detectors; d++)
+		h[d] = NULL;
+
+	/* 0.25 s or 1 sample whichever is larger */
+	det_resp_interval = round(0.25 / hplus->deltaT) < 1 ? 1 : round(0.25 / hplus->deltaT);
+	grid_interval = det_resp_interval * hplus->deltaT;
+
+	dets = XLALCalloc(n_detectors, sizeof(*dets));
+	if(!dets)
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	/* allocate the output time series.  the time grid covers the
+	 * input and all output series */
+
+	grid_epoch = hplus->epoch;
+	grid_duration = hplus->data->length * hplus->deltaT;
+	for(d = 0; d < n_detectors; d++) {
+		const LALDetector *detector = &detectors[d];
+		/* mean arm length in samples */
+		const double arm_length_samples = (detector->frDetector.xArmMidpoint + detector->frDetector.yArmMidpoint) / (LAL_C_SI * hplus->deltaT);
+		/* kernel length in samples, see
+		 * XLALSimDetectorStrainREAL8TimeSeries() */
+		const int kernel_length = 67 + 48 * lround(2.0 * arm_length_samples);
+		double start, end;
+
+		if((int) hplus->data->length < 0 || (int) (hplus->data->length + kernel_length + 2.0 * LAL_REARTH_SI / LAL_C_SI / hplus->deltaT) < 0) {
+			XLALPrintError("%s(): error: input series too long\n", __func__);
+			errcode = XLAL_EBADLEN;
+			goto error;
+		}
+
+		dets[d].detector = detector;
+		dets[d].kernel_length = kernel_length;
+		dets[d].xdata.welch_factor = dets[d].ydata.welch_factor = 1.0 / ((kernel_length - 1.) / 2. + 1.);
+		dets[d].h = detector_strain_series_create(hplus, right_ascension, declination, detector, kernel_length, arm_length_samples);
+		if(!dets[d].h) {
+			errcode = XLAL_EFUNC;
+			goto error;
+		}
+
+		start = XLALGPSDiff(&dets[d].h->epoch, &grid_epoch);
+		end = start + dets[d].h->data->length * dets[d].h->deltaT;
+		if(start < 0) {
+			XLALGPSAdd(&grid_epoch, start);
+			grid_duration -= start;
+			end -= start;
+		}
+		if(end > grid_duration)
+			grid_duration = end;
+	}
+	grid_length = ceil(grid_duration / grid_interval) + 2;
+
+	/* sidereal time on the grid, shared by all detectors */
+
+	gmst = XLALMalloc(grid_length * sizeof(*gmst));
+	if(!gmst) {
+		errcode = XLAL_ENOMEM;
+		goto error;
+	}
+	for(k = 0; k < grid_length; k++) {
+		LIGOTimeGPS t = grid_epoch;
+		if(!XLALGPSAdd(&t, k * grid_interval)) {
+			errcode = XLAL_EFUNC;
+			goto error;
+		}
+		gmst[k] = XLALGreenwichMeanSiderealTime(&t);
+		if(XLAL_IS_REAL8_FAIL_NAN(gmst[k])) {
+			errcode = XLAL_EFUNC;
+			goto error;
+		}
+	}
+
+	/* tabulate the detector responses and geometric delays */
+
+	for(d = 0; d < n_detectors; d++) {
+		struct network_strain_detector *det = &dets[d];
+		double **grids[] = {&det->armlen, &det->xcos, &det->ycos, &det->fxplus, &det->fxcross, &det->fyplus, &det->fycross, &det->delay};
+		unsigned n;
+		for(n = 0; n < XLAL_NUM_ELEM(grids); n++) {
+			*grids[n] = XLALMalloc(grid_length * sizeof(**grids[n]));
+			if(!*grids[n]) {
+				errcode = XLAL_ENOMEM;
+				goto error;
+			}
+		}
+		for(k = 0; k < grid_length; k++) {
+			/* unit vector pointing from the geocentre to the
+			 * source, see XLALArrivalTimeDiff() */
+			const double gha = gmst[k] - right_ascension;
+			const double ehat_src[3] = {cos(declination) * cos(gha), cos(declination) * -sin(gha), sin(declination)};
+			XLALComputeDetAMResponseParts(&det->armlen[k], &det->xcos[k], &det->ycos[k], &det->fxplus[k], &det->fyplus[k], &det->fxcross[k], &det->fycross[k], det->detector, right_ascension, declination, psi, gmst[k]);
+			/* = -XLALTimeDelayFromEarthCenter() */
+			det->delay[k] = (ehat_src[0] * det->detector->location[0] + ehat_src[1] * det->detector->location[1] + ehat_src[2] * det->detector->location[2]) / LAL_C_SI;
+		}
+	}
+
+	/* compute the strains */
+
+	#pragma omp parallel for schedule(dynamic)
+	for(d = 0; d < n_detectors; d++) {
+		int per_thread_errcode;
+		#pragma omp flush(errcode)
+		if(errcode != XLAL_SUCCESS)
+			continue;
+		per_thread_errcode = network_strain_detector(&dets[d], hplus, hcross, &grid_epoch, grid_interval, grid_length);
+		if(per_thread_errcode != XLAL_SUCCESS) {
+			#pragma omp critical (XLALSimDetectorStrainNetworkREAL8TimeSeries)
+			errcode = XLAL_EFUNC;
+		}
+	}
+	if(errcode != XLAL_SUCCESS)
+		goto error;
+
+	/* done */
+
+	for(d = 0; d < n_detectors; d++) {
+		h[d] = dets[d].h;
+		dets[d].h = NULL;
+	}
+
+error:
+	for(d = 0; d < n_detectors; d++) {
+		XLALDestroyREAL8TimeSeries(dets[d].h);
+		XLALFree(dets[d].armlen);
+		XLALFree(dets[d].xcos);
+		XLALFree(dets[d].ycos);
+		XLALFree(dets[d].fxplus);
+		XLALFree(dets[d].fxcross);
+		XLALFree(dets[d].fyplus);
+		XLALFree(dets[d].fycross);
+		XLALFree(dets[d].delay);
+	}
+	XLALFree(dets);
+	XLALFree(gmst);
+	if(errcode != XLAL_SUCCESS)
+		XLAL_ERROR(errcode);
+	return 0;
+}
+
+
 /**
  * @brief Adds a detector strain time series to detector data.
  * @details
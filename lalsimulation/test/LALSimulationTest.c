@@ -140,6 +140,65 @@ static void check_result(const REAL8TimeSeries *model, const REAL8TimeSeries *re
 }
 
 
+/* check that the network projection agrees with the single-detector
+ * projection, to within the errors of the latter, and with the model */
+static void check_network(double ampl, double freq, double dt, unsigned length_origin, unsigned start_mdl, unsigned length_mdl, REAL8 right_ascension, REAL8 declination, REAL8 psi, double rms_bound, double residual_bound, double diff_bound)
+{
+	LALDetector detectors[] = {
+		lalCachedDetectors[LAL_LHO_4K_DETECTOR],
+		lalCachedDetectors[LAL_LLO_4K_DETECTOR],
+		lalCachedDetectors[LAL_VIRGO_DETECTOR]
+	};
+	const unsigned n_detectors = sizeof(detectors) / sizeof(*detectors);
+	REAL8TimeSeries *h[sizeof(detectors) / sizeof(*detectors)];
+	REAL8TimeSeries *hplus, *hcross;
+	unsigned d, i;
+
+	hplus = new_series(dt, length_origin, 0.0);
+	hcross = copy_series(hplus);
+	add_circular_polarized_sine(hplus, hcross, hplus->epoch, ampl, freq);
+
+	if(XLALSimDetectorStrainNetworkREAL8TimeSeries(h, hplus, hcross, right_ascension, declination, psi, detectors, n_detectors) < 0) {
+		fprintf(stderr, "XLALSimDetectorStrainNetworkREAL8TimeSeries() failed\n");
+		exit(1);
+	}
+
+	fprintf(stderr, "injecting unit amplitude %g Hz circular polarized monochromatic GWs sampled at %g Hz into a %u detector network\n", freq, 1 / dt, n_detectors);
+
+	for(d = 0; d < n_detectors; d++) {
+		REAL8TimeSeries *dst = XLALSimDetectorStrainREAL8TimeSeries(hplus, hcross, right_ascension, declination, psi, &detectors[d]);
+		REAL8TimeSeries *short_dst, *mdl;
+		double maxdiff = 0.;
+
+		if(XLALGPSCmp(&dst->epoch, &h[d]->epoch) || dst->data->length != h[d]->data->length) {
+			fprintf(stderr, "%s: network and single-detector strains are not aligned\n", detectors[d].frDetector.prefix);
+			exit(1);
+		}
+		for(i = 0; i < dst->data->length; i++)
+			if(fabs(dst->data->data[i] - h[d]->data->data[i]) > maxdiff)
+				maxdiff = fabs(dst->data->data[i] - h[d]->data->data[i]);
+		fprintf(stderr, "%s: max difference from single-detector strain = %g\n", detectors[d].frDetector.prefix, maxdiff);
+		if(maxdiff > diff_bound) {
+			fprintf(stderr, "difference larger than allowed\n");
+			exit(1);
+		}
+
+		short_dst = XLALCutREAL8TimeSeries(h[d], start_mdl, length_mdl);
+		mdl = copy_series(short_dst);
+		compute_answer(mdl, hplus->epoch, ampl, freq, right_ascension, declination, psi, &detectors[d]);
+		check_result(mdl, short_dst, rms_bound, -residual_bound, residual_bound);
+
+		XLALDestroyREAL8TimeSeries(dst);
+		XLALDestroyREAL8TimeSeries(short_dst);
+		XLALDestroyREAL8TimeSeries(mdl);
+		XLALDestroyREAL8TimeSeries(h[d]);
+	}
+
+	XLALDestroyREAL8TimeSeries(hplus);
+	XLALDestroyREAL8TimeSeries(hcross);
+}
+
+
 int main(void)
 {
 	REAL8TimeSeries *hplus, *hcross, *dst, *short_dst, *mdl;
@@ -202,5 +261,7 @@ int main(void)
 	XLALDestroyREAL8TimeSeries(short_dst);
 	XLALDestroyREAL8TimeSeries(mdl);
 
+	check_network(1.0, 100.0, 1.0 / 400.0, 1024 * 3, 1024, 1024, 1.0, -0.5, 0.3, 0.0003, 0.0005, 0.004);
+
 	exit(0);
 }
@@ -0,0 +1,130 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check XLALSimInspiralChooseFDWaveformMultiband() against evaluating
+ * the waveform at every frequency bin
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include <complex.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDict.h>
+#include <lal/Sequence.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALSimInspiral.h>
+#include <lal/LALSimInspiralWaveformCache.h>
+
+#define TOLERANCE 1e-2
+#define MAX_MISMATCH 1e-3
+
+/* white-noise mismatch between a[k] and b[k - boffset] over [kmin, kmax] */
+static REAL8 mismatch(const COMPLEX16 *a, const COMPLEX16 *b, UINT4 boffset, UINT4 kmin, UINT4 kmax) {
+    REAL8 aa = 0., bb = 0.;
+    COMPLEX16 ab = 0.;
+    UINT4 k;
+    for (k = kmin; k <= kmax; k++) {
+        const COMPLEX16 bk = b[k - boffset];
+        aa += creal(a[k] * conj(a[k]));
+        bb += creal(bk * conj(bk));
+        ab += a[k] * conj(bk);
+    }
+    return 1. - creal(ab) / sqrt(aa * bb);
+}
+
+static int check(Approximant approximant, REAL8 m1, REAL8 m2, REAL8 s1z, REAL8 s2z, REAL8 deltaF, REAL8 f_min, REAL8 f_max) {
+    COMPLEX16FrequencySeries *hptilde = NULL, *hctilde = NULL;
+    COMPLEX16FrequencySeries *hpref = NULL, *hcref = NULL;
+    REAL8Sequence *frequencies;
+    LALDict *LALpars = XLALCreateDict();
+    REAL8 phiRef = 0.7, f_ref = 0., distance = 1.e6 * LAL_PC_SI, inclination = 0.4;
+    REAL8 plusmm, crossmm;
+    UINT4 kmin = ceil(f_min / deltaF), kmax = floor(f_max / deltaF);
+    UINT4 k, ncoarse;
+    clock_t s1, e1, s2, e2;
+
+    /* reference: every bin from f_min to f_max */
+    frequencies = XLALCreateREAL8Sequence(kmax - kmin + 1);
+    for (k = kmin; k <= kmax; k++)
+        frequencies->data[k - kmin] = k * deltaF;
+    s1 = clock();
+    if (XLALSimInspiralChooseFDWaveformSequence(&hpref, &hcref, phiRef, m1, m2, 0., 0., s1z, 0., 0., s2z, f_ref, distance, inclination, LALpars, approximant, frequencies) == XLAL_FAILURE)
+        return 1;
+    e1 = clock();
+    XLALDestroyREAL8Sequence(frequencies);
+
+    frequencies = XLALSimInspiralMultibandFrequencies(m1, m2, deltaF, f_min, f_max, TOLERANCE);
+    if (!frequencies)
+        return 1;
+    ncoarse = frequencies->length;
+    XLALDestroyREAL8Sequence(frequencies);
+
+    s2 = clock();
+    if (XLALSimInspiralChooseFDWaveformMultiband(&hptilde, &hctilde, phiRef, m1, m2, 0., 0., s1z, 0., 0., s2z, f_ref, distance, inclination, LALpars, approximant, deltaF, f_min, f_max, TOLERANCE) == XLAL_FAILURE)
+        return 1;
+    e2 = clock();
+
+    if (hptilde->data->length != kmax + 1 || hctilde->data->length != kmax + 1) {
+        fprintf(stderr, "MultibandTest: FAIL (%s: length %u, expected %u)\n", XLALSimInspiralGetStringFromApproximant(approximant), hptilde->data->length, kmax + 1);
+        return 1;
+    }
+    for (k = 0; k < kmin; k++)
+        if (hptilde->data->data[k] != 0. || hctilde->data->data[k] != 0.) {
+            fprintf(stderr, "MultibandTest: FAIL (%s: non-zero below f_min)\n", XLALSimInspiralGetStringFromApproximant(approximant));
+            return 1;
+        }
+
+    /* the reference starts at f_min */
+    plusmm = mismatch(hptilde->data->data, hpref->data->data, kmin, kmin, kmax);
+    crossmm = mismatch(hctilde->data->data, hcref->data->data, kmin, kmin, kmax);
+
+    printf("Comparing %s from ChooseFDWaveformSequence and ChooseFDWaveformMultiband\n", XLALSimInspiralGetStringFromApproximant(approximant));
+    printf("Multiband evaluated %u of %u frequencies\n", ncoarse, kmax - kmin + 1);
+    printf("ChooseFDWaveformSequence took %f seconds\n", (double) (e1 - s1) / CLOCKS_PER_SEC);
+    printf("ChooseFDWaveformMultiband took %f seconds\n", (double) (e2 - s2) / CLOCKS_PER_SEC);
+    printf("Mismatch of plus polarization is: %g\n", plusmm);
+    printf("Mismatch of cross polarization is: %g\n\n", crossmm);
+
+    XLALDestroyCOMPLEX16FrequencySeries(hptilde);
+    XLALDestroyCOMPLEX16FrequencySeries(hctilde);
+    XLALDestroyCOMPLEX16FrequencySeries(hpref);
+    XLALDestroyCOMPLEX16FrequencySeries(hcref);
+    XLALDestroyDict(LALpars);
+
+    if (!(plusmm < MAX_MISMATCH && crossmm < MAX_MISMATCH)) {
+        fprintf(stderr, "MultibandTest: FAIL (%s: mismatch %g, %g)\n", XLALSimInspiralGetStringFromApproximant(approximant), plusmm, crossmm);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    /* a binary neutron star and a binary black hole */
+    if (check(TaylorF2, 1.4 * LAL_MSUN_SI, 1.3 * LAL_MSUN_SI, 0., 0., 1. / 256., 20., 1024.))
+        return 1;
+    if (check(IMRPhenomD, 30. * LAL_MSUN_SI, 20. * LAL_MSUN_SI, 0.3, -0.2, 1. / 8., 20., 1024.))
+        return 1;
+
+    LALCheckMemoryLeaks();
+    fprintf(stderr, "MultibandTest: PASS\n");
+    return 0;
+}
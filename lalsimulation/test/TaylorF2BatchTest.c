@@ -0,0 +1,135 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check XLALSimInspiralTaylorF2CoreBatch() against
+ * XLALSimInspiralTaylorF2Core() one template at a time
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <complex.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDict.h>
+#include <lal/Sequence.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALSimInspiral.h>
+
+#define NTMPLT 16
+#define DELTAF (1. / 64.)
+#define F_MIN 15.
+#define F_MAX 1500.
+#define MAX_RELDIFF 1e-5
+
+static int check(const char *name, LALDict *LALpars, REAL8 f_ref) {
+    REAL8 m1[NTMPLT], m2[NTMPLT], S1z[NTMPLT], S2z[NTMPLT];
+    COMPLEX16 *htilde[NTMPLT];
+    const REAL8 phi_ref = 0.3, shft = -LAL_TWOPI / DELTAF, r = 1.e6 * LAL_PC_SI;
+    const UINT4 n = (F_MAX - F_MIN) / DELTAF;
+    REAL8Sequence *freqs = XLALCreateREAL8Sequence(n);
+    LALSimInspiralTaylorF2Workspace *ws;
+    REAL8 reldiff = 0.;
+    clock_t s1, e1, s2, e2;
+    UINT4 i, k;
+
+    for (i = 0; i < n; i++)
+        freqs->data[i] = F_MIN + i * DELTAF;
+    ws = XLALCreateSimInspiralTaylorF2Workspace(freqs);
+    if (!ws)
+        return 1;
+
+    /* a bank of binary neutron stars */
+    srand(1729);
+    for (k = 0; k < NTMPLT; k++) {
+        m1[k] = (1.1 + rand() / (RAND_MAX + 1.) * 1.9) * LAL_MSUN_SI;
+        m2[k] = (1.0 + rand() / (RAND_MAX + 1.) * 1.2) * LAL_MSUN_SI;
+        S1z[k] = rand() / (RAND_MAX + 1.) * 0.1 - 0.05;
+        S2z[k] = rand() / (RAND_MAX + 1.) * 0.1 - 0.05;
+        htilde[k] = XLALMalloc(n * sizeof(*htilde[k]));
+        if (!htilde[k])
+            return 1;
+    }
+
+    s1 = clock();
+    if (XLALSimInspiralTaylorF2CoreBatch(htilde, m1, m2, S1z, S2z, NTMPLT, phi_ref, f_ref, shft, r, LALpars, ws) != XLAL_SUCCESS)
+        return 1;
+    e1 = clock();
+
+    s2 = clock();
+    for (k = 0; k < NTMPLT; k++) {
+        COMPLEX16FrequencySeries *href = NULL;
+        PNPhasingSeries *pfa = NULL;
+        if (XLALSimInspiralTaylorF2AlignedPhasing(&pfa, m1[k] / LAL_MSUN_SI, m2[k] / LAL_MSUN_SI, S1z[k], S2z[k], LALpars) != XLAL_SUCCESS)
+            return 1;
+        if (XLALSimInspiralTaylorF2Core(&href, freqs, phi_ref, m1[k], m2[k], f_ref, shft, r, LALpars, pfa) != XLAL_SUCCESS)
+            return 1;
+        for (i = 0; i < n; i++) {
+            REAL8 d = cabs(htilde[k][i] - href->data->data[i]) / cabs(href->data->data[i]);
+            if (d > reldiff)
+                reldiff = d;
+        }
+        XLALDestroyCOMPLEX16FrequencySeries(href);
+        LALFree(pfa);
+    }
+    e2 = clock();
+
+    printf("Comparing TaylorF2CoreBatch and TaylorF2Core (%s)\n", name);
+    printf("TaylorF2CoreBatch took %f seconds\n", (double) (e1 - s1) / CLOCKS_PER_SEC);
+    printf("TaylorF2Core took %f seconds\n", (double) (e2 - s2) / CLOCKS_PER_SEC);
+    printf("Largest relative difference is: %g\n\n", reldiff);
+
+    for (k = 0; k < NTMPLT; k++)
+        XLALFree(htilde[k]);
+    XLALDestroySimInspiralTaylorF2Workspace(ws);
+    XLALDestroyREAL8Sequence(freqs);
+
+    if (!(reldiff < MAX_RELDIFF)) {
+        fprintf(stderr, "TaylorF2BatchTest: FAIL (%s: relative difference %g)\n", name, reldiff);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    LALDict *LALpars = XLALCreateDict();
+
+    if (check("default orders", LALpars, 0.))
+        return 1;
+
+    /* tides, amplitude corrections and a reference frequency */
+    XLALSimInspiralWaveformParamsInsertTidalLambda1(LALpars, 400.);
+    XLALSimInspiralWaveformParamsInsertTidalLambda2(LALpars, 300.);
+    XLALSimInspiralWaveformParamsInsertPNTidalOrder(LALpars, LAL_SIM_INSPIRAL_TIDAL_ORDER_75PN);
+    XLALSimInspiralWaveformParamsInsertPNAmplitudeOrder(LALpars, 5);
+    if (check("tidal, amplitude order 5", LALpars, 40.))
+        return 1;
+
+    /* lower phase order */
+    XLALSimInspiralWaveformParamsInsertPNPhaseOrder(LALpars, 5);
+    if (check("phase order 5", LALpars, 20.))
+        return 1;
+
+    XLALDestroyDict(LALpars);
+    LALCheckMemoryLeaks();
+    fprintf(stderr, "TaylorF2BatchTest: PASS\n");
+    return 0;
+}